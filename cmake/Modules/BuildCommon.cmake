@@ -36,6 +36,7 @@ set(KATANA_USE_TUNE "intel;generic;auto" CACHE STRING "Semi-colon separated list
   optimizing for the most common processors and then to optimizing for the processor selected by KATANA_USE_ARCH")
 set(KATANA_USE_SANITIZER "" CACHE STRING "Semi-colon separated list of sanitizers to use (Memory, MemoryWithOrigins, Address, Undefined, Thread)")
 set(KATANA_USE_JEMALLOC OFF CACHE BOOL "Use jemalloc")
+set(KATANA_USE_URING OFF CACHE BOOL "Use io_uring (liburing) for local storage bulk reads")
 
 # This option is automatically handled by CMake.
 # It makes add_library build a shared lib unless STATIC is explicitly specified.
@@ -262,6 +263,12 @@ if (KATANA_USE_JEMALLOC)
   link_libraries(jemalloc::jemalloc)
 endif ()
 
+if (KATANA_USE_URING)
+  find_package(LibUring REQUIRED)
+  include_directories(${LibUring_INCLUDE_DIRS})
+  add_definitions(-DKATANA_USE_URING)
+endif ()
+
 find_package(NUMA)
 
 find_package(Threads REQUIRED)
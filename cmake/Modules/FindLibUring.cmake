@@ -0,0 +1,18 @@
+# Find liburing
+# Once done this will define
+#  LibUring_FOUND - liburing found
+#  LibUring_INCLUDE_DIRS - liburing include directories
+#  LibUring_LIBRARIES - liburing libraries
+find_path(LibUring_INCLUDE_DIR liburing.h)
+find_library(LibUring_LIBRARY NAMES uring PATH_SUFFIXES lib lib64)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LibUring DEFAULT_MSG
+  LibUring_LIBRARY LibUring_INCLUDE_DIR)
+
+if(LibUring_FOUND)
+  set(LibUring_INCLUDE_DIRS ${LibUring_INCLUDE_DIR})
+  set(LibUring_LIBRARIES ${LibUring_LIBRARY})
+endif()
+
+mark_as_advanced(LibUring_INCLUDE_DIR LibUring_LIBRARY)
@@ -27,6 +27,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <boost/utility.hpp>
 
@@ -106,6 +107,36 @@ public:
   }
 };
 
+//! Socket-local heaps: all threads on a socket share one source heap behind
+//! a socket-local lock. Compared to ThreadPrivateHeap this trades a lock for
+//! fewer, denser arenas whose slabs stay on the socket that uses them; layer
+//! a per-thread batching heap (e.g. MagazineFreeListHeap) on top so the lock
+//! is only taken when a batch runs out. Only suitable for source heaps whose
+//! deallocate ignores its argument, since a pointer may be freed from a
+//! different socket than the one that allocated it.
+template <class SourceHeap>
+class PerSocketHeap {
+  PerSocketStorage<LockedHeap<SourceHeap>> heaps;
+
+public:
+  enum { AllocSize = SourceHeap::AllocSize };
+
+  ~PerSocketHeap() { clear(); }
+
+  inline void* allocate(size_t size) {
+    return heaps.getLocal()->allocate(size);
+  }
+
+  inline void deallocate(void* ptr) { heaps.getLocal()->deallocate(ptr); }
+
+  void clear() {
+    auto& tp = GetThreadPool();
+    for (unsigned i = 0; i < tp.getMaxSockets(); ++i) {
+      heaps.getRemoteByPkg(i)->clear();
+    }
+  }
+};
+
 template <typename SourceHeap>
 class ZeroOut : public SourceHeap {
 public:
@@ -265,6 +296,103 @@ public:
   }
 };
 
+//! Maintain per-thread freelists (magazines) with lazy return through a
+//! shared depot. Each thread fills an active magazine of kMagazineSize
+//! entries plus one full spare before parking a full magazine in the depot,
+//! where any thread may pick it up. In steady state alloc/free pairs never
+//! leave the calling thread, and a producer/consumer imbalance (one thread
+//! freeing chunks another allocates, as worklist churn does) touches the
+//! depot lock only once per kMagazineSize operations instead of growing the
+//! freeing thread's list forever while the allocating thread goes back to
+//! the page pool. The source heap is used as given and must be safe to
+//! call from any thread; wrap it in ThreadPrivateHeap or PerSocketHeap to
+//! pick the arena granularity. Intended for bump-style heaps whose
+//! deallocate is a no-op and that reclaim their slabs on clear().
+template <class SourceHeap>
+class MagazineFreeListHeap {
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  // the active magazine plus one full spare; swapping between them keeps
+  // allocate and deallocate strictly O(1)
+  struct Magazines {
+    FreeNode* cur = nullptr;
+    unsigned curCount = 0;
+    FreeNode* full = nullptr;
+  };
+
+  static constexpr unsigned kMagazineSize = 64;
+
+  SourceHeap inner;
+  PerThreadStorage<Magazines> mags;
+  SimpleLock depotLock;
+  std::vector<FreeNode*> depot;  // full magazines
+
+public:
+  enum { AllocSize = SourceHeap::AllocSize };
+
+  ~MagazineFreeListHeap() { clear(); }
+
+  void clear() {
+    // the entries live inside SourceHeap slabs, so dropping the lists and
+    // clearing the source heaps is enough
+    for (unsigned i = 0; i < mags.size(); ++i) {
+      *mags.getRemote(i) = Magazines();
+    }
+    depotLock.lock();
+    depot.clear();
+    depotLock.unlock();
+    inner.clear();
+  }
+
+  inline void* allocate(size_t size) {
+    Magazines& m = *mags.getLocal();
+    if (!m.cur) {
+      if (m.full) {
+        m.cur = m.full;
+        m.full = nullptr;
+        m.curCount = kMagazineSize;
+      } else {
+        depotLock.lock();
+        if (!depot.empty()) {
+          m.cur = depot.back();
+          depot.pop_back();
+          m.curCount = kMagazineSize;
+        }
+        depotLock.unlock();
+      }
+    }
+    if (m.cur) {
+      FreeNode* n = m.cur;
+      m.cur = n->next;
+      --m.curCount;
+      return n;
+    }
+    return inner.allocate(size);
+  }
+
+  inline void deallocate(void* ptr) {
+    if (!ptr) {
+      return;
+    }
+    Magazines& m = *mags.getLocal();
+    FreeNode* n = static_cast<FreeNode*>(ptr);
+    n->next = m.cur;
+    m.cur = n;
+    if (++m.curCount == kMagazineSize) {
+      if (m.full) {
+        depotLock.lock();
+        depot.push_back(m.full);
+        depotLock.unlock();
+      }
+      m.full = m.cur;
+      m.cur = nullptr;
+      m.curCount = 0;
+    }
+  }
+};
+
 template <unsigned ElemSize, typename SourceHeap>
 class BlockHeap : public SourceHeap {
   struct TyEq {
@@ -484,6 +612,104 @@ public:
   inline void deallocate(void*) {}
 };
 
+/**
+ * This implements a bump pointer over chunks of memory that are retained
+ * when the heap is rewound: rewind() is O(1) and later rounds reuse the
+ * chunks of earlier rounds instead of going back to the source heap.
+ * Allocations larger than a chunk fall back to malloc and are freed on
+ * rewind.
+ */
+template <typename SourceHeap>
+class BumpRewindHeap : public SourceHeap {
+  struct Block {
+    union {
+      Block* next;
+      double dummy;  // for alignment
+    };
+  };
+
+  Block* head;          // first chunk, in allocation order
+  Block* cur;           // chunk currently bumped into
+  Block* fallbackHead;  // oversize malloc allocations
+  int offset;
+
+  void refill() {
+    if (cur && cur->next) {
+      // Reuse a chunk retained by rewind()
+      cur = cur->next;
+    } else {
+      Block* BP = (Block*)SourceHeap::allocate(SourceHeap::AllocSize);
+      BP->next = nullptr;
+      if (cur)
+        cur->next = BP;
+      else
+        head = BP;
+      cur = BP;
+    }
+    offset = sizeof(Block);
+  }
+
+public:
+  enum { AllocSize = 0 };
+
+  BumpRewindHeap()
+      : SourceHeap(),
+        head(nullptr),
+        cur(nullptr),
+        fallbackHead(nullptr),
+        offset(0) {}
+
+  ~BumpRewindHeap() { clear(); }
+
+  //! Make all retained chunks available for reuse without returning them to
+  //! the source heap; only oversize fallback allocations go back to malloc.
+  void rewind() {
+    cur = head;
+    offset = sizeof(Block);
+    while (fallbackHead) {
+      Block* B = fallbackHead;
+      fallbackHead = B->next;
+      free(B);
+    }
+  }
+
+  void clear() {
+    while (head) {
+      Block* B = head;
+      head = B->next;
+      SourceHeap::deallocate(B);
+    }
+    cur = nullptr;
+    offset = 0;
+    while (fallbackHead) {
+      Block* B = fallbackHead;
+      fallbackHead = B->next;
+      free(B);
+    }
+  }
+
+  inline void* allocate(size_t size) {
+    // Increase to alignment
+    size_t alignedSize = (size + sizeof(double) - 1) & ~(sizeof(double) - 1);
+    if (sizeof(Block) + alignedSize > SourceHeap::AllocSize) {
+      void* p = malloc(alignedSize + sizeof(Block));
+      Block* BP = (Block*)p;
+      BP->next = fallbackHead;
+      fallbackHead = BP;
+      return (char*)p + sizeof(Block);
+    }
+    // Check current block
+    if (!cur || offset + alignedSize > SourceHeap::AllocSize)
+      refill();
+    char* retval = (char*)cur;
+    retval += offset;
+    offset += alignedSize;
+    return retval;
+  }
+
+  inline void deallocate(void*) {}
+};
+
 //! This is the base source of memory for all allocators.
 //! It maintains a freelist of chunks acquired from the system
 class KATANA_EXPORT SystemHeap {
@@ -565,7 +791,8 @@ class KATANA_EXPORT SizedHeapFactory
 
 public:
   //! [FixedSizeAllocator example]
-  typedef ThreadPrivateHeap<FreeListHeap<BumpHeap<SystemHeap>>> SizedHeap;
+  typedef MagazineFreeListHeap<ThreadPrivateHeap<BumpHeap<SystemHeap>>>
+      SizedHeap;
   //! [FixedSizeAllocator example]
 
   static SizedHeap* getHeapForSize(size_t);
@@ -1,9 +1,11 @@
 #include <arrow/api.h>
 
 #include "katana/ErrorCode.h"
+#include "katana/Galois.h"
 #include "katana/Logging.h"
 #include "katana/NUMAArray.h"
 #include "katana/Properties.h"
+#include "katana/Reduction.h"
 #include "katana/Result.h"
 
 namespace katana {
@@ -87,40 +89,102 @@ public:
   size_t size() const { return data_.size(); }
 
   katana::Result<void> Finalize(std::shared_ptr<arrow::Array>* array) const {
-    using ArrowBuilder = typename arrow::TypeTraits<ArrowType>::BuilderType;
-    ArrowBuilder builder;
-    if (data_.size() > 0) {
-      if constexpr (std::is_scalar_v<value_type>) {
-        // TODO(danielmawhirter) find a better way to handle this
-        // arrow::NumericBuilder has:
-        // AppendValues(value_type*, int64_t, uint8_t*)
-        // AppendValues(value_type*, int64_t, vector<bool>)
-        // AppendValues(vector<value_type>, vector<bool>)
-        if (auto r =
-                builder.AppendValues(data_.data(), data_.size(), valid_.data());
-            !r.ok()) {
-          KATANA_LOG_DEBUG("arrow error: {}", r);
-          return katana::ErrorCode::ArrowError;
-        }
-      } else {
-        // TODO(danielmawhirter) find a better way to handle this
-        // arrow::BinaryBuilder has:
-        // AppendValues(vector<string>, uint8_t*)
-        // AppendValues(char**, int64_t, uint8_t*)
+    if constexpr (std::is_scalar_v<value_type>) {
+      return FinalizeFixedWidth(array);
+    } else {
+      // TODO(danielmawhirter) find a better way to handle this
+      // arrow::BinaryBuilder has:
+      // AppendValues(vector<string>, uint8_t*)
+      // AppendValues(char**, int64_t, uint8_t*)
+      using ArrowBuilder = typename arrow::TypeTraits<ArrowType>::BuilderType;
+      ArrowBuilder builder;
+      if (data_.size() > 0) {
         if (auto r = builder.AppendValues(data_, valid_.data()); !r.ok()) {
           KATANA_LOG_DEBUG("arrow error: {}", r);
           return katana::ErrorCode::ArrowError;
         }
       }
+      if (auto r = builder.Finish(array); !r.ok()) {
+        KATANA_LOG_DEBUG("arrow error: {}", r);
+        return katana::ErrorCode::ArrowError;
+      }
+      return katana::ResultSuccess();
     }
-    if (auto r = builder.Finish(array); !r.ok()) {
-      KATANA_LOG_DEBUG("arrow error: {}", r);
-      return katana::ErrorCode::ArrowError;
+  }
+
+private:
+  /// Pack bytes[begin, min(begin + 8, end)) into the byte holding bit begin of
+  /// bitmap; begin must be a multiple of 8 so writes never share a byte
+  static void PackBitmapByte(
+      const uint8_t* bytes, size_t begin, size_t end, uint8_t* bitmap) {
+    uint8_t bits = 0;
+    size_t stop = std::min(begin + 8, end);
+    for (size_t i = begin; i < stop; ++i) {
+      if (bytes[i]) {
+        bits |= uint8_t{1} << (i - begin);
+      }
     }
+    bitmap[begin / 8] = bits;
+  }
+
+  /// Assemble the validity bitmap and value buffer directly rather than
+  /// through an arrow builder, which appends one bit at a time; each thread
+  /// owns whole bitmap bytes so no synchronization is needed
+  katana::Result<void> FinalizeFixedWidth(
+      std::shared_ptr<arrow::Array>* array) const {
+    const int64_t length = data_.size();
+    const size_t num_bytes = arrow::BitUtil::BytesForBits(length);
+
+    std::shared_ptr<arrow::Buffer> validity =
+        KATANA_CHECKED(arrow::AllocateEmptyBitmap(length));
+    uint8_t* validity_data = validity->mutable_data();
+    katana::GAccumulator<int64_t> null_count;
+    katana::do_all(
+        katana::iterate(size_t{0}, num_bytes),
+        [&](size_t byte) {
+          PackBitmapByte(valid_.data(), byte * 8, data_.size(), validity_data);
+          size_t stop = std::min(byte * 8 + 8, data_.size());
+          for (size_t i = byte * 8; i < stop; ++i) {
+            if (!valid_[i]) {
+              null_count += 1;
+            }
+          }
+        },
+        katana::no_stats());
+
+    std::shared_ptr<arrow::Buffer> values;
+    if constexpr (arrow::is_boolean_type<ArrowType>::value) {
+      values = KATANA_CHECKED(arrow::AllocateEmptyBitmap(length));
+      uint8_t* values_data = values->mutable_data();
+      katana::do_all(
+          katana::iterate(size_t{0}, num_bytes),
+          [&](size_t byte) {
+            PackBitmapByte(data_.data(), byte * 8, data_.size(), values_data);
+          },
+          katana::no_stats());
+    } else {
+      values = KATANA_CHECKED(
+          arrow::AllocateBuffer(length * int64_t{sizeof(StorageType)}));
+      auto* dest = reinterpret_cast<StorageType*>(values->mutable_data());
+      constexpr size_t kCopyBlock = size_t{1} << 16;
+      katana::do_all(
+          katana::iterate(
+              size_t{0}, (data_.size() + kCopyBlock - 1) / kCopyBlock),
+          [&](size_t block) {
+            size_t begin = block * kCopyBlock;
+            size_t count = std::min(kCopyBlock, data_.size() - begin);
+            std::copy_n(data_.data() + begin, count, dest + begin);
+          },
+          katana::no_stats());
+    }
+
+    auto array_data = arrow::ArrayData::Make(
+        arrow::TypeTraits<ArrowType>::type_singleton(), length,
+        {std::move(validity), std::move(values)}, null_count.reduce());
+    *array = arrow::MakeArray(array_data);
     return katana::ResultSuccess();
   }
 
-private:
   std::vector<StorageType> data_;
   std::vector<uint8_t> valid_;
 };
@@ -69,6 +69,16 @@ KATANA_EXPORT std::unique_ptr<Barrier> CreateMCSBarrier(unsigned);
 KATANA_EXPORT std::unique_ptr<Barrier> CreateTopoBarrier(unsigned);
 KATANA_EXPORT std::unique_ptr<Barrier> CreateCountingBarrier(unsigned);
 KATANA_EXPORT std::unique_ptr<Barrier> CreateDisseminationBarrier(unsigned);
+KATANA_EXPORT std::unique_ptr<Barrier> CreateCombiningBarrier(unsigned);
+
+/**
+ * Create a barrier that measures round length at runtime and switches
+ * between the topo and combining barriers: short bulk-synchronous rounds
+ * get the combining tree, whose bounded fan-in keeps arrival latency flat
+ * at high core counts, and anything else keeps the topo barrier. This is
+ * the system barrier unless KATANA_BARRIER picks a specific algorithm.
+ */
+KATANA_EXPORT std::unique_ptr<Barrier> CreateAdaptiveBarrier(unsigned);
 
 /**
  * Creates a new simple barrier. This barrier is not designed to be fast but
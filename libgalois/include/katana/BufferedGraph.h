@@ -26,7 +26,12 @@
 #ifndef KATANA_LIBGALOIS_KATANA_BUFFEREDGRAPH_H_
 #define KATANA_LIBGALOIS_KATANA_BUFFEREDGRAPH_H_
 
-#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <future>
+#include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
 
@@ -82,16 +87,100 @@ private:
   //! number of bytes read related to the edge data buffer
   katana::GAccumulator<uint64_t> numBytesReadEdgeData;
 
+  //! file handle reads are issued against; pread keeps it stateless so
+  //! concurrent loads can share it
+  int graphFd = -1;
+
+  //! bytes per asynchronous read task; large enough to amortize per-task
+  //! overhead, small enough that a load keeps several reads in flight
+  static constexpr uint64_t kAsyncChunkSize = UINT64_C(64) << 20;
+
+  /**
+   * Open the graph file for reading and remember the handle.
+   *
+   * @param filename name of the graph file
+   */
+  void openFile(const std::string& filename) {
+    KATANA_LOG_DEBUG_ASSERT(graphFd == -1);
+    graphFd = open(filename.c_str(), O_RDONLY);
+    if (graphFd == -1) {
+      KATANA_DIE("Failed to open graph file ", filename);
+    }
+  }
+
+  /**
+   * Close the graph file handle if one is open.
+   */
+  void closeFile() {
+    if (graphFd != -1) {
+      close(graphFd);
+      graphFd = -1;
+    }
+  }
+
+  /**
+   * Read the byte range [readPosition, readPosition + numBytes) of the
+   * graph file into a buffer. Uses pread, which carries no file cursor, so
+   * any number of these may run concurrently over one handle.
+   *
+   * @param dest buffer to read into
+   * @param numBytes number of bytes to read
+   * @param readPosition byte offset into the file to read from
+   */
+  void readRange(char* dest, uint64_t numBytes, uint64_t readPosition) {
+    uint64_t bytesRead = 0;
+    while (bytesRead < numBytes) {
+      ssize_t numRead = pread(
+          graphFd, dest + bytesRead, numBytes - bytesRead,
+          readPosition + bytesRead);
+      if (numRead <= 0) {
+        KATANA_DIE("Failed to read graph file range.");
+      }
+      bytesRead += numRead;
+    }
+  }
+
+  /**
+   * Read a byte range either synchronously or, if a future list is given,
+   * as a series of fixed-size chunks with one asynchronous task per chunk.
+   *
+   * @param futures if non-null, receives one future per issued chunk;
+   * if null the range is read before returning
+   * @param dest buffer to read into
+   * @param numBytes number of bytes to read
+   * @param readPosition byte offset into the file to read from
+   */
+  void issueRead(
+      std::vector<std::future<void>>* futures, char* dest, uint64_t numBytes,
+      uint64_t readPosition) {
+    if (futures == nullptr) {
+      readRange(dest, numBytes, readPosition);
+      return;
+    }
+    for (uint64_t chunkOffset = 0; chunkOffset < numBytes;
+         chunkOffset += kAsyncChunkSize) {
+      uint64_t chunkBytes = std::min(kAsyncChunkSize, numBytes - chunkOffset);
+      futures->emplace_back(std::async(
+          std::launch::async, [this, dest, chunkOffset, chunkBytes,
+                               readPosition]() {
+            readRange(dest + chunkOffset, chunkBytes, readPosition + chunkOffset);
+          }));
+    }
+  }
+
   /**
    * Load the out indices (i.e. where a particular node's edges begin in the
    * array of edges) from the file.
    *
-   * @param graphFile loaded file for the graph
    * @param nodeStart the first node to load
    * @param numNodesToLoad number of nodes to load
+   * @param futures if non-null, the reads are issued asynchronously and
+   * their futures appended here
    */
   void loadOutIndex(
-      std::ifstream& graphFile, uint64_t nodeStart, uint64_t numNodesToLoad) {
+      uint64_t nodeStart, uint64_t numNodesToLoad,
+      std::vector<std::future<void>>* futures = nullptr) {
+    nodeOffset = nodeStart;
     if (numNodesToLoad == 0) {
       return;
     }
@@ -104,35 +193,26 @@ private:
 
     // position to start of contiguous chunk of nodes to read
     uint64_t readPosition = (4 + nodeStart) * sizeof(uint64_t);
-    graphFile.seekg(readPosition);
-
-    uint64_t numBytesToLoad = numNodesToLoad * sizeof(uint64_t);
-    uint64_t bytesRead = 0;
-
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->outIndexBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    KATANA_LOG_DEBUG_ASSERT(numBytesToLoad == 0);
-
-    nodeOffset = nodeStart;
+    issueRead(
+        futures, (char*)this->outIndexBuffer,
+        numNodesToLoad * sizeof(uint64_t), readPosition);
   }
 
   /**
    * Load the edge destination information from the file.
    *
-   * @param graphFile loaded file for the graph
    * @param edgeStart the first edge to load
    * @param numEdgesToLoad number of edges to load
    * @param numGlobalNodes total number of nodes in the graph file; needed
    * to determine offset into the file
+   * @param futures if non-null, the reads are issued asynchronously and
+   * their futures appended here
    */
   void loadEdgeDest(
-      std::ifstream& graphFile, uint64_t edgeStart, uint64_t numEdgesToLoad,
-      uint64_t numGlobalNodes) {
+      uint64_t edgeStart, uint64_t numEdgesToLoad, uint64_t numGlobalNodes,
+      std::vector<std::future<void>>* futures = nullptr) {
+    // save edge offset of this graph for later use
+    edgeOffset = edgeStart;
     if (numEdgesToLoad == 0) {
       return;
     }
@@ -147,20 +227,9 @@ private:
     // position to start of contiguous chunk of edges to read
     uint64_t readPosition = (4 + numGlobalNodes) * sizeof(uint64_t) +
                             (sizeof(uint32_t) * edgeStart);
-    graphFile.seekg(readPosition);
-
-    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(uint32_t);
-    uint64_t bytesRead = 0;
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->edgeDestBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    KATANA_LOG_DEBUG_ASSERT(numBytesToLoad == 0);
-    // save edge offset of this graph for later use
-    edgeOffset = edgeStart;
+    issueRead(
+        futures, (char*)this->edgeDestBuffer,
+        numEdgesToLoad * sizeof(uint32_t), readPosition);
   }
 
   /**
@@ -174,13 +243,16 @@ private:
    * to determine offset into the file
    * @param numGlobalEdges total number of edges in the graph file; needed
    * to determine offset into the file
+   * @param futures if non-null, the reads are issued asynchronously and
+   * their futures appended here
    */
   template <
       typename EdgeType,
       typename std::enable_if<!std::is_void<EdgeType>::value>::type* = nullptr>
   void loadEdgeData(
-      std::ifstream& graphFile, uint64_t edgeStart, uint64_t numEdgesToLoad,
-      uint64_t numGlobalNodes, uint64_t numGlobalEdges) {
+      uint64_t edgeStart, uint64_t numEdgesToLoad, uint64_t numGlobalNodes,
+      uint64_t numGlobalEdges,
+      std::vector<std::future<void>>* futures = nullptr) {
     katana::gDebug("Loading edge data");
 
     if (numEdgesToLoad == 0) {
@@ -207,18 +279,9 @@ private:
     // jump to first byte of edge data
     uint64_t readPosition =
         baseReadPosition + (sizeof(EdgeDataType) * edgeStart);
-    graphFile.seekg(readPosition);
-    uint64_t numBytesToLoad = numEdgesToLoad * sizeof(EdgeDataType);
-    uint64_t bytesRead = 0;
-
-    while (numBytesToLoad > 0) {
-      graphFile.read(((char*)this->edgeDataBuffer) + bytesRead, numBytesToLoad);
-      size_t numRead = graphFile.gcount();
-      numBytesToLoad -= numRead;
-      bytesRead += numRead;
-    }
-
-    KATANA_LOG_DEBUG_ASSERT(numBytesToLoad == 0);
+    issueRead(
+        futures, (char*)this->edgeDataBuffer,
+        numEdgesToLoad * sizeof(EdgeDataType), readPosition);
   }
 
   /**
@@ -232,7 +295,9 @@ private:
   template <
       typename EdgeType,
       typename std::enable_if<std::is_void<EdgeType>::value>::type* = nullptr>
-  void loadEdgeData(std::ifstream&, uint64_t, uint64_t, uint64_t, uint64_t) {
+  void loadEdgeData(
+      uint64_t, uint64_t, uint64_t, uint64_t,
+      std::vector<std::future<void>>* = nullptr) {
     katana::gDebug("Not loading edge data");
     // do nothing (edge data is void, i.e. no edge data)
   }
@@ -252,7 +317,7 @@ private:
   }
 
   /**
-   * Free all of the buffers in memory.
+   * Free all of the buffers in memory and close the file handle.
    */
   void freeMemory() {
     free(outIndexBuffer);
@@ -261,6 +326,7 @@ private:
     edgeDestBuffer = nullptr;
     free(edgeDataBuffer);
     edgeDataBuffer = nullptr;
+    closeFile();
   }
 
 public:
@@ -311,27 +377,29 @@ public:
    *
    * @param filename name of graph to load; should be in Galois binary graph
    * format
+   * @param withEdgeData if false, skip loading edge data even when
+   * EdgeDataType is non-void; topology-only consumers save the read and
+   * the memory
    */
-  void loadGraph(const std::string& filename) {
+  void loadGraph(const std::string& filename, bool withEdgeData = true) {
     if (graphLoaded) {
       KATANA_DIE("Cannot load an buffered graph more than once.");
     }
 
-    std::ifstream graphFile(filename.c_str());
+    openFile(filename);
     uint64_t header[4];
-    graphFile.read(((char*)header), sizeof(uint64_t) * 4);
+    readRange((char*)header, sizeof(uint64_t) * 4, 0);
 
     numLocalNodes = globalSize = header[2];
     numLocalEdges = globalEdgeSize = header[3];
 
-    loadOutIndex(graphFile, 0, globalSize);
-    loadEdgeDest(graphFile, 0, globalEdgeSize, globalSize);
-    // may or may not do something depending on EdgeDataType
-    loadEdgeData<EdgeDataType>(
-        graphFile, 0, globalEdgeSize, globalSize, globalEdgeSize);
+    loadOutIndex(0, globalSize);
+    loadEdgeDest(0, globalEdgeSize, globalSize);
+    if (withEdgeData) {
+      // may or may not do something depending on EdgeDataType
+      loadEdgeData<EdgeDataType>(0, globalEdgeSize, globalSize, globalEdgeSize);
+    }
     graphLoaded = true;
-
-    graphFile.close();
   }
 
   /**
@@ -347,34 +415,95 @@ public:
    * @param edgeEnd Last edge to load, non-inclusive
    * @param numGlobalNodes Total number of nodes in the graph
    * @param numGlobalEdges Total number of edges in the graph
+   * @param withEdgeData if false, skip loading edge data even when
+   * EdgeDataType is non-void
    */
   void loadPartialGraph(
       const std::string& filename, uint64_t nodeStart, uint64_t nodeEnd,
       uint64_t edgeStart, uint64_t edgeEnd, uint64_t numGlobalNodes,
-      uint64_t numGlobalEdges) {
+      uint64_t numGlobalEdges, bool withEdgeData = true) {
     if (graphLoaded) {
       KATANA_DIE("Cannot load an buffered graph more than once.");
     }
 
-    std::ifstream graphFile(filename.c_str());
+    openFile(filename);
 
     globalSize = numGlobalNodes;
     globalEdgeSize = numGlobalEdges;
 
     KATANA_LOG_DEBUG_ASSERT(nodeEnd >= nodeStart);
     numLocalNodes = nodeEnd - nodeStart;
-    loadOutIndex(graphFile, nodeStart, numLocalNodes);
+    loadOutIndex(nodeStart, numLocalNodes);
 
     KATANA_LOG_DEBUG_ASSERT(edgeEnd >= edgeStart);
     numLocalEdges = edgeEnd - edgeStart;
-    loadEdgeDest(graphFile, edgeStart, numLocalEdges, numGlobalNodes);
+    loadEdgeDest(edgeStart, numLocalEdges, numGlobalNodes);
 
-    // may or may not do something depending on EdgeDataType
-    loadEdgeData<EdgeDataType>(
-        graphFile, edgeStart, numLocalEdges, numGlobalNodes, numGlobalEdges);
+    if (withEdgeData) {
+      // may or may not do something depending on EdgeDataType
+      loadEdgeData<EdgeDataType>(
+          edgeStart, numLocalEdges, numGlobalNodes, numGlobalEdges);
+    }
+    graphLoaded = true;
+  }
+
+  /**
+   * Asynchronous version of loadPartialGraph: allocates the buffers, issues
+   * every read as fixed-size chunks with one task each so a cold load keeps
+   * several reads in flight, and returns without waiting. The returned
+   * future completes once every chunk has been read; accessors must not be
+   * used before then. Reads use pread over one file handle, so several
+   * ranges (from this or other BufferedGraphs) can load concurrently from
+   * the same file.
+   *
+   * @param filename name of graph to load; should be in Galois binary graph
+   * format
+   * @param nodeStart First node to load
+   * @param nodeEnd Last node to load, non-inclusive
+   * @param edgeStart First edge to load; should correspond to first edge of
+   * first node
+   * @param edgeEnd Last edge to load, non-inclusive
+   * @param numGlobalNodes Total number of nodes in the graph
+   * @param numGlobalEdges Total number of edges in the graph
+   * @param withEdgeData if false, skip loading edge data even when
+   * EdgeDataType is non-void
+   * @returns future that completes when the whole range is in memory
+   */
+  std::future<void> loadPartialGraphAsync(
+      const std::string& filename, uint64_t nodeStart, uint64_t nodeEnd,
+      uint64_t edgeStart, uint64_t edgeEnd, uint64_t numGlobalNodes,
+      uint64_t numGlobalEdges, bool withEdgeData = true) {
+    if (graphLoaded) {
+      KATANA_DIE("Cannot load an buffered graph more than once.");
+    }
+
+    openFile(filename);
+
+    globalSize = numGlobalNodes;
+    globalEdgeSize = numGlobalEdges;
+
+    auto futures = std::make_shared<std::vector<std::future<void>>>();
+
+    KATANA_LOG_DEBUG_ASSERT(nodeEnd >= nodeStart);
+    numLocalNodes = nodeEnd - nodeStart;
+    loadOutIndex(nodeStart, numLocalNodes, futures.get());
+
+    KATANA_LOG_DEBUG_ASSERT(edgeEnd >= edgeStart);
+    numLocalEdges = edgeEnd - edgeStart;
+    loadEdgeDest(edgeStart, numLocalEdges, numGlobalNodes, futures.get());
+
+    if (withEdgeData) {
+      loadEdgeData<EdgeDataType>(
+          edgeStart, numLocalEdges, numGlobalNodes, numGlobalEdges,
+          futures.get());
+    }
     graphLoaded = true;
 
-    graphFile.close();
+    return std::async(std::launch::async, [futures]() {
+      for (std::future<void>& f : *futures) {
+        f.get();
+      }
+    });
   }
 
   /**
@@ -16,6 +16,8 @@
 #include <arrow/stl.h>
 #include <arrow/type.h>
 
+#include "katana/ConcurrentFlatMap.h"
+#include "katana/PODVector.h"
 #include "katana/PropertyGraph.h"
 
 namespace katana {
@@ -113,11 +115,11 @@ struct LabelsState {
 
 struct TopologyState {
   // maps node IDs to node indexes
-  std::unordered_map<std::string, size_t> node_indexes;
+  ConcurrentFlatMap<std::string, size_t> node_indexes;
   // node's start of edge lists
   std::vector<uint64_t> out_indices;
   // edge list of destinations
-  std::vector<uint32_t> out_dests;
+  PODVector<uint32_t> out_dests;
   // list of sources of edges
   std::vector<uint32_t> sources;
   // list of destinations of edges
@@ -0,0 +1,237 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_CONCURRENTFLATMAP_H_
+#define KATANA_LIBGALOIS_KATANA_CONCURRENTFLATMAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "katana/PODVector.h"
+#include "katana/SimpleLock.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * An open-addressing hash map with linear probing, sharded into
+ * independently locked and independently grown stripes.
+ *
+ * Each stripe owns a flat slot array, so lookups and inserts touch one
+ * cache-friendly probe sequence instead of chasing tree or bucket-list
+ * nodes, and a stripe that hits its load factor rehashes only itself while
+ * the other stripes keep serving operations. With a single stripe it
+ * degenerates to a plain (uncontended-lock) flat hash map, which is the
+ * right shape for thread-local scratch maps as well.
+ *
+ * The interface is deliberately narrow: find() returns a pointer into the
+ * table that stays valid only until the next insert into the same stripe,
+ * and for_each()/size() are exact only when no concurrent mutation is in
+ * flight. Erasure is not supported.
+ */
+template <
+    typename Key, typename T, typename Hash = std::hash<Key>,
+    typename KeyEqual = std::equal_to<Key>>
+class ConcurrentFlatMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+
+  static constexpr size_t kDefaultStripes = 16;
+
+private:
+  static constexpr uint8_t kEmpty = 0;
+  static constexpr uint8_t kFull = 1;
+  static constexpr size_t kMinStripeCapacity = 16;
+
+  struct Stripe {
+    mutable SimpleLock lock;
+    PODVector<uint8_t> states;
+    std::vector<value_type> slots;
+    size_t size{0};
+  };
+
+  std::vector<Stripe> stripes_;
+  size_t stripe_mask_;
+  Hash hash_;
+  KeyEqual key_equal_;
+
+  static size_t RoundUpToPowerOf2(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  Stripe& StripeFor(size_t hash) { return stripes_[hash & stripe_mask_]; }
+  const Stripe& StripeFor(size_t hash) const {
+    return stripes_[hash & stripe_mask_];
+  }
+
+  //! The stripe is selected by the low hash bits, so probe sequences within
+  //! a stripe use the remaining bits.
+  size_t SlotHash(size_t hash) const { return hash >> 4; }
+
+  void GrowStripe(Stripe& stripe, size_t new_capacity) {
+    std::vector<value_type> old_slots(new_capacity);
+    PODVector<uint8_t> new_states;
+    new_states.resize(new_capacity);
+    std::fill(new_states.begin(), new_states.end(), kEmpty);
+    old_slots.swap(stripe.slots);
+    PODVector<uint8_t> old_states = std::move(stripe.states);
+    stripe.states = std::move(new_states);
+
+    size_t mask = stripe.slots.size() - 1;
+    for (size_t i = 0; i < old_slots.size(); ++i) {
+      if (old_states[i] != kFull) {
+        continue;
+      }
+      size_t j = SlotHash(hash_(old_slots[i].first)) & mask;
+      while (stripe.states[j] == kFull) {
+        j = (j + 1) & mask;
+      }
+      stripe.slots[j] = std::move(old_slots[i]);
+      stripe.states[j] = kFull;
+    }
+  }
+
+  //! Grow when the stripe passes a 70% load factor.
+  void GrowIfNeeded(Stripe& stripe) {
+    if (stripe.slots.empty()) {
+      GrowStripe(stripe, kMinStripeCapacity);
+    } else if (10 * (stripe.size + 1) > 7 * stripe.slots.size()) {
+      GrowStripe(stripe, 2 * stripe.slots.size());
+    }
+  }
+
+  template <typename StripeTy, typename ValueTy>
+  static ValueTy* FindLocked(
+      StripeTy& stripe, const Key& key, size_t slot_hash,
+      const KeyEqual& key_equal) {
+    if (stripe.slots.empty()) {
+      return nullptr;
+    }
+    size_t mask = stripe.slots.size() - 1;
+    for (size_t i = slot_hash & mask;; i = (i + 1) & mask) {
+      if (stripe.states[i] == kEmpty) {
+        return nullptr;
+      }
+      if (key_equal(stripe.slots[i].first, key)) {
+        return &stripe.slots[i].second;
+      }
+    }
+  }
+
+public:
+  explicit ConcurrentFlatMap(size_t num_stripes = kDefaultStripes)
+      : stripes_(RoundUpToPowerOf2(std::max<size_t>(num_stripes, 1))),
+        stripe_mask_(stripes_.size() - 1) {}
+
+  //! Returns a pointer to the mapped value or null. The pointer stays valid
+  //! until the next insert into the same stripe.
+  T* find(const Key& key) {
+    size_t h = hash_(key);
+    Stripe& stripe = StripeFor(h);
+    std::lock_guard<SimpleLock> guard(stripe.lock);
+    return FindLocked<Stripe, T>(stripe, key, SlotHash(h), key_equal_);
+  }
+
+  const T* find(const Key& key) const {
+    size_t h = hash_(key);
+    const Stripe& stripe = StripeFor(h);
+    std::lock_guard<SimpleLock> guard(stripe.lock);
+    return FindLocked<const Stripe, const T>(
+        stripe, key, SlotHash(h), key_equal_);
+  }
+
+  //! Inserts the key with the given value unless the key is present.
+  //! Returns the mapped value and whether this call inserted it.
+  std::pair<T*, bool> insert(const Key& key, T value) {
+    size_t h = hash_(key);
+    Stripe& stripe = StripeFor(h);
+    std::lock_guard<SimpleLock> guard(stripe.lock);
+    GrowIfNeeded(stripe);
+    size_t mask = stripe.slots.size() - 1;
+    for (size_t i = SlotHash(h) & mask;; i = (i + 1) & mask) {
+      if (stripe.states[i] == kEmpty) {
+        stripe.slots[i] = value_type(key, std::move(value));
+        stripe.states[i] = kFull;
+        stripe.size++;
+        return {&stripe.slots[i].second, true};
+      }
+      if (key_equal_(stripe.slots[i].first, key)) {
+        return {&stripe.slots[i].second, false};
+      }
+    }
+  }
+
+  //! Pre-sizes every stripe for an expected total number of keys.
+  void reserve(size_t total) {
+    size_t per_stripe = RoundUpToPowerOf2(std::max<size_t>(
+        kMinStripeCapacity, 2 * (total / stripes_.size() + 1)));
+    for (Stripe& stripe : stripes_) {
+      std::lock_guard<SimpleLock> guard(stripe.lock);
+      if (stripe.slots.size() < per_stripe) {
+        GrowStripe(stripe, per_stripe);
+      }
+    }
+  }
+
+  size_t size() const {
+    size_t total = 0;
+    for (const Stripe& stripe : stripes_) {
+      std::lock_guard<SimpleLock> guard(stripe.lock);
+      total += stripe.size;
+    }
+    return total;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (Stripe& stripe : stripes_) {
+      std::lock_guard<SimpleLock> guard(stripe.lock);
+      std::fill(stripe.states.begin(), stripe.states.end(), kEmpty);
+      stripe.size = 0;
+    }
+  }
+
+  //! Applies fn to every (const Key&, T&) pair. Only meaningful while no
+  //! other thread is mutating the map.
+  template <typename Fn>
+  void for_each(Fn&& fn) {
+    for (Stripe& stripe : stripes_) {
+      std::lock_guard<SimpleLock> guard(stripe.lock);
+      for (size_t i = 0; i < stripe.slots.size(); ++i) {
+        if (stripe.states[i] == kFull) {
+          fn(stripe.slots[i].first, stripe.slots[i].second);
+        }
+      }
+    }
+  }
+};
+
+}  // namespace katana
+
+#endif
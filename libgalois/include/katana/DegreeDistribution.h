@@ -0,0 +1,80 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_DEGREEDISTRIBUTION_H_
+#define KATANA_LIBGALOIS_KATANA_DEGREEDISTRIBUTION_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "katana/GraphTopology.h"
+#include "katana/PODVector.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// DegreeDistribution summarizes a topology's out-degree distribution as
+/// the node ids sorted by out-degree along with their degrees. Building it
+/// is one parallel sort; afterwards percentile queries are O(1), top-k
+/// queries are O(k) and threshold counts are O(log n), so callers stop
+/// rescanning OutDegree over every node for each question they ask.
+///
+/// PropertyGraph caches one per topology
+/// (\see PropertyGraph::GetDegreeDistribution); the cache is dropped with
+/// the topology itself.
+class KATANA_EXPORT DegreeDistribution {
+public:
+  using Node = GraphTopology::Node;
+
+  /// Builds the distribution from a topology in parallel.
+  static DegreeDistribution Make(const GraphTopology& topo);
+
+  /// Number of nodes summarized.
+  size_t num_nodes() const { return degrees_.size(); }
+
+  /// The out-degree at percentile \p p of the node population, with p in
+  /// [0.0, 1.0]; p = 0.5 is the median and p = 1.0 the maximum. An empty
+  /// graph reports 0.
+  uint64_t DegreePercentile(double p) const;
+
+  /// The largest out-degree in the graph.
+  uint64_t max_degree() const {
+    return degrees_.empty() ? 0 : degrees_[degrees_.size() - 1];
+  }
+
+  /// The \p k nodes of highest out-degree, highest first; ties are broken
+  /// arbitrarily and k is clamped to the number of nodes.
+  std::vector<Node> TopKByDegree(size_t k) const;
+
+  /// Number of nodes whose out-degree is at least \p degree.
+  size_t NumNodesWithDegreeAtLeast(uint64_t degree) const;
+
+private:
+  DegreeDistribution(PODVector<Node>&& nodes, PODVector<uint64_t>&& degrees)
+      : nodes_by_degree_(std::move(nodes)), degrees_(std::move(degrees)) {}
+
+  /// Node ids in ascending out-degree order.
+  PODVector<Node> nodes_by_degree_;
+  /// degrees_[i] is the out-degree of nodes_by_degree_[i].
+  PODVector<uint64_t> degrees_;
+};
+
+}  // namespace katana
+
+#endif
@@ -308,6 +308,23 @@ public:
    */
   void bitwise_xor(const DynamicBitset& other1, const DynamicBitset& other2);
 
+  /**
+   * Does an IN-PLACE bitwise and-not (this & ~other) of this bitset and
+   * another bitset; useful for subtracting a visited set from a frontier
+   *
+   * @param other Bitset whose set bits are cleared in this one
+   */
+  void bitwise_andnot(const DynamicBitset& other);
+
+  /**
+   * Does an IN-PLACE bitwise and-not of 2 passed in bitsets and saves to
+   * this bitset
+   *
+   * @param other1 Bitset to and with the complement of other2
+   * @param other2 Bitset whose complement is anded with other1
+   */
+  void bitwise_andnot(const DynamicBitset& other1, const DynamicBitset& other2);
+
   /**
    * Count how many bits are set in the bitset
    *
@@ -315,6 +332,41 @@ public:
    */
   size_t count() const;
 
+  /**
+   * Calls fn(index) for every set bit, in parallel. Bits are visited word
+   * at a time via count-trailing-zeros, so sparse bitsets do not pay for
+   * their zero words; within a word, indices ascend. Assumes the bitset is
+   * not updated concurrently. Do NOT call in a parallel region as it uses
+   * katana::do_all.
+   */
+  template <typename Fn>
+  void for_each_set_bit(Fn fn) const {
+    katana::do_all(
+        katana::iterate(size_t{0}, bitvec_.size()),
+        [&](size_t w) {
+          uint64_t word = bitvec_[w].load(std::memory_order_relaxed);
+          if (w == bitvec_.size() - 1 &&
+              (num_bits_ % kNumBitsInUint64) != 0) {
+            // mask off the padding bits past num_bits_, which bitwise_not
+            // may have set
+            word &= (uint64_t{1} << (num_bits_ % kNumBitsInUint64)) - 1;
+          }
+          while (word != 0) {
+#ifdef __GNUC__
+            uint32_t bit = __builtin_ctzll(word);
+#else
+            uint32_t bit = 0;
+            while (((word >> bit) & 1) == 0) {
+              ++bit;
+            }
+#endif
+            fn(w * kNumBitsInUint64 + bit);
+            word &= word - 1;  // clear the lowest set bit
+          }
+        },
+        katana::no_stats());
+  }
+
   /**
    * Returns a vector containing the set bits in this bitset in order
    * from left to right.
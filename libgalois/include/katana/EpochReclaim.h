@@ -0,0 +1,129 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_EPOCHRECLAIM_H_
+#define KATANA_LIBGALOIS_KATANA_EPOCHRECLAIM_H_
+
+#include <atomic>
+#include <vector>
+
+#include "katana/PerThreadStorage.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * Epoch-based memory reclamation for concurrently read data structures.
+ *
+ * Structures like concurrent_gslist and the MorphGraph edge storage unlink
+ * nodes while other threads may still be traversing them, so the memory
+ * cannot be returned to the allocator at the point of removal. Historically
+ * such memory was only reclaimed at loop boundaries (or never), which makes
+ * long-running mutation loops grow without bound.
+ *
+ * EpochManager defers reclamation instead: a remover unlinks an object and
+ * then retire()s it, and readers bracket traversals with an EpochGuard. A
+ * retired object is handed back to its reclaim function only after every
+ * thread registered with the ThreadPool has left the epoch in which the
+ * object was still reachable, so no guard-protected reader can hold a
+ * reference to it.
+ *
+ * Threads are registered implicitly through PerThreadStorage; there is one
+ * process-wide manager, accessible via GetEpochManager(). Reclamation is
+ * amortized: retired objects are buffered per thread and freed in batches as
+ * the global epoch advances. Readers that hold locks on the enclosing
+ * objects (MethodFlag::WRITE style access) do not need a guard; only
+ * unprotected traversals that race with removal do.
+ */
+class KATANA_EXPORT EpochManager {
+  struct ThreadState {
+    std::atomic<unsigned> localEpoch{0};
+    std::atomic<bool> active{false};
+    //! nesting depth of enter()/exit() on this thread
+    unsigned depth{0};
+  };
+
+  struct Retired {
+    void* ptr;
+    void (*reclaim)(void*);
+  };
+
+  struct LimboList {
+    //! retired objects bucketed by (retirement epoch % 3); a bucket is
+    //! reused, and therefore freed, three epochs after it was filled
+    std::vector<Retired> buckets[3];
+    //! epoch this thread last retired in
+    unsigned epoch{0};
+    unsigned sinceAdvance{0};
+  };
+
+  //! Number of retires a thread buffers before trying to advance the
+  //! global epoch
+  constexpr static unsigned kRetireBatch = 64;
+
+  std::atomic<unsigned> globalEpoch_{0};
+  PerThreadStorage<ThreadState> state_;
+  PerThreadStorage<LimboList> limbo_;
+
+  void tryAdvance();
+  static void freeBucket(std::vector<Retired>& bucket);
+
+public:
+  //! Marks the calling thread as reading epoch-protected structures.
+  //! Nesting is allowed; prefer EpochGuard.
+  void enter();
+
+  //! Leaves the protected region entered by the matching enter()
+  void exit();
+
+  /**
+   * Schedules an unlinked object for reclamation. The object must already
+   * be unreachable for threads entering after this call; reclaim(ptr) runs
+   * once no guard that could have observed the object remains active. May
+   * be called inside or outside a protected region.
+   */
+  void retire(void* ptr, void (*reclaim)(void*));
+
+  /**
+   * Immediately reclaims everything retired so far. Only safe when no
+   * thread is inside a protected region, e.g. between parallel loops.
+   */
+  void reclaimAll();
+};
+
+//! The process-wide reclamation manager
+KATANA_EXPORT EpochManager& GetEpochManager();
+
+//! RAII helper marking a reader's traversal of epoch-protected structures
+class EpochGuard {
+  EpochManager& manager_;
+
+public:
+  EpochGuard(EpochManager& manager = GetEpochManager()) : manager_(manager) {
+    manager_.enter();
+  }
+
+  EpochGuard(const EpochGuard&) = delete;
+  EpochGuard& operator=(const EpochGuard&) = delete;
+
+  ~EpochGuard() { manager_.exit(); }
+};
+
+}  // namespace katana
+#endif
@@ -0,0 +1,201 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_EPSILONORDEREDLIST_H_
+#define KATANA_LIBGALOIS_KATANA_EPSILONORDEREDLIST_H_
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "katana/PaddedLock.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/ThreadPool.h"
+#include "katana/WLCompileCheck.h"
+#include "katana/WorkListHelpers.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * Relaxed ordered worklist over continuous (float or 64-bit) priorities.
+ *
+ * {@link OrderedByIntegerMetric} and {@link OrderedList} need discrete
+ * integer priorities; workloads with continuous keys, such as event-driven
+ * simulation timestamps, must quantize and either explode the bucket count
+ * or invert priorities badly. An EpsilonOrderedList keeps items in
+ * per-thread min-heaps keyed by the Keyer's value and executes a sliding
+ * window: an item is eligible when its key is within epsilon of the lowest
+ * key present. Threads drain their own heap while it has eligible work;
+ * when it does not, they locate the global minimum, slide the window onto
+ * it, and take it, so the window advances without barriers and no discrete
+ * bucketing is ever chosen.
+ *
+ * The ordering is relaxed, not strict: items whose keys differ by at most
+ * epsilon may execute in any order (plus items in flight when the window
+ * slides), which is the usual contract of windowed schedulers. epsilon is a
+ * constructor argument and is forwarded through the wl trait:
+ *
+ * \code
+ * struct Keyer {
+ *   double operator()(const Event& e) const { return e.timestamp; }
+ * };
+ *
+ * typedef katana::EpsilonOrderedList<Keyer> WL;
+ * katana::for_each(katana::iterate(init), Fn, katana::wl<WL>(1e-6));
+ * \endcode
+ *
+ * @tparam Keyer      Maps items to an arithmetic key; keys are compared as
+ *                    doubles, so 64-bit integer keys above 2^53 lose
+ *                    precision (and with it some strictness, never items)
+ * @tparam T          Item type
+ * @tparam Concurrent Whether the worklist must be thread-safe
+ */
+template <
+    class Keyer = DummyIndexer<int>, typename T = int, bool Concurrent = true>
+class EpsilonOrderedList : private boost::noncopyable {
+public:
+  template <typename Tnew>
+  using retype = EpsilonOrderedList<Keyer, Tnew, Concurrent>;
+
+  template <bool b>
+  using rethread = EpsilonOrderedList<Keyer, T, b>;
+
+  template <typename _keyer>
+  struct with_keyer {
+    typedef EpsilonOrderedList<_keyer, T, Concurrent> type;
+  };
+
+  typedef T value_type;
+
+  explicit EpsilonOrderedList(double epsilon = 1.0)
+      : epsilon_(epsilon),
+        window_bits_(ToBits(-std::numeric_limits<double>::infinity())) {}
+
+  void push(const value_type& val) {
+    double key = static_cast<double>(keyer_(val));
+    ThreadData& local = *data_.getLocal();
+    local.lock.lock();
+    local.heap.emplace(key, val);
+    local.lock.unlock();
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e) {
+      push(*b++);
+    }
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  std::optional<value_type> pop() {
+    double window_end =
+        FromBits(window_bits_.load(std::memory_order_acquire)) + epsilon_;
+
+    // common case: this thread's own heap still has work in the window
+    ThreadData& local = *data_.getLocal();
+    local.lock.lock();
+    if (!local.heap.empty() && local.heap.top().first <= window_end) {
+      std::optional<value_type> result(local.heap.top().second);
+      local.heap.pop();
+      local.lock.unlock();
+      return result;
+    }
+    local.lock.unlock();
+
+    // nothing local in the window: find the global minimum key
+    int best = -1;
+    double best_key = 0;
+    for (unsigned i = 0; i < data_.size(); ++i) {
+      ThreadData& other = *data_.getRemote(i);
+      other.lock.lock();
+      if (!other.heap.empty() &&
+          (best < 0 || other.heap.top().first < best_key)) {
+        best = static_cast<int>(i);
+        best_key = other.heap.top().first;
+      }
+      other.lock.unlock();
+    }
+    if (best < 0) {
+      return std::nullopt;
+    }
+
+    // slide the window onto the minimum; racing sliders each install some
+    // observed minimum, which only relaxes the ordering by epsilon
+    window_bits_.store(ToBits(best_key), std::memory_order_release);
+
+    ThreadData& victim = *data_.getRemote(best);
+    victim.lock.lock();
+    if (!victim.heap.empty() &&
+        victim.heap.top().first <= best_key + epsilon_) {
+      std::optional<value_type> result(victim.heap.top().second);
+      victim.heap.pop();
+      victim.lock.unlock();
+      return result;
+    }
+    victim.lock.unlock();
+    // someone else won the race; the caller retries or terminates
+    return std::nullopt;
+  }
+
+private:
+  typedef std::pair<double, T> KeyedItem;
+
+  struct GreaterByKey {
+    bool operator()(const KeyedItem& a, const KeyedItem& b) const {
+      return a.first > b.first;
+    }
+  };
+
+  struct ThreadData {
+    PaddedLock<Concurrent> lock;
+    std::priority_queue<KeyedItem, std::vector<KeyedItem>, GreaterByKey> heap;
+  };
+
+  static uint64_t ToBits(double d) {
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+  }
+
+  static double FromBits(uint64_t bits) {
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+  }
+
+  PerThreadStorage<ThreadData> data_;
+  Keyer keyer_;
+  double epsilon_;
+  std::atomic<uint64_t> window_bits_;
+};
+KATANA_WLCOMPILECHECK(EpsilonOrderedList)
+
+}  // end namespace katana
+#endif
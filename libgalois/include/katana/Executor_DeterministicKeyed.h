@@ -0,0 +1,82 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_EXECUTORDETERMINISTICKEYED_H_
+#define KATANA_LIBGALOIS_KATANA_EXECUTORDETERMINISTICKEYED_H_
+
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "katana/Executor_DoAll.h"
+#include "katana/Range.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Deterministic loop over iterations whose conflicts are known up front.
+///
+/// The caller names the state each iteration touches with a conflict key
+/// (e.g., the node ID an operator updates). Iterations are pre-partitioned
+/// into rounds such that no two iterations in a round share a key: the i-th
+/// occurrence of a key in range order runs in round i, so the number of
+/// rounds equals the largest key multiplicity, which is the fewest rounds
+/// any such schedule can have. Each round runs as an ordinary do_all.
+///
+/// Because iterations in a round touch disjoint state, the final result is
+/// independent of scheduling, without the speculation, context acquisition,
+/// and commit machinery of the general deterministic executor. In exchange
+/// the operator must satisfy two conditions the general executor does not
+/// require: it may not push new work, and everything it reads or writes that
+/// another iteration could also write must be covered by the conflict key.
+///
+/// Operator conforms to <code>fn(item)</code> as in do_all; trailing
+/// arguments are forwarded to each round's do_all (e.g., loopname, steal).
+template <typename Range, typename KeyFn, typename FunctionTy, typename... Args>
+void
+for_each_deterministic_keyed(
+    const Range& range, const KeyFn& key_fn, FunctionTy&& fn, Args&&... args) {
+  using T =
+      typename std::iterator_traits<decltype(range.begin())>::value_type;
+  using Key = std::decay_t<decltype(key_fn(std::declval<const T&>()))>;
+
+  // round assignment is a function of range order only, so it is
+  // deterministic across runs and thread counts
+  std::unordered_map<Key, unsigned> occurrences;
+  std::vector<std::vector<T>> rounds;
+  for (auto it = range.begin(), end = range.end(); it != end; ++it) {
+    const T& item = *it;
+    unsigned round = occurrences[key_fn(item)]++;
+    if (round == rounds.size()) {
+      rounds.emplace_back();
+    }
+    rounds[round].emplace_back(item);
+  }
+
+  auto tpl = std::make_tuple(std::forward<Args>(args)...);
+  for (std::vector<T>& round : rounds) {
+    do_all_gen(iterate(round), fn, tpl);
+  }
+}
+
+}  // namespace katana
+
+#endif
@@ -20,12 +20,17 @@
 #ifndef KATANA_LIBGALOIS_KATANA_EXECUTORDOALL_H_
 #define KATANA_LIBGALOIS_KATANA_EXECUTORDOALL_H_
 
+#include <algorithm>
+
 #include "katana/Barrier.h"
 #include "katana/CompilerSpecific.h"
 #include "katana/Executor_OnEach.h"
+#include "katana/JobScheduler.h"
 #include "katana/OperatorReferenceTypes.h"
 #include "katana/PaddedLock.h"
 #include "katana/PerThreadStorage.h"
+#include "katana/PerfCounters.h"
+#include "katana/SamplingProfiler.h"
 #include "katana/Statistics.h"
 #include "katana/TerminationDetection.h"
 #include "katana/ThreadPool.h"
@@ -49,6 +54,12 @@ class DoAllStealingExec {
   constexpr static const bool MORE_STATS =
       NEED_STATS && has_trait<more_stats_tag, ArgsTuple>();
   constexpr static const bool USE_TERM = false;
+  constexpr static const bool ADAPTIVE_CHUNK =
+      has_trait<adaptive_chunk_size_tag, ArgsTuple>();
+  // With adaptive_chunk_size, each grab takes 1/GUIDED_CHUNK_DIVISOR of the
+  // thread's remaining share, so chunk sizes shrink geometrically as the
+  // range drains.
+  constexpr static const Diff_ty GUIDED_CHUNK_DIVISOR = 8;
 
   struct ThreadContext {
     alignas(KATANA_CACHE_LINE_SIZE) SimpleLock work_mutex;
@@ -58,6 +69,7 @@ class DoAllStealingExec {
     Iter shared_end;
     Diff_ty m_size;
     size_t num_iter;
+    size_t num_chunks;
 
     // Stats
 
@@ -67,7 +79,8 @@ class DoAllStealingExec {
           shared_beg(),
           shared_end(),
           m_size(0),
-          num_iter(0) {
+          num_iter(0),
+          num_chunks(0) {
       // TODO: fix this initialization problem,
       // see initThread
     }
@@ -78,17 +91,22 @@ class DoAllStealingExec {
           shared_beg(beg),
           shared_end(end),
           m_size(std::distance(beg, end)),
-          num_iter(0) {}
+          num_iter(0),
+          num_chunks(0) {}
 
-    bool doWork(F func, const unsigned chunk_size) {
+    bool doWork(F func, const Diff_ty chunk_size) {
       Iter beg(shared_beg);
       Iter end(shared_end);
 
       bool didwork = false;
 
-      while (getWork(beg, end, chunk_size)) {
+      while (getWork(beg, end, nextChunkSize(chunk_size))) {
         didwork = true;
 
+        if (NEED_STATS) {
+          ++num_chunks;
+        }
+
         for (; beg != end; ++beg) {
           if (NEED_STATS) {
             ++num_iter;
@@ -119,7 +137,18 @@ class DoAllStealingExec {
     }
 
   private:
-    bool getWork(Iter& priv_beg, Iter& priv_end, const unsigned chunk_size) {
+    //! Guided schedule: take a fixed fraction of this thread's remaining
+    //! share, clamped below by the chunk_size trait. Reading m_size without
+    //! the lock is only a sizing heuristic; getWork clamps to what is
+    //! actually left.
+    Diff_ty nextChunkSize(const Diff_ty chunk_size) const {
+      if (!ADAPTIVE_CHUNK) {
+        return chunk_size;
+      }
+      return std::max(m_size / GUIDED_CHUNK_DIVISOR, chunk_size);
+    }
+
+    bool getWork(Iter& priv_beg, Iter& priv_end, const Diff_ty chunk_size) {
       bool succ = false;
 
       work_mutex.lock();
@@ -259,6 +288,37 @@ private:
     return succ;
   }
 
+  KATANA_ATTRIBUTE_NOINLINE bool stealWithinCore(ThreadContext& poor) {
+    bool sawWork = false;
+    bool stoleWork = false;
+
+    auto& tp = GetThreadPool();
+    const unsigned maxT = katana::getActiveThreads();
+    const unsigned my_core = tp.getCore(poor.id);
+
+    // SMT siblings share L1/L2 with the poor thread, so their work is the
+    // cheapest to take over.
+    for (unsigned i = 1; i < maxT; ++i) {
+      unsigned t = (poor.id + i) % maxT;
+
+      if (tp.getCore(t) != my_core) {
+        continue;
+      }
+
+      if (workers.getRemote(t)->hasWorkWeak()) {
+        sawWork = true;
+
+        stoleWork = transferWork(*workers.getRemote(t), poor, HALF);
+
+        if (stoleWork) {
+          break;
+        }
+      }
+    }
+
+    return sawWork || stoleWork;
+  }
+
   KATANA_ATTRIBUTE_NOINLINE bool stealWithinSocket(ThreadContext& poor) {
     bool sawWork = false;
     bool stoleWork = false;
@@ -323,9 +383,46 @@ private:
     return sawWork || stoleWork;
   }
 
+  KATANA_ATTRIBUTE_NOINLINE bool stealFlat(ThreadContext& poor) {
+    bool sawWork = false;
+    bool stoleWork = false;
+
+    const unsigned maxT = katana::getActiveThreads();
+
+    for (unsigned i = 1; i < maxT; ++i) {
+      ThreadContext& rich = *(workers.getRemote((poor.id + i) % maxT));
+
+      if (rich.hasWorkWeak()) {
+        sawWork = true;
+
+        stoleWork = transferWork(rich, poor, HALF);
+
+        if (stoleWork) {
+          break;
+        }
+      }
+    }
+
+    return sawWork || stoleWork;
+  }
+
   KATANA_ATTRIBUTE_NOINLINE bool trySteal(ThreadContext& poor) {
     bool ret = false;
 
+    if (steal_policy_ == StealPolicy::kFlat) {
+      ret = stealFlat(poor);
+      asmPause();
+      return ret;
+    }
+
+    ret = stealWithinCore(poor);
+
+    if (ret) {
+      return true;
+    }
+
+    asmPause();
+
     ret = stealWithinSocket(poor);
 
     if (ret) {
@@ -357,6 +454,7 @@ private:
   F func;
   const char* loopname;
   Diff_ty chunk_size;
+  StealPolicy steal_policy_;
   PerThreadStorage<ThreadContext> workers;
 
   TerminationDetection& term;
@@ -367,6 +465,9 @@ private:
   PerThreadTimer<MORE_STATS> execTime;
   PerThreadTimer<MORE_STATS> stealTime;
   PerThreadTimer<MORE_STATS> termTime;
+  // hardware counters over each thread's whole participation (work,
+  // stealing and termination); no-op unless KATANA_PERF_COUNTERS is set
+  PerThreadPerfCounters<NEED_STATS> perfCounters;
 
 public:
   DoAllStealingExec(const R& _range, F _func, const ArgsTuple& argsTuple)
@@ -374,12 +475,14 @@ public:
         func(_func),
         loopname(katana::internal::getLoopName(argsTuple)),
         chunk_size(get_trait_value<chunk_size_tag>(argsTuple).value),
+        steal_policy_(get_trait_value<steal_policy_tag>(argsTuple).value),
         term(GetTerminationDetection(activeThreads)),
         totalTime(loopname, "Total"),
         initTime(loopname, "Init"),
         execTime(loopname, "Execute"),
         stealTime(loopname, "Steal"),
-        termTime(loopname, "Term") {
+        termTime(loopname, "Term"),
+        perfCounters(loopname) {
     KATANA_LOG_DEBUG_ASSERT(chunk_size > 0);
   }
 
@@ -411,7 +514,9 @@ public:
 
   void operator()(void) {
     ThreadContext& ctx = *workers.getLocal();
+    SamplingProfiler::LoopScope sampling_scope(loopname);
     totalTime.start();
+    perfCounters.start();
 
     while (true) {
       bool workHappened = false;
@@ -451,11 +556,17 @@ public:
       }
     }
 
+    perfCounters.stop();
     totalTime.stop();
     KATANA_LOG_DEBUG_ASSERT(!ctx.hasWork());
 
     if (NEED_STATS) {
       katana::ReportStatSum(loopname, "Iterations", ctx.num_iter);
+      // Max vs. avg iterations per thread exposes residual load imbalance
+      // after stealing; chunk count shows how finely the range was carved.
+      katana::ReportStatMax(loopname, "IterationsPerThreadMax", ctx.num_iter);
+      katana::ReportStatAvg(loopname, "IterationsPerThreadAvg", ctx.num_iter);
+      katana::ReportStatSum(loopname, "Chunks", ctx.num_chunks);
     }
   }
 };
@@ -464,6 +575,10 @@ template <bool _STEAL>
 struct ChooseDoAllImpl {
   template <typename R, typename F, typename ArgsT>
   static void call(const R& range, F&& func, const ArgsT& argsTuple) {
+    // may block for our turn and resize activeThreads; must precede the
+    // reads of activeThreads below
+    internal::JobSlice job_slice;
+
     internal::DoAllStealingExec<
         R, OperatorReferenceType<decltype(std::forward<F>(func))>, ArgsT>
         exec(range, std::forward<F>(func), argsTuple);
@@ -489,11 +604,16 @@ struct ChooseDoAllImpl<false> {
 
           const char* const loopname = katana::internal::getLoopName(argsTuple);
 
+          SamplingProfiler::LoopScope sampling_scope(loopname);
           PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
           PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
           PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
+          // per-thread scope already, so drive a group directly instead
+          // of going through PerThreadPerfCounters
+          PerfCounterGroup perfCounters;
 
           totalTime.start();
+          perfCounters.start();
           initTime.start();
 
           auto begin = range.local_begin();
@@ -513,10 +633,12 @@ struct ChooseDoAllImpl<false> {
           }
           execTime.stop();
 
+          perfCounters.stop();
           totalTime.stop();
 
           if (NEED_STATS) {
             katana::ReportStatSum(loopname, "Iterations", iter);
+            perfCounters.report(loopname);
           }
         },
         std::make_tuple());
@@ -534,8 +656,9 @@ do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
 
   auto argsT = std::tuple_cat(
       argsTuple, get_default_trait_values(
-                     argsTuple, std::make_tuple(chunk_size_tag{}),
-                     std::make_tuple(chunk_size<>{})));
+                     argsTuple,
+                     std::make_tuple(chunk_size_tag{}, steal_policy_tag{}),
+                     std::make_tuple(chunk_size<>{}, steal_policy{})));
 
   using ArgsT = decltype(argsT);
 
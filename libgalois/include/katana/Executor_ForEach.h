@@ -28,6 +28,8 @@
 #include "katana/Barrier.h"
 #include "katana/Chunk.h"
 #include "katana/Context.h"
+#include "katana/Fiber.h"
+#include "katana/JobScheduler.h"
 #include "katana/LoopStatistics.h"
 #include "katana/Mem.h"
 #include "katana/OperatorReferenceTypes.h"
@@ -149,10 +151,23 @@ public:
   static constexpr bool needsAborts =
       !has_trait<disable_conflict_detection_tag, ArgsTy>();
   static constexpr bool needsPia = has_trait<per_iter_alloc_tag, ArgsTy>();
+  static constexpr bool needsPra = has_trait<per_round_alloc_tag, ArgsTy>();
   static constexpr bool needsBreak = has_trait<parallel_break_tag, ArgsTy>();
   static constexpr bool MORE_STATS =
       needStats && has_trait<more_stats_tag, ArgsTy>();
 
+  static constexpr unsigned numFibers() {
+    if constexpr (has_trait<fibers_tag, ArgsTy>()) {
+      return trait_type<fibers_tag, ArgsTy>::type::value;
+    } else {
+      return 1;
+    }
+  }
+  // fibers interleave operator invocations on one thread, so they cannot
+  // share a conflict-detection context or a per-iteration allocator
+  static constexpr bool useFibers =
+      numFibers() > 1 && !needsAborts && !needsPia;
+
 protected:
   typedef typename WorkListTy::value_type value_type;
 
@@ -205,6 +220,7 @@ protected:
         wl.push(pb.begin(), pb.end());
         pb.clear();
       }
+      tld.note_push_chain(n > 0);
     }
     if (needsPia)
       tld.facing.resetAlloc();
@@ -247,6 +263,19 @@ protected:
     return didWork;
   }
 
+  bool runQueueFibered(ThreadLocalData& tld) {
+    bool didWork = false;
+    FiberGroup group(numFibers(), [&]() {
+      std::optional<value_type> p;
+      while ((p = wl.pop())) {
+        didWork = true;
+        doProcess(*p, tld);
+      }
+    });
+    group.Run();
+    return didWork;
+  }
+
   template <unsigned int limit, typename WL>
   void runQueueDispatch(ThreadLocalData& tld, WL& lwl, RunQueueState<WL>& s) {
 #ifdef KATANA_USE_LONGJMP_ABORT
@@ -325,6 +354,9 @@ protected:
             b = handleAborts(tld);
             didWork = b || didWork;
           }
+        } else if constexpr (useFibers) {
+          bool b = runQueueFibered(tld);
+          didWork = b || didWork;
         } else {  // No try/catch
           bool b = runQueueSimple(tld);
           didWork = b || didWork;
@@ -345,6 +377,12 @@ protected:
         break;
       }
 
+      // Round boundary: every thread is quiescent but the worklist still
+      // holds work for the next round, so the round arena can be reused.
+      tld.note_round();
+      if (needsPra)
+        tld.facing.rewindRoundAlloc();
+
       term.InitializeThread();
       barrier.Wait();
     }
@@ -358,7 +396,10 @@ protected:
 
   template <typename... WArgsTy>
   ForEachExecutor(T2, FunctionTy f, const ArgsTy& args, WArgsTy... wargs)
-      : term(GetTerminationDetection(activeThreads)),
+      : term(
+            has_trait<flat_termination_tag, ArgsTy>()
+                ? GetFlatTerminationDetection(activeThreads)
+                : GetTerminationDetection(activeThreads)),
         barrier(GetBarrier(activeThreads)),
         wl(std::forward<WArgsTy>(wargs)...),
         origFunction(f),
@@ -450,6 +491,10 @@ for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
       OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))>;
   typedef ForEachExecutor<WorkListTy, FuncRefType, ArgsTy> WorkTy;
 
+  // may block for our turn and resize activeThreads; must precede the
+  // reads of activeThreads below
+  internal::JobSlice job_slice;
+
   auto& barrier = GetBarrier(activeThreads);
   FuncRefType fn_ref = fn;
   WorkTy W(fn_ref, args);
@@ -20,6 +20,7 @@
 #ifndef KATANA_LIBGALOIS_KATANA_EXECUTORONEACH_H_
 #define KATANA_LIBGALOIS_KATANA_EXECUTORONEACH_H_
 
+#include "katana/JobScheduler.h"
 #include "katana/OperatorReferenceTypes.h"
 #include "katana/ThreadPool.h"
 #include "katana/ThreadTimer.h"
@@ -49,6 +50,9 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
 
   PerThreadTimer<MORE_STATS> execTime(loopname, "Execute");
 
+  // may block for our turn and resize activeThreads; must precede numT
+  internal::JobSlice job_slice;
+
   const auto numT = getActiveThreads();
 
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
@@ -0,0 +1,142 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_FIBER_H_
+#define KATANA_LIBGALOIS_KATANA_FIBER_H_
+
+#include <ucontext.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "katana/Logging.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * A group of cooperatively scheduled fibers multiplexed on one OS thread.
+ *
+ * Pointer-chasing loops spend most of their cycles stalled on DRAM; running
+ * several instances of the loop body per thread and switching between them at
+ * each load lets one instance's memory latency overlap another's compute. A
+ * fiber issues a software prefetch for the address it is about to
+ * dereference, yields with \ref FiberPrefetchAndYield, and by the time the
+ * round-robin schedule returns to it the line is likely resident.
+ *
+ * Fibers are not threads: they never migrate, never run concurrently with
+ * each other, and switch only at explicit yields, so thread-local structures
+ * (worklists, statistics) may be shared freely between the fibers of one
+ * group. State that must be exclusive for the duration of one operator
+ * invocation (conflict-detection contexts, per-iteration allocators) must
+ * not be shared, since another fiber runs while an invocation is suspended.
+ */
+class FiberGroup {
+  struct Fiber {
+    ucontext_t ctx;
+    std::unique_ptr<char[]> stack;
+    bool done;
+  };
+
+  constexpr static size_t kStackSize = 64 * 1024;
+
+  inline thread_local static FiberGroup* current_ = nullptr;
+
+  ucontext_t scheduler_;
+  std::vector<Fiber> fibers_;
+  std::function<void()> fn_;
+  unsigned running_index_{0};
+  unsigned live_{0};
+
+  static void Trampoline() {
+    FiberGroup* g = current_;
+    g->fn_();
+    g->fibers_[g->running_index_].done = true;
+    --g->live_;
+    // uc_link returns to the scheduler
+  }
+
+public:
+  /**
+   * Creates a group of num_fibers fibers, each of which runs fn once. Stacks
+   * are small (64KB); fn must not recurse deeply.
+   */
+  template <typename F>
+  FiberGroup(unsigned num_fibers, F&& fn)
+      : fibers_(std::max(1U, num_fibers)), fn_(std::forward<F>(fn)) {}
+
+  /**
+   * Runs every fiber to completion, round-robining between them at yields.
+   * Must be called outside any fiber.
+   */
+  void Run() {
+    KATANA_LOG_DEBUG_ASSERT(!current_);
+    current_ = this;
+    live_ = fibers_.size();
+    for (Fiber& f : fibers_) {
+      f.stack = std::make_unique<char[]>(kStackSize);
+      f.done = false;
+      getcontext(&f.ctx);
+      f.ctx.uc_stack.ss_sp = f.stack.get();
+      f.ctx.uc_stack.ss_size = kStackSize;
+      f.ctx.uc_link = &scheduler_;
+      makecontext(&f.ctx, reinterpret_cast<void (*)()>(&Trampoline), 0);
+    }
+    running_index_ = 0;
+    while (live_ > 0) {
+      while (fibers_[running_index_].done) {
+        running_index_ = (running_index_ + 1) % fibers_.size();
+      }
+      swapcontext(&scheduler_, &fibers_[running_index_].ctx);
+      running_index_ = (running_index_ + 1) % fibers_.size();
+    }
+    current_ = nullptr;
+  }
+
+  //! Returns true when called from inside a running fiber
+  static bool InFiber() { return current_ != nullptr; }
+
+  //! Suspends the current fiber until the scheduler comes around again; a
+  //! no-op outside a fiber
+  static void Yield() {
+    FiberGroup* g = current_;
+    if (!g) {
+      return;
+    }
+    swapcontext(&g->fibers_[g->running_index_].ctx, &g->scheduler_);
+  }
+};
+
+/**
+ * Prefetches addr and yields to the next fiber in the current \ref
+ * FiberGroup so the fetch overlaps other fibers' work. Outside a fibered
+ * loop this degenerates to the plain prefetch, so operators may call it
+ * unconditionally.
+ */
+inline void
+FiberPrefetchAndYield(const void* addr) {
+  __builtin_prefetch(addr);
+  FiberGroup::Yield();
+}
+
+}  // namespace katana
+
+#endif
@@ -42,9 +42,11 @@
 #include "katana/Details.h"
 #include "katana/Endian.h"
 #include "katana/GraphHelpers.h"
+#include "katana/Loops.h"
 #include "katana/MethodFlags.h"
 #include "katana/NUMAArray.h"
 #include "katana/NumaMem.h"
+#include "katana/ParallelSTL.h"
 #include "katana/Reduction.h"
 #include "katana/config.h"
 
@@ -595,13 +597,30 @@ public:
    */
   ~FileGraph();
 
+  /**
+   * Hint describing how eagerly fromFile/partFromFile should page file
+   * data into memory.
+   */
+  enum class LoadHint {
+    //! Fault pages on first touch (mmap default)
+    kLazy,
+    /**
+     * Eagerly fault the mapping before returning, one contiguous segment
+     * per thread walked sequentially. On a cold cache this keeps several
+     * sequential streams outstanding against the disk instead of paying
+     * one synchronous major fault per page at first touch.
+     */
+    kEagerPopulate,
+  };
+
   /**
    * Given a file name, mmap the entire file into memory. Should
    * be a graph with some specific layout.
    *
    * @param filename Graph file to load
+   * @param hint how eagerly to page the file in; see LoadHint
    */
-  void fromFile(const std::string& filename);
+  void fromFile(const std::string& filename, LoadHint hint = LoadHint::kLazy);
 
   /**
    * Loads/mmaps particular portions of a graph corresponding to a node
@@ -616,10 +635,13 @@ public:
    * @param erange Edge range to load
    * @param numaMap if true, does interleaved numa allocation for data
    * structures
+   * @param hint how eagerly to page the part in; see LoadHint. Ignored when
+   * numaMap is set because the round-robin first-touch interleave is itself
+   * what places pages across sockets
    */
   void partFromFile(
       const std::string& filename, NodeRange nrange, EdgeRange erange,
-      bool numaMap = false);
+      bool numaMap = false, LoadHint hint = LoadHint::kLazy);
 
   /**
    * Reads graph connectivity information from file. Tries to balance memory
@@ -712,17 +734,20 @@ public:
     outIdx[id] += delta;
   }
 
+  //! Thread-safe version of incrementDegree; may be called concurrently
+  //! from multiple threads between phase1() and phase2()
+  void incrementDegreeAtomic(size_t id) {
+    KATANA_LOG_DEBUG_ASSERT(id < numNodes);
+    __sync_fetch_and_add(&outIdx[id], 1);
+  }
+
   //! Marks the transition to next phase of parsing, adding edges
   void phase2() {
     if (numNodes == 0)
       return;
 
     // Turn counts into partial sums
-    auto prev = outIdx.begin();
-    for (auto ii = outIdx.begin() + 1, ei = outIdx.end(); ii != ei;
-         ++ii, ++prev) {
-      *ii += *prev;
-    }
+    ParallelSTL::partial_sum(outIdx.begin(), outIdx.end(), outIdx.begin());
     KATANA_LOG_DEBUG_ASSERT(outIdx[numNodes - 1] == numEdges);
 
     if (numNodes <= std::numeric_limits<uint32_t>::max()) {
@@ -755,6 +780,28 @@ public:
     }
   }
 
+  //! Thread-safe version of addNeighbor; may be called concurrently from
+  //! multiple threads between phase2() and finish(). Edges added to the same
+  //! src from different threads may land in any order within src's
+  //! neighborhood.
+  size_t addNeighborAtomic(size_t src, size_t dst) {
+    size_t base = src ? outIdx[src - 1] : 0;
+
+    if (numNodes <= std::numeric_limits<uint32_t>::max()) {
+      // version 1
+      size_t idx = base + __sync_fetch_and_add(&starts[src], 1);
+      KATANA_LOG_DEBUG_ASSERT(idx < outIdx[src]);
+      outs[idx] = dst;
+      return idx;
+    } else {
+      // version 2
+      size_t idx = base + __sync_fetch_and_add(&starts64[src], 1);
+      KATANA_LOG_DEBUG_ASSERT(idx < outIdx[src]);
+      outs64[idx] = dst;
+      return idx;
+    }
+  }
+
   /**
    * Finish making graph. Returns pointer to block of memory that should be
    * used to store edge data.
@@ -0,0 +1,230 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_FRONTIERENGINE_H_
+#define KATANA_LIBGALOIS_KATANA_FRONTIERENGINE_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Loops.h"
+#include "katana/Range.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+
+namespace katana {
+
+/// Parameters controlling when a FrontierEngine switches between push
+/// (out-edge) and pull (in-edge) traversal.
+///
+/// The defaults follow Beamer's direction-optimizing BFS heuristic: switch to
+/// pull once the frontier's outgoing edges exceed 1/alpha of the unexplored
+/// edges, and switch back to push once the frontier shrinks below 1/beta of
+/// the nodes.
+struct FrontierPlan {
+  uint32_t alpha{15};
+  uint32_t beta{18};
+  /// If true, stop scanning a node's in-edges after the first successful
+  /// pull update (correct for monotone state like BFS parents). Algorithms
+  /// that must observe every frontier neighbor of a node (e.g. degree
+  /// decrements in k-core) should set this to false.
+  bool pull_stop_on_update{true};
+};
+
+/// A bulk-synchronous frontier executor with automatic push/pull direction
+/// selection, factored out of the direction-optimizing BFS.
+///
+/// The engine owns the frontier worklists and density bookkeeping; the
+/// algorithm supplies three operators to Run():
+///
+/// - push(src, dst, out_edge) -> bool: attempt to update dst from frontier
+///   node src; return true iff dst newly joined the frontier. May run
+///   concurrently for the same dst, so updates must be atomic.
+/// - pull_candidate(dst) -> bool: whether dst can still be updated. Used to
+///   skip settled nodes before their in-edges are scanned.
+/// - pull(dst, src, in_edge) -> bool: attempt to update dst from frontier
+///   node src; return true iff dst joined the frontier. Exactly one thread
+///   processes a given dst, so updates to dst need not be atomic.
+///
+/// GraphView must provide edges()/edge_dest()/degree() and, unless
+/// kPullUsesOutEdges is set, in_edges()/in_edge_dest() (i.e. a bidirectional
+/// view). Algorithms on symmetric graphs can set kPullUsesOutEdges to pull
+/// over the out-edges and avoid materializing a transpose.
+template <typename GraphView, bool kPullUsesOutEdges = false>
+class FrontierEngine {
+public:
+  using Node = typename GraphView::Node;
+
+  FrontierEngine(const GraphView& graph, FrontierPlan plan = FrontierPlan{})
+      : graph_(graph),
+        plan_(plan),
+        frontier_(std::make_unique<Cont>()),
+        next_frontier_(std::make_unique<Cont>()) {
+    front_bitset_.resize(graph_.num_nodes());
+    next_bitset_.resize(graph_.num_nodes());
+  }
+
+  /// Adds a node to the initial frontier. Thread-safe, so seeds may be
+  /// added from inside a parallel loop.
+  void AddSeed(const Node& node) {
+    next_frontier_->push(node);
+    seed_count_ += 1;
+    seed_degrees_ += graph_.degree(node);
+  }
+
+  /// Runs rounds until the frontier is empty. See the class comment for the
+  /// operator contracts.
+  template <typename PushFn, typename PullCandidateFn, typename PullFn>
+  void Run(
+      PushFn&& push, PullCandidateFn&& pull_candidate, PullFn&& pull,
+      const char* stat_prefix = "FrontierEngine") {
+    katana::GAccumulator<uint64_t> work_items;
+    katana::StatTimer bitset_to_wl_timer("Bitset_To_WL_Timer", stat_prefix);
+    katana::StatTimer wl_to_bitset_timer("WL_To_Bitset_Timer", stat_prefix);
+
+    const uint32_t num_nodes = graph_.num_nodes();
+
+    int64_t edges_to_check = graph_.num_edges();
+    int64_t scout_count = seed_degrees_.reduce();
+    work_items += seed_count_.reduce();
+
+    while (!next_frontier_->empty()) {
+      std::swap(frontier_, next_frontier_);
+      next_frontier_->clear();
+      if (scout_count > edges_to_check / plan_.alpha) {
+        wl_to_bitset_timer.start();
+        WlToBitset(*frontier_, &front_bitset_);
+        wl_to_bitset_timer.stop();
+        uint64_t old_num_work_items{0};
+        do {
+          old_num_work_items = work_items.reduce();
+          work_items.reset();
+
+          katana::do_all(
+              katana::iterate(Node{0}, static_cast<Node>(num_nodes)),
+              [&](const Node& dst) {
+                if (!pull_candidate(dst)) {
+                  return;
+                }
+                bool joined = false;
+                for (auto e : PullEdges(dst)) {
+                  auto src = PullEdgeDest(e);
+                  if (front_bitset_.test(src)) {
+                    if (pull(dst, src, e)) {
+                      joined = true;
+                      if (plan_.pull_stop_on_update) {
+                        break;
+                      }
+                    }
+                  }
+                }
+                if (joined) {
+                  next_bitset_.set(dst);
+                  work_items += 1;
+                }
+              },
+              katana::steal(), katana::chunk_size<kChunkSize>(),
+              katana::loopname("FrontierEnginePull"));
+          std::swap(front_bitset_, next_bitset_);
+          next_bitset_.reset();
+        } while (work_items.reduce() >= old_num_work_items ||
+                 (work_items.reduce() > num_nodes / plan_.beta));
+        bitset_to_wl_timer.start();
+        BitsetToWl(front_bitset_, next_frontier_.get());
+        bitset_to_wl_timer.stop();
+        scout_count = 1;
+      } else {
+        edges_to_check -= scout_count;
+        work_items.reset();
+
+        katana::do_all(
+            katana::iterate(*frontier_),
+            [&](const Node& src) {
+              for (auto e : graph_.edges(src)) {
+                auto dst = graph_.edge_dest(e);
+                if (push(src, dst, e)) {
+                  next_frontier_->push(dst);
+                  work_items += graph_.degree(dst);
+                }
+              }
+            },
+            katana::steal(), katana::chunk_size<kChunkSize>(),
+            katana::loopname("FrontierEnginePush"));
+        scout_count = work_items.reduce();
+      }
+    }
+  }
+
+private:
+  using Cont = katana::InsertBag<Node>;
+
+  constexpr static unsigned kChunkSize = 256U;
+
+  auto PullEdges(const Node& node) const {
+    if constexpr (kPullUsesOutEdges) {
+      return graph_.edges(node);
+    } else {
+      return graph_.in_edges(node);
+    }
+  }
+
+  auto PullEdgeDest(const typename GraphView::Edge& edge) const {
+    if constexpr (kPullUsesOutEdges) {
+      return graph_.edge_dest(edge);
+    } else {
+      return graph_.in_edge_dest(edge);
+    }
+  }
+
+  static void WlToBitset(const Cont& wl, katana::DynamicBitset* bitset) {
+    katana::do_all(
+        katana::iterate(wl), [&](const Node& src) { bitset->set(src); },
+        katana::chunk_size<kChunkSize>(), katana::loopname("WlToBitset"));
+  }
+
+  void BitsetToWl(const katana::DynamicBitset& bitset, Cont* wl) const {
+    wl->clear();
+    katana::do_all(
+        katana::iterate(Node{0}, static_cast<Node>(graph_.num_nodes())),
+        [&](const Node& src) {
+          if (bitset.test(src)) {
+            wl->push(src);
+          }
+        },
+        katana::chunk_size<kChunkSize>(), katana::loopname("BitsetToWl"));
+  }
+
+  const GraphView& graph_;
+  FrontierPlan plan_;
+
+  std::unique_ptr<Cont> frontier_;
+  std::unique_ptr<Cont> next_frontier_;
+  katana::DynamicBitset front_bitset_;
+  katana::DynamicBitset next_bitset_;
+
+  katana::GAccumulator<uint64_t> seed_count_;
+  katana::GAccumulator<int64_t> seed_degrees_;
+};
+
+}  // namespace katana
+
+#endif
@@ -260,6 +260,46 @@ divideNodesBinarySearch(
       EdgeRange(edge_iterator(edgesLower), edge_iterator(edgesUpper)));
 }
 
+/**
+ * Computes per-thread boundaries over an edge-destination array such that
+ * each thread owns a contiguous, node-aligned slice covering roughly the
+ * same number of edges, rather than the same number of array elements.
+ * Feeding the result to NUMAArray::allocateSpecified makes each thread
+ * first-touch (and so each socket own) the pages for the edges it will
+ * serve, which balances memory traffic on hub-heavy graphs where an
+ * even index split concentrates most accesses on one socket.
+ *
+ * @tparam PrefixSumType type of the object that holds the edge prefix sum
+ *
+ * @param edgePrefixSum Prefix sum of the edges in the graph
+ * @param numNodes Total number of nodes included in prefix sum
+ * @param numEdges Total number of edges included in prefix sum
+ * @param numThreads Number of threads to split the edges among
+ *
+ * @returns Vector of numThreads + 1 edge-array boundaries; thread i owns
+ * elements [result[i], result[i + 1])
+ */
+template <typename PrefixSumType>
+std::vector<uint64_t>
+computeEdgeBalancedRanges(
+    PrefixSumType& edgePrefixSum, uint64_t numNodes, uint64_t numEdges,
+    uint32_t numThreads) {
+  std::vector<uint64_t> ranges(numThreads + 1);
+  ranges[0] = 0;
+  for (uint32_t tid = 0; tid < numThreads; ++tid) {
+    auto graph_range = divideNodesBinarySearch<PrefixSumType>(
+        numNodes, numEdges, 0, 1, tid, numThreads, edgePrefixSum);
+    if (graph_range.first.first == graph_range.first.second) {
+      // empty division (more threads than nodes)
+      ranges[tid + 1] = ranges[tid];
+    } else {
+      ranges[tid + 1] = *graph_range.second.second;
+    }
+  }
+  ranges[numThreads] = numEdges;
+  return ranges;
+}
+
 // second internal namespace
 namespace internal {
 
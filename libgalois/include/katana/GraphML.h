@@ -19,6 +19,24 @@ KATANA_EXPORT katana::Result<katana::GraphComponents> ConvertGraphML(
     const std::string& infilename, size_t chunk_size = 25000,
     bool verbose = false);
 
+/// ConvertGraphMLParallel is a parallel variant of ConvertGraphML: the input
+/// is memory mapped and split into segments at node/edge element boundaries,
+/// segments are parsed concurrently with property values resolved to the
+/// types declared in the GraphML header, and the parsed segments are appended
+/// to the graph in input order. The result is identical to ConvertGraphML.
+///
+/// Comments or CDATA sections containing literal "<node" or "<edge" text are
+/// not supported; use ConvertGraphML for such inputs.
+///
+/// \param infilename Path to source graphml file
+/// \param chunk_size Chunk size for in memory representations during conversion
+/// \param verbose If true, print progress to the standard out while converting
+/// \returns A collection of Arrow tables of node properties/labels, edge
+///     properties/types, and CSR topology
+KATANA_EXPORT katana::Result<katana::GraphComponents> ConvertGraphMLParallel(
+    const std::string& infilename, size_t chunk_size = 25000,
+    bool verbose = false);
+
 }  // end namespace katana
 
 #endif
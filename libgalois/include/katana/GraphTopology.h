@@ -1,16 +1,32 @@
 #ifndef KATANA_LIBGALOIS_KATANA_GRAPHTOPOLOGY_H_
 #define KATANA_LIBGALOIS_KATANA_GRAPHTOPOLOGY_H_
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
 
+#include "katana/Cache.h"
 #include "katana/DynamicBitset.h"
 #include "katana/Iterators.h"
 #include "katana/NUMAArray.h"
+#include "katana/PODVector.h"
+#include "katana/Result.h"
+#include "katana/SimpleLock.h"
 #include "katana/config.h"
 
+namespace arrow {
+class Array;
+}  // namespace arrow
+
 namespace katana {
 
 class KATANA_EXPORT PropertyGraph;
@@ -32,6 +48,7 @@ struct KATANA_EXPORT GraphTopologyTypes {
   using nodes_range = StandardRange<node_iterator>;
   using edges_range = StandardRange<edge_iterator>;
   using iterator = node_iterator;
+  using local_iterator = node_iterator;
 
   using AdjIndexVec = NUMAArray<Edge>;
   using EdgeDestVec = NUMAArray<Node>;
@@ -59,17 +76,40 @@ public:
       size_t num_edges) noexcept;
 
   GraphTopology(NUMAArray<Edge>&& adj_indices, NUMAArray<Node>&& dests) noexcept
-      : adj_indices_(std::move(adj_indices)), dests_(std::move(dests)) {}
+      : adj_indices_(std::move(adj_indices)),
+        dests_(std::move(dests)),
+        adj_view_(adj_indices_.data()),
+        dests_view_(dests_.data()),
+        num_nodes_(adj_indices_.size()),
+        num_edges_(dests_.size()) {}
+
+  /// Makes a non-owning topology over externally managed (typically
+  /// memory-mapped) arrays. Unlike the copying pointer constructor, pages
+  /// fault in on demand as they are traversed; use Prefetch() to warm a
+  /// node range ahead of time. The backing memory (e.g., the RDG's
+  /// topology FileView) must outlive the returned topology.
+  static GraphTopology MakeMemMappedView(
+      const Edge* adj_indices, size_t num_nodes, const Node* dests,
+      size_t num_edges) noexcept;
 
   static GraphTopology Copy(const GraphTopology& that) noexcept;
 
-  uint64_t num_nodes() const noexcept { return adj_indices_.size(); }
+  /// @returns true if this topology aliases memory it does not own
+  bool is_mem_mapped_view() const noexcept { return mem_mapped_view_; }
 
-  uint64_t num_edges() const noexcept { return dests_.size(); }
+  /// Advises the OS to fault in the adjacency index and destination pages
+  /// covering \p nodes ahead of traversal. A cheap hint; useful mainly for
+  /// mem-mapped topologies where cold pages would otherwise fault in one
+  /// at a time.
+  void Prefetch(const nodes_range& nodes) const noexcept;
 
-  const Edge* adj_data() const noexcept { return adj_indices_.data(); }
+  uint64_t num_nodes() const noexcept { return num_nodes_; }
 
-  const Node* dest_data() const noexcept { return dests_.data(); }
+  uint64_t num_edges() const noexcept { return num_edges_; }
+
+  const Edge* adj_data() const noexcept { return adj_view_; }
+
+  const Node* dest_data() const noexcept { return dests_view_; }
 
   /// Checks equality against another instance of GraphTopology.
   /// WARNING: Expensive operation due to element-wise checks on large arrays
@@ -86,7 +126,9 @@ public:
       return false;
     }
 
-    return adj_indices_ == that.adj_indices_ && dests_ == that.dests_;
+    return std::equal(
+               adj_data(), adj_data() + num_nodes(), that.adj_data()) &&
+           std::equal(dest_data(), dest_data() + num_edges(), that.dest_data());
   }
 
   /// Gets the edge range of some node.
@@ -94,9 +136,9 @@ public:
   /// \param node node to get the edge range of
   /// \returns iterable edge range for node.
   edges_range edges(Node node) const noexcept {
-    KATANA_LOG_DEBUG_ASSERT(node <= adj_indices_.size());
-    edge_iterator e_beg{node > 0 ? adj_indices_[node - 1] : 0};
-    edge_iterator e_end{adj_indices_[node]};
+    KATANA_LOG_DEBUG_ASSERT(node <= num_nodes_);
+    edge_iterator e_beg{node > 0 ? adj_view_[node - 1] : 0};
+    edge_iterator e_end{adj_view_[node]};
 
     return MakeStandardRange(e_beg, e_end);
   }
@@ -104,15 +146,16 @@ public:
   Node edge_source(const Edge& eid) const noexcept {
     KATANA_LOG_DEBUG_ASSERT(eid < num_edges());
 
-    if (eid < adj_indices_[0]) {
+    if (eid < adj_view_[0]) {
       return Node{0};
     }
 
-    auto it = std::upper_bound(adj_indices_.begin(), adj_indices_.end(), eid);
-    KATANA_LOG_DEBUG_ASSERT(it != adj_indices_.end());
+    const Edge* adj_end = adj_view_ + num_nodes_;
+    auto it = std::upper_bound(adj_view_, adj_end, eid);
+    KATANA_LOG_DEBUG_ASSERT(it != adj_end);
     KATANA_LOG_DEBUG_ASSERT(*it > eid);
 
-    auto d = std::distance(adj_indices_.begin(), it);
+    auto d = std::distance(adj_view_, it);
     KATANA_LOG_DEBUG_ASSERT(static_cast<size_t>(d) < num_nodes());
     KATANA_LOG_DEBUG_ASSERT(d > 0);
 
@@ -120,8 +163,8 @@ public:
   }
 
   Node edge_dest(Edge edge_id) const noexcept {
-    KATANA_LOG_DEBUG_ASSERT(edge_id < dests_.size());
-    return dests_[edge_id];
+    KATANA_LOG_DEBUG_ASSERT(edge_id < num_edges_);
+    return dests_view_[edge_id];
   }
 
   nodes_range nodes(Node begin, Node end) const noexcept {
@@ -149,10 +192,27 @@ public:
   ///@returns Degree of node N
   size_t degree(Node node) const noexcept { return edges(node).size(); }
 
+  /// Beginning of the calling thread's edge-balanced slice of the nodes.
+  ///
+  /// The slice boundaries are computed once per (topology, active thread
+  /// count) and cached, so \ref katana::iterate picks up an edge-balanced
+  /// LocalRange for free instead of the default node-balanced split, which
+  /// degrades badly on power-law degree distributions.
+  node_iterator local_begin() const noexcept;
+
+  /// End of the calling thread's edge-balanced slice; see \ref local_begin.
+  node_iterator local_end() const noexcept;
+
   PropertyIndex edge_property_index(const Edge& eid) const noexcept {
     return eid;
   }
 
+  /// Identity mapping, so there is no permutation array; null tells
+  /// FlatTopologyView to read properties by edge id directly
+  const PropertyIndex* edge_property_index_data() const noexcept {
+    return nullptr;
+  }
+
   PropertyIndex node_property_index(const Node& nid) const noexcept {
     return nid;
   }
@@ -175,11 +235,37 @@ private:
   friend class EdgeShuffleTopology;
   friend class EdgeTypeAwareTopology;
 
-  NUMAArray<Edge>& GetAdjIndices() noexcept { return adj_indices_; }
-  NUMAArray<Node>& GetDests() noexcept { return dests_; }
+  NUMAArray<Edge>& GetAdjIndices() noexcept {
+    KATANA_LOG_DEBUG_ASSERT(!mem_mapped_view_);
+    return adj_indices_;
+  }
+  NUMAArray<Node>& GetDests() noexcept {
+    KATANA_LOG_DEBUG_ASSERT(!mem_mapped_view_);
+    return dests_;
+  }
 
+  /// Returns the calling thread's [begin, end) node slice, lazily building
+  /// the cached per-thread cutpoint table if it is missing or stale.
+  std::pair<Node, Node> GetThreadRange() const noexcept;
+
+  // Owning storage; empty when this topology is a mem-mapped view. All
+  // accessors go through the view pointers, which alias the NUMAArrays in
+  // the owning case.
   NUMAArray<Edge> adj_indices_;
   NUMAArray<Node> dests_;
+  const Edge* adj_view_{nullptr};
+  const Node* dests_view_{nullptr};
+  uint64_t num_nodes_{0};
+  uint64_t num_edges_{0};
+  bool mem_mapped_view_{false};
+
+  // Cached edge-balanced per-thread cutpoints; entry i is the first node of
+  // thread i's slice and the last entry is num_nodes(). Rebuilt under the
+  // lock whenever the active thread count (or the topology, for patched
+  // views) no longer matches. SimpleLock's copy constructor reinitializes,
+  // so the defaulted moves above stay valid.
+  mutable std::vector<Node> thread_ranges_;
+  mutable SimpleLock thread_ranges_lock_;
 };
 
 // TODO(amber): In the future, when we group properties e.g., by node or edge type,
@@ -196,6 +282,9 @@ public:
   EdgeShuffleTopology(const EdgeShuffleTopology&) = delete;
   EdgeShuffleTopology& operator=(const EdgeShuffleTopology&) = delete;
 
+  /// removes any scratch file left behind by SpillToScratch
+  ~EdgeShuffleTopology();
+
   enum class TransposeKind : int { kNo = 0, kYes };
 
   enum class EdgeSortKind : int {
@@ -220,6 +309,30 @@ public:
 
   void invalidate() noexcept { is_valid_ = false; }
 
+  /// true while SpillToScratch has the arrays parked on scratch storage;
+  /// see PGViewCache's topology memory budget
+  bool is_spilled() const noexcept { return is_spilled_; }
+
+  /// Approximate bytes of CSR array data this topology keeps resident;
+  /// 0 for mem-mapped views, whose pages belong to their backing file
+  size_t memory_usage() const noexcept {
+    if (is_mem_mapped_view() || is_spilled_) {
+      return 0;
+    }
+    return num_nodes() * sizeof(Edge) + num_edges() * sizeof(Node) +
+           num_edges() * sizeof(PropertyIndex);
+  }
+
+  /// Writes the CSR arrays to a scratch file (KATANA_TOPOLOGY_SPILL_DIR,
+  /// default /tmp) and frees them, leaving this object as a stub until
+  /// RestoreFromScratch puts them back. The caller must guarantee nothing
+  /// still reads this topology's arrays.
+  Result<void> SpillToScratch() noexcept;
+
+  /// Reloads the arrays written by SpillToScratch into fresh
+  /// NUMA-interleaved storage and removes the scratch file.
+  Result<void> RestoreFromScratch() noexcept;
+
   bool has_edges_sorted_by(const EdgeSortKind& kind) const noexcept {
     if (kind == EdgeSortKind::kAny) {
       return true;
@@ -232,6 +345,10 @@ public:
     return edge_prop_indices_[eid];
   }
 
+  const PropertyIndex* edge_property_index_data() const noexcept {
+    return edge_prop_indices_.data();
+  }
+
   // Need to redefine the method here so it overrides and hides base-class
   // version of this method
   Edge original_edge_id(const Edge& eid) const noexcept {
@@ -240,9 +357,24 @@ public:
 
   static std::unique_ptr<EdgeShuffleTopology> MakeTransposeCopy(
       const PropertyGraph* pg);
+
+  /// Builds the transpose directly from \p topology without consulting a
+  /// persisted transpose; used by the pipelined open path, which runs
+  /// before the PropertyGraph exists.
+  static std::unique_ptr<EdgeShuffleTopology> MakeTransposeCopy(
+      const GraphTopology& topology);
+
   static std::unique_ptr<EdgeShuffleTopology> MakeOriginalCopy(
       const PropertyGraph* pg);
 
+  /// Reconstitutes a transposed topology from arrays persisted by
+  /// PropertyGraph::WriteTransposeTopology(). The arrays are copied into
+  /// NUMA-interleaved storage; the caller's buffers need not outlive the
+  /// returned topology.
+  static std::unique_ptr<EdgeShuffleTopology> MakeTransposeFromArrays(
+      const Edge* adj_indices, size_t num_nodes, const Node* dests,
+      size_t num_edges, const PropertyIndex* edge_prop_indices);
+
   static std::unique_ptr<EdgeShuffleTopology> Make(
       const PropertyGraph* pg, const TransposeKind& tpose_todo,
       const EdgeSortKind& edge_sort_todo) noexcept {
@@ -310,6 +442,9 @@ protected:
 
 private:
   bool is_valid_ = true;
+  bool is_spilled_ = false;
+  // scratch file holding the arrays while is_spilled_
+  std::string spill_path_;
   TransposeKind tpose_state_ = TransposeKind::kNo;
   EdgeSortKind edge_sort_state_ = EdgeSortKind::kAny;
 
@@ -329,6 +464,8 @@ public:
     kAny = 0,
     kSortedByDegree,
     kSortedByNodeType,
+    kReverseCuthillMcKee,
+    kGorder,
   };
 
   PropertyIndex node_property_index(const Node& nid) const noexcept {
@@ -352,6 +489,16 @@ public:
   static std::unique_ptr<ShuffleTopology> MakeSortedByNodeType(
       const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo) noexcept;
 
+  /// Renumbers nodes in reverse Cuthill-McKee order; see
+  /// katana::ComputeRCMPermutation for the order's properties
+  static std::unique_ptr<ShuffleTopology> MakeReverseCuthillMcKee(
+      const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo) noexcept;
+
+  /// Renumbers nodes in Gorder window order; see
+  /// katana::ComputeGorderPermutation for the order's properties
+  static std::unique_ptr<ShuffleTopology> MakeGorder(
+      const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo) noexcept;
+
   static std::unique_ptr<ShuffleTopology> MakeFromTopo(
       const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo,
       const NodeSortKind& node_sort_todo,
@@ -368,6 +515,12 @@ public:
     case NodeSortKind::kSortedByNodeType:
       ret = MakeSortedByNodeType(pg, seed_topo);
       break;
+    case NodeSortKind::kReverseCuthillMcKee:
+      ret = MakeReverseCuthillMcKee(pg, seed_topo);
+      break;
+    case NodeSortKind::kGorder:
+      ret = MakeGorder(pg, seed_topo);
+      break;
     default:
       KATANA_LOG_FATAL("switch case fell through");
     }
@@ -393,63 +546,17 @@ private:
         node_prop_indices.begin(), node_prop_indices.end(),
         [&](const auto& i1, const auto& i2) { return cmp(i1, i2); });
 
-    GraphTopology::AdjIndexVec degrees;
-    degrees.allocateInterleaved(seed_topo.num_nodes());
-
-    katana::NUMAArray<GraphTopologyTypes::Node> old_to_new_map;
-    old_to_new_map.allocateInterleaved(seed_topo.num_nodes());
-    // TODO(amber): given 32-bit node ids, put a check here that
-    // node_prop_indices.size() < 2^32
-    katana::do_all(
-        katana::iterate(size_t{0}, node_prop_indices.size()),
-        [&](auto i) {
-          // node_prop_indices[i] gives old node id
-          old_to_new_map[node_prop_indices[i]] = i;
-          degrees[i] = seed_topo.degree(node_prop_indices[i]);
-        },
-        katana::no_stats());
-
-    KATANA_LOG_DEBUG_ASSERT(std::is_sorted(degrees.begin(), degrees.end()));
-
-    katana::ParallelSTL::partial_sum(
-        degrees.begin(), degrees.end(), degrees.begin());
-
-    GraphTopologyTypes::EdgeDestVec new_dest_vec;
-    new_dest_vec.allocateInterleaved(seed_topo.num_edges());
-
-    GraphTopologyTypes::PropIndexVec edge_prop_indices;
-    edge_prop_indices.allocateInterleaved(seed_topo.num_edges());
-
-    katana::do_all(
-        katana::iterate(seed_topo.all_nodes()),
-        [&](auto old_src_id) {
-          auto new_srd_id = old_to_new_map[old_src_id];
-          auto new_out_index = new_srd_id > 0 ? degrees[new_srd_id - 1] : 0;
-
-          for (auto e : seed_topo.edges(old_src_id)) {
-            auto new_edge_dest = old_to_new_map[seed_topo.edge_dest(e)];
-            KATANA_LOG_DEBUG_ASSERT(new_edge_dest < seed_topo.num_nodes());
-
-            auto new_edge_id = new_out_index;
-            ++new_out_index;
-            KATANA_LOG_DEBUG_ASSERT(new_out_index <= degrees[new_srd_id]);
-
-            new_dest_vec[new_edge_id] = new_edge_dest;
-
-            // copy over edge_property_index mapping from old edge to new edge
-            edge_prop_indices[new_edge_id] = seed_topo.edge_property_index(e);
-          }
-          KATANA_LOG_DEBUG_ASSERT(new_out_index == degrees[new_srd_id]);
-        },
-        katana::steal(), katana::no_stats());
-
-    return std::make_unique<ShuffleTopology>(ShuffleTopology{
-        seed_topo.transpose_state(), node_sort_todo,
-        seed_topo.edge_sort_state(), std::move(degrees),
-        std::move(node_prop_indices), std::move(new_dest_vec),
-        std::move(edge_prop_indices)});
+    return MakeNodePermutedTopo(
+        seed_topo, std::move(node_prop_indices), node_sort_todo);
   }
 
+  /// Builds a topology whose node \c i is old node \c node_prop_indices[i];
+  /// shared tail of the comparator-sorted and permutation-based (RCM,
+  /// Gorder) factories
+  static std::unique_ptr<ShuffleTopology> MakeNodePermutedTopo(
+      const EdgeShuffleTopology& seed_topo, PropIndexVec&& node_prop_indices,
+      const NodeSortKind& node_sort_todo);
+
   ShuffleTopology(
       const TransposeKind& tpose_todo, const NodeSortKind& node_sort_todo,
       const EdgeSortKind& edge_sort_todo, AdjIndexVec&& adj_indices,
@@ -496,14 +603,19 @@ public:
       const PropertyGraph* pg) noexcept;
   // TODO(amber): add MakeFromNodeTypes
 
+  /// Sentinel returned by the dense lookup table for types with no edges.
+  static constexpr uint32_t kInvalidIndex =
+      std::numeric_limits<uint32_t>::max();
+
   EntityType GetType(uint32_t index) const noexcept {
     KATANA_LOG_DEBUG_ASSERT(size_t(index) < index_to_type_map_.size());
     return index_to_type_map_[index];
   }
 
   uint32_t GetIndex(const EntityType& edge_type) const noexcept {
-    KATANA_LOG_DEBUG_ASSERT(type_to_index_map_.count(edge_type) > 0);
-    return type_to_index_map_.at(edge_type);
+    KATANA_LOG_DEBUG_ASSERT(
+        dense_type_to_index_[edge_type] != kInvalidIndex);
+    return dense_type_to_index_[edge_type];
   }
 
   size_t num_unique_types() const noexcept { return index_to_type_map_.size(); }
@@ -511,7 +623,7 @@ public:
   /// @param edge_type: edge_type to check
   /// @returns true iff there exists some edge in the graph with that edge_type
   bool has_edge_type_id(const EntityType& edge_type) const noexcept {
-    return (type_to_index_map_.find(edge_type) != type_to_index_map_.cend());
+    return dense_type_to_index_[edge_type] != kInvalidIndex;
   }
 
   /// Wrapper to get the distinct edge types in the graph.
@@ -533,10 +645,19 @@ private:
         index_to_type_map_(std::move(index_to_type)),
         is_valid_(true) {
     KATANA_LOG_ASSERT(index_to_type_map_.size() == type_to_index_map_.size());
+    // EntityType is a small integer, so hot-path lookups go through a dense
+    // table instead of the hash map.
+    dense_type_to_index_.fill(kInvalidIndex);
+    for (const auto& [type, index] : type_to_index_map_) {
+      dense_type_to_index_[type] = index;
+    }
   }
 
   TypeIDToIndexMap type_to_index_map_;
   IndexToTypeIDMap index_to_type_map_;
+  std::array<
+      uint32_t, size_t{std::numeric_limits<EntityType>::max()} + 1>
+      dense_type_to_index_;
   bool is_valid_ = true;
 };
 
@@ -565,6 +686,10 @@ public:
     return topo().edge_source(eid);
   }
 
+  auto adj_data() const noexcept { return topo().adj_data(); }
+
+  auto dest_data() const noexcept { return topo().dest_data(); }
+
   /// @param node node to get degree for
   /// @returns Degree of node N
   auto degree(const Node& node) const noexcept { return topo().degree(node); }
@@ -602,6 +727,12 @@ public:
     return topo().original_edge_id(eid);
   }
 
+  // only instantiated on use, so wrapping a topology without a
+  // property-index array (e.g. the original GraphTopology) stays legal
+  auto edge_property_index_data() const noexcept {
+    return topo().edge_property_index_data();
+  }
+
 protected:
   const Topo& topo() const noexcept { return *topo_ptr_; }
 
@@ -716,6 +847,10 @@ public:
     return projected_to_original_edges_mapping_[eid];
   }
 
+  const PropertyIndex* edge_property_index_data() const noexcept {
+    return projected_to_original_edges_mapping_.data();
+  }
+
   /// @param eid the input eid (must be projected edge id)
   Edge projected_to_original_edge_id(const Edge& eid) const noexcept {
     return edge_property_index(eid);
@@ -785,6 +920,606 @@ private:
   NUMAArray<Edge> projected_to_original_edges_mapping_;
 };
 
+/// A zero-copy projection over the default CSR topology. Instead of copying
+/// and renumbering the node/edge arrays like ProjectedTopology, it keeps
+/// membership bitsets plus the list of active nodes and filters the parent's
+/// arrays during iteration. Creating one costs O(active set) retained memory
+/// rather than O(graph), which matters when many projections of the same
+/// graph are alive at once.
+///
+/// Node and edge IDs are the ORIGINAL IDs, so property access needs no
+/// index translation. Call Materialize() to build the compact, renumbered
+/// ProjectedTopology on demand when a kernel needs dense IDs.
+class KATANA_EXPORT LazyProjectedTopology : public GraphTopologyTypes {
+public:
+  /// Forward iterator over a node's original edge IDs, skipping edges
+  /// filtered out of the projection.
+  class active_edge_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Edge;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Edge*;
+    using reference = Edge;
+
+    active_edge_iterator() = default;
+
+    Edge operator*() const noexcept { return current_; }
+
+    active_edge_iterator& operator++() noexcept {
+      ++current_;
+      SkipInactive();
+      return *this;
+    }
+
+    active_edge_iterator operator++(int) noexcept {
+      active_edge_iterator ret = *this;
+      ++(*this);
+      return ret;
+    }
+
+    bool operator==(const active_edge_iterator& that) const noexcept {
+      return current_ == that.current_;
+    }
+
+    bool operator!=(const active_edge_iterator& that) const noexcept {
+      return !(*this == that);
+    }
+
+  private:
+    friend class LazyProjectedTopology;
+
+    active_edge_iterator(
+        const DynamicBitset* active_edges, Edge current, Edge end) noexcept
+        : active_edges_(active_edges), current_(current), end_(end) {
+      SkipInactive();
+    }
+
+    void SkipInactive() noexcept {
+      while (current_ != end_ && !active_edges_->test(current_)) {
+        ++current_;
+      }
+    }
+
+    const DynamicBitset* active_edges_{nullptr};
+    Edge current_{0};
+    Edge end_{0};
+  };
+
+  using active_edges_range = StandardRange<active_edge_iterator>;
+  using active_nodes_range = StandardRange<const Node*>;
+
+  LazyProjectedTopology() = default;
+  LazyProjectedTopology(LazyProjectedTopology&&) = default;
+  LazyProjectedTopology& operator=(LazyProjectedTopology&&) = default;
+
+  LazyProjectedTopology(const LazyProjectedTopology&) = delete;
+  LazyProjectedTopology& operator=(const LazyProjectedTopology&) = delete;
+
+  /// Builds the projection membership by filtering nodes and edges on
+  /// entity types, like ProjectedTopology::MakeTypeProjectedTopology, but
+  /// without copying the parent's topology arrays.
+  static std::unique_ptr<LazyProjectedTopology> MakeTypeProjection(
+      const PropertyGraph* pg, const std::vector<std::string>& node_types,
+      const std::vector<std::string>& edge_types);
+
+  /// Number of nodes in the projection.
+  uint64_t num_nodes() const noexcept { return active_node_list_.size(); }
+
+  /// Number of edges in the projection.
+  uint64_t num_edges() const noexcept { return num_active_edges_; }
+
+  uint64_t num_original_nodes() const noexcept { return csr().num_nodes(); }
+
+  uint64_t num_original_edges() const noexcept { return csr().num_edges(); }
+
+  bool has_node(Node original_nid) const noexcept {
+    return active_nodes_.test(original_nid);
+  }
+
+  bool has_edge(Edge original_eid) const noexcept {
+    return active_edges_.test(original_eid);
+  }
+
+  /// Range over the original IDs of the projection's nodes, in ascending
+  /// order.
+  active_nodes_range active_nodes() const noexcept {
+    return MakeStandardRange(
+        active_node_list_.data(),
+        active_node_list_.data() + active_node_list_.size());
+  }
+
+  /// Gets the projected edge range of some node; yields original edge IDs.
+  /// Empty if the node itself is not in the projection.
+  ///
+  /// \param node ORIGINAL node ID to get the edge range of
+  active_edges_range edges(Node node) const noexcept {
+    if (!has_node(node)) {
+      return MakeStandardRange(
+          active_edge_iterator{}, active_edge_iterator{});
+    }
+    auto all = csr().edges(node);
+    return MakeStandardRange(
+        active_edge_iterator{&active_edges_, *all.begin(), *all.end()},
+        active_edge_iterator{&active_edges_, *all.end(), *all.end()});
+  }
+
+  Node edge_dest(Edge original_eid) const noexcept {
+    return csr().edge_dest(original_eid);
+  }
+
+  /// Degree of a node within the projection. Counts the filtered edge
+  /// range, so this is O(original degree), not O(1).
+  size_t degree(Node node) const noexcept {
+    size_t d = 0;
+    for (auto e : edges(node)) {
+      (void)e;
+      ++d;
+    }
+    return d;
+  }
+
+  /// IDs are original, so property indices need no translation.
+  PropertyIndex node_property_index(const Node& nid) const noexcept {
+    return nid;
+  }
+
+  PropertyIndex edge_property_index(const Edge& eid) const noexcept {
+    return eid;
+  }
+
+  /// Materializes the compact, renumbered projection. O(graph) work and
+  /// memory; only pay for it when a kernel needs dense IDs.
+  std::unique_ptr<ProjectedTopology> Materialize(
+      const PropertyGraph* pg) const {
+    return ProjectedTopology::MakeTypeProjectedTopology(
+        pg, node_types_, edge_types_);
+  }
+
+  bool is_valid() const noexcept { return is_valid_; }
+
+  void invalidate() noexcept { is_valid_ = false; }
+
+private:
+  LazyProjectedTopology(
+      const GraphTopology* csr, DynamicBitset&& active_nodes,
+      DynamicBitset&& active_edges, NUMAArray<Node>&& active_node_list,
+      uint64_t num_active_edges, std::vector<std::string> node_types,
+      std::vector<std::string> edge_types) noexcept
+      : csr_(csr),
+        active_nodes_(std::move(active_nodes)),
+        active_edges_(std::move(active_edges)),
+        active_node_list_(std::move(active_node_list)),
+        num_active_edges_(num_active_edges),
+        node_types_(std::move(node_types)),
+        edge_types_(std::move(edge_types)) {}
+
+  const GraphTopology& csr() const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(csr_);
+    return *csr_;
+  }
+
+  const GraphTopology* csr_{nullptr};
+  DynamicBitset active_nodes_;
+  DynamicBitset active_edges_;
+  NUMAArray<Node> active_node_list_;
+  uint64_t num_active_edges_{0};
+  std::vector<std::string> node_types_;
+  std::vector<std::string> edge_types_;
+  bool is_valid_ = true;
+};
+
+namespace internal {
+
+/// Varint (LEB128) helpers used by CompressedTopology. Encoded values are
+/// 7 bits per byte, least-significant group first, high bit set on all but
+/// the final byte.
+inline size_t
+VarintLength(uint32_t val) noexcept {
+  size_t len = 1;
+  while (val >= 0x80) {
+    val >>= 7;
+    ++len;
+  }
+  return len;
+}
+
+inline uint8_t*
+EncodeVarint(uint8_t* buf, uint32_t val) noexcept {
+  while (val >= 0x80) {
+    *buf++ = static_cast<uint8_t>(val) | 0x80;
+    val >>= 7;
+  }
+  *buf++ = static_cast<uint8_t>(val);
+  return buf;
+}
+
+inline const uint8_t*
+DecodeVarint(const uint8_t* buf, uint32_t* val) noexcept {
+  uint32_t result = *buf;
+  if (result < 0x80) {
+    *val = result;
+    return buf + 1;
+  }
+  result &= 0x7f;
+  uint32_t shift = 7;
+  uint8_t byte;
+  do {
+    byte = *++buf;
+    result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  *val = result;
+  return buf + 1;
+}
+
+}  // end namespace internal
+
+/// A compressed CSR topology that stores each node's destination list as
+/// varint-encoded deltas over the sorted destination IDs. For sorted
+/// web-scale graphs this cuts topology memory 3-4x relative to the raw
+/// 4-byte-per-edge representation.
+///
+/// Edge IDs remain the positions in the sorted CSR, so edges(node) ranges
+/// and edge_property_index() behave like EdgeShuffleTopology. Destinations
+/// are not randomly addressable; traverse them through neighbors(node),
+/// which decodes lazily, or DecodeNeighborhood(), which decodes a node's
+/// full adjacency block into a caller-provided buffer.
+class KATANA_EXPORT CompressedTopology : public GraphTopologyTypes {
+public:
+  /// Forward iterator that decodes one destination per increment.
+  class neighbor_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Node;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Node*;
+    using reference = Node;
+
+    neighbor_iterator() = default;
+
+    Node operator*() const noexcept { return current_; }
+
+    neighbor_iterator& operator++() noexcept {
+      ++idx_;
+      if (idx_ < degree_) {
+        uint32_t delta;
+        buf_ = internal::DecodeVarint(buf_, &delta);
+        current_ += delta;
+      }
+      return *this;
+    }
+
+    neighbor_iterator operator++(int) noexcept {
+      neighbor_iterator ret = *this;
+      ++(*this);
+      return ret;
+    }
+
+    bool operator==(const neighbor_iterator& that) const noexcept {
+      return idx_ == that.idx_;
+    }
+
+    bool operator!=(const neighbor_iterator& that) const noexcept {
+      return !(*this == that);
+    }
+
+  private:
+    friend class CompressedTopology;
+
+    neighbor_iterator(const uint8_t* buf, uint32_t degree) noexcept
+        : buf_(buf), degree_(degree) {
+      if (degree_ > 0) {
+        uint32_t first;
+        buf_ = internal::DecodeVarint(buf_, &first);
+        current_ = first;
+      }
+    }
+
+    static neighbor_iterator MakeEnd(uint32_t degree) noexcept {
+      neighbor_iterator ret;
+      ret.idx_ = degree;
+      ret.degree_ = degree;
+      return ret;
+    }
+
+    const uint8_t* buf_{nullptr};
+    uint32_t idx_{0};
+    uint32_t degree_{0};
+    Node current_{0};
+  };
+
+  using neighbors_range = StandardRange<neighbor_iterator>;
+
+  CompressedTopology() = default;
+  CompressedTopology(CompressedTopology&&) = default;
+  CompressedTopology& operator=(CompressedTopology&&) = default;
+
+  CompressedTopology(const CompressedTopology&) = delete;
+  CompressedTopology& operator=(const CompressedTopology&) = delete;
+
+  /// Builds a CompressedTopology by delta/varint-encoding the destination
+  /// array of a topology whose edges are sorted by destination ID.
+  static std::unique_ptr<CompressedTopology> Make(
+      const EdgeShuffleTopology& sorted_topo) noexcept;
+
+  uint64_t num_nodes() const noexcept { return adj_indices_.size(); }
+
+  uint64_t num_edges() const noexcept { return num_edges_; }
+
+  /// Size in bytes of the encoded destination stream; compare against
+  /// num_edges() * sizeof(Node) for the achieved compression ratio.
+  size_t compressed_dests_size() const noexcept {
+    return compressed_dests_.size();
+  }
+
+  edges_range edges(Node node) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(node < adj_indices_.size());
+    edge_iterator e_beg{node > 0 ? adj_indices_[node - 1] : 0};
+    edge_iterator e_end{adj_indices_[node]};
+    return MakeStandardRange(e_beg, e_end);
+  }
+
+  size_t degree(Node node) const noexcept { return edges(node).size(); }
+
+  /// Lazily-decoding range over the sorted destinations of a node.
+  neighbors_range neighbors(Node node) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(node < adj_indices_.size());
+    const uint64_t byte_beg = node > 0 ? byte_offsets_[node - 1] : 0;
+    const auto deg = static_cast<uint32_t>(degree(node));
+    return MakeStandardRange(
+        neighbor_iterator{&compressed_dests_[byte_beg], deg},
+        neighbor_iterator::MakeEnd(deg));
+  }
+
+  /// Decodes the full adjacency block of a node into \p out, which must
+  /// have room for degree(node) entries.
+  /// @returns the number of destinations written
+  size_t DecodeNeighborhood(Node node, Node* out) const noexcept {
+    size_t i = 0;
+    for (auto dest : neighbors(node)) {
+      out[i++] = dest;
+    }
+    return i;
+  }
+
+  nodes_range nodes(Node begin, Node end) const noexcept {
+    return MakeStandardRange<node_iterator>(begin, end);
+  }
+
+  nodes_range all_nodes() const noexcept {
+    return nodes(Node{0}, static_cast<Node>(num_nodes()));
+  }
+
+  edges_range all_edges() const noexcept {
+    return MakeStandardRange<edge_iterator>(Edge{0}, Edge{num_edges()});
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const noexcept { return node_iterator(0); }
+
+  node_iterator end() const noexcept { return node_iterator(num_nodes()); }
+
+  size_t size() const noexcept { return num_nodes(); }
+
+  bool empty() const noexcept { return num_nodes() == 0; }
+
+  PropertyIndex edge_property_index(const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < num_edges());
+    return edge_prop_indices_[eid];
+  }
+
+  PropertyIndex node_property_index(const Node& nid) const noexcept {
+    return nid;
+  }
+
+  Node original_node_id(const Node& nid) const noexcept {
+    return static_cast<Node>(node_property_index(nid));
+  }
+
+  Edge original_edge_id(const Edge& eid) const noexcept {
+    return edge_property_index(eid);
+  }
+
+  bool is_valid() const noexcept { return is_valid_; }
+
+  void invalidate() noexcept { is_valid_ = false; }
+
+private:
+  CompressedTopology(
+      AdjIndexVec&& adj_indices, NUMAArray<uint64_t>&& byte_offsets,
+      NUMAArray<uint8_t>&& compressed_dests, PropIndexVec&& edge_prop_indices,
+      Edge num_edges) noexcept
+      : adj_indices_(std::move(adj_indices)),
+        byte_offsets_(std::move(byte_offsets)),
+        compressed_dests_(std::move(compressed_dests)),
+        edge_prop_indices_(std::move(edge_prop_indices)),
+        num_edges_(num_edges) {}
+
+  AdjIndexVec adj_indices_;
+  NUMAArray<uint64_t> byte_offsets_;
+  NUMAArray<uint8_t> compressed_dests_;
+  PropIndexVec edge_prop_indices_;
+  Edge num_edges_{0};
+  bool is_valid_ = true;
+};
+
+/// Topology wrapper presenting CompressedTopology to PGView users, in the
+/// mold of BasicTopologyWrapper but forwarding the decode-based traversal
+/// API instead of edge_dest().
+class KATANA_EXPORT CompressedTopologyWrapper : public GraphTopologyTypes {
+public:
+  explicit CompressedTopologyWrapper(const CompressedTopology* t) noexcept
+      : topo_ptr_(t) {
+    KATANA_LOG_DEBUG_ASSERT(topo_ptr_);
+  }
+
+  auto num_nodes() const noexcept { return topo().num_nodes(); }
+
+  auto num_edges() const noexcept { return topo().num_edges(); }
+
+  auto edges(const Node& N) const noexcept { return topo().edges(N); }
+
+  auto neighbors(const Node& N) const noexcept { return topo().neighbors(N); }
+
+  auto DecodeNeighborhood(const Node& N, Node* out) const noexcept {
+    return topo().DecodeNeighborhood(N, out);
+  }
+
+  auto degree(const Node& node) const noexcept { return topo().degree(node); }
+
+  auto nodes(const Node& begin, const Node& end) const noexcept {
+    return topo().nodes(begin, end);
+  }
+
+  auto all_nodes() const noexcept { return topo().all_nodes(); }
+
+  auto all_edges() const noexcept { return topo().all_edges(); }
+
+  // Standard container concepts
+
+  auto begin() const noexcept { return topo().begin(); }
+
+  auto end() const noexcept { return topo().end(); }
+
+  auto size() const noexcept { return topo().size(); }
+
+  auto empty() const noexcept { return topo().empty(); }
+
+  auto edge_property_index(const Edge& e) const noexcept {
+    return topo().edge_property_index(e);
+  }
+
+  auto node_property_index(const Node& nid) const noexcept {
+    return topo().node_property_index(nid);
+  }
+
+  auto original_node_id(const Node& nid) const noexcept {
+    return topo().original_node_id(nid);
+  }
+
+  auto original_edge_id(const Edge& eid) const noexcept {
+    return topo().original_edge_id(eid);
+  }
+
+protected:
+  const CompressedTopology& topo() const noexcept { return *topo_ptr_; }
+
+private:
+  const CompressedTopology* topo_ptr_;
+};
+
+/// Per-block metadata for EdgeBlockedTopology. A block covers the
+/// consecutive CSR edge IDs [edge_begin, edge_end); first_node is the node
+/// owning edge_begin, and [min_dest, max_dest] bounds the destinations
+/// appearing in the block.
+struct KATANA_EXPORT EdgeBlockDescriptor {
+  GraphTopologyTypes::Edge edge_begin;
+  GraphTopologyTypes::Edge edge_end;
+  GraphTopologyTypes::Node first_node;
+  GraphTopologyTypes::Node min_dest;
+  GraphTopologyTypes::Node max_dest;
+};
+
+/// A cache-blocked overlay on the default CSR topology. Edges are grouped
+/// into fixed-size blocks of consecutive edge IDs, sized so a block's
+/// destination array fits in L2, and each block records the range of
+/// destinations it touches. PageRank-style kernels can iterate blocks
+/// instead of nodes and keep the destination data of the current block
+/// resident in cache, instead of thrashing the LLC on the multi-megabyte
+/// adjacency lists of hub nodes.
+///
+/// The overlay references the PropertyGraph's own CSR arrays; node and
+/// edge IDs are unchanged, so property access works as for the default
+/// topology.
+class KATANA_EXPORT EdgeBlockedTopology : public GraphTopologyTypes {
+public:
+  /// Edges per block: 64K 4-byte destinations = 256KB, sized to a typical
+  /// L2 cache.
+  static constexpr uint64_t kEdgesPerBlock = uint64_t{64} * 1024;
+
+  EdgeBlockedTopology() = default;
+  EdgeBlockedTopology(EdgeBlockedTopology&&) = default;
+  EdgeBlockedTopology& operator=(EdgeBlockedTopology&&) = default;
+
+  EdgeBlockedTopology(const EdgeBlockedTopology&) = delete;
+  EdgeBlockedTopology& operator=(const EdgeBlockedTopology&) = delete;
+
+  static std::unique_ptr<EdgeBlockedTopology> Make(
+      const PropertyGraph* pg) noexcept;
+
+  /// The CSR this overlay describes.
+  const GraphTopology& csr() const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(csr_);
+    return *csr_;
+  }
+
+  uint64_t num_nodes() const noexcept { return csr().num_nodes(); }
+
+  uint64_t num_edges() const noexcept { return csr().num_edges(); }
+
+  uint64_t num_blocks() const noexcept { return blocks_.size(); }
+
+  const EdgeBlockDescriptor& block(uint64_t block_id) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(block_id < blocks_.size());
+    return blocks_[block_id];
+  }
+
+  /// Edge range covered by a block; the edges belong to consecutive nodes
+  /// starting at block(block_id).first_node.
+  edges_range block_edges(uint64_t block_id) const noexcept {
+    const EdgeBlockDescriptor& b = block(block_id);
+    return MakeStandardRange(
+        edge_iterator{b.edge_begin}, edge_iterator{b.edge_end});
+  }
+
+  bool is_valid() const noexcept { return is_valid_; }
+
+  void invalidate() noexcept { is_valid_ = false; }
+
+private:
+  EdgeBlockedTopology(
+      const GraphTopology* csr,
+      NUMAArray<EdgeBlockDescriptor>&& blocks) noexcept
+      : csr_(csr), blocks_(std::move(blocks)) {}
+
+  const GraphTopology* csr_{nullptr};
+  NUMAArray<EdgeBlockDescriptor> blocks_;
+  bool is_valid_ = true;
+};
+
+/// Topology wrapper presenting the plain CSR API plus block iteration for
+/// EdgeBlockedTopology.
+class KATANA_EXPORT EdgeBlockedTopologyWrapper
+    : public BasicTopologyWrapper<GraphTopology> {
+  using Base = BasicTopologyWrapper<GraphTopology>;
+
+public:
+  explicit EdgeBlockedTopologyWrapper(const EdgeBlockedTopology* t) noexcept
+      : Base(&t->csr()), blocked_topo_ptr_(t) {
+    KATANA_LOG_DEBUG_ASSERT(blocked_topo_ptr_);
+  }
+
+  auto num_blocks() const noexcept { return blocked().num_blocks(); }
+
+  const EdgeBlockDescriptor& block(uint64_t block_id) const noexcept {
+    return blocked().block(block_id);
+  }
+
+  auto block_edges(uint64_t block_id) const noexcept {
+    return blocked().block_edges(block_id);
+  }
+
+protected:
+  const EdgeBlockedTopology& blocked() const noexcept {
+    return *blocked_topo_ptr_;
+  }
+
+private:
+  const EdgeBlockedTopology* blocked_topo_ptr_;
+};
+
 template <typename Topo>
 class KATANA_EXPORT ProjectedTopologyWrapper : public GraphTopologyTypes {
 public:
@@ -1263,6 +1998,122 @@ public:
   }
 };
 
+/// FlatTopologyView collapses a stack of topology wrappers into one flat
+/// value type: the CSR pointers are captured once at construction and
+/// every accessor is direct array arithmetic, so traversal loops compile
+/// to the same code as hand-written CSR iteration. The wrapper templates
+/// above forward each call through a chain of this-pointer indirections
+/// that the optimizer does not always flatten; instruction profiles show
+/// the residual call overhead in edge-iteration inner loops.
+///
+/// Build one with \ref MakeFlatView from any CSR-backed view or topology
+/// just before a hot loop:
+///
+/// \code
+/// auto view = pg->BuildView<PropertyGraphViews::EdgesSortedByDestID>();
+/// auto flat = katana::MakeFlatView(view);
+/// katana::do_all(katana::iterate(flat), [&](auto n) {
+///   for (auto e : flat.edges(n)) {
+///     ... flat.edge_dest(e) ...
+///   }
+/// });
+/// \endcode
+///
+/// The view aliases the source topology's arrays and does not keep it
+/// alive; the source must outlive the flat view. Views without raw CSR
+/// arrays (compressed, blocked, edge-type-aware lookups) cannot be
+/// flattened.
+class FlatTopologyView : public GraphTopologyTypes {
+public:
+  FlatTopologyView() = default;
+
+  template <typename Topo>
+  static FlatTopologyView Make(const Topo& topo) noexcept {
+    FlatTopologyView view;
+    view.adj_indices_ = topo.adj_data();
+    view.dests_ = topo.dest_data();
+    view.num_nodes_ = topo.num_nodes();
+    view.num_edges_ = topo.num_edges();
+    // shuffled topologies read properties through a permutation; the
+    // original topology's identity mapping stays a null pointer
+    if constexpr (has_edge_property_index_data<Topo>::value) {
+      view.edge_prop_indices_ = topo.edge_property_index_data();
+    }
+    return view;
+  }
+
+  uint64_t num_nodes() const noexcept { return num_nodes_; }
+
+  uint64_t num_edges() const noexcept { return num_edges_; }
+
+  const Edge* adj_data() const noexcept { return adj_indices_; }
+
+  const Node* dest_data() const noexcept { return dests_; }
+
+  edges_range edges(Node node) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(node < num_nodes_);
+    edge_iterator e_beg{node > 0 ? adj_indices_[node - 1] : 0};
+    edge_iterator e_end{adj_indices_[node]};
+    return MakeStandardRange(e_beg, e_end);
+  }
+
+  Node edge_dest(const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < num_edges_);
+    return dests_[eid];
+  }
+
+  size_t degree(Node node) const noexcept { return edges(node).size(); }
+
+  PropertyIndex edge_property_index(const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < num_edges_);
+    return edge_prop_indices_ ? edge_prop_indices_[eid] : eid;
+  }
+
+  nodes_range nodes(Node begin, Node end) const noexcept {
+    return MakeStandardRange<node_iterator>(begin, end);
+  }
+
+  nodes_range all_nodes() const noexcept {
+    return nodes(Node{0}, static_cast<Node>(num_nodes_));
+  }
+
+  edges_range all_edges() const noexcept {
+    return MakeStandardRange<edge_iterator>(Edge{0}, Edge{num_edges_});
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const noexcept { return node_iterator(0); }
+
+  node_iterator end() const noexcept { return node_iterator(num_nodes_); }
+
+  size_t size() const noexcept { return num_nodes_; }
+
+  bool empty() const noexcept { return num_nodes_ == 0; }
+
+private:
+  template <typename T, typename = void>
+  struct has_edge_property_index_data : std::false_type {};
+  template <typename T>
+  struct has_edge_property_index_data<
+      T, std::void_t<decltype(
+             std::declval<const T&>().edge_property_index_data())>>
+      : std::true_type {};
+
+  const Edge* adj_indices_{nullptr};
+  const Node* dests_{nullptr};
+  const PropertyIndex* edge_prop_indices_{nullptr};
+  uint64_t num_nodes_{0};
+  uint64_t num_edges_{0};
+};
+
+/// Flattens any CSR-backed topology view; \see FlatTopologyView
+template <typename Topo>
+FlatTopologyView
+MakeFlatView(const Topo& topo) noexcept {
+  return FlatTopologyView::Make(topo);
+}
+
 template <typename Topo>
 class BasicPropGraphViewWrapper : public Topo {
   using Base = Topo;
@@ -1274,6 +2125,14 @@ public:
 
   const PropertyGraph& property_graph() const noexcept { return *prop_graph_; }
 
+  /// Edge property \p name physically permuted into this view's edge
+  /// order, materialized and cached on first use; \see
+  /// PGViewCache::GetMaterializedEdgeProperty for what qualifies and when
+  /// the copy is dropped. Only instantiated on use, and only for views
+  /// whose topology is a shuffled CSR. Defined in PropertyGraph.h.
+  Result<std::shared_ptr<arrow::Array>> GetMaterializedEdgeProperty(
+      const std::string& name) const;
+
 private:
   const PropertyGraph* prop_graph_;
 };
@@ -1287,6 +2146,9 @@ using PGViewBiDirectional = BasicPropGraphViewWrapper<SimpleBiDirTopology>;
 using PGViewEdgeTypeAwareBiDir =
     BasicPropGraphViewWrapper<EdgeTypeAwareBiDirTopology>;
 using PGViewProjectedGraph = BasicPropGraphViewWrapper<ProjectedTopology>;
+using PGViewCompressedEdgesSortedByDestID =
+    BasicPropGraphViewWrapper<CompressedTopologyWrapper>;
+using PGViewEdgesBlocked = BasicPropGraphViewWrapper<EdgeBlockedTopologyWrapper>;
 
 template <typename PGView>
 struct PGViewBuilder {};
@@ -1350,6 +2212,29 @@ struct PGViewBuilder<PGViewEdgeTypeAwareBiDir> {
   }
 };
 
+template <>
+struct PGViewBuilder<PGViewCompressedEdgesSortedByDestID> {
+  template <typename ViewCache>
+  static PGViewCompressedEdgesSortedByDestID BuildView(
+      const PropertyGraph* pg, ViewCache& viewCache) noexcept {
+    auto compressed_topo = viewCache.BuildOrGetCompressedTopo(pg);
+
+    return PGViewCompressedEdgesSortedByDestID{
+        pg, CompressedTopologyWrapper{compressed_topo}};
+  }
+};
+
+template <>
+struct PGViewBuilder<PGViewEdgesBlocked> {
+  template <typename ViewCache>
+  static PGViewEdgesBlocked BuildView(
+      const PropertyGraph* pg, ViewCache& viewCache) noexcept {
+    auto blocked_topo = viewCache.BuildOrGetBlockedTopo(pg);
+
+    return PGViewEdgesBlocked{pg, EdgeBlockedTopologyWrapper{blocked_topo}};
+  }
+};
+
 template <>
 struct PGViewBuilder<PGViewProjectedGraph> {
   template <typename ViewCache>
@@ -1370,16 +2255,57 @@ struct PropertyGraphViews {
   using NodesSortedByDegreeEdgesSortedByDestID =
       internal::PGViewNodesSortedByDegreeEdgesSortedByDestID;
   using ProjectedGraph = internal::PGViewProjectedGraph;
+  using CompressedEdgesSortedByDestID =
+      internal::PGViewCompressedEdgesSortedByDestID;
+  using EdgesBlocked = internal::PGViewEdgesBlocked;
 };
 
 class KATANA_EXPORT PGViewCache {
+  /// LRU entry for the topology memory budget; keyed by object identity
+  struct TopologyLRUKey {
+    EdgeShuffleTopology* topo;
+    bool operator==(const TopologyLRUKey& that) const noexcept {
+      return topo == that.topo;
+    }
+    struct Hash {
+      size_t operator()(const TopologyLRUKey& key) const noexcept {
+        return std::hash<const void*>()(key.topo);
+      }
+    };
+  };
+
   std::vector<std::unique_ptr<EdgeShuffleTopology>> edge_shuff_topos_;
   std::vector<std::unique_ptr<ShuffleTopology>> fully_shuff_topos_;
   std::vector<std::unique_ptr<EdgeTypeAwareTopology>> edge_type_aware_topos_;
+  std::unique_ptr<CompressedTopology> compressed_topo_;
+  std::unique_ptr<EdgeBlockedTopology> blocked_topo_;
   std::unique_ptr<CondensedTypeIDMap> edge_type_id_map_;
   // TODO(amber): define a node_type_id_map_;
   std::unique_ptr<ProjectedTopology> projected_topos_;
 
+  // Memory budget for cached EdgeShuffleTopology artifacts, enabled by
+  // KATANA_TOPOLOGY_CACHE_BUDGET_MB (null when unset). Every topology
+  // handed out is touched in this LRU; crossing the budget spills the
+  // least recently used ones to scratch (EdgeShuffleTopology::
+  // SpillToScratch) and the next request rehydrates them. Topologies an
+  // EdgeTypeAwareTopology wraps stay resident (unspillable_topos_), as do
+  // node-shuffled and compressed views, which are derived and rebuilt
+  // rather than spilled. Like the rest of this cache, single threaded;
+  // callers must not hold a PGView across another view's construction
+  // while a budget is set, since that construction may spill its
+  // topologies.
+  std::unique_ptr<Cache<TopologyLRUKey, EdgeShuffleTopology*>> topo_lru_;
+  std::unordered_set<const EdgeShuffleTopology*> unspillable_topos_;
+
+  // Edge-property columns physically permuted into a shuffled topology's
+  // edge order, keyed by topology identity and property name. Dropped
+  // whenever the topologies they were permuted for are patched or
+  // invalidated.
+  std::unordered_map<
+      const EdgeShuffleTopology*,
+      std::unordered_map<std::string, std::shared_ptr<arrow::Array>>>
+      materialized_edge_props_;
+
   template <typename>
   friend struct internal::PGViewBuilder;
 
@@ -1407,6 +2333,14 @@ private:
       const EdgeShuffleTopology::TransposeKind& tpose_kind,
       const EdgeShuffleTopology::EdgeSortKind& sort_kind) noexcept;
 
+  /// Hands a topology built outside the cache (e.g., by the pipelined open
+  /// path) to the cache so later BuildOrGet calls reuse it.
+  void AdoptEdgeShuffTopo(std::unique_ptr<EdgeShuffleTopology> topo) noexcept;
+
+  /// Restores \p topo if it was spilled and records the use in the
+  /// budget's LRU; no-op when no budget is configured
+  void TouchTopology(EdgeShuffleTopology* topo) noexcept;
+
   ShuffleTopology* BuildOrGetShuffTopo(
       const PropertyGraph* pg,
       const EdgeShuffleTopology::TransposeKind& tpose_kind,
@@ -1417,9 +2351,47 @@ private:
       const PropertyGraph* pg,
       const EdgeShuffleTopology::TransposeKind& tpose_kind) noexcept;
 
+  CompressedTopology* BuildOrGetCompressedTopo(const PropertyGraph* pg) noexcept;
+
+  EdgeBlockedTopology* BuildOrGetBlockedTopo(const PropertyGraph* pg) noexcept;
+
   ProjectedTopology* BuildOrGetProjectedGraphTopo(
       const PropertyGraph* pg, const std::vector<std::string>& node_properties,
       const std::vector<std::string>& edge_properties) noexcept;
+
+public:
+  /// Applies a batch of edge insertions to the cached topologies in place.
+  /// Edge-sorted topologies (and their transposes) absorb the batch with a
+  /// parallel merge; views whose derivation cannot be patched cheaply
+  /// (node-shuffled, compressed, projected) are invalidated and rebuilt
+  /// lazily on next use. The caller must have already updated the
+  /// PropertyGraph's own topology and property tables.
+  void PatchTopologies(
+      const PropertyGraph* pg,
+      const std::vector<TopologyEdgeInsert>& inserts) noexcept;
+
+  /// Marks every cached topology invalid, forcing rebuilds on next use.
+  /// Prefer PatchTopologies for small mutations.
+  void InvalidateTopologies() noexcept;
+
+  /// Returns \p name's edge-property column physically permuted into \p
+  /// topo's edge order, building and caching it on first use. Reading a
+  /// property through a shuffled view normally gathers through the view's
+  /// edge_property_indices on every access; hot columns in tight loops
+  /// (e.g. SSSP weights over a sorted view) are worth the one-time parallel
+  /// gather that turns those reads into unit-stride loads. Only
+  /// single-chunk, null-free, fixed-width columns are materialized; other
+  /// columns report an error and callers should fall back to indirected
+  /// access. The array is dropped when the topologies are patched or
+  /// invalidated.
+  Result<std::shared_ptr<arrow::Array>> GetMaterializedEdgeProperty(
+      const PropertyGraph* pg, const EdgeShuffleTopology* topo,
+      const std::string& name);
+
+  /// Drops every materialized copy of edge property \p name. The
+  /// PropertyGraph edge-property mutators call this so a changed column
+  /// can never be read back through a stale permuted copy.
+  void DropMaterializedEdgeProperty(const std::string& name) noexcept;
 };
 
 /// Creates a uniform-random CSR GrpahTopology instance, where each node as
@@ -1435,9 +2407,12 @@ KATANA_EXPORT GraphTopology CreateUniformRandomTopology(
 /// AddNodes(10); // creates 10 nodes (0..9) with no edges
 /// AddEdge(0, 3); // creates an edge between nodes 0 and 3.
 /// Once done adding edges, call ConvertToCSR() to obtain a GraphTopology instance
+/// AddEdge() may be called from a parallel loop once the nodes exist;
+/// adjacency lists claim slots with a fetch-add append. The duplicate-edge
+/// debug assert assumes serial use.
 template <bool IS_SYMMETRIC = false>
 class KATANA_EXPORT TopologyBuilderImpl : public GraphTopologyTypes {
-  using AdjVec = std::vector<Node>;
+  using AdjVec = PODVector<Node>;
 
   // TODO(Amber/Yan): Add a flag that allows multi-edges in AddEdge() method
 
@@ -1502,7 +2477,7 @@ private:
         (std::find(adj_list.begin(), adj_list.end(), dst) == adj_list.end());
     KATANA_LOG_DEBUG_ASSERT(not_found);
 
-    adj_list.emplace_back(dst);
+    adj_list.push_back_concurrent(dst);
   }
 
   std::vector<AdjVec> all_nodes_adj_;
@@ -32,6 +32,8 @@ struct KATANA_EXPORT ThreadTopoInfo {
   unsigned socketLeader;         // first thread id in tid's socket
   unsigned socket;               // socket (L3 normally) of thread
   unsigned numaNode;             // memory bank.  may be different than socket.
+  unsigned core;                 // physical core, renumbered across sockets;
+                                 // SMT siblings share a core
   unsigned cumulativeMaxSocket;  // max socket id seen from [0, tid]
   unsigned osContext;            // OS ID to use for thread binding
   unsigned osNumaNode;           // OS ID for numa node
@@ -66,6 +68,14 @@ KATANA_EXPORT std::vector<int> parseCPUList(const std::string& in);
  */
 KATANA_EXPORT bool bindThreadSelf([[maybe_unused]] unsigned osContext);
 
+/**
+ * bindThreadMemoryPreferred sets the calling thread's memory policy to
+ * prefer allocating from the given OS NUMA node (e.g. a flat-mode HBM
+ * node), falling back to other nodes when it has no free pages.
+ */
+KATANA_EXPORT bool bindThreadMemoryPreferred(
+    [[maybe_unused]] unsigned osNumaNode);
+
 }  // namespace katana
 
 #endif
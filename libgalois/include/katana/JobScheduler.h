@@ -0,0 +1,172 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_JOBSCHEDULER_H_
+#define KATANA_LIBGALOIS_KATANA_JOBSCHEDULER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * Cooperative scheduler for several analytics sharing one process.
+ *
+ * The thread pool executes one parallel loop at a time, so concurrent
+ * callers of do_all and friends otherwise interleave destructively. A
+ * multi-tenant service registers each analytic as a job and attaches the
+ * application thread driving it; every katana loop that thread starts is
+ * then admitted through the scheduler, which time-slices the pool between
+ * jobs at loop granularity.
+ *
+ * Pool time is divided by weighted fair queuing: each job accumulates
+ * virtual time at a rate inversely proportional to its weight, and the
+ * waiting job with the least virtual time runs next. A job's max_threads
+ * budget caps how many threads its loops use while other jobs are
+ * runnable; when every other job is gone or sitting in a ScopedBlocking
+ * section (storage I/O, network), the cap is lifted and the remaining job
+ * gets the whole machine -- that is where the capacity wasted by
+ * run-one-job-at-a-time deployments comes back.
+ *
+ * Threads that never attach bypass the scheduler entirely, so
+ * single-tenant programs pay one thread-local load per loop. Mixing
+ * attached and unattached threads that run loops concurrently is not
+ * supported.
+ */
+class KATANA_EXPORT JobScheduler {
+public:
+  using JobId = unsigned;
+  static constexpr JobId kNoJob = ~0U;
+
+  JobScheduler() = default;
+
+  JobScheduler(const JobScheduler&) = delete;
+  JobScheduler(JobScheduler&&) = delete;
+  JobScheduler& operator=(const JobScheduler&) = delete;
+  JobScheduler& operator=(JobScheduler&&) = delete;
+
+  /// Register a job. weight sets its share of pool time relative to the
+  /// other jobs; max_threads caps the threads its loops run with while
+  /// other jobs are runnable (0 means no cap).
+  JobId CreateJob(std::string name, unsigned weight = 1,
+                  unsigned max_threads = 0);
+
+  /// Unregister a job; it must have no loops in flight and no threads
+  /// still attached to it.
+  void DestroyJob(JobId job);
+
+  /// Attach the calling application thread to a job; its loops are gated
+  /// from here on. One thread drives one job at a time.
+  void AttachCurrentThread(JobId job);
+  void DetachCurrentThread();
+
+  /// Marks the attached job as blocked for the current scope, e.g. around
+  /// a property load. While blocked the job earns no virtual-time credit
+  /// and the other jobs may exceed their thread caps.
+  class KATANA_EXPORT ScopedBlocking {
+  public:
+    ScopedBlocking();
+    ~ScopedBlocking();
+
+    ScopedBlocking(const ScopedBlocking&) = delete;
+    ScopedBlocking(ScopedBlocking&&) = delete;
+    ScopedBlocking& operator=(const ScopedBlocking&) = delete;
+    ScopedBlocking& operator=(ScopedBlocking&&) = delete;
+  };
+
+  // loop admission, used by the executors through internal::JobSlice;
+  // NeedsGate is false for unattached threads and for loops nested inside
+  // an already admitted slice
+  bool NeedsGate() const;
+  // blocks until this job's turn; returns the activeThreads value to
+  // restore at ExitLoop
+  unsigned EnterLoop();
+  void ExitLoop(unsigned saved_threads);
+
+private:
+  struct Job {
+    std::string name;
+    unsigned weight = 1;
+    unsigned max_threads = 0;
+    // pool nanoseconds consumed, scaled down by weight
+    uint64_t vtime_ns = 0;
+    unsigned waiting = 0;
+    bool blocked = false;
+    bool live = false;
+  };
+
+  // true when job may run before every other waiting runnable job;
+  // lock_ must be held
+  bool IsNext(JobId job) const;
+  unsigned Allotment(const Job& job, unsigned usable) const;
+
+  mutable std::mutex lock_;
+  std::condition_variable cv_;
+  std::vector<Job> jobs_;
+  bool pool_busy_ = false;
+  JobId running_job_ = kNoJob;
+  std::chrono::steady_clock::time_point slice_start_;
+};
+
+/// The process-wide scheduler; null until SharedMemSys is up.
+KATANA_EXPORT JobScheduler* GetJobScheduler();
+
+namespace internal {
+
+//! Install the job scheduler, used by SharedMem
+KATANA_EXPORT void setJobScheduler(JobScheduler* js);
+
+//! RAII loop gate placed at the top of each loop executor; a no-op unless
+//! the calling thread is attached to a job
+class JobSlice {
+public:
+  JobSlice() {
+    JobScheduler* js = GetJobScheduler();
+    if (js && js->NeedsGate()) {
+      sched_ = js;
+      saved_threads_ = js->EnterLoop();
+    }
+  }
+
+  ~JobSlice() {
+    if (sched_) {
+      sched_->ExitLoop(saved_threads_);
+    }
+  }
+
+  JobSlice(const JobSlice&) = delete;
+  JobSlice(JobSlice&&) = delete;
+  JobSlice& operator=(const JobSlice&) = delete;
+  JobSlice& operator=(JobSlice&&) = delete;
+
+private:
+  JobScheduler* sched_ = nullptr;
+  unsigned saved_threads_ = 0;
+};
+
+}  // end namespace internal
+
+}  // end namespace katana
+
+#endif
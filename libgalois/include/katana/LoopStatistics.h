@@ -20,6 +20,13 @@
 #ifndef KATANA_LIBGALOIS_KATANA_LOOPSTATISTICS_H_
 #define KATANA_LIBGALOIS_KATANA_LOOPSTATISTICS_H_
 
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "katana/PerfCounters.h"
+#include "katana/SamplingProfiler.h"
 #include "katana/Statistics.h"
 #include "katana/config.h"
 
@@ -29,20 +36,56 @@ namespace katana {
 template <bool Enabled>
 class LoopStatistics {
 protected:
+  // per-round breakdowns past this many rounds fold into the last slot to
+  // keep long-running loops from flooding the stat output
+  static constexpr size_t kMaxReportedRounds = 32;
+
   size_t m_iterations;
   size_t m_pushes;
   size_t m_conflicts;
+  // chain of consecutive push-producing iterations on this thread; its
+  // maximum is a cheap lower bound on the loop's dependence depth
+  size_t m_chain;
+  size_t m_max_chain;
+  size_t m_round_start_iterations;
+  size_t m_round_start_conflicts;
+  // (executed, retried) per executor round
+  std::vector<std::pair<size_t, size_t>> m_rounds;
+  // hardware counters over this thread's run of the loop; no-op unless
+  // KATANA_PERF_COUNTERS is set
+  PerfCounterGroup m_perf_counters;
+  // marks this thread for the sampling profiler while the loop runs
+  SamplingProfiler::LoopScope m_sampling_scope;
   const char* loopname;
 
 public:
   explicit LoopStatistics(const char* ln)
-      : m_iterations(0), m_pushes(0), m_conflicts(0), loopname(ln) {}
+      : m_iterations(0), m_pushes(0), m_conflicts(0), m_chain(0),
+        m_max_chain(0), m_round_start_iterations(0), m_round_start_conflicts(0),
+        m_sampling_scope(ln), loopname(ln) {
+    m_perf_counters.start();
+  }
 
   ~LoopStatistics() {
+    m_perf_counters.stop();
+    note_round();
     ReportStatSum(loopname, "Iterations", m_iterations);
     ReportStatSum(loopname, "Commits", (m_iterations - m_conflicts));
     ReportStatSum(loopname, "Pushes", m_pushes);
     ReportStatSum(loopname, "Conflicts", m_conflicts);
+    if (m_iterations > 0) {
+      ReportStatMax(loopname, "DepthEstimate", m_max_chain + 1);
+    }
+    if (m_rounds.size() > 1) {
+      ReportStatMax(loopname, "Rounds", m_rounds.size());
+      for (size_t r = 0; r < m_rounds.size(); ++r) {
+        ReportStatSum(
+            loopname, fmt::format("Round{}Iterations", r), m_rounds[r].first);
+        ReportStatSum(
+            loopname, fmt::format("Round{}Conflicts", r), m_rounds[r].second);
+      }
+    }
+    m_perf_counters.report(loopname);
   }
 
   size_t iterations() const { return m_iterations; }
@@ -54,12 +97,46 @@ public:
   inline void inc_iterations() { ++m_iterations; }
 
   inline void inc_conflicts() { ++m_conflicts; }
+
+  /// Called once per committed iteration with whether it pushed new work;
+  /// consecutive pushing iterations on one thread form a dependence chain
+  inline void note_push_chain(bool pushed) {
+    if (pushed) {
+      if (++m_chain > m_max_chain) {
+        m_max_chain = m_chain;
+      }
+    } else {
+      m_chain = 0;
+    }
+  }
+
+  /// Called at executor round boundaries to snapshot executed/retried
+  /// counts for the round that just finished
+  void note_round() {
+    size_t executed = m_iterations - m_round_start_iterations;
+    size_t retried = m_conflicts - m_round_start_conflicts;
+    if (executed == 0 && retried == 0) {
+      return;
+    }
+    if (m_rounds.size() < kMaxReportedRounds) {
+      m_rounds.emplace_back(executed, retried);
+    } else {
+      m_rounds.back().first += executed;
+      m_rounds.back().second += retried;
+    }
+    m_round_start_iterations = m_iterations;
+    m_round_start_conflicts = m_conflicts;
+  }
 };
 
 template <>
 class LoopStatistics<false> {
+  // stats are compiled out, but the sampling profiler still wants to know
+  // which loop this thread is in
+  SamplingProfiler::LoopScope m_sampling_scope;
+
 public:
-  explicit LoopStatistics(const char*) {}
+  explicit LoopStatistics(const char* ln) : m_sampling_scope(ln) {}
 
   size_t iterations() const { return 0; }
   size_t pushes() const { return 0; }
@@ -68,6 +145,8 @@ public:
   inline void inc_iterations() const {}
   inline void inc_pushes(size_t) const {}
   inline void inc_conflicts() const {}
+  inline void note_push_chain(bool) const {}
+  inline void note_round() const {}
 };
 
 }  // namespace katana
@@ -21,6 +21,7 @@
 #define KATANA_LIBGALOIS_KATANA_LOOPS_H_
 
 #include "katana/Executor_Deterministic.h"
+#include "katana/Executor_DeterministicKeyed.h"
 #include "katana/Executor_DoAll.h"
 #include "katana/Executor_ForEach.h"
 #include "katana/Executor_OnEach.h"
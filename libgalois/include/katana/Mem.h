@@ -63,6 +63,14 @@ typedef katana::BumpWithMallocHeap<katana::FreeListHeap<katana::SystemHeap>>
 typedef katana::ExternalHeapAllocator<char, IterAllocBaseTy> PerIterAllocTy;
 //! [PerIterAllocTy example]
 
+//! Base arena for the per-round allocator: bump allocations come from page
+//! pool chunks that are retained across O(1) rewinds at round boundaries
+typedef katana::BumpRewindHeap<katana::FreeListHeap<katana::SystemHeap>>
+    RoundAllocBaseTy;
+
+//! Per-round allocator that conforms to STL allocator interface
+typedef katana::ExternalHeapAllocator<char, RoundAllocBaseTy> PerRoundAllocTy;
+
 //! Scalable variable-sized allocator for T that allocates blocks of sizes in
 //! powers of 2 Useful for small and medium sized allocations, e.g. small or
 //! medium vectors, strings, deques
@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <map>
+#include <new>
 #include <set>
 #include <type_traits>
 #include <vector>
@@ -37,9 +38,11 @@
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
+#include "katana/Allocators.h"
 #include "katana/Bag.h"
 #include "katana/CacheLineStorage.h"
 #include "katana/Details.h"
+#include "katana/EpochReclaim.h"
 #include "katana/FileGraph.h"
 #include "katana/Galois.h"
 #include "katana/SimpleLock.h"
@@ -148,13 +151,45 @@ struct UEdgeInfoBase<NTy, void, false> {
  */
 template <typename ETy, bool DirectedNotInOut>
 struct EdgeFactory {
-  katana::InsertBag<ETy> mem;
+  //! Edge records come from bump arenas shared per socket, refilled through
+  //! per-thread magazines: bursty concurrent insert phases neither contend
+  //! on one process-wide heap nor pull records from a remote socket. The
+  //! header in front of each record points back at this factory's arena so
+  //! the epoch manager's reclaim callback can return the record to it.
+  using ArenaHeap =
+      katana::MagazineFreeListHeap<katana::PerSocketHeap<
+          katana::BumpHeap<katana::SystemHeap>>>;
+  using TaggedArena = katana::AddHeader<ArenaHeap*, ArenaHeap>;
+
+  TaggedArena mem;
+
+  //! Flushes pending retires before the arena disappears: a record retired
+  //! through the epoch manager must come back to this factory's arena, not
+  //! outlive it.
+  ~EdgeFactory() { katana::GetEpochManager().reclaimAll(); }
+
   template <typename... Args>
   ETy* mkEdge(Args&&... args) {
-    return &mem.emplace(std::forward<Args>(args)...);
+    void* p = mem.allocate(sizeof(ETy));
+    *TaggedArena::getHeader(p) = &mem;
+    return new (p) ETy(std::forward<Args>(args)...);
+  }
+  //! Retires the edge data through the epoch manager rather than freeing it
+  //! directly: an unprotected reader may still be dereferencing the pointer
+  //! it loaded from an EdgeInfo before the edge was unlinked.
+  void delEdge(ETy* e) {
+    if (e) {
+      katana::GetEpochManager().retire(e, &reclaimEdge);
+    }
+  }
+  bool mustDel() const { return true; }
+
+private:
+  static void reclaimEdge(void* p) {
+    static_cast<ETy*>(p)->~ETy();
+    ArenaHeap* arena = *TaggedArena::getHeader(p);
+    arena->deallocate(TaggedArena::getHeader(p));
   }
-  void delEdge(ETy*) {}
-  bool mustDel() const { return false; }
 };
 
 template <typename ETy>
@@ -816,10 +851,13 @@ public
       src->erase(dst.base());
     } else {
       dst->first()->acquire(mflag);
-      // EdgeTy* e = dst->second();
+      EdgeTy* e = dst->second();
       dst->first()->erase(
           src, Directional ? true : false);  // erase incoming/symmetric edge
       src->erase(dst.base());
+      if (edgesF.mustDel()) {
+        edgesF.delEdge(e);
+      }
     }
   }
 
@@ -0,0 +1,343 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_NUMABAG_H_
+#define KATANA_LIBGALOIS_KATANA_NUMABAG_H_
+
+#include <atomic>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "katana/Mem.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Range.h"
+#include "katana/SimpleLock.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
+#include "katana/config.h"
+#include "katana/gIO.h"
+#include "katana/gstl.h"
+
+namespace katana {
+
+/**
+ * Unordered collection of elements with NUMA-aware consumption. Like
+ * {@link InsertBag}, pushes go into thread-local chunks backed by the page
+ * pool, so each chunk lives on the pushing thread's NUMA node. Unlike
+ * InsertBag, whose local ranges tie each chunk to the thread that pushed it,
+ * a NUMABag redistributes chunks among the threads of the socket that
+ * produced them: local_begin()/local_end() for a thread cover an even share
+ * of its own socket's chunks and nothing from other sockets. A consuming
+ * do_all therefore reads socket-local memory even when production was
+ * imbalanced across the socket's threads, which matters for frontier
+ * exchange in BFS/SSSP-style loops on multi-socket machines.
+ *
+ * Pushes are thread safe with respect to each other, but iteration must not
+ * overlap with pushes: the first iteration after a push snapshots the chunk
+ * lists per socket.
+ */
+template <typename T, unsigned int BlockSize = 0>
+class NUMABag {
+  struct header {
+    header* next;
+    T* dbegin;  // start of interesting data
+    T* dend;    // end of valid data
+    T* dlast;   // end of storage
+  };
+
+  typedef std::pair<header*, header*> PerThread;
+
+public:
+  template <typename U>
+  class Iterator : public boost::iterator_facade<
+                       Iterator<U>, U, boost::forward_traversal_tag> {
+    friend class boost::iterator_core_access;
+
+    header* const* chunk;
+    header* const* chunk_end;
+    U* v;
+
+    void seek_chunk() {
+      v = 0;
+      while (chunk != chunk_end) {
+        if ((*chunk)->dbegin != (*chunk)->dend) {
+          v = (*chunk)->dbegin;
+          return;
+        }
+        ++chunk;
+      }
+    }
+
+    void increment() {
+      ++v;
+      if (v == (*chunk)->dend) {
+        ++chunk;
+        seek_chunk();
+      }
+    }
+
+    template <typename OtherTy>
+    bool equal(const Iterator<OtherTy>& o) const {
+      return chunk == o.chunk && v == o.v;
+    }
+
+    U& dereference() const { return *v; }
+
+  public:
+    Iterator() : chunk(0), chunk_end(0), v(0) {}
+
+    template <typename OtherTy>
+    Iterator(const Iterator<OtherTy>& o)
+        : chunk(o.chunk), chunk_end(o.chunk_end), v(o.v) {}
+
+    Iterator(header* const* beg, header* const* end)
+        : chunk(beg), chunk_end(end), v(0) {
+      seek_chunk();
+    }
+  };
+
+private:
+  katana::FixedSizeHeap heap;
+  katana::PerThreadStorage<PerThread> heads;
+
+  // Snapshot of all chunks, grouped by producing socket;
+  // socket_offsets_[s] .. socket_offsets_[s + 1] delimit socket s's chunks.
+  // Rebuilt on first iteration after a push.
+  std::vector<header*> chunks_;
+  std::vector<size_t> socket_offsets_;
+  std::atomic<bool> dirty_{false};
+  SimpleLock snapshot_lock_;
+
+  void insHeader(header* h) {
+    PerThread& hpair = *heads.getLocal();
+    if (hpair.second) {
+      hpair.second->next = h;
+      hpair.second = h;
+    } else {
+      hpair.first = hpair.second = h;
+    }
+  }
+
+  header* newHeaderFromHeap(void* m, unsigned size) {
+    header* H = new (m) header();
+    int offset = 1;
+    if (sizeof(T) < sizeof(header))
+      offset += sizeof(header) / sizeof(T);
+    T* a = reinterpret_cast<T*>(m);
+    H->dbegin = &a[offset];
+    H->dend = H->dbegin;
+    H->dlast = &a[(size / sizeof(T))];
+    H->next = 0;
+    return H;
+  }
+
+  header* newHeader() {
+    if (BlockSize) {
+      return newHeaderFromHeap(heap.allocate(BlockSize), BlockSize);
+    } else {
+      return newHeaderFromHeap(katana::pagePoolAlloc(), katana::allocSize());
+    }
+  }
+
+  void destruct() {
+    for (unsigned x = 0; x < heads.size(); ++x) {
+      PerThread& hpair = *heads.getRemote(x);
+      header*& h = hpair.first;
+      while (h) {
+        uninitialized_destroy(h->dbegin, h->dend);
+        header* h2 = h;
+        h = h->next;
+        if (BlockSize)
+          heap.deallocate(h2);
+        else
+          katana::pagePoolFree(h2);
+      }
+      hpair.second = 0;
+    }
+    chunks_.clear();
+    socket_offsets_.clear();
+    dirty_ = false;
+  }
+
+  bool snapshotValid() const {
+    return !socket_offsets_.empty() && !dirty_.load(std::memory_order_acquire);
+  }
+
+  void snapshot() {
+    if (snapshotValid()) {
+      return;
+    }
+
+    // Built by the first thread to start iterating; the others wait on the
+    // lock and see a clean snapshot. Pushes must have finished by now.
+    std::lock_guard<SimpleLock> guard(snapshot_lock_);
+    if (snapshotValid()) {
+      return;
+    }
+
+    auto& tp = GetThreadPool();
+
+    chunks_.clear();
+    socket_offsets_.clear();
+    socket_offsets_.push_back(0);
+
+    for (unsigned s = 0; s < tp.getMaxSockets(); ++s) {
+      for (unsigned t = 0; t < heads.size(); ++t) {
+        if (tp.getSocket(t) != s) {
+          continue;
+        }
+        for (header* h = heads.getRemote(t)->first; h; h = h->next) {
+          chunks_.push_back(h);
+        }
+      }
+      socket_offsets_.push_back(chunks_.size());
+    }
+
+    dirty_.store(false, std::memory_order_release);
+  }
+
+  //! Share of my socket's chunks assigned to this thread: my socket's
+  //! chunk range split evenly among the socket's active threads.
+  std::pair<size_t, size_t> localChunkRange() {
+    auto& tp = GetThreadPool();
+    const unsigned tid = ThreadPool::getTID();
+    const unsigned my_socket = tp.getSocket(tid);
+    const unsigned num_threads = katana::getActiveThreads();
+
+    unsigned on_socket = 0;
+    unsigned my_index = 0;
+    for (unsigned t = 0; t < num_threads; ++t) {
+      if (tp.getSocket(t) != my_socket) {
+        continue;
+      }
+      if (t < tid) {
+        ++my_index;
+      }
+      ++on_socket;
+    }
+
+    const size_t beg = socket_offsets_[my_socket];
+    const size_t end = socket_offsets_[my_socket + 1];
+    return katana::block_range(beg, end, my_index, on_socket);
+  }
+
+public:
+  NUMABag() : heap(BlockSize) {}
+  NUMABag(NUMABag&& o) : heap(BlockSize) { swap(o); }
+
+  NUMABag& operator=(NUMABag&& o) {
+    swap(o);
+    return *this;
+  }
+
+  NUMABag(const NUMABag&) = delete;
+  NUMABag& operator=(const NUMABag&) = delete;
+
+  ~NUMABag() { destruct(); }
+
+  void clear() { destruct(); }
+
+  void swap(NUMABag& o) {
+    std::swap(heap, o.heap);
+    std::swap(heads, o.heads);
+    std::swap(chunks_, o.chunks_);
+    std::swap(socket_offsets_, o.socket_offsets_);
+    bool d = dirty_;
+    dirty_ = o.dirty_.load();
+    o.dirty_ = d;
+  }
+
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef const T& const_reference;
+  typedef T& reference;
+  typedef Iterator<T> iterator;
+  typedef Iterator<const T> const_iterator;
+  typedef iterator local_iterator;
+
+  iterator begin() {
+    snapshot();
+    return iterator(chunks_.data(), chunks_.data() + chunks_.size());
+  }
+  iterator end() {
+    snapshot();
+    return iterator(
+        chunks_.data() + chunks_.size(), chunks_.data() + chunks_.size());
+  }
+
+  //! Beginning of this thread's share of its own socket's chunks; safe to
+  //! call concurrently from inside a parallel loop.
+  local_iterator local_begin() {
+    snapshot();
+    auto r = localChunkRange();
+    return local_iterator(chunks_.data() + r.first, chunks_.data() + r.second);
+  }
+  local_iterator local_end() {
+    snapshot();
+    auto r = localChunkRange();
+    return local_iterator(chunks_.data() + r.second, chunks_.data() + r.second);
+  }
+
+  bool empty() const {
+    for (unsigned x = 0; x < heads.size(); ++x) {
+      header* h = heads.getRemote(x)->first;
+      if (h && h->dbegin != h->dend)
+        return false;
+    }
+    return true;
+  }
+
+  //! Thread safe bag insertion
+  template <typename... Args>
+  reference emplace(Args&&... args) {
+    header* H = heads.getLocal()->second;
+    T* rv;
+    if (!H || H->dend == H->dlast) {
+      H = newHeader();
+      insHeader(H);
+      dirty_.store(true, std::memory_order_release);
+    }
+    rv = new (H->dend) T(std::forward<Args>(args)...);
+    ++H->dend;
+    return *rv;
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    return emplace(std::forward<Args>(args)...);
+  }
+
+  //! Thread safe bag insertion
+  template <typename ItemTy>
+  reference push(ItemTy&& val) {
+    return emplace(std::forward<ItemTy>(val));
+  }
+
+  //! Thread safe bag insertion
+  template <typename ItemTy>
+  reference push_back(ItemTy&& val) {
+    return emplace(std::forward<ItemTy>(val));
+  }
+};
+
+}  // namespace katana
+
+#endif
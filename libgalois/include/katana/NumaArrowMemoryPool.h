@@ -0,0 +1,86 @@
+#ifndef KATANA_LIBGALOIS_KATANA_NUMAARROWMEMORYPOOL_H_
+#define KATANA_LIBGALOIS_KATANA_NUMAARROWMEMORYPOOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+
+#include <arrow/memory_pool.h>
+
+#include "katana/NumaMem.h"
+#include "katana/SimpleLock.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// An arrow::MemoryPool backed by katana's large-page allocator.
+///
+/// Arrow buffers built during property decode are long-lived and read by
+/// parallel loops, but arrow's default allocator places them wherever jemalloc
+/// happens to map them and hides them from katana accounting. This pool routes
+/// allocations of at least one huge page (\ref katana::allocSize) through the
+/// largeMalloc family so their pages land interleaved (or blocked) across
+/// NUMA sockets. Placement uses the mbind-based variants rather than the
+/// thread pool's first-touch page-in, because arrow allocates from
+/// arbitrary threads (async property decode, write-behind) where running
+/// the pool is not allowed. The pool tracks current and high-water bytes for both the
+/// large and small classes so OOM postmortems can see arrow's share.
+///
+/// Smaller requests fall through to arrow's default pool; they are too small
+/// to have meaningful placement and the page allocator only deals in whole
+/// pages.
+///
+/// Install the process-wide instance with \ref katana::SetArrowMemoryPool;
+/// SharedMemSys does so at startup. The placement policy defaults to
+/// interleaved and can be switched with KATANA_ARROW_POOL_POLICY=blocked.
+class KATANA_EXPORT NumaArrowMemoryPool : public arrow::MemoryPool {
+public:
+  enum class Policy {
+    kInterleaved,  //!< round-robin pages across sockets (default)
+    kBlocked,      //!< contiguous per-thread blocks on each thread's node
+  };
+
+  NumaArrowMemoryPool();
+
+  /// The instance SharedMemSys installs; lives for the whole process
+  static NumaArrowMemoryPool& Global();
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(
+      int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+  std::string backend_name() const override { return "katana-numa"; }
+
+  /// Report current and high-water bytes for both allocation classes through
+  /// the StatManager; SharedMemSys calls this before printing stats
+  void ReportStats() const;
+
+private:
+  struct ClassStats {
+    std::atomic<int64_t> current{0};
+    std::atomic<int64_t> high_water{0};
+
+    void Add(int64_t bytes);
+    void Remove(int64_t bytes) {
+      current.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+  };
+
+  Policy policy_{Policy::kInterleaved};
+  //! requests at least this large go to the page allocator
+  size_t large_threshold_;
+
+  //! large allocations live here so Free can find their LAptr
+  std::unordered_map<void*, LAptr> large_allocs_;
+  mutable SimpleLock large_allocs_lock_;
+
+  ClassStats large_stats_;
+  ClassStats small_stats_;
+};
+
+}  // namespace katana
+
+#endif
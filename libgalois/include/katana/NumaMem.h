@@ -45,12 +45,44 @@ KATANA_EXPORT LAptr largeMallocInterleaved(size_t bytes, unsigned numThreads);
 // fault in block interleaved mapping
 KATANA_EXPORT LAptr largeMallocBlocked(size_t bytes, unsigned numThreads);
 
+/**
+ * Like largeMallocInterleaved, but places pages with a kernel memory
+ * policy (mbind) instead of first-touch page-in on the thread pool.
+ *
+ * The first-touch variants run ThreadPool::run, which must start from the
+ * master thread and asserts against reentry, so they cannot be called
+ * from arbitrary threads or while a parallel region is active. The mbind
+ * variants are safe from any caller: no page is touched at allocation
+ * time, and the kernel places each page on first fault according to the
+ * policy, wherever the faulting thread runs. On non-Linux builds or when
+ * mbind is unavailable the placement degrades to first-touch, like
+ * largeMallocFloating.
+ */
+KATANA_EXPORT LAptr largeMallocInterleavedMbind(size_t bytes);
+
+/// Blocked counterpart of largeMallocInterleavedMbind: thread i's chunk
+/// of a blocked partition prefers thread i's NUMA node.
+KATANA_EXPORT LAptr largeMallocBlockedMbind(size_t bytes, unsigned numThreads);
+
 // fault in specified regions for each thread (threadRanges)
 template <typename RangeArrayTy>
 KATANA_EXPORT LAptr largeMallocSpecified(
     size_t bytes, uint32_t numThreads, RangeArrayTy& threadRanges,
     size_t elementSize);
 
+/**
+ * Migrate the pages backing [ptr, ptr + bytes) so that each thread's share
+ * of a blocked partition is local to that thread's NUMA node.
+ *
+ * Unlike the largeMalloc family, which controls placement by first-touch at
+ * allocation time, this repairs memory that has already been faulted in on
+ * the wrong node, e.g. buffers filled by I/O threads during graph load. The
+ * contents are unchanged; only the physical page placement moves. A no-op on
+ * single-node machines or when the kernel refuses page migration.
+ */
+KATANA_EXPORT void migratePagesBlocked(
+    const void* ptr, size_t bytes, unsigned numThreads);
+
 }  // namespace katana
 
 #endif
@@ -23,18 +23,24 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <numeric>
+#include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
 
 #include "katana/Details.h"
 #include "katana/GraphHelpers.h"
+#include "katana/Loops.h"
 #include "katana/SimpleLock.h"
 #include "katana/config.h"
+#include "tsuba/FileView.h"
 
 namespace katana {
 
@@ -59,6 +65,8 @@ namespace katana {
 // outedges[numEdges] {uint64_t LE}
 // EdgeType[numEdges] {EdgeType size}
 
+// All accesses serialize through one lock and an ifstream seek; prefer
+// MappedOfflineGraph below for anything queried from a parallel loop.
 class OfflineGraph {
   std::ifstream fileEdgeDst, fileIndex, fileEdgeData;
   std::streamoff locEdgeDst, locIndex, locEdgeData;
@@ -337,6 +345,168 @@ public:
   }
 };
 
+/// Read-only view of an on-disk graph file mapped with tsuba::FileView.
+///
+/// Unlike \ref OfflineGraph, which serializes every access through one lock
+/// and an ifstream seek, all queries here read the mapping directly and may
+/// be issued concurrently from every thread. A compact resident cache of the
+/// out-index array (a 64-bit anchor per 64-node block plus a 32-bit delta
+/// per node, about half the footprint of the raw array) answers
+/// edge_begin/edge_end without touching the mapped index pages, so random
+/// neighborhood queries only fault in destination data.
+class MappedOfflineGraph {
+public:
+  typedef boost::counting_iterator<uint64_t> iterator;
+  typedef boost::counting_iterator<uint64_t> edge_iterator;
+  typedef StandardRange<NoDerefIterator<edge_iterator>> edges_iterator;
+  typedef uint64_t GraphNode;
+
+  explicit MappedOfflineGraph(const std::string& name) {
+    if (auto res = file_.Bind(name, true); !res) {
+      KATANA_LOG_ERROR("cannot bind {}: {}", name, res.error());
+      throw "Bad filename";
+    }
+    if (file_.size() < 4 * sizeof(uint64_t)) {
+      throw "File too small";
+    }
+
+    const uint64_t* header = file_.ptr<uint64_t>();
+    uint64_t ver = header[0];
+    if (ver == 0 || ver > 2) {
+      throw "Bad Version";
+    }
+    v2_ = (ver == 2);
+    size_edge_data_ = header[1];
+    num_nodes_ = header[2];
+    num_edges_ = header[3];
+
+    const uint64_t dest_size = v2_ ? sizeof(uint64_t) : sizeof(uint32_t);
+    if (file_.size() <
+        sizeof(uint64_t) * (4 + num_nodes_) + dest_size * num_edges_) {
+      throw "File too small";
+    }
+
+    out_indexs_ = header + 4;
+    dests_ = reinterpret_cast<const char*>(out_indexs_ + num_nodes_);
+
+    uint64_t data_pos =
+        sizeof(uint64_t) * (4 + num_nodes_) + dest_size * num_edges_;
+    data_pos = (data_pos + 7) & ~uint64_t{7};
+    edge_data_ = file_.ptr<char>(data_pos);
+
+    BuildOffsetCache();
+  }
+
+  size_t size() const { return num_nodes_; }
+  size_t sizeEdges() const { return num_edges_; }
+  size_t edgeSize() const { return size_edge_data_; }
+
+  iterator begin() const { return iterator(0); }
+  iterator end() const { return iterator(num_nodes_); }
+
+  edge_iterator edge_begin(GraphNode N) const {
+    return edge_iterator(N == 0 ? 0 : OutIndex(N - 1));
+  }
+
+  edge_iterator edge_end(GraphNode N) const {
+    return edge_iterator(OutIndex(N));
+  }
+
+  GraphNode getEdgeDst(edge_iterator ni) const {
+    if (v2_) {
+      return reinterpret_cast<const uint64_t*>(dests_)[*ni];
+    }
+    return reinterpret_cast<const uint32_t*>(dests_)[*ni];
+  }
+
+  edges_iterator edges(GraphNode N) const {
+    return internal::make_no_deref_range(edge_begin(N), edge_end(N));
+  }
+
+  template <typename T>
+  T getEdgeData(edge_iterator ni) const {
+    KATANA_LOG_DEBUG_ASSERT(sizeof(T) <= size_edge_data_);
+    T retval;
+    memcpy(&retval, edge_data_ + *ni * size_edge_data_, sizeof(T));
+    return retval;
+  }
+
+  /// Value at index \param n of the edge prefix sum, served from the
+  /// resident cache
+  uint64_t operator[](uint64_t n) const { return OutIndex(n); }
+
+  typedef std::pair<iterator, iterator> NodeRange;
+  typedef std::pair<edge_iterator, edge_iterator> EdgeRange;
+  typedef std::pair<NodeRange, EdgeRange> GraphRange;
+
+  auto divideByNode(
+      size_t nodeWeight, size_t edgeWeight, size_t id, size_t total,
+      std::vector<unsigned> scaleFactor = std::vector<unsigned>())
+      -> GraphRange {
+    return katana::divideNodesBinarySearch<MappedOfflineGraph>(
+        num_nodes_, num_edges_, nodeWeight, edgeWeight, id, total, *this,
+        scaleFactor);
+  }
+
+private:
+  static constexpr uint64_t kBlockShift = 6;
+  static constexpr uint64_t kBlockSize = uint64_t{1} << kBlockShift;
+
+  void BuildOffsetCache() {
+    const uint64_t num_blocks = (num_nodes_ + kBlockSize - 1) >> kBlockShift;
+    anchors_.resize(num_blocks);
+    deltas_.resize(num_nodes_);
+
+    std::atomic<bool> overflow{false};
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_blocks),
+        [&](uint64_t block) {
+          const uint64_t begin = block << kBlockShift;
+          const uint64_t end = std::min(num_nodes_, begin + kBlockSize);
+          const uint64_t anchor = begin == 0 ? 0 : out_indexs_[begin - 1];
+          anchors_[block] = anchor;
+          for (uint64_t n = begin; n < end; ++n) {
+            const uint64_t delta = out_indexs_[n] - anchor;
+            if (delta > std::numeric_limits<uint32_t>::max()) {
+              overflow = true;
+              return;
+            }
+            deltas_[n] = static_cast<uint32_t>(delta);
+          }
+        },
+        katana::no_stats(), katana::loopname("MappedOfflineGraphCache"));
+
+    if (overflow) {
+      // a single 64-node block holds more than 4G edges; serve offsets from
+      // the mapping instead of caching them
+      anchors_.clear();
+      anchors_.shrink_to_fit();
+      deltas_.clear();
+      deltas_.shrink_to_fit();
+    }
+  }
+
+  uint64_t OutIndex(uint64_t n) const {
+    KATANA_LOG_DEBUG_ASSERT(n < num_nodes_);
+    if (!deltas_.empty()) {
+      return anchors_[n >> kBlockShift] + deltas_[n];
+    }
+    return out_indexs_[n];
+  }
+
+  tsuba::FileView file_;
+  const uint64_t* out_indexs_{nullptr};
+  const char* dests_{nullptr};
+  const char* edge_data_{nullptr};
+  uint64_t num_nodes_{0};
+  uint64_t num_edges_{0};
+  uint64_t size_edge_data_{0};
+  bool v2_{false};
+
+  std::vector<uint64_t> anchors_;
+  std::vector<uint32_t> deltas_;
+};
+
 class OfflineGraphWriter {
   std::fstream file;
   uint64_t numNodes, numEdges;
@@ -0,0 +1,157 @@
+#ifndef KATANA_LIBGALOIS_KATANA_OUTOFCOREPROPERTYGRAPH_H_
+#define KATANA_LIBGALOIS_KATANA_OUTOFCOREPROPERTYGRAPH_H_
+
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/GraphTopology.h"
+#include "katana/NUMAArray.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+#include "tsuba/RDGSlice.h"
+#include "tsuba/tsuba.h"
+
+namespace katana {
+
+/// An out-of-core view of a property graph whose topology does not fit in
+/// memory.
+///
+/// Only the CSR out-index array (8 bytes per node) stays resident; edge
+/// destinations and any requested properties are loaded one contiguous node
+/// segment at a time through tsuba::RDGSlice. Segments are sized by a target
+/// edge count, and GetSegment()/Prefetch() double-buffer segment loads so
+/// the next segment streams from storage while the current one is being
+/// processed.
+///
+/// This is the PropertyGraph-era replacement for the FileGraph-only
+/// OCImmutableEdgeGraph in OCGraph.h: algorithms iterate segments of
+/// out-edges and keep their per-node state in memory.
+class KATANA_EXPORT OutOfCorePropertyGraph {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+
+  /// A contiguous slice of nodes and the out-edges belonging to them.
+  struct SegmentInfo {
+    Node node_begin;
+    Node node_end;
+    Edge edge_begin;
+    Edge edge_end;
+  };
+
+  /// One segment resident in memory: the destination array for its edge
+  /// range plus the sliced node/edge property tables.
+  class LoadedSegment {
+  public:
+    LoadedSegment(
+        tsuba::RDGSlice&& slice, const SegmentInfo& info,
+        uint64_t dests_file_offset)
+        : slice_(std::move(slice)),
+          info_(info),
+          dests_(slice_.topology_file_storage().ptr<Node>(dests_file_offset)) {
+    }
+
+    const SegmentInfo& info() const { return info_; }
+
+    /// \param e must fall in [info().edge_begin, info().edge_end)
+    Node edge_dest(Edge e) const { return dests_[e - info_.edge_begin]; }
+
+    /// Properties sliced to this segment's node range; row i corresponds to
+    /// node info().node_begin + i.
+    const std::shared_ptr<arrow::Table>& node_properties() const {
+      return slice_.node_properties();
+    }
+    /// Properties sliced to this segment's edge range; row i corresponds to
+    /// edge info().edge_begin + i.
+    const std::shared_ptr<arrow::Table>& edge_properties() const {
+      return slice_.edge_properties();
+    }
+
+  private:
+    tsuba::RDGSlice slice_;
+    SegmentInfo info_;
+    const Node* dests_;
+  };
+
+  /// Open an RDG for segment-at-a-time processing.
+  ///
+  /// \param rdg_name the RDG directory
+  /// \param target_edges_per_segment segments are cut at node boundaries
+  /// once they hold at least this many edges
+  /// \param node_properties / \param edge_properties the property columns
+  /// to load with each segment; empty lists load none
+  static Result<std::unique_ptr<OutOfCorePropertyGraph>> Make(
+      const std::string& rdg_name, uint64_t target_edges_per_segment,
+      std::vector<std::string> node_properties = {},
+      std::vector<std::string> edge_properties = {});
+
+  uint64_t num_nodes() const { return num_nodes_; }
+  uint64_t num_edges() const { return num_edges_; }
+  size_t num_segments() const { return segments_.size(); }
+  const SegmentInfo& segment(size_t i) const { return segments_[i]; }
+
+  /// Edge range of a node, valid without any segment loaded.
+  Edge edge_begin(Node n) const { return n == 0 ? Edge{0} : adj_indices_[n - 1]; }
+  Edge edge_end(Node n) const { return adj_indices_[n]; }
+  size_t degree(Node n) const { return edge_end(n) - edge_begin(n); }
+
+  /// Load a segment synchronously.
+  Result<std::unique_ptr<LoadedSegment>> LoadSegment(size_t i) const;
+
+  /// Start loading a segment in the background. At most one prefetch is
+  /// outstanding; a second call before GetSegment() replaces it.
+  void Prefetch(size_t i);
+
+  /// \returns the given segment, consuming the matching prefetch if one is
+  /// in flight and falling back to a synchronous load otherwise.
+  Result<std::unique_ptr<LoadedSegment>> GetSegment(size_t i);
+
+  /// Run \p fn on every segment in order, prefetching the next segment
+  /// while the current one is processed.
+  template <typename F>
+  Result<void> ForEachSegment(F&& fn) {
+    for (size_t i = 0; i < num_segments(); ++i) {
+      std::unique_ptr<LoadedSegment> seg = KATANA_CHECKED(GetSegment(i));
+      if (i + 1 < num_segments()) {
+        Prefetch(i + 1);
+      }
+      fn(*seg);
+    }
+    return ResultSuccess();
+  }
+
+private:
+  OutOfCorePropertyGraph(
+      std::shared_ptr<tsuba::RDGFile> file, uint64_t num_nodes,
+      uint64_t num_edges, std::vector<std::string> node_properties,
+      std::vector<std::string> edge_properties)
+      : file_(std::move(file)),
+        num_nodes_(num_nodes),
+        num_edges_(num_edges),
+        node_properties_(std::move(node_properties)),
+        edge_properties_(std::move(edge_properties)) {}
+
+  uint64_t DestsFileOffset(Edge e) const;
+
+  std::shared_ptr<tsuba::RDGFile> file_;
+  uint64_t num_nodes_{};
+  uint64_t num_edges_{};
+  std::vector<std::string> node_properties_;
+  std::vector<std::string> edge_properties_;
+
+  /// CSR out-index array, resident for the lifetime of this object.
+  NUMAArray<Edge> adj_indices_;
+  std::vector<SegmentInfo> segments_;
+
+  size_t prefetch_id_{};
+  std::future<Result<std::unique_ptr<LoadedSegment>>> prefetch_;
+};
+
+}  // namespace katana
+
+#endif
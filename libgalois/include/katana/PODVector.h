@@ -21,16 +21,21 @@
 #define KATANA_LIBGALOIS_KATANA_PODVECTOR_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
 #include <iterator>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include "katana/CompilerSpecific.h"
 #include "katana/HostAllocator.h"
 #include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/SimpleLock.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -39,7 +44,7 @@ namespace katana {
  * A specialization of std::vector of plain-old-datatype (POD) objects that
  * does not initialize/construct or destruct the objects.
  * (grows allocation in powers of 2 similar to std::vector)
- * Does not support concurrent/scalable or NUMA-aware allocation.
+ * Does not support NUMA-aware allocation.
  *
  * Use this when the object type is a POD and when the allocation
  * is done in a serial region but the assignment/construction is done in
@@ -47,6 +52,11 @@ namespace katana {
  * and values are assigned in parallel (instead of the typical reserve() and
  * emplace_back() on the main thread).
  *
+ * Collect phases that produce values in parallel can instead use
+ * push_back_concurrent(), which claims slots with a fetch-add on the size
+ * and grows the allocation cooperatively; all other methods remain
+ * unsynchronized and must not run concurrently with it.
+ *
  * If the allocation can be concurrent, check katana::gstl::Vector.
  * If the allocation is large and of known size, then check katana::NUMAArray.
  * Read CONTRIBUTING.md for a more detailed comparison between these types.
@@ -55,8 +65,13 @@ template <typename _Tp>
 class PODVector {
   _Tp* data_;
   size_t capacity_;
-  size_t size_;
+  //! doubles as the slot-claim cursor for push_back_concurrent()
+  std::atomic<size_t> size_;
   HostAllocator<_Tp> host_alloc_;
+  //! number of push_back_concurrent() calls currently writing to data_
+  std::atomic<size_t> concurrent_writers_{0};
+  //! serializes growth during push_back_concurrent()
+  SimpleLock concurrent_lock_;
 
   constexpr static size_t kMinNonZeroCapacity = 8;
 
@@ -68,6 +83,20 @@ class PODVector {
     size_ = 0;
   }
 
+  //! Grows the allocation for push_back_concurrent() once every in-flight
+  //! append has drained, since those may still write to the old allocation.
+  void GrowCooperatively(size_t needed) {
+    std::lock_guard<SimpleLock> guard(concurrent_lock_);
+    if (needed <= capacity_) {
+      // another thread grew the allocation while this one waited
+      return;
+    }
+    while (concurrent_writers_.load() != 0) {
+      asmPause();
+    }
+    reserve(std::max(needed, capacity_ << 1));
+  }
+
 public:
   typedef _Tp value_type;
   typedef size_t size_type;
@@ -106,7 +135,7 @@ public:
   PODVector(PODVector&& v)
       : data_(v.data_),
         capacity_(v.capacity_),
-        size_(v.size_),
+        size_(v.size_.load()),
         host_alloc_(v.host_alloc_) {
     v.Reset();
   }
@@ -120,7 +149,7 @@ public:
       host_alloc_.Free(data_);
       data_ = v.data_;
       capacity_ = v.capacity_;
-      size_ = v.size_;
+      size_ = v.size_.load();
       host_alloc_ = v.host_alloc_;
       v.Reset();
     }
@@ -162,7 +191,7 @@ public:
         capacity_ = 0;
       }
     } else if (size_ < capacity_) {
-      capacity_ = std::max(size_, kMinNonZeroCapacity);
+      capacity_ = std::max(size_.load(), kMinNonZeroCapacity);
       _Tp* new_data_ = host_alloc_.Realloc(data_, capacity_);
       KATANA_LOG_ASSERT(new_data_);
       data_ = new_data_;
@@ -197,6 +226,16 @@ public:
     size_ = n;
   }
 
+  //! Resizes and assigns value to any newly added elements in parallel.
+  void resize(size_t n, const _Tp& value) {
+    size_t old_size = size_;
+    resize(n);
+    if (n > old_size) {
+      katana::do_all(
+          katana::iterate(old_size, n), [&](size_t i) { data_[i] = value; });
+    }
+  }
+
   void clear() { size_ = 0; }
 
   // element access:
@@ -232,6 +271,31 @@ public:
     data_[size_ - 1] = value;
   }
 
+  /**
+   * Appends a value concurrently with other push_back_concurrent() calls
+   * and returns the index it was assigned. A fetch-add on the size claims a
+   * slot; a claim beyond the current capacity doubles the allocation
+   * cooperatively, with late arrivals backing off until the new allocation
+   * is published. Do not mix with the serial mutators, and reserve() an
+   * estimate up front to keep growth off the append path.
+   */
+  size_t push_back_concurrent(const _Tp& value) {
+    size_t index = size_.fetch_add(1);
+    while (true) {
+      concurrent_writers_.fetch_add(1);
+      // The grow lock must be checked after registering as a writer and
+      // before touching capacity_ or data_: a grower that acquires it
+      // afterwards waits for this writer to drain.
+      if (!concurrent_lock_.is_locked() && index < capacity_) {
+        data_[index] = value;
+        concurrent_writers_.fetch_sub(1);
+        return index;
+      }
+      concurrent_writers_.fetch_sub(1);
+      GrowCooperatively(index + 1);
+    }
+  }
+
   template <class InputIterator>
   void insert(
       [[maybe_unused]] iterator position, InputIterator first,
@@ -247,7 +311,9 @@ public:
 
   void swap(PODVector& v) {
     std::swap(data_, v.data_);
-    std::swap(size_, v.size_);
+    size_t s = size_;
+    size_ = v.size_.load();
+    v.size_ = s;
     std::swap(capacity_, v.capacity_);
   }
 };
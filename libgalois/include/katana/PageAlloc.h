@@ -21,6 +21,7 @@
 #define KATANA_LIBGALOIS_KATANA_PAGEALLOC_H_
 
 #include <cstddef>
+#include <functional>
 
 #include "katana/config.h"
 
@@ -35,6 +36,37 @@ KATANA_EXPORT void* allocPages(unsigned num, bool preFault);
 // free page range
 KATANA_EXPORT void freePages(void* ptr, unsigned num);
 
+// Process-wide cap on allocPages memory, in bytes; zero means unlimited.
+// Every consumer of allocPages counts against it, which covers the page
+// pool (and so InsertBag and the rest of the allocator stack) as well as
+// every NUMAArray. Set via KATANA_MEMORY_BUDGET_MB; an allocation that
+// would cross the cap first runs the registered pressure hooks and then
+// applies KATANA_MEMORY_BUDGET_POLICY: "fail" (the default) aborts with a
+// diagnostic while the machine is still responsive, "backpressure" blocks
+// the allocating thread until other threads free pages, aborting only
+// after KATANA_MEMORY_BUDGET_STALL_MS (default 10000) with no frees.
+KATANA_EXPORT size_t allocBudgetBytes();
+
+// allocPages memory currently in use, and the most that was ever in use,
+// in bytes. Tracked whether or not a budget is set.
+KATANA_EXPORT size_t allocInUseBytes();
+KATANA_EXPORT size_t allocHighWaterBytes();
+
+// Register a routine that tries to give back allocPages memory under
+// budget pressure -- spilling a cache, trimming a free list -- and returns
+// roughly how many bytes it released. Hooks run on the allocating thread
+// and must not themselves allocate.
+KATANA_EXPORT void addMemoryPressureHook(std::function<size_t()> hook);
+
+// Cumulative number of huge-page-sized chunks handed out, broken down by the
+// backing actually achieved: explicit hugetlb mappings, regular mappings
+// advised for transparent-huge-page collapse, and plain base pages. Together
+// they describe the hugepage coverage of all allocPages memory, which
+// includes the page pool and every NUMAArray.
+KATANA_EXPORT size_t numPagesHugeTLB();
+KATANA_EXPORT size_t numPagesTHPAdvised();
+KATANA_EXPORT size_t numPagesNotHuge();
+
 }  // namespace katana
 
 #endif
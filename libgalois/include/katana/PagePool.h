@@ -135,6 +135,36 @@ public:
   }
 
   void pagePreAlloc() { pageFree(allocFromOS()); }
+
+  //! Return every page sitting on a free list to the OS; run as a memory
+  //! pressure hook so the budget enforcement in allocPages can claw back
+  //! cached pages before failing an allocation. Returns bytes released.
+  size_t releaseFreePages() {
+    size_t released = 0;
+    for (unsigned tid = 0; tid < pool.size(); ++tid) {
+      HeadPtr& hp = pool[tid].data;
+      if (!hp.getValue()) {
+        continue;
+      }
+      hp.lock();
+      FreeNode* h = hp.getValue();
+      hp.unlock_and_set(nullptr);
+      while (h) {
+        FreeNode* next = h->next;
+        {
+          std::lock_guard<katana::SimpleLock> lg(mapLock);
+          KATANA_LOG_DEBUG_ASSERT(ownerMap.count(h));
+          ownerMap.erase(h);
+        }
+        counts[tid] -= 1;
+        freeCounts[tid] -= 1;
+        katana::freePages(h, 1);
+        released += katana::allocSize();
+        h = next;
+      }
+    }
+    return released;
+  }
 };
 
 //! Initialize PagePool, used by init();
@@ -20,11 +20,15 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PARALLELSTL_H_
 #define KATANA_LIBGALOIS_KATANA_PARALLELSTL_H_
 
+#include <array>
 #include <iterator>
+#include <type_traits>
+#include <vector>
 
 #include "katana/Chunk.h"
 #include "katana/LoopsDecl.h"
 #include "katana/NoDerefIterator.h"
+#include "katana/NumaMem.h"
 #include "katana/Range.h"
 #include "katana/Reduction.h"
 #include "katana/Threads.h"
@@ -274,6 +278,119 @@ sort(RandomAccessIterator first, RandomAccessIterator last) {
           typename std::iterator_traits<RandomAccessIterator>::value_type>());
 }
 
+/**
+ * Sorts trivially copyable records in contiguous storage by an unsigned
+ * integral key extracted with @p key_fn, using a parallel LSD radix sort:
+ * per-thread histograms over 8-bit digits followed by an in-order scatter
+ * into a NUMA-blocked swap buffer each pass. Passes whose digit is constant
+ * across all keys are skipped, so keys drawn from a narrow range only pay
+ * for the digits they use. On billions of 64-bit keyed records (topology
+ * construction, ingest key sorting) this runs several times faster than the
+ * comparison-based \ref sort. The scatter is stable, so records with equal
+ * keys keep their relative order.
+ */
+template <class RandomAccessIterator, class KeyFn>
+void
+radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyFn key_fn) {
+  using value_type =
+      typename std::iterator_traits<RandomAccessIterator>::value_type;
+  using key_type = std::decay_t<decltype(key_fn(*first))>;
+  static_assert(
+      std::is_trivially_copyable<value_type>::value,
+      "radix_sort requires trivially copyable records");
+  static_assert(
+      std::is_integral<key_type>::value && std::is_unsigned<key_type>::value,
+      "radix_sort requires an unsigned integral key");
+
+  const size_t num_items = std::distance(first, last);
+  if (num_items <= 1024) {
+    std::sort(first, last, [&](const value_type& a, const value_type& b) {
+      return key_fn(a) < key_fn(b);
+    });
+    return;
+  }
+
+  constexpr unsigned kDigitBits = 8;
+  constexpr size_t kNumBuckets = size_t{1} << kDigitBits;
+  constexpr unsigned kNumPasses =
+      (sizeof(key_type) * 8 + kDigitBits - 1) / kDigitBits;
+
+  const unsigned num_threads = katana::getActiveThreads();
+  LAptr buffer_mem =
+      largeMallocBlocked(num_items * sizeof(value_type), num_threads);
+
+  value_type* const data = std::addressof(*first);
+  value_type* src = data;
+  value_type* dst = static_cast<value_type*>(buffer_mem.get());
+
+  // counts[t] doubles as thread t's histogram and then its scatter cursors;
+  // 2KB per thread keeps each table inside L1 during the counting scan.
+  std::vector<std::array<size_t, kNumBuckets>> counts(num_threads);
+
+  for (unsigned pass = 0; pass < kNumPasses; ++pass) {
+    const unsigned shift = pass * kDigitBits;
+
+    on_each([&](unsigned tid, unsigned total) {
+      auto range = block_range(size_t{0}, num_items, tid, total);
+      auto& local = counts[tid];
+      local.fill(0);
+      for (size_t i = range.first; i < range.second; ++i) {
+        ++local[(key_fn(src[i]) >> shift) & (kNumBuckets - 1)];
+      }
+    });
+
+    // Exclusive scan over (bucket, thread) pairs turns each histogram slot
+    // into that thread's first destination index for the bucket. Also
+    // detects a constant digit, which makes the whole pass a no-op.
+    bool constant_digit = false;
+    size_t running = 0;
+    for (size_t b = 0; b < kNumBuckets; ++b) {
+      const size_t bucket_start = running;
+      for (unsigned t = 0; t < num_threads; ++t) {
+        const size_t c = counts[t][b];
+        counts[t][b] = running;
+        running += c;
+      }
+      if (running - bucket_start == num_items) {
+        constant_digit = true;
+      }
+    }
+    if (constant_digit) {
+      continue;
+    }
+
+    on_each([&](unsigned tid, unsigned total) {
+      auto range = block_range(size_t{0}, num_items, tid, total);
+      auto& cursor = counts[tid];
+      for (size_t i = range.first; i < range.second; ++i) {
+        dst[cursor[(key_fn(src[i]) >> shift) & (kNumBuckets - 1)]++] = src[i];
+      }
+    });
+
+    std::swap(src, dst);
+  }
+
+  if (src != data) {
+    on_each([&](unsigned tid, unsigned total) {
+      auto range = block_range(size_t{0}, num_items, tid, total);
+      std::copy(
+          src + range.first, src + range.second, data + range.first);
+    });
+  }
+}
+
+/**
+ * Radix sorts unsigned integral values in contiguous storage by their own
+ * value.
+ */
+template <class RandomAccessIterator>
+void
+radix_sort(RandomAccessIterator first, RandomAccessIterator last) {
+  using value_type =
+      typename std::iterator_traits<RandomAccessIterator>::value_type;
+  radix_sort(first, last, [](const value_type& v) { return v; });
+}
+
 template <class InputIterator, class T, typename BinaryOperation>
 T
 accumulate(
@@ -525,6 +642,117 @@ copy_if(InputIt first, InputIt last, OutputIt d_first, UnaryPredicate pred) {
   return d_first + prefix_sum.back();
 }
 
+//! How far ahead the gather/scatter inner loops issue software prefetches.
+//! The indexed side of those passes misses the cache almost every iteration,
+//! so a small lookahead is enough to cover the load latency.
+constexpr ptrdiff_t kIndexedCopyPrefetchDistance = 16;
+
+/**
+ * Gathers indexed elements, i.e. d_first[i] = src[index_first[i]] for every
+ * i in [0, index_last - index_first). The indexed loads are the random side
+ * of this bandwidth-bound pass, so each block prefetches them a small
+ * distance ahead while the writes stream.
+ */
+template <class IndexIt, class RandomIt, class OutputIt>
+OutputIt
+gather(IndexIt index_first, IndexIt index_last, RandomIt src, OutputIt d_first) {
+  using index_category =
+      typename std::iterator_traits<IndexIt>::iterator_category;
+  using output_category =
+      typename std::iterator_traits<OutputIt>::iterator_category;
+  static_assert(
+      std::is_base_of_v<std::random_access_iterator_tag, index_category>,
+      "parallel gather is only supported for random access iterators");
+  static_assert(
+      std::is_base_of_v<std::random_access_iterator_tag, output_category>,
+      "parallel gather is only supported for random access iterators");
+
+  using diff_type = typename std::iterator_traits<IndexIt>::difference_type;
+
+  on_each([&](unsigned tid, unsigned total) {
+    auto [begin, end] = block_range(index_first, index_last, tid, total);
+    diff_type offset = std::distance(index_first, begin);
+    OutputIt out = d_first + offset;
+    const diff_type n = std::distance(begin, end);
+    for (diff_type i = 0; i < n; ++i) {
+      if (i + kIndexedCopyPrefetchDistance < n) {
+        __builtin_prefetch(&src[begin[i + kIndexedCopyPrefetchDistance]]);
+      }
+      out[i] = src[begin[i]];
+    }
+  });
+
+  return d_first + std::distance(index_first, index_last);
+}
+
+/**
+ * Scatters elements to indexed positions, i.e. dst[index_first[i]] =
+ * first[i] for every i in [0, last - first). The indices must be distinct
+ * or the racing writes leave an arbitrary winner. The indexed stores are
+ * the random side of this bandwidth-bound pass, so each block prefetches
+ * the destinations with write intent a small distance ahead while the
+ * reads stream.
+ */
+template <class InputIt, class IndexIt, class RandomIt>
+void
+scatter(InputIt first, InputIt last, IndexIt index_first, RandomIt dst) {
+  using input_category =
+      typename std::iterator_traits<InputIt>::iterator_category;
+  using index_category =
+      typename std::iterator_traits<IndexIt>::iterator_category;
+  static_assert(
+      std::is_base_of_v<std::random_access_iterator_tag, input_category>,
+      "parallel scatter is only supported for random access iterators");
+  static_assert(
+      std::is_base_of_v<std::random_access_iterator_tag, index_category>,
+      "parallel scatter is only supported for random access iterators");
+
+  using diff_type = typename std::iterator_traits<InputIt>::difference_type;
+
+  on_each([&](unsigned tid, unsigned total) {
+    auto [begin, end] = block_range(first, last, tid, total);
+    diff_type offset = std::distance(first, begin);
+    IndexIt index = index_first + offset;
+    const diff_type n = std::distance(begin, end);
+    for (diff_type i = 0; i < n; ++i) {
+      if (i + kIndexedCopyPrefetchDistance < n) {
+        __builtin_prefetch(
+            &dst[index[i + kIndexedCopyPrefetchDistance]], 1 /* write */);
+      }
+      dst[index[i]] = begin[i];
+    }
+  });
+}
+
+/**
+ * Reorders [first, last) so that position i receives the element that was
+ * at position perm_first[i]. The permutation must cover every position
+ * exactly once. The values are staged through a large allocation
+ * interleaved across the machine's memory banks, so the streaming copy out
+ * and the indexed gather back both draw on all sockets' bandwidth. The
+ * value type must be trivially copyable because the staging memory is raw.
+ */
+template <class RandomIt, class IndexIt>
+void
+apply_permutation(RandomIt first, RandomIt last, IndexIt perm_first) {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert(
+      std::is_trivially_copyable_v<value_type>,
+      "apply_permutation stages values through raw memory");
+
+  const auto n = std::distance(first, last);
+  if (n == 0) {
+    return;
+  }
+
+  LAptr staging =
+      largeMallocInterleaved(n * sizeof(value_type), getActiveThreads());
+  value_type* tmp = static_cast<value_type*>(staging.get());
+
+  katana::ParallelSTL::copy(first, last, tmp);
+  katana::ParallelSTL::gather(perm_first, perm_first + n, tmp, first);
+}
+
 }  // end namespace ParallelSTL
 }  // end namespace katana
 #endif
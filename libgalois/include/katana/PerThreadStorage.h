@@ -39,6 +39,9 @@ class KATANA_EXPORT PerBackend {
 
   std::atomic<unsigned int> nextLoc{0};
   std::atomic<char*>* heads{nullptr};
+  //! per-socket backing pools; the socket leader maps one region that all
+  //! threads of the socket carve their slices out of
+  std::atomic<char*>* socketPools{nullptr};
   Lock freeOffsetsLock;
   std::vector<std::vector<unsigned>> freeOffsets;
   /**
@@ -68,6 +71,17 @@ public:
   char* initPerThread(unsigned maxT);
   char* initPerSocket(unsigned maxT);
 
+  //! Size in bytes a slot of the given size occupies in each thread's
+  //! region, after rounding to the backend's size classes.
+  static unsigned roundedAllocSize(unsigned size);
+
+  //! High-water mark of bytes handed out from each thread's region. The
+  //! backing is committed on first touch, so this is an upper bound on the
+  //! per-thread RSS contribution.
+  unsigned bytesAllocated() const {
+    return nextLoc.load(std::memory_order_relaxed);
+  }
+
   unsigned allocOffset(unsigned size);
   void deallocOffset(unsigned offset, unsigned size);
   void* getRemote(unsigned thread, unsigned offset);
@@ -196,6 +210,11 @@ public:
 
   unsigned size() const { return GetThreadPool().getMaxThreads(); }
 
+  //! Bytes of backend storage this instance reserves across all threads.
+  size_t allocatedBytes() const {
+    return size_t{PerBackend::roundedAllocSize(sizeof(T))} * size();
+  }
+
   iterator begin() { return iterator(*this, 0); }
 
   iterator end() { return iterator(*this, size()); }
@@ -291,6 +310,12 @@ public:
   }
 
   unsigned size() const { return GetThreadPool().getMaxThreads(); }
+
+  //! Bytes of backend storage this instance reserves across all sockets.
+  size_t allocatedBytes() const {
+    return size_t{PerBackend::roundedAllocSize(sizeof(T))} *
+           GetThreadPool().getMaxSockets();
+  }
 };
 
 }  // end namespace katana
@@ -0,0 +1,115 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PERFCOUNTERS_H_
+#define KATANA_LIBGALOIS_KATANA_PERFCOUNTERS_H_
+
+#include <cstdint>
+
+#include "katana/PerThreadStorage.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// PerfCounterGroup drives one perf_event_open group on the calling
+/// thread: instructions, last-level-cache misses and backend-stalled
+/// cycles are scheduled onto the PMU together, so their ratios are taken
+/// over the same instruction stream. Unlike the session-wide VTune/PAPI
+/// wrappers in Profile.h, groups are started and stopped around
+/// individual loops, which is what lets a single run say which loop is
+/// memory-bound.
+///
+/// Collection is off unless the KATANA_PERF_COUNTERS environment
+/// variable is set; when it is unset, or the kernel refuses the events
+/// (perf_event_paranoid, missing PMU), every method is a cheap no-op.
+class KATANA_EXPORT PerfCounterGroup {
+public:
+  struct Counts {
+    uint64_t instructions{0};
+    uint64_t llc_misses{0};
+    uint64_t stalled_cycles{0};
+  };
+
+  PerfCounterGroup() = default;
+  ~PerfCounterGroup();
+
+  PerfCounterGroup(const PerfCounterGroup&) = delete;
+  PerfCounterGroup(PerfCounterGroup&&) = delete;
+  PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+  PerfCounterGroup& operator=(PerfCounterGroup&&) = delete;
+
+  /// True when collection was requested via KATANA_PERF_COUNTERS.
+  static bool CollectionRequested();
+
+  /// Enable the group on the calling thread, opening it on first use.
+  void start();
+
+  /// Disable the group and fold the elapsed deltas into counts().
+  void stop();
+
+  /// Report the accumulated counts as summed statistics under \p region,
+  /// alongside the loop's Iterations/Time entries.
+  void report(const char* region) const;
+
+  const Counts& counts() const { return counts_; }
+
+private:
+  bool Open();
+
+  Counts counts_;
+  // group leader (instructions) and followers; -1 while unopened or when
+  // the kernel rejected the event
+  int group_fd_{-1};
+  int llc_fd_{-1};
+  int stall_fd_{-1};
+  bool open_failed_{false};
+};
+
+/// ThreadPerfCounters holds one counter group per thread for a loop and
+/// reports their sums, mirroring ThreadTimers.
+class KATANA_EXPORT ThreadPerfCounters {
+protected:
+  PerThreadStorage<PerfCounterGroup> groups_;
+
+  void reportCounts(const char* region);
+};
+
+/// PerThreadPerfCounters attaches per-loop hardware counters to an
+/// executor the same way PerThreadTimer attaches per-loop times; the
+/// disabled specialization compiles away entirely.
+template <bool enabled>
+class PerThreadPerfCounters : private ThreadPerfCounters {
+  const char* const region_;
+
+public:
+  explicit PerThreadPerfCounters(const char* const region) : region_(region) {}
+
+  PerThreadPerfCounters(const PerThreadPerfCounters&) = delete;
+  PerThreadPerfCounters(PerThreadPerfCounters&&) = delete;
+  PerThreadPerfCounters& operator=(const PerThreadPerfCounters&) = delete;
+  PerThreadPerfCounters& operator=(PerThreadPerfCounters&&) = delete;
+
+  ~PerThreadPerfCounters() { reportCounts(region_); }
+
+  void start() { groups_.getLocal()->start(); }
+
+  void stop() { groups_.getLocal()->stop(); }
+};
+
+template <>
+class PerThreadPerfCounters<false> {
+public:
+  explicit PerThreadPerfCounters(const char* const) {}
+
+  PerThreadPerfCounters(const PerThreadPerfCounters&) = delete;
+  PerThreadPerfCounters(PerThreadPerfCounters&&) = delete;
+  PerThreadPerfCounters& operator=(const PerThreadPerfCounters&) = delete;
+  PerThreadPerfCounters& operator=(PerThreadPerfCounters&&) = delete;
+
+  ~PerThreadPerfCounters() = default;
+
+  void start() const {}
+
+  void stop() const {}
+};
+
+}  // end namespace katana
+
+#endif
@@ -21,12 +21,15 @@
 #define KATANA_LIBGALOIS_KATANA_PRIORITYQUEUE_H_
 
 #include <algorithm>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "katana/CompilerSpecific.h"
 #include "katana/Mem.h"
 #include "katana/PaddedLock.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
 #include "katana/config.h"
 
 namespace katana {
@@ -376,6 +379,145 @@ public:
   void reserve(size_type s) { heap.reserve(s); }
 };
 
+/**
+ * Concurrent min priority queue in the MultiQueue style: several
+ * sequential min-heaps per thread, each behind its own lock. push()
+ * inserts into a random heap and pop() takes the better top of two random
+ * heaps, so threads almost never contend on the same lock and the popped
+ * element is within a bounded distance of the global minimum in
+ * expectation. Use this instead of ThreadSafeMinHeap for best-first
+ * searches that tolerate slightly out-of-order processing.
+ *
+ * try_pop() returning nullopt only means the queue looked empty during one
+ * sweep; it is a definitive answer only once no thread is pushing.
+ */
+template <typename T, typename Cmp = std::less<T>>
+class MultiQueue {
+public:
+  typedef MinHeap<T, Cmp> container_type;
+
+  typedef typename container_type::value_type value_type;
+  typedef typename container_type::size_type size_type;
+
+  static constexpr unsigned kQueuesPerThread = 4;
+
+protected:
+  typedef katana::SimpleLock Lock_ty;
+
+  struct alignas(KATANA_CACHE_LINE_SIZE) Queue {
+    Lock_ty mutex;
+    container_type heap;
+
+    explicit Queue(const Cmp& cmp) : heap(cmp) {}
+  };
+
+  std::vector<Queue> queues;
+  Cmp cmp;
+
+  //! Cheap per-thread xorshift; only the spread matters, not the quality.
+  unsigned randomQueueIndex() const {
+    static thread_local unsigned state =
+        ThreadPool::getTID() * 2654435769U + 1U;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % queues.size();
+  }
+
+  std::optional<value_type> popFrom(Queue& q) {
+    std::lock_guard<Lock_ty> guard(q.mutex);
+    if (q.heap.empty()) {
+      return std::nullopt;
+    }
+    return q.heap.pop();
+  }
+
+public:
+  explicit MultiQueue(
+      const Cmp& cmp = Cmp(), unsigned queues_per_thread = kQueuesPerThread)
+      : queues(
+            std::max(2U, queues_per_thread * getActiveThreads()), Queue(cmp)),
+        cmp(cmp) {}
+
+  bool empty() const { return size() == 0; }
+
+  size_type size() const {
+    size_type total = 0;
+    for (const Queue& q : queues) {
+      q.mutex.lock();
+      total += q.heap.size();
+      q.mutex.unlock();
+    }
+    return total;
+  }
+
+  // for compatibility with various stl types
+  inline void push_back(const value_type& x) { this->push(x); }
+  inline void insert(const value_type& x) { this->push(x); }
+
+  void push(const value_type& x) {
+    Queue& q = queues[randomQueueIndex()];
+    std::lock_guard<Lock_ty> guard(q.mutex);
+    q.heap.push(x);
+  }
+
+  /**
+   * Pops the better top of two random heaps. Returns nullopt after a full
+   * sweep finds every heap empty; under concurrent pushes that is only a
+   * hint, not proof of emptiness.
+   */
+  std::optional<value_type> try_pop() {
+    unsigned i = randomQueueIndex();
+    unsigned j = randomQueueIndex();
+    if (i == j) {
+      j = (j + 1) % queues.size();
+    }
+    if (j < i) {
+      std::swap(i, j);
+    }
+
+    {
+      // lock in index order to stay deadlock-free against other poppers
+      std::lock_guard<Lock_ty> guard_i(queues[i].mutex);
+      std::lock_guard<Lock_ty> guard_j(queues[j].mutex);
+      MinHeap<T, Cmp>& heap_i = queues[i].heap;
+      MinHeap<T, Cmp>& heap_j = queues[j].heap;
+      if (!heap_i.empty() && !heap_j.empty()) {
+        return cmp(heap_j.top(), heap_i.top()) ? heap_j.pop() : heap_i.pop();
+      }
+      if (!heap_i.empty()) {
+        return heap_i.pop();
+      }
+      if (!heap_j.empty()) {
+        return heap_j.pop();
+      }
+    }
+
+    // both random picks were empty; sweep before reporting empty
+    for (Queue& q : queues) {
+      if (std::optional<value_type> x = popFrom(q)) {
+        return x;
+      }
+    }
+    return std::nullopt;
+  }
+
+  //! Like ThreadSafeMinHeap::pop(); only call when the queue is known to
+  //! be non-empty.
+  value_type pop() {
+    std::optional<value_type> x = try_pop();
+    KATANA_LOG_DEBUG_ASSERT(x.has_value());
+    return *x;
+  }
+
+  void clear() {
+    for (Queue& q : queues) {
+      std::lock_guard<Lock_ty> guard(q.mutex);
+      q.heap.clear();
+    }
+  }
+};
+
 }  // namespace katana
 
 #endif
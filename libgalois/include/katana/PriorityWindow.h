@@ -0,0 +1,178 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_PRIORITYWINDOW_H_
+#define KATANA_LIBGALOIS_KATANA_PRIORITYWINDOW_H_
+
+#include <atomic>
+#include <optional>
+#include <type_traits>
+
+#include <boost/noncopyable.hpp>
+
+#include "katana/Chunk.h"
+#include "katana/WorkListHelpers.h"
+
+namespace katana {
+
+/**
+ * Approximate priority scheduling over a fixed, wrapping window of buckets.
+ *
+ * Like {@link OrderedByIntegerMetric}, items are grouped into buckets by an
+ * integer priority and lower priorities are scheduled first. Unlike OBIM,
+ * which allocates buckets on demand behind a lock-protected master log and
+ * per-thread map, a PriorityWindow holds a fixed array of WindowSize buckets
+ * indexed by priority modulo WindowSize, with an atomic cursor marking the
+ * lowest active priority. Pushes and pops touch no shared lock, only the
+ * per-thread chunked queues of the target bucket and the cursor, so the
+ * scheduler does not serialize when many priority levels churn (e.g.
+ * delta-stepping SSSP at high thread counts).
+ *
+ * Priorities are approximate: an item whose priority has already passed the
+ * cursor runs at the current level, and an item more than WindowSize ahead
+ * of the cursor is clamped into the last bucket of the window. No item is
+ * ever lost — a failed pop scans the whole window — but items may execute
+ * earlier or later than their nominal priority, exactly as OBIM's
+ * back-scan/opportunistic rules allow. Priorities must be integral and
+ * monotonically non-decreasing over the run (ascending order only).
+ *
+ * An example:
+ * \code
+ * struct Indexer {
+ *   unsigned operator()(const UpdateRequest& r) const {
+ *     return r.dist >> delta;
+ *   }
+ * };
+ *
+ * typedef katana::PriorityWindow<Indexer> WL;
+ * katana::for_each(katana::iterate(init), Fn, katana::wl<WL>());
+ * \endcode
+ *
+ * @tparam Indexer    Maps items to an integral priority
+ * @tparam Container  Scheduler for each bucket
+ * @tparam WindowSize Number of simultaneously distinct priority levels
+ */
+template <
+    class Indexer = DummyIndexer<int>,
+    typename Container = PerSocketChunkFIFO<>, unsigned WindowSize = 1024,
+    typename T = int, typename Index = unsigned, bool Concurrent = true>
+struct PriorityWindow : private boost::noncopyable {
+  static_assert(
+      std::is_integral<Index>::value, "only integral index types supported");
+  static_assert(WindowSize > 0, "window must have at least one bucket");
+
+  template <typename _T>
+  using retype = PriorityWindow<
+      Indexer, typename Container::template retype<_T>, WindowSize, _T,
+      typename std::result_of<Indexer(_T)>::type, Concurrent>;
+
+  template <bool _b>
+  using rethread =
+      PriorityWindow<Indexer, Container, WindowSize, T, Index, _b>;
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef PriorityWindow<_indexer, Container, WindowSize, T, Index, Concurrent>
+        type;
+  };
+
+  template <typename _container>
+  struct with_container {
+    typedef PriorityWindow<Indexer, _container, WindowSize, T, Index, Concurrent>
+        type;
+  };
+
+  template <unsigned _window_size>
+  struct with_window_size {
+    typedef PriorityWindow<Indexer, Container, _window_size, T, Index, Concurrent>
+        type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+private:
+  typedef typename Container::template rethread<Concurrent> CTy;
+
+  CTy buckets_[WindowSize];
+  std::atomic<Index> cursor_;
+  Indexer indexer_;
+
+  //! Clamps a priority into the window [cursor, cursor + WindowSize).
+  //! The cursor read may be stale; that only deprioritizes the item within
+  //! the window, it cannot strand it, because pop scans every bucket.
+  Index clamp(Index index) const {
+    Index cur = cursor_.load(std::memory_order_acquire);
+    if (compare(index, cur)) {
+      return cur;
+    }
+    if (!compare(index, cur + WindowSize)) {
+      return cur + WindowSize - 1;
+    }
+    return index;
+  }
+
+  static bool compare(Index a, Index b) { return a < b; }
+
+public:
+  PriorityWindow(const Indexer& x = Indexer()) : cursor_(0), indexer_(x) {}
+
+  void push(const value_type& val) {
+    Index index = clamp(indexer_(val));
+    buckets_[index % WindowSize].push(val);
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e)
+      push(*b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  std::optional<value_type> pop() {
+    Index cur = cursor_.load(std::memory_order_acquire);
+
+    // Scan the full window from the cursor so items stranded behind a stale
+    // cursor read are still found.
+    for (unsigned k = 0; k < WindowSize; ++k) {
+      std::optional<value_type> item = buckets_[(cur + k) % WindowSize].pop();
+      if (item) {
+        if (k > 0) {
+          // Publish the first non-empty level; failure means another
+          // thread already moved the cursor.
+          cursor_.compare_exchange_weak(
+              cur, cur + k, std::memory_order_release,
+              std::memory_order_relaxed);
+        }
+        return item;
+      }
+    }
+
+    return std::nullopt;
+  }
+};
+KATANA_WLCOMPILECHECK(PriorityWindow)
+
+}  // end namespace katana
+
+#endif
@@ -15,6 +15,7 @@
 #include "katana/PODVector.h"
 #include "katana/Result.h"
 #include "katana/Traits.h"
+#include "katana/config.h"
 
 namespace katana {
 
@@ -253,6 +254,36 @@ AllocateTable(uint64_t num_rows, const std::vector<std::string>& names) {
 /// with trivial constructors (std::is_trivial) and standard layout
 /// (std::is_standard_layout).
 ///
+/// PODPropertySpan is a flat view of one POD property column: a
+/// restrict-qualified base pointer plus a length. Because the pointer is
+/// declared non-aliasing, a loop indexing through a span keeps the base
+/// pointer in a register and can vectorize; capture one span per property
+/// outside a hot loop rather than going through GetValue per element.
+/// operator[] bounds-checks in debug builds and compiles to plain indexing
+/// otherwise.
+template <typename T>
+class PODPropertySpan {
+public:
+  PODPropertySpan(T* data, size_t size) : data_(data), size_(size) {}
+
+  T& operator[](size_t i) const {
+    KATANA_LOG_DEBUG_VASSERT(i < size_, "index: {}, size: {}", i, size_);
+    return data_[i];
+  }
+
+  T* data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+  T* begin() const { return data_; }
+
+  T* end() const { return data_ + size_; }
+
+private:
+  T* KATANA_RESTRICT data_;
+  size_t size_;
+};
+
 /// POD types as a concept are deprecated in C++20, but POD so much shorter to
 /// say than trivial and standard.
 ///
@@ -281,8 +312,7 @@ public:
     }
     return PODPropertyView(
         internal::GetMutableValuesWorkAround<T>(array.data(), 1, 0),
-        array.data()->template GetValues<uint8_t>(0, 0), array.length(),
-        array.offset());
+        NullBitmap(array), array.length(), array.offset());
   }
 
   static Result<PODPropertyView> Make(
@@ -304,8 +334,7 @@ public:
     }
     return PODPropertyView(
         internal::GetMutableValuesWorkAround<T>(array.data(), 1, 0),
-        array.data()->template GetValues<uint8_t>(0, 0), array.length(),
-        array.offset());
+        NullBitmap(array), array.length(), array.offset());
   }
 
   bool IsValid(size_t i) const {
@@ -318,6 +347,14 @@ public:
 
   const_reference GetValue(size_t i) const { return values_[i + offset_]; }
 
+  /// The values as a flat restrict-qualified span with the arrow offset
+  /// folded in; \see PODPropertySpan
+  PODPropertySpan<T> span() { return {values_ + offset_, length_}; }
+
+  PODPropertySpan<const T> span() const {
+    return {values_ + offset_, length_};
+  }
+
   reference operator[](size_t i) { return GetValue(i); }
 
   const_reference operator[](size_t i) const { return GetValue(i); }
@@ -330,6 +367,18 @@ private:
         length_(length),
         offset_(offset) {}
 
+  /// The validity bitmap, or nullptr for all-valid arrays even when a
+  /// bitmap buffer is present (e.g., after slicing): IsValid then reduces
+  /// to a loop-invariant pointer compare the compiler hoists, so typed
+  /// loops over the common zero-null column pay no per-element mask check
+  template <typename ArrayType>
+  static const uint8_t* NullBitmap(const ArrayType& array) {
+    if (array.null_count() == 0) {
+      return nullptr;
+    }
+    return array.data()->template GetValues<uint8_t>(0, 0);
+  }
+
   T* values_;
   const uint8_t* null_bitmap_;
   size_t length_, offset_;
@@ -349,7 +398,7 @@ public:
 
   bool IsValid(size_t i) const {
     KATANA_LOG_DEBUG_ASSERT(i < (size_t)array_.length());
-    return array_.IsValid(i);
+    return no_nulls_ || array_.IsValid(i);
   }
 
   value_type GetValue(size_t i) const {
@@ -366,9 +415,12 @@ public:
 
 private:
   BooleanPropertyReadOnlyView(const arrow::BooleanArray& array)
-      : array_(array) {}
+      : array_(array), no_nulls_(array.null_count() == 0) {}
 
   const arrow::BooleanArray& array_;
+  // captured at construction so IsValid is a loop-invariant test for the
+  // common all-valid column instead of a per-element bitmap probe
+  bool no_nulls_;
 };
 
 /// StringPropertyReadOnlyView provides a read-only property view over
@@ -383,7 +435,7 @@ public:
     return StringPropertyReadOnlyView(array);
   }
 
-  bool IsValid(size_t i) const { return array_.IsValid(i); }
+  bool IsValid(size_t i) const { return no_nulls_ || array_.IsValid(i); }
 
   value_type GetValue(size_t i) const {
     KATANA_LOG_DEBUG_ASSERT(IsValid(i));
@@ -398,9 +450,68 @@ public:
   }
 
 private:
-  StringPropertyReadOnlyView(const ArrowArrayType& array) : array_(array) {}
+  StringPropertyReadOnlyView(const ArrowArrayType& array)
+      : array_(array), no_nulls_(array.null_count() == 0) {}
 
   const ArrowArrayType& array_;
+  bool no_nulls_;
+};
+
+/// StringDictPropertyReadOnlyView provides a read-only property view over
+/// dictionary-encoded string columns (arrow::DictionaryArray with int32
+/// codes over an arrow::StringArray dictionary). The dictionary is stored
+/// once; per-row access touches only the code array, so equality predicates
+/// and group-bys can compare int32 codes and look strings up only at the
+/// boundary. \see PropertyGraph::DictionaryEncodeNodeProperty
+class KATANA_EXPORT StringDictPropertyReadOnlyView {
+public:
+  using value_type = std::string;
+
+  /// code returned by FindCode for strings absent from the dictionary; no
+  /// row's code ever equals it
+  static constexpr int32_t kInvalidCode = -1;
+
+  static Result<StringDictPropertyReadOnlyView> Make(
+      const arrow::DictionaryArray& array);
+
+  bool IsValid(size_t i) const { return no_nulls_ || codes_->IsValid(i); }
+
+  /// The dictionary code of row \p i
+  int32_t GetCode(size_t i) const {
+    KATANA_LOG_DEBUG_ASSERT(IsValid(i));
+    return codes_->Value(i);
+  }
+
+  value_type GetValue(size_t i) const {
+    return dict_->GetString(GetCode(i));
+  }
+
+  value_type operator[](size_t i) const {
+    if (!IsValid(i)) {
+      return value_type{};
+    }
+    return GetValue(i);
+  }
+
+  /// The code \p value maps to, or kInvalidCode if the dictionary does not
+  /// contain it (so no row compares equal). Linear in the dictionary size;
+  /// resolve predicates once, then compare codes
+  int32_t FindCode(std::string_view value) const;
+
+  /// Number of distinct strings in the dictionary
+  int64_t dictionary_size() const { return dict_->length(); }
+
+private:
+  StringDictPropertyReadOnlyView(
+      std::shared_ptr<arrow::Int32Array> codes,
+      std::shared_ptr<arrow::StringArray> dict)
+      : codes_(std::move(codes)),
+        dict_(std::move(dict)),
+        no_nulls_(codes_->null_count() == 0) {}
+
+  std::shared_ptr<arrow::Int32Array> codes_;
+  std::shared_ptr<arrow::StringArray> dict_;
+  bool no_nulls_;
 };
 
 template <typename ArrowT, typename ViewT>
@@ -472,6 +583,10 @@ struct LargeStringReadOnlyProperty
           arrow::LargeStringType,
           StringPropertyReadOnlyView<arrow::LargeStringArray>> {};
 
+struct StringDictProperty
+    : public Property<arrow::DictionaryType, StringDictPropertyReadOnlyView> {
+};
+
 template <typename T>
 struct StructProperty
     : public Property<arrow::FixedSizeBinaryType, katana::PODPropertyView<T>> {
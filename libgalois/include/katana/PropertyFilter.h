@@ -0,0 +1,77 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_PROPERTYFILTER_H_
+#define KATANA_LIBGALOIS_KATANA_PROPERTYFILTER_H_
+
+#include <string>
+#include <vector>
+
+#include "katana/DynamicBitset.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Comparison operator of a PropertyPredicate.
+enum class PredicateOp {
+  kEqual,
+  kNotEqual,
+  kLessThan,
+  kLessEqual,
+  kGreaterThan,
+  kGreaterEqual,
+};
+
+/// One comparison of a numeric property column against a constant.
+///
+/// The constant is held as a double; evaluation folds it into the column's
+/// native type once per predicate, so integer columns are compared exactly
+/// in their own type rather than row by row in floating point.
+struct PropertyPredicate {
+  std::string property_name;
+  PredicateOp op;
+  double value;
+};
+
+/// EvaluateNodePredicates evaluates the conjunction of \p predicates over
+/// the graph's node property columns and returns the selected nodes as a
+/// bitmap indexed by node id. Null rows never match. An empty conjunction
+/// selects every node.
+///
+/// Each predicate is a single tight pass over the column's value buffer,
+/// built 64 rows at a time so the compare vectorizes and nulls are masked
+/// word-at-a-time from the Arrow validity bitmap. This replaces the
+/// hand-written do_all filter loops apps carry; the result feeds straight
+/// into traversals via DynamicBitset::for_each_set_bit or
+/// katana::iterate over DynamicBitset::GetOffsets.
+KATANA_EXPORT Result<DynamicBitset> EvaluateNodePredicates(
+    const PropertyGraph* pg, const std::vector<PropertyPredicate>& predicates);
+
+/// EvaluateEdgePredicates evaluates the conjunction of \p predicates over
+/// edge property columns; the bitmap is indexed by edge id.
+///
+/// \see EvaluateNodePredicates
+KATANA_EXPORT Result<DynamicBitset> EvaluateEdgePredicates(
+    const PropertyGraph* pg, const std::vector<PropertyPredicate>& predicates);
+
+}  // namespace katana
+
+#endif
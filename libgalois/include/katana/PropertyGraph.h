@@ -1,6 +1,8 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPH_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPH_H_
 
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include <arrow/api.h>
@@ -8,14 +10,18 @@
 #include <arrow/type_traits.h>
 
 #include "katana/ArrowInterchange.h"
+#include "katana/DegreeDistribution.h"
 #include "katana/Details.h"
 #include "katana/EntityTypeManager.h"
 #include "katana/ErrorCode.h"
 #include "katana/GraphTopology.h"
 #include "katana/Iterators.h"
 #include "katana/NUMAArray.h"
+#include "katana/NumaMem.h"
+#include "katana/PerThreadStorage.h"
 #include "katana/PropertyIndex.h"
 #include "katana/Result.h"
+#include "katana/SharedMemoryRegion.h"
 #include "katana/config.h"
 #include "tsuba/RDG.h"
 
@@ -51,6 +57,7 @@ public:
   using edge_iterator = GraphTopology::edge_iterator;
   using edges_range = GraphTopology::edges_range;
   using iterator = GraphTopology::iterator;
+  using local_iterator = GraphTopology::local_iterator;
   using Node = GraphTopology::Node;
   using Edge = GraphTopology::Edge;
 
@@ -88,13 +95,113 @@ private:
   /// The edge EntityTypeID for each edge's most specific type
   EntityTypeIDArray edge_entity_type_ids_;
 
+  /// Sorted node-ID list per EntityTypeID, indexed by the type id;
+  /// \see BuildNodeTypeIndex
+  std::vector<std::vector<GraphTopology::Node>> node_type_index_;
+  bool node_type_index_valid_{false};
+
+  /// Concatenate the exact-type lists flagged in \p selected into one
+  /// ascending node list
+  std::vector<GraphTopology::Node> GatherNodesOfSelectedTypes(
+      const std::vector<bool>& selected) const;
+
   // List of node and edge indexes on this graph.
   std::vector<std::unique_ptr<PropertyIndex<GraphTopology::Node>>>
       node_indexes_;
   std::vector<std::unique_ptr<PropertyIndex<GraphTopology::Edge>>>
       edge_indexes_;
 
-  PGViewCache pg_view_cache_;
+  // mutable because materializing a permuted property copy through a
+  // const view is a logically const operation; the cache itself is
+  // single threaded (see PGViewCache)
+  mutable PGViewCache pg_view_cache_;
+
+  /// Type-erased cache of bound typed property view tuples, keyed by the
+  /// property tuple type and the property names it was bound over; see
+  /// internal::MakeNodePropertyViews. Cleared whenever a property table
+  /// changes so no cached view can dangle. mutable because binding a typed
+  /// view is a logically const operation. Moving a graph moves the entries
+  /// but not the mutex, which keeps PropertyGraph movable.
+  struct PropertyViewCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<void>> entries;
+
+    PropertyViewCache() = default;
+    PropertyViewCache(PropertyViewCache&& other) noexcept
+        : entries(std::move(other.entries)) {}
+    PropertyViewCache& operator=(PropertyViewCache&& other) noexcept {
+      entries = std::move(other.entries);
+      return *this;
+    }
+  };
+  mutable PropertyViewCache property_view_cache_;
+
+  /// Lazily built summary of the topology's out-degree distribution; see
+  /// GetDegreeDistribution. Follows the same movability scheme as
+  /// PropertyViewCache: moving a graph moves the entry but not the mutex.
+  struct DegreeDistributionCache {
+    std::mutex mutex;
+    std::shared_ptr<const DegreeDistribution> entry;
+
+    DegreeDistributionCache() = default;
+    DegreeDistributionCache(DegreeDistributionCache&& other) noexcept
+        : entry(std::move(other.entry)) {}
+    DegreeDistributionCache& operator=(
+        DegreeDistributionCache&& other) noexcept {
+      entry = std::move(other.entry);
+      return *this;
+    }
+  };
+  mutable DegreeDistributionCache degree_distribution_cache_;
+
+  /// One NUMA-local copy per socket of a hot read-only property's values,
+  /// resolved per-thread through PerSocketStorage; see
+  /// ReplicateNodeProperty
+  struct ReplicatedProperty {
+    /// One buffer per socket, first-touched by that socket's threads.
+    /// Sockets with no active thread hold no buffer and share the first
+    /// socket's copy through the pointer table instead.
+    std::vector<LAptr> copies;
+    /// Per-socket pointer to the socket-local copy; behind a unique_ptr
+    /// because PerSocketStorage cannot be moved safely
+    std::unique_ptr<PerSocketStorage<const uint8_t*>> local;
+    uint64_t value_width{0};
+  };
+  std::unordered_map<std::string, ReplicatedProperty>
+      replicated_node_properties_;
+  std::unordered_map<std::string, ReplicatedProperty>
+      replicated_edge_properties_;
+
+  Result<void> ReplicateProperty(
+      const std::shared_ptr<arrow::ChunkedArray>& column,
+      const std::string& name,
+      std::unordered_map<std::string, ReplicatedProperty>* replicas);
+
+  template <typename T>
+  static const T* GetReplicatedData(
+      const std::unordered_map<std::string, ReplicatedProperty>& replicas,
+      const std::string& name) {
+    auto it = replicas.find(name);
+    if (it == replicas.end()) {
+      return nullptr;
+    }
+    KATANA_LOG_DEBUG_ASSERT(sizeof(T) == it->second.value_width);
+    return reinterpret_cast<const T*>(*it->second.local->getLocal());
+  }
+
+  /// Drop all cached typed property views, and the per-socket property
+  /// replicas with them; called by every operation that adds, replaces,
+  /// removes, loads, or unloads a property column
+  void InvalidatePropertyViewCache();
+
+  /// Drop the cached degree distribution; called when the topology is
+  /// dropped or replaced
+  void InvalidateDegreeDistribution();
+
+  /// Keeps the mapping behind a graph built by MakeFromSharedMemory()
+  /// alive; the topology arrays alias it directly (property buffers hold
+  /// their own references)
+  std::shared_ptr<SharedMemoryRegion> shared_mem_region_;
 
   friend class PropertyGraphRetractor;
 
@@ -216,16 +323,38 @@ public:
   PGView BuildView() noexcept {
     return pg_view_cache_.BuildView<PGView>(this);
   }
+
+  /// Edge property \p name permuted into \p topo's edge order; \see
+  /// PGViewCache::GetMaterializedEdgeProperty. Like the rest of the view
+  /// cache, not thread-safe: materialize before entering a parallel loop.
+  /// Most callers reach this through a view's GetMaterializedEdgeProperty.
+  Result<std::shared_ptr<arrow::Array>> GetMaterializedEdgeProperty(
+      const EdgeShuffleTopology* topo, const std::string& name) const {
+    return pg_view_cache_.GetMaterializedEdgeProperty(this, topo, name);
+  }
   /// Make a property graph from a constructed RDG. Take ownership of the RDG
-  /// and its underlying resources.
+  /// and its underlying resources. When \p lazy_topology is set, the
+  /// topology stays backed by the RDG's memory-mapped topology file rather
+  /// than being materialized into NUMA arrays.
   static Result<std::unique_ptr<PropertyGraph>> Make(
-      std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg);
+      std::unique_ptr<tsuba::RDGFile> rdg_file, tsuba::RDG&& rdg,
+      bool lazy_topology = false);
 
   /// Make a property graph from an RDG name.
   static Result<std::unique_ptr<PropertyGraph>> Make(
       const std::string& rdg_name,
       const tsuba::RDGLoadOptions& opts = tsuba::RDGLoadOptions());
 
+  /// Make a property graph from an RDG name with a pipelined open: the
+  /// transposed topology is built on the ThreadPool while property decode
+  /// is still reading from storage, and is seeded into the view cache so
+  /// BiDirectional and Transposed views come up without a rebuild. Use
+  /// this when the caller is going to ask for in-edge views anyway; it
+  /// does the transpose work even if no view ever needs it.
+  static Result<std::unique_ptr<PropertyGraph>> MakePipelined(
+      const std::string& rdg_name,
+      const tsuba::RDGLoadOptions& opts = tsuba::RDGLoadOptions());
+
   /// Make a property graph from topology
   static Result<std::unique_ptr<PropertyGraph>> Make(
       GraphTopology&& topo_to_assign);
@@ -294,6 +423,15 @@ public:
 
   uint32_t partition_id() const { return rdg_.partition_id(); }
 
+  /// Metadata describing this graph's place in a partitioned whole;
+  /// persisted with the RDG on the next Write.
+  const tsuba::PartitionMetadata& partition_metadata() const {
+    return rdg_.part_metadata();
+  }
+  void set_partition_metadata(const tsuba::PartitionMetadata& metadata) {
+    rdg_.set_part_metadata(metadata);
+  }
+
   /// Create a new storage location for a graph and write everything into it.
   ///
   /// \returns io_error if, for instance, a file already exists
@@ -307,6 +445,35 @@ public:
   Result<void> Commit(const std::string& command_line);
   Result<void> WriteView(const std::string& command_line);
 
+  /// Persist the transposed topology next to the RDG so later runs can map
+  /// it instead of rebuilding it. Builds the transpose first if it is not
+  /// already cached. The file is keyed to the current topology's shape and
+  /// ignored once the graph's node or edge count changes.
+  Result<void> WriteTransposeTopology();
+
+  /// Load a transpose persisted by WriteTransposeTopology(), if one exists
+  /// and still matches this graph's topology.
+  ///
+  /// \returns nullptr when no usable persisted transpose is found; an error
+  /// only if a file exists but cannot be read.
+  Result<std::unique_ptr<EdgeShuffleTopology>> LoadTransposeTopology() const;
+
+  /// Place the CSR topology arrays and every single-chunk, fixed-width,
+  /// null-free property column into the named POSIX shared-memory segment
+  /// so concurrent processes can map one physical copy of the graph.
+  /// Columns that do not qualify (string, nested, or dictionary types,
+  /// columns with nulls, multi-chunk columns) are skipped with a warning;
+  /// run ConsolidateProperties() first to make chunked columns eligible.
+  /// The segment persists until SharedMemoryRegion::Unlink(\p name).
+  Result<void> ExportToSharedMemory(const std::string& name) const;
+
+  /// Map a graph exported by ExportToSharedMemory(). Topology and property
+  /// data alias the shared segment directly, so the returned graph costs no
+  /// additional physical memory beyond page tables; its properties are
+  /// read-only.
+  static Result<std::unique_ptr<PropertyGraph>> MakeFromSharedMemory(
+      const std::string& name);
+
   /// Determine if two PropertyGraphs are Equal
   /// THIS IS A TESTING ONLY FUNCTION, DO NOT EXPOSE THIS TO THE USER
   /// when comparing PG in Equals we directly compare all tables in properties
@@ -319,6 +486,16 @@ public:
   /// software did not. The two graphs would be functionally Equal, but this function would say this are not equal
   /// TODO(unknown):(emcginnis) consider breaking the function down into: topology comparison, type comparison, and property comparison. Move pitfall described above alone with the property comparison function
   bool Equals(const PropertyGraph* other) const;
+
+  /// A 64-bit merkle-style digest of the graph: chunk hashes of the topology
+  /// arrays, entity type id arrays, and property buffers are computed in
+  /// parallel and folded in order. Byte-identical graphs always produce the
+  /// same fingerprint, so it is a cheap replica divergence check and lets
+  /// Equals skip the element-wise property compare. The digest covers the
+  /// in-memory representation: logically equal columns chunked or offset
+  /// differently can produce different fingerprints.
+  uint64_t Fingerprint() const;
+
   /// Report the differences between two graphs
   /// THIS IS A TESTING ONLY FUNCTION, DO NOT EXPOSE THIS TO THE USER
   std::string ReportDiff(const PropertyGraph* other) const;
@@ -501,6 +678,36 @@ public:
     return IsEdgeSubtypeOf(edge_entity_type_id, GetTypeOfEdge(edge));
   }
 
+  /// Sorted node IDs grouped by entity type
+  using NodeList = std::vector<Node>;
+
+  /// Build the per-type node index: a sorted node-ID list per
+  /// EntityTypeID, so type-filtered queries cost O(matching nodes) instead
+  /// of a full-graph scan over DoesNodeHaveType. ConstructEntityTypeIDs()
+  /// builds it automatically; call this for graphs whose type arrays were
+  /// loaded from storage, and again after mutating type assignments.
+  void BuildNodeTypeIndex();
+
+  /// \returns true iff BuildNodeTypeIndex() ran against the current type
+  /// assignments
+  bool HasNodeTypeIndex() const noexcept { return node_type_index_valid_; }
+
+  /// The nodes whose MOST SPECIFIC type is exactly \p type_id, ascending.
+  /// Requires the node type index.
+  const NodeList& GetNodesWithExactType(EntityTypeID type_id) const;
+
+  /// The nodes that have type \p type_id (most specific or any subtype),
+  /// ascending: the union of the exact lists of every subtype. Requires
+  /// the node type index.
+  NodeList GetNodesWithType(EntityTypeID type_id) const;
+
+  /// Union over \p type_ids of GetNodesWithType, ascending
+  NodeList GetNodesWithAnyType(const std::vector<EntityTypeID>& type_ids) const;
+
+  /// Intersection over \p type_ids of GetNodesWithType, ascending
+  NodeList GetNodesWithAllTypes(
+      const std::vector<EntityTypeID>& type_ids) const;
+
   // Return type dictated by arrow
   /// Returns the number of node properties
   int32_t GetNumNodeProperties() const {
@@ -528,6 +735,30 @@ public:
     return rdg_.edge_properties()->column(i);
   }
 
+  /// Borrow a node property without taking shared ownership.
+  ///
+  /// GetNodeProperty copies a shared_ptr, and when every thread does that
+  /// per operator the column's reference count ping-pongs between caches.
+  /// The borrowed pointer touches no reference count; the property table
+  /// keeps the column alive, so it remains valid until the property is
+  /// unloaded or removed. Borrow once per loop and do not hold the pointer
+  /// across calls that change the loaded property set.
+  const arrow::ChunkedArray* BorrowNodeProperty(int i) const {
+    if (i >= rdg_.node_properties()->num_columns()) {
+      return nullptr;
+    }
+    return rdg_.node_properties()->column(i).get();
+  }
+
+  /// Borrow an edge property without taking shared ownership; see
+  /// BorrowNodeProperty for the lifetime rules.
+  const arrow::ChunkedArray* BorrowEdgeProperty(int i) const {
+    if (i >= rdg_.edge_properties()->num_columns()) {
+      return nullptr;
+    }
+    return rdg_.edge_properties()->column(i).get();
+  }
+
   /// \returns true if a node property/type with @param name exists
   bool HasNodeProperty(const std::string& name) const {
     return loaded_node_schema()->GetFieldIndex(name) != -1;
@@ -540,8 +771,13 @@ public:
 
   /// Get a node property by name.
   ///
+  /// If the property exists on storage but has not been loaded (e.g. the
+  /// graph was opened with RDGLoadOptions::lazy_properties or a subset of
+  /// columns), it is faulted in from the RDG on first touch and registered
+  /// with the property cache.
+  ///
   /// \param name The name of the property to get.
-  /// \return The property data or NULL if the property is not found.
+  /// \return The property data or an error if the property is not found.
   Result<std::shared_ptr<arrow::ChunkedArray>> GetNodeProperty(
       const std::string& name) const;
 
@@ -549,9 +785,52 @@ public:
     return loaded_node_schema()->field(i)->name();
   }
 
+  /// Get an edge property by name, faulting it in from the RDG like
+  /// GetNodeProperty does for nodes.
   Result<std::shared_ptr<arrow::ChunkedArray>> GetEdgeProperty(
       const std::string& name) const;
 
+  /// Borrow a node property by name, faulting it in if necessary. The one
+  /// shared_ptr copy happens here, at loop setup, instead of per access;
+  /// the same lifetime rules as BorrowNodeProperty(int) apply.
+  Result<const arrow::ChunkedArray*> BorrowNodeProperty(
+      const std::string& name) const;
+
+  /// Borrow an edge property by name; see BorrowNodeProperty.
+  Result<const arrow::ChunkedArray*> BorrowEdgeProperty(
+      const std::string& name) const;
+
+  /// Keep one copy per socket of the named node property's values so a
+  /// small, extremely hot column (e.g. the rank array in pull-style
+  /// PageRank) is read from socket-local memory instead of across the
+  /// interconnect. Only fixed-width, null-free columns qualify. The
+  /// copies are not kept coherent with the column: replicate only
+  /// properties that stay read-only while the replicas are in use. They
+  /// are dropped whenever the property table changes. Replicating an
+  /// already-replicated property is a no-op.
+  Result<void> ReplicateNodeProperty(const std::string& name);
+
+  /// see ReplicateNodeProperty
+  Result<void> ReplicateEdgeProperty(const std::string& name);
+
+  /// Free every per-socket copy made by Replicate{Node,Edge}Property
+  void DropReplicatedProperties();
+
+  /// This thread's socket-local copy of a replicated node property, or
+  /// nullptr if the property is not replicated. \tparam T must be the
+  /// column's physical value type. Resolve once per loop and index with
+  /// node IDs like any flat array.
+  template <typename T>
+  const T* GetReplicatedNodeProperty(const std::string& name) const {
+    return GetReplicatedData<T>(replicated_node_properties_, name);
+  }
+
+  /// see GetReplicatedNodeProperty
+  template <typename T>
+  const T* GetReplicatedEdgeProperty(const std::string& name) const {
+    return GetReplicatedData<T>(replicated_edge_properties_, name);
+  }
+
   std::string GetEdgePropertyName(int32_t i) const {
     return loaded_edge_schema()->field(i)->name();
   }
@@ -612,6 +891,12 @@ public:
 
   const GraphTopology& topology() const noexcept { return topology_; }
 
+  /// Returns the cached summary of the topology's out-degree distribution,
+  /// building it in parallel on first use (\see DegreeDistribution).
+  /// Callers that hold the pointer keep a usable summary even after the
+  /// topology is dropped.
+  std::shared_ptr<const DegreeDistribution> GetDegreeDistribution() const;
+
   const EntityTypeManager& node_entity_type_manager() const noexcept {
     return node_entity_type_manager_;
   }
@@ -629,6 +914,38 @@ public:
   /// If property name exists, replace it, otherwise insert it
   Result<void> UpsertEdgeProperties(const std::shared_ptr<arrow::Table>& props);
 
+  /// Compact a node property that arrived in several chunks into a single
+  /// contiguous (64-byte-aligned) chunk so that typed property views can be
+  /// built over it; a no-op for single-chunk columns
+  Result<void> ConsolidateNodeProperty(const std::string& prop_name);
+  /// \see ConsolidateNodeProperty
+  Result<void> ConsolidateEdgeProperty(const std::string& prop_name);
+  /// Consolidate the named loaded properties; TypedPropertyGraph::Make calls
+  /// this for the columns it views
+  Result<void> ConsolidateProperties(
+      const std::vector<std::string>& node_properties,
+      const std::vector<std::string>& edge_properties);
+
+  /// Replace a string-typed node property with its dictionary-encoded form
+  /// (int32 codes over a dictionary stored once), suitable for viewing
+  /// through StringDictProperty; a no-op if the column is already
+  /// dictionary-encoded
+  Result<void> DictionaryEncodeNodeProperty(const std::string& prop_name);
+  /// \see DictionaryEncodeNodeProperty
+  Result<void> DictionaryEncodeEdgeProperty(const std::string& prop_name);
+
+  /// Return the typed property view tuple cached under \p key, or nullptr.
+  /// Entries are dropped whenever a property table changes, so a returned
+  /// entry is valid for the current tables. Keys are built by
+  /// internal::PropertyViewCacheKey.
+  std::shared_ptr<void> FindPropertyViewCacheEntry(
+      const std::string& key) const;
+
+  /// Store a typed property view tuple under \p key
+  /// \see FindPropertyViewCacheEntry
+  void InsertPropertyViewCacheEntry(
+      const std::string& key, std::shared_ptr<void> entry) const;
+
   Result<void> RemoveNodeProperty(int i);
   Result<void> RemoveNodeProperty(const std::string& prop_name);
 
@@ -731,6 +1048,12 @@ public:
 
   node_iterator end() const { return topology().end(); }
 
+  /// Edge-balanced per-thread node slice; lets \ref katana::iterate build a
+  /// LocalRange over the graph instead of a node-balanced split.
+  node_iterator local_begin() const { return topology().local_begin(); }
+
+  node_iterator local_end() const { return topology().local_end(); }
+
   /// Return the number of local nodes
   size_t size() const { return topology().size(); }
 
@@ -757,12 +1080,39 @@ public:
     return node_iterator(node_id);
   }
 
-  // Creates an index over a node property.
+  // Creates an index over a node property. If a copy of the index was
+  // persisted with WriteNodePropertyIndex it is revived from storage
+  // instead of being rebuilt.
   Result<void> MakeNodeIndex(const std::string& column_name);
 
-  // Creates an index over an edge property.
+  // Creates an index over an edge property. If a copy of the index was
+  // persisted with WriteEdgePropertyIndex it is revived from storage
+  // instead of being rebuilt.
   Result<void> MakeEdgeIndex(const std::string& column_name);
 
+  // Persists the index over the named node property into the RDG so later
+  // loads can revive it instead of rebuilding it. The graph must have been
+  // written before its indexes can be; the part header records the index
+  // at the next Commit.
+  Result<void> WriteNodePropertyIndex(const std::string& column_name);
+
+  // Persists the index over the named edge property into the RDG; see
+  // WriteNodePropertyIndex.
+  Result<void> WriteEdgePropertyIndex(const std::string& column_name);
+
+  // Materializes from storage the runs of rows of the named node property
+  // whose value may lie in [lower, upper], both inclusive. Zone maps
+  // recorded when the property was written let the scan skip blocks whose
+  // bounds exclude the range, so selective scans (e.g. a one-day window
+  // over timestamps) read only a fraction of the column. The returned
+  // slices can contain non-qualifying rows; callers must still filter.
+  Result<std::vector<tsuba::PropertySlice>> ScanNodePropertyRange(
+      const std::string& property_name, double lower, double upper) const;
+
+  // Range scan over an edge property; see ScanNodePropertyRange.
+  Result<std::vector<tsuba::PropertySlice>> ScanEdgePropertyRange(
+      const std::string& property_name, double lower, double upper) const;
+
   // Returns the list of node indexes.
   const std::vector<std::unique_ptr<PropertyIndex<GraphTopology::Node>>>&
   node_indexes() const {
@@ -844,6 +1194,15 @@ CreateSymmetricGraph(PropertyGraph* pg);
 KATANA_EXPORT Result<std::unique_ptr<PropertyGraph>>
 CreateTransposeGraphTopology(const GraphTopology& topology);
 
+// Defined here rather than in GraphTopology.h because it needs the
+// complete PropertyGraph type; only instantiated on use.
+template <typename Topo>
+Result<std::shared_ptr<arrow::Array>>
+BasicPropGraphViewWrapper<Topo>::GetMaterializedEdgeProperty(
+    const std::string& name) const {
+  return property_graph().GetMaterializedEdgeProperty(&this->topo(), name);
+}
+
 }  // namespace katana
 
 #endif
@@ -0,0 +1,93 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHEDGEINSERTER_H_
+#define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHEDGEINSERTER_H_
+
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "katana/PerThreadStorage.h"
+#include "katana/PropertyGraph.h"
+
+namespace katana {
+
+/// Batched edge insertion for a loaded PropertyGraph.
+///
+/// A PropertyGraph's CSR topology cannot absorb individual edge inserts, so
+/// streaming pipelines have been rebuilding the whole graph from Arrow
+/// tables for every batch. This class stages inserts cheaply instead:
+/// InsertEdge appends to a per-thread buffer with no synchronization, Flush
+/// merges the staged edges into per-node overlay adjacency lists (the spill
+/// list structure LC_Morph_Graph uses for the same problem), and Compact
+/// folds the overlay into a fresh CSR graph when the overlay has grown
+/// large enough to be worth paying for.
+///
+/// Queries between compactions see the base CSR through the graph as usual
+/// and consult the overlay through degree / ForEachOverlayEdge. Compact
+/// only reads the managed graph, so it can run in the background (see
+/// CompactAsync) while readers continue on the current graph; the caller
+/// swaps the returned graph in when it is ready, typically under the
+/// snapshot scheme PropertyGraphRetractor provides.
+class KATANA_EXPORT PropertyGraphEdgeInserter {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+
+  explicit PropertyGraphEdgeInserter(PropertyGraph* pg)
+      : pg_(pg), overlay_(pg->num_nodes()) {}
+
+  /// Stage one edge for insertion. Thread safe against other InsertEdge
+  /// calls (each thread appends to its own buffer); both endpoints must be
+  /// existing nodes. Staged edges are not visible until Flush.
+  void InsertEdge(Node src, Node dest) {
+    KATANA_LOG_DEBUG_ASSERT(src < pg_->num_nodes());
+    KATANA_LOG_DEBUG_ASSERT(dest < pg_->num_nodes());
+    staged_.getLocal()->emplace_back(src, dest);
+  }
+
+  /// Merge every thread's staged edges into the per-node overlay lists.
+  /// Not thread safe with respect to InsertEdge or overlay queries.
+  Result<void> Flush();
+
+  /// Out-degree of \p node counting both the base CSR and the overlay
+  size_t degree(Node node) const {
+    return pg_->topology().edges(node).size() + overlay_[node].size();
+  }
+
+  /// Edges merged into the overlay and not yet compacted
+  uint64_t num_overlay_edges() const noexcept { return num_overlay_edges_; }
+
+  /// Visit the overlay destinations of \p node; base CSR edges are visited
+  /// through the graph as usual
+  template <typename F>
+  void ForEachOverlayEdge(Node node, F fn) const {
+    for (Node dest : overlay_[node]) {
+      fn(dest);
+    }
+  }
+
+  /// Build a new graph whose CSR merges the base topology with the overlay;
+  /// within each node the base edges come first, in their existing order,
+  /// followed by that node's overlay edges. Existing edge
+  /// property rows and entity types follow their edges to their new IDs;
+  /// inserted edges get null property rows and the unknown entity type.
+  /// The overlay is cleared on success.
+  Result<std::unique_ptr<PropertyGraph>> Compact();
+
+  /// Run Compact on another thread so readers of the current graph are not
+  /// stalled; the managed graph must not be mutated until the future is
+  /// consumed
+  std::future<Result<std::unique_ptr<PropertyGraph>>> CompactAsync() {
+    return std::async(std::launch::async, [this]() { return Compact(); });
+  }
+
+private:
+  PropertyGraph* pg_;
+  PerThreadStorage<std::vector<std::pair<Node, Node>>> staged_;
+  std::vector<std::vector<Node>> overlay_;
+  uint64_t num_overlay_edges_{0};
+};
+
+}  // namespace katana
+
+#endif
@@ -1,10 +1,72 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHRETRACTOR_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHRETRACTOR_H_
 
+#include <memory>
+#include <mutex>
+
 #include "katana/PropertyGraph.h"
 
 namespace katana {
 
+/// An immutable, consistent view of a PropertyGraph taken at a point in
+/// time. Readers hold the snapshot by shared_ptr and keep using it while a
+/// writer mutates the underlying graph; nothing a snapshot exposes changes
+/// after it is taken.
+///
+/// Snapshots are cheap: Arrow property tables are immutable, so the tables
+/// are shared with the graph and property mutations simply swap in new
+/// columns without disturbing older snapshots. The topology arrays are
+/// copied at most once per mutation epoch (see
+/// PropertyGraphRetractor::TakeSnapshot) and shared by every snapshot taken
+/// in that epoch.
+class KATANA_EXPORT PropertyGraphSnapshot {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+
+  const GraphTopology& topology() const noexcept { return *topology_; }
+
+  uint64_t num_nodes() const noexcept { return topology_->num_nodes(); }
+  uint64_t num_edges() const noexcept { return topology_->num_edges(); }
+
+  const std::shared_ptr<arrow::Table>& node_properties() const noexcept {
+    return node_properties_;
+  }
+  const std::shared_ptr<arrow::Table>& edge_properties() const noexcept {
+    return edge_properties_;
+  }
+
+  std::shared_ptr<arrow::ChunkedArray> GetNodeProperty(
+      const std::string& name) const {
+    return node_properties_->GetColumnByName(name);
+  }
+  std::shared_ptr<arrow::ChunkedArray> GetEdgeProperty(
+      const std::string& name) const {
+    return edge_properties_->GetColumnByName(name);
+  }
+
+  /// Topology epoch this snapshot was taken in; two snapshots with the same
+  /// version share the same topology arrays
+  uint64_t version() const noexcept { return version_; }
+
+private:
+  friend class PropertyGraphRetractor;
+
+  PropertyGraphSnapshot(
+      std::shared_ptr<const GraphTopology> topology,
+      std::shared_ptr<arrow::Table> node_properties,
+      std::shared_ptr<arrow::Table> edge_properties, uint64_t version)
+      : topology_(std::move(topology)),
+        node_properties_(std::move(node_properties)),
+        edge_properties_(std::move(edge_properties)),
+        version_(version) {}
+
+  std::shared_ptr<const GraphTopology> topology_;
+  std::shared_ptr<arrow::Table> node_properties_;
+  std::shared_ptr<arrow::Table> edge_properties_;
+  uint64_t version_;
+};
+
 /// A PropertyGraphRetractor provides a interfaces to some normally hidden
 /// parts of PropertyGraph; similar to the way a surgical retractor holds an
 /// incision open to provide access to normally hidden parts of our anatomy.
@@ -128,12 +190,33 @@ public:
   /// managed PropertyGraph
   Result<void> DropTopologies();
 
+  /// Return a consistent point-in-time view of the managed graph that stays
+  /// valid across subsequent mutations, so query threads need not quiesce
+  /// during an update window. Property tables are shared with the graph;
+  /// the topology is copied lazily, at most once per epoch of
+  /// InvalidateSnapshots calls. Safe to call from multiple reader threads
+  /// concurrently with each other, but not concurrently with graph mutation.
+  std::shared_ptr<const PropertyGraphSnapshot> TakeSnapshot();
+
+  /// Writers must call this after mutating the managed graph's topology (or
+  /// anything else snapshots expose outside the property tables); the next
+  /// TakeSnapshot then makes a fresh topology copy. Property-only mutations
+  /// do not require it because Arrow tables are copy-on-write already.
+  void InvalidateSnapshots();
+
   /// access the managed PropertyGraph
   PropertyGraph& property_graph() { return *pg_; }
   const PropertyGraph& property_graph() const { return *pg_; }
 
 private:
   std::unique_ptr<PropertyGraph> pg_;
+
+  // Snapshot bookkeeping: the cached topology copy is handed to every
+  // snapshot taken in the current epoch. The mutex guards only this cache,
+  // not graph mutation, which remains single-writer.
+  std::mutex snapshot_mutex_;
+  std::shared_ptr<const GraphTopology> snapshot_topology_;
+  uint64_t snapshot_version_{0};
 };
 
 }  // namespace katana
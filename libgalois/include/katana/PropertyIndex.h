@@ -1,47 +1,36 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYINDEX_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYINDEX_H_
 
-#include <set>
+#include <algorithm>
 #include <string>
-#include <variant>
+#include <string_view>
 
 #include <arrow/api.h>
 #include <arrow/array.h>
 #include <arrow/type_traits.h>
-#include <boost/iterator/iterator_categories.hpp>
-#include <boost/iterator/iterator_facade.hpp>
 
+#include "katana/ErrorCode.h"
+#include "katana/PODVector.h"
+#include "katana/Range.h"
 #include "katana/Result.h"
 #include "katana/config.h"
+#include "tsuba/FileView.h"
 
 namespace katana {
 
 // PropertyIndex provides an interface similar to an ordered container
-// over a single property.
+// over a single property. The index is a permutation of the node/edge ids
+// sorted by property value; iterating it yields ids in value order.
 template <typename node_or_edge>
 class KATANA_EXPORT PropertyIndex {
 public:
-  // Type-safe container for node and edge ids to avoid overlap with the
-  // primitive types we are indexing.
-  struct IndexID {
-    node_or_edge id;
-  };
-
-  // The set key type is either a node/edge id (all the keys in the actual set)
-  // or a value representing the search key.
-  using set_key_type = typename std::variant<
-      IndexID, bool, uint8_t, int64_t, double_t, std::string_view*>;
-
-  // PropertyIndex::iterator returns a sequence of node or edge ids.
-  using base_iterator = typename std::multiset<set_key_type>::iterator;
-  class iterator : public base_iterator {
-  public:
-    explicit iterator(const base_iterator& base) : base_iterator(base) {}
-    iterator() : base_iterator(0) {}
-    const node_or_edge& operator*() const {
-      return std::get<IndexID>(base_iterator::operator*()).id;
-    }
-  };
+  // The backing array is contiguous, so iteration over the indexed ids is
+  // iteration over a plain array of them.
+  using iterator = const node_or_edge*;
+
+  // A contiguous run of indexed ids, e.g. the result of a range scan. The
+  // ids are ordered by property value, not by id.
+  using id_range = StandardRange<iterator>;
 
   PropertyIndex(std::string column_name)
       : column_name_(std::move(column_name)) {}
@@ -56,14 +45,50 @@ public:
   // The name of the indexed property.
   std::string column_name() { return column_name_; }
 
-  virtual iterator begin() = 0;
-  virtual iterator end() = 0;
+  iterator begin() const {
+    return file_view_.Valid() ? file_view_.ptr<node_or_edge>() : ids_.data();
+  }
+  iterator end() const { return begin() + size(); }
+
+  // Number of indexed entities. Entities whose property value is null are
+  // not in the index.
+  size_t size() const {
+    return file_view_.Valid() ? file_view_.size() / sizeof(node_or_edge)
+                              : ids_.size();
+  }
 
   virtual Result<void> BuildFromProperty() = 0;
-  // virtual Result<void> BuildFromFile() = 0;
+
+  // Adopt a stored copy of this index (the id permutation written by
+  // RDG::Write*PropertyIndex) instead of rebuilding it from the property.
+  // The view's asynchronous read, issued when it was bound, is completed
+  // here; binding the view early overlaps the transfer with other load
+  // work, and adoption costs no rebuild.
+  Result<void> BuildFromStorage(
+      tsuba::FileView&& file_view, size_t num_entities) {
+    if (file_view.size() % sizeof(node_or_edge) != 0 ||
+        file_view.size() / sizeof(node_or_edge) > num_entities) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "stored index does not match the indexed entities");
+    }
+    KATANA_CHECKED(file_view.Resolve(0, file_view.size()));
+    file_view_ = std::move(file_view);
+    return ResultSuccess();
+  }
+
+protected:
+  // Entity ids, sorted by property value. Built in parallel by
+  // BuildFromProperty; ties between equal values leave id order
+  // unspecified. Unused while file_view_ is valid.
+  PODVector<node_or_edge> ids_;
 
 private:
   std::string column_name_;
+
+  // Storage-backed copy of the permutation; when valid it takes the place
+  // of ids_.
+  tsuba::FileView file_view_;
 };
 
 // PrimitivePropertyIndex provides a PropertyIndex for primitive types.
@@ -72,74 +97,56 @@ class KATANA_EXPORT PrimitivePropertyIndex
     : public PropertyIndex<node_or_edge> {
 public:
   using ArrowArrayType = typename arrow::CTypeTraits<c_type>::ArrayType;
-  using IndexID = typename PropertyIndex<node_or_edge>::IndexID;
   using iterator = typename PropertyIndex<node_or_edge>::iterator;
-  using set_key_type = typename PropertyIndex<node_or_edge>::set_key_type;
+  using id_range = typename PropertyIndex<node_or_edge>::id_range;
 
   PrimitivePropertyIndex(
       const std::string& column, size_t num_entities,
       std::shared_ptr<arrow::Array> property)
       : PropertyIndex<node_or_edge>(column),
         num_entities_(num_entities),
-        property_(std::static_pointer_cast<ArrowArrayType>(property)),
-        set_(PropertyCompare(property_)) {}
+        property_(std::static_pointer_cast<ArrowArrayType>(property)) {}
 
-  iterator begin() override { return iterator(set_.begin()); }
-  iterator end() override { return iterator(set_.end()); }
-
-  // Returns an iterator to the first element in the set with its property
-  // value equal to `key`. The STL does not seem to specify that
-  // multiset::find returns the first value, though it appears so in practice.
+  // Returns an iterator to the first element with its property value equal
+  // to `key`, or end() if there is none.
   iterator Find(c_type key) {
-    auto it = set_.lower_bound(key);
-    if (it == set_.end() ||
-        property_->Value(std::get<IndexID>(*it).id) != key) {
-      return end();
+    iterator it = LowerBound(key);
+    if (it == this->end() || property_->Value(*it) != key) {
+      return this->end();
     }
-    return iterator(it);
+    return it;
   }
 
-  // Returns an iterator to the first element in the set that is greater than or
+  // Returns an iterator to the first element whose value is greater than or
   // equal to `key`.
-  iterator LowerBound(c_type key) { return iterator(set_.lower_bound(key)); }
+  iterator LowerBound(c_type key) {
+    return std::lower_bound(
+        this->begin(), this->end(), key,
+        [&](node_or_edge id, c_type k) {
+          return std::less<c_type>{}(property_->Value(id), k);
+        });
+  }
 
-  // Returns an iterator to the first element in the set that is greater than
+  // Returns an iterator to the first element whose value is greater than
   // `key`.
-  iterator UpperBound(c_type key) { return iterator(set_.upper_bound(key)); }
-
-private:
-  class PropertyCompare {
-  public:
-    PropertyCompare(std::shared_ptr<ArrowArrayType> property)
-        : property_(std::move(property)) {}
-
-    bool operator()(const set_key_type& a, const set_key_type& b) const {
-      // Each operand is either a literal key_type or a node/edge.
-      c_type val_a = GetValue(a);
-      c_type val_b = GetValue(b);
-      // Compare the value of the indexed property for a and b using std::less.
-      return std::less<c_type>{}(val_a, val_b);
-    }
-
-  private:
-    c_type GetValue(const set_key_type& a) const {
-      if (std::holds_alternative<IndexID>(a)) {
-        node_or_edge id = std::get<IndexID>(a).id;
-        c_type val = property_->Value(id);
-        return val;
-      }
-      return std::get<c_type>(a);
-    }
+  iterator UpperBound(c_type key) {
+    return std::upper_bound(
+        this->begin(), this->end(), key,
+        [&](c_type k, node_or_edge id) {
+          return std::less<c_type>{}(k, property_->Value(id));
+        });
+  }
 
-    std::shared_ptr<ArrowArrayType> property_;
-  };
+  // Ids of all elements whose value lies in [lower, upper], both inclusive.
+  id_range Range(c_type lower, c_type upper) {
+    return MakeStandardRange(LowerBound(lower), UpperBound(upper));
+  }
 
+private:
   Result<void> BuildFromProperty() override;
-  // Result<void> BuildFromFile(...) override;
 
   size_t num_entities_;
   std::shared_ptr<ArrowArrayType> property_;
-  std::multiset<set_key_type, PropertyCompare> set_;
 };
 
 // StringPropertyIndex provides a PropertyIndex for strings.
@@ -148,82 +155,75 @@ class KATANA_EXPORT StringPropertyIndex : public PropertyIndex<node_or_edge> {
 public:
   using ArrowArrayType =
       typename arrow::TypeTraits<arrow::LargeStringType>::ArrayType;
-  using IndexID = typename PropertyIndex<node_or_edge>::IndexID;
   using iterator = typename PropertyIndex<node_or_edge>::iterator;
-  using set_key_type = typename PropertyIndex<node_or_edge>::set_key_type;
+  using id_range = typename PropertyIndex<node_or_edge>::id_range;
 
   StringPropertyIndex(
       const std::string& column_name, size_t num_entities,
       const std::shared_ptr<arrow::Array>& property)
       : PropertyIndex<node_or_edge>(column_name),
         num_entities_(num_entities),
-        property_(std::static_pointer_cast<arrow::LargeStringArray>(property)),
-        set_(StringCompare(property_)) {}
-
-  iterator begin() override { return iterator(set_.begin()); }
-  iterator end() override { return iterator(set_.end()); }
+        property_(std::static_pointer_cast<arrow::LargeStringArray>(property)) {
+  }
 
-  // Returns an iterator to the first element in the set with its property
-  // value equal to `key`. The STL does not appear to specify that
-  // multiset::find returns the first value, though it appears so in practice.
+  // Returns an iterator to the first element with its property value equal
+  // to `key`, or end() if there is none.
   iterator Find(std::string_view key) {
-    auto it = set_.lower_bound(&key);
-    if (it != set_.end()) {
-      arrow::util::string_view arrow_view =
-          property_->GetView(std::get<IndexID>(*it).id);
-      if (std::string_view(arrow_view.data(), arrow_view.length()) != key) {
-        return end();
-      }
+    iterator it = LowerBound(key);
+    if (it == this->end() || GetValue(*it) != key) {
+      return this->end();
     }
-    return iterator(it);
+    return it;
   }
 
-  // Returns an iterator to the first element in the set that is greater than or
+  // Returns an iterator to the first element whose value is greater than or
   // equal to `key`.
   iterator LowerBound(std::string_view key) {
-    return iterator(set_.lower_bound(&key));
+    return std::lower_bound(
+        this->begin(), this->end(), key,
+        [&](node_or_edge id, std::string_view k) {
+          return std::less<std::string_view>{}(GetValue(id), k);
+        });
   }
 
-  // Returns an iterator to the first element in the set that is greater than
+  // Returns an iterator to the first element whose value is greater than
   // `key`.
   iterator UpperBound(std::string_view key) {
-    return iterator(set_.upper_bound(&key));
+    return std::upper_bound(
+        this->begin(), this->end(), key,
+        [&](std::string_view k, node_or_edge id) {
+          return std::less<std::string_view>{}(k, GetValue(id));
+        });
   }
 
-private:
-  class StringCompare {
-  public:
-    StringCompare(std::shared_ptr<arrow::LargeStringArray> property)
-        : property_(std::move(property)) {}
-
-    bool operator()(const set_key_type& a, const set_key_type& b) const {
-      // Each operand is either a pointer to a string_view or a node/edge.
-      std::string_view val_a = GetValue(a);
-      std::string_view val_b = GetValue(b);
-      // Compare the value of the indexed property for a and b using std::less.
-      return std::less<std::string_view>{}(val_a, val_b);
-    }
-
-  private:
-    std::string_view GetValue(const set_key_type& a) const {
-      if (std::holds_alternative<IndexID>(a)) {
-        arrow::util::string_view arrow_view =
-            property_->GetView(std::get<IndexID>(a).id);
-        return std::string_view(arrow_view.data(), arrow_view.length());
-      }
-      return *std::get<std::string_view*>(a);
-    }
+  // Ids of all elements whose value lies in [lower, upper], both inclusive.
+  id_range Range(std::string_view lower, std::string_view upper) {
+    return MakeStandardRange(LowerBound(lower), UpperBound(upper));
+  }
 
-    std::shared_ptr<arrow::LargeStringArray> property_;
-  };
+private:
+  std::string_view GetValue(node_or_edge id) const {
+    arrow::util::string_view arrow_view = property_->GetView(id);
+    return std::string_view(arrow_view.data(), arrow_view.length());
+  }
 
   Result<void> BuildFromProperty() override;
-  // virtual Result<void> BuildFromFile(...) override;
 
   size_t num_entities_;
   std::shared_ptr<arrow::LargeStringArray> property_;
-  std::multiset<set_key_type, StringCompare> set_;
-};  // namespace katana
+};
+
+// Intersects the id sets of several index query results, e.g. range scans
+// over different properties of the same entities ("age in [30, 40] AND
+// region == X"), so selective multi-attribute filters can be answered from
+// the indexes instead of a full scan. Returns the surviving ids in
+// ascending id order. Chooses between sorting the candidate lists and
+// merging them (cheap for selective scans) and ANDing DynamicBitsets
+// (cheap for broad ones). Must not be called inside a parallel region.
+template <typename node_or_edge>
+std::vector<node_or_edge> IntersectIndexRanges(
+    const std::vector<StandardRange<const node_or_edge*>>& ranges,
+    size_t num_entities);
 
 // Create a PropertyIndex with the apropriate type for 'property'. Does not
 // build the index.
@@ -1,11 +1,29 @@
 #ifndef KATANA_LIBGALOIS_KATANA_PROPERTYVIEWS_H_
 #define KATANA_LIBGALOIS_KATANA_PROPERTYVIEWS_H_
 
+#include <typeinfo>
+
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
 
 namespace katana::internal {
 
+/// PropertyViewCacheKey names a bound property view tuple for
+/// PropertyGraph's typed view cache: the C++ property tuple type plus the
+/// ordered property names it is bound over
+template <typename PropTuple>
+std::string
+PropertyViewCacheKey(
+    const char* kind, const std::vector<std::string>& properties) {
+  std::string key = kind;
+  key += typeid(PropTuple).name();
+  for (const std::string& name : properties) {
+    key += '\0';
+    key += name;
+  }
+  return key;
+}
+
 /// ExtractArrays returns the array for each column of a table. It returns an
 /// error if there is more than one array for any column.
 KATANA_EXPORT Result<std::vector<arrow::Array*>> ExtractArrays(
@@ -61,8 +79,17 @@ template <typename PropTuple>
 static Result<katana::PropertyViewTuple<PropTuple>>
 MakeNodePropertyViews(
     const PropertyGraph* pg, const std::vector<std::string>& properties) {
-  return MakePropertyViews<PropTuple>(
-      pg->NodeReadOnlyPropertyView(), properties);
+  using Views = katana::PropertyViewTuple<PropTuple>;
+  // repeat bindings over unchanged tables are a hash lookup; the cache is
+  // invalidated whenever a property table changes
+  std::string key = PropertyViewCacheKey<PropTuple>("node", properties);
+  if (std::shared_ptr<void> entry = pg->FindPropertyViewCacheEntry(key)) {
+    return *std::static_pointer_cast<Views>(entry);
+  }
+  Views views = KATANA_CHECKED(
+      MakePropertyViews<PropTuple>(pg->NodeReadOnlyPropertyView(), properties));
+  pg->InsertPropertyViewCacheEntry(key, std::make_shared<Views>(views));
+  return views;
 }
 
 /// MakeNodePropertyViews asserts a typed view on top of runtime properties.
@@ -84,8 +111,15 @@ template <typename PropTuple>
 static Result<katana::PropertyViewTuple<PropTuple>>
 MakeEdgePropertyViews(
     const PropertyGraph* pg, const std::vector<std::string>& properties) {
-  return MakePropertyViews<PropTuple>(
-      pg->EdgeReadOnlyPropertyView(), properties);
+  using Views = katana::PropertyViewTuple<PropTuple>;
+  std::string key = PropertyViewCacheKey<PropTuple>("edge", properties);
+  if (std::shared_ptr<void> entry = pg->FindPropertyViewCacheEntry(key)) {
+    return *std::static_pointer_cast<Views>(entry);
+  }
+  Views views = KATANA_CHECKED(
+      MakePropertyViews<PropTuple>(pg->EdgeReadOnlyPropertyView(), properties));
+  pg->InsertPropertyViewCacheEntry(key, std::make_shared<Views>(views));
+  return views;
 }
 
 /// MakeEdgePropertyViews asserts a typed view on top of runtime properties.
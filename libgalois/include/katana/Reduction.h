@@ -109,6 +109,28 @@ public:
     return lhs;
   }
 
+  /**
+   * Returns the final reduction value like reduce(), but combines the
+   * per-thread values pairwise in a fixed thread-order tree rooted at thread
+   * 0 instead of folding them into the calling thread's value. For
+   * non-associative merge functions (notably floating-point addition) the
+   * result is therefore bit-identical across runs at a fixed thread count,
+   * regardless of which thread calls it, provided the per-thread partials
+   * themselves are deterministic (e.g. a do_all without katana::steal()).
+   * Only valid outside the parallel region.
+   */
+  T& reduceTree() {
+    for (unsigned int stride = 1; stride < data_.size(); stride *= 2) {
+      for (unsigned int i = 0; i + stride < data_.size(); i += 2 * stride) {
+        T& rhs = *data_.getRemote(i + stride);
+        merge(*data_.getRemote(i), std::move(rhs));
+        rhs = IDFunc::operator()();
+      }
+    }
+
+    return *data_.getRemote(0);
+  }
+
   void reset() {
     for (unsigned int i = 0; i < data_.size(); ++i) {
       *data_.getRemote(i) = IDFunc::operator()();
@@ -0,0 +1,84 @@
+#ifndef KATANA_LIBGALOIS_KATANA_SAMPLINGPROFILER_H_
+#define KATANA_LIBGALOIS_KATANA_SAMPLINGPROFILER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// SamplingProfiler is a low-overhead SIGPROF sampling profiler that
+/// attributes CPU samples to the enclosing katana loop (the loopname
+/// trait) rather than to symbols, so production binaries can answer
+/// "which loop is the time going to" without redeploying an instrumented
+/// build or attaching VTune.
+///
+/// The executors mark the loop each thread is running through LoopScope;
+/// the signal handler charges each sample to the marked loop in a
+/// lock-free counter table. This keeps the handler async-signal-safe --
+/// the symbolizing backtrace in libsupport's Backtrace.cpp cannot run
+/// inside a handler, which is why samples are keyed by loop name instead
+/// of by unwound stacks.
+///
+/// Sampling starts at init when the KATANA_SAMPLING_PROFILER environment
+/// variable is set (\see SharedMemSys) and can also be driven explicitly
+/// with Start/Stop. Stopping exports the samples as collapsed-stack
+/// flame-graph lines ("process;loop count") through the ProgressTracer.
+class KATANA_EXPORT SamplingProfiler {
+public:
+  static constexpr uint64_t kDefaultHz = 97;
+
+  static SamplingProfiler& Get();
+
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler(SamplingProfiler&&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+
+  /// Install the SIGPROF handler and arm the profiling timer to fire
+  /// \p samples_per_sec times per second of process CPU time.
+  Result<void> Start(uint64_t samples_per_sec = kDefaultHz);
+
+  /// Disarm the timer and export the collected samples through the
+  /// active ProgressTracer span.
+  Result<void> Stop();
+
+  /// Start at the default rate if KATANA_SAMPLING_PROFILER is set.
+  void StartIfRequested();
+
+  /// Stop and export if running; used at shutdown.
+  void StopIfRunning();
+
+  bool running() const { return running_; }
+
+  /// Render the samples collected so far in collapsed-stack format, one
+  /// "process;loop count" line per loop, ready for flamegraph.pl.
+  std::string GetCollapsedStacks() const;
+
+  /// LoopScope marks the calling thread as executing \p loopname for the
+  /// scope's lifetime; scopes nest, restoring the enclosing loop on exit.
+  class KATANA_EXPORT LoopScope {
+  public:
+    explicit LoopScope(const char* loopname);
+    ~LoopScope();
+
+    LoopScope(const LoopScope&) = delete;
+    LoopScope(LoopScope&&) = delete;
+    LoopScope& operator=(const LoopScope&) = delete;
+    LoopScope& operator=(LoopScope&&) = delete;
+
+  private:
+    const char* previous_;
+  };
+
+private:
+  SamplingProfiler() = default;
+
+  bool running_{false};
+};
+
+}  // namespace katana
+
+#endif
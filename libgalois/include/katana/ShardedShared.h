@@ -0,0 +1,146 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_SHARDEDSHARED_H_
+#define KATANA_LIBGALOIS_KATANA_SHARDEDSHARED_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "katana/CacheLineStorage.h"
+#include "katana/CompilerSpecific.h"
+#include "katana/Logging.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// ShardedShared hands one long-lived std::shared_ptr out to many threads
+/// without touching its reference count on the hot path.
+///
+/// Copying a shared_ptr from every thread serializes on a single atomic
+/// counter: the cache line holding the control block ping-pongs between
+/// cores. ShardedShared keeps a single owning shared_ptr and tracks
+/// borrowers with a per-thread counter instead; Acquire() bumps the
+/// acquiring thread's own cache line and returns a RAII Pin holding a raw
+/// pointer, so concurrent acquires from different threads never contend.
+///
+/// The trade-off is on the cold path: replacing the payload has to sum all
+/// of the per-thread counters and wait for them to drain. Reset() must
+/// therefore run at a quiescent point -- after the loops using the old
+/// payload have joined and before any new Acquire() -- which matches how
+/// long-lived handles like property columns are swapped in practice. Pins
+/// may be moved across threads; releases decrement the shard they were
+/// acquired against.
+template <typename T>
+class ShardedShared {
+public:
+  /// A non-owning borrow of the payload, released on destruction. Holding
+  /// a Pin keeps the owning ShardedShared from resetting or destroying the
+  /// payload; it does not keep the payload alive on its own.
+  class Pin {
+  public:
+    Pin() = default;
+    Pin(const Pin&) = delete;
+    Pin& operator=(const Pin&) = delete;
+    Pin(Pin&& other) noexcept
+        : obj_(std::exchange(other.obj_, nullptr)),
+          shard_(std::exchange(other.shard_, nullptr)) {}
+    Pin& operator=(Pin&& other) noexcept {
+      if (this != &other) {
+        Release();
+        obj_ = std::exchange(other.obj_, nullptr);
+        shard_ = std::exchange(other.shard_, nullptr);
+      }
+      return *this;
+    }
+    ~Pin() { Release(); }
+
+    T* get() const { return obj_; }
+    T& operator*() const { return *obj_; }
+    T* operator->() const { return obj_; }
+    explicit operator bool() const { return obj_ != nullptr; }
+
+  private:
+    friend class ShardedShared;
+    Pin(T* obj, std::atomic<int64_t>* shard) : obj_(obj), shard_(shard) {}
+
+    void Release() {
+      if (shard_ != nullptr) {
+        // release pairs with the acquire loads in Outstanding so writes to
+        // the payload made under the pin are visible after Reset returns
+        shard_->fetch_sub(1, std::memory_order_release);
+        shard_ = nullptr;
+        obj_ = nullptr;
+      }
+    }
+
+    T* obj_{};
+    std::atomic<int64_t>* shard_{};
+  };
+
+  ShardedShared() = default;
+  explicit ShardedShared(std::shared_ptr<T> owner)
+      : owner_(std::move(owner)) {}
+
+  ShardedShared(const ShardedShared&) = delete;
+  ShardedShared& operator=(const ShardedShared&) = delete;
+
+  ~ShardedShared() {
+    KATANA_LOG_DEBUG_VASSERT(
+        Outstanding() == 0, "destroying ShardedShared with live pins");
+  }
+
+  /// Borrow the payload. Contention-free: only the calling thread's shard
+  /// counter is touched.
+  Pin Acquire() const {
+    std::atomic<int64_t>& shard = pins_.getLocal()->get();
+    shard.fetch_add(1, std::memory_order_relaxed);
+    return Pin(owner_.get(), &shard);
+  }
+
+  T* get() const { return owner_.get(); }
+  const std::shared_ptr<T>& owner() const { return owner_; }
+
+  /// Replace the payload, spinning until outstanding pins drain. Must not
+  /// race with new Acquire calls; call it between loops, not inside one.
+  void Reset(std::shared_ptr<T> next = nullptr) {
+    while (Outstanding() != 0) {
+      asmPause();
+    }
+    owner_ = std::move(next);
+  }
+
+private:
+  int64_t Outstanding() const {
+    int64_t total = 0;
+    for (unsigned tid = 0; tid < pins_.size(); ++tid) {
+      total += pins_.getRemote(tid)->get().load(std::memory_order_acquire);
+    }
+    return total;
+  }
+
+  std::shared_ptr<T> owner_;
+  mutable PerThreadStorage<CacheLineStorage<std::atomic<int64_t>>> pins_;
+};
+
+}  // namespace katana
+
+#endif
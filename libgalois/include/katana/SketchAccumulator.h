@@ -0,0 +1,89 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_SKETCHACCUMULATOR_H_
+#define KATANA_LIBGALOIS_KATANA_SKETCHACCUMULATOR_H_
+
+#include <utility>
+
+#include "katana/Reduction.h"
+#include "katana/Sketch.h"
+
+namespace katana {
+
+//! merge functor for any sketch with a Merge member
+template <typename Sketch>
+struct sketch_merge {
+  Sketch& operator()(Sketch& lhs, Sketch&& rhs) const {
+    lhs.Merge(rhs);
+    return lhs;
+  }
+};
+
+//! identity functor that copies a prototype, so every per-thread sketch
+//! starts with the same shape
+template <typename Sketch>
+struct sketch_prototype {
+  Sketch prototype;
+  Sketch operator()() const { return prototype; }
+};
+
+/// Accumulator for a mergeable sketch (\ref HyperLogLog, \ref
+/// CountMinSketch, \ref ReservoirSample). Each thread updates its own
+/// sketch through Add inside a do_all and reduce() merges them, so
+/// approximate statistics over billions of edges run in the fixed memory
+/// of one sketch per thread:
+///
+/// \code
+/// katana::SketchAccumulator<katana::HyperLogLog> distinct;
+/// katana::do_all(katana::iterate(graph), [&](GNode n) {
+///   for (auto e : graph.edges(n)) {
+///     distinct.Add(attribute[*graph.GetEdgeDest(e)]);
+///   }
+/// });
+/// double estimate = distinct.reduce().Estimate();
+/// \endcode
+template <typename Sketch>
+class SketchAccumulator
+    : public Reducible<Sketch, sketch_merge<Sketch>, sketch_prototype<Sketch>> {
+  using base_type =
+      Reducible<Sketch, sketch_merge<Sketch>, sketch_prototype<Sketch>>;
+
+public:
+  SketchAccumulator()
+      : base_type(sketch_merge<Sketch>(), sketch_prototype<Sketch>{Sketch()}) {
+  }
+
+  /// Size the per-thread sketches from a prototype, e.g.
+  /// SketchAccumulator<HyperLogLog>(HyperLogLog(16))
+  explicit SketchAccumulator(Sketch prototype)
+      : base_type(
+            sketch_merge<Sketch>(),
+            sketch_prototype<Sketch>{std::move(prototype)}) {}
+
+  /// Update the calling thread's sketch
+  template <typename... Args>
+  void Add(Args&&... args) {
+    this->getLocal().Add(std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace katana
+
+#endif
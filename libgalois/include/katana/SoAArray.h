@@ -0,0 +1,216 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_SOAARRAY_H_
+#define KATANA_LIBGALOIS_KATANA_SOAARRAY_H_
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "katana/NUMAArray.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/**
+ * A struct-of-arrays counterpart to NUMAArray<Struct>. Each field in the
+ * parameter pack is stored in its own NUMAArray, so loops that touch only a
+ * subset of the fields (the common case in pull-style kernels) stream each
+ * field contiguously instead of striding over whole structs, which keeps
+ * cache lines dense and lets the compiler vectorize.
+ *
+ * The indexed interface mirrors NUMAArray: operator[] returns a tuple of
+ * references to element i of every field array, and set() assigns a whole
+ * element at once. Use field<I>() to get at an individual field array for
+ * do_all loops over a single field:
+ *
+ * \code
+ * katana::SoAArray<uint32_t, uint32_t, bool> node_data;  // dist, parent, flag
+ * node_data.allocateInterleaved(num_nodes);
+ * node_data.construct();
+ * katana::do_all(
+ *     katana::iterate(node_data.field<0>()), [&](uint32_t& dist) { ... });
+ * \endcode
+ *
+ * Like NUMAArray, the allocation cannot grow, allocations and deallocations
+ * must occur on the main thread, and elements are uninitialized until
+ * construct() is called.
+ */
+template <typename... Fields>
+class SoAArray {
+  static_assert(sizeof...(Fields) > 0, "SoAArray requires at least one field");
+
+  using Indices = std::index_sequence_for<Fields...>;
+
+  std::tuple<NUMAArray<Fields>...> arrays_;
+
+  template <size_t... Is>
+  std::tuple<Fields&...> GetImpl(size_t x, std::index_sequence<Is...>) {
+    return std::tie(std::get<Is>(arrays_)[x]...);
+  }
+
+  template <size_t... Is>
+  std::tuple<const Fields&...> GetImpl(
+      size_t x, std::index_sequence<Is...>) const {
+    return std::tie(std::get<Is>(arrays_)[x]...);
+  }
+
+  template <typename F, size_t... Is>
+  void ForEachArray(F&& f, std::index_sequence<Is...>) {
+    (f(std::get<Is>(arrays_)), ...);
+  }
+
+public:
+  typedef std::tuple<Fields...> value_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef std::tuple<Fields&...> reference;
+  typedef std::tuple<const Fields&...> const_reference;
+
+  //! Type of field I
+  template <size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  SoAArray() = default;
+
+  SoAArray(SoAArray&&) noexcept = default;
+  SoAArray& operator=(SoAArray&&) = default;
+
+  SoAArray(const SoAArray&) = delete;
+  SoAArray& operator=(const SoAArray&) = delete;
+
+  const_reference at(difference_type x) const { return GetImpl(x, Indices{}); }
+  reference at(difference_type x) { return GetImpl(x, Indices{}); }
+  const_reference operator[](size_type x) const {
+    return GetImpl(x, Indices{});
+  }
+  reference operator[](size_type x) { return GetImpl(x, Indices{}); }
+  void set(difference_type x, const value_type& v) {
+    operator[](x) = v;
+  }
+  size_type size() const { return std::get<0>(arrays_).size(); }
+  bool empty() const { return size() == 0; }
+
+  //! The array backing field I; iterable, so it can be handed to
+  //! katana::iterate directly.
+  template <size_t I>
+  NUMAArray<field_type<I>>& field() {
+    return std::get<I>(arrays_);
+  }
+
+  template <size_t I>
+  const NUMAArray<field_type<I>>& field() const {
+    return std::get<I>(arrays_);
+  }
+
+  //! Contiguous storage of field I
+  template <size_t I>
+  field_type<I>* data() {
+    return std::get<I>(arrays_).data();
+  }
+
+  template <size_t I>
+  const field_type<I>* data() const {
+    return std::get<I>(arrays_).data();
+  }
+
+  //! [allocatefunctions]
+  //! Allocates each field array interleaved across NUMA (memory) nodes.
+  void allocateInterleaved(size_type n) {
+    ForEachArray([n](auto& a) { a.allocateInterleaved(n); }, Indices{});
+  }
+
+  /**
+   * Allocates each field array using blocked memory policy
+   *
+   * @param  n         number of elements to allocate
+   */
+  void allocateBlocked(size_type n) {
+    ForEachArray([n](auto& a) { a.allocateBlocked(n); }, Indices{});
+  }
+
+  /**
+   * Allocates each field array using Thread Local memory policy
+   *
+   * @param  n         number of elements to allocate
+   */
+  void allocateLocal(size_type n) {
+    ForEachArray([n](auto& a) { a.allocateLocal(n); }, Indices{});
+  }
+
+  /**
+   * Allocates each field array using no memory policy (no pre alloc)
+   *
+   * @param  n         number of elements to allocate
+   */
+  void allocateFloating(size_type n) {
+    ForEachArray([n](auto& a) { a.allocateFloating(n); }, Indices{});
+  }
+  //! [allocatefunctions]
+
+  //! Default-constructs every element of every field array
+  void construct() {
+    ForEachArray([](auto& a) { a.construct(); }, Indices{});
+  }
+
+  //! Constructs every element from the corresponding field of the given value
+  void construct(const value_type& v) {
+    ConstructImpl(v, Indices{});
+  }
+
+  //! Constructs element n from the corresponding fields of the given value
+  void constructAt(size_type n, const value_type& v) {
+    ConstructAtImpl(n, v, Indices{});
+  }
+
+  //! Allocate and construct
+  void create(size_type n) {
+    allocateInterleaved(n);
+    construct();
+  }
+
+  void create(size_type n, const value_type& v) {
+    allocateInterleaved(n);
+    construct(v);
+  }
+
+  void deallocate() {
+    ForEachArray([](auto& a) { a.deallocate(); }, Indices{});
+  }
+
+  void destroy() {
+    ForEachArray([](auto& a) { a.destroy(); }, Indices{});
+  }
+
+private:
+  template <size_t... Is>
+  void ConstructImpl(const value_type& v, std::index_sequence<Is...>) {
+    (std::get<Is>(arrays_).construct(std::get<Is>(v)), ...);
+  }
+
+  template <size_t... Is>
+  void ConstructAtImpl(
+      size_type n, const value_type& v, std::index_sequence<Is...>) {
+    (std::get<Is>(arrays_).constructAt(n, std::get<Is>(v)), ...);
+  }
+};
+
+}  // namespace katana
+#endif
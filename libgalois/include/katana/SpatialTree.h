@@ -25,7 +25,8 @@
 namespace katana {
 
 //! Stores sets of objects at specific spatial coordinates in a quad tree.
-//! Lookup returns an approximation of the closest item
+//! Lookup returns an approximation of the closest item. For read-mostly
+//! workloads built in bulk, prefer \ref PackedSpatialTree2d.
 template <typename T>
 class SpatialTree2d {
   struct Box2d {
@@ -0,0 +1,171 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#ifndef KATANA_LIBGALOIS_KATANA_TASKGRAPH_H_
+#define KATANA_LIBGALOIS_KATANA_TASKGRAPH_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "katana/CompilerSpecific.h"
+#include "katana/Logging.h"
+#include "katana/SimpleLock.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
+
+namespace katana {
+
+/// Executes a graph of dependent tasks over the ThreadPool with a single
+/// fork-join instead of one per stage.
+///
+/// do_all, for_each, and on_each are bulk-synchronous: every loop pays a
+/// full ThreadPool wakeup and barrier. Multi-stage pipelines whose stages
+/// are short — or only partially dependent on each other — lose a large
+/// fraction of their runtime to those per-loop barriers. A TaskGraph lets
+/// such pipelines declare the dependencies explicitly; independent tasks
+/// run concurrently and a task starts as soon as its last predecessor
+/// finishes, with no global barrier in between.
+///
+/// Tasks must not invoke parallel loops themselves: the ThreadPool is
+/// occupied running the graph, and nested fork-join is not supported. For
+/// parallelism within a stage, split the stage into several tasks over
+/// disjoint parts of the data.
+///
+/// A running task may add new tasks (continuations); dependencies may only
+/// name previously created tasks. Run() returns when every task, including
+/// ones added during execution, has finished. The executor may be reused:
+/// tasks added after Run() returns form a new graph for the next Run().
+///
+/// Typical use:
+///
+/// \code
+/// katana::TaskGraph graph;
+/// auto a = graph.AddTask([&] { ... });
+/// auto b = graph.AddTask([&] { ... });          // independent of a
+/// auto c = graph.AddTask([&] { ... }, {a, b});  // runs after both
+/// graph.Run();
+/// \endcode
+class TaskGraph {
+public:
+  using TaskHandle = size_t;
+
+  TaskGraph() = default;
+
+  TaskGraph(const TaskGraph&) = delete;
+  TaskGraph& operator=(const TaskGraph&) = delete;
+
+  /// Adds a task with no predecessors.
+  TaskHandle AddTask(std::function<void()> fn) {
+    return AddTask(std::move(fn), {});
+  }
+
+  /// Adds a task that runs only after all tasks in \p deps have finished.
+  /// Safe to call from inside a running task.
+  TaskHandle AddTask(
+      std::function<void()> fn, const std::vector<TaskHandle>& deps) {
+    MutexGuard guard(mutex_);
+
+    const TaskHandle handle = tasks_.size();
+    tasks_.emplace_back();
+    Task& task = tasks_.back();
+    task.fn = std::move(fn);
+
+    for (TaskHandle dep : deps) {
+      KATANA_LOG_DEBUG_ASSERT(dep < handle);
+      if (!tasks_[dep].done) {
+        tasks_[dep].successors.push_back(handle);
+        ++task.unfinished_deps;
+      }
+    }
+
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    if (task.unfinished_deps == 0) {
+      ready_.push_back(handle);
+    }
+    return handle;
+  }
+
+  /// Runs all pending tasks to completion on the active threads. Blocks
+  /// until the graph, including tasks added during execution, is drained.
+  void Run() {
+    unsigned num_threads = katana::getActiveThreads();
+    GetThreadPool().run(num_threads, [this]() { workerLoop(); });
+  }
+
+private:
+  struct Task {
+    std::function<void()> fn;
+    std::vector<TaskHandle> successors;
+    unsigned unfinished_deps{0};
+    bool done{false};
+  };
+
+  using Mutex = katana::SimpleLock;
+  using MutexGuard = std::lock_guard<Mutex>;
+
+  void workerLoop() {
+    while (true) {
+      Task* task = nullptr;
+      {
+        MutexGuard guard(mutex_);
+        if (!ready_.empty()) {
+          // Pointers into tasks_ stay valid across concurrent AddTask
+          // calls because std::deque never relocates elements.
+          task = &tasks_[ready_.front()];
+          ready_.pop_front();
+        }
+      }
+
+      if (!task) {
+        if (outstanding_.load(std::memory_order_acquire) == 0) {
+          break;
+        }
+        asmPause();
+        continue;
+      }
+
+      task->fn();
+
+      {
+        MutexGuard guard(mutex_);
+        task->done = true;
+        for (TaskHandle succ : task->successors) {
+          if (--tasks_[succ].unfinished_deps == 0) {
+            ready_.push_back(succ);
+          }
+        }
+      }
+      outstanding_.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  // Serializes graph mutation; tasks should be coarse enough that this is
+  // not a bottleneck.
+  Mutex mutex_;
+  std::deque<Task> tasks_;
+  std::deque<TaskHandle> ready_;
+  std::atomic<size_t> outstanding_{0};
+};
+
+}  // end namespace katana
+
+#endif
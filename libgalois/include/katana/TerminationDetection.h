@@ -37,6 +37,15 @@ class TerminationDetection;
 KATANA_EXPORT TerminationDetection& GetTerminationDetection(
     unsigned active_threads);
 
+/*
+ * Returns the flat phase-based termination detection instance, which detects
+ * quiescence in two flat confirmation phases instead of two token
+ * circulations; lower latency for loops with many tiny rounds. The instance
+ * will be reused, but reinitialized to activeThreads.
+ */
+KATANA_EXPORT TerminationDetection& GetFlatTerminationDetection(
+    unsigned active_threads);
+
 /// Termination detection is the process of determining whether multiple
 /// threads can safely stop executing because no worker has done any
 /// work.
@@ -110,6 +119,7 @@ public:
 
 namespace internal {
 void SetTerminationDetection(TerminationDetection* term);
+void SetFlatTerminationDetection(TerminationDetection* term);
 }  // end namespace internal
 
 }  // end namespace katana
@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <cstdlib>
 #include <functional>
@@ -65,17 +66,29 @@ protected:
 
   //! Per-thread mailboxes for notification
   struct per_signal {
+    //! In fastmode, spin this long before decaying to a blocking wait so an
+    //! idle warm pool does not burn cycles forever
+    constexpr static unsigned kFastmodeSpins = 1 << 20;
+
     std::condition_variable cv;
     std::mutex m;
     unsigned wbegin, wend;
     std::atomic<int> done;
     std::atomic<int> fastRelease;
+    std::atomic<int> sleeping;
     ThreadTopoInfo topo;
 
     void wakeup(bool fastmode) {
       if (fastmode) {
         done = 0;
         fastRelease = 1;
+        // pair of seq_cst accesses (fastRelease store, sleeping load)
+        // against the reverse pair in wait; either we see the sleeper and
+        // notify, or the sleeper sees fastRelease and does not block
+        if (sleeping.load()) {
+          std::lock_guard<std::mutex> lg(m);
+          cv.notify_one();
+        }
       } else {
         std::lock_guard<std::mutex> lg(m);
         done = 0;
@@ -86,9 +99,18 @@ protected:
 
     void wait(bool fastmode) {
       if (fastmode) {
-        while (!fastRelease.load(std::memory_order_relaxed)) {
+        for (unsigned spins = 0; spins < kFastmodeSpins; ++spins) {
+          if (fastRelease.load(std::memory_order_relaxed)) {
+            fastRelease = 0;
+            return;
+          }
           asmPause();
         }
+        // decay to blocking; wakeup notices sleeping and notifies
+        std::unique_lock<std::mutex> lg(m);
+        sleeping = 1;
+        cv.wait(lg, [=] { return fastRelease.load() != 0; });
+        sleeping = 0;
         fastRelease = 0;
       } else {
         std::unique_lock<std::mutex> lg(m);
@@ -106,6 +128,13 @@ protected:
   unsigned reserved;
   unsigned masterFastmode;
   bool running;
+  // auto-warm mode (KATANA_WARM_POOL): switch to fastmode when loops arrive
+  // within warmGapMicros of each other; idle fastmode threads decay to
+  // blocking on their own via the bounded spin in per_signal::wait
+  bool autoWarm;
+  bool warming;
+  long warmGapMicros;
+  std::chrono::steady_clock::time_point lastRunEnd;
   std::function<void(void)> work;
 
   //! destroy all threads
@@ -117,6 +146,9 @@ protected:
   //! main thread loop
   void threadLoop(unsigned tid);
 
+  //! enter fastmode for this run if loops are arriving quickly
+  void autoWarmPool(unsigned num);
+
   //! spin up for run
   void cascade(bool fastmode);
 
@@ -152,6 +184,9 @@ public:
       }
       ExecuteTuple(Args&&... args) : cmds(std::forward<Args>(args)...) {}
     };
+    // must happen before work is set: warming up runs its own work through
+    // the pool
+    autoWarmPool(num);
     // paying for an indirection in work allows small-object optimization in
     // std::function to kick in and avoid a heap allocation
     ExecuteTuple lwork(std::forward<Args>(args)...);
@@ -192,6 +227,7 @@ public:
     return signals[tid]->topo.socketLeader == tid;
   }
   unsigned getSocket(unsigned tid) const { return signals[tid]->topo.socket; }
+  unsigned getCore(unsigned tid) const { return signals[tid]->topo.core; }
   unsigned getLeader(unsigned tid) const {
     return signals[tid]->topo.socketLeader;
   }
@@ -201,15 +237,20 @@ public:
   unsigned getNumaNode(unsigned tid) const {
     return signals[tid]->topo.numaNode;
   }
+  unsigned getOsNumaNode(unsigned tid) const {
+    return signals[tid]->topo.osNumaNode;
+  }
 
   static unsigned getTID() { return my_box.topo.tid; }
   static bool isLeader() { return my_box.topo.tid == my_box.topo.socketLeader; }
   static unsigned getLeader() { return my_box.topo.socketLeader; }
   static unsigned getSocket() { return my_box.topo.socket; }
+  static unsigned getCore() { return my_box.topo.core; }
   static unsigned getCumulativeMaxSocket() {
     return my_box.topo.cumulativeMaxSocket;
   }
   static unsigned getNumaNode() { return my_box.topo.numaNode; }
+  static unsigned getOsNumaNode() { return my_box.topo.osNumaNode; }
 };
 
 /**
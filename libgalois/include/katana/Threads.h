@@ -20,6 +20,9 @@
 #ifndef KATANA_LIBGALOIS_KATANA_THREADS_H_
 #define KATANA_LIBGALOIS_KATANA_THREADS_H_
 
+#include <string>
+#include <vector>
+
 #include "katana/config.h"
 
 namespace katana {
@@ -37,5 +40,51 @@ KATANA_EXPORT unsigned int setActiveThreads(unsigned int num) noexcept;
  */
 KATANA_EXPORT unsigned int getActiveThreads() noexcept;
 
+/**
+ * How worker threads are mapped onto hardware contexts, parsed from a
+ * pinning profile spec (see setThreadPinningProfile).
+ */
+struct KATANA_EXPORT ThreadPinningProfile {
+  enum class Order {
+    kDefault,  // real cores across sockets first, then SMT contexts
+    kCompact,  // fill one core (and its SMT contexts) before the next
+    kScatter,  // round robin across sockets
+  };
+
+  Order order = Order::kDefault;
+  // sockets threads may be pinned to; empty means every socket
+  std::vector<unsigned> sockets;
+  // drop the efficiency cores of a hybrid (P/E) part
+  bool excludeEfficiencyCores = false;
+  // OS NUMA node each worker prefers to allocate from, e.g. a flat-mode
+  // HBM node; -1 leaves the default policy
+  int preferredNumaNode = -1;
+};
+
+/**
+ * Selects a thread pinning profile. The spec is a comma-separated list of
+ * tokens: "compact", "scatter", "sockets=<id>[+<id>...]", "no-e-cores" and
+ * "hbm-node=<os node id>". The profile is applied when the hardware
+ * topology is first computed, so this must be called before the thread pool
+ * starts (in practice, before constructing SharedMemSys); the
+ * KATANA_THREAD_PINNING environment variable sets the same spec without a
+ * code change. Returns false if the thread pool has already started.
+ */
+KATANA_EXPORT bool setThreadPinningProfile(const std::string& spec) noexcept;
+
+/**
+ * Returns the pinning profile in effect, parsing the spec (or the
+ * KATANA_THREAD_PINNING environment variable) on first use.
+ */
+KATANA_EXPORT const ThreadPinningProfile& getThreadPinningProfile() noexcept;
+
+namespace internal {
+
+// reports the pinning profile and the resulting thread-to-context mapping
+// through the StatManager; called once the system StatManager exists
+KATANA_EXPORT void reportThreadPinning();
+
+}  // end namespace internal
+
 }  // namespace katana
 #endif
@@ -219,6 +219,21 @@ struct loopname : public trait_has_value<const char*>, loopname_tag {
 struct steal_tag {};
 struct steal : public trait_has_type<bool>, steal_tag {};
 
+/**
+ * Victim-selection order for work-stealing {@link do_all()} loops; only
+ * meaningful together with {@link steal}. kHierarchical prefers SMT
+ * siblings on the same core, then threads on the same socket, then remote
+ * sockets, which keeps steals inside shared caches on multi-socket
+ * machines. kFlat scans all threads in thread-id order.
+ */
+enum class StealPolicy { kHierarchical, kFlat };
+
+struct steal_policy_tag {};
+struct steal_policy : public trait_has_value<StealPolicy>, steal_policy_tag {
+  steal_policy(StealPolicy p = StealPolicy::kHierarchical)
+      : trait_has_value<StealPolicy>(p) {}
+};
+
 /**
  * Indicates worklist to use. Optional argument to {@link for_each()} loops.
  */
@@ -254,6 +269,15 @@ struct no_pushes : public trait_has_type<bool>, no_pushes_tag {};
 struct per_iter_alloc_tag {};
 struct per_iter_alloc : public trait_has_type<bool>, per_iter_alloc_tag {};
 
+/**
+ * Indicates the operator may request access to a per-round allocator: a bump
+ * arena that lives across iterations and is rewound in O(1) when the loop
+ * reaches a round boundary (global quiescence with more work pending).
+ * Memory obtained from it must not be referenced across rounds.
+ */
+struct per_round_alloc_tag {};
+struct per_round_alloc : public trait_has_type<bool>, per_round_alloc_tag {};
+
 /**
  * Indicates the operator doesn't need its execution stats recorded
  */
@@ -274,6 +298,15 @@ struct disable_conflict_detection_tag {};
 struct disable_conflict_detection : public trait_has_type<bool>,
                                     disable_conflict_detection_tag {};
 
+/**
+ * Indicates {@link for_each()} should use flat phase-based termination
+ * detection instead of the default token ring: quiescence is confirmed by
+ * flat scans of per-thread counters rather than token circulations, which
+ * lowers the per-round latency of loops with many tiny rounds.
+ */
+struct flat_termination_tag {};
+struct flat_termination : public trait_has_type<bool>, flat_termination_tag {};
+
 /**
  * Indicates that the neighborhood set does not change through out i.e. is not
  * dependent on computed values. Examples of such fixed neighborhood is e.g.
@@ -382,6 +415,33 @@ public:
   chunk_size(unsigned cs = SZ) : trait_has_value(clamp(cs)) {}
 };
 
+/**
+ * Indicates work-stealing {@link do_all()} loops should size chunks
+ * adaptively instead of using a fixed {@link chunk_size}: a thread grabs a
+ * fixed fraction of its remaining share of the range, so chunks start large
+ * and shrink geometrically as the range drains (guided schedule). Useful for
+ * power-law inputs where no single chunk size fits. A {@link chunk_size}
+ * argument, if also given, acts as the lower bound on the chunk size. Only
+ * meaningful together with {@link steal}.
+ */
+struct adaptive_chunk_size_tag {};
+struct adaptive_chunk_size : public trait_has_type<bool>,
+                             adaptive_chunk_size_tag {};
+
+struct fibers_tag {};
+
+/**
+ * Indicates that {@link for_each()} should multiplex N fiber instances of
+ * the loop operator on each thread (see {@link FiberGroup}), so an operator
+ * about to chase a pointer can prefetch the target and yield with {@link
+ * FiberPrefetchAndYield} while the line is fetched. Only honored by loops
+ * that also use {@link disable_conflict_detection} and do not use {@link
+ * per_iter_alloc}, since those keep per-invocation state that cannot be
+ * shared between interleaved fibers; it is ignored otherwise.
+ */
+template <unsigned N = 8>
+struct fibers : public trait_has_svalue<unsigned, N>, fibers_tag {};
+
 typedef PerSocketChunkFIFO<chunk_size<>::value> defaultWL;
 
 namespace internal {
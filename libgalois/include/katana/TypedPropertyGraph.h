@@ -51,6 +51,7 @@ public:
   using edge_iterator = GraphTopology::edge_iterator;
   using edges_range = GraphTopology::edges_range;
   using iterator = GraphTopology::iterator;
+  using local_iterator = GraphTopology::local_iterator;
   using Node = GraphTopology::Node;
   using Edge = GraphTopology::Edge;
 
@@ -60,6 +61,10 @@ public:
 
   node_iterator end() const { return pg_->end(); }
 
+  node_iterator local_begin() const { return pg_->local_begin(); }
+
+  node_iterator local_end() const { return pg_->local_end(); }
+
   size_t size() const { return pg_->size(); }
 
   bool empty() const { return pg_->empty(); }
@@ -99,6 +104,44 @@ public:
     return GetData<NodeIndex>(*node);
   }
 
+  /**
+   * Gets the values of a POD node property as a flat restrict-qualified
+   * span indexed by node id.
+   *
+   * Capture the span once outside a hot loop instead of calling GetData per
+   * element; the non-aliasing base pointer lets the compiler keep it in a
+   * register and vectorize. Bounds are checked in debug builds only.
+   */
+  template <typename NodeIndex>
+  auto GetDataSpan() {
+    constexpr size_t prop_col_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_col_index>(node_view_).span();
+  }
+
+  template <typename NodeIndex>
+  auto GetDataSpan() const {
+    constexpr size_t prop_col_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_col_index>(node_view_).span();
+  }
+
+  /**
+   * Gets the values of a POD edge property as a flat restrict-qualified
+   * span indexed by edge id.
+   *
+   * \see GetDataSpan
+   */
+  template <typename EdgeIndex>
+  auto GetEdgeDataSpan() {
+    constexpr size_t prop_col_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_col_index>(edge_view_).span();
+  }
+
+  template <typename EdgeIndex>
+  auto GetEdgeDataSpan() const {
+    constexpr size_t prop_col_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_col_index>(edge_view_).span();
+  }
+
   /**
    * Gets the edge data.
    *
@@ -181,6 +224,8 @@ public:
    */
   const PropertyGraph& GetPropertyGraph() const { return *pg_; }
 
+  PropertyGraph& GetPropertyGraph() { return *pg_; }
+
   // Graph constructors
   static Result<TypedPropertyGraph<NodeProps, EdgeProps>> Make(
       PropertyGraph* pg, const std::vector<std::string>& node_properties,
@@ -239,6 +284,27 @@ public:
         .GetValue(PGView::node_property_index(node));
   }
 
+  /**
+   * Gets the values of a POD node property as a flat restrict-qualified
+   * span. Unlike GetData, the span is indexed by property index
+   * (\see node_property_index), not by view-local node id.
+   */
+  template <typename NodeIndex>
+  auto GetDataSpan() const {
+    constexpr size_t prop_col_index = find_trait<NodeIndex, NodeProps>();
+    return std::get<prop_col_index>(node_view_).span();
+  }
+
+  /**
+   * Gets the values of a POD edge property as a flat restrict-qualified
+   * span indexed by property index (\see edge_property_index).
+   */
+  template <typename EdgeIndex>
+  auto GetEdgeDataSpan() const {
+    constexpr size_t prop_col_index = find_trait<EdgeIndex, EdgeProps>();
+    return std::get<prop_col_index>(edge_view_).span();
+  }
+
   /**
    * Gets the edge data.
    *
@@ -295,6 +361,12 @@ Result<TypedPropertyGraph<NodeProps, EdgeProps>>
 TypedPropertyGraph<NodeProps, EdgeProps>::Make(
     PropertyGraph* pg, const std::vector<std::string>& node_properties,
     const std::vector<std::string>& edge_properties) {
+  // typed views need single-chunk columns; compact any that are not
+  if (auto res = pg->ConsolidateProperties(node_properties, edge_properties);
+      !res) {
+    return res.error();
+  }
+
   auto node_view_result =
       internal::MakeNodePropertyViews<NodeProps>(pg, node_properties);
   if (!node_view_result) {
@@ -327,6 +399,12 @@ TypedPropertyGraphView<PGView, NodeProps, EdgeProps>::Make(
     const std::vector<std::string>& edge_properties) {
   auto pg_view = pg->BuildView<PGView>();
   KATANA_LOG_DEBUG_ASSERT(pg);
+  // typed views need single-chunk columns; compact any that are not
+  if (auto res = pg->ConsolidateProperties(node_properties, edge_properties);
+      !res) {
+    return res.error();
+  }
+
   auto node_view_result =
       internal::MakeNodePropertyViews<NodeProps>(pg, node_properties);
   if (!node_view_result) {
@@ -45,6 +45,8 @@ protected:
   //! Allocator stuff
   IterAllocBaseTy IterationAllocatorBase;
   PerIterAllocTy PerIterationAllocator;
+  RoundAllocBaseTy RoundAllocatorBase;
+  PerRoundAllocTy PerRoundAllocator;
 
   //! used by all
   bool* didBreak = nullptr;
@@ -56,6 +58,8 @@ protected:
 
   void __resetAlloc() { IterationAllocatorBase.clear(); }
 
+  void __rewindRoundAlloc() { RoundAllocatorBase.rewind(); }
+
   void __setFirstPass(void) { firstPassFlag = true; }
 
   void __resetFirstPass(void) { firstPassFlag = false; }
@@ -72,6 +76,8 @@ public:
   UserContext()
       : IterationAllocatorBase(),
         PerIterationAllocator(&IterationAllocatorBase),
+        RoundAllocatorBase(),
+        PerRoundAllocator(&RoundAllocatorBase),
         didBreak(0) {}
 
   //! Signal break in parallel loop, current iteration continues
@@ -81,6 +87,12 @@ public:
   //! Acquire a per-iteration allocator
   PerIterAllocTy& getPerIterAlloc() { return PerIterationAllocator; }
 
+  //! Acquire the per-round allocator: an arena that survives across
+  //! iterations and is rewound in O(1) at round boundaries, so per-round
+  //! temporaries stay out of malloc/free. Requires the per_round_alloc
+  //! trait; memory must not be referenced across rounds.
+  PerRoundAllocTy& getPerRoundAlloc() { return PerRoundAllocator; }
+
   //! Push new work
   template <typename... Args>
   void push(Args&&... args) {
@@ -34,6 +34,7 @@ public:
   typedef typename SuperTy::FastPushBack FastPushBack;
 
   void resetAlloc() { SuperTy::__resetAlloc(); }
+  void rewindRoundAlloc() { SuperTy::__rewindRoundAlloc(); }
   PushBufferTy& getPushBuffer() { return SuperTy::__getPushBuffer(); }
   void resetPushBuffer() { SuperTy::__resetPushBuffer(); }
   SuperTy& data() { return *static_cast<SuperTy*>(this); }
@@ -24,11 +24,13 @@
 
 #include "katana/BulkSynchronous.h"
 #include "katana/Chunk.h"
+#include "katana/EpsilonOrderedList.h"
 #include "katana/LocalQueue.h"
 #include "katana/Obim.h"
 #include "katana/OrderedList.h"
 #include "katana/OwnerComputes.h"
 #include "katana/PerThreadChunk.h"
+#include "katana/PriorityWindow.h"
 #include "katana/Simple.h"
 #include "katana/StableIterator.h"
 #include "katana/config.h"
@@ -38,7 +40,9 @@ namespace katana {
  * Scheduling policies for Galois iterators. Unless you have very specific
  * scheduling requirement, \ref PerSocketChunkLIFO or \ref PerSocketChunkFIFO is
  * a reasonable scheduling policy. If you need approximate priority scheduling,
- * use \ref OrderedByIntegerMetric. For debugging, you may be interested in
+ * use \ref OrderedByIntegerMetric, \ref PriorityWindow when many priority
+ * levels churn at high thread counts, or \ref EpsilonOrderedList when
+ * priorities are continuous rather than small integers. For debugging, you may be interested in
  * \ref FIFO or \ref LIFO, which try to follow serial order exactly.
  *
  * The way to use a worklist is to pass it as a template parameter to
@@ -0,0 +1,86 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_ANALYTICS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_ANALYTICS_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "katana/Loops.h"
+
+namespace katana::analytics {
+
+/// Runs the per-node and per-edge kernels of several analytics in one fused
+/// traversal of the topology.
+///
+/// Back-to-back analytics that each stream the whole graph (degree
+/// statistics, a PageRank round, label propagation, ...) are memory-bound,
+/// so running k of them as k separate loops costs k full passes of DRAM
+/// traffic over the same adjacency arrays. A pipeline executes every
+/// registered kernel inside a single edge-stealing do_all: the topology is
+/// read once and each kernel keeps its own accumulators.
+///
+/// Kernels must be fusable: independent of each other and of iteration
+/// order, exactly like the body of the do_all each algorithm would
+/// otherwise run on its own. Kernels that carry cross-round dependencies
+/// (e.g. consecutive PageRank iterations) can fuse within a round but must
+/// still synchronize between rounds by calling Run once per round.
+///
+/// \code
+/// katana::analytics::TraversalPipeline<Graph> pipeline(graph);
+/// pipeline.AddEdgeKernel([&](GNode n, Graph::Edge) { degree[n] += 1; });
+/// pipeline.AddEdgeKernel([&](GNode n, Graph::Edge e) {
+///   next_rank[*graph.GetEdgeDest(e)] += delta[n];
+/// });
+/// pipeline.Run("DegreeAndPagerank");
+/// \endcode
+template <typename Graph>
+class TraversalPipeline {
+public:
+  using Node = typename Graph::Node;
+  using Edge = typename Graph::Edge;
+
+  explicit TraversalPipeline(const Graph& graph) : graph_(&graph) {}
+
+  /// Register a kernel run once per node
+  TraversalPipeline& AddNodeKernel(std::function<void(Node)> kernel) {
+    node_kernels_.emplace_back(std::move(kernel));
+    return *this;
+  }
+
+  /// Register a kernel run once per out edge of every node
+  TraversalPipeline& AddEdgeKernel(std::function<void(Node, Edge)> kernel) {
+    edge_kernels_.emplace_back(std::move(kernel));
+    return *this;
+  }
+
+  /// Execute all registered kernels in one pass over the topology. The
+  /// kernels registered so far stay registered, so iterative algorithms can
+  /// call Run once per round.
+  void Run(const char* loop_name = "TraversalPipeline") {
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](Node node) {
+          for (const auto& kernel : node_kernels_) {
+            kernel(node);
+          }
+          if (edge_kernels_.empty()) {
+            return;
+          }
+          for (auto edge : graph_->edges(node)) {
+            for (const auto& kernel : edge_kernels_) {
+              kernel(node, edge);
+            }
+          }
+        },
+        katana::steal(), katana::loopname(loop_name), katana::no_stats());
+  }
+
+private:
+  const Graph* graph_;
+  std::vector<std::function<void(Node)>> node_kernels_;
+  std::vector<std::function<void(Node, Edge)>> edge_kernels_;
+};
+
+}  // namespace katana::analytics
+
+#endif
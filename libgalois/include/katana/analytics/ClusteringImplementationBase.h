@@ -25,6 +25,8 @@
 #include <random>
 
 #include "katana/AtomicHelpers.h"
+#include "katana/ConcurrentFlatMap.h"
+#include "katana/DynamicBitset.h"
 #include "katana/Galois.h"
 #include "katana/NUMAArray.h"
 #include "katana/analytics/Utils.h"
@@ -220,11 +222,14 @@ struct ClusteringImplementationBase {
   /**
    * Computes the modularity gain of the current cluster assignment
    * without swapping the cluster assignment.
+   * The resolution parameter scales the null-model term of the gain;
+   * 1.0 gives classic modularity and larger values favor smaller clusters.
    */
   static uint64_t MaxModularityWithoutSwaps(
       std::map<uint64_t, uint64_t>& cluster_local_map,
       std::vector<EdgeTy>& counter, uint64_t self_loop_wt,
-      CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant) {
+      CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant,
+      double resolution = 1.0) {
     uint64_t max_index = sc;  // Assign the intial value as self community
     double cur_gain = 0;
     double max_gain = 0;
@@ -248,8 +253,9 @@ struct ClusteringImplementationBase {
 
         eiy = counter[stored_already
                           ->second];  // Total edges incident on cluster y
-        cur_gain = 2 * constant * (eiy - eix) +
-                   2 * degree_wt * ((ax - ay) * constant * constant);
+        cur_gain =
+            2 * constant * (eiy - eix) +
+            2 * resolution * degree_wt * ((ax - ay) * constant * constant);
 
         if ((cur_gain > max_gain) ||
             ((cur_gain == max_gain) && (cur_gain != 0) &&
@@ -272,11 +278,13 @@ struct ClusteringImplementationBase {
 
   /**
    * Computes the modularity gain of the current cluster assignment.
+   * The resolution parameter scales the null-model term; 1.0 gives
+   * classic modularity.
    */
   template <typename EdgeWeightType>
   static double CalModularity(
       const Graph& graph, CommunityArray& c_info, double& e_xx, double& a2_x,
-      double& constant_for_second_term) {
+      double& constant_for_second_term, double resolution = 1.0) {
     /* Variables needed for Modularity calculation */
     double mod = -1;
 
@@ -315,7 +323,7 @@ struct ClusteringImplementationBase {
     a2_x = acc_a2_x.reduce();
 
     mod = e_xx * (double)constant_for_second_term -
-          a2_x * (double)constant_for_second_term;
+          resolution * a2_x * (double)constant_for_second_term;
     return mod;
   }
 
@@ -415,21 +423,19 @@ struct ClusteringImplementationBase {
  */
   template <typename CommunityIDType>
   static uint64_t RenumberClustersContiguously(Graph* graph) {
-    std::map<uint64_t, uint64_t> cluster_local_map;
+    katana::ConcurrentFlatMap<uint64_t, uint64_t> cluster_local_map(1);
     uint64_t num_unique_clusters = 0;
 
     for (GNode n = 0; n < graph->num_nodes(); ++n) {
       auto& n_data_curr_comm_id = graph->template GetData<CommunityIDType>(n);
       if (n_data_curr_comm_id != UNASSIGNED) {
         KATANA_LOG_DEBUG_ASSERT(n_data_curr_comm_id < graph->num_nodes());
-        auto stored_already = cluster_local_map.find(n_data_curr_comm_id);
-        if (stored_already != cluster_local_map.end()) {
-          n_data_curr_comm_id = stored_already->second;
-        } else {
-          cluster_local_map[n_data_curr_comm_id] = num_unique_clusters;
-          n_data_curr_comm_id = num_unique_clusters;
+        auto [renumbered_id, inserted] =
+            cluster_local_map.insert(n_data_curr_comm_id, num_unique_clusters);
+        if (inserted) {
           num_unique_clusters++;
         }
+        n_data_curr_comm_id = *renumbered_id;
       }
     }
     return num_unique_clusters;
@@ -526,16 +532,46 @@ struct ClusteringImplementationBase {
 
     const uint64_t num_nodes_next = num_unique_clusters;
 
-    std::vector<std::vector<GNode>> cluster_bags(num_unique_clusters);
-    // TODO(amber): This loop can be parallelized when using a concurrent container
-    // for cluster_bags, but something like katana::InsertBag exhausts the
-    // per-thread-storage memory
-    for (GNode n = 0; n < graph.num_nodes(); ++n) {
+    // Group the nodes by cluster id with a parallel counting sort. Scattering
+    // into one preallocated flat array avoids the per-thread-storage
+    // exhaustion that a katana::InsertBag per cluster would cause.
+    katana::NUMAArray<std::atomic<uint64_t>> cluster_cursor;
+    cluster_cursor.allocateInterleaved(num_unique_clusters);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_unique_clusters),
+        [&](uint64_t c) { cluster_cursor[c] = 0; });
+
+    katana::do_all(katana::iterate(graph), [&](GNode n) {
       auto n_data_curr_comm_id = graph.template GetData<CommunityIDType>(n);
       if (n_data_curr_comm_id != UNASSIGNED) {
-        cluster_bags[n_data_curr_comm_id].push_back(n);
+        cluster_cursor[n_data_curr_comm_id].fetch_add(
+            1, std::memory_order_relaxed);
       }
-    }
+    });
+
+    katana::NUMAArray<uint64_t> cluster_bag_end;
+    cluster_bag_end.allocateInterleaved(num_unique_clusters);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_unique_clusters),
+        [&](uint64_t c) { cluster_bag_end[c] = cluster_cursor[c]; });
+
+    katana::ParallelSTL::partial_sum(
+        cluster_bag_end.begin(), cluster_bag_end.end(),
+        cluster_bag_end.begin());
+
+    katana::NUMAArray<GNode> cluster_nodes;
+    cluster_nodes.allocateInterleaved(cluster_bag_end[num_unique_clusters - 1]);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_unique_clusters), [&](uint64_t c) {
+          cluster_cursor[c] = (c == 0) ? 0 : cluster_bag_end[c - 1];
+        });
+    katana::do_all(katana::iterate(graph), [&](GNode n) {
+      auto n_data_curr_comm_id = graph.template GetData<CommunityIDType>(n);
+      if (n_data_curr_comm_id != UNASSIGNED) {
+        cluster_nodes[cluster_cursor[n_data_curr_comm_id].fetch_add(
+            1, std::memory_order_relaxed)] = n;
+      }
+    });
 
     std::vector<katana::gstl::Vector<uint32_t>> edges_id(num_unique_clusters);
     std::vector<katana::gstl::Vector<EdgeTy>> edges_data(num_unique_clusters);
@@ -544,9 +580,11 @@ struct ClusteringImplementationBase {
     katana::do_all(
         katana::iterate(uint64_t{0}, num_unique_clusters),
         [&](uint64_t c) {
-          katana::gstl::Map<uint64_t, uint64_t> cluster_local_map;
+          katana::ConcurrentFlatMap<uint64_t, uint64_t> cluster_local_map(1);
           uint64_t num_unique_clusters = 0;
-          for (auto node : cluster_bags[c]) {
+          const uint64_t bag_begin = (c == 0) ? 0 : cluster_bag_end[c - 1];
+          for (uint64_t i = bag_begin; i < cluster_bag_end[c]; ++i) {
+            GNode node = cluster_nodes[i];
             KATANA_LOG_DEBUG_ASSERT(
                 graph.template GetData<CommunityIDType>(node) ==
                 c);  // All nodes in this bag must have same cluster id
@@ -557,13 +595,12 @@ struct ClusteringImplementationBase {
               auto dst_data_curr_comm_id =
                   graph.template GetData<CommunityIDType>(dst);
               KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
-              auto stored_already = cluster_local_map.find(
-                  dst_data_curr_comm_id);  // Check if it already exists
-              if (stored_already != cluster_local_map.end()) {
-                edges_data[c][stored_already->second] +=
+              auto [index, inserted] = cluster_local_map.insert(
+                  dst_data_curr_comm_id, num_unique_clusters);
+              if (!inserted) {
+                edges_data[c][*index] +=
                     graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
               } else {
-                cluster_local_map[dst_data_curr_comm_id] = num_unique_clusters;
                 edges_id[c].push_back(dst_data_curr_comm_id);
                 edges_data[c].push_back(
                     graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
@@ -880,54 +917,14 @@ struct ClusteringImplementationBase {
  */
   template <typename EdgeWeightType>
   static void MergeNodesSubset(
-      Graph* graph, std::vector<GNode>& cluster_nodes, uint64_t comm_id,
+      Graph* graph, const katana::NUMAArray<GNode>& nodes_to_move,
+      uint64_t move_begin, uint64_t move_end, uint64_t comm_id,
       uint64_t total_degree_wt, CommunityArray& subcomm_info,
       double constant_for_second_term, double resolution, double randomness) {
-    // select set R
-    std::vector<GNode> cluster_nodes_to_move;
-    for (uint64_t i = 0; i < cluster_nodes.size(); ++i) {
-      GNode n = cluster_nodes[i];
-      auto& n_degree_wt =
-          graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
-      auto& n_node_wt = graph->template GetData<NodeWeight>(n);
-      /*
-     * Initialize with singleton sub-communities
-     */
-      EdgeWeightType node_edge_weight_within_cluster = 0;
-      for (auto ii = graph->edge_begin(n); ii != graph->edge_end(n); ++ii) {
-        auto dst = graph->GetEdgeDest(ii);
-        EdgeWeightType edge_wt =
-            graph->template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
-        /*
-       * Must include the edge weight of all neighbors excluding self loops
-       * belonging to the community comm_id
-       */
-        if (*dst != n &&
-            graph->template GetData<CurrentCommunityID>(dst) == comm_id) {
-          node_edge_weight_within_cluster += edge_wt;
-        }
-      }
-
-      uint64_t node_wt = n_node_wt;
-      uint64_t degree_wt = n_degree_wt;
-      /*
-     * Additionally, only nodes that are well connected with
-     * the rest of the network are considered for moving.
-     * (externalEdgeWeightPerCluster[j] >= clusterWeights[j] * (totalNodeWeight
-     * - clusterWeights[j]) * resolution
-     */
-      if (node_edge_weight_within_cluster >=
-          constant_for_second_term * (double)degree_wt *
-              ((double)total_degree_wt - (double)degree_wt))
-        cluster_nodes_to_move.push_back(n);
-
-      subcomm_info[n].node_wt = node_wt;
-      subcomm_info[n].internal_edge_wt = node_edge_weight_within_cluster;
-      subcomm_info[n].size = 1;
-      subcomm_info[n].degree_wt = degree_wt;
-    }
-
-    for (GNode n : cluster_nodes_to_move) {
+    // The set R of well-connected nodes was selected in parallel by
+    // RefinePartition; only the sequential move phase remains here.
+    for (uint64_t i = move_begin; i < move_end; ++i) {
+      GNode n = nodes_to_move[i];
       auto& n_degree_wt =
           graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
       auto& n_node_wt = graph->template GetData<NodeWeight>(n);
@@ -989,37 +986,140 @@ struct ClusteringImplementationBase {
         [&](GNode n) { graph->template GetData<CurrentSubCommunityID>(n) = n; },
         katana::steal());
 
-    // populate nodes into communities
-    std::vector<std::vector<GNode>> cluster_bags(2 * graph->size() + 1);
+    // Accumulate community sizes and weights in parallel; the grouping of
+    // nodes by community happens below via counting sort over the selected
+    // movers only.
+    const uint64_t num_comms = 2 * graph->size() + 1;
     CommunityArray comm_info;
 
-    comm_info.allocateBlocked(2 * graph->size() + 1);
+    comm_info.allocateBlocked(num_comms);
 
     katana::do_all(
-        katana::iterate((uint32_t)0, (uint32_t)(2 * graph->size() + 1)),
-        [&](uint32_t n) {
+        katana::iterate((uint64_t)0, num_comms),
+        [&](uint64_t n) {
+          comm_info[n].size = (uint64_t)0;
           comm_info[n].node_wt = (uint64_t)0;
           comm_info[n].degree_wt = (uint64_t)0;
         },
         katana::steal());
 
-    for (GNode n : *graph) {
-      auto& n_current_comm = graph->template GetData<CurrentCommunityID>(n);
-      auto& n_node_wt = graph->template GetData<NodeWeight>(n);
-      auto& n_degree_wt =
-          graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
-      if (n_current_comm != UNASSIGNED) {
-        cluster_bags[n_current_comm].push_back(n);
-
-        katana::atomicAdd(comm_info[n_current_comm].node_wt, n_node_wt);
-        katana::atomicAdd(comm_info[n_current_comm].degree_wt, n_degree_wt);
-      }
-    }
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto& n_current_comm = graph->template GetData<CurrentCommunityID>(n);
+          if (n_current_comm != UNASSIGNED) {
+            katana::atomicAdd(comm_info[n_current_comm].size, (uint64_t)1);
+            katana::atomicAdd(
+                comm_info[n_current_comm].node_wt,
+                (uint64_t)graph->template GetData<NodeWeight>(n));
+            katana::atomicAdd(
+                comm_info[n_current_comm].degree_wt,
+                graph->template GetData<DegreeWeight<EdgeWeightType>>(n));
+          }
+        },
+        katana::steal());
 
     CommunityArray subcomm_info;
 
     subcomm_info.allocateBlocked(graph->size() + 1);
 
+    // Select the set R of well-connected nodes in parallel over all nodes
+    // instead of per community inside MergeNodesSubset; the edge scans
+    // dominate refinement and are independent per node. Moves are batched
+    // into per-community queues and the sub-community weight updates are
+    // deferred to the sequential move phase below.
+    katana::DynamicBitset selected;
+    selected.resize(graph->size());
+    selected.reset();
+
+    katana::NUMAArray<std::atomic<uint64_t>> move_cursor;
+    move_cursor.allocateInterleaved(num_comms);
+    katana::do_all(
+        katana::iterate((uint64_t)0, num_comms),
+        [&](uint64_t c) { move_cursor[c] = 0; });
+
+    katana::GAccumulator<uint64_t> num_nodes_to_move;
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto& n_current_comm = graph->template GetData<CurrentCommunityID>(n);
+          if (n_current_comm == UNASSIGNED) {
+            return;
+          }
+          auto& n_degree_wt =
+              graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
+          auto& n_node_wt = graph->template GetData<NodeWeight>(n);
+          /*
+         * Initialize with singleton sub-communities
+         */
+          EdgeWeightType node_edge_weight_within_cluster = 0;
+          for (auto ii = graph->edge_begin(n); ii != graph->edge_end(n); ++ii) {
+            auto dst = graph->GetEdgeDest(ii);
+            EdgeWeightType edge_wt =
+                graph->template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
+            /*
+           * Must include the edge weight of all neighbors excluding self
+           * loops belonging to the community comm_id
+           */
+            if (*dst != n &&
+                graph->template GetData<CurrentCommunityID>(dst) ==
+                    n_current_comm) {
+              node_edge_weight_within_cluster += edge_wt;
+            }
+          }
+
+          uint64_t degree_wt = n_degree_wt;
+          uint64_t total_degree_wt = comm_info[n_current_comm].degree_wt;
+          /*
+         * Additionally, only nodes that are well connected with
+         * the rest of the network are considered for moving.
+         * (externalEdgeWeightPerCluster[j] >= clusterWeights[j] *
+         * (totalNodeWeight - clusterWeights[j]) * resolution
+         */
+          if (node_edge_weight_within_cluster >=
+              constant_for_second_term * (double)degree_wt *
+                  ((double)total_degree_wt - (double)degree_wt)) {
+            selected.set(n);
+            move_cursor[n_current_comm].fetch_add(
+                1, std::memory_order_relaxed);
+            num_nodes_to_move += 1;
+          }
+
+          subcomm_info[n].node_wt = (uint64_t)n_node_wt;
+          subcomm_info[n].internal_edge_wt = node_edge_weight_within_cluster;
+          subcomm_info[n].size = 1;
+          subcomm_info[n].degree_wt = degree_wt;
+        },
+        katana::steal(), katana::loopname("RefinePartition_Select"));
+
+    // Group the selected movers by community with the same counting-sort
+    // layout GraphCoarsening uses; a flat array avoids the per-thread-storage
+    // cost of a bag per community.
+    katana::NUMAArray<uint64_t> move_end;
+    move_end.allocateInterleaved(num_comms);
+    katana::do_all(
+        katana::iterate((uint64_t)0, num_comms),
+        [&](uint64_t c) { move_end[c] = move_cursor[c]; });
+    katana::ParallelSTL::partial_sum(
+        move_end.begin(), move_end.end(), move_end.begin());
+
+    katana::NUMAArray<GNode> nodes_to_move;
+    if (num_nodes_to_move.reduce() > 0) {
+      nodes_to_move.allocateInterleaved(num_nodes_to_move.reduce());
+      katana::do_all(
+          katana::iterate((uint64_t)0, num_comms), [&](uint64_t c) {
+            move_cursor[c] = (c == 0) ? 0 : move_end[c - 1];
+          });
+      katana::do_all(katana::iterate(*graph), [&](GNode n) {
+        if (selected.test(n)) {
+          auto& n_current_comm =
+              graph->template GetData<CurrentCommunityID>(n);
+          nodes_to_move[move_cursor[n_current_comm].fetch_add(
+              1, std::memory_order_relaxed)] = n;
+        }
+      });
+    }
+
     // call MergeNodesSubset for each community in parallel
     katana::do_all(
         katana::iterate((uint64_t)0, (uint64_t)graph->size()), [&](uint64_t c) {
@@ -1029,12 +1129,12 @@ struct ClusteringImplementationBase {
                     * never be split up.
                     */
           comm_info[c].num_sub_communities = 0;
-          if (cluster_bags[c].size() > 1) {
+          const uint64_t move_begin = (c == 0) ? 0 : move_end[c - 1];
+          if (comm_info[c].size > 1 && move_begin < move_end[c]) {
             MergeNodesSubset<EdgeWeightType>(
-                graph, cluster_bags[c], c, comm_info[c].degree_wt, subcomm_info,
-                constant_for_second_term, resolution, randomness);
-          } else {
-            comm_info[c].num_sub_communities = 0;
+                graph, nodes_to_move, move_begin, move_end[c], c,
+                comm_info[c].degree_wt, subcomm_info, constant_for_second_term,
+                resolution, randomness);
           }
         });
   }
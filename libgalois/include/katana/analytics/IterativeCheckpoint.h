@@ -0,0 +1,89 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_ITERATIVECHECKPOINT_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_ITERATIVECHECKPOINT_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana::analytics {
+
+/// Periodic snapshots of an iterative algorithm's state, so a preempted
+/// multi-hour run resumes from the last snapshot instead of recomputing
+/// from scratch.
+///
+/// A snapshot is an opaque round counter plus the raw bytes of the state
+/// arrays the algorithm hands to Save. Writes go through the storage layer
+/// asynchronously: Save copies the live arrays into an internal buffer --
+/// the algorithm may keep mutating them -- and drains the store in the
+/// background while later rounds compute, so the synchronous cost is one
+/// memcpy per interval. Snapshots alternate between two slot files and
+/// carry a trailing sentinel, so a crash mid-write leaves the previous
+/// slot intact; Restore picks the newest slot that validates.
+///
+/// The interpretation of the round counter and the number, order, and
+/// sizes of the sections are the calling algorithm's contract with itself;
+/// Restore hands back exactly what Save was given and the caller rejects
+/// snapshots whose shape does not match the current input.
+class KATANA_EXPORT IterativeCheckpointer {
+public:
+  struct Section {
+    const void* data;
+    size_t bytes;
+  };
+
+  struct Snapshot {
+    uint32_t round;
+    std::vector<std::vector<uint8_t>> sections;
+  };
+
+  /// \param location directory URI the slot files live under
+  /// \param name distinguishes checkpoints of different analytics sharing
+  ///        a location
+  /// \param interval_rounds snapshot every this many rounds; 0 disables
+  ///        the checkpointer entirely
+  IterativeCheckpointer(
+      std::string location, std::string name, uint32_t interval_rounds);
+
+  /// Waits for the in-flight snapshot; a failure at this point is logged,
+  /// not fatal -- the computed result is unaffected.
+  ~IterativeCheckpointer();
+
+  IterativeCheckpointer(const IterativeCheckpointer&) = delete;
+  IterativeCheckpointer(IterativeCheckpointer&&) = delete;
+  IterativeCheckpointer& operator=(const IterativeCheckpointer&) = delete;
+  IterativeCheckpointer& operator=(IterativeCheckpointer&&) = delete;
+
+  bool Enabled() const { return interval_rounds_ > 0; }
+
+  /// True when round is a snapshot boundary
+  bool Due(uint32_t round) const {
+    return Enabled() && round > 0 && round % interval_rounds_ == 0;
+  }
+
+  /// Snapshot the given state sections under the given round counter;
+  /// returns once the data is copied out, not once it is stored.
+  katana::Result<void> Save(
+      uint32_t round, const std::vector<Section>& sections);
+
+  /// The newest usable snapshot, or std::nullopt on a cold start (no
+  /// snapshot written yet, or none validates).
+  katana::Result<std::optional<Snapshot>> Restore();
+
+private:
+  std::string SlotUri(uint32_t slot) const;
+
+  std::string location_;
+  std::string name_;
+  uint32_t interval_rounds_;
+  uint32_t next_slot_{0};
+  // holds the serialized snapshot until its async store drains
+  std::vector<uint8_t> buffer_;
+};
+
+}  // namespace katana::analytics
+
+#endif
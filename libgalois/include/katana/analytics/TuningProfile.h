@@ -0,0 +1,86 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_TUNINGPROFILE_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_TUNINGPROFILE_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "katana/JSON.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+class PropertyGraph;
+
+namespace analytics {
+
+/// Best-known executor parameters for a graph, persisted alongside its RDG.
+///
+/// Parameters are keyed by machine shape (sockets and cores) and algorithm
+/// name, so a graph opened on a machine it has been tuned on before runs with
+/// its best-known configuration instead of wrapper scripts full of
+/// environment variables. Plans consult the profile through their
+/// FromTuningProfile factories; an autotune run (or a user who found good
+/// settings by hand) records them with Set and persists them with Store.
+///
+/// The profile is a JSON sidecar (\ref kFileName) in the RDG directory and
+/// is advisory: a missing or unreadable file loads as an empty profile and
+/// every lookup has a caller-supplied fallback, so consulting it never
+/// changes whether an algorithm can run.
+class KATANA_EXPORT TuningProfile {
+public:
+  /// Name of the sidecar file in the RDG directory
+  static constexpr const char* kFileName = "katana_tuning.json";
+
+  TuningProfile() : shape_(CurrentMachineShape()) {}
+
+  /// Key identifying this machine's shape ("<sockets>x<cores>"); entries
+  /// recorded under other shapes are kept but not consulted
+  static std::string CurrentMachineShape();
+
+  /// Load the profile stored alongside \p pg; a graph with no storage
+  /// location or no recorded profile yields an empty one
+  static TuningProfile Load(const PropertyGraph& pg);
+
+  /// Load the profile for the RDG stored at \p rdg_dir
+  static TuningProfile Load(const std::string& rdg_dir);
+
+  /// Best-known value of \p parameter for \p algorithm on this machine
+  /// shape, if one has been recorded
+  std::optional<int64_t> Get(
+      const std::string& algorithm, const std::string& parameter) const;
+
+  /// \ref Get with a fallback for unrecorded parameters
+  int64_t GetOr(
+      const std::string& algorithm, const std::string& parameter,
+      int64_t fallback) const {
+    return Get(algorithm, parameter).value_or(fallback);
+  }
+
+  /// Record \p value as the best-known \p parameter for \p algorithm on
+  /// this machine shape; call \ref Store to persist it
+  void Set(
+      const std::string& algorithm, const std::string& parameter,
+      int64_t value);
+
+  /// Write the profile back next to the RDG; fails if the profile was not
+  /// loaded from a stored graph
+  katana::Result<void> Store() const;
+
+private:
+  TuningProfile(std::string rdg_dir, nlohmann::json profiles)
+      : rdg_dir_(std::move(rdg_dir)),
+        shape_(CurrentMachineShape()),
+        profiles_(std::move(profiles)) {}
+
+  std::string rdg_dir_;
+  std::string shape_;
+  //! machine shape -> algorithm -> parameter -> value
+  nlohmann::json profiles_ = nlohmann::json::object();
+};
+
+}  // namespace analytics
+}  // namespace katana
+
+#endif
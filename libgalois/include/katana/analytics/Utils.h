@@ -34,6 +34,12 @@ public:
 KATANA_EXPORT bool IsApproximateDegreeDistributionPowerLaw(
     const PropertyGraph& graph);
 
+//! Pick num_samples node ids uniformly at random for the spot-check modes of
+//! the AssertValid family. Returns every node when num_samples is 0 or at
+//! least num_nodes, so callers can pass a sample size through unconditionally.
+KATANA_EXPORT std::vector<uint32_t> SampleValidationNodes(
+    uint64_t num_nodes, uint32_t num_samples);
+
 template <typename Props>
 std::vector<std::string>
 DefaultPropertyNames() {
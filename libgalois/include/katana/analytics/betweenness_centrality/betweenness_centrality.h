@@ -18,19 +18,34 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kSampled,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
   };
 
+  /// Default additive error bound for the sampled algorithm.
+  static constexpr float kDefaultEpsilon = 0.01;
+  /// Default failure probability for the sampled algorithm.
+  static constexpr float kDefaultConfidence = 0.1;
+
 private:
   Algorithm algorithm_;
+  float epsilon_;
+  float confidence_;
 
-  BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, float epsilon,
+      float confidence)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        confidence_(confidence) {}
 
 public:
-  BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
+  BetweennessCentralityPlan()
+      : BetweennessCentralityPlan{
+            kCPU, kLevel, kDefaultEpsilon, kDefaultConfidence} {}
 
   BetweennessCentralityPlan(const katana::PropertyGraph* pg [[maybe_unused]])
       : BetweennessCentralityPlan() {
@@ -51,12 +66,37 @@ public:
 
   Algorithm algorithm() const { return algorithm_; }
 
-  static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
+  /// The additive error bound of the sampled algorithm; unused by the exact
+  /// algorithms.
+  float epsilon() const { return epsilon_; }
+
+  /// The probability that the sampled algorithm exceeds its error bound;
+  /// unused by the exact algorithms.
+  float confidence() const { return confidence_; }
+
+  static BetweennessCentralityPlan Level() {
+    return {kCPU, kLevel, kDefaultEpsilon, kDefaultConfidence};
+  }
 
-  static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
+  static BetweennessCentralityPlan Outer() {
+    return {kCPU, kOuter, kDefaultEpsilon, kDefaultConfidence};
+  }
+
+  /// Approximate betweenness centrality by sampling sources until the number
+  /// of samples reaches the Riondato-Kornaropoulos bound, which guarantees
+  /// every normalized centrality is within epsilon of the exact value with
+  /// probability at least 1 - confidence [Riondato and Kornaropoulos, "Fast
+  /// approximation of betweenness centrality through sampling", WSDM 2014].
+  /// The bound depends on the graph only through its diameter, so on large
+  /// graphs the sample count is orders of magnitude below the node count.
+  static BetweennessCentralityPlan Sampled(
+      float epsilon = kDefaultEpsilon, float confidence = kDefaultConfidence) {
+    return {kCPU, kSampled, epsilon, confidence};
+  }
 
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
-    return BetweennessCentralityPlan(kCPU, algo);
+    return BetweennessCentralityPlan(
+        kCPU, algo, kDefaultEpsilon, kDefaultConfidence);
   }
 };
 
@@ -0,0 +1,110 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_BIPART_BIPART_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_BIPART_BIPART_H_
+
+#include <iostream>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// The partition id assigned to hyperedges whose member nodes do not all
+/// fall into the same partition.
+static constexpr const uint32_t kCutHyperedgePartition =
+    std::numeric_limits<uint32_t>::max();
+
+/// A computational plan to for Bipart, specifying the matching policy used
+/// during coarsening and the maximum number of coarsening levels.
+class BipartPlan : public Plan {
+public:
+  /// The priority used to pick the hyperedge each node is matched to during
+  /// multi-node matching.
+  enum MatchingPolicy {
+    /// Higher priority assigned to high degree hyperedges.
+    kHigherDegree,
+    /// Higher priority assigned to low degree hyperedges.
+    kLowerDegree,
+    /// Higher priority assigned to high weight hyperedges.
+    kHigherWeight,
+    /// Higher priority assigned to low weight hyperedges.
+    kLowerWeight,
+    /// Priority assigned using a deterministic hash of hyperedge ids.
+    kRandom,
+  };
+
+  static const MatchingPolicy kDefaultMatchingPolicy = kHigherDegree;
+  static const uint32_t kDefaultMaxCoarsenLevel = 25;
+
+private:
+  MatchingPolicy matching_policy_;
+  uint32_t max_coarsen_level_;
+
+  BipartPlan(
+      Architecture architecture, MatchingPolicy matching_policy,
+      uint32_t max_coarsen_level)
+      : Plan(architecture),
+        matching_policy_(matching_policy),
+        max_coarsen_level_(max_coarsen_level) {}
+
+public:
+  BipartPlan()
+      : BipartPlan{kCPU, kDefaultMatchingPolicy, kDefaultMaxCoarsenLevel} {}
+
+  MatchingPolicy matching_policy() const { return matching_policy_; }
+  uint32_t max_coarsen_level() const { return max_coarsen_level_; }
+
+  /// Multi-level hypergraph partitioning.
+  ///
+  /// @param matching_policy Priority used during multi-node matching.
+  /// @param max_coarsen_level Maximum number of coarsening levels allowed.
+  static BipartPlan Bipart(
+      MatchingPolicy matching_policy = kDefaultMatchingPolicy,
+      uint32_t max_coarsen_level = kDefaultMaxCoarsenLevel) {
+    return {kCPU, matching_policy, max_coarsen_level};
+  }
+};
+
+/// Partition the hypergraph encoded in pg into num_partitions parts while
+/// minimizing the number of cut hyperedges, and write the partition id of
+/// each node to the property named output_property_name.
+///
+/// The graph must use the bipartite hyperedge encoding: the first nodes of
+/// the graph represent the hyperedges and their out-edges point to the member
+/// nodes, which follow the hyperedges in the node numbering and have no
+/// out-edges of their own. Hyperedges whose member nodes all land in the same
+/// partition are assigned that partition as well; cut hyperedges are assigned
+/// kCutHyperedgePartition.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+///
+/// @param pg The bipartite hyperedge graph to process.
+/// @param num_partitions Number of partitions to create.
+/// @param output_property_name Name of the uint32 node property to create.
+/// @param plan
+KATANA_EXPORT katana::Result<void> Bipart(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_property_name, BipartPlan plan = {});
+
+struct KATANA_EXPORT BipartStatistics {
+  /// Number of non-empty partitions.
+  uint32_t number_of_partitions;
+  /// Number of hyperedges whose member nodes span more than one partition.
+  uint32_t cut_hyperedges;
+  /// Number of member nodes in the largest partition.
+  uint32_t largest_partition_size;
+  /// Number of member nodes in the smallest non-empty partition.
+  uint32_t smallest_partition_size;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<BipartStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
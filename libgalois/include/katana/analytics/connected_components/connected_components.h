@@ -2,13 +2,20 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_CONNECTEDCOMPONENTS_CONNECTEDCOMPONENTS_H_
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
+#include "katana/NUMAArray.h"
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
 
 // API
 
+namespace katana {
+class OutOfCorePropertyGraph;
+}
+
 namespace katana::analytics {
 
 /// A computational plan to for ConnectedComponents, specifying the algorithm and any
@@ -161,8 +168,46 @@ KATANA_EXPORT Result<void> ConnectedComponents(
     PropertyGraph* pg, const std::string& output_property_name,
     ConnectedComponentsPlan plan = ConnectedComponentsPlan());
 
+/// Default number of incremental batches ConnectedComponentsIncremental
+/// applies before falling back to a full recompute.
+constexpr uint64_t kDefaultFullRecomputeInterval = 1024;
+
+/// Incrementally maintain Connected-components labels under edge insertions.
+/// The labels a prior ConnectedComponents (or ConnectedComponentsIncremental)
+/// run left in property_name form a fully compressed union-find forest: every
+/// node stores its component representative. This function resumes that
+/// union-find, applies only the edges in inserted_edges and rewrites the
+/// labels, so the cost is proportional to the batch size plus one linear
+/// relabel pass over the nodes rather than a traversal of every edge.
+///
+/// Incremental maintenance can only merge components, so a full recompute is
+/// kept as a safety valve: when property_name does not exist or
+/// batches_since_full_compute has reached full_recompute_interval the call
+/// runs ConnectedComponents with plan instead. The caller is responsible for
+/// counting batches between full runs and for symmetry of inserted_edges
+/// (an undirected insertion needs to be passed only once).
+KATANA_EXPORT Result<void> ConnectedComponentsIncremental(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<std::pair<uint32_t, uint32_t>>& inserted_edges,
+    uint64_t batches_since_full_compute = 0,
+    uint64_t full_recompute_interval = kDefaultFullRecomputeInterval,
+    ConnectedComponentsPlan plan = ConnectedComponentsPlan());
+
+/// Compute Connected-components for a graph too large to load, streaming
+/// edge segments through an OutOfCorePropertyGraph. Edges are treated as
+/// undirected, so the input does not have to be symmetric. Component labels
+/// are returned in \p components (indexed by node ID) instead of being
+/// written to a property. The schedule is always label propagation; the
+/// plan's algorithm choice does not apply.
+KATANA_EXPORT Result<void> ConnectedComponentsOutOfCore(
+    OutOfCorePropertyGraph* graph, NUMAArray<uint64_t>* components);
+
+/// Check that neighboring nodes carry the same component label. When
+/// num_samples is non-zero only that many randomly chosen nodes are
+/// checked, for a quick production sanity check instead of a full scan.
 KATANA_EXPORT Result<void> ConnectedComponentsAssertValid(
-    PropertyGraph* pg, const std::string& property_name);
+    PropertyGraph* pg, const std::string& property_name,
+    uint32_t num_samples = 0);
 
 struct KATANA_EXPORT ConnectedComponentsStatistics {
   /// Total number of unique components in the graph.
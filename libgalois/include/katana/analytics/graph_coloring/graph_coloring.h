@@ -0,0 +1,116 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHCOLORING_GRAPHCOLORING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHCOLORING_GRAPHCOLORING_H_
+
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// The color stored for nodes the algorithm failed to color. Never present
+/// after a successful GraphColoring call.
+constexpr uint32_t kUncoloredColor = std::numeric_limits<uint32_t>::max();
+
+/// A computational plan to for graph coloring, specifying the algorithm and
+/// any parameters associated with it.
+class GraphColoringPlan : public Plan {
+public:
+  /// Algorithm selectors for graph coloring
+  enum Algorithm { kJonesPlassmannLLF, kJonesPlassmannSLL };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  GraphColoringPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  GraphColoringPlan() : GraphColoringPlan{kCPU, kJonesPlassmannLLF} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Jones-Plassmann with largest-log-degree-first priorities: nodes with
+  /// larger log2(degree) are colored first, with a hash of the node ID
+  /// breaking ties within a log-degree bucket.
+  static GraphColoringPlan JonesPlassmannLLF() {
+    return {kCPU, kJonesPlassmannLLF};
+  }
+
+  /// Jones-Plassmann with smallest-log-degree-last priorities: nodes are
+  /// peeled off in rounds of doubling degree thresholds and colored in the
+  /// reverse of their removal round, which typically uses fewer colors than
+  /// LLF on skewed degree distributions at the cost of the peeling
+  /// preprocessing.
+  static GraphColoringPlan JonesPlassmannSLL() {
+    return {kCPU, kJonesPlassmannSLL};
+  }
+};
+
+/// Compute a distance-1 coloring of pg. The pg is expected to be symmetric
+/// and free of self loops. Colors are the dense range [0, number of colors)
+/// and are stored in the uint32 node property named by output_property_name.
+/// Priorities depend only on the graph, so the coloring is deterministic
+/// across runs and thread counts.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> GraphColoring(
+    PropertyGraph* pg, const std::string& output_property_name,
+    GraphColoringPlan plan = {});
+
+/// The nodes of a colored graph grouped by color, so downstream loops can
+/// run color class by color class: nodes of one class are pairwise
+/// non-adjacent and may be mutated in a single do_all without atomics.
+struct KATANA_EXPORT ColorClasses {
+  /// Node IDs grouped by color.
+  std::vector<uint32_t> nodes;
+  /// Exclusive prefix sums of class sizes: class c occupies
+  /// nodes[class_end[c - 1]..class_end[c]) (class 0 starts at 0).
+  std::vector<uint64_t> class_end;
+
+  uint64_t NumColors() const { return class_end.size(); }
+
+  /// The nodes of one color class as an iterator range, usable with
+  /// katana::iterate.
+  std::pair<
+      std::vector<uint32_t>::const_iterator,
+      std::vector<uint32_t>::const_iterator>
+  Class(uint64_t color) const {
+    auto begin = nodes.begin() + (color == 0 ? 0 : class_end[color - 1]);
+    return {begin, nodes.begin() + class_end[color]};
+  }
+};
+
+/// Group the nodes of pg by the colors in property_name (as produced by
+/// GraphColoring).
+KATANA_EXPORT Result<ColorClasses> GraphColoringColorClasses(
+    PropertyGraph* pg, const std::string& property_name);
+
+/// Check that every node is colored and no edge connects two nodes of the
+/// same color. When num_samples is non-zero only that many randomly chosen
+/// nodes are checked.
+KATANA_EXPORT Result<void> GraphColoringAssertValid(
+    PropertyGraph* pg, const std::string& property_name,
+    uint32_t num_samples = 0);
+
+struct KATANA_EXPORT GraphColoringStatistics {
+  /// Total number of distinct colors used.
+  uint32_t number_of_colors;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<GraphColoringStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
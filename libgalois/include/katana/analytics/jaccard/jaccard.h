@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_JACCARD_JACCARD_H_
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -61,6 +63,19 @@ KATANA_EXPORT Result<void> Jaccard(
     PropertyGraph* pg, uint32_t compare_node,
     const std::string& output_property_name, JaccardPlan plan = {});
 
+/// Compute, for every node in one pass, the k nodes most Jaccard-similar to
+/// it. Row n of the returned table holds up to k (node id, similarity) pairs
+/// in order of decreasing similarity. Only pairs that share at least one
+/// neighbor are considered, and pairs below min_similarity are dropped, so
+/// rows may hold fewer than k entries. A positive min_similarity also prunes
+/// candidate generation with the classic degree bound
+/// min(d(u), d(v)) / max(d(u), d(v)) >= min_similarity over the
+/// degree-sorted graph view, where the bound is a contiguous node id range.
+/// This replaces calling Jaccard() once per node when only the strongest
+/// similarities are needed.
+KATANA_EXPORT Result<std::vector<std::vector<std::pair<uint32_t, double>>>>
+JaccardTopKAllPairs(PropertyGraph* pg, uint32_t k, double min_similarity = 0.0);
+
 KATANA_EXPORT Result<void> JaccardAssertValid(
     PropertyGraph* pg, uint32_t compare_node, const std::string& property_name);
 
@@ -51,9 +51,21 @@ KATANA_EXPORT Result<void> KCore(
     PropertyGraph* pg, uint32_t k_core_number,
     const std::string& output_property_name, KCorePlan plan = KCorePlan());
 
+/// Compute the full k-core decomposition of pg in one peeling pass. The pg
+/// must be symmetric. Each node's coreness (the largest k such that the node
+/// is in the k-core) is stored as a uint32 in the property named
+/// output_property_name, which is created by this function and may not exist
+/// before the call. One run replaces a sweep of KCore calls over every k of
+/// interest.
+KATANA_EXPORT Result<void> KCoreDecomposition(
+    PropertyGraph* pg, const std::string& output_property_name);
+
+/// Check that alive nodes have at least k alive neighbors and dead nodes do
+/// not (the k-core is maximal). When num_samples is non-zero only that many
+/// randomly chosen nodes are checked.
 KATANA_EXPORT Result<void> KCoreAssertValid(
     PropertyGraph* pg, uint32_t k_core_number,
-    const std::string& property_name);
+    const std::string& property_name, uint32_t num_samples = 0);
 
 struct KATANA_EXPORT KCoreStatistics {
   /// Total number of node left in the core.
@@ -0,0 +1,109 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_KSHORTESTPATHS_KSHORTESTPATHS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_KSHORTESTPATHS_KSHORTESTPATHS_H_
+
+#include <iostream>
+#include <vector>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for k shortest paths, specifying the algorithm and
+/// any parameters associated with it.
+class KShortestPathsPlan : public Plan {
+public:
+  /// Algorithm selectors for k shortest paths
+  enum Algorithm {
+    kDeltaTile,
+    kDeltaStep,
+    kDeltaStepBarrier,
+  };
+
+  static const int kDefaultDelta = 13;
+  static const int kDefaultEdgeTileSize = 512;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  unsigned delta_;
+  ptrdiff_t edge_tile_size_;
+
+  KShortestPathsPlan(
+      Architecture architecture, Algorithm algorithm, unsigned delta,
+      ptrdiff_t edge_tile_size)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        delta_(delta),
+        edge_tile_size_(edge_tile_size) {}
+
+public:
+  KShortestPathsPlan()
+      : KShortestPathsPlan{
+            kCPU, kDeltaTile, kDefaultDelta, kDefaultEdgeTileSize} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The exponent of the delta step size (2 based). A delta of 4 will produce
+  /// a real delta step size of 16.
+  unsigned delta() const { return delta_; }
+  ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
+
+  static KShortestPathsPlan DeltaTile(
+      unsigned delta = kDefaultDelta,
+      ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
+    return {kCPU, kDeltaTile, delta, edge_tile_size};
+  }
+
+  static KShortestPathsPlan DeltaStep(unsigned delta = kDefaultDelta) {
+    return {kCPU, kDeltaStep, delta, 0};
+  }
+
+  static KShortestPathsPlan DeltaStepBarrier(unsigned delta = kDefaultDelta) {
+    return {kCPU, kDeltaStepBarrier, delta, 0};
+  }
+};
+
+/// One of the k shortest paths from the source to the destination.
+struct KATANA_EXPORT KShortestPath {
+  /// Total weight of the path.
+  double weight;
+  /// The node IDs along the path, from the source to the destination
+  /// inclusive.
+  std::vector<uint32_t> nodes;
+};
+
+/// Compute up to num_paths shortest paths from source_node to
+/// destination_node using the edge weights in edge_weight_property_name
+/// (which may be a 32- or 64-bit signed or unsigned int, or a float or
+/// double). All k paths are discovered in a single priority-ordered pass
+/// that shares one search tree across the paths, so a query costs about as
+/// much as one SSSP run instead of k of them. The returned paths are sorted
+/// by weight in ascending order; fewer than num_paths paths are returned if
+/// the destination is not reachable through enough distinct paths.
+KATANA_EXPORT Result<std::vector<KShortestPath>> KShortestPaths(
+    PropertyGraph* pg, size_t source_node, size_t destination_node,
+    const std::string& edge_weight_property_name, size_t num_paths,
+    KShortestPathsPlan plan = {});
+
+struct KATANA_EXPORT KShortestPathsStatistics {
+  /// Number of paths actually found (at most the requested k).
+  uint64_t number_of_paths;
+  /// Weight of the shortest returned path; 0 if no path was found.
+  double shortest_path_weight;
+  /// Weight of the longest returned path; 0 if no path was found.
+  double longest_path_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static KShortestPathsStatistics Compute(
+      const std::vector<KShortestPath>& paths);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -16,7 +16,7 @@ namespace katana::analytics {
 class KTrussPlan : public Plan {
 public:
   /// Algorithm selectors for KCore
-  enum Algorithm { kBsp, kBspJacobi, kBspCoreThenTruss };
+  enum Algorithm { kBsp, kBspJacobi, kBspCoreThenTruss, kSupportIndexed };
 
   // Don't allow people to directly construct these, so as to have only one
   // consistent way to configure.
@@ -39,6 +39,12 @@ public:
 
   /// Compute k-1 core and then k-truss algorithm.
   static KTrussPlan BspCoreThenTruss() { return {kCPU, kBspCoreThenTruss}; }
+
+  /// Support-indexed algorithm: count the support of each edge once,
+  /// maintain it with atomic decrements as edges are removed, and peel
+  /// from a worklist of unsupported edges instead of re-intersecting
+  /// adjacency lists every round.
+  static KTrussPlan SupportIndexed() { return {kCPU, kSupportIndexed}; }
 };
 
 /// Compute the k-truss for pg. The pg is expected to be
@@ -53,9 +59,14 @@ KATANA_EXPORT Result<void> KTruss(
     PropertyGraph* pg, uint32_t k_truss_number,
     const std::string& output_property_name, KTrussPlan plan = KTrussPlan());
 
+/// Check that every edge left in the truss is supported by at least
+/// k_truss_number - 2 triangles of remaining edges. This recounts support
+/// from scratch, so it can cost as much as the algorithm itself; when
+/// num_samples is non-zero only the edges of that many randomly chosen
+/// nodes are checked.
 KATANA_EXPORT Result<void> KTrussAssertValid(
     PropertyGraph* pg, uint32_t k_truss_number,
-    const std::string& property_name);
+    const std::string& property_name, uint32_t num_samples = 0);
 
 struct KATANA_EXPORT KTrussStatistics {
   /// Total number of edges left in the truss.
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_LOUVAINCLUSTERING_LOUVAINCLUSTERING_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/analytics/Plan.h"
@@ -23,6 +25,7 @@ public:
   static constexpr double kDefaultModularityThresholdTotal = 0.01;
   static const uint32_t kDefaultMaxIterations = 10;
   static const uint32_t kDefaultMinGraphSize = 100;
+  static constexpr double kDefaultResolution = 1.0;
 
   // Don't allow people to directly construct these, so as to have only one
   // consistent way to configure.
@@ -33,18 +36,22 @@ private:
   double modularity_threshold_total_;
   uint32_t max_iterations_;
   uint32_t min_graph_size_;
+  double resolution_;
+  std::string checkpoint_location_;
+  uint32_t checkpoint_interval_{0};
 
   LouvainClusteringPlan(
       Architecture architecture, Algorithm algorithm, bool enable_vf,
       double modularity_threshold_per_round, double modularity_threshold_total,
-      uint32_t max_iterations, uint32_t min_graph_size)
+      uint32_t max_iterations, uint32_t min_graph_size, double resolution)
       : Plan(architecture),
         algorithm_(algorithm),
         enable_vf_(enable_vf),
         modularity_threshold_per_round_(modularity_threshold_per_round),
         modularity_threshold_total_(modularity_threshold_total),
         max_iterations_(max_iterations),
-        min_graph_size_(min_graph_size) {}
+        min_graph_size_(min_graph_size),
+        resolution_(resolution) {}
 
 public:
   LouvainClusteringPlan()
@@ -55,7 +62,8 @@ public:
             kDefaultModularityThresholdPerRound,
             kDefaultModularityThresholdTotal,
             kDefaultMaxIterations,
-            kDefaultMinGraphSize} {}
+            kDefaultMinGraphSize,
+            kDefaultResolution} {}
 
   Algorithm algorithm() const { return algorithm_; }
   /// Enable vertex following optimization
@@ -72,6 +80,24 @@ public:
   uint32_t max_iterations() const { return max_iterations_; }
   /// Minimum coarsened graph size
   uint32_t min_graph_size() const { return min_graph_size_; }
+  /// Resolution (gamma) scaling the null-model term of modularity.
+  /// 1.0 gives classic modularity; larger values favor smaller communities.
+  double resolution() const { return resolution_; }
+
+  /// Snapshot the cluster assignment and phase counters to storage every
+  /// interval_rounds phases so a preempted run can resume. A run that
+  /// finds a snapshot under location rebuilds the coarsened working graph
+  /// from the saved assignment and continues from the saved phase instead
+  /// of restarting. Snapshots are written asynchronously while the next
+  /// phase computes.
+  void EnableCheckpointing(std::string location, uint32_t interval_rounds) {
+    checkpoint_location_ = std::move(location);
+    checkpoint_interval_ = interval_rounds;
+  }
+  const std::string& checkpoint_location() const {
+    return checkpoint_location_;
+  }
+  uint32_t checkpoint_interval() const { return checkpoint_interval_; }
 
   /// Nondeterministic algorithm for louvain clustering
   /// usign katana do_all
@@ -81,7 +107,8 @@ public:
           kDefaultModularityThresholdPerRound,
       double modularity_threshold_total = kDefaultModularityThresholdTotal,
       uint32_t max_iterations = kDefaultMaxIterations,
-      uint32_t min_graph_size = kDefaultMinGraphSize) {
+      uint32_t min_graph_size = kDefaultMinGraphSize,
+      double resolution = kDefaultResolution) {
     return {
         kCPU,
         kDoAll,
@@ -89,7 +116,8 @@ public:
         modularity_threshold_per_round,
         modularity_threshold_total,
         max_iterations,
-        min_graph_size};
+        min_graph_size,
+        resolution};
   }
 
   /// Deterministic algorithm for louvain clustering
@@ -100,7 +128,8 @@ public:
           kDefaultModularityThresholdPerRound,
       double modularity_threshold_total = kDefaultModularityThresholdTotal,
       uint32_t max_iterations = kDefaultMaxIterations,
-      uint32_t min_graph_size = kDefaultMinGraphSize) {
+      uint32_t min_graph_size = kDefaultMinGraphSize,
+      double resolution = kDefaultResolution) {
     return {
         kCPU,
         kDeterministic,
@@ -108,7 +137,8 @@ public:
         modularity_threshold_per_round,
         modularity_threshold_total,
         max_iterations,
-        min_graph_size};
+        min_graph_size,
+        resolution};
   }
 };
 
@@ -123,6 +153,21 @@ KATANA_EXPORT Result<void> LouvainClustering(
     PropertyGraph* pg, const std::string& edge_weight_property_name,
     const std::string& output_property_name, LouvainClusteringPlan plan = {});
 
+/// Compute the Louvain Clustering for pg once per resolution in resolutions,
+/// storing the clustering computed at resolutions[i] in the property named
+/// output_property_names[i] (as uint32_t). The output properties are created
+/// by this function and may not exist before the call.
+/// The resolutions must be given in decreasing order: each clustering can
+/// then only merge communities of the previous one, so the sweep continues
+/// from the previous resolution's coarsened graph instead of restarting the
+/// level hierarchy from the original graph. The resolution of plan is
+/// ignored.
+KATANA_EXPORT Result<void> LouvainClusteringResolutionSweep(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::vector<double>& resolutions,
+    const std::vector<std::string>& output_property_names,
+    LouvainClusteringPlan plan = {});
+
 KATANA_EXPORT Result<void> LouvainClusteringAssertValid(
     PropertyGraph* pg, const std::string& edge_weight_property_name,
     const std::string& output_property_name);
@@ -16,6 +16,8 @@ class MatrixCompletionPlan : public Plan {
 public:
   enum Algorithm {
     kSGDByItems,
+    kSGDByItemsHogwild,
+    kSGDBlockEdge,
   };
 
   enum Step { kBold, kBottou, kIntel, kInverse, kPurdue };
@@ -31,6 +33,8 @@ public:
   static constexpr bool kDefaultUseExactError = false;
   static constexpr bool kDefaultUseDetInit = false;
   static constexpr Step kDefaultLearningRateFunction = kBold;
+  static constexpr uint32_t kDefaultItemsPerBlock = 350;
+  static constexpr uint32_t kDefaultUsersPerBlock = 2048;
 
 private:
   Algorithm algorithm_;
@@ -45,13 +49,17 @@ private:
   bool use_exact_error_;
   bool use_det_init_;
   Step learning_rate_function_;
+  uint32_t items_per_block_;
+  uint32_t users_per_block_;
 
   MatrixCompletionPlan(
       Architecture architecture, Algorithm algorithm, double learning_rate,
       double decay_rate, double lambda, double tolerance,
       bool use_same_latent_vector, uint32_t max_updates,
       uint32_t updates_per_edge, uint32_t fixed_rounds, bool use_exact_error,
-      bool use_det_init, Step learning_rate_function)
+      bool use_det_init, Step learning_rate_function,
+      uint32_t items_per_block = kDefaultItemsPerBlock,
+      uint32_t users_per_block = kDefaultUsersPerBlock)
       : Plan(architecture),
         algorithm_(algorithm),
         learning_rate_(learning_rate),
@@ -64,7 +72,9 @@ private:
         fixed_rounds_(fixed_rounds),
         use_exact_error_(use_exact_error),
         use_det_init_(use_det_init),
-        learning_rate_function_(learning_rate_function) {}
+        learning_rate_function_(learning_rate_function),
+        items_per_block_(items_per_block),
+        users_per_block_(users_per_block) {}
 
 public:
   MatrixCompletionPlan()
@@ -95,6 +105,8 @@ public:
   bool useExactError() const { return use_exact_error_; }
   bool useDetInit() const { return use_det_init_; }
   Step learningRateFunction() const { return learning_rate_function_; }
+  uint32_t itemsPerBlock() const { return items_per_block_; }
+  uint32_t usersPerBlock() const { return users_per_block_; }
 
   static MatrixCompletionPlan SGDByItems(
       double learning_rate = kDefaultLearningRate,
@@ -122,6 +134,76 @@ public:
         use_det_init,
         learning_rate_function};
   }
+
+  /// SGD over item nodes with Hogwild-style unsynchronized updates: latent
+  /// vector components are read and written with plain relaxed accesses
+  /// instead of atomic read-modify-writes. Occasional lost component updates
+  /// are tolerated, which SGD absorbs in later rounds; in exchange the
+  /// latent-vector contention that limits kSGDByItems at high thread counts
+  /// disappears.
+  static MatrixCompletionPlan SGDByItemsHogwild(
+      double learning_rate = kDefaultLearningRate,
+      double decay_rate = kDefaultDecayRate, double lambda = kDefaultLambda,
+      double tolerance = kDefaultTolerance,
+      bool use_same_latent_vector = kDefaultUseSameLatentVector,
+      uint32_t max_updates = kDefaultMaxUpdates,
+      uint32_t updates_per_edge = kDefaultUpdatesPerEdge,
+      uint32_t fixed_rounds = kDefaultFixedRounds,
+      bool use_exact_error = kDefaultUseExactError,
+      bool use_det_init = kDefaultUseDetInit,
+      Step learning_rate_function = kDefaultLearningRateFunction) {
+    return {
+        kCPU,
+        kSGDByItemsHogwild,
+        learning_rate,
+        decay_rate,
+        lambda,
+        tolerance,
+        use_same_latent_vector,
+        max_updates,
+        updates_per_edge,
+        fixed_rounds,
+        use_exact_error,
+        use_det_init,
+        learning_rate_function};
+  }
+
+  /// SGD over tiles of the bipartite edge set. The item and user ranges are
+  /// divided into items_per_block x users_per_block tiles and each thread
+  /// locks the item and user rows of its tile, so no two threads ever update
+  /// the same latent vector concurrently and no atomics are needed inside a
+  /// tile. Requires the edge list of each node to be sorted by destination
+  /// ID.
+  static MatrixCompletionPlan SGDBlockEdge(
+      double learning_rate = kDefaultLearningRate,
+      double decay_rate = kDefaultDecayRate, double lambda = kDefaultLambda,
+      double tolerance = kDefaultTolerance,
+      bool use_same_latent_vector = kDefaultUseSameLatentVector,
+      uint32_t max_updates = kDefaultMaxUpdates,
+      uint32_t updates_per_edge = kDefaultUpdatesPerEdge,
+      uint32_t fixed_rounds = kDefaultFixedRounds,
+      bool use_exact_error = kDefaultUseExactError,
+      bool use_det_init = kDefaultUseDetInit,
+      Step learning_rate_function = kDefaultLearningRateFunction,
+      uint32_t items_per_block = kDefaultItemsPerBlock,
+      uint32_t users_per_block = kDefaultUsersPerBlock) {
+    return {
+        kCPU,
+        kSGDBlockEdge,
+        learning_rate,
+        decay_rate,
+        lambda,
+        tolerance,
+        use_same_latent_vector,
+        max_updates,
+        updates_per_edge,
+        fixed_rounds,
+        use_exact_error,
+        use_det_init,
+        learning_rate_function,
+        items_per_block,
+        users_per_block};
+  }
 };
 
 /// Performs matrix completion using stochastic gradient descent (SGD) algortihm
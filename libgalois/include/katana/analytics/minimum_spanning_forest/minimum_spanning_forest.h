@@ -0,0 +1,75 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+
+#include <iostream>
+
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for minimum spanning forest, specifying the
+/// algorithm and any parameters associated with it.
+class MinimumSpanningForestPlan : public Plan {
+public:
+  /// Algorithm selectors for minimum spanning forest
+  enum Algorithm { kBoruvka };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  MinimumSpanningForestPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  MinimumSpanningForestPlan() : MinimumSpanningForestPlan{kCPU, kBoruvka} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Bulk-synchronous Boruvka: every round each component nominates its
+  /// lightest outgoing edge, components are merged along the nominated edges
+  /// with lock-free union-find, and the surviving candidate edges are
+  /// compacted for the next round. Ties between equal weights are broken by
+  /// edge ID, so the computed forest is deterministic.
+  static MinimumSpanningForestPlan Boruvka() { return {kCPU, kBoruvka}; }
+};
+
+/// Compute a minimum spanning forest of pg using the edge weights in
+/// edge_weight_property_name. The pg is expected to be symmetric.
+/// The canonical copy (the one with the lower source ID) of each undirected
+/// edge in the forest is marked with 1 in the uint8 edge property named by
+/// output_property_name; all other edges are marked with 0.
+/// Equal-weight ties are broken by edge ID, so the marked forest is the
+/// unique minimum under the (weight, edge ID) order and is independent of
+/// the parallel schedule.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> MinimumSpanningForest(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    MinimumSpanningForestPlan plan = {});
+
+struct KATANA_EXPORT MinimumSpanningForestStatistics {
+  /// Total number of trees in the forest, counting isolated nodes as
+  /// trivial trees.
+  uint64_t number_of_trees;
+  /// Total number of undirected edges in the forest.
+  uint64_t number_of_forest_edges;
+  /// Sum of the weights of the forest edges.
+  double total_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MinimumSpanningForestStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
@@ -0,0 +1,138 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_NEIGHBORSAMPLING_NEIGHBORSAMPLING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_NEIGHBORSAMPLING_NEIGHBORSAMPLING_H_
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan for neighbor sampling, specifying how edges are
+/// drawn at each hop of the expansion.
+class NeighborSamplingPlan : public Plan {
+public:
+  /// Algorithm selectors for neighbor sampling
+  enum Algorithm {
+    /// Sample each hop's edges uniformly without replacement.
+    kUniform,
+    /// Sample each hop's edges with probability proportional to an edge
+    /// weight property, with replacement.
+    kWeighted,
+  };
+
+  static const Algorithm kDefaultAlgorithm = kUniform;
+  static const uint32_t kDefaultFanout = 10;
+  static const uint32_t kDefaultNumberOfHops = 2;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  std::vector<uint32_t> fanouts_;
+
+  NeighborSamplingPlan(
+      Architecture architecture, Algorithm algorithm,
+      std::vector<uint32_t> fanouts)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        fanouts_(std::move(fanouts)) {}
+
+public:
+  NeighborSamplingPlan()
+      : NeighborSamplingPlan{
+            kCPU, kDefaultAlgorithm,
+            std::vector<uint32_t>(kDefaultNumberOfHops, kDefaultFanout)} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Per-hop bound on the number of edges sampled out of each frontier
+  /// node; the number of hops is the size of this vector.
+  const std::vector<uint32_t>& fanouts() const { return fanouts_; }
+
+  /// At each hop keep at most the fanout's worth of edges per frontier
+  /// node, drawn uniformly without replacement; nodes with degree at or
+  /// below the fanout keep all their edges.
+  static NeighborSamplingPlan Uniform(
+      std::vector<uint32_t> fanouts =
+          std::vector<uint32_t>(kDefaultNumberOfHops, kDefaultFanout)) {
+    return {kCPU, kUniform, std::move(fanouts)};
+  }
+
+  /// Like Uniform, but edges are drawn with probability proportional to
+  /// the edge weight property passed to SampleNeighborhoods, with
+  /// replacement, so a batch can contain the same edge more than once.
+  /// This is the weighted counterpart of the biased option in
+  /// random_walks; per-node prefix sums replace the global alias tables
+  /// because each node's distribution is sampled only fanout times.
+  static NeighborSamplingPlan Weighted(
+      std::vector<uint32_t> fanouts =
+          std::vector<uint32_t>(kDefaultNumberOfHops, kDefaultFanout)) {
+    return {kCPU, kWeighted, std::move(fanouts)};
+  }
+};
+
+/// One sampled mini-batch: a compact CSR over locally renumbered nodes
+/// plus the gathered property rows, ready for Arrow C-data export to a
+/// training framework.
+///
+/// Local node ids are dense; the batch's seeds occupy ids [0, num_seeds)
+/// in seed order, so model output rows line up with the seeds without a
+/// lookup. node_ids maps a local id back to the original graph node and
+/// edge_property_indices maps a local edge back to its original property
+/// row.
+struct KATANA_EXPORT NeighborSampleBatch {
+  /// CSR out-index array over local node ids; adj_indices[n] is one past
+  /// the last edge of local node n.
+  std::vector<uint64_t> adj_indices;
+  /// CSR destination array of local node ids.
+  std::vector<uint32_t> dests;
+  /// Local node id to original graph node id.
+  std::vector<PropertyGraph::Node> node_ids;
+  /// Local edge id to original edge property row.
+  std::vector<uint64_t> edge_property_indices;
+  /// The first num_seeds local nodes are this batch's seeds.
+  uint32_t num_seeds{0};
+  /// Requested node property columns, one row per local node; null if no
+  /// node properties were requested.
+  std::shared_ptr<arrow::Table> node_features;
+  /// Requested edge property columns, one row per local edge; null if no
+  /// edge properties were requested.
+  std::shared_ptr<arrow::Table> edge_features;
+};
+
+/**
+ * Sample fanout-bounded k-hop neighborhoods around the given seeds and
+ * return one mini-batch per batch_size seeds.
+ *
+ * Each batch expands its seeds hop by hop over the graph topology,
+ * keeping at most plan.fanouts()[hop] edges per frontier node, and emits
+ * the union as a renumbered CSR together with the requested node and
+ * edge property rows gathered through arrow Take. Batches are sampled in
+ * parallel with per-thread buffers and are independent of each other; a
+ * node reached from several batches appears in each of them.
+ *
+ * @param pg The graph to sample from.
+ * @param seeds Seed nodes, split into batches in the given order.
+ * @param batch_size Number of seeds per batch; the last batch may be
+ *    smaller.
+ * @param node_property_names Node property columns to gather per batch;
+ *    empty for topology-only batches.
+ * @param edge_property_names Edge property columns to gather per batch.
+ * @param edge_weight_property_name Edge weight column for the weighted
+ *    plan; ignored by the uniform plan, required otherwise.
+ * @param plan
+ */
+KATANA_EXPORT katana::Result<std::vector<NeighborSampleBatch>>
+SampleNeighborhoods(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::PropertyGraph::Node>& seeds,
+    uint32_t batch_size,
+    const std::vector<std::string>& node_property_names = {},
+    const std::vector<std::string>& edge_property_names = {},
+    const std::string& edge_weight_property_name = "",
+    NeighborSamplingPlan plan = {});
+
+}  // namespace katana::analytics
+
+#endif
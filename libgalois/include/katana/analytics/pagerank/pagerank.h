@@ -3,14 +3,28 @@
 
 #include <iostream>
 
+#include "katana/NUMAArray.h"
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
 #include "katana/analytics/Plan.h"
 
+namespace katana {
+class OutOfCorePropertyGraph;
+}
+
 namespace katana::analytics {
 
 /// A computational plan to for Page Rank, specifying the algorithm and any
 /// parameters associated with it.
+///
+/// Every algorithm can be warm-started from the ranks of a previous run by
+/// naming an existing node property through initial_rank_property_name. The
+/// residual-style algorithms seed their residuals with the mismatch between
+/// the old ranks and the current graph, so stale ranks on a slightly changed
+/// graph still converge to the same answer as a cold start, typically in far
+/// fewer iterations. The old ranks must come from the same algorithm family
+/// (pull topological ranks are normalized differently from the residual
+/// ones).
 class PagerankPlan : public Plan {
 public:
   enum Algorithm {
@@ -18,6 +32,7 @@ public:
     kPullResidual,
     kPushSynchronous,
     kPushAsynchronous,
+    kPushPullFrontier,
   };
 
   static constexpr double kDefaultTolerance = 1.0e-3;
@@ -29,16 +44,21 @@ private:
   float tolerance_;
   unsigned int max_iterations_;
   float alpha_;
+  std::string initial_rank_property_name_;
+  std::string checkpoint_location_;
+  unsigned int checkpoint_interval_{0};
 
 public:
   PagerankPlan(
       Architecture architecture, Algorithm algorithm, float tolerance,
-      unsigned int max_iterations, float alpha)
+      unsigned int max_iterations, float alpha,
+      std::string initial_rank_property_name = "")
       : Plan(architecture),
         algorithm_(algorithm),
         tolerance_(tolerance),
         max_iterations_(max_iterations),
-        alpha_(alpha) {}
+        alpha_(alpha),
+        initial_rank_property_name_(std::move(initial_rank_property_name)) {}
 
   constexpr static const unsigned kChunkSize = 16U;
 
@@ -55,6 +75,28 @@ public:
   unsigned int max_iterations() const { return max_iterations_; }
   float alpha() const { return alpha_; }
   float initial_residual() const { return 1 - alpha_; }
+  /// The node property holding ranks from a previous run, or the empty
+  /// string for a cold start.
+  const std::string& initial_rank_property_name() const {
+    return initial_rank_property_name_;
+  }
+
+  /// Snapshot the iteration state to storage every interval_rounds rounds
+  /// so a preempted run can resume. A run that finds a snapshot under
+  /// location resumes from it, so restarting with the same plan and graph
+  /// picks up where the killed run left off. Snapshots are written
+  /// asynchronously while the next rounds compute. Supported by the pull
+  /// algorithms, which iterate in rounds; the asynchronous push algorithm
+  /// has no round boundary to snapshot at and ignores this option.
+  void EnableCheckpointing(
+      std::string location, unsigned int interval_rounds) {
+    checkpoint_location_ = std::move(location);
+    checkpoint_interval_ = interval_rounds;
+  }
+  const std::string& checkpoint_location() const {
+    return checkpoint_location_;
+  }
+  unsigned int checkpoint_interval() const { return checkpoint_interval_; }
 
   /// Topological pull algorithm
   ///
@@ -62,8 +104,11 @@ public:
   static PagerankPlan PullTopological(
       float tolerance = kDefaultTolerance,
       unsigned int max_iterations = kDefaultMaxIterations,
-      float alpha = kDefaultAlpha) {
-    return {kCPU, kPullTopological, tolerance, max_iterations, alpha};
+      float alpha = kDefaultAlpha,
+      std::string initial_rank_property_name = "") {
+    return {
+        kCPU, kPullTopological, tolerance, max_iterations, alpha,
+        std::move(initial_rank_property_name)};
   }
 
   /// Delta-residual pull algorithm
@@ -72,8 +117,11 @@ public:
   static PagerankPlan PullResidual(
       float tolerance = kDefaultTolerance,
       unsigned int max_iterations = kDefaultMaxIterations,
-      float alpha = kDefaultAlpha) {
-    return {kCPU, kPullResidual, tolerance, max_iterations, alpha};
+      float alpha = kDefaultAlpha,
+      std::string initial_rank_property_name = "") {
+    return {
+        kCPU, kPullResidual, tolerance, max_iterations, alpha,
+        std::move(initial_rank_property_name)};
   }
 
   /// Asynchronous push algorithm
@@ -85,8 +133,11 @@ public:
   /// system issues, and lessons learned. In: European Conference on Parallel
   /// Processing. Springer, Berlin, Heidelberg, 2015. p. 438-450.
   static PagerankPlan PushAsynchronous(
-      float tolerance = kDefaultTolerance, float alpha = kDefaultAlpha) {
-    return {kCPU, kPushAsynchronous, tolerance, 0, alpha};
+      float tolerance = kDefaultTolerance, float alpha = kDefaultAlpha,
+      std::string initial_rank_property_name = "") {
+    return {
+        kCPU, kPushAsynchronous, tolerance, 0, alpha,
+        std::move(initial_rank_property_name)};
   }
 
   /// Synchronous push algorithm
@@ -100,8 +151,30 @@ public:
   static PagerankPlan PushSynchronous(
       float tolerance = kDefaultTolerance,
       unsigned int max_iterations = kDefaultMaxIterations,
-      float alpha = kDefaultAlpha) {
-    return {kCPU, kPushSynchronous, tolerance, max_iterations, alpha};
+      float alpha = kDefaultAlpha,
+      std::string initial_rank_property_name = "") {
+    return {
+        kCPU, kPushSynchronous, tolerance, max_iterations, alpha,
+        std::move(initial_rank_property_name)};
+  }
+
+  /// Residual push-pull algorithm with converged-node filtering
+  ///
+  /// Nodes whose residual stays below the tolerance are filtered out of each
+  /// iteration through a DynamicBitset frontier, so late iterations only
+  /// touch the few nodes still changing. Each iteration propagates the
+  /// surviving residuals by push or by pull over the bidirectional view,
+  /// chosen by the frontier's edge density (Beamer's direction-optimization
+  /// heuristic). Unlike the pull algorithms, this runs on the original
+  /// (untransposed) graph.
+  static PagerankPlan PushPullFrontier(
+      float tolerance = kDefaultTolerance,
+      unsigned int max_iterations = kDefaultMaxIterations,
+      float alpha = kDefaultAlpha,
+      std::string initial_rank_property_name = "") {
+    return {
+        kCPU, kPushPullFrontier, tolerance, max_iterations, alpha,
+        std::move(initial_rank_property_name)};
   }
 };
 
@@ -112,8 +185,20 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyGraph* pg, const std::string& output_property_name,
     PagerankPlan plan = {});
 
+/// Compute the Page Rank of each node of a graph too large to load,
+/// streaming edge segments through an OutOfCorePropertyGraph. Ranks are
+/// returned in \p ranks (indexed by node ID) instead of being written to a
+/// property. Only the tolerance, alpha, and max_iterations of the plan
+/// apply; the schedule is always synchronous push.
+KATANA_EXPORT Result<void> PagerankOutOfCore(
+    OutOfCorePropertyGraph* graph, NUMAArray<float>* ranks,
+    PagerankPlan plan = {});
+
+/// Check that every rank is finite and non-negative. When num_samples is
+/// non-zero only that many randomly chosen nodes are checked.
 KATANA_EXPORT Result<void> PagerankAssertValid(
-    PropertyGraph* pg, const std::string& property_name);
+    PropertyGraph* pg, const std::string& property_name,
+    uint32_t num_samples = 0);
 
 struct KATANA_EXPORT PagerankStatistics {
   /// The maximum similarity excluding the comparison node.
@@ -0,0 +1,115 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+
+#include <string>
+#include <vector>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan for streaming graph partitioning, specifying the
+/// placement heuristic and any parameters associated with it.
+class PartitionPlan : public Plan {
+public:
+  enum Algorithm {
+    kLinearDeterministicGreedy,
+    kFennel,
+  };
+
+  static const uint32_t kDefaultRefinementPasses = 0;
+  static constexpr double kDefaultBalanceSlack = 0.05;
+  static constexpr double kDefaultFennelGamma = 1.5;
+
+private:
+  Algorithm algorithm_;
+  uint32_t refinement_passes_;
+  double balance_slack_;
+  double fennel_gamma_;
+
+  PartitionPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t refinement_passes, double balance_slack, double fennel_gamma)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        refinement_passes_(refinement_passes),
+        balance_slack_(balance_slack),
+        fennel_gamma_(fennel_gamma) {}
+
+public:
+  PartitionPlan()
+      : PartitionPlan{
+            kCPU, kLinearDeterministicGreedy, kDefaultRefinementPasses,
+            kDefaultBalanceSlack, kDefaultFennelGamma} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// Number of whole-graph refinement sweeps run after the streaming pass.
+  uint32_t refinement_passes() const { return refinement_passes_; }
+  /// Allowed imbalance: a partition may hold up to
+  /// (1 + balance_slack) * num_nodes / num_partitions nodes.
+  double balance_slack() const { return balance_slack_; }
+  /// Exponent of Fennel's partition-size penalty term.
+  double fennel_gamma() const { return fennel_gamma_; }
+
+  /// Linear deterministic greedy (LDG) placement: a node goes to the
+  /// partition holding most of its already-placed neighbors, scaled by that
+  /// partition's remaining capacity.
+  static PartitionPlan LinearDeterministicGreedy(
+      uint32_t refinement_passes = kDefaultRefinementPasses,
+      double balance_slack = kDefaultBalanceSlack) {
+    return {
+        kCPU, kLinearDeterministicGreedy, refinement_passes, balance_slack,
+        kDefaultFennelGamma};
+  }
+
+  /// Fennel placement: neighbor affinity minus a superlinear penalty on the
+  /// target partition's current size, trading a little balance for fewer
+  /// cut edges than LDG on skewed graphs.
+  static PartitionPlan Fennel(
+      double gamma = kDefaultFennelGamma,
+      uint32_t refinement_passes = kDefaultRefinementPasses,
+      double balance_slack = kDefaultBalanceSlack) {
+    return {kCPU, kFennel, refinement_passes, balance_slack, gamma};
+  }
+};
+
+/// Assign every node of pg to one of num_partitions parts in a single
+/// parallel streaming pass over the nodes, followed by the plan's optional
+/// refinement sweeps that move nodes to the partition holding most of their
+/// neighbors when capacity allows. Threads stream disjoint node blocks
+/// concurrently and observe each other's placements, so the result is not
+/// deterministic across runs, only capacity-bounded.
+///
+/// \returns the partition id of every node
+KATANA_EXPORT Result<std::vector<uint32_t>> StreamingPartition(
+    PropertyGraph* pg, uint32_t num_partitions, PartitionPlan plan = {});
+
+/// Partition pg with StreamingPartition and write one RDG per partition
+/// under output_base ("<output_base>/part_<i>").
+///
+/// Each partition RDG is an outgoing edge cut: it holds its owned nodes
+/// first (ascending by original id), then degree-zero mirror copies of the
+/// remote destinations of its owned nodes' edges, and every out-edge of an
+/// owned node. Local nodes (owned and mirror) and edges carry every loaded
+/// property of the original graph, and an extra uint64 node property named
+/// kPartitionGlobalIDPropertyName maps every local node (owned or mirror)
+/// back to its id in the original graph. PartitionMetadata records the
+/// global and local node/edge counts.
+///
+/// \param command_line The command line used to invoke the calling program,
+///    recorded in each RDG's provenance.
+KATANA_EXPORT Result<void> StreamingPartitionToRdgs(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_base, const std::string& command_line,
+    PartitionPlan plan = {});
+
+/// Name of the node property written by StreamingPartitionToRdgs holding
+/// each local node's id in the original graph.
+KATANA_EXPORT extern const char* kPartitionGlobalIDPropertyName;
+
+}  // namespace katana::analytics
+
+#endif
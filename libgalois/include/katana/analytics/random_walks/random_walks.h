@@ -17,7 +17,7 @@ namespace katana::analytics {
 class RandomWalksPlan : public Plan {
 public:
   /// Algorithm selectors for random walks
-  enum Algorithm { kNode2Vec, kEdge2Vec };
+  enum Algorithm { kNode2Vec, kEdge2Vec, kBiasedNode2Vec };
 
   static const Algorithm kDefaultAlgorithm = kNode2Vec;
   static const uint32_t kDefaultWalkLength = 1;
@@ -112,6 +112,27 @@ public:
         1};
   }
 
+  /// Node2Vec walks sampled from per-node alias tables instead of
+  /// acceptance-rejection over uniform edge picks. The alias tables are
+  /// built in parallel up front and support non-uniform edge weights (see
+  /// BiasedRandomWalks); the p/q second-order bias is applied by rejection
+  /// on top of the table draw, so each step stays O(1) expected time.
+  static RandomWalksPlan BiasedNode2Vec(
+      uint32_t walk_length = kDefaultWalkLength,
+      uint32_t number_of_walks = kDefaultNumberOfWalks,
+      double backward_probability = kDefaultBackwardProbability,
+      double forward_probability = kDefaultForwardProbability) {
+    return {
+        kCPU,
+        kBiasedNode2Vec,
+        walk_length,
+        number_of_walks,
+        backward_probability,
+        forward_probability,
+        0,
+        1};
+  }
+
   /// Edge2Vec algorithm to generate random walks on the graph.
   /// Takes the heterogeneity of the edges into account
   static RandomWalksPlan Edge2Vec(
@@ -140,6 +161,16 @@ public:
 KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> RandomWalks(
     PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
 
+/// Compute weighted second-order random walks for pg using the plan's p/q
+/// bias (kBiasedNode2Vec). The pg is expected to be symmetric. Neighbors are
+/// drawn proportionally to the weights in the property named
+/// edge_weight_property_name (same types as Sssp accepts); an empty name
+/// means unit weights. The generated random-walks are returned as a vector
+/// of vectors.
+KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> BiasedRandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan = RandomWalksPlan::BiasedNode2Vec());
+
 KATANA_EXPORT Result<void> RandomWalksAssertValid(PropertyGraph* pg);
 
 }  // namespace katana::analytics
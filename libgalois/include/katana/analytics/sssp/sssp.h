@@ -5,6 +5,7 @@
 
 #include "katana/AtomicHelpers.h"
 #include "katana/analytics/Plan.h"
+#include "katana/analytics/TuningProfile.h"
 #include "katana/analytics/Utils.h"
 
 namespace katana::analytics {
@@ -111,6 +112,22 @@ public:
       ptrdiff_t edge_tile_size = kDefaultEdgeTileSize) {
     return {kCPU, kTopologicalTile, 0, edge_tile_size};
   }
+
+  /// Plan from the best-known parameters recorded for "sssp" in \p pg's
+  /// tuning profile. Falls back to the degree-distribution heuristic when
+  /// no algorithm has been recorded for this machine shape.
+  static SsspPlan FromTuningProfile(
+      const TuningProfile& profile, const katana::PropertyGraph* pg) {
+    auto algorithm = profile.Get("sssp", "algorithm");
+    if (!algorithm) {
+      return SsspPlan{pg};
+    }
+    return {
+        kCPU, static_cast<Algorithm>(*algorithm),
+        static_cast<unsigned>(profile.GetOr("sssp", "delta", kDefaultDelta)),
+        static_cast<ptrdiff_t>(
+            profile.GetOr("sssp", "edge_tile_size", kDefaultEdgeTileSize))};
+  }
 };
 
 /// Compute the Single-Source Shortest Path for pg starting from start_node.
@@ -126,6 +143,17 @@ KATANA_EXPORT Result<void> Sssp(
     const std::string& edge_weight_property_name,
     const std::string& output_property_name, SsspPlan plan = {});
 
+/// Build a delta-stepping plan whose delta is tuned to the edge-weight
+/// distribution instead of guessed per graph. Samples the property named
+/// edge_weight_property_name (same types as Sssp accepts) and sizes the
+/// bucket width near mean_weight / average_degree, so a node expects O(1)
+/// light-edge relaxations per bucket [Meyer and Sanders, "Delta-stepping: a
+/// parallelizable shortest path algorithm", J. Algorithms 49(1), 2003]. The
+/// returned plan uses the bucket-fusion algorithm (kDeltaStepFusion), which
+/// drains small buckets without global barriers.
+KATANA_EXPORT Result<SsspPlan> AutotuneDeltaSsspPlan(
+    PropertyGraph* pg, const std::string& edge_weight_property_name);
+
 KATANA_EXPORT Result<void> SsspAssertValid(
     PropertyGraph* pg, size_t start_node,
     const std::string& edge_weight_property_name,
@@ -45,8 +45,10 @@ public:
 /**
  * Construct a new sub-graph from the original graph.
  *
- * By default only topology of the sub-graph is constructed.
- * The new sub-graph is independent of the original graph.
+ * The sub-graph carries every loaded node and edge property of the original
+ * graph: property columns are gathered in parallel through the original
+ * property indices of the extracted nodes and edges, so no manual re-join is
+ * needed afterwards. The new sub-graph is independent of the original graph.
  *
  * @param pg The graph to process.
  * @param node_vec Set of node IDs
@@ -57,7 +59,25 @@ SubGraphExtraction(
     katana::PropertyGraph* pg,
     const std::vector<katana::PropertyGraph::Node>& node_vec,
     SubGraphExtractionPlan plan = {});
-// const std::vector<std::string>& node_properties_to_copy, const std::vector<std::string>& edge_properties_to_copy);
+
+/**
+ * Construct a sub-graph like SubGraphExtraction and write it directly into a
+ * new RDG at output_rdg_path, so callers that only want the stored result do
+ * not have to stage the graph through their own writer pipeline.
+ *
+ * @param pg The graph to process.
+ * @param node_vec Set of node IDs
+ * @param output_rdg_path Storage location for the new RDG; fails if it
+ *    already exists.
+ * @param command_line The command line used to invoke the calling program,
+ *    recorded in the RDG's provenance.
+ * @param plan
+ */
+KATANA_EXPORT katana::Result<void> SubGraphExtractionToRdg(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::PropertyGraph::Node>& node_vec,
+    const std::string& output_rdg_path, const std::string& command_line,
+    SubGraphExtractionPlan plan = {});
 
 }  // namespace katana::analytics
 
@@ -0,0 +1,74 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_WEIGHTEDMATCHING_WEIGHTEDMATCHING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_WEIGHTEDMATCHING_WEIGHTEDMATCHING_H_
+
+#include <iostream>
+#include <limits>
+
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// The partner ID stored for nodes that end up unmatched.
+constexpr uint32_t kUnmatchedPartnerId = std::numeric_limits<uint32_t>::max();
+
+/// A computational plan to for weighted matching, specifying the algorithm
+/// and any parameters associated with it.
+class WeightedMatchingPlan : public Plan {
+public:
+  /// Algorithm selectors for weighted matching
+  enum Algorithm { kSuitor };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  WeightedMatchingPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  WeightedMatchingPlan() : WeightedMatchingPlan{kCPU, kSuitor} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Suitor algorithm: every node proposes to its heaviest neighbor whose
+  /// standing offer it can beat, and proposals are installed in a lock-free
+  /// per-node proposal array. A displaced suitor immediately re-proposes to
+  /// its next-best neighbor, so conflicts are resolved inside the work item
+  /// that caused them. Produces a 1/2-approximation of the maximum weight
+  /// matching; ties are broken by node ID so the result does not depend on
+  /// the parallel schedule.
+  static WeightedMatchingPlan Suitor() { return {kCPU, kSuitor}; }
+};
+
+/// Compute an approximate maximum weight matching of pg using the edge
+/// weights in edge_weight_property_name. The pg is expected to be symmetric.
+/// The matched partner of each node is stored in the uint32 node property
+/// named by output_property_name; unmatched nodes store
+/// kUnmatchedPartnerId. The partner relation is symmetric.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> WeightedMatching(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, WeightedMatchingPlan plan = {});
+
+struct KATANA_EXPORT WeightedMatchingStatistics {
+  /// Number of matched node pairs.
+  uint64_t number_of_matched_pairs;
+  /// Sum of the weights of the matched edges.
+  double total_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<WeightedMatchingStatistics> Compute(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+#endif
@@ -0,0 +1,125 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+#include "katana/Barrier.h"
+#include "katana/PerThreadStorage.h"
+
+namespace {
+
+// Wraps two barrier algorithms and switches between them based on measured
+// round length. A barrier's own latency only matters when rounds are short,
+// which is when the combining tree's bounded fan-in wins (a level-synchronous
+// BFS runs thousands of near-empty rounds); for long rounds the default topo
+// barrier is kept. Thread 0 times windows of kWindow rounds and schedules a
+// switch two rounds out, far enough that every thread still agrees on which
+// algorithm serves each round: when thread 0 finishes round r, no other
+// thread can have begun round r + 2, since completing round r + 1 needs
+// thread 0's arrival.
+class AdaptiveBarrier : public katana::Barrier {
+  static constexpr uint64_t kWindow = 64;
+  static constexpr int64_t kShortRoundNanos = 100 * 1000;
+  static constexpr uint64_t kNoSwitch = std::numeric_limits<uint64_t>::max();
+
+  struct PerThread {
+    uint64_t round;
+    katana::Barrier* current;
+  };
+
+  std::unique_ptr<katana::Barrier> topo_;
+  std::unique_ptr<katana::Barrier> combining_;
+
+  katana::PerThreadStorage<PerThread> state_;
+  std::atomic<katana::Barrier*> next_{nullptr};
+  std::atomic<uint64_t> switch_round_{kNoSwitch};
+
+  // thread 0 only
+  katana::Barrier* target_;
+  std::chrono::steady_clock::time_point window_start_;
+
+  void _reinit(unsigned P) {
+    topo_->Reinit(P);
+    combining_->Reinit(P);
+
+    auto& tp = katana::GetThreadPool();
+    for (unsigned i = 0; i < tp.getMaxThreads(); ++i) {
+      PerThread& st = *state_.getRemote(i);
+      st.round = 0;
+      st.current = target_;
+    }
+    next_ = nullptr;
+    switch_round_ = kNoSwitch;
+    window_start_ = std::chrono::steady_clock::time_point();
+  }
+
+  void maybeSwitch(uint64_t completed_round) {
+    auto now = std::chrono::steady_clock::now();
+    if (window_start_ != std::chrono::steady_clock::time_point()) {
+      int64_t avg_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              now - window_start_)
+                              .count() /
+                          kWindow;
+      katana::Barrier* want =
+          (avg_nanos < kShortRoundNanos) ? combining_.get() : topo_.get();
+      if (want != target_) {
+        target_ = want;
+        next_.store(want, std::memory_order_relaxed);
+        switch_round_.store(completed_round + 2, std::memory_order_release);
+      }
+    }
+    window_start_ = now;
+  }
+
+public:
+  AdaptiveBarrier(unsigned v)
+      : topo_(katana::CreateTopoBarrier(v)),
+        combining_(katana::CreateCombiningBarrier(v)),
+        target_(topo_.get()) {
+    _reinit(v);
+  }
+
+  // not safe if any thread is in wait
+  void Reinit(unsigned val) override { _reinit(val); }
+
+  void Wait() override {
+    PerThread& st = *state_.getLocal();
+    uint64_t r = st.round++;
+
+    if (r == switch_round_.load(std::memory_order_acquire)) {
+      st.current = next_.load(std::memory_order_acquire);
+    }
+    st.current->Wait();
+
+    if (katana::ThreadPool::getTID() == 0 && (r + 1) % kWindow == 0) {
+      maybeSwitch(r);
+    }
+  }
+
+  const char* name() const override { return "AdaptiveBarrier"; }
+};
+
+}  // namespace
+
+std::unique_ptr<katana::Barrier>
+katana::CreateAdaptiveBarrier(unsigned active_threads) {
+  return std::make_unique<AdaptiveBarrier>(active_threads);
+}
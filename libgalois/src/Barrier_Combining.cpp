@@ -0,0 +1,139 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "katana/Barrier.h"
+#include "katana/CompilerSpecific.h"
+#include "katana/PerThreadStorage.h"
+
+namespace {
+
+// Hierarchical combining-tree barrier. Every thread has its own tree node;
+// the threads of a socket combine through an arity-kArity tree rooted at the
+// socket leader, and the socket leaders combine through another
+// arity-kArity tree rooted at thread 0. Unlike TopoBarrier, where every
+// thread of a socket hits one shared counter, arrivals here fan in through
+// at most kArity children per node, which keeps arrival latency flat on
+// high-core-count packages.
+class CombiningBarrier : public katana::Barrier {
+  static constexpr unsigned kArity = 4;
+
+  struct TreeNode {
+    // a leader may have up to kArity children in its socket and another
+    // kArity child sockets
+    TreeNode* parent;  // null for thread 0
+    TreeNode* child_pointers[2 * kArity];
+
+    unsigned have_child;
+    std::atomic<unsigned> child_not_ready;
+
+    std::atomic<unsigned> parent_sense;
+  };
+
+  katana::PerThreadStorage<TreeNode> nodes_;
+  katana::PerThreadStorage<unsigned> sense_;
+
+  void addChild(unsigned parent, unsigned child) {
+    TreeNode& p = *nodes_.getRemote(parent);
+    TreeNode& c = *nodes_.getRemote(child);
+    c.parent = &p;
+    p.child_pointers[p.have_child] = &c;
+    ++p.have_child;
+    ++p.child_not_ready;
+  }
+
+  void _reinit(unsigned P) {
+    auto& tp = katana::GetThreadPool();
+
+    for (unsigned i = 0; i < P; ++i) {
+      TreeNode& n = *nodes_.getRemote(i);
+      n.parent = nullptr;
+      for (auto& c : n.child_pointers) {
+        c = nullptr;
+      }
+      n.have_child = 0;
+      n.child_not_ready = 0;
+      n.parent_sense = 0;
+      *sense_.getRemote(i) = 1;
+    }
+
+    // threads of each socket in pool order; the first is the socket leader
+    std::map<unsigned, std::vector<unsigned>> socket_threads;
+    for (unsigned i = 0; i < P; ++i) {
+      socket_threads[tp.getSocket(i)].push_back(i);
+    }
+
+    std::vector<unsigned> leaders;
+    leaders.reserve(socket_threads.size());
+    for (const auto& [socket, threads] : socket_threads) {
+      leaders.push_back(threads[0]);
+      for (unsigned i = 1; i < threads.size(); ++i) {
+        addChild(threads[(i - 1) / kArity], threads[i]);
+      }
+    }
+
+    // socket leaders combine through their own tree rooted at thread 0
+    for (unsigned i = 1; i < leaders.size(); ++i) {
+      addChild(leaders[(i - 1) / kArity], leaders[i]);
+    }
+  }
+
+public:
+  CombiningBarrier(unsigned v) { _reinit(v); }
+
+  // not safe if any thread is in wait
+  void Reinit(unsigned val) override { _reinit(val); }
+
+  void Wait() override {
+    TreeNode& n = *nodes_.getLocal();
+    unsigned& s = *sense_.getLocal();
+
+    // combine arrivals up the tree
+    while (n.child_not_ready) {
+      katana::asmPause();
+    }
+    n.child_not_ready = n.have_child;
+    if (n.parent) {
+      --n.parent->child_not_ready;
+
+      // wait for signal
+      while (n.parent_sense != s) {
+        katana::asmPause();
+      }
+    }
+
+    // signal children in wakeup tree
+    for (unsigned i = 0; i < n.have_child; ++i) {
+      n.child_pointers[i]->parent_sense = s;
+    }
+    ++s;
+  }
+
+  const char* name() const override { return "CombiningBarrier"; }
+};
+
+}  // namespace
+
+std::unique_ptr<katana::Barrier>
+katana::CreateCombiningBarrier(unsigned active_threads) {
+  return std::make_unique<CombiningBarrier>(active_threads);
+}
@@ -710,7 +710,7 @@ AddLabelInternal(
 // Used to build the out_dests component of the CSR representation
 uint64_t
 SetEdgeID(
-    TopologyState* topology_builder, std::vector<uint64_t>* offsets,
+    TopologyState* topology_builder, katana::PODVector<uint64_t>* offsets,
     size_t index) {
   uint32_t src = topology_builder->sources[index];
   uint64_t base = src ? topology_builder->out_indices[src - 1] : 0;
@@ -792,7 +792,7 @@ ArrowArrays
 RearrangeArray(
     std::shared_ptr<T> builder,
     const std::shared_ptr<arrow::ChunkedArray>& chunked_array,
-    const std::vector<size_t>& mapping, WriterProperties* properties) {
+    const katana::PODVector<size_t>& mapping, WriterProperties* properties) {
   auto chunk_size = properties->chunk_size;
   ArrowArrays chunks;
   auto st = builder->Reserve(chunk_size);
@@ -826,7 +826,7 @@ ArrowArrays
 RearrangeArray(
     std::shared_ptr<arrow::StringBuilder> builder,
     const std::shared_ptr<arrow::ChunkedArray>& chunked_array,
-    const std::vector<size_t>& mapping, WriterProperties* properties) {
+    const katana::PODVector<size_t>& mapping, WriterProperties* properties) {
   auto chunk_size = properties->chunk_size;
   ArrowArrays chunks;
   auto st = builder->Reserve(chunk_size);
@@ -860,7 +860,7 @@ ArrowArrays
 RearrangeArray(
     std::shared_ptr<arrow::BooleanBuilder> builder,
     const std::shared_ptr<arrow::ChunkedArray>& chunked_array,
-    const std::vector<size_t>& mapping, WriterProperties* properties) {
+    const katana::PODVector<size_t>& mapping, WriterProperties* properties) {
   auto chunk_size = properties->chunk_size;
   ArrowArrays chunks;
   auto st = builder->Reserve(chunk_size);
@@ -891,7 +891,7 @@ ArrowArrays
 RearrangeArray(
     const std::shared_ptr<arrow::ListBuilder>& builder, T* type_builder,
     const std::shared_ptr<arrow::ChunkedArray>& chunked_array,
-    const std::vector<size_t>& mapping, WriterProperties* properties) {
+    const katana::PODVector<size_t>& mapping, WriterProperties* properties) {
   auto chunk_size = properties->chunk_size;
   ArrowArrays chunks;
   auto st = builder->Reserve(chunk_size);
@@ -929,7 +929,7 @@ RearrangeArray(
 ArrowArrays
 RearrangeListArray(
     const std::shared_ptr<arrow::ChunkedArray>& list_chunked_array,
-    const std::vector<size_t>& mapping, WriterProperties* properties) {
+    const katana::PODVector<size_t>& mapping, WriterProperties* properties) {
   auto* pool = arrow::default_memory_pool();
   ArrowArrays chunks;
   auto list_type =
@@ -1014,7 +1014,7 @@ RearrangeListArray(
 // mapping
 std::vector<ArrowArrays>
 RearrangeTable(
-    const ChunkedArrays& initial, const std::vector<size_t>& mapping,
+    const ChunkedArrays& initial, const katana::PODVector<size_t>& mapping,
     WriterProperties* properties) {
   std::vector<ArrowArrays> rearranged;
   rearranged.resize(initial.size());
@@ -1095,7 +1095,7 @@ RearrangeTable(
 // mapping, for labels
 std::vector<ArrowArrays>
 RearrangeTypeTable(
-    const ChunkedArrays& initial, const std::vector<size_t>& mapping,
+    const ChunkedArrays& initial, const katana::PODVector<size_t>& mapping,
     WriterProperties* properties) {
   std::vector<ArrowArrays> rearranged;
   rearranged.resize(initial.size());
@@ -1210,8 +1210,7 @@ katana::PropertyGraphBuilder::StartNode(const std::string& id) {
 
 void
 katana::PropertyGraphBuilder::AddNodeID(const std::string& id) {
-  topology_builder_.node_indexes.insert(
-      std::pair<std::string, size_t>(id, nodes_));
+  topology_builder_.node_indexes.insert(id, nodes_);
 }
 
 void
@@ -1312,11 +1311,10 @@ katana::PropertyGraphBuilder::AddEdgeSource(const std::string& source) {
   if (!building_edge_) {
     return;
   }
-  auto src_entry = topology_builder_.node_indexes.find(source);
-  if (src_entry != topology_builder_.node_indexes.end()) {
-    topology_builder_.sources.emplace_back(
-        static_cast<uint32_t>(src_entry->second));
-    topology_builder_.out_indices[src_entry->second]++;
+  const size_t* src_entry = topology_builder_.node_indexes.find(source);
+  if (src_entry != nullptr) {
+    topology_builder_.sources.emplace_back(static_cast<uint32_t>(*src_entry));
+    topology_builder_.out_indices[*src_entry]++;
   } else {
     topology_builder_.sources_intermediate.insert(
         std::pair<size_t, std::string>(edges_, source));
@@ -1330,10 +1328,10 @@ katana::PropertyGraphBuilder::AddEdgeTarget(const std::string& target) {
   if (!building_edge_) {
     return;
   }
-  auto dest_entry = topology_builder_.node_indexes.find(target);
-  if (dest_entry != topology_builder_.node_indexes.end()) {
+  const size_t* dest_entry = topology_builder_.node_indexes.find(target);
+  if (dest_entry != nullptr) {
     topology_builder_.destinations.emplace_back(
-        static_cast<uint32_t>(dest_entry->second));
+        static_cast<uint32_t>(*dest_entry));
   } else {
     topology_builder_.destinations_intermediate.insert(
         std::pair<size_t, std::string>(edges_, target));
@@ -1634,26 +1632,26 @@ katana::PropertyGraphBuilder::ResolveIntermediateIDs() {
   TopologyState* topology = &topology_builder_;
 
   for (auto [index, str_id] : topology->destinations_intermediate) {
-    auto dest_index = topology->node_indexes.find(str_id);
+    const size_t* dest_index = topology->node_indexes.find(str_id);
     uint32_t dest;
     // if node does not exist, create it
-    if (dest_index == topology->node_indexes.end()) {
+    if (dest_index == nullptr) {
       dest = nodes_;
       this->AddNode(str_id);
     } else {
-      dest = static_cast<uint32_t>(dest_index->second);
+      dest = static_cast<uint32_t>(*dest_index);
     }
     topology->destinations[index] = dest;
   }
 
   for (auto [index, str_id] : topology->sources_intermediate) {
-    auto src_index = topology->node_indexes.find(str_id);
+    const size_t* src_index = topology->node_indexes.find(str_id);
     uint32_t src;
-    if (src_index == topology->node_indexes.end()) {
+    if (src_index == nullptr) {
       src = nodes_;
       this->AddNode(str_id);
     } else {
-      src = static_cast<uint32_t>(src_index->second);
+      src = static_cast<uint32_t>(*src_index);
     }
     topology->sources[index] = src;
     topology->out_indices[src]++;
@@ -1668,10 +1666,10 @@ katana::PropertyGraphBuilder::BuildFinalEdges(bool verbose) {
       topology_builder_.out_indices.end(),
       topology_builder_.out_indices.begin());
 
-  std::vector<size_t> edge_mapping;
+  katana::PODVector<size_t> edge_mapping;
   edge_mapping.resize(edges_, std::numeric_limits<uint64_t>::max());
 
-  std::vector<uint64_t> offsets;
+  katana::PODVector<uint64_t> offsets;
   offsets.resize(nodes_, 0);
 
   // get edge indices
@@ -0,0 +1,58 @@
+#include "katana/DegreeDistribution.h"
+
+#include <algorithm>
+
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+
+katana::DegreeDistribution
+katana::DegreeDistribution::Make(const GraphTopology& topo) {
+  size_t num_nodes = topo.num_nodes();
+
+  PODVector<Node> nodes;
+  nodes.resize(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { nodes[i] = static_cast<Node>(i); }, katana::no_stats());
+  katana::ParallelSTL::sort(
+      nodes.begin(), nodes.end(),
+      [&](Node a, Node b) { return topo.degree(a) < topo.degree(b); });
+
+  // Materialize the sorted degrees so queries never touch the topology
+  // again; the summary stays usable after the topology is dropped.
+  PODVector<uint64_t> degrees;
+  degrees.resize(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { degrees[i] = topo.degree(nodes[i]); },
+      katana::no_stats());
+
+  return DegreeDistribution(std::move(nodes), std::move(degrees));
+}
+
+uint64_t
+katana::DegreeDistribution::DegreePercentile(double p) const {
+  KATANA_LOG_DEBUG_ASSERT(p >= 0.0 && p <= 1.0);
+  if (degrees_.empty()) {
+    return 0;
+  }
+  auto idx = static_cast<size_t>(p * static_cast<double>(degrees_.size() - 1));
+  return degrees_[std::min(idx, degrees_.size() - 1)];
+}
+
+std::vector<katana::DegreeDistribution::Node>
+katana::DegreeDistribution::TopKByDegree(size_t k) const {
+  k = std::min(k, nodes_by_degree_.size());
+  std::vector<Node> top(k);
+  for (size_t i = 0; i < k; ++i) {
+    top[i] = nodes_by_degree_[nodes_by_degree_.size() - 1 - i];
+  }
+  return top;
+}
+
+size_t
+katana::DegreeDistribution::NumNodesWithDegreeAtLeast(uint64_t degree) const {
+  auto it = std::lower_bound(degrees_.begin(), degrees_.end(), degree);
+  return std::distance(it, degrees_.end());
+}
@@ -23,33 +23,84 @@
 
 #include "katana/DynamicBitset.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "katana/Galois.h"
 
 KATANA_EXPORT katana::DynamicBitset katana::EmptyBitset;
 
+namespace {
+
+constexpr unsigned kWordsPerVector = 4;  // 256 bits
+
+const uint64_t*
+Words(const katana::PODVector<katana::CopyableAtomic<uint64_t>>& vec) {
+  return reinterpret_cast<const uint64_t*>(vec.data());
+}
+
+uint64_t*
+Words(katana::PODVector<katana::CopyableAtomic<uint64_t>>& vec) {
+  return reinterpret_cast<uint64_t*>(vec.data());
+}
+
+// The bitwise_* operations document that the bitset is not updated (set) in
+// parallel with them, so words go through plain loads and stores instead of
+// the atomic read-modify-writes that element access on CopyableAtomic would
+// emit; with AVX2 four words go per instruction. The op is a generic lambda
+// applied to uint64_t and, on the vector path, to __m256i (both GCC and
+// Clang support the bitwise operators on vector types).
+template <typename BinOp>
+void
+ApplyWordwise(
+    const uint64_t* a, const uint64_t* b, uint64_t* dst, size_t num_words,
+    BinOp op) {
+  katana::on_each(
+      [&](unsigned tid, unsigned nthreads) {
+        auto [beg, end] =
+            katana::block_range(size_t{0}, num_words, tid, nthreads);
+        size_t i = beg;
+#if defined(__AVX2__)
+        for (; i + kWordsPerVector <= end; i += kWordsPerVector) {
+          __m256i va =
+              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+          __m256i vb =
+              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dst + i), op(va, vb));
+        }
+#endif
+        for (; i < end; ++i) {
+          dst[i] = op(a[i], b[i]);
+        }
+      },
+      katana::no_stats());
+}
+
+}  // namespace
+
 void
 katana::DynamicBitset::bitwise_or(const DynamicBitset& other) {
   KATANA_LOG_DEBUG_ASSERT(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec_.size()),
-      [&](size_t i) { bitvec_[i] |= other_bitvec[i]; }, katana::no_stats());
+  ApplyWordwise(
+      Words(bitvec_), Words(other.get_vec()), Words(bitvec_), bitvec_.size(),
+      [](auto a, auto b) { return a | b; });
 }
 
 void
 katana::DynamicBitset::bitwise_not() {
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec_.size()),
-      [&](size_t i) { bitvec_[i] = ~bitvec_[i]; }, katana::no_stats());
+  ApplyWordwise(
+      Words(bitvec_), Words(bitvec_), Words(bitvec_), bitvec_.size(),
+      [](auto a, auto) { return ~a; });
 }
 
 void
 katana::DynamicBitset::bitwise_and(const DynamicBitset& other) {
   KATANA_LOG_DEBUG_ASSERT(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec_.size()),
-      [&](size_t i) { bitvec_[i] &= other_bitvec[i]; }, katana::no_stats());
+  ApplyWordwise(
+      Words(bitvec_), Words(other.get_vec()), Words(bitvec_), bitvec_.size(),
+      [](auto a, auto b) { return a & b; });
 }
 
 void
@@ -57,22 +108,17 @@ katana::DynamicBitset::bitwise_and(
     const DynamicBitset& other1, const DynamicBitset& other2) {
   KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
   KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
-
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec_.size()),
-      [&](size_t i) { bitvec_[i] = other_bitvec1[i] & other_bitvec2[i]; },
-      katana::no_stats());
+  ApplyWordwise(
+      Words(other1.get_vec()), Words(other2.get_vec()), Words(bitvec_),
+      bitvec_.size(), [](auto a, auto b) { return a & b; });
 }
 
 void
 katana::DynamicBitset::bitwise_xor(const DynamicBitset& other) {
   KATANA_LOG_DEBUG_ASSERT(size() == other.size());
-  const auto& other_bitvec = other.get_vec();
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec_.size()),
-      [&](size_t i) { bitvec_[i] ^= other_bitvec[i]; }, katana::no_stats());
+  ApplyWordwise(
+      Words(bitvec_), Words(other.get_vec()), Words(bitvec_), bitvec_.size(),
+      [](auto a, auto b) { return a ^ b; });
 }
 
 void
@@ -80,13 +126,27 @@ katana::DynamicBitset::bitwise_xor(
     const DynamicBitset& other1, const DynamicBitset& other2) {
   KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
   KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
-  const auto& other_bitvec1 = other1.get_vec();
-  const auto& other_bitvec2 = other2.get_vec();
+  ApplyWordwise(
+      Words(other1.get_vec()), Words(other2.get_vec()), Words(bitvec_),
+      bitvec_.size(), [](auto a, auto b) { return a ^ b; });
+}
 
-  katana::do_all(
-      katana::iterate(size_t{0}, bitvec_.size()),
-      [&](size_t i) { bitvec_[i] = other_bitvec1[i] ^ other_bitvec2[i]; },
-      katana::no_stats());
+void
+katana::DynamicBitset::bitwise_andnot(const DynamicBitset& other) {
+  KATANA_LOG_DEBUG_ASSERT(size() == other.size());
+  ApplyWordwise(
+      Words(bitvec_), Words(other.get_vec()), Words(bitvec_), bitvec_.size(),
+      [](auto a, auto b) { return a & ~b; });
+}
+
+void
+katana::DynamicBitset::bitwise_andnot(
+    const DynamicBitset& other1, const DynamicBitset& other2) {
+  KATANA_LOG_DEBUG_ASSERT(size() == other1.size());
+  KATANA_LOG_DEBUG_ASSERT(size() == other2.size());
+  ApplyWordwise(
+      Words(other1.get_vec()), Words(other2.get_vec()), Words(bitvec_),
+      bitvec_.size(), [](auto a, auto b) { return a & ~b; });
 }
 
 size_t
@@ -109,6 +169,31 @@ katana::DynamicBitset::count() const {
 }
 
 namespace {
+
+uint32_t
+Popcount(uint64_t n) {
+#ifdef __GNUC__
+  return __builtin_popcountll(n);
+#else
+  n = n - ((n >> 1) & 0x5555555555555555UL);
+  n = (n & 0x3333333333333333UL) + ((n >> 2) & 0x3333333333333333UL);
+  return (((n + (n >> 4)) & 0xF0F0F0F0F0F0F0FUL) * 0x101010101010101UL) >> 56;
+#endif
+}
+
+uint32_t
+CountTrailingZeros(uint64_t n) {
+#ifdef __GNUC__
+  return __builtin_ctzll(n);
+#else
+  uint32_t bit = 0;
+  while (((n >> bit) & 1) == 0) {
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
 template <typename Integer>
 void
 ComputeOffsets(
@@ -117,16 +202,27 @@ ComputeOffsets(
   uint32_t activeThreads = katana::getActiveThreads();
   std::vector<Integer> tPrefixBitCounts(activeThreads);
 
-  // count how many bits are set on each thread
+  constexpr uint32_t kBitsPerWord = katana::DynamicBitset::kNumBitsInUint64;
+  const auto& bitvec = bitset.get_vec();
+  const size_t num_words = bitvec.size();
+
+  // last word, with the padding bits past size() masked off
+  auto word_at = [&](size_t w) {
+    uint64_t word = bitvec[w].load(std::memory_order_relaxed);
+    if (w == num_words - 1 && (bitset.size() % kBitsPerWord) != 0) {
+      word &= (uint64_t{1} << (bitset.size() % kBitsPerWord)) - 1;
+    }
+    return word;
+  };
+
+  // count how many bits are set on each thread, a word at a time
   katana::on_each([&](unsigned tid, unsigned nthreads) {
     auto [start, end] =
-        katana::block_range(size_t{0}, bitset.size(), tid, nthreads);
+        katana::block_range(size_t{0}, num_words, tid, nthreads);
 
     Integer count = 0;
-    for (Integer i = start; i < end; ++i) {
-      if (bitset.test(i)) {
-        ++count;
-      }
+    for (size_t w = start; w < end; ++w) {
+      count += Popcount(word_at(w));
     }
 
     tPrefixBitCounts[tid] = count;
@@ -141,27 +237,31 @@ ComputeOffsets(
   Integer bitsetCount = tPrefixBitCounts[activeThreads - 1];
 
   // calculate the indices of the set bits and save them to the offset
-  // vector
+  // vector; count-trailing-zeros walks the set bits of each word directly
+  // instead of testing every bit
   if (bitsetCount > 0) {
     size_t cur_size = offsets->size();
     offsets->resize(cur_size + bitsetCount);
     katana::on_each([&](unsigned tid, unsigned nthreads) {
       auto [start, end] =
-          katana::block_range(size_t{0}, bitset.size(), tid, nthreads);
+          katana::block_range(size_t{0}, num_words, tid, nthreads);
       Integer index = cur_size;
       if (tid != 0) {
         index += tPrefixBitCounts[tid - 1];
       }
 
-      for (Integer i = start; i < end; ++i) {
-        if (bitset.test(i)) {
-          offsets->at(index) = i;
+      for (size_t w = start; w < end; ++w) {
+        uint64_t word = word_at(w);
+        while (word != 0) {
+          offsets->at(index) = w * kBitsPerWord + CountTrailingZeros(word);
           ++index;
+          word &= word - 1;  // clear the lowest set bit
         }
       }
     });
   }
 }
+
 }  //namespace
 
 template <>
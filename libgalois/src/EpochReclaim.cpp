@@ -0,0 +1,104 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/EpochReclaim.h"
+
+#include "katana/gIO.h"
+
+katana::EpochManager&
+katana::GetEpochManager() {
+  static katana::EpochManager m;
+  return m;
+}
+
+void
+katana::EpochManager::enter() {
+  ThreadState& s = *state_.getLocal();
+  if (s.depth++ != 0) {
+    return;
+  }
+  // The active store must be ordered before the epoch load (and before any
+  // read of a protected structure): tryAdvance loads the epoch and then our
+  // active flag, so one of the two sides always observes the other
+  // (Dekker-style).
+  s.active.store(true, std::memory_order_seq_cst);
+  s.localEpoch.store(
+      globalEpoch_.load(std::memory_order_seq_cst), std::memory_order_release);
+}
+
+void
+katana::EpochManager::exit() {
+  ThreadState& s = *state_.getLocal();
+  KATANA_LOG_DEBUG_ASSERT(s.depth > 0);
+  if (--s.depth == 0) {
+    s.active.store(false, std::memory_order_release);
+  }
+}
+
+void
+katana::EpochManager::retire(void* ptr, void (*reclaim)(void*)) {
+  LimboList& l = *limbo_.getLocal();
+  unsigned e = globalEpoch_.load(std::memory_order_acquire);
+  if (l.epoch != e) {
+    // The epoch advanced since this thread last retired something. The
+    // bucket epoch e maps to was filled at least three epochs ago; any
+    // reader that could have seen its contents has long since left.
+    freeBucket(l.buckets[e % 3]);
+    l.epoch = e;
+    l.sinceAdvance = 0;
+  }
+  l.buckets[e % 3].push_back(Retired{ptr, reclaim});
+  if (++l.sinceAdvance >= kRetireBatch) {
+    l.sinceAdvance = 0;
+    tryAdvance();
+  }
+}
+
+void
+katana::EpochManager::tryAdvance() {
+  unsigned e = globalEpoch_.load(std::memory_order_seq_cst);
+  for (unsigned t = 0, n = state_.size(); t < n; ++t) {
+    const ThreadState& s = *state_.getRemote(t);
+    if (s.active.load(std::memory_order_seq_cst) &&
+        s.localEpoch.load(std::memory_order_acquire) != e) {
+      // t is still reading in an older epoch; try again on a later retire
+      return;
+    }
+  }
+  globalEpoch_.compare_exchange_strong(
+      e, e + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+}
+
+void
+katana::EpochManager::freeBucket(std::vector<Retired>& bucket) {
+  for (const Retired& r : bucket) {
+    r.reclaim(r.ptr);
+  }
+  bucket.clear();
+}
+
+void
+katana::EpochManager::reclaimAll() {
+  for (unsigned t = 0, n = limbo_.size(); t < n; ++t) {
+    LimboList& l = *limbo_.getRemote(t);
+    for (std::vector<Retired>& bucket : l.buckets) {
+      freeBucket(bucket);
+    }
+  }
+}
@@ -324,8 +324,52 @@ FileGraph::fromArrays(
   return edgeData;
 }
 
+/**
+ * Makes each thread fault in one contiguous segment of a buffer, walking its
+ * segment sequentially. Unlike pageInterleaved below, which distributes
+ * consecutive pages across threads for NUMA placement, contiguous segments
+ * keep each thread's faults sequential on disk, so a cold-cache load runs
+ * several sequential streams instead of one page-sized read per fault.
+ *
+ * @param ptr buffer to page in
+ * @param length amount of data to page in
+ * @param numThreads number of threads to use when paging in memory
+ */
+static void
+pageInSegments(void* ptr, uint64_t length, unsigned int numThreads) {
+  if (length == 0)
+    return;
+
+  katana::GetThreadPool().run(numThreads, [ptr, length, numThreads]() {
+    auto myID = katana::ThreadPool::getTID();
+    size_t pageSize = katana::allocSize();
+
+    size_t segment = (length + numThreads - 1) / numThreads;
+    size_t begin = std::min<size_t>(segment * myID, length);
+    size_t end = std::min<size_t>(begin + segment, length);
+    if (begin >= end)
+      return;
+
+    char* base = static_cast<char*>(ptr) + begin;
+#ifdef MADV_WILLNEED
+    // kick off kernel readahead for the whole segment before touching it;
+    // madvise wants a page-aligned start
+    uintptr_t addr = reinterpret_cast<uintptr_t>(base);
+    uintptr_t aligned = addr & ~static_cast<uintptr_t>(pageSize - 1);
+    madvise(
+        reinterpret_cast<void*>(aligned), (end - begin) + (addr - aligned),
+        MADV_WILLNEED);
+#endif
+
+    volatile char* cptr = reinterpret_cast<volatile char*>(base);
+    for (size_t x = 0; x < end - begin; x += pageSize)
+      // this should do an access
+      cptr[x];
+  });
+}
+
 void
-FileGraph::fromFile(const std::string& filename) {
+FileGraph::fromFile(const std::string& filename, LoadHint hint) {
   int fd = open(filename.c_str(), O_RDONLY);
   if (fd == -1)
     KATANA_SYS_DIE("failed opening ", "'", filename, "'");
@@ -338,13 +382,19 @@ FileGraph::fromFile(const std::string& filename) {
   // mmap file, then load from mem using fromMem function
   int _MAP_BASE = MAP_PRIVATE;
 #ifdef MAP_POPULATE
-  _MAP_BASE |= MAP_POPULATE;
+  // kernel populate is single threaded; with the eager hint we fault the
+  // mapping ourselves below with one thread per segment instead
+  if (hint != LoadHint::kEagerPopulate)
+    _MAP_BASE |= MAP_POPULATE;
 #endif
   void* base = mmap_big(nullptr, buf.st_size, PROT_READ, _MAP_BASE, fd, 0);
   if (base == MAP_FAILED)
     KATANA_SYS_DIE("failed reading ", "'", filename, "'");
   mappings.push_back({base, static_cast<size_t>(buf.st_size)});
 
+  if (hint == LoadHint::kEagerPopulate)
+    pageInSegments(base, buf.st_size, katana::activeThreads);
+
   fromMem(base, 0, 0, buf.st_size);
 }
 
@@ -403,7 +453,7 @@ pageInterleaved(
 void
 FileGraph::partFromFile(
     const std::string& filename, NodeRange nrange, EdgeRange erange,
-    bool numaMap) {
+    bool numaMap, LoadHint hint) {
   int fd = open(filename.c_str(), O_RDONLY);
   if (fd == -1)
     KATANA_SYS_DIE("failed opening ", "'", filename, "'");
@@ -488,6 +538,20 @@ FileGraph::partFromFile(
         pageInterleaved(ptr, length, hugePageSize, numThreads);
       }
     }
+  } else if (hint == LoadHint::kEagerPopulate) {
+    // fault the part in with one contiguous sequential segment per thread;
+    // the numaMap path above keeps its round-robin first touch because that
+    // interleave is what places pages across sockets
+    unsigned int numThreads = katana::activeThreads;
+
+    pageInSegments((void*)outIdx, numNodes * sizeof(uint64_t), numThreads);
+
+    size_t destSize =
+        graphVersion == 1 ? sizeof(uint32_t) : sizeof(uint64_t);
+    pageInSegments(outs, numEdges * destSize, numThreads);
+
+    if (sizeofEdge)
+      pageInSegments(edgeData, numEdges * sizeofEdge, numThreads);
   }
 }
 
@@ -1,8 +1,14 @@
 #include "katana/GraphML.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <fstream>
 #include <iostream>
@@ -17,6 +23,8 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
+#include <libxml/parser.h>
+#include <libxml/xmlreader.h>
 
 #include "katana/ErrorCode.h"
 #include "katana/Galois.h"
@@ -329,13 +337,29 @@ ProcessData(xmlTextReaderPtr reader) {
   return make_pair(key, propertyData);
 }
 
+/// AddPropertyValue routes a raw key/value pair from the XML stream into a
+/// builder; the PropertyGraphBuilder overload resolves the value lazily
+/// against the builder's column type
+void
+AddPropertyValue(
+    katana::PropertyGraphBuilder* builder, const std::string& key,
+    const std::string& value) {
+  builder->AddValue(
+      key,
+      [&]() { return PropertyKey{key, ImportDataType::kString, false}; },
+      [&value](ImportDataType type, bool is_list) {
+        return ResolveValue(value, type, is_list);
+      });
+}
+
 /*
  * reader should be pointing at the node element before calling
  *
  * parses the node from a GraphML file into readable form
  */
+template <typename Builder>
 void
-ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
+ProcessNode(xmlTextReaderPtr reader, Builder* builder) {
   auto minimum_depth = xmlTextReaderDepth(reader);
 
   int ret = xmlTextReaderMoveToNextAttribute(reader);
@@ -409,16 +433,7 @@ ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
             }
           } else if (property.first != std::string("IGNORE")) {
             if (validNode) {
-              const std::string& value = property.second;
-              builder->AddValue(
-                  property.first,
-                  [&]() {
-                    return PropertyKey{
-                        property.first, ImportDataType::kString, false};
-                  },
-                  [&value](ImportDataType type, bool is_list) {
-                    return ResolveValue(value, type, is_list);
-                  });
+              AddPropertyValue(builder, property.first, property.second);
             }
           }
         }
@@ -449,8 +464,9 @@ ProcessNode(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
  *
  * parses the edge from a GraphML file into readable form
  */
+template <typename Builder>
 void
-ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
+ProcessEdge(xmlTextReaderPtr reader, Builder* builder) {
   auto minimum_depth = xmlTextReaderDepth(reader);
 
   int ret = xmlTextReaderMoveToNextAttribute(reader);
@@ -517,16 +533,7 @@ ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
             }
           } else if (property.first != std::string("IGNORE")) {
             if (valid_edge) {
-              const std::string& value = property.second;
-              builder->AddValue(
-                  property.first,
-                  [&]() {
-                    return PropertyKey{
-                        property.first, ImportDataType::kString, false};
-                  },
-                  [&value](ImportDataType type, bool is_list) {
-                    return ResolveValue(value, type, is_list);
-                  });
+              AddPropertyValue(builder, property.first, property.second);
             }
           }
         }
@@ -554,10 +561,9 @@ ProcessEdge(xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder) {
  *
  * parses the graph structure from a GraphML file into Galois format
  */
+template <typename Builder>
 void
-ProcessGraph(
-    xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder,
-    bool verbose) {
+ProcessGraph(xmlTextReaderPtr reader, Builder* builder, bool verbose) {
   auto minimum_depth = xmlTextReaderDepth(reader);
   int ret = xmlTextReaderRead(reader);
 
@@ -599,6 +605,202 @@ ProcessGraph(
   }
 }
 
+/*********************************************/
+/* Functions for parallel segmented parsing  */
+/*********************************************/
+
+/// SegmentCollector stands in for PropertyGraphBuilder while a segment of the
+/// input is parsed on a worker thread. It records nodes and edges in input
+/// order and eagerly resolves property values against the types declared in
+/// the GraphML header, so the expensive lexical casts happen in parallel; the
+/// raw text is kept so a value can be re-resolved if the final column type
+/// differs.
+class SegmentCollector {
+public:
+  struct CollectedValue {
+    std::string key;
+    std::string raw;
+    ImportData data{ImportDataType::kUnsupported, false};
+  };
+
+  struct CollectedElement {
+    bool is_node{false};
+    std::string id;
+    std::string source;
+    std::string target;
+    std::vector<std::string> labels;
+    std::vector<CollectedValue> values;
+  };
+
+  explicit SegmentCollector(
+      const std::unordered_map<std::string, PropertyKey>* schema)
+      : schema_(schema) {}
+
+  bool StartNode(const std::string& id) {
+    elements_.emplace_back();
+    elements_.back().is_node = true;
+    elements_.back().id = id;
+    building_ = true;
+    return true;
+  }
+
+  bool FinishNode() {
+    building_ = false;
+    return true;
+  }
+
+  bool StartEdge(const std::string& source, const std::string& target) {
+    elements_.emplace_back();
+    elements_.back().source = source;
+    elements_.back().target = target;
+    building_ = true;
+    return true;
+  }
+
+  bool FinishEdge() {
+    building_ = false;
+    return true;
+  }
+
+  void AddLabel(const std::string& name) {
+    if (building_) {
+      elements_.back().labels.emplace_back(name);
+    }
+  }
+
+  void AddValue(const std::string& key, const std::string& raw) {
+    if (!building_) {
+      return;
+    }
+    CollectedValue value;
+    value.key = key;
+    value.raw = raw;
+    auto schema_entry = schema_->find(key);
+    if (schema_entry != schema_->end()) {
+      value.data = ResolveValue(
+          raw, schema_entry->second.type, schema_entry->second.is_list);
+    }
+    elements_.back().values.emplace_back(std::move(value));
+  }
+
+  const std::vector<CollectedElement>& elements() const { return elements_; }
+
+private:
+  const std::unordered_map<std::string, PropertyKey>* schema_;
+  std::vector<CollectedElement> elements_;
+  bool building_{false};
+};
+
+void
+AddPropertyValue(
+    SegmentCollector* collector, const std::string& key,
+    const std::string& value) {
+  collector->AddValue(key, value);
+}
+
+/// Appends a parsed segment to the builder in input order. Values resolved on
+/// the worker thread are reused when the builder's column type matches;
+/// otherwise they are re-resolved from the raw text.
+void
+ReplaySegment(
+    const SegmentCollector& segment, katana::PropertyGraphBuilder* builder) {
+  for (const SegmentCollector::CollectedElement& element :
+       segment.elements()) {
+    bool valid = element.is_node
+                     ? builder->StartNode(element.id)
+                     : builder->StartEdge(element.source, element.target);
+    if (!valid) {
+      continue;
+    }
+    for (const SegmentCollector::CollectedValue& value : element.values) {
+      builder->AddValue(
+          value.key,
+          [&]() {
+            return PropertyKey{value.key, ImportDataType::kString, false};
+          },
+          [&value](ImportDataType type, bool is_list) {
+            if (value.data.type == type && value.data.is_list == is_list &&
+                value.data.type != ImportDataType::kUnsupported) {
+              return value.data;
+            }
+            return ResolveValue(value.raw, type, is_list);
+          });
+    }
+    for (const std::string& label : element.labels) {
+      builder->AddLabel(label);
+    }
+    if (element.is_node) {
+      builder->FinishNode();
+    } else {
+      builder->FinishEdge();
+    }
+  }
+}
+
+/// Finds the next "<node" or "<edge" element start at or after offset;
+/// returns npos if there is none before end. Raw '<' cannot appear in
+/// attribute values or text in well-formed XML, so a textual search only
+/// yields markup (comments and CDATA sections containing such text are not
+/// supported by the segmented parser).
+size_t
+FindElementStart(const char* data, size_t offset, size_t end) {
+  for (size_t i = offset; i + 5 < end; ++i) {
+    if (data[i] != '<') {
+      continue;
+    }
+    if (memcmp(data + i + 1, "node", 4) != 0 &&
+        memcmp(data + i + 1, "edge", 4) != 0) {
+      continue;
+    }
+    char next = data[i + 5];
+    if (next == ' ' || next == '\t' || next == '\r' || next == '\n' ||
+        next == '>' || next == '/') {
+      return i;
+    }
+  }
+  return std::string::npos;
+}
+
+/// Parses one segment of element text that has been wrapped in a synthetic
+/// graphml/graph document. Returns false on an xml error.
+bool
+ParseSegment(
+    const char* data, size_t begin, size_t end, SegmentCollector* collector) {
+  static const char kPrefix[] = "<graphml><graph>";
+  static const char kSuffix[] = "</graph></graphml>";
+
+  std::string buffer;
+  buffer.reserve(sizeof(kPrefix) + sizeof(kSuffix) + (end - begin));
+  buffer.append(kPrefix);
+  buffer.append(data + begin, end - begin);
+  buffer.append(kSuffix);
+
+  xmlTextReaderPtr reader = xmlReaderForMemory(
+      buffer.data(), static_cast<int>(buffer.size()), nullptr, nullptr, 0);
+  if (reader == nullptr) {
+    return false;
+  }
+
+  int ret = xmlTextReaderRead(reader);
+  bool ok = true;
+  while (ret == 1) {
+    xmlChar* name = xmlTextReaderName(reader);
+    if (name != NULL && xmlTextReaderNodeType(reader) == 1 &&
+        xmlStrEqual(name, BAD_CAST "graph")) {
+      ProcessGraph(reader, collector, false);
+      xmlFree(name);
+      break;
+    }
+    xmlFree(name);
+    ret = xmlTextReaderRead(reader);
+  }
+  if (ret < 0) {
+    ok = false;
+  }
+  xmlFreeTextReader(reader);
+  return ok;
+}
+
 }  // end of unnamed namespace
 
 katana::Result<katana::GraphComponents>
@@ -668,3 +870,165 @@ katana::ConvertGraphML(
   }
   return builder.Finish(verbose);
 }
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphMLParallel(
+    const std::string& infilename, size_t chunk_size, bool verbose) {
+  // libxml global state must be set up before readers run concurrently
+  xmlInitParser();
+
+  int fd = open(infilename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return KATANA_ERROR(ErrorCode::NotFound, "Unable to open {}", infilename);
+  }
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) == -1) {
+    close(fd);
+    return KATANA_ERROR(ErrorCode::NotFound, "Unable to stat {}", infilename);
+  }
+  size_t file_size = stat_buf.st_size;
+  void* base =
+      file_size != 0
+          ? mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0)
+          : MAP_FAILED;
+  if (base == MAP_FAILED) {
+    close(fd);
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Unable to mmap {}", infilename);
+  }
+  const char* data = static_cast<const char*>(base);
+
+  auto unmap = [&]() {
+    munmap(base, file_size);
+    close(fd);
+  };
+
+  katana::PropertyGraphBuilder builder{chunk_size};
+  if (verbose) {
+    std::cout << "Start converting GraphML file: " << infilename << "\n";
+  }
+
+  // parse the header serially for the declared property keys; worker threads
+  // use them to resolve values to their final types while parsing
+  std::unordered_map<std::string, PropertyKey> schema;
+  {
+    xmlTextReaderPtr reader = xmlNewTextReaderFilename(infilename.c_str());
+    if (reader == NULL) {
+      unmap();
+      return KATANA_ERROR(ErrorCode::NotFound, "Unable to open {}", infilename);
+    }
+    int ret = xmlTextReaderRead(reader);
+    bool reached_graph = false;
+    while (ret == 1 && !reached_graph) {
+      xmlChar* name = xmlTextReaderName(reader);
+      if (name == NULL) {
+        name = xmlStrdup(BAD_CAST "--");
+      }
+      if (xmlTextReaderNodeType(reader) == 1) {
+        if (xmlStrEqual(name, BAD_CAST "key")) {
+          PropertyKey key = katana::graphml::ProcessKey(reader);
+          if (!key.id.empty() && key.id != std::string("label") &&
+              key.id != std::string("IGNORE")) {
+            schema.insert(std::make_pair(key.id, key));
+            if (key.for_node || key.for_edge) {
+              builder.AddBuilder(std::move(key));
+            }
+          }
+        } else if (xmlStrEqual(name, BAD_CAST "graph")) {
+          if (verbose) {
+            std::cout << "Finished processing property headers\n";
+          }
+          reached_graph = true;
+        }
+      }
+      xmlFree(name);
+      if (!reached_graph) {
+        ret = xmlTextReaderRead(reader);
+      }
+    }
+    xmlFreeTextReader(reader);
+    if (ret < 0) {
+      unmap();
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "Failed to parse {}, incorrect xml format",
+          infilename);
+    }
+  }
+
+  size_t content_begin = FindElementStart(data, 0, file_size);
+  if (content_begin == std::string::npos) {
+    // no nodes or edges; nothing left to parallelize
+    unmap();
+    return builder.Finish(verbose);
+  }
+
+  size_t content_end = std::string::npos;
+  constexpr char kGraphClose[] = "</graph>";
+  constexpr size_t kGraphCloseLen = sizeof(kGraphClose) - 1;
+  for (size_t i = file_size - std::min(file_size, kGraphCloseLen) + 1;
+       i-- > content_begin;) {
+    if (memcmp(data + i, kGraphClose, kGraphCloseLen) == 0) {
+      content_end = i;
+      break;
+    }
+  }
+  if (content_end == std::string::npos) {
+    unmap();
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "No closing graph element in {}",
+        infilename);
+  }
+
+  // split the element region into segments at node/edge starts
+  constexpr size_t kTargetSegmentBytes = 64 * 1024 * 1024;
+  std::vector<std::pair<size_t, size_t>> segments;
+  size_t segment_begin = content_begin;
+  while (segment_begin < content_end) {
+    size_t target = segment_begin + kTargetSegmentBytes;
+    size_t segment_end =
+        target >= content_end
+            ? content_end
+            : FindElementStart(data, target, content_end);
+    if (segment_end == std::string::npos) {
+      segment_end = content_end;
+    }
+    segments.emplace_back(segment_begin, segment_end);
+    segment_begin = segment_end;
+  }
+
+  // parse a wave of segments in parallel, then append them to the builder in
+  // input order and free them, so memory is bounded by the wave size
+  size_t wave_size = katana::getActiveThreads();
+  for (size_t wave_begin = 0; wave_begin < segments.size();
+       wave_begin += wave_size) {
+    size_t wave_end = std::min(wave_begin + wave_size, segments.size());
+    std::vector<SegmentCollector> collectors(
+        wave_end - wave_begin, SegmentCollector(&schema));
+    std::vector<uint8_t> parse_ok(wave_end - wave_begin, 0);
+
+    katana::do_all(
+        katana::iterate(size_t{0}, wave_end - wave_begin),
+        [&](size_t i) {
+          const std::pair<size_t, size_t>& segment = segments[wave_begin + i];
+          parse_ok[i] = ParseSegment(
+              data, segment.first, segment.second, &collectors[i]);
+        },
+        katana::steal());
+
+    for (size_t i = 0; i < collectors.size(); ++i) {
+      if (!parse_ok[i]) {
+        unmap();
+        return KATANA_ERROR(
+            ErrorCode::InvalidArgument,
+            "Failed to parse {}, incorrect xml format\n"
+            "Please verify there are no illegal characters in the GraphML "
+            "file",
+            infilename);
+      }
+      ReplaySegment(collectors[i], &builder);
+    }
+  }
+
+  unmap();
+  return builder.Finish(verbose);
+}
@@ -1,10 +1,26 @@
 #include "katana/GraphTopology.h"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <iostream>
+#include <mutex>
 
+#include "katana/Env.h"
+#include "katana/GraphHelpers.h"
 #include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/NodeOrdering.h"
 #include "katana/PropertyGraph.h"
 #include "katana/Random.h"
+#include "katana/Range.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
+#include "katana/URI.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FileFrame.h"
+#include "tsuba/FileView.h"
+#include "tsuba/file.h"
 
 void
 katana::GraphTopology::Print() const noexcept {
@@ -16,26 +32,154 @@ katana::GraphTopology::Print() const noexcept {
     std::cout << "]" << std::endl;
   };
 
-  print_array(adj_indices_, "adj_indices_");
-  print_array(dests_, "dests_");
+  print_array(
+      MakeStandardRange(adj_data(), adj_data() + num_nodes()),
+      "adj_indices_");
+  print_array(
+      MakeStandardRange(dest_data(), dest_data() + num_edges()), "dests_");
+}
+
+namespace {
+
+// KATANA_NUMA_EDGE_BALANCED: first-touch the dests array so each thread's
+// pages cover an equal share of edges instead of an equal index range;
+// see computeEdgeBalancedRanges
+bool
+UseEdgeBalancedPlacement() {
+  static bool enabled = []() {
+    bool val = false;
+    katana::GetEnv("KATANA_NUMA_EDGE_BALANCED", &val);
+    return val;
+  }();
+  return enabled;
 }
 
+}  // namespace
+
 katana::GraphTopology::GraphTopology(
     const Edge* adj_indices, size_t num_nodes, const Node* dests,
     size_t num_edges) noexcept {
   adj_indices_.allocateInterleaved(num_nodes);
-  dests_.allocateInterleaved(num_edges);
-
   katana::ParallelSTL::copy(
       &adj_indices[0], &adj_indices[num_nodes], adj_indices_.begin());
+
+  if (UseEdgeBalancedPlacement() && num_nodes > 0) {
+    // adj_indices_ is resident now; use its prefix sum to split dests_ so
+    // each socket owns the pages for roughly equal edge traffic
+    std::vector<uint64_t> ranges = katana::computeEdgeBalancedRanges(
+        adj_indices_, num_nodes, num_edges, katana::activeThreads);
+    dests_.allocateSpecified(num_edges, ranges);
+  } else {
+    dests_.allocateInterleaved(num_edges);
+  }
   katana::ParallelSTL::copy(&dests[0], &dests[num_edges], dests_.begin());
+
+  adj_view_ = adj_indices_.data();
+  dests_view_ = dests_.data();
+  num_nodes_ = num_nodes;
+  num_edges_ = num_edges;
+}
+
+katana::GraphTopology
+katana::GraphTopology::MakeMemMappedView(
+    const Edge* adj_indices, size_t num_nodes, const Node* dests,
+    size_t num_edges) noexcept {
+  GraphTopology topo;
+  topo.adj_view_ = adj_indices;
+  topo.dests_view_ = dests;
+  topo.num_nodes_ = num_nodes;
+  topo.num_edges_ = num_edges;
+  topo.mem_mapped_view_ = true;
+  return topo;
+}
+
+namespace {
+
+/// madvise(MADV_WILLNEED) an arbitrary range, aligning the start down to a
+/// page boundary as madvise requires. Failures are ignored; this is a hint.
+void
+AdviseWillNeed(const void* addr, size_t bytes) noexcept {
+  if (bytes == 0) {
+    return;
+  }
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const auto start = reinterpret_cast<uintptr_t>(addr);
+  const uintptr_t aligned = start & ~(page_size - 1);
+  ::madvise(
+      reinterpret_cast<void*>(aligned), bytes + (start - aligned),
+      MADV_WILLNEED);
+}
+
+}  // namespace
+
+void
+katana::GraphTopology::Prefetch(const nodes_range& nodes) const noexcept {
+  if (empty() || nodes.begin() == nodes.end()) {
+    return;
+  }
+  const Node n_beg = *nodes.begin();
+  const Node n_end = *nodes.end();
+  KATANA_LOG_DEBUG_ASSERT(n_beg <= n_end && n_end <= num_nodes_);
+  if (n_beg == n_end) {
+    return;
+  }
+
+  // Warm the adjacency index pages first so the edge range below does not
+  // fault them in serially. Include node n_beg - 1, which edges() reads.
+  const Node adj_beg = n_beg > 0 ? n_beg - 1 : 0;
+  AdviseWillNeed(adj_view_ + adj_beg, (n_end - adj_beg) * sizeof(Edge));
+
+  const Edge e_beg = n_beg > 0 ? adj_view_[n_beg - 1] : 0;
+  const Edge e_end = adj_view_[n_end - 1];
+  AdviseWillNeed(dests_view_ + e_beg, (e_end - e_beg) * sizeof(Node));
 }
 
 katana::GraphTopology
 katana::GraphTopology::Copy(const GraphTopology& that) noexcept {
   return katana::GraphTopology(
-      that.adj_indices_.data(), that.adj_indices_.size(), that.dests_.data(),
-      that.dests_.size());
+      that.adj_data(), that.num_nodes(), that.dest_data(), that.num_edges());
+}
+
+std::pair<katana::GraphTopology::Node, katana::GraphTopology::Node>
+katana::GraphTopology::GetThreadRange() const noexcept {
+  const unsigned num_threads = katana::getActiveThreads();
+  const unsigned tid = katana::ThreadPool::getTID();
+  KATANA_LOG_DEBUG_ASSERT(tid < num_threads);
+
+  std::lock_guard<SimpleLock> guard(thread_ranges_lock_);
+  // The back() check catches topologies patched in place (e.g. by
+  // PGViewCache::PatchTopologies) as well as thread-count changes.
+  if (thread_ranges_.size() != num_threads + 1 ||
+      thread_ranges_.back() != num_nodes()) {
+    thread_ranges_.assign(num_threads + 1, Node{0});
+    const Edge* adj_end = adj_view_ + num_nodes();
+    for (unsigned i = 1; i < num_threads; ++i) {
+      if (num_edges() == 0) {
+        // Edgeless topology: fall back to an even node split so threads
+        // still share the work.
+        thread_ranges_[i] = static_cast<Node>(num_nodes() * i / num_threads);
+        continue;
+      }
+      // First node whose cumulative edge count exceeds thread i's share;
+      // adj_indices_ is an inclusive prefix sum, so upper_bound on the
+      // target edge id lands on the owning node.
+      const Edge target = num_edges() * i / num_threads;
+      auto it = std::upper_bound(adj_view_, adj_end, target);
+      thread_ranges_[i] = static_cast<Node>(std::distance(adj_view_, it));
+    }
+    thread_ranges_[num_threads] = static_cast<Node>(num_nodes());
+  }
+  return std::make_pair(thread_ranges_[tid], thread_ranges_[tid + 1]);
+}
+
+katana::GraphTopology::node_iterator
+katana::GraphTopology::local_begin() const noexcept {
+  return node_iterator(GetThreadRange().first);
+}
+
+katana::GraphTopology::node_iterator
+katana::GraphTopology::local_end() const noexcept {
+  return node_iterator(GetThreadRange().second);
 }
 
 std::unique_ptr<katana::ShuffleTopology>
@@ -58,6 +202,27 @@ katana::EdgeShuffleTopology::MakeTransposeCopy(
     return std::make_unique<EdgeShuffleTopology>(std::move(et));
   }
 
+  // Prefer a transpose persisted by PropertyGraph::WriteTransposeTopology();
+  // mapping it is far cheaper than rebuilding it on every run.
+  if (auto persisted = pg->LoadTransposeTopology(); !persisted) {
+    KATANA_LOG_WARN(
+        "ignoring persisted transpose topology: {}", persisted.error());
+  } else if (persisted.value()) {
+    return std::move(persisted.value());
+  }
+
+  return MakeTransposeCopy(topology);
+}
+
+std::unique_ptr<katana::EdgeShuffleTopology>
+katana::EdgeShuffleTopology::MakeTransposeCopy(
+    const katana::GraphTopology& topology) {
+  if (topology.empty()) {
+    EdgeShuffleTopology et;
+    et.tpose_state_ = TransposeKind::kYes;
+    return std::make_unique<EdgeShuffleTopology>(std::move(et));
+  }
+
   GraphTopologyTypes::AdjIndexVec out_indices;
   GraphTopologyTypes::EdgeDestVec out_dests;
   GraphTopologyTypes::PropIndexVec edge_prop_indices;
@@ -70,17 +235,66 @@ katana::EdgeShuffleTopology::MakeTransposeCopy(
 
   katana::ParallelSTL::fill(out_indices.begin(), out_indices.end(), Edge{0});
 
-  // Keep a copy of old destinaton ids and compute number of
-  // in-coming edges for the new prefix sum of out_indices.
-  katana::do_all(
-      katana::iterate(topology.all_edges()),
-      [&](Edge e) {
-        // Counting outgoing edges in the tranpose graph by
-        // counting incoming edges in the original graph
-        auto dest = topology.edge_dest(e);
-        __sync_add_and_fetch(&(out_indices[dest]), 1);
-      },
-      katana::no_stats());
+  const unsigned num_threads = katana::getActiveThreads();
+  // Per-thread in-degree counters make both the counting pass and the
+  // scatter pass free of atomics: every (thread, destination) pair owns a
+  // disjoint slice of the destination's in-edge list. The counters cost
+  // num_threads * num_nodes slots, so fall back to the shared atomic
+  // counters when they would dwarf the edge arrays themselves.
+  const bool use_per_thread_counts =
+      uint64_t{num_threads} * topology.num_nodes() <=
+      uint64_t{4} * topology.num_edges();
+
+  GraphTopologyTypes::AdjIndexVec per_thread_counts;
+  if (use_per_thread_counts) {
+    per_thread_counts.allocateInterleaved(
+        uint64_t{num_threads} * topology.num_nodes());
+    katana::ParallelSTL::fill(
+        per_thread_counts.begin(), per_thread_counts.end(), Edge{0});
+
+    // Each thread counts the in-edges of its block of source nodes into a
+    // private row of counters.
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [beg, end] = katana::block_range(
+          Node{0}, static_cast<Node>(topology.num_nodes()), tid, total);
+      Edge* counts = &per_thread_counts[uint64_t{tid} * topology.num_nodes()];
+      for (Node src = beg; src != end; ++src) {
+        for (Edge e : topology.edges(src)) {
+          ++counts[topology.edge_dest(e)];
+        }
+      }
+    });
+
+    // A per-destination exclusive prefix sum over the thread rows turns
+    // each row into that thread's write cursor; the row total is the
+    // in-degree.
+    katana::do_all(
+        katana::iterate(topology.all_nodes()),
+        [&](auto dest) {
+          Edge running = 0;
+          for (unsigned t = 0; t < num_threads; ++t) {
+            Edge& slot =
+                per_thread_counts[uint64_t{t} * topology.num_nodes() + dest];
+            const Edge count = slot;
+            slot = running;
+            running += count;
+          }
+          out_indices[dest] = running;
+        },
+        katana::no_stats());
+  } else {
+    // Keep a copy of old destinaton ids and compute number of
+    // in-coming edges for the new prefix sum of out_indices.
+    katana::do_all(
+        katana::iterate(topology.all_edges()),
+        [&](Edge e) {
+          // Counting outgoing edges in the tranpose graph by
+          // counting incoming edges in the original graph
+          auto dest = topology.edge_dest(e);
+          __sync_add_and_fetch(&(out_indices[dest]), 1);
+        },
+        katana::no_stats());
+  }
 
   // Prefix sum calculation of the edge index array
   katana::ParallelSTL::partial_sum(
@@ -94,32 +308,77 @@ katana::EdgeShuffleTopology::MakeTransposeCopy(
       [&](Edge n) { out_dests_offset[n] = out_indices[n - 1]; },
       katana::no_stats());
 
-  // Update out_dests with the new destination ids
-  // of the transposed graphs
-  katana::do_all(
-      katana::iterate(topology.all_nodes()),
-      [&](auto src) {
-        // get all outgoing edges of a particular
-        // node and reverse the edges.
-        for (GraphTopology::Edge e : topology.edges(src)) {
-          // e = start index into edge array for a particular node
-          // Destination node
+  if (use_per_thread_counts) {
+    // Scatter without atomics using the per-thread cursors computed above.
+    // Re-walking the same node blocks in source order also leaves every
+    // in-edge list sorted by source, so the result is deterministic.
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [beg, end] = katana::block_range(
+          Node{0}, static_cast<Node>(topology.num_nodes()), tid, total);
+      Edge* cursors = &per_thread_counts[uint64_t{tid} * topology.num_nodes()];
+      for (Node src = beg; src != end; ++src) {
+        for (Edge e : topology.edges(src)) {
           auto dest = topology.edge_dest(e);
-          // Location to save edge
-          auto e_new = __sync_fetch_and_add(&(out_dests_offset[dest]), 1);
+          const Edge e_new = out_dests_offset[dest] + cursors[dest]++;
           // Save src as destination
           out_dests[e_new] = src;
           // remember the original edge ID to look up properties
           edge_prop_indices[e_new] = e;
         }
-      },
-      katana::steal(), katana::no_stats());
+      }
+    });
+  } else {
+    // Update out_dests with the new destination ids
+    // of the transposed graphs
+    katana::do_all(
+        katana::iterate(topology.all_nodes()),
+        [&](auto src) {
+          // get all outgoing edges of a particular
+          // node and reverse the edges.
+          for (GraphTopology::Edge e : topology.edges(src)) {
+            // e = start index into edge array for a particular node
+            // Destination node
+            auto dest = topology.edge_dest(e);
+            // Location to save edge
+            auto e_new = __sync_fetch_and_add(&(out_dests_offset[dest]), 1);
+            // Save src as destination
+            out_dests[e_new] = src;
+            // remember the original edge ID to look up properties
+            edge_prop_indices[e_new] = e;
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
 
   return std::make_unique<EdgeShuffleTopology>(EdgeShuffleTopology{
       TransposeKind::kYes, EdgeSortKind::kAny, std::move(out_indices),
       std::move(out_dests), std::move(edge_prop_indices)});
 }
 
+std::unique_ptr<katana::EdgeShuffleTopology>
+katana::EdgeShuffleTopology::MakeTransposeFromArrays(
+    const Edge* adj_indices, size_t num_nodes, const Node* dests,
+    size_t num_edges, const PropertyIndex* edge_prop_indices) {
+  GraphTopologyTypes::AdjIndexVec out_indices;
+  GraphTopologyTypes::EdgeDestVec out_dests;
+  GraphTopologyTypes::PropIndexVec prop_indices;
+
+  out_indices.allocateInterleaved(num_nodes);
+  out_dests.allocateInterleaved(num_edges);
+  prop_indices.allocateInterleaved(num_edges);
+
+  katana::ParallelSTL::copy(
+      &adj_indices[0], &adj_indices[num_nodes], out_indices.begin());
+  katana::ParallelSTL::copy(&dests[0], &dests[num_edges], out_dests.begin());
+  katana::ParallelSTL::copy(
+      &edge_prop_indices[0], &edge_prop_indices[num_edges],
+      prop_indices.begin());
+
+  return std::make_unique<EdgeShuffleTopology>(EdgeShuffleTopology{
+      TransposeKind::kYes, EdgeSortKind::kAny, std::move(out_indices),
+      std::move(out_dests), std::move(prop_indices)});
+}
+
 std::unique_ptr<katana::EdgeShuffleTopology>
 katana::EdgeShuffleTopology::MakeOriginalCopy(const katana::PropertyGraph* pg) {
   GraphTopology copy_topo = GraphTopology::Copy(pg->topology());
@@ -330,47 +589,358 @@ katana::ShuffleTopology::MakeSortedByNodeType(
   return MakeNodeSortedTopo(seed_topo, cmp, NodeSortKind::kSortedByNodeType);
 }
 
+namespace {
+
+/// Widen an engine permutation (new-to-old node IDs) into the
+/// PropIndexVec ShuffleTopology keeps as node_prop_indices
+katana::GraphTopologyTypes::PropIndexVec
+PermutationToPropIndices(
+    const katana::NUMAArray<katana::GraphTopologyTypes::Node>& perm) {
+  katana::GraphTopologyTypes::PropIndexVec node_prop_indices;
+  node_prop_indices.allocateInterleaved(perm.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, perm.size()),
+      [&](size_t i) { node_prop_indices[i] = perm[i]; }, katana::no_stats());
+  return node_prop_indices;
+}
+
+}  // namespace
+
+std::unique_ptr<katana::ShuffleTopology>
+katana::ShuffleTopology::MakeNodePermutedTopo(
+    const katana::EdgeShuffleTopology& seed_topo,
+    PropIndexVec&& node_prop_indices, const NodeSortKind& node_sort_todo) {
+  GraphTopology::AdjIndexVec degrees;
+  degrees.allocateInterleaved(seed_topo.num_nodes());
+
+  katana::NUMAArray<GraphTopologyTypes::Node> old_to_new_map;
+  old_to_new_map.allocateInterleaved(seed_topo.num_nodes());
+  // TODO(amber): given 32-bit node ids, put a check here that
+  // node_prop_indices.size() < 2^32
+  katana::do_all(
+      katana::iterate(size_t{0}, node_prop_indices.size()),
+      [&](auto i) {
+        // node_prop_indices[i] gives old node id
+        old_to_new_map[node_prop_indices[i]] = i;
+        degrees[i] = seed_topo.degree(node_prop_indices[i]);
+      },
+      katana::no_stats());
+
+  katana::ParallelSTL::partial_sum(
+      degrees.begin(), degrees.end(), degrees.begin());
+
+  GraphTopologyTypes::EdgeDestVec new_dest_vec;
+  new_dest_vec.allocateInterleaved(seed_topo.num_edges());
+
+  GraphTopologyTypes::PropIndexVec edge_prop_indices;
+  edge_prop_indices.allocateInterleaved(seed_topo.num_edges());
+
+  katana::do_all(
+      katana::iterate(seed_topo.all_nodes()),
+      [&](auto old_src_id) {
+        auto new_srd_id = old_to_new_map[old_src_id];
+        auto new_out_index = new_srd_id > 0 ? degrees[new_srd_id - 1] : 0;
+
+        for (auto e : seed_topo.edges(old_src_id)) {
+          auto new_edge_dest = old_to_new_map[seed_topo.edge_dest(e)];
+          KATANA_LOG_DEBUG_ASSERT(new_edge_dest < seed_topo.num_nodes());
+
+          auto new_edge_id = new_out_index;
+          ++new_out_index;
+          KATANA_LOG_DEBUG_ASSERT(new_out_index <= degrees[new_srd_id]);
+
+          new_dest_vec[new_edge_id] = new_edge_dest;
+
+          // copy over edge_property_index mapping from old edge to new edge
+          edge_prop_indices[new_edge_id] = seed_topo.edge_property_index(e);
+        }
+        KATANA_LOG_DEBUG_ASSERT(new_out_index == degrees[new_srd_id]);
+      },
+      katana::steal(), katana::no_stats());
+
+  return std::make_unique<ShuffleTopology>(ShuffleTopology{
+      seed_topo.transpose_state(), node_sort_todo, seed_topo.edge_sort_state(),
+      std::move(degrees), std::move(node_prop_indices), std::move(new_dest_vec),
+      std::move(edge_prop_indices)});
+}
+
+std::unique_ptr<katana::ShuffleTopology>
+katana::ShuffleTopology::MakeReverseCuthillMcKee(
+    const PropertyGraph*,
+    const katana::EdgeShuffleTopology& seed_topo) noexcept {
+  return MakeNodePermutedTopo(
+      seed_topo, PermutationToPropIndices(ComputeRCMPermutation(seed_topo)),
+      NodeSortKind::kReverseCuthillMcKee);
+}
+
+std::unique_ptr<katana::ShuffleTopology>
+katana::ShuffleTopology::MakeGorder(
+    const PropertyGraph*,
+    const katana::EdgeShuffleTopology& seed_topo) noexcept {
+  return MakeNodePermutedTopo(
+      seed_topo, PermutationToPropIndices(ComputeGorderPermutation(seed_topo)),
+      NodeSortKind::kGorder);
+}
+
+namespace {
+
+katana::Result<std::string>
+MakeTopologySpillPath() {
+  std::string dir = "/tmp";
+  katana::GetEnv("KATANA_TOPOLOGY_SPILL_DIR", &dir);
+  katana::Uri uri = KATANA_CHECKED(katana::Uri::MakeRand(
+      katana::Uri::JoinPath(dir, "katana-topology-spill")));
+  return uri.string();
+}
+
+}  // namespace
+
+katana::EdgeShuffleTopology::~EdgeShuffleTopology() {
+  if (is_spilled_ && !spill_path_.empty()) {
+    auto path_uri = katana::Uri::Make(spill_path_);
+    if (!path_uri) {
+      return;
+    }
+    if (auto res = tsuba::FileDelete(
+            path_uri.value().DirName().string(), {path_uri.value().BaseName()});
+        !res) {
+      KATANA_LOG_WARN(
+          "removing topology spill file {}: {}", spill_path_, res.error());
+    }
+  }
+}
+
+katana::Result<void>
+katana::EdgeShuffleTopology::SpillToScratch() noexcept {
+  KATANA_LOG_DEBUG_ASSERT(!is_spilled_);
+  KATANA_LOG_DEBUG_ASSERT(!is_mem_mapped_view());
+
+  std::string path = KATANA_CHECKED(MakeTopologySpillPath());
+
+  tsuba::FileFrame ff;
+  KATANA_CHECKED(ff.Init(memory_usage()));
+  arrow::Status aro_sts = ff.Write(adj_data(), num_nodes() * sizeof(Edge));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+  aro_sts = ff.Write(dest_data(), num_edges() * sizeof(Node));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+  if (num_edges() % 2) {
+    // keep the PropertyIndex section 8-byte aligned for the readback
+    const Node padding = 0;
+    aro_sts = ff.Write(&padding, sizeof(padding));
+    if (!aro_sts.ok()) {
+      return tsuba::ArrowToTsuba(aro_sts.code());
+    }
+  }
+  aro_sts =
+      ff.Write(edge_prop_indices_.data(), num_edges() * sizeof(PropertyIndex));
+  if (!aro_sts.ok()) {
+    return tsuba::ArrowToTsuba(aro_sts.code());
+  }
+  ff.Bind(path);
+  KATANA_CHECKED_CONTEXT(ff.Persist(), "spilling topology to {}", path);
+
+  GetAdjIndices().deallocate();
+  GetDests().deallocate();
+  edge_prop_indices_.deallocate();
+  adj_view_ = nullptr;
+  dests_view_ = nullptr;
+  spill_path_ = std::move(path);
+  is_spilled_ = true;
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::EdgeShuffleTopology::RestoreFromScratch() noexcept {
+  KATANA_LOG_DEBUG_ASSERT(is_spilled_);
+
+  tsuba::FileView fv;
+  KATANA_CHECKED_CONTEXT(
+      fv.Bind(spill_path_, true), "restoring spilled topology from {}",
+      spill_path_);
+
+  const Edge* adj = fv.ptr<Edge>();
+  GetAdjIndices().allocateInterleaved(num_nodes());
+  ParallelSTL::copy(adj, adj + num_nodes(), GetAdjIndices().begin());
+
+  const Node* dests = reinterpret_cast<const Node*>(adj + num_nodes());
+  GetDests().allocateInterleaved(num_edges());
+  ParallelSTL::copy(dests, dests + num_edges(), GetDests().begin());
+
+  const PropertyIndex* props = reinterpret_cast<const PropertyIndex*>(
+      dests + num_edges() + (num_edges() % 2));
+  edge_prop_indices_.allocateInterleaved(num_edges());
+  ParallelSTL::copy(props, props + num_edges(), edge_prop_indices_.begin());
+
+  adj_view_ = GetAdjIndices().data();
+  dests_view_ = GetDests().data();
+  is_spilled_ = false;
+
+  KATANA_CHECKED(fv.Unbind());
+  katana::Uri path_uri = KATANA_CHECKED(katana::Uri::Make(spill_path_));
+  KATANA_CHECKED(
+      tsuba::FileDelete(path_uri.DirName().string(), {path_uri.BaseName()}));
+  spill_path_.clear();
+  return katana::ResultSuccess();
+}
+
+void
+katana::EdgeShuffleTopology::MergeNewEdges(
+    const katana::PropertyGraph* pg,
+    std::vector<TopologyEdgeInsert> inserts) noexcept {
+  if (inserts.empty()) {
+    return;
+  }
+
+  if (is_transposed()) {
+    for (auto& ins : inserts) {
+      std::swap(ins.src, ins.dst);
+    }
+  }
+
+  // Order the batch the way this topology's edges are sorted so the
+  // per-node pass below is a linear merge of two sorted runs.
+  auto batch_cmp = [&](const TopologyEdgeInsert& a,
+                       const TopologyEdgeInsert& b) {
+    if (a.src != b.src) {
+      return a.src < b.src;
+    }
+    switch (edge_sort_state()) {
+    case EdgeSortKind::kSortedByDestID:
+      return a.dst < b.dst;
+    case EdgeSortKind::kSortedByEdgeType: {
+      const auto type_a = pg->GetTypeOfEdge(a.prop_index);
+      const auto type_b = pg->GetTypeOfEdge(b.prop_index);
+      if (type_a != type_b) {
+        return type_a < type_b;
+      }
+      return a.dst < b.dst;
+    }
+    default:
+      // Unsorted topologies append within a node in batch order.
+      return false;
+    }
+  };
+  std::sort(inserts.begin(), inserts.end(), batch_cmp);
+
+  // True if the batch edge must be emitted before existing edge e to keep
+  // the node's edges sorted; ties keep existing edges first (stable).
+  auto insert_goes_first = [&](const TopologyEdgeInsert& ins, Edge e) {
+    switch (edge_sort_state()) {
+    case EdgeSortKind::kSortedByDestID:
+      return ins.dst < edge_dest(e);
+    case EdgeSortKind::kSortedByEdgeType: {
+      const auto ins_type = pg->GetTypeOfEdge(ins.prop_index);
+      const auto e_type = pg->GetTypeOfEdge(edge_property_index(e));
+      if (ins_type != e_type) {
+        return ins_type < e_type;
+      }
+      return ins.dst < edge_dest(e);
+    }
+    default:
+      return false;
+    }
+  };
+
+  const size_t num_nodes = this->num_nodes();
+  const Edge new_num_edges = num_edges() + inserts.size();
+
+  NUMAArray<Edge> new_adj_indices;
+  new_adj_indices.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) { new_adj_indices[n] = degree(static_cast<Node>(n)); },
+      katana::no_stats());
+  for (const auto& ins : inserts) {
+    KATANA_LOG_DEBUG_ASSERT(ins.src < num_nodes);
+    new_adj_indices[ins.src] += 1;
+  }
+  katana::ParallelSTL::partial_sum(
+      new_adj_indices.begin(), new_adj_indices.end(), new_adj_indices.begin());
+  KATANA_LOG_DEBUG_ASSERT(new_adj_indices[num_nodes - 1] == new_num_edges);
+
+  NUMAArray<Node> new_dests;
+  new_dests.allocateInterleaved(new_num_edges);
+  PropIndexVec new_prop_indices;
+  new_prop_indices.allocateInterleaved(new_num_edges);
+
+  katana::do_all(
+      katana::iterate(Node{0}, static_cast<Node>(num_nodes)),
+      [&](Node n) {
+        auto batch_beg = std::lower_bound(
+            inserts.begin(), inserts.end(), n,
+            [](const TopologyEdgeInsert& ins, Node node) {
+              return ins.src < node;
+            });
+        auto batch_end = std::upper_bound(
+            inserts.begin(), inserts.end(), n,
+            [](Node node, const TopologyEdgeInsert& ins) {
+              return node < ins.src;
+            });
+
+        Edge out = n > 0 ? new_adj_indices[n - 1] : 0;
+        auto bi = batch_beg;
+        for (auto e : edges(n)) {
+          while (bi != batch_end && insert_goes_first(*bi, e)) {
+            new_dests[out] = bi->dst;
+            new_prop_indices[out] = bi->prop_index;
+            ++out;
+            ++bi;
+          }
+          new_dests[out] = edge_dest(e);
+          new_prop_indices[out] = edge_property_index(e);
+          ++out;
+        }
+        for (; bi != batch_end; ++bi) {
+          new_dests[out] = bi->dst;
+          new_prop_indices[out] = bi->prop_index;
+          ++out;
+        }
+        KATANA_LOG_DEBUG_ASSERT(out == new_adj_indices[n]);
+      },
+      katana::steal(), katana::loopname("EdgeShuffleTopologyMergeNewEdges"));
+
+  Base::ReplaceStorage(std::move(new_adj_indices), std::move(new_dests));
+  edge_prop_indices_ = std::move(new_prop_indices);
+}
+
 std::unique_ptr<katana::CondensedTypeIDMap>
 katana::CondensedTypeIDMap::MakeFromEdgeTypes(
     const katana::PropertyGraph* pg) noexcept {
   TypeIDToIndexMap edge_type_to_index;
   IndexToTypeIDMap edge_index_to_type;
 
-  katana::PerThreadStorage<katana::gstl::Set<EntityType>> edgeTypes;
-
   const auto& topo = pg->topology();
 
+  // EntityType is a small integer, so a bitmap of observed types scales
+  // with cores with no per-thread sets to merge afterwards.
+  constexpr size_t kNumPossibleTypes =
+      size_t{std::numeric_limits<EntityType>::max()} + 1;
+  katana::DynamicBitset present_types;
+  present_types.resize(kNumPossibleTypes);
+
   katana::do_all(
       katana::iterate(Edge{0}, topo.num_edges()),
       [&](const Edge& e) {
         EntityType type = pg->GetTypeOfEdge(e);
-        edgeTypes.getLocal()->insert(type);
+        if (!present_types.test(type)) {
+          present_types.set(type);
+        }
       },
       katana::no_stats());
 
-  // ordered map
-  std::set<EntityType> mergedSet;
-  for (uint32_t i = 0; i < katana::activeThreads; ++i) {
-    auto& edgeTypesSet = *edgeTypes.getRemote(i);
-    for (auto edgeType : edgeTypesSet) {
-      mergedSet.insert(edgeType);
-    }
-  }
-
-  // unordered map
+  // Bit order gives ascending type IDs, matching the old std::set merge.
   uint32_t num_edge_types = 0u;
-  for (const auto& edgeType : mergedSet) {
-    edge_type_to_index[edgeType] = num_edge_types++;
-    edge_index_to_type.emplace_back(edgeType);
+  for (size_t type = 0; type < kNumPossibleTypes; ++type) {
+    if (present_types.test(type)) {
+      edge_type_to_index[static_cast<EntityType>(type)] = num_edge_types++;
+      edge_index_to_type.emplace_back(static_cast<EntityType>(type));
+    }
   }
 
-  // TODO(amber): introduce a per-thread-container type that frees memory
-  // correctly
-  katana::on_each([&](unsigned, unsigned) {
-    // free up memory by resetting
-    *edgeTypes.getLocal() = gstl::Set<EntityType>();
-  });
-
   return std::make_unique<CondensedTypeIDMap>(CondensedTypeIDMap{
       std::move(edge_type_to_index), std::move(edge_index_to_type)});
 }
@@ -396,26 +966,27 @@ katana::EdgeTypeAwareTopology::CreatePerEdgeTypeAdjacencyIndex(
   AdjIndexVec adj_indices;
   adj_indices.allocateInterleaved(sz);
 
+  const size_t num_types = edge_type_index->num_unique_types();
   katana::do_all(
       katana::iterate(e_topo->all_nodes()),
       [&](Node N) {
-        auto offset = N * edge_type_index->num_unique_types();
+        auto offset = N * num_types;
         uint32_t index = 0;
         for (auto e : e_topo->edges(N)) {
           // Since we sort the edges, we must use the
           // edge_property_index because EdgeShuffleTopology rearranges the edges
           const auto type = pg->GetTypeOfEdge(e_topo->edge_property_index(e));
-          while (type != edge_type_index->GetType(index)) {
+          // Dense O(1) lookup of the edge's condensed index; the scan fills
+          // the boundaries of every type skipped over since the last edge.
+          const uint32_t type_pos = edge_type_index->GetIndex(type);
+          KATANA_LOG_DEBUG_ASSERT(type_pos >= index && type_pos < num_types);
+          for (; index < type_pos; ++index) {
             adj_indices[offset + index] = e;
-            index++;
-            KATANA_LOG_DEBUG_ASSERT(
-                index < edge_type_index->num_unique_types());
           }
         }
         auto e = *e_topo->edges(N).end();
-        while (index < edge_type_index->num_unique_types()) {
+        for (; index < num_types; ++index) {
           adj_indices[offset + index] = e;
-          index++;
         }
       },
       katana::no_stats(), katana::steal());
@@ -692,6 +1263,229 @@ katana::ProjectedTopology::MakeTypeProjectedTopology(
       std::move(original_to_projected_edges_mapping),
       std::move(projected_to_original_edges_mapping)});
 }
+
+std::unique_ptr<katana::LazyProjectedTopology>
+katana::LazyProjectedTopology::MakeTypeProjection(
+    const katana::PropertyGraph* pg, const std::vector<std::string>& node_types,
+    const std::vector<std::string>& edge_types) {
+  KATANA_LOG_DEBUG_ASSERT(pg);
+
+  const auto& topology = pg->topology();
+
+  katana::DynamicBitset bitset_nodes;
+  bitset_nodes.resize(topology.num_nodes());
+
+  uint64_t num_active_nodes = 0;
+
+  if (node_types.empty()) {
+    num_active_nodes = topology.num_nodes();
+    katana::do_all(katana::iterate(topology.all_nodes()), [&](auto src) {
+      bitset_nodes.set(src);
+    });
+  } else {
+    std::set<katana::EntityTypeID> node_entity_type_ids;
+
+    for (auto node_type : node_types) {
+      auto entity_type_id = pg->GetNodeEntityTypeID(node_type);
+      node_entity_type_ids.insert(entity_type_id);
+    }
+
+    katana::GAccumulator<uint64_t> accum_num_active_nodes;
+
+    katana::do_all(katana::iterate(topology.all_nodes()), [&](auto src) {
+      for (auto type : node_entity_type_ids) {
+        if (pg->DoesNodeHaveType(src, type)) {
+          accum_num_active_nodes += 1;
+          bitset_nodes.set(src);
+          return;
+        }
+      }
+    });
+    num_active_nodes = accum_num_active_nodes.reduce();
+  }
+
+  // Scatter the active node IDs into an ascending list via a prefix sum
+  // over membership marks; the marks are scratch and freed on return.
+  NUMAArray<Node> node_offsets;
+  node_offsets.allocateInterleaved(topology.num_nodes());
+  katana::do_all(katana::iterate(topology.all_nodes()), [&](auto src) {
+    node_offsets[src] = bitset_nodes.test(src) ? 1 : 0;
+  });
+  katana::ParallelSTL::partial_sum(
+      node_offsets.begin(), node_offsets.end(), node_offsets.begin());
+
+  NUMAArray<Node> active_node_list;
+  active_node_list.allocateInterleaved(num_active_nodes);
+  katana::do_all(katana::iterate(topology.all_nodes()), [&](auto src) {
+    if (bitset_nodes.test(src)) {
+      active_node_list[node_offsets[src] - 1] = src;
+    }
+  });
+
+  katana::DynamicBitset bitset_edges;
+  bitset_edges.resize(topology.num_edges());
+
+  katana::GAccumulator<uint64_t> accum_num_active_edges;
+
+  if (edge_types.empty()) {
+    // keep all edges between active endpoints
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_active_nodes),
+        [&](uint64_t n) {
+          auto src = active_node_list[n];
+          for (Edge e : topology.edges(src)) {
+            auto dest = topology.edge_dest(e);
+            if (bitset_nodes.test(dest)) {
+              bitset_edges.set(e);
+              accum_num_active_edges += 1;
+            }
+          }
+        },
+        katana::steal());
+  } else {
+    std::set<katana::EntityTypeID> edge_entity_type_ids;
+
+    for (auto edge_type : edge_types) {
+      auto entity_type_id = pg->GetEdgeEntityTypeID(edge_type);
+      edge_entity_type_ids.insert(entity_type_id);
+    }
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_active_nodes),
+        [&](uint64_t n) {
+          auto src = active_node_list[n];
+          for (Edge e : topology.edges(src)) {
+            auto dest = topology.edge_dest(e);
+            if (bitset_nodes.test(dest)) {
+              for (auto type : edge_entity_type_ids) {
+                if (pg->DoesEdgeHaveType(e, type)) {
+                  bitset_edges.set(e);
+                  accum_num_active_edges += 1;
+                  break;
+                }
+              }
+            }
+          }
+        },
+        katana::steal());
+  }
+
+  return std::unique_ptr<LazyProjectedTopology>(new LazyProjectedTopology{
+      &topology, std::move(bitset_nodes), std::move(bitset_edges),
+      std::move(active_node_list), accum_num_active_edges.reduce(), node_types,
+      edge_types});
+}
+
+std::unique_ptr<katana::CompressedTopology>
+katana::CompressedTopology::Make(
+    const katana::EdgeShuffleTopology& sorted_topo) noexcept {
+  KATANA_LOG_DEBUG_ASSERT(sorted_topo.has_edges_sorted_by(
+      EdgeShuffleTopology::EdgeSortKind::kSortedByDestID));
+
+  const size_t num_nodes = sorted_topo.num_nodes();
+  const Edge num_edges = sorted_topo.num_edges();
+
+  AdjIndexVec adj_indices;
+  adj_indices.allocateInterleaved(num_nodes);
+  katana::ParallelSTL::copy(
+      sorted_topo.adj_data(), sorted_topo.adj_data() + num_nodes,
+      adj_indices.begin());
+
+  // First pass: per-node encoded byte counts, then prefix-summed into end
+  // offsets so the second pass can encode each node independently.
+  NUMAArray<uint64_t> byte_offsets;
+  byte_offsets.allocateInterleaved(num_nodes);
+
+  const Node* dests = sorted_topo.dest_data();
+
+  katana::do_all(
+      katana::iterate(Node{0}, static_cast<Node>(num_nodes)),
+      [&](Node n) {
+        const Edge e_beg = n > 0 ? adj_indices[n - 1] : 0;
+        const Edge e_end = adj_indices[n];
+        uint64_t bytes = 0;
+        Node prev = 0;
+        for (Edge e = e_beg; e < e_end; ++e) {
+          const Node dest = dests[e];
+          KATANA_LOG_DEBUG_ASSERT(e == e_beg || dest >= prev);
+          bytes += internal::VarintLength(e == e_beg ? dest : dest - prev);
+          prev = dest;
+        }
+        byte_offsets[n] = bytes;
+      },
+      katana::steal(), katana::loopname("CompressedTopologySizePass"));
+
+  katana::ParallelSTL::partial_sum(
+      byte_offsets.begin(), byte_offsets.end(), byte_offsets.begin());
+
+  const uint64_t total_bytes = num_nodes > 0 ? byte_offsets[num_nodes - 1] : 0;
+
+  NUMAArray<uint8_t> compressed_dests;
+  compressed_dests.allocateInterleaved(total_bytes);
+
+  // Second pass: delta/varint encode each node's sorted destinations.
+  katana::do_all(
+      katana::iterate(Node{0}, static_cast<Node>(num_nodes)),
+      [&](Node n) {
+        const Edge e_beg = n > 0 ? adj_indices[n - 1] : 0;
+        const Edge e_end = adj_indices[n];
+        uint8_t* buf = compressed_dests.data() +
+                       (n > 0 ? byte_offsets[n - 1] : 0);
+        Node prev = 0;
+        for (Edge e = e_beg; e < e_end; ++e) {
+          const Node dest = dests[e];
+          buf = internal::EncodeVarint(buf, e == e_beg ? dest : dest - prev);
+          prev = dest;
+        }
+      },
+      katana::steal(), katana::loopname("CompressedTopologyEncodePass"));
+
+  PropIndexVec edge_prop_indices;
+  edge_prop_indices.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(Edge{0}, num_edges), [&](Edge e) {
+        edge_prop_indices[e] = sorted_topo.edge_property_index(e);
+      });
+
+  return std::unique_ptr<CompressedTopology>(new CompressedTopology{
+      std::move(adj_indices), std::move(byte_offsets),
+      std::move(compressed_dests), std::move(edge_prop_indices), num_edges});
+}
+
+std::unique_ptr<katana::EdgeBlockedTopology>
+katana::EdgeBlockedTopology::Make(const PropertyGraph* pg) noexcept {
+  const GraphTopology& csr = pg->topology();
+  const uint64_t num_edges = csr.num_edges();
+  const uint64_t num_blocks =
+      (num_edges + kEdgesPerBlock - 1) / kEdgesPerBlock;
+
+  NUMAArray<EdgeBlockDescriptor> blocks;
+  blocks.allocateInterleaved(num_blocks);
+
+  const Node* dests = csr.dest_data();
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_blocks),
+      [&](uint64_t block_id) {
+        const Edge e_beg = block_id * kEdgesPerBlock;
+        const Edge e_end = std::min(e_beg + kEdgesPerBlock, num_edges);
+
+        Node min_dest = std::numeric_limits<Node>::max();
+        Node max_dest = 0;
+        for (Edge e = e_beg; e < e_end; ++e) {
+          min_dest = std::min(min_dest, dests[e]);
+          max_dest = std::max(max_dest, dests[e]);
+        }
+
+        blocks[block_id] = EdgeBlockDescriptor{
+            e_beg, e_end, csr.edge_source(e_beg), min_dest, max_dest};
+      },
+      katana::steal(), katana::loopname("CreateEdgeBlocks"));
+
+  return std::unique_ptr<EdgeBlockedTopology>(
+      new EdgeBlockedTopology{&csr, std::move(blocks)});
+}
+
 const katana::GraphTopology*
 katana::PGViewCache::GetOriginalTopology(
     const PropertyGraph* pg) const noexcept {
@@ -730,16 +1524,78 @@ katana::PGViewCache::BuildOrGetEdgeShuffTopo(
       std::find_if(edge_shuff_topos_.begin(), edge_shuff_topos_.end(), pred);
 
   if (it != edge_shuff_topos_.end()) {
+    TouchTopology(it->get());
     KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, it->get()));
     return it->get();
   } else {
     edge_shuff_topos_.emplace_back(
         EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind));
+    TouchTopology(edge_shuff_topos_.back().get());
     KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, edge_shuff_topos_.back().get()));
     return edge_shuff_topos_.back().get();
   }
 }
 
+void
+katana::PGViewCache::AdoptEdgeShuffTopo(
+    std::unique_ptr<EdgeShuffleTopology> topo) noexcept {
+  KATANA_LOG_DEBUG_ASSERT(topo);
+  edge_shuff_topos_.emplace_back(std::move(topo));
+  TouchTopology(edge_shuff_topos_.back().get());
+}
+
+namespace {
+
+size_t
+TopologyBudgetBytes() {
+  static size_t budget = []() -> size_t {
+    int budget_mb = 0;
+    if (katana::GetEnv("KATANA_TOPOLOGY_CACHE_BUDGET_MB", &budget_mb) &&
+        budget_mb > 0) {
+      return static_cast<size_t>(budget_mb) << 20;
+    }
+    return 0;
+  }();
+  return budget;
+}
+
+}  // namespace
+
+void
+katana::PGViewCache::TouchTopology(EdgeShuffleTopology* topo) noexcept {
+  const size_t budget = TopologyBudgetBytes();
+  if (budget == 0) {
+    return;
+  }
+  if (topo->is_spilled()) {
+    if (auto res = topo->RestoreFromScratch(); !res) {
+      KATANA_LOG_FATAL("cannot restore spilled topology: {}", res.error());
+    }
+  }
+  // mem-mapped views pin nothing and pinned topologies are not the
+  // budget's to reclaim; keep both out of the LRU
+  if (topo->memory_usage() == 0 || unspillable_topos_.count(topo) > 0) {
+    return;
+  }
+  if (!topo_lru_) {
+    topo_lru_ = std::make_unique<Cache<TopologyLRUKey, EdgeShuffleTopology*>>(
+        budget,
+        [](EdgeShuffleTopology* const& t) { return t->memory_usage(); },
+        [this](const TopologyLRUKey& key, uint64_t, void*) {
+          if (unspillable_topos_.count(key.topo) > 0) {
+            // wrapped by a type-aware view since insertion; stays resident
+            return;
+          }
+          if (auto res = key.topo->SpillToScratch(); !res) {
+            KATANA_LOG_WARN(
+                "failed to spill topology, keeping it resident: {}",
+                res.error());
+          }
+        });
+  }
+  topo_lru_->Insert(TopologyLRUKey{topo}, topo);
+}
+
 katana::ShuffleTopology*
 katana::PGViewCache::BuildOrGetShuffTopo(
     const katana::PropertyGraph* pg,
@@ -791,6 +1647,9 @@ katana::PGViewCache::BuildOrGetEdgeTypeAwareTopo(
   } else {
     auto sorted_topo = BuildOrGetEdgeShuffTopo(
         pg, tpose_kind, EdgeShuffleTopology::EdgeSortKind::kSortedByEdgeType);
+    // the type-aware topology wraps sorted_topo's arrays for its lifetime,
+    // so the budget must never spill them out from under it
+    unspillable_topos_.insert(sorted_topo);
     auto edge_type_index = BuildOrGetEdgeTypeIndex(pg);
     edge_type_aware_topos_.emplace_back(
         EdgeTypeAwareTopology::MakeFrom(pg, edge_type_index, sorted_topo));
@@ -801,6 +1660,35 @@ katana::PGViewCache::BuildOrGetEdgeTypeAwareTopo(
   }
 }
 
+katana::CompressedTopology*
+katana::PGViewCache::BuildOrGetCompressedTopo(
+    const katana::PropertyGraph* pg) noexcept {
+  if (compressed_topo_ && compressed_topo_->is_valid()) {
+    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, compressed_topo_.get()));
+    return compressed_topo_.get();
+  }
+
+  auto sorted_topo = BuildOrGetEdgeShuffTopo(
+      pg, EdgeShuffleTopology::TransposeKind::kNo,
+      EdgeShuffleTopology::EdgeSortKind::kSortedByDestID);
+  compressed_topo_ = CompressedTopology::Make(*sorted_topo);
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, compressed_topo_.get()));
+  return compressed_topo_.get();
+}
+
+katana::EdgeBlockedTopology*
+katana::PGViewCache::BuildOrGetBlockedTopo(
+    const katana::PropertyGraph* pg) noexcept {
+  if (blocked_topo_ && blocked_topo_->is_valid()) {
+    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, blocked_topo_.get()));
+    return blocked_topo_.get();
+  }
+
+  blocked_topo_ = EdgeBlockedTopology::Make(pg);
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, blocked_topo_.get()));
+  return blocked_topo_.get();
+}
+
 katana::ProjectedTopology*
 katana::PGViewCache::BuildOrGetProjectedGraphTopo(
     const PropertyGraph* pg, const std::vector<std::string>& node_types,
@@ -815,6 +1703,164 @@ katana::PGViewCache::BuildOrGetProjectedGraphTopo(
   return projected_topos_.get();
 }
 
+void
+katana::PGViewCache::PatchTopologies(
+    const PropertyGraph* pg,
+    const std::vector<TopologyEdgeInsert>& inserts) noexcept {
+  if (inserts.empty()) {
+    return;
+  }
+
+  for (auto& topo : edge_shuff_topos_) {
+    if (topo->is_valid()) {
+      // spilled topologies still reflect the pre-batch graph; bring them
+      // back so the merge keeps every cached copy consistent
+      TouchTopology(topo.get());
+      topo->MergeNewEdges(pg, inserts);
+    }
+  }
+
+  // Node-shuffled orders key on degrees or types that the batch may have
+  // changed; rebuild those on demand instead of patching.
+  for (auto& topo : fully_shuff_topos_) {
+    topo->invalidate();
+  }
+
+  // The sorted topologies underlying the edge-type-aware views were merged
+  // above; only their per-type indices need recomputing.
+  for (auto& topo : edge_type_aware_topos_) {
+    if (topo->is_valid()) {
+      topo->RefreshAfterMerge(pg);
+    }
+  }
+
+  if (compressed_topo_) {
+    compressed_topo_->invalidate();
+  }
+  if (blocked_topo_) {
+    blocked_topo_->invalidate();
+  }
+  projected_topos_.reset();
+  // the merged topologies renumbered their edges, so any permuted copies
+  // are stale
+  materialized_edge_props_.clear();
+}
+
+void
+katana::PGViewCache::InvalidateTopologies() noexcept {
+  for (auto& topo : edge_shuff_topos_) {
+    topo->invalidate();
+  }
+  for (auto& topo : fully_shuff_topos_) {
+    topo->invalidate();
+  }
+  for (auto& topo : edge_type_aware_topos_) {
+    topo->invalidate();
+  }
+  if (compressed_topo_) {
+    compressed_topo_->invalidate();
+  }
+  if (blocked_topo_) {
+    blocked_topo_->invalidate();
+  }
+  projected_topos_.reset();
+  materialized_edge_props_.clear();
+}
+
+void
+katana::PGViewCache::DropMaterializedEdgeProperty(
+    const std::string& name) noexcept {
+  for (auto& [topo, props] : materialized_edge_props_) {
+    props.erase(name);
+  }
+}
+
+katana::Result<std::shared_ptr<arrow::Array>>
+katana::PGViewCache::GetMaterializedEdgeProperty(
+    const PropertyGraph* pg, const EdgeShuffleTopology* topo,
+    const std::string& name) {
+  KATANA_LOG_DEBUG_ASSERT(pg && topo);
+
+  auto& for_topo = materialized_edge_props_[topo];
+  if (auto it = for_topo.find(name); it != for_topo.end()) {
+    return it->second;
+  }
+
+  std::shared_ptr<arrow::ChunkedArray> column =
+      KATANA_CHECKED(pg->GetEdgeProperty(name));
+  if (column->num_chunks() != 1) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented,
+        "cannot materialize edge property {}: {} chunks; only single-chunk "
+        "columns are supported",
+        name, column->num_chunks());
+  }
+  std::shared_ptr<arrow::Array> chunk = column->chunk(0);
+  if (chunk->null_count() != 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented,
+        "cannot materialize edge property {}: column has nulls", name);
+  }
+  const auto& type = chunk->type();
+  const auto* fixed = dynamic_cast<const arrow::FixedWidthType*>(type.get());
+  if (fixed == nullptr || fixed->bit_width() % 8 != 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError,
+        "cannot materialize edge property {}: type {} is not byte-aligned "
+        "fixed width",
+        name, type->ToString());
+  }
+
+  const size_t width = fixed->bit_width() / 8;
+  const size_t num_edges = topo->num_edges();
+  if (chunk->length() < static_cast<int64_t>(num_edges)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "cannot materialize edge property {}: column has {} values for {} "
+        "edges",
+        name, chunk->length(), num_edges);
+  }
+
+  std::shared_ptr<arrow::Buffer> permuted =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_edges * width));
+  const std::shared_ptr<arrow::ArrayData>& data = chunk->data();
+  const uint8_t* src = data->buffers[1]->data() + data->offset * width;
+  const GraphTopologyTypes::PropertyIndex* perm =
+      topo->edge_property_index_data();
+
+  switch (width) {
+  case 1:
+    ParallelSTL::gather(
+        perm, perm + num_edges, src, permuted->mutable_data());
+    break;
+  case 2:
+    ParallelSTL::gather(
+        perm, perm + num_edges, reinterpret_cast<const uint16_t*>(src),
+        reinterpret_cast<uint16_t*>(permuted->mutable_data()));
+    break;
+  case 4:
+    ParallelSTL::gather(
+        perm, perm + num_edges, reinterpret_cast<const uint32_t*>(src),
+        reinterpret_cast<uint32_t*>(permuted->mutable_data()));
+    break;
+  case 8:
+    ParallelSTL::gather(
+        perm, perm + num_edges, reinterpret_cast<const uint64_t*>(src),
+        reinterpret_cast<uint64_t*>(permuted->mutable_data()));
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented,
+        "cannot materialize edge property {}: unsupported element width {}",
+        name, width);
+  }
+
+  std::shared_ptr<arrow::Array> result = arrow::MakeArray(
+      arrow::ArrayData::Make(type, num_edges, {nullptr, permuted}, 0));
+  for_topo.emplace(name, result);
+  return result;
+}
+
 katana::GraphTopology
 katana::CreateUniformRandomTopology(
     const size_t num_nodes, const size_t edges_per_node) noexcept {
@@ -73,6 +73,9 @@ makeHWTopo() {
   const unsigned threadsPerSocket =
       (mti.maxThreads + mti.maxThreads - 1) / mti.maxSockets;
 
+  const unsigned logicalPerPhysical =
+      (mti.maxThreads + mti.maxThreads - 1) / mti.maxCores;
+
   // Describe dense configuration first; then, sort logical threads to the
   // back.
   for (unsigned i = 0; i < mti.maxThreads; ++i) {
@@ -82,14 +85,12 @@ makeHWTopo() {
         .socketLeader = leader,
         .socket = socket,
         .numaNode = socket,
+        .core = i / logicalPerPhysical,
         .osContext = i,
         .osNumaNode = socket,
     });
   }
 
-  const unsigned logicalPerPhysical =
-      (mti.maxThreads + mti.maxThreads - 1) / mti.maxCores;
-
   std::sort(
       tti.begin(), tti.end(),
       [&](const ThreadTopoInfo& a, const ThreadTopoInfo& b) {
@@ -133,6 +134,12 @@ katana::bindThreadSelf([[maybe_unused]] unsigned osContext) {
   return true;
 }
 
+//! no per-thread memory policy on Darwin
+bool
+katana::bindThreadMemoryPreferred([[maybe_unused]] unsigned osNumaNode) {
+  return false;
+}
+
 HWTopoInfo
 katana::getHWTopo() {
   static SimpleLock lock;
@@ -18,6 +18,9 @@
  */
 
 #include <dlfcn.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <array>
@@ -29,9 +32,12 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <tuple>
+#include <unordered_map>
 
 #include "katana/HWTopo.h"
 #include "katana/SimpleLock.h"
+#include "katana/Threads.h"
 #include "katana/gIO.h"
 
 #ifdef KATANA_USE_NUMA
@@ -251,6 +257,98 @@ markValid(std::vector<cpuinfo>& info) {
   }
 }
 
+//! The efficiency cores of a hybrid (P/E) part are listed under cpu_atom
+std::vector<int>
+parseAtomCPUs() {
+  std::ifstream data("/sys/devices/cpu_atom/cpus");
+  if (!data) {
+    return {};
+  }
+  std::string line;
+  std::getline(data, line);
+  return katana::parseCPUList(line);
+}
+
+//! Filter and reorder the usable cpus according to the selected pinning
+//! profile. Runs after markSMT, so the smt flags travel with their cpus.
+void
+applyPinningProfile(std::vector<cpuinfo>& info) {
+  using Order = katana::ThreadPinningProfile::Order;
+
+  const katana::ThreadPinningProfile& profile =
+      katana::getThreadPinningProfile();
+
+  if (profile.excludeEfficiencyCores) {
+    auto atom = parseAtomCPUs();
+    if (atom.empty()) {
+      KATANA_WARN_ONCE(
+          "no-e-cores requested but /sys does not describe a hybrid part; "
+          "keeping every core");
+    } else {
+      std::sort(atom.begin(), atom.end());
+      info.erase(
+          std::remove_if(
+              info.begin(), info.end(),
+              [&atom](const cpuinfo& c) {
+                return std::binary_search(
+                    atom.begin(), atom.end(), static_cast<int>(c.proc));
+              }),
+          info.end());
+    }
+  }
+
+  if (!profile.sockets.empty()) {
+    info.erase(
+        std::remove_if(
+            info.begin(), info.end(),
+            [&profile](const cpuinfo& c) {
+              return std::find(
+                         profile.sockets.begin(), profile.sockets.end(),
+                         c.physid) == profile.sockets.end();
+            }),
+        info.end());
+  }
+
+  if (info.empty()) {
+    KATANA_SYS_DIE("thread pinning profile excludes every usable cpu");
+  }
+
+  switch (profile.order) {
+  case Order::kCompact:
+    // fill a core and its SMT contexts before moving to the next core
+    std::sort(info.begin(), info.end(), [](const cpuinfo& a, const cpuinfo& b) {
+      return std::tie(a.physid, a.coreid, a.proc) <
+             std::tie(b.physid, b.coreid, b.proc);
+    });
+    break;
+  case Order::kScatter: {
+    // round robin across sockets: rank each cpu within its socket in the
+    // default order, then interleave by rank
+    std::unordered_map<unsigned, unsigned> seen;
+    std::vector<unsigned> rank(info.size());
+    for (unsigned i = 0; i < info.size(); ++i) {
+      rank[i] = seen[info[i].physid]++;
+    }
+    std::vector<unsigned> order(info.size());
+    for (unsigned i = 0; i < info.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&rank](unsigned a, unsigned b) { return rank[a] < rank[b]; });
+    std::vector<cpuinfo> reordered;
+    reordered.reserve(info.size());
+    for (unsigned i : order) {
+      reordered.push_back(info[i]);
+    }
+    info = std::move(reordered);
+    break;
+  }
+  case Order::kDefault:
+    break;
+  }
+}
+
 katana::HWTopoInfo
 makeHWTopo() {
   katana::MachineTopoInfo retMTI;
@@ -267,6 +365,7 @@ makeHWTopo() {
 
   std::sort(info.begin(), info.end());
   markSMT(info);
+  applyPinningProfile(info);
   retMTI.maxSockets = countSockets(info);
   retMTI.maxThreads = info.size();
   retMTI.maxCores = countCores(info);
@@ -277,9 +376,11 @@ makeHWTopo() {
   // compute renumberings
   std::set<unsigned> sockets;
   std::set<unsigned> numaNodes;
+  std::set<std::pair<int, int>> cores;
   for (auto& i : info) {
     sockets.insert(i.physid);
     numaNodes.insert(i.numaNode);
+    cores.insert(std::make_pair(i.physid, i.coreid));
   }
   unsigned mid = 0;  // max socket id
   for (unsigned i = 0; i < info.size(); ++i) {
@@ -292,11 +393,14 @@ makeHWTopo() {
         std::find_if(info.begin(), info.end(), [pid](const cpuinfo& c) {
           return c.physid == pid;
         }));
+    unsigned core = std::distance(
+        cores.begin(),
+        cores.find(std::make_pair(info[i].physid, info[i].coreid)));
     retTTI.push_back(katana::ThreadTopoInfo{
         i, leader, repid,
         (unsigned)std::distance(
             numaNodes.begin(), numaNodes.find(info[i].numaNode)),
-        mid, info[i].proc, info[i].numaNode});
+        core, mid, info[i].proc, info[i].numaNode});
   }
 
   return {
@@ -344,3 +448,32 @@ katana::bindThreadSelf([[maybe_unused]] unsigned osContext) {
   return false;
 #endif
 }
+
+//! sets the calling thread's memory policy to prefer "osNumaNode"
+bool
+katana::bindThreadMemoryPreferred(unsigned osNumaNode) {
+#ifdef SYS_set_mempolicy
+  // a fixed 1024-node mask, the same size libnuma assumes
+  constexpr unsigned maxNodes = 1024;
+  constexpr unsigned bitsPerWord = 8 * sizeof(unsigned long);
+  std::array<unsigned long, maxNodes / bitsPerWord> mask{};
+
+  if (osNumaNode >= maxNodes) {
+    return false;
+  }
+  mask[osNumaNode / bitsPerWord] = 1UL << (osNumaNode % bitsPerWord);
+
+  // direct syscall so we don't have to link (or dlopen) libnuma for this
+  if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), maxNodes) != 0) {
+    katana::gWarn(
+        "Could not set preferred NUMA node to ", osNumaNode, " (",
+        strerror(errno), ")");
+    return false;
+  }
+  return true;
+#else
+  (void)osNumaNode;
+  KATANA_WARN_ONCE("Cannot set memory policy on this platform.");
+  return false;
+#endif
+}
@@ -0,0 +1,222 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/JobScheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "katana/Logging.h"
+#include "katana/Threads.h"
+
+namespace {
+
+katana::JobScheduler* JS = nullptr;
+
+// job the calling application thread drives, and the loop nesting depth on
+// it; nested loops run inside the slice already admitted for the outermost
+thread_local katana::JobScheduler::JobId tl_job =
+    katana::JobScheduler::kNoJob;
+thread_local unsigned tl_depth = 0;
+
+}  // namespace
+
+void
+katana::internal::setJobScheduler(JobScheduler* js) {
+  KATANA_LOG_VASSERT(!(JS && js), "double initialization of JobScheduler");
+  JS = js;
+}
+
+katana::JobScheduler*
+katana::GetJobScheduler() {
+  return JS;
+}
+
+katana::JobScheduler::JobId
+katana::JobScheduler::CreateJob(
+    std::string name, unsigned weight, unsigned max_threads) {
+  KATANA_LOG_VASSERT(weight > 0, "job weight must be positive");
+  std::lock_guard<std::mutex> lg(lock_);
+
+  // start at the smallest live virtual time so a newcomer neither starves
+  // nor monopolizes the pool
+  uint64_t vtime = std::numeric_limits<uint64_t>::max();
+  for (const Job& job : jobs_) {
+    if (job.live) {
+      vtime = std::min(vtime, job.vtime_ns);
+    }
+  }
+  if (vtime == std::numeric_limits<uint64_t>::max()) {
+    vtime = 0;
+  }
+
+  JobId id = 0;
+  for (; id < jobs_.size(); ++id) {
+    if (!jobs_[id].live) {
+      break;
+    }
+  }
+  if (id == jobs_.size()) {
+    jobs_.emplace_back();
+  }
+
+  Job& job = jobs_[id];
+  job.name = std::move(name);
+  job.weight = weight;
+  job.max_threads = max_threads;
+  job.vtime_ns = vtime;
+  job.waiting = 0;
+  job.blocked = false;
+  job.live = true;
+  return id;
+}
+
+void
+katana::JobScheduler::DestroyJob(JobId job) {
+  std::lock_guard<std::mutex> lg(lock_);
+  KATANA_LOG_VASSERT(
+      job < jobs_.size() && jobs_[job].live, "destroying unknown job");
+  KATANA_LOG_VASSERT(
+      jobs_[job].waiting == 0 && running_job_ != job,
+      "destroying job \"{}\" with loops in flight", jobs_[job].name);
+  jobs_[job].live = false;
+  // the remaining jobs no longer wait on this one's virtual time
+  cv_.notify_all();
+}
+
+void
+katana::JobScheduler::AttachCurrentThread(JobId job) {
+  KATANA_LOG_VASSERT(
+      tl_job == kNoJob, "thread is already attached to a job");
+  std::lock_guard<std::mutex> lg(lock_);
+  KATANA_LOG_VASSERT(
+      job < jobs_.size() && jobs_[job].live, "attaching to unknown job");
+  tl_job = job;
+}
+
+void
+katana::JobScheduler::DetachCurrentThread() {
+  KATANA_LOG_VASSERT(tl_job != kNoJob, "thread is not attached to a job");
+  KATANA_LOG_VASSERT(tl_depth == 0, "detaching inside a parallel loop");
+  tl_job = kNoJob;
+}
+
+bool
+katana::JobScheduler::NeedsGate() const {
+  return tl_job != kNoJob && tl_depth == 0;
+}
+
+bool
+katana::JobScheduler::IsNext(JobId job) const {
+  const uint64_t mine = jobs_[job].vtime_ns;
+  for (JobId other = 0; other < jobs_.size(); ++other) {
+    if (other == job || !jobs_[other].live || jobs_[other].waiting == 0) {
+      continue;
+    }
+    if (jobs_[other].vtime_ns < mine ||
+        (jobs_[other].vtime_ns == mine && other < job)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+unsigned
+katana::JobScheduler::Allotment(const Job& job, unsigned usable) const {
+  // the cap only binds while somebody else could use the spare threads;
+  // with every other job blocked or gone, lend the whole machine
+  bool others_runnable = false;
+  for (JobId other = 0; other < jobs_.size(); ++other) {
+    const Job& candidate = jobs_[other];
+    if (&candidate != &job && candidate.live && !candidate.blocked) {
+      others_runnable = true;
+      break;
+    }
+  }
+  if (!others_runnable || job.max_threads == 0) {
+    return usable;
+  }
+  return std::min(job.max_threads, usable);
+}
+
+unsigned
+katana::JobScheduler::EnterLoop() {
+  std::unique_lock<std::mutex> lk(lock_);
+  Job& me = jobs_[tl_job];
+  ++me.waiting;
+  cv_.wait(lk, [&] { return !pool_busy_ && IsNext(tl_job); });
+  --me.waiting;
+  pool_busy_ = true;
+  running_job_ = tl_job;
+  slice_start_ = std::chrono::steady_clock::now();
+
+  const unsigned saved = getActiveThreads();
+  const unsigned allotment = Allotment(me, saved);
+  lk.unlock();
+
+  if (allotment != saved) {
+    setActiveThreads(allotment);
+  }
+  ++tl_depth;
+  return saved;
+}
+
+void
+katana::JobScheduler::ExitLoop(unsigned saved_threads) {
+  --tl_depth;
+  if (getActiveThreads() != saved_threads) {
+    setActiveThreads(saved_threads);
+  }
+
+  std::lock_guard<std::mutex> lg(lock_);
+  Job& me = jobs_[running_job_];
+  const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - slice_start_)
+                          .count();
+  me.vtime_ns += ns / me.weight;
+  pool_busy_ = false;
+  running_job_ = kNoJob;
+  cv_.notify_all();
+}
+
+katana::JobScheduler::ScopedBlocking::ScopedBlocking() {
+  KATANA_LOG_VASSERT(
+      tl_job != kNoJob, "ScopedBlocking on a thread with no job");
+  std::lock_guard<std::mutex> lg(JS->lock_);
+  JS->jobs_[tl_job].blocked = true;
+}
+
+katana::JobScheduler::ScopedBlocking::~ScopedBlocking() {
+  std::lock_guard<std::mutex> lg(JS->lock_);
+  Job& me = JS->jobs_[tl_job];
+  me.blocked = false;
+  // no credit for time spent blocked: rejoin at the trailing edge of the
+  // runnable jobs so a long I/O wait does not buy a burst afterwards
+  uint64_t vtime = 0;
+  bool any = false;
+  for (const Job& job : JS->jobs_) {
+    if (job.live && !job.blocked && &job != &me) {
+      vtime = any ? std::min(vtime, job.vtime_ns) : job.vtime_ns;
+      any = true;
+    }
+  }
+  if (any) {
+    me.vtime_ns = std::max(me.vtime_ns, vtime);
+  }
+}
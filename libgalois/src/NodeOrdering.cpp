@@ -0,0 +1,172 @@
+#include "katana/NodeOrdering.h"
+
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+/// Node IDs sorted by degree, ascending or descending, ties toward lower
+/// IDs; used to pick traversal seeds deterministically.
+template <bool kAscending>
+katana::NUMAArray<Node>
+NodesByDegree(const katana::GraphTopology& topo) {
+  katana::NUMAArray<Node> seeds;
+  seeds.allocateInterleaved(topo.num_nodes());
+  katana::ParallelSTL::iota(seeds.begin(), seeds.end(), Node{0});
+  katana::ParallelSTL::sort(seeds.begin(), seeds.end(), [&](Node a, Node b) {
+    size_t da = topo.degree(a);
+    size_t db = topo.degree(b);
+    if (da == db) {
+      return a < b;
+    }
+    return kAscending ? da < db : da > db;
+  });
+  return seeds;
+}
+
+}  // namespace
+
+katana::NUMAArray<Node>
+katana::ComputeRCMPermutation(const GraphTopology& topo) {
+  const size_t num_nodes = topo.num_nodes();
+
+  NUMAArray<Node> order;
+  order.allocateInterleaved(num_nodes);
+
+  // Each component starts from its minimum-degree unvisited node
+  NUMAArray<Node> seeds = NodesByDegree<true>(topo);
+
+  NUMAArray<uint8_t> visited;
+  visited.allocateInterleaved(num_nodes);
+  ParallelSTL::fill(visited.begin(), visited.end(), uint8_t{0});
+
+  // (parent's position in the order, degree, node): sorting a BFS level by
+  // this key gives every parent its children in increasing degree order in
+  // one parallel sort
+  using ChildKey = std::tuple<size_t, size_t, Node>;
+  std::vector<ChildKey> level;
+
+  size_t out = 0;
+  for (size_t s = 0; s < num_nodes; ++s) {
+    Node seed = seeds[s];
+    if (visited[seed]) {
+      continue;
+    }
+    visited[seed] = 1;
+    order[out] = seed;
+    ++out;
+
+    // the current frontier is the slice [level_begin, out) of the order
+    size_t level_begin = out - 1;
+    while (level_begin < out) {
+      size_t level_end = out;
+      level.clear();
+      for (size_t p = level_begin; p < level_end; ++p) {
+        Node src = order[p];
+        for (auto e : topo.edges(src)) {
+          Node dest = topo.edge_dest(e);
+          if (!visited[dest]) {
+            visited[dest] = 1;
+            level.emplace_back(p, topo.degree(dest), dest);
+          }
+        }
+      }
+      ParallelSTL::sort(level.begin(), level.end());
+      for (const ChildKey& child : level) {
+        order[out] = std::get<2>(child);
+        ++out;
+      }
+      level_begin = level_end;
+    }
+  }
+  KATANA_LOG_DEBUG_ASSERT(out == num_nodes);
+
+  // Cuthill-McKee order reversed; the reversal further shrinks the
+  // envelope without changing adjacent nodes' ID distance
+  NUMAArray<Node> perm;
+  perm.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { perm[i] = order[num_nodes - 1 - i]; },
+      katana::no_stats());
+  return perm;
+}
+
+katana::NUMAArray<Node>
+katana::ComputeGorderPermutation(const GraphTopology& topo, uint32_t window) {
+  KATANA_LOG_ASSERT(window > 0);
+  const size_t num_nodes = topo.num_nodes();
+
+  NUMAArray<Node> perm;
+  perm.allocateInterleaved(num_nodes);
+
+  // Hubs seed each component so the densest neighborhoods get packed first
+  NUMAArray<Node> seeds = NodesByDegree<false>(topo);
+
+  NUMAArray<int32_t> score;
+  score.allocateInterleaved(num_nodes);
+  ParallelSTL::fill(score.begin(), score.end(), int32_t{0});
+
+  NUMAArray<uint8_t> placed;
+  placed.allocateInterleaved(num_nodes);
+  ParallelSTL::fill(placed.begin(), placed.end(), uint8_t{0});
+
+  // Lazy max-heap: every score change pushes a fresh entry and pops skip
+  // entries whose score no longer matches, the standard trick for
+  // priority queues with frequent small updates
+  std::priority_queue<std::pair<int32_t, Node>> heap;
+
+  size_t seed_scan = 0;
+  for (size_t out = 0; out < num_nodes; ++out) {
+    Node v = 0;
+    bool found = false;
+    while (!heap.empty()) {
+      auto [top_score, top_node] = heap.top();
+      heap.pop();
+      if (placed[top_node] || top_score != score[top_node]) {
+        continue;
+      }
+      v = top_node;
+      found = true;
+      break;
+    }
+    if (!found) {
+      // nothing borders the window; start the next component at its hub
+      while (placed[seeds[seed_scan]]) {
+        ++seed_scan;
+      }
+      v = seeds[seed_scan];
+    }
+
+    placed[v] = 1;
+    perm[out] = v;
+
+    // the node sliding out of the window stops contributing priority
+    if (out >= window) {
+      Node expired = perm[out - window];
+      for (auto e : topo.edges(expired)) {
+        Node dest = topo.edge_dest(e);
+        if (!placed[dest]) {
+          --score[dest];
+          heap.emplace(score[dest], dest);
+        }
+      }
+    }
+    for (auto e : topo.edges(v)) {
+      Node dest = topo.edge_dest(e);
+      if (!placed[dest]) {
+        ++score[dest];
+        heap.emplace(score[dest], dest);
+      }
+    }
+  }
+  return perm;
+}
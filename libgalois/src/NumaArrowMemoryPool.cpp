@@ -0,0 +1,139 @@
+#include "katana/NumaArrowMemoryPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/PageAlloc.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+
+namespace {
+
+constexpr const char* kStatRegion = "NumaArrowPool";
+
+}  // namespace
+
+void
+katana::NumaArrowMemoryPool::ClassStats::Add(int64_t bytes) {
+  int64_t now =
+      current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64_t high = high_water.load(std::memory_order_relaxed);
+  while (now > high && !high_water.compare_exchange_weak(
+                           high, now, std::memory_order_relaxed)) {
+  }
+}
+
+katana::NumaArrowMemoryPool::NumaArrowMemoryPool()
+    : large_threshold_(allocSize()) {
+  std::string policy;
+  if (GetEnv("KATANA_ARROW_POOL_POLICY", &policy)) {
+    if (policy == "blocked") {
+      policy_ = Policy::kBlocked;
+    } else if (policy != "interleaved") {
+      KATANA_LOG_WARN(
+          "unknown KATANA_ARROW_POOL_POLICY \"{}\"; using interleaved",
+          policy);
+    }
+  }
+}
+
+katana::NumaArrowMemoryPool&
+katana::NumaArrowMemoryPool::Global() {
+  static NumaArrowMemoryPool pool;
+  return pool;
+}
+
+arrow::Status
+katana::NumaArrowMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (size < static_cast<int64_t>(large_threshold_)) {
+    arrow::Status res = arrow::default_memory_pool()->Allocate(size, out);
+    if (res.ok()) {
+      small_stats_.Add(size);
+    }
+    return res;
+  }
+
+  // Arrow calls this pool from arbitrary threads -- async property
+  // decode, parallel row-group reads, write-behind stores -- so the
+  // first-touch largeMalloc variants are off limits: their page-in runs
+  // ThreadPool::run, which must start from the master thread and asserts
+  // against reentry. The mbind variants set a kernel placement policy
+  // without touching a page, which is safe from any caller.
+  LAptr mem = policy_ == Policy::kBlocked
+                  ? largeMallocBlockedMbind(size, getActiveThreads())
+                  : largeMallocInterleavedMbind(size);
+  if (!mem) {
+    return arrow::Status::OutOfMemory(
+        "katana page allocator failed for ", size, " bytes");
+  }
+
+  *out = static_cast<uint8_t*>(mem.get());
+  {
+    std::lock_guard<SimpleLock> guard(large_allocs_lock_);
+    large_allocs_.emplace(mem.get(), std::move(mem));
+  }
+  large_stats_.Add(size);
+  return arrow::Status::OK();
+}
+
+arrow::Status
+katana::NumaArrowMemoryPool::Reallocate(
+    int64_t old_size, int64_t new_size, uint8_t** ptr) {
+  uint8_t* grown = nullptr;
+  arrow::Status res = Allocate(new_size, &grown);
+  if (!res.ok()) {
+    return res;
+  }
+  if (int64_t keep = std::min(old_size, new_size); keep > 0) {
+    memcpy(grown, *ptr, keep);
+  }
+  Free(*ptr, old_size);
+  *ptr = grown;
+  return arrow::Status::OK();
+}
+
+void
+katana::NumaArrowMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  {
+    std::lock_guard<SimpleLock> guard(large_allocs_lock_);
+    auto it = large_allocs_.find(buffer);
+    if (it != large_allocs_.end()) {
+      large_allocs_.erase(it);
+      large_stats_.Remove(size);
+      return;
+    }
+  }
+  arrow::default_memory_pool()->Free(buffer, size);
+  small_stats_.Remove(size);
+}
+
+int64_t
+katana::NumaArrowMemoryPool::bytes_allocated() const {
+  return large_stats_.current.load(std::memory_order_relaxed) +
+         small_stats_.current.load(std::memory_order_relaxed);
+}
+
+int64_t
+katana::NumaArrowMemoryPool::max_memory() const {
+  return large_stats_.high_water.load(std::memory_order_relaxed) +
+         small_stats_.high_water.load(std::memory_order_relaxed);
+}
+
+void
+katana::NumaArrowMemoryPool::ReportStats() const {
+  ReportStatSingle(
+      kStatRegion, "NumaBytesCurrent",
+      large_stats_.current.load(std::memory_order_relaxed));
+  ReportStatSingle(
+      kStatRegion, "NumaBytesHighWater",
+      large_stats_.high_water.load(std::memory_order_relaxed));
+  ReportStatSingle(
+      kStatRegion, "SmallBytesCurrent",
+      small_stats_.current.load(std::memory_order_relaxed));
+  ReportStatSingle(
+      kStatRegion, "SmallBytesHighWater",
+      small_stats_.high_water.load(std::memory_order_relaxed));
+}
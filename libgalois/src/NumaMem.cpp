@@ -21,6 +21,17 @@
 
 #include <cassert>
 
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "katana/Logging.h"
 #include "katana/PageAlloc.h"
 #include "katana/ThreadPool.h"
 #include "katana/gIO.h"
@@ -207,6 +218,87 @@ katana::largeMallocBlocked(size_t bytes, unsigned numThreads) {
   return LAptr{data, internal::largeFreer{bytes}};
 }
 
+#if defined(__linux__) && defined(SYS_mbind)
+/* Apply a memory policy to [ptr, ptr + len) so the kernel places each page
+ * when it first faults, wherever the faulting thread runs. Unlike pageIn,
+ * no page is touched here, so this is safe from any thread. */
+static bool
+bindRegion(
+    void* ptr, size_t len, int mode, const std::vector<unsigned long>& mask) {
+  constexpr size_t bitsPerWord = sizeof(unsigned long) * 8;
+  long ret =
+      syscall(SYS_mbind, ptr, len, mode, mask.data(), mask.size() * bitsPerWord, 0);
+  if (ret < 0) {
+    KATANA_WARN_ONCE(
+        "memory policy unavailable (mbind: {}); leaving pages to "
+        "first-touch placement",
+        strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+/* Set bit `node` in a nodemask sized for the kernel's mbind interface */
+static void
+setNodeBit(std::vector<unsigned long>& mask, unsigned node) {
+  constexpr size_t bitsPerWord = sizeof(unsigned long) * 8;
+  if (node / bitsPerWord >= mask.size()) {
+    mask.resize(node / bitsPerWord + 1, 0);
+  }
+  mask[node / bitsPerWord] |= 1UL << (node % bitsPerWord);
+}
+#endif
+
+LAptr
+katana::largeMallocInterleavedMbind(size_t bytes) {
+  bytes = roundup(bytes, allocSize());
+  LAptr data = largeMallocFloating(bytes);
+#if defined(__linux__) && defined(SYS_mbind)
+  auto& tp = GetThreadPool();
+  if (!data || tp.getMaxNumaNodes() <= 1) {
+    return data;
+  }
+  // interleave over every node the thread pool runs on
+  std::vector<unsigned long> mask(1, 0);
+  for (unsigned tid = 0; tid < tp.getMaxThreads(); ++tid) {
+    setNodeBit(mask, tp.getOsNumaNode(tid));
+  }
+  bindRegion(data.get(), bytes, MPOL_INTERLEAVE, mask);
+#endif
+  return data;
+}
+
+LAptr
+katana::largeMallocBlockedMbind(size_t bytes, unsigned numThreads) {
+  bytes = roundup(bytes, allocSize());
+  LAptr data = largeMallocFloating(bytes);
+#if defined(__linux__) && defined(SYS_mbind)
+  auto& tp = GetThreadPool();
+  if (!data || numThreads == 0 || tp.getMaxNumaNodes() <= 1) {
+    return data;
+  }
+  // same sectioned distribution as pageIn without finegrained, with chunk
+  // boundaries rounded to the allocation granularity. MPOL_PREFERRED
+  // rather than MPOL_BIND so a full node falls back instead of OOMing.
+  char* ptr = static_cast<char*>(data.get());
+  for (unsigned i = 0; i < numThreads; ++i) {
+    size_t begin = roundup(i * bytes / numThreads, allocSize());
+    size_t end = i + 1 == numThreads
+                     ? bytes
+                     : roundup((i + 1) * bytes / numThreads, allocSize());
+    if (begin >= end) {
+      continue;
+    }
+    std::vector<unsigned long> mask(1, 0);
+    setNodeBit(mask, tp.getOsNumaNode(i));
+    if (!bindRegion(ptr + begin, end - begin, MPOL_PREFERRED, mask)) {
+      break;
+    }
+  }
+#endif
+  return data;
+}
+
 /**
  * Allocates pages for some specified number of bytes, then does NUMA page
  * faulting based on a specified distribution of elements among threads.
@@ -237,6 +329,68 @@ katana::largeMallocSpecified(
 
   return LAptr{data, internal::largeFreer{bytes}};
 }
+/* Move the pages each thread will access under a blocked partition onto
+ * that thread's NUMA node. Unlike pageIn, this runs after the memory has
+ * already been faulted in, possibly on the wrong socket. */
+void
+katana::migratePagesBlocked(
+    [[maybe_unused]] const void* _ptr, [[maybe_unused]] size_t bytes,
+    [[maybe_unused]] unsigned numThreads) {
+#if defined(__linux__) && defined(SYS_move_pages)
+  if (!_ptr || bytes == 0 || numThreads == 0) {
+    return;
+  }
+  if (GetThreadPool().getMaxNumaNodes() <= 1) {
+    return;
+  }
+
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  // move_pages does not write through the pointers; it only relocates the
+  // physical pages behind them
+  char* ptr = const_cast<char*>(static_cast<const char*>(_ptr));
+
+  GetThreadPool().run(numThreads, [ptr, bytes, pageSize, numThreads]() {
+    auto myID = ThreadPool::getTID();
+    int myNode = static_cast<int>(ThreadPool::getOsNumaNode());
+
+    // same sectioned distribution as pageIn without finegrained (e.g.
+    // thread 0 gets first chunk, thread 1 gets next chunk, ...)
+    size_t begin = myID * bytes / numThreads;
+    size_t end = (myID + 1) * bytes / numThreads;
+
+    // a page straddling two chunks is moved by the thread owning its first
+    // byte, so start at the first page boundary at or after begin
+    size_t page = (begin + pageSize - 1) / pageSize;
+
+    constexpr size_t batchSize = 512;
+    std::array<void*, batchSize> pages;
+    std::array<int, batchSize> nodes;
+    std::array<int, batchSize> status;
+
+    while (page * pageSize < end) {
+      size_t count = 0;
+      for (; count < batchSize && page * pageSize < end; ++page, ++count) {
+        pages[count] = ptr + page * pageSize;
+        nodes[count] = myNode;
+      }
+      // per-page failures (e.g. shared file-backed pages) are reported in
+      // status and ignored; failure of the call itself means the kernel
+      // will not migrate for us at all
+      long ret = syscall(
+          SYS_move_pages, 0, count, pages.data(), nodes.data(), status.data(),
+          MPOL_MF_MOVE);
+      if (ret < 0) {
+        KATANA_WARN_ONCE(
+            "page migration unavailable (move_pages: {}); leaving pages "
+            "where they were first touched",
+            strerror(errno));
+        return;
+      }
+    }
+  });
+#endif
+}
+
 // Explicit template declarations since the template is defined in the .h
 // file
 template LAptr katana::largeMallocSpecified<std::vector<uint32_t>>(
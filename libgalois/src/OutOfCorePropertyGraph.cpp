@@ -0,0 +1,131 @@
+#include "katana/OutOfCorePropertyGraph.h"
+
+#include <algorithm>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "tsuba/CSRTopology.h"
+
+namespace {
+
+/// A slice that touches no nodes, edges, or properties; used to read the
+/// topology header and out-index prefix without loading the graph.
+tsuba::RDGSlice::SliceArg
+PrefixSliceArg(uint64_t topo_size) {
+  return tsuba::RDGSlice::SliceArg{
+      .node_range = {0, 0},
+      .edge_range = {0, 0},
+      .topo_off = 0,
+      .topo_size = topo_size,
+  };
+}
+
+}  // namespace
+
+katana::Result<std::unique_ptr<katana::OutOfCorePropertyGraph>>
+katana::OutOfCorePropertyGraph::Make(
+    const std::string& rdg_name, uint64_t target_edges_per_segment,
+    std::vector<std::string> node_properties,
+    std::vector<std::string> edge_properties) {
+  tsuba::RDGManifest manifest = KATANA_CHECKED(tsuba::FindManifest(rdg_name));
+  auto file = std::make_shared<tsuba::RDGFile>(
+      KATANA_CHECKED(tsuba::Open(std::move(manifest), tsuba::kReadOnly)));
+
+  // First pass: the fixed-size header tells us how many nodes and edges the
+  // out-index prefix covers.
+  tsuba::RDGSlice header_slice = KATANA_CHECKED(tsuba::RDGSlice::Make(
+      *file, PrefixSliceArg(sizeof(tsuba::CSRTopologyHeader)),
+      std::vector<std::string>{}, std::vector<std::string>{}));
+  tsuba::CSRTopologyHeader header =
+      *header_slice.topology_file_storage().ptr<tsuba::CSRTopologyHeader>();
+  if (header.version != 1) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented,
+        "out-of-core loading expects CSR topology version 1, got {}",
+        header.version);
+  }
+
+  std::unique_ptr<OutOfCorePropertyGraph> g(new OutOfCorePropertyGraph(
+      std::move(file), header.num_nodes, header.num_edges,
+      std::move(node_properties), std::move(edge_properties)));
+
+  // Second pass: map the out-index array and copy it into a resident NUMA
+  // array; it is the only part of the topology kept in memory.
+  uint64_t prefix_size = sizeof(tsuba::CSRTopologyHeader) +
+                         header.num_nodes * sizeof(Edge);
+  tsuba::RDGSlice prefix_slice = KATANA_CHECKED(tsuba::RDGSlice::Make(
+      *g->file_, PrefixSliceArg(prefix_size), std::vector<std::string>{},
+      std::vector<std::string>{}));
+  const Edge* out_indexes = prefix_slice.topology_file_storage().ptr<Edge>(
+      sizeof(tsuba::CSRTopologyHeader));
+
+  g->adj_indices_.allocateInterleaved(header.num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, header.num_nodes),
+      [&](uint64_t i) { g->adj_indices_[i] = out_indexes[i]; });
+
+  // Cut segments at node boundaries once they hold the target edge count. A
+  // single node with more than target_edges_per_segment edges gets a
+  // segment of its own.
+  Node node_begin = 0;
+  while (node_begin < header.num_nodes) {
+    Node node_end = node_begin;
+    Edge edge_begin = g->edge_begin(node_begin);
+    while (node_end < header.num_nodes &&
+           g->edge_end(node_end) - edge_begin < target_edges_per_segment) {
+      ++node_end;
+    }
+    if (node_end < header.num_nodes) {
+      ++node_end;
+    }
+    g->segments_.push_back(SegmentInfo{
+        node_begin, node_end, edge_begin, g->edge_begin(node_end)});
+    node_begin = node_end;
+  }
+
+  return std::unique_ptr<OutOfCorePropertyGraph>(std::move(g));
+}
+
+uint64_t
+katana::OutOfCorePropertyGraph::DestsFileOffset(Edge e) const {
+  return sizeof(tsuba::CSRTopologyHeader) + num_nodes_ * sizeof(Edge) +
+         e * sizeof(Node);
+}
+
+katana::Result<std::unique_ptr<katana::OutOfCorePropertyGraph::LoadedSegment>>
+katana::OutOfCorePropertyGraph::LoadSegment(size_t i) const {
+  const SegmentInfo& info = segments_.at(i);
+  uint64_t dests_off = DestsFileOffset(info.edge_begin);
+  tsuba::RDGSlice::SliceArg arg{
+      .node_range = {info.node_begin, info.node_end},
+      .edge_range = {info.edge_begin, info.edge_end},
+      .topo_off = dests_off,
+      .topo_size = (info.edge_end - info.edge_begin) * sizeof(Node),
+  };
+  tsuba::RDGSlice slice = KATANA_CHECKED(tsuba::RDGSlice::Make(
+      *file_, arg, node_properties_, edge_properties_));
+  return std::make_unique<LoadedSegment>(std::move(slice), info, dests_off);
+}
+
+void
+katana::OutOfCorePropertyGraph::Prefetch(size_t i) {
+  if (prefetch_.valid() && prefetch_id_ == i) {
+    return;
+  }
+  prefetch_id_ = i;
+  prefetch_ = std::async(
+      std::launch::async, [this, i]() { return LoadSegment(i); });
+}
+
+katana::Result<std::unique_ptr<katana::OutOfCorePropertyGraph::LoadedSegment>>
+katana::OutOfCorePropertyGraph::GetSegment(size_t i) {
+  if (prefetch_.valid()) {
+    if (prefetch_id_ == i) {
+      return prefetch_.get();
+    }
+    // drop a stale prefetch so its load does not race with ours
+    prefetch_.wait();
+    prefetch_ = {};
+  }
+  return LoadSegment(i);
+}
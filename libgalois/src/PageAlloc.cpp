@@ -19,9 +19,16 @@
 
 #include "katana/PageAlloc.h"
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "katana/Env.h"
 #include "katana/Logging.h"
+#include "katana/ProgressTracer.h"
 #include "katana/SimpleLock.h"
 
 #ifdef __linux__
@@ -31,9 +38,185 @@
 
 // figure this out dynamically
 const size_t hugePageSize = 2 * 1024 * 1024;
+[[maybe_unused]] const size_t giganticPageSize = size_t{1} << 30;
 // protect mmap, munmap since linux has issues
 static katana::SimpleLock allocLock;
 
+// achieved backing, in hugePageSize units, for the coverage report
+static std::atomic<size_t> numHugeTLB{0};
+static std::atomic<size_t> numTHPAdvised{0};
+static std::atomic<size_t> numNotHuge{0};
+
+size_t
+katana::numPagesHugeTLB() {
+  return numHugeTLB;
+}
+
+size_t
+katana::numPagesTHPAdvised() {
+  return numTHPAdvised;
+}
+
+size_t
+katana::numPagesNotHuge() {
+  return numNotHuge;
+}
+
+// budget accounting, in hugePageSize units
+static std::atomic<size_t> numInUse{0};
+static std::atomic<size_t> numHighWater{0};
+static katana::SimpleLock hookLock;
+
+enum class BudgetPolicy { kFail, kBackpressure };
+
+static std::vector<std::function<size_t()>>&
+pressureHooks() {
+  static std::vector<std::function<size_t()>> hooks;
+  return hooks;
+}
+
+static size_t
+budgetPages() {
+  static const size_t pages = [] {
+    int mb = 0;
+    katana::GetEnv("KATANA_MEMORY_BUDGET_MB", &mb);
+    if (mb < 0) {
+      KATANA_LOG_WARN("ignoring negative KATANA_MEMORY_BUDGET_MB");
+      mb = 0;
+    }
+    return (static_cast<size_t>(mb) << 20) / hugePageSize;
+  }();
+  return pages;
+}
+
+static BudgetPolicy
+budgetPolicy() {
+  static const BudgetPolicy policy = [] {
+    std::string kind = "fail";
+    katana::GetEnv("KATANA_MEMORY_BUDGET_POLICY", &kind);
+    if (kind == "backpressure") {
+      return BudgetPolicy::kBackpressure;
+    }
+    if (kind != "fail") {
+      KATANA_LOG_WARN(
+          "unknown KATANA_MEMORY_BUDGET_POLICY \"{}\"; using fail", kind);
+    }
+    return BudgetPolicy::kFail;
+  }();
+  return policy;
+}
+
+static size_t
+runPressureHooks() {
+  std::lock_guard<katana::SimpleLock> lg(hookLock);
+  size_t released = 0;
+  for (const auto& hook : pressureHooks()) {
+    released += hook();
+  }
+  return released;
+}
+
+static void
+logBudgetPressure(const char* message, unsigned num) {
+  katana::GetTracer().GetActiveSpan().Log(
+      message, {
+                   {"budget_mb", katana::allocBudgetBytes() >> 20},
+                   {"requested_mb",
+                    (static_cast<uint64_t>(num) * hugePageSize) >> 20},
+                   {"in_use_mb", katana::allocInUseBytes() >> 20},
+                   {"high_water_mb", katana::allocHighWaterBytes() >> 20},
+               });
+}
+
+// Block until num more pages fit under the budget; gives up once no other
+// thread has freed anything for the stall window.
+static bool
+waitForHeadroom(unsigned num) {
+  static const int stall_ms = [] {
+    int ms = 10000;
+    katana::GetEnv("KATANA_MEMORY_BUDGET_STALL_MS", &ms);
+    return ms;
+  }();
+  KATANA_WARN_ONCE(
+      "memory budget reached ({} MB); stalling allocation until pages are "
+      "freed",
+      katana::allocBudgetBytes() >> 20);
+  auto last_progress = std::chrono::steady_clock::now();
+  size_t last_in_use = numInUse;
+  unsigned spins = 0;
+  while (numInUse + num > budgetPages()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    size_t in_use = numInUse;
+    if (in_use < last_in_use) {
+      last_in_use = in_use;
+      last_progress = std::chrono::steady_clock::now();
+    } else if (
+        std::chrono::steady_clock::now() - last_progress >
+        std::chrono::milliseconds(stall_ms)) {
+      return false;
+    }
+    // retry the reclaimers now and then; frees may have refilled free lists
+    if (++spins % 128 == 0) {
+      runPressureHooks();
+    }
+  }
+  return true;
+}
+
+// Account num pages against the budget before mapping them. The check and
+// the increment are not one atomic step, so concurrent allocations can
+// overshoot by a few in-flight requests; the budget is a guard rail against
+// swap death, not an exact limit.
+static void
+chargePages(unsigned num) {
+  const size_t budget = budgetPages();
+  if (budget > 0 && numInUse + num > budget) {
+    // let registered reclaimers give memory back before enforcing
+    runPressureHooks();
+    if (numInUse + num > budget) {
+      bool fits = budgetPolicy() == BudgetPolicy::kBackpressure
+                      ? waitForHeadroom(num)
+                      : false;
+      if (!fits) {
+        logBudgetPressure("memory budget exceeded", num);
+        KATANA_LOG_FATAL(
+            "allocation of {} MB would exceed the {} MB memory budget "
+            "({} MB in use); raise KATANA_MEMORY_BUDGET_MB or shrink the "
+            "run",
+            (static_cast<uint64_t>(num) * hugePageSize) >> 20,
+            katana::allocBudgetBytes() >> 20,
+            katana::allocInUseBytes() >> 20);
+      }
+    }
+  }
+  size_t in_use = numInUse += num;
+  size_t high_water = numHighWater;
+  while (in_use > high_water &&
+         !numHighWater.compare_exchange_weak(high_water, in_use)) {
+  }
+}
+
+size_t
+katana::allocBudgetBytes() {
+  return budgetPages() * hugePageSize;
+}
+
+size_t
+katana::allocInUseBytes() {
+  return numInUse * hugePageSize;
+}
+
+size_t
+katana::allocHighWaterBytes() {
+  return numHighWater * hugePageSize;
+}
+
+void
+katana::addMemoryPressureHook(std::function<size_t()> hook) {
+  std::lock_guard<SimpleLock> lg(hookLock);
+  pressureHooks().emplace_back(std::move(hook));
+}
+
 // mmap flags
 #if defined(MAP_ANONYMOUS)
 static const int _MAP_ANON = MAP_ANONYMOUS;
@@ -72,11 +255,14 @@ katana::allocPages(unsigned num, [[maybe_unused]] bool preFault) {
     return nullptr;
   }
   KATANA_DEBUG_WARN_ONCE("not using huge pages due to jemalloc");
+  chargePages(num);
+  numNotHuge += num;
   return malloc(num * hugePageSize);
 }
 
 void
-katana::freePages(void* ptr, [[maybe_unused]] unsigned num) {
+katana::freePages(void* ptr, unsigned num) {
+  numInUse -= num;
   free(ptr);
 }
 
@@ -99,11 +285,44 @@ katana::allocPages(unsigned num, bool preFault) {
     return nullptr;
   }
 
-  void* ptr = trymmap(num * hugePageSize, preFault ? _MAP_HUGE_POP : _MAP_HUGE);
+  chargePages(num);
+
+  size_t size = num * hugePageSize;
+  void* ptr = nullptr;
+
+#ifdef MAP_HUGETLB
+#ifdef MAP_HUGE_1GB
+  // 1GB pages cut the page walk another level, but hugetlb mappings must be
+  // a multiple of the page size, so only try them when the size allows.
+  if (size >= giganticPageSize && size % giganticPageSize == 0) {
+    ptr = trymmap(
+        size, (preFault ? _MAP_HUGE_POP : _MAP_HUGE) | MAP_HUGE_1GB);
+  }
+#endif
   if (!ptr) {
+    ptr = trymmap(size, preFault ? _MAP_HUGE_POP : _MAP_HUGE);
+  }
+#endif
+
+  if (ptr) {
+    numHugeTLB += num;
+  } else {
+    // No explicit huge pages available; take regular pages but ask the
+    // kernel to collapse them into transparent huge pages.
     KATANA_DEBUG_WARN_ONCE(
-        "huge page alloc failed, falling back to regular pages");
-    ptr = trymmap(num * hugePageSize, preFault ? _MAP_POP : _MAP);
+        "huge page alloc failed, falling back to transparent huge pages");
+    ptr = trymmap(size, preFault ? _MAP_POP : _MAP);
+#ifdef MADV_HUGEPAGE
+    if (ptr && madvise(ptr, size, MADV_HUGEPAGE) == 0) {
+      numTHPAdvised += num;
+    } else if (ptr) {
+      numNotHuge += num;
+    }
+#else
+    if (ptr) {
+      numNotHuge += num;
+    }
+#endif
   }
 
   if (!ptr) {
@@ -121,6 +340,7 @@ katana::allocPages(unsigned num, bool preFault) {
 
 void
 katana::freePages(void* ptr, unsigned num) {
+  numInUse -= num;
   std::lock_guard<SimpleLock> lg(allocLock);
   if (munmap(ptr, num * hugePageSize) != 0) {
     KATANA_LOG_FATAL("munmap failed: {}", errno);
@@ -19,6 +19,8 @@
 
 #include "katana/PagePool.h"
 
+#include <mutex>
+
 #include "katana/Logging.h"
 
 static katana::internal::PageAllocState<>* PA;
@@ -27,6 +29,15 @@ void
 katana::internal::setPagePoolState(PageAllocState<>* pa) {
   KATANA_LOG_VASSERT(!(PA && pa), "double Initialization of PageAllocState");
   PA = pa;
+  if (pa) {
+    // free-list pages count against the memory budget; register a reclaimer
+    // once so budget pressure can empty the lists before an allocation fails
+    static std::once_flag once;
+    std::call_once(once, [] {
+      addMemoryPressureHook(
+          []() -> size_t { return PA ? PA->releaseFreePages() : 0; });
+    });
+  }
 }
 
 int
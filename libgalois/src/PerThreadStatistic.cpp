@@ -0,0 +1,17 @@
+#include "katana/PerThreadStatistic.h"
+
+#include "katana/Executor_OnEach.h"
+
+template <typename T>
+void
+katana::internal::PerThreadStatBuffers<T>::report(
+    const char* region, const char* category, const StatTotal::Type& type) {
+  on_each_gen(
+      [&](auto, auto) {
+        ReportStat(region, category, *values_.getLocal(), type);
+      },
+      std::make_tuple());
+}
+
+template class katana::internal::PerThreadStatBuffers<int64_t>;
+template class katana::internal::PerThreadStatBuffers<double>;
@@ -43,9 +43,10 @@ katana::getPPSBackend() {
 
 const size_t ptAllocSize = katana::allocSize();
 inline void*
-alloc() {
-  // alloc a single page, don't prefault
-  void* toReturn = katana::allocPages(1, true);
+alloc(unsigned num) {
+  // Reserve address space only; pages are committed on first touch so
+  // slots of idle threads do not contribute to RSS.
+  void* toReturn = katana::allocPages(num, false);
   if (toReturn == nullptr) {
     KATANA_DIE("per-thread storage out of memory");
   }
@@ -73,6 +74,11 @@ katana::PerBackend::nextLog2(unsigned size) {
   return i;
 }
 
+unsigned
+katana::PerBackend::roundedAllocSize(const unsigned size) {
+  return 1U << nextLog2(size);
+}
+
 unsigned
 katana::PerBackend::allocOffset(const unsigned sz) {
   unsigned ll = nextLog2(sz);
@@ -168,8 +174,48 @@ katana::PerBackend::initCommon(unsigned maxT) {
 char*
 katana::PerBackend::initPerThread(unsigned maxT) {
   initCommon(maxT);
-  char* b = heads[ThreadPool::getTID()] = (char*)alloc();
+
+  const HWTopoInfo topo = getHWTopo();
+  const unsigned tid = ThreadPool::getTID();
+  const ThreadTopoInfo& self = topo.threadTopoInfo[tid];
+
+  if (!socketPools) {
+    // as in initCommon, thread 0 runs before any other thread
+    KATANA_LOG_DEBUG_ASSERT(tid == 0);
+    socketPools = new std::atomic<char*>[topo.machineTopoInfo.maxSockets] {};
+  }
+
+  unsigned threads_in_socket = 0;
+  unsigned index_in_socket = 0;
+  for (const ThreadTopoInfo& t : topo.threadTopoInfo) {
+    if (t.socketLeader == self.socketLeader) {
+      ++threads_in_socket;
+      if (t.tid < tid) {
+        ++index_in_socket;
+      }
+    }
+  }
+
+  // The socket leader maps one pool for the whole socket; the other
+  // threads carve their regions out of it. First touch commits each
+  // thread's pages on its own NUMA node.
+  std::atomic<char*>& pool = socketPools[self.socket];
+  char* base;
+  if (tid == self.socketLeader) {
+    base = (char*)alloc(threads_in_socket);
+    pool.store(base);
+  } else {
+    // wait for the leader to map the socket's pool
+    while (!(base = pool.load())) {
+      asmPause();
+    }
+  }
+
+  char* b = heads[tid] = base + index_in_socket * ptAllocSize;
+#ifdef KATANA_USE_JEMALLOC
+  // malloc-backed storage is not zero-filled like freshly mapped pages
   memset(b, 0, ptAllocSize);
+#endif
   return b;
 }
 
@@ -179,8 +225,10 @@ katana::PerBackend::initPerSocket(unsigned maxT) {
   unsigned id = ThreadPool::getTID();
   unsigned leader = ThreadPool::getLeader();
   if (id == leader) {
-    char* b = heads[id] = (char*)alloc();
+    char* b = heads[id] = (char*)alloc(1);
+#ifdef KATANA_USE_JEMALLOC
     memset(b, 0, ptAllocSize);
+#endif
     return b;
   }
   char* expected = nullptr;
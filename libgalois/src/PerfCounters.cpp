@@ -0,0 +1,149 @@
+#include "katana/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <mutex>
+
+#include "katana/Env.h"
+#include "katana/Executor_OnEach.h"
+#include "katana/Logging.h"
+#include "katana/Statistics.h"
+
+#ifdef __linux__
+
+namespace {
+
+int
+OpenCounter(uint32_t type, uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  // the leader starts disabled and is enabled explicitly; followers
+  // inherit the leader's enable state
+  attr.disabled = (group_fd == -1) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+uint64_t
+ReadCounter(int fd) {
+  uint64_t value = 0;
+  if (fd != -1 && read(fd, &value, sizeof(value)) != sizeof(value)) {
+    value = 0;
+  }
+  return value;
+}
+
+}  // namespace
+
+bool
+katana::PerfCounterGroup::CollectionRequested() {
+  static bool requested = katana::GetEnv("KATANA_PERF_COUNTERS");
+  return requested;
+}
+
+bool
+katana::PerfCounterGroup::Open() {
+  group_fd_ = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1);
+  if (group_fd_ == -1) {
+    open_failed_ = true;
+    static std::once_flag warned;
+    std::call_once(warned, []() {
+      KATANA_LOG_WARN(
+          "KATANA_PERF_COUNTERS is set but perf_event_open failed; check "
+          "kernel.perf_event_paranoid");
+    });
+    return false;
+  }
+  // Followers that the PMU cannot provide (stalled cycles is commonly
+  // unimplemented) stay at -1 and report as 0.
+  llc_fd_ =
+      OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, group_fd_);
+  stall_fd_ = OpenCounter(
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND, group_fd_);
+  return true;
+}
+
+katana::PerfCounterGroup::~PerfCounterGroup() {
+  for (int fd : {stall_fd_, llc_fd_, group_fd_}) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+void
+katana::PerfCounterGroup::start() {
+  if (!CollectionRequested() || open_failed_) {
+    return;
+  }
+  if (group_fd_ == -1 && !Open()) {
+    return;
+  }
+  ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void
+katana::PerfCounterGroup::stop() {
+  if (group_fd_ == -1) {
+    return;
+  }
+  ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  counts_.instructions += ReadCounter(group_fd_);
+  counts_.llc_misses += ReadCounter(llc_fd_);
+  counts_.stalled_cycles += ReadCounter(stall_fd_);
+}
+
+#else
+
+bool
+katana::PerfCounterGroup::CollectionRequested() {
+  return false;
+}
+
+bool
+katana::PerfCounterGroup::Open() {
+  open_failed_ = true;
+  return false;
+}
+
+katana::PerfCounterGroup::~PerfCounterGroup() = default;
+
+void
+katana::PerfCounterGroup::start() {}
+
+void
+katana::PerfCounterGroup::stop() {}
+
+#endif
+
+void
+katana::PerfCounterGroup::report(const char* region) const {
+  if (!CollectionRequested()) {
+    return;
+  }
+  ReportStatSum(region, "Instructions", counts_.instructions);
+  ReportStatSum(region, "LLCMisses", counts_.llc_misses);
+  ReportStatSum(region, "StalledCycles", counts_.stalled_cycles);
+}
+
+void
+katana::ThreadPerfCounters::reportCounts(const char* region) {
+  if (!PerfCounterGroup::CollectionRequested()) {
+    return;
+  }
+  on_each_gen(
+      [&](auto, auto) { groups_.getLocal()->report(region); },
+      std::make_tuple());
+}
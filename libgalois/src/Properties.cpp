@@ -9,4 +9,33 @@ BooleanPropertyReadOnlyView::Make(const arrow::BooleanArray& array) {
   return BooleanPropertyReadOnlyView(array);
 }
 
+Result<StringDictPropertyReadOnlyView>
+StringDictPropertyReadOnlyView::Make(const arrow::DictionaryArray& array) {
+  auto dict =
+      std::dynamic_pointer_cast<arrow::StringArray>(array.dictionary());
+  if (!dict) {
+    return KATANA_ERROR(
+        ErrorCode::TypeError, "dictionary does not hold strings: {}",
+        array.dictionary()->type()->ToString());
+  }
+  auto codes = std::dynamic_pointer_cast<arrow::Int32Array>(array.indices());
+  if (!codes) {
+    return KATANA_ERROR(
+        ErrorCode::TypeError, "dictionary codes are not int32: {}",
+        array.indices()->type()->ToString());
+  }
+  return StringDictPropertyReadOnlyView(std::move(codes), std::move(dict));
+}
+
+int32_t
+StringDictPropertyReadOnlyView::FindCode(std::string_view value) const {
+  arrow::util::string_view needle(value.data(), value.size());
+  for (int64_t i = 0, n = dict_->length(); i < n; ++i) {
+    if (dict_->GetView(i) == needle) {
+      return static_cast<int32_t>(i);
+    }
+  }
+  return kInvalidCode;
+}
+
 }  // namespace katana
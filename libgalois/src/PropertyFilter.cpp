@@ -0,0 +1,393 @@
+#include "katana/PropertyFilter.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <arrow/array.h>
+#include <arrow/table.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+
+namespace {
+
+using katana::DynamicBitset;
+using katana::PredicateOp;
+
+constexpr uint32_t kBitsPerWord = DynamicBitset::kNumBitsInUint64;
+
+// Half-open range [Lower, Upper) of values of integer type T that are
+// exactly representable as doubles used for range checks. Both bounds are
+// powers of two, so the doubles themselves are exact even for 64-bit types
+// whose extreme values are not.
+template <typename T>
+constexpr double
+TypeLowerBound() {
+  if constexpr (std::is_signed_v<T>) {
+    return static_cast<double>(std::numeric_limits<T>::min());
+  } else {
+    return 0.0;
+  }
+}
+
+template <typename T>
+constexpr double
+TypeUpperBound() {
+  if constexpr (std::is_signed_v<T>) {
+    return -static_cast<double>(std::numeric_limits<T>::min());
+  } else {
+    // For uint64_t max() rounds up to 2^64 and adding one is a no-op; for
+    // narrower types the sum is computed exactly.
+    return static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+  }
+}
+
+enum class FoldedKind {
+  kAllRows,  // every non-null row matches
+  kNoRows,   // no row can match
+  kCompare,  // compare against threshold with op
+};
+
+// Result of folding a predicate's double constant into integer type T:
+// either the predicate is decided for every row, or it reduces to an exact
+// comparison against a native threshold. op is one of kEqual, kNotEqual,
+// kLessEqual or kGreaterEqual; strict inequalities are absorbed into the
+// threshold.
+template <typename T>
+struct FoldedPredicate {
+  FoldedKind kind;
+  PredicateOp op;
+  T threshold;
+};
+
+template <typename T>
+FoldedPredicate<T>
+FoldIntegerPredicate(PredicateOp op, double value) {
+  constexpr double kLower = TypeLowerBound<T>();
+  constexpr double kUpper = TypeUpperBound<T>();
+  const auto all = FoldedPredicate<T>{FoldedKind::kAllRows, op, T{}};
+  const auto none = FoldedPredicate<T>{FoldedKind::kNoRows, op, T{}};
+
+  if (std::isnan(value)) {
+    return op == PredicateOp::kNotEqual ? all : none;
+  }
+
+  switch (op) {
+  case PredicateOp::kEqual:
+  case PredicateOp::kNotEqual: {
+    bool representable =
+        std::floor(value) == value && value >= kLower && value < kUpper;
+    if (!representable) {
+      return op == PredicateOp::kEqual ? none : all;
+    }
+    return {FoldedKind::kCompare, op, static_cast<T>(value)};
+  }
+  case PredicateOp::kLessThan:
+  case PredicateOp::kLessEqual: {
+    if (op == PredicateOp::kLessThan && std::floor(value) == value) {
+      // x < v over integers is x <= v - 1. Step down in the integer domain
+      // because v - 1 is not exact in double once v exceeds 2^53.
+      if (value <= kLower) {
+        return none;
+      }
+      if (value >= kUpper) {
+        return all;
+      }
+      return {
+          FoldedKind::kCompare, PredicateOp::kLessEqual,
+          static_cast<T>(static_cast<T>(value) - 1)};
+    }
+    double bound = std::floor(value);
+    if (bound < kLower) {
+      return none;
+    }
+    if (bound >= kUpper) {
+      return all;
+    }
+    return {FoldedKind::kCompare, PredicateOp::kLessEqual,
+            static_cast<T>(bound)};
+  }
+  case PredicateOp::kGreaterThan:
+  case PredicateOp::kGreaterEqual: {
+    if (op == PredicateOp::kGreaterThan && std::floor(value) == value) {
+      if (value < kLower) {
+        return all;
+      }
+      if (value >= kUpper) {
+        return none;
+      }
+      T t = static_cast<T>(value);
+      if (t == std::numeric_limits<T>::max()) {
+        return none;
+      }
+      return {
+          FoldedKind::kCompare, PredicateOp::kGreaterEqual,
+          static_cast<T>(t + 1)};
+    }
+    double bound = std::ceil(value);
+    if (bound <= kLower) {
+      return all;
+    }
+    if (bound >= kUpper) {
+      return none;
+    }
+    return {FoldedKind::kCompare, PredicateOp::kGreaterEqual,
+            static_cast<T>(bound)};
+  }
+  }
+  KATANA_LOG_FATAL("unknown predicate op {}", static_cast<int>(op));
+}
+
+// Evaluates cmp over every row, packing results 64 rows to a word so the
+// compare auto-vectorizes, masking nulls a word at a time and combining
+// into the selection under conjunction. Arrow packs validity bitmaps
+// LSB-first, matching the bitset's word layout on little-endian targets.
+template <typename T, typename Compare>
+void
+EvaluateWords(
+    const T* values, const uint8_t* validity, size_t num_rows, bool first,
+    Compare cmp, DynamicBitset* selected) {
+  auto& words = selected->get_vec();
+  size_t num_words = (num_rows + kBitsPerWord - 1) / kBitsPerWord;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_words),
+      [&](size_t w) {
+        size_t base = w * kBitsPerWord;
+        size_t limit = std::min(base + kBitsPerWord, num_rows);
+        uint64_t word = 0;
+        for (size_t i = base; i < limit; ++i) {
+          word |= uint64_t{cmp(values[i])} << (i - base);
+        }
+        if (validity != nullptr) {
+          uint64_t valid = 0;
+          memcpy(
+              &valid, validity + w * sizeof(uint64_t),
+              (limit - base + CHAR_BIT - 1) / CHAR_BIT);
+          word &= valid;
+        }
+        if (first) {
+          words[w] = word;
+        } else {
+          words[w] &= word;
+        }
+      },
+      katana::no_stats());
+}
+
+template <typename T>
+void
+EvaluateIntegerArray(
+    const arrow::Array& array, PredicateOp op, double value, bool first,
+    DynamicBitset* selected) {
+  FoldedPredicate<T> folded = FoldIntegerPredicate<T>(op, value);
+  if (folded.kind == FoldedKind::kNoRows) {
+    // Conjunction with an unsatisfiable predicate empties the selection.
+    selected->reset();
+    return;
+  }
+  const T* values = array.data()->GetValues<T>(1);
+  const uint8_t* validity =
+      array.null_count() > 0 ? array.null_bitmap_data() : nullptr;
+  size_t num_rows = array.length();
+  if (folded.kind == FoldedKind::kAllRows) {
+    // Every non-null row matches; a pass is still needed to mask nulls
+    // and combine with the predicates evaluated so far.
+    EvaluateWords(
+        values, validity, num_rows, first, [](T) { return true; }, selected);
+    return;
+  }
+  T t = folded.threshold;
+  switch (folded.op) {
+  case PredicateOp::kEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [t](T x) { return x == t; },
+        selected);
+    break;
+  case PredicateOp::kNotEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [t](T x) { return x != t; },
+        selected);
+    break;
+  case PredicateOp::kLessEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [t](T x) { return x <= t; },
+        selected);
+    break;
+  case PredicateOp::kGreaterEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [t](T x) { return x >= t; },
+        selected);
+    break;
+  default:
+    KATANA_LOG_FATAL("folded predicate has a strict op");
+  }
+}
+
+template <typename T>
+void
+EvaluateFloatingArray(
+    const arrow::Array& array, PredicateOp op, double value, bool first,
+    DynamicBitset* selected) {
+  const T* values = array.data()->GetValues<T>(1);
+  const uint8_t* validity =
+      array.null_count() > 0 ? array.null_bitmap_data() : nullptr;
+  size_t num_rows = array.length();
+  // Compare in double: float widens exactly, and NaN rows fail ordered
+  // comparisons (and match kNotEqual) per IEEE semantics.
+  switch (op) {
+  case PredicateOp::kEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [value](T x) { return x == value; },
+        selected);
+    break;
+  case PredicateOp::kNotEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [value](T x) { return x != value; },
+        selected);
+    break;
+  case PredicateOp::kLessThan:
+    EvaluateWords(
+        values, validity, num_rows, first, [value](T x) { return x < value; },
+        selected);
+    break;
+  case PredicateOp::kLessEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [value](T x) { return x <= value; },
+        selected);
+    break;
+  case PredicateOp::kGreaterThan:
+    EvaluateWords(
+        values, validity, num_rows, first, [value](T x) { return x > value; },
+        selected);
+    break;
+  case PredicateOp::kGreaterEqual:
+    EvaluateWords(
+        values, validity, num_rows, first, [value](T x) { return x >= value; },
+        selected);
+    break;
+  }
+}
+
+katana::Result<void>
+EvaluateArray(
+    const arrow::Array& array, const katana::PropertyPredicate& predicate,
+    bool first, DynamicBitset* selected) {
+  switch (array.type_id()) {
+  case arrow::Type::INT8:
+    EvaluateIntegerArray<int8_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::UINT8:
+    EvaluateIntegerArray<uint8_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::INT16:
+    EvaluateIntegerArray<int16_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::UINT16:
+    EvaluateIntegerArray<uint16_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::INT32:
+    EvaluateIntegerArray<int32_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::UINT32:
+    EvaluateIntegerArray<uint32_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::INT64:
+    EvaluateIntegerArray<int64_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::UINT64:
+    EvaluateIntegerArray<uint64_t>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::FLOAT:
+    EvaluateFloatingArray<float>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  case arrow::Type::DOUBLE:
+    EvaluateFloatingArray<double>(
+        array, predicate.op, predicate.value, first, selected);
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "property {} has type {} which predicates cannot evaluate",
+        std::quoted(predicate.property_name), array.type()->ToString());
+  }
+  return katana::ResultSuccess();
+}
+
+template <typename GetColumn>
+katana::Result<DynamicBitset>
+EvaluatePredicates(
+    size_t num_rows, const std::vector<katana::PropertyPredicate>& predicates,
+    GetColumn&& get_column) {
+  DynamicBitset selected;
+  selected.resize(num_rows);
+  if (predicates.empty()) {
+    // An empty conjunction selects everything; keep the bits past num_rows
+    // in the last word clear so counts and offset extraction stay exact.
+    auto& words = selected.get_vec();
+    std::fill(words.begin(), words.end(), ~uint64_t{0});
+    if (size_t tail = num_rows % kBitsPerWord; tail != 0 && !words.empty()) {
+      words[words.size() - 1] = ~uint64_t{0} >> (kBitsPerWord - tail);
+    }
+    return katana::Result<DynamicBitset>(std::move(selected));
+  }
+
+  bool first = true;
+  for (const katana::PropertyPredicate& predicate : predicates) {
+    std::shared_ptr<arrow::ChunkedArray> column =
+        KATANA_CHECKED(get_column(predicate.property_name));
+    if (column->num_chunks() != 1) {
+      // Katana form graphs only contain single chunk property columns.
+      return KATANA_ERROR(
+          katana::ErrorCode::NotImplemented, "property is in the wrong format");
+    }
+    const arrow::Array& array = *column->chunk(0);
+    if (array.offset() != 0) {
+      // A sliced array's validity bits are not word aligned.
+      return KATANA_ERROR(
+          katana::ErrorCode::NotImplemented,
+          "property {} has a non-zero array offset",
+          std::quoted(predicate.property_name));
+    }
+    if (static_cast<size_t>(array.length()) != num_rows) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "property {} does not cover all entities",
+          std::quoted(predicate.property_name));
+    }
+    KATANA_CHECKED(EvaluateArray(array, predicate, first, &selected));
+    first = false;
+  }
+  return katana::Result<DynamicBitset>(std::move(selected));
+}
+
+}  // namespace
+
+katana::Result<katana::DynamicBitset>
+katana::EvaluateNodePredicates(
+    const PropertyGraph* pg, const std::vector<PropertyPredicate>& predicates) {
+  return EvaluatePredicates(
+      pg->num_nodes(), predicates,
+      [&](const std::string& name) { return pg->GetNodeProperty(name); });
+}
+
+katana::Result<katana::DynamicBitset>
+katana::EvaluateEdgePredicates(
+    const PropertyGraph* pg, const std::vector<PropertyPredicate>& predicates) {
+  return EvaluatePredicates(
+      pg->num_edges(), predicates,
+      [&](const std::string& name) { return pg->GetEdgeProperty(name); });
+}
@@ -0,0 +1,191 @@
+#include "katana/PropertyGraphEdgeInserter.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <arrow/api.h>
+#include <arrow/compute/api_vector.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+
+template <typename T>
+using Result = katana::Result<T>;
+
+namespace {
+
+using Node = katana::PropertyGraphEdgeInserter::Node;
+using Edge = katana::PropertyGraphEdgeInserter::Edge;
+
+// Marks an inserted edge with no property row in the source graph
+constexpr uint64_t kNoSourceRow = std::numeric_limits<uint64_t>::max();
+
+/// Build an index array from source row IDs, with a null for every edge
+/// marked kNoSourceRow; Take then yields null property rows for those edges
+Result<std::shared_ptr<arrow::Array>>
+MakeNullableIndexArray(const katana::NUMAArray<uint64_t>& source_rows) {
+  arrow::Int64Builder builder;
+  if (auto r = builder.Reserve(source_rows.size()); !r.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "building index array: {}",
+        r.ToString());
+  }
+  for (uint64_t row : source_rows) {
+    if (row == kNoSourceRow) {
+      builder.UnsafeAppendNull();
+    } else {
+      builder.UnsafeAppend(static_cast<int64_t>(row));
+    }
+  }
+  std::shared_ptr<arrow::Array> indices;
+  if (auto r = builder.Finish(&indices); !r.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "building index array: {}",
+        r.ToString());
+  }
+  return indices;
+}
+
+}  // namespace
+
+Result<void>
+katana::PropertyGraphEdgeInserter::Flush() {
+  // Concatenate the per-thread buffers into one array
+  uint64_t total = 0;
+  std::vector<uint64_t> offsets(staged_.size());
+  for (unsigned t = 0; t < staged_.size(); ++t) {
+    offsets[t] = total;
+    total += staged_.getRemote(t)->size();
+  }
+  if (total == 0) {
+    return ResultSuccess();
+  }
+
+  NUMAArray<std::pair<Node, Node>> all;
+  all.allocateInterleaved(total);
+  katana::do_all(katana::iterate(unsigned{0}, staged_.size()), [&](unsigned t) {
+    std::vector<std::pair<Node, Node>>& buf = *staged_.getRemote(t);
+    std::copy(buf.begin(), buf.end(), all.begin() + offsets[t]);
+    buf.clear();
+  });
+
+  // Group by source so each node's overlay list is appended to by exactly
+  // one loop iteration
+  katana::ParallelSTL::sort(
+      all.begin(), all.end(),
+      [](const std::pair<Node, Node>& a, const std::pair<Node, Node>& b) {
+        return a.first < b.first;
+      });
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, total),
+      [&](uint64_t i) {
+        if (i > 0 && all[i].first == all[i - 1].first) {
+          return;
+        }
+        Node src = all[i].first;
+        std::vector<Node>& list = overlay_[src];
+        for (uint64_t j = i; j < total && all[j].first == src; ++j) {
+          list.push_back(all[j].second);
+        }
+      },
+      katana::steal());
+
+  num_overlay_edges_ += total;
+  return ResultSuccess();
+}
+
+Result<std::unique_ptr<katana::PropertyGraph>>
+katana::PropertyGraphEdgeInserter::Compact() {
+  const GraphTopology& topo = pg_->topology();
+  uint64_t num_nodes = topo.num_nodes();
+  uint64_t num_edges = topo.num_edges() + num_overlay_edges_;
+
+  NUMAArray<Edge> new_adj_indices;
+  new_adj_indices.allocateInterleaved(num_nodes);
+  katana::do_all(katana::iterate(topo.all_nodes()), [&](Node node) {
+    new_adj_indices[node] = degree(node);
+  });
+  katana::ParallelSTL::partial_sum(
+      new_adj_indices.begin(), new_adj_indices.end(), new_adj_indices.begin());
+
+  NUMAArray<Node> new_dests;
+  new_dests.allocateInterleaved(num_edges);
+  NUMAArray<uint64_t> source_rows;
+  source_rows.allocateInterleaved(num_edges);
+
+  PropertyGraph::EntityTypeIDArray node_types;
+  node_types.allocateInterleaved(num_nodes);
+  PropertyGraph::EntityTypeIDArray edge_types;
+  edge_types.allocateInterleaved(num_edges);
+
+  katana::do_all(
+      katana::iterate(topo.all_nodes()),
+      [&](Node node) {
+        node_types[node] = pg_->GetTypeOfNode(node);
+        Edge out = node == 0 ? Edge{0} : new_adj_indices[node - 1];
+        for (Edge e : topo.edges(node)) {
+          new_dests[out] = topo.edge_dest(e);
+          source_rows[out] = e;
+          edge_types[out] = pg_->GetTypeOfEdge(e);
+          ++out;
+        }
+        for (Node dest : overlay_[node]) {
+          new_dests[out] = dest;
+          source_rows[out] = kNoSourceRow;
+          edge_types[out] = kUnknownEntityType;
+          ++out;
+        }
+      },
+      katana::steal());
+
+  GraphTopology new_topo{std::move(new_adj_indices), std::move(new_dests)};
+  std::unique_ptr<PropertyGraph> new_pg = KATANA_CHECKED(PropertyGraph::Make(
+      std::move(new_topo), std::move(node_types), std::move(edge_types),
+      EntityTypeManager(pg_->GetNodeTypeManager()),
+      EntityTypeManager(pg_->GetEdgeTypeManager())));
+
+  // Node IDs are unchanged, so node property columns are shared as-is
+  if (pg_->GetNumNodeProperties() > 0) {
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    for (int32_t i = 0; i < pg_->GetNumNodeProperties(); ++i) {
+      columns.emplace_back(pg_->GetNodeProperty(i));
+    }
+    KATANA_CHECKED(new_pg->AddNodeProperties(
+        arrow::Table::Make(pg_->loaded_node_schema(), columns)));
+  }
+
+  // Edge property rows follow their edges to their new IDs; inserted edges
+  // take null rows. One Take per column, run in parallel across columns.
+  if (pg_->GetNumEdgeProperties() > 0) {
+    std::shared_ptr<arrow::Array> indices =
+        KATANA_CHECKED(MakeNullableIndexArray(source_rows));
+    int32_t num_fields = pg_->GetNumEdgeProperties();
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(num_fields);
+    std::vector<Result<void>> results(num_fields, ResultSuccess());
+    katana::do_all(katana::iterate(int32_t{0}, num_fields), [&](int32_t i) {
+      auto taken = arrow::compute::Take(pg_->GetEdgeProperty(i), indices);
+      if (!taken.ok()) {
+        results[i] = KATANA_ERROR(
+            katana::ErrorCode::ArrowError, "gathering edge property {}: {}",
+            pg_->GetEdgePropertyName(i), taken.status().ToString());
+        return;
+      }
+      columns[i] = taken.ValueOrDie().chunked_array();
+    });
+    for (Result<void>& r : results) {
+      if (!r) {
+        return r.error();
+      }
+    }
+    KATANA_CHECKED(new_pg->AddEdgeProperties(
+        arrow::Table::Make(pg_->loaded_edge_schema(), columns)));
+  }
+
+  overlay_.assign(num_nodes, {});
+  num_overlay_edges_ = 0;
+
+  return std::unique_ptr<PropertyGraph>(std::move(new_pg));
+}
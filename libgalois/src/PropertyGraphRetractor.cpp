@@ -16,5 +16,29 @@ katana::PropertyGraphRetractor::InformPath(const std::string& input_path) {
 Result<void>
 katana::PropertyGraphRetractor::DropTopologies() {
   pg_->topology_ = GraphTopology{};
+  pg_->InvalidateDegreeDistribution();
+  InvalidateSnapshots();
   return pg_->rdg_.DropTopology();
 }
+
+std::shared_ptr<const katana::PropertyGraphSnapshot>
+katana::PropertyGraphRetractor::TakeSnapshot() {
+  std::lock_guard<std::mutex> guard(snapshot_mutex_);
+  if (!snapshot_topology_) {
+    snapshot_topology_ = std::make_shared<const GraphTopology>(
+        GraphTopology::Copy(pg_->topology()));
+    ++snapshot_version_;
+  }
+  // The constructor is private; snapshots only come from here
+  return std::shared_ptr<const PropertyGraphSnapshot>(new PropertyGraphSnapshot(
+      snapshot_topology_, pg_->rdg_.node_properties(),
+      pg_->rdg_.edge_properties(), snapshot_version_));
+}
+
+void
+katana::PropertyGraphRetractor::InvalidateSnapshots() {
+  std::lock_guard<std::mutex> guard(snapshot_mutex_);
+  // Snapshots already taken keep their reference to the old topology alive;
+  // dropping ours just forces the next TakeSnapshot to copy afresh
+  snapshot_topology_.reset();
+}
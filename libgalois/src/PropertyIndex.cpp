@@ -1,5 +1,8 @@
 #include "katana/PropertyIndex.h"
 
+#include "katana/DynamicBitset.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
 #include "katana/PropertyGraph.h"
 
 namespace katana {
@@ -43,6 +46,34 @@ MakeTypedIndex(
   return Result<std::unique_ptr<PropertyIndex<node_or_edge>>>(std::move(index));
 }
 
+namespace {
+
+// Fills `ids` with the ids of all entities whose property value is not
+// null. The common all-valid case is a parallel iota; columns with nulls
+// take a serial compaction pass, which is cheap next to the sort.
+template <typename node_or_edge, typename ArrayType>
+void
+CollectValidIds(
+    katana::PODVector<node_or_edge>* ids, const ArrayType& property,
+    size_t num_entities) {
+  ids->resize(num_entities);
+  if (property.null_count() == 0) {
+    katana::do_all(
+        katana::iterate(size_t{0}, num_entities),
+        [&](size_t i) { (*ids)[i] = static_cast<node_or_edge>(i); });
+    return;
+  }
+  size_t pos = 0;
+  for (size_t i = 0; i < num_entities; ++i) {
+    if (property.IsValid(i)) {
+      (*ids)[pos++] = static_cast<node_or_edge>(i);
+    }
+  }
+  ids->resize(pos);
+}
+
+}  // namespace
+
 template <typename node_or_edge, typename c_type>
 Result<void>
 PrimitivePropertyIndex<node_or_edge, c_type>::BuildFromProperty() {
@@ -51,14 +82,15 @@ PrimitivePropertyIndex<node_or_edge, c_type>::BuildFromProperty() {
         ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
 
-  // TODO(osh): Index build should be parallelized.
-  for (node_or_edge i = 0; i < num_entities_; ++i) {
-    // The keys inserted are the node ids - the set translates these into
-    // property values.
-    if (property_->IsValid(i)) {
-      set_.insert(IndexID{i});
-    }
-  }
+  CollectValidIds(&this->ids_, *property_, num_entities_);
+
+  // Sort the ids by property value; the sorted permutation replaces the
+  // node-per-element tree the index used to build serially.
+  katana::ParallelSTL::sort(
+      this->ids_.begin(), this->ids_.end(),
+      [&](node_or_edge a, node_or_edge b) {
+        return std::less<c_type>{}(property_->Value(a), property_->Value(b));
+      });
 
   return katana::ResultSuccess();
 }
@@ -71,16 +103,73 @@ StringPropertyIndex<node_or_edge>::BuildFromProperty() {
         ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
 
-  // TODO(osh): Index build should be parallelized.
-  for (node_or_edge i = 0; i < num_entities_; ++i) {
-    // The keys inserted are the node ids - the set translates these into
-    // property values.
-    if (property_->IsValid(i)) {
-      set_.insert(IndexID{i});
+  CollectValidIds(&this->ids_, *property_, num_entities_);
+
+  katana::ParallelSTL::sort(
+      this->ids_.begin(), this->ids_.end(),
+      [&](node_or_edge a, node_or_edge b) {
+        return std::less<std::string_view>{}(GetValue(a), GetValue(b));
+      });
+
+  return katana::ResultSuccess();
+}
+
+template <typename node_or_edge>
+std::vector<node_or_edge>
+IntersectIndexRanges(
+    const std::vector<StandardRange<const node_or_edge*>>& ranges,
+    size_t num_entities) {
+  std::vector<node_or_edge> result;
+  if (ranges.empty()) {
+    return result;
+  }
+
+  size_t total = 0;
+  for (const auto& r : ranges) {
+    total += std::distance(r.begin(), r.end());
+  }
+
+  // Sorting the candidate lists costs O(total log total) while the bitmap
+  // path streams one num_entities-bit bitmap per range; prefer sorting when
+  // the scans are selective.
+  if (total < num_entities / 8) {
+    std::vector<std::vector<node_or_edge>> sorted(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      sorted[i].assign(ranges[i].begin(), ranges[i].end());
+      katana::ParallelSTL::sort(sorted[i].begin(), sorted[i].end());
+    }
+    // Intersect smallest-first so the working set only shrinks.
+    std::sort(
+        sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+          return a.size() < b.size();
+        });
+    result = std::move(sorted[0]);
+    std::vector<node_or_edge> tmp;
+    for (size_t i = 1; i < sorted.size() && !result.empty(); ++i) {
+      tmp.clear();
+      std::set_intersection(
+          result.begin(), result.end(), sorted[i].begin(), sorted[i].end(),
+          std::back_inserter(tmp));
+      result.swap(tmp);
     }
+    return result;
   }
 
-  return katana::ResultSuccess();
+  DynamicBitset accum;
+  accum.resize(num_entities);
+  katana::do_all(
+      katana::iterate(ranges[0].begin(), ranges[0].end()),
+      [&](node_or_edge id) { accum.set(id); });
+  DynamicBitset current;
+  current.resize(num_entities);
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    current.reset();
+    katana::do_all(
+        katana::iterate(ranges[i].begin(), ranges[i].end()),
+        [&](node_or_edge id) { current.set(id); });
+    accum.bitwise_and(current);
+  }
+  return accum.GetOffsets<node_or_edge>();
 }
 
 // Forward declare template types to allow implementation in .cpp.
@@ -103,4 +192,11 @@ MakeTypedIndex(
     const std::string& column_name, size_t num_entities,
     std::shared_ptr<arrow::Array> property);
 
+template std::vector<GraphTopology::Node> IntersectIndexRanges(
+    const std::vector<StandardRange<const GraphTopology::Node*>>& ranges,
+    size_t num_entities);
+template std::vector<GraphTopology::Edge> IntersectIndexRanges(
+    const std::vector<StandardRange<const GraphTopology::Edge*>>& ranges,
+    size_t num_entities);
+
 }  // namespace katana
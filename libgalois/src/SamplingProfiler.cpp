@@ -0,0 +1,186 @@
+#include "katana/SamplingProfiler.h"
+
+#include <signal.h>
+#include <sys/time.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <map>
+
+#include "katana/Env.h"
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/ProgressTracer.h"
+
+namespace {
+
+// The sample table is written from the signal handler, so it is a fixed
+// array of atomics probed linearly: no allocation, no locks. Loop names
+// are string literals, which makes the pointer itself a stable key; the
+// render step merges slots whose literals compare equal.
+struct Slot {
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> count{0};
+};
+
+constexpr size_t kNumSlots = 512;
+std::array<Slot, kNumSlots> sample_table;
+std::atomic<uint64_t> dropped_samples{0};
+
+thread_local const char* tl_loop_name = nullptr;
+
+const char kOutsideLoops[] = "(outside parallel loops)";
+
+struct sigaction previous_action;
+
+void
+HandleSample(int) {
+  const char* name = tl_loop_name != nullptr ? tl_loop_name : kOutsideLoops;
+  auto key = reinterpret_cast<uintptr_t>(name);
+  size_t slot_index = (key >> 4) % kNumSlots;
+  for (size_t probes = 0; probes < kNumSlots; ++probes) {
+    Slot& slot = sample_table[slot_index];
+    const char* occupant = slot.name.load(std::memory_order_acquire);
+    if (occupant == nullptr) {
+      if (slot.name.compare_exchange_strong(
+              occupant, name, std::memory_order_acq_rel)) {
+        occupant = name;
+      }
+      // on failure occupant holds the racing writer's name; fall through
+    }
+    if (occupant == name) {
+      slot.count.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    slot_index = (slot_index + 1) % kNumSlots;
+  }
+  dropped_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+katana::SamplingProfiler&
+katana::SamplingProfiler::Get() {
+  static SamplingProfiler profiler;
+  return profiler;
+}
+
+katana::Result<void>
+katana::SamplingProfiler::Start(uint64_t samples_per_sec) {
+  if (running_) {
+    return KATANA_ERROR(ErrorCode::AlreadyExists, "profiler already running");
+  }
+  if (samples_per_sec == 0 || samples_per_sec > 1000000) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "invalid sampling rate {}",
+        samples_per_sec);
+  }
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = HandleSample;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  if (sigaction(SIGPROF, &action, &previous_action) != 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "sigaction: {}", std::strerror(errno));
+  }
+
+  uint64_t period_usec = 1000000 / samples_per_sec;
+  itimerval timer;
+  timer.it_interval.tv_sec = period_usec / 1000000;
+  timer.it_interval.tv_usec = period_usec % 1000000;
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    sigaction(SIGPROF, &previous_action, nullptr);
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "setitimer: {}", std::strerror(errno));
+  }
+
+  running_ = true;
+  return ResultSuccess();
+}
+
+katana::Result<void>
+katana::SamplingProfiler::Stop() {
+  if (!running_) {
+    return KATANA_ERROR(ErrorCode::NotFound, "profiler is not running");
+  }
+
+  itimerval timer;
+  std::memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  sigaction(SIGPROF, &previous_action, nullptr);
+  running_ = false;
+
+  uint64_t total = 0;
+  for (const Slot& slot : sample_table) {
+    total += slot.count.load(std::memory_order_relaxed);
+  }
+  Tags tags = {
+      {"samples", total},
+      {"dropped_samples", dropped_samples.load(std::memory_order_relaxed)},
+      {"collapsed_stacks", GetCollapsedStacks()},
+  };
+  GetTracer().GetActiveSpan().Log("sampling profile", tags);
+
+  return ResultSuccess();
+}
+
+void
+katana::SamplingProfiler::StartIfRequested() {
+  if (!GetEnv("KATANA_SAMPLING_PROFILER")) {
+    return;
+  }
+  if (auto res = Start(); !res) {
+    KATANA_LOG_WARN("could not start sampling profiler: {}", res.error());
+  }
+}
+
+void
+katana::SamplingProfiler::StopIfRunning() {
+  if (!running_) {
+    return;
+  }
+  if (auto res = Stop(); !res) {
+    KATANA_LOG_WARN("could not stop sampling profiler: {}", res.error());
+  }
+}
+
+std::string
+katana::SamplingProfiler::GetCollapsedStacks() const {
+  // Distinct literals can carry equal strings across translation units;
+  // merge them here where allocation is allowed.
+  std::map<std::string, uint64_t> merged;
+  for (const Slot& slot : sample_table) {
+    const char* name = slot.name.load(std::memory_order_acquire);
+    if (name == nullptr) {
+      continue;
+    }
+    uint64_t count = slot.count.load(std::memory_order_relaxed);
+    if (count > 0) {
+      merged[name] += count;
+    }
+  }
+
+  std::string out;
+  for (const auto& [name, count] : merged) {
+    out += "katana;";
+    out += name;
+    out += ' ';
+    out += std::to_string(count);
+    out += '\n';
+  }
+  return out;
+}
+
+katana::SamplingProfiler::LoopScope::LoopScope(const char* loopname)
+    : previous_(tl_loop_name) {
+  tl_loop_name = loopname;
+}
+
+katana::SamplingProfiler::LoopScope::~LoopScope() {
+  tl_loop_name = previous_;
+}
@@ -22,6 +22,9 @@
 #include <memory>
 
 #include "katana/Barrier.h"
+#include "katana/Env.h"
+#include "katana/JobScheduler.h"
+#include "katana/Logging.h"
 #include "katana/PagePool.h"
 #include "katana/TerminationDetection.h"
 #include "katana/ThreadPool.h"
@@ -202,13 +205,130 @@ public:
   }
 };
 
+// Flat phase-based termination detection. Each thread owns a cache-line
+// padded slot into which it publishes the phase it has confirmed as idle,
+// together with a bit recording whether it worked since its previous
+// confirmation. A phase completes once every thread has confirmed it; the
+// completing thread advances the global phase, and two consecutive all-clean
+// phases mean no work happened between two global confirmations, so it is
+// safe to terminate. Detection latency is two flat scans instead of the ring
+// scheme's two token circulations, which matters for loops with many tiny
+// rounds. A thread that is between popping work and signaling has not
+// confirmed the current phase, so the phase cannot complete under its feet.
+class FlatTerminationDetection : public katana::TerminationDetection {
+  struct Slot {
+    // ((confirmed_phase + 1) << 1) | worked_during_that_phase;
+    // zero means nothing confirmed yet
+    std::atomic<uint64_t> confirmed;
+    // work since the last confirmation; only touched by the owning thread
+    bool worked;
+  };
+
+  katana::PerThreadStorage<katana::CacheLineStorage<Slot>> slots_;
+
+  // (round << 1) | previous_round_was_clean
+  katana::CacheLineStorage<std::atomic<uint64_t>> phase_;
+
+  unsigned active_threads_;
+
+protected:
+  void Init(unsigned active_threads) override {
+    active_threads_ = active_threads;
+  }
+
+public:
+  void InitializeThread() override {
+    Slot& slot = slots_.getLocal()->get();
+    slot.confirmed = 0;
+    // conservatively dirty, like the ring scheme's initial black state
+    slot.worked = true;
+    phase_.get() = 0;
+    ResetTerminated();
+  }
+
+  void SignalWorked(bool work_happened) override {
+    KATANA_LOG_DEBUG_ASSERT(!(work_happened && !Working()));
+    Slot& slot = slots_.getLocal()->get();
+    if (work_happened) {
+      slot.worked = true;
+      return;
+    }
+
+    const uint64_t phase = phase_.get().load(std::memory_order_acquire);
+    const uint64_t round = phase >> 1;
+
+    // confirm the current round once; work after confirming stays pending
+    // in slot.worked and dirties the next round instead
+    if ((slot.confirmed.load(std::memory_order_relaxed) >> 1) != round + 1) {
+      slot.confirmed.store(
+          ((round + 1) << 1) | (slot.worked ? 1 : 0),
+          std::memory_order_release);
+      slot.worked = false;
+    }
+
+    // flat completion scan; all slots are read-only here
+    uint64_t dirty = 0;
+    for (unsigned i = 0; i < active_threads_; ++i) {
+      uint64_t v =
+          slots_.getRemote(i)->get().confirmed.load(std::memory_order_acquire);
+      if ((v >> 1) != round + 1) {
+        // round not complete yet
+        return;
+      }
+      dirty |= (v & 1);
+    }
+
+    if ((phase & 1) && !dirty) {
+      // This was the second clean round
+      SetTerminated();
+      return;
+    }
+
+    // advance the round; on CAS failure another thread got there first
+    uint64_t expected = phase;
+    phase_.get().compare_exchange_strong(
+        expected, ((round + 1) << 1) | (dirty ? 0 : 1),
+        std::memory_order_acq_rel);
+  }
+};
+
+//! Pick the system barrier algorithm; KATANA_BARRIER overrides the
+//! round-length-adaptive default
+std::unique_ptr<katana::Barrier>
+makeSystemBarrier(unsigned max_threads) {
+  std::string kind = "adaptive";
+  katana::GetEnv("KATANA_BARRIER", &kind);
+
+  if (kind == "topo") {
+    return katana::CreateTopoBarrier(max_threads);
+  }
+  if (kind == "mcs") {
+    return katana::CreateMCSBarrier(max_threads);
+  }
+  if (kind == "counting") {
+    return katana::CreateCountingBarrier(max_threads);
+  }
+  if (kind == "dissemination") {
+    return katana::CreateDisseminationBarrier(max_threads);
+  }
+  if (kind == "combining") {
+    return katana::CreateCombiningBarrier(max_threads);
+  }
+  if (kind != "adaptive") {
+    KATANA_LOG_WARN("unknown KATANA_BARRIER \"{}\"; using adaptive", kind);
+  }
+  return katana::CreateAdaptiveBarrier(max_threads);
+}
+
 }  // namespace
 
 struct katana::SharedMem::Impl {
   struct Dependents {
     LocalTerminationDetection term;
+    FlatTerminationDetection flat_term;
     std::unique_ptr<Barrier> barrier;
     internal::PageAllocState<> page_pool;
+    JobScheduler job_scheduler;
   };
 
   ThreadPool thread_pool;
@@ -222,15 +342,19 @@ katana::SharedMem::SharedMem() : impl_(std::make_unique<Impl>()) {
   // may call GetThreadPool() in their constructors
   impl_->deps = std::make_unique<Impl::Dependents>();
   impl_->deps->barrier =
-      katana::CreateTopoBarrier(impl_->thread_pool.getMaxUsableThreads());
+      makeSystemBarrier(impl_->thread_pool.getMaxUsableThreads());
 
   internal::SetBarrier(impl_->deps->barrier.get());
   internal::SetTerminationDetection(&impl_->deps->term);
+  internal::SetFlatTerminationDetection(&impl_->deps->flat_term);
   internal::setPagePoolState(&impl_->deps->page_pool);
+  internal::setJobScheduler(&impl_->deps->job_scheduler);
 }
 
 katana::SharedMem::~SharedMem() {
+  internal::setJobScheduler(nullptr);
   internal::setPagePoolState(nullptr);
+  internal::SetFlatTerminationDetection(nullptr);
   internal::SetTerminationDetection(nullptr);
   internal::SetBarrier(nullptr);
 
@@ -19,12 +19,24 @@
 
 #include "katana/SharedMemSys.h"
 
+#include <sstream>
+
+#include <fmt/format.h>
+
+#include "katana/ArrowInterchange.h"
 #include "katana/CommBackend.h"
 #include "katana/Logging.h"
+#include "katana/MemoryTelemetry.h"
+#include "katana/Metrics.h"
+#include "katana/NumaArrowMemoryPool.h"
+#include "katana/PageAlloc.h"
+#include "katana/PagePool.h"
 #include "katana/Plugin.h"
+#include "katana/SamplingProfiler.h"
 #include "katana/SharedMem.h"
 #include "katana/Statistics.h"
 #include "katana/TextTracer.h"
+#include "katana/Threads.h"
 #include "tsuba/FileStorage.h"
 #include "tsuba/tsuba.h"
 
@@ -32,11 +44,66 @@ namespace {
 
 katana::NullCommBackend comm_backend;
 
+/// Per-loop CPU samples as a labeled family; live only while the
+/// sampling profiler runs, which is what makes "which loop is the job
+/// stuck in" answerable from a scrape.
+void
+RenderLoopSamples(std::string* out) {
+  auto& profiler = katana::SamplingProfiler::Get();
+  if (!profiler.running()) {
+    return;
+  }
+  out->append(
+      "# HELP katana_loop_samples CPU samples attributed to each katana "
+      "loop\n"
+      "# TYPE katana_loop_samples counter\n");
+  // collapsed-stack lines are "process;loop count"
+  std::istringstream lines(profiler.GetCollapsedStacks());
+  std::string line;
+  while (std::getline(lines, line)) {
+    size_t semi = line.find(';');
+    size_t space = line.rfind(' ');
+    if (semi == std::string::npos || space == std::string::npos ||
+        space <= semi) {
+      continue;
+    }
+    fmt::format_to(
+        std::back_inserter(*out), "katana_loop_samples_total{{loop=\"{}\"}} {}\n",
+        line.substr(semi + 1, space - semi - 1), line.substr(space + 1));
+  }
+}
+
+void
+RegisterRuntimeMetrics() {
+  auto& registry = katana::MetricsRegistry::Get();
+  registry.RegisterGauge(
+      "katana_active_threads", "Threads the runtime is currently using",
+      []() { return static_cast<double>(katana::getActiveThreads()); });
+  registry.RegisterGauge(
+      "katana_page_pool_pages", "Huge pages handed out by the page pool",
+      []() { return static_cast<double>(katana::numPagePoolAllocTotal()); });
+  registry.RegisterGauge(
+      "katana_arrow_pool_bytes",
+      "Bytes currently allocated from the NUMA-aware arrow pool", []() {
+        return static_cast<double>(
+            katana::NumaArrowMemoryPool::Global().bytes_allocated());
+      });
+  registry.RegisterGauge(
+      "katana_arrow_pool_bytes_max",
+      "High-water bytes of the NUMA-aware arrow pool", []() {
+        return static_cast<double>(
+            katana::NumaArrowMemoryPool::Global().max_memory());
+      });
+  registry.RegisterFamily(RenderLoopSamples);
+}
+
 }  // namespace
 
 struct katana::SharedMemSys::Impl {
   katana::SharedMem shared_mem;
   katana::StatManager stat_manager;
+  // covers the whole run; apps can add finer-grained PhaseScopes
+  std::unique_ptr<katana::MemoryTelemetry::PhaseScope> memory_telemetry;
 };
 
 katana::SharedMemSys::SharedMemSys(std::unique_ptr<ProgressTracer> tracer)
@@ -46,12 +113,39 @@ katana::SharedMemSys::SharedMemSys(std::unique_ptr<ProgressTracer> tracer)
     KATANA_LOG_FATAL("tsuba::Init: {}", init_good.error());
   }
   katana::ProgressTracer::Set(std::move(tracer));
+  // route arrow buffers (tsuba reads, property building) through the
+  // NUMA-aware pool now that the page allocator is up
+  katana::SetArrowMemoryPool(&katana::NumaArrowMemoryPool::Global());
 
   katana::internal::setSysStatManager(&impl_->stat_manager);
+  katana::internal::reportThreadPinning();
+
+  katana::SamplingProfiler::Get().StartIfRequested();
+  RegisterRuntimeMetrics();
+  katana::MetricsExporter::Get().StartIfRequested();
+  if (katana::MemoryTelemetry::Enabled()) {
+    impl_->memory_telemetry =
+        std::make_unique<katana::MemoryTelemetry::PhaseScope>("run");
+  }
 }
 
 katana::SharedMemSys::~SharedMemSys() {
+  // log telemetry while the tracer is still open
+  impl_->memory_telemetry.reset();
+  if (katana::allocBudgetBytes() > 0) {
+    katana::GetTracer().GetActiveSpan().Log(
+        "memory budget",
+        {
+            {"budget_mb", katana::allocBudgetBytes() >> 20},
+            {"high_water_mb", katana::allocHighWaterBytes() >> 20},
+        });
+  }
+  // keep the endpoint scrapeable for as long as the job is alive
+  katana::MetricsExporter::Get().Stop();
+  katana::SamplingProfiler::Get().StopIfRunning();
+  katana::NumaArrowMemoryPool::Global().ReportStats();
   katana::PrintStats();
+  katana::SetArrowMemoryPool(nullptr);
   katana::internal::setSysStatManager(nullptr);
 
   if (auto fini_good = tsuba::Fini(); !fini_good) {
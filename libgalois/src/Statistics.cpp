@@ -29,6 +29,7 @@
 #include "katana/Env.h"
 #include "katana/Executor_OnEach.h"
 #include "katana/Logging.h"
+#include "katana/PageAlloc.h"
 #include "katana/PerThreadStorage.h"
 #include "tsuba/file.h"
 
@@ -297,6 +298,14 @@ katana::reportPageAlloc(const char* category) {
         ReportStatSum("PageAlloc", category, numPagePoolAllocForThread(tid));
       },
       std::make_tuple());
+
+  // Hugepage coverage achieved so far by the page allocator, which backs
+  // both the page pool and NUMAArray. Prefixed with the category so the
+  // pre/post reports stay distinguishable.
+  std::string prefix(category);
+  ReportStatSum("PageAlloc", prefix + "HugeTLB", numPagesHugeTLB());
+  ReportStatSum("PageAlloc", prefix + "THPAdvised", numPagesTHPAdvised());
+  ReportStatSum("PageAlloc", prefix + "NotHuge", numPagesNotHuge());
 }
 
 void
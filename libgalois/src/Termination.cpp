@@ -24,6 +24,7 @@
 katana::TerminationDetection::~TerminationDetection() = default;
 
 static katana::TerminationDetection* kTerminationDetection = nullptr;
+static katana::TerminationDetection* kFlatTerminationDetection = nullptr;
 
 void
 katana::internal::SetTerminationDetection(katana::TerminationDetection* t) {
@@ -33,8 +34,22 @@ katana::internal::SetTerminationDetection(katana::TerminationDetection* t) {
   kTerminationDetection = t;
 }
 
+void
+katana::internal::SetFlatTerminationDetection(katana::TerminationDetection* t) {
+  KATANA_LOG_VASSERT(
+      !(kFlatTerminationDetection && t),
+      "Double initialization of flat TerminationDetection");
+  kFlatTerminationDetection = t;
+}
+
 katana::TerminationDetection&
 katana::GetTerminationDetection(unsigned active_threads) {
   kTerminationDetection->Init(active_threads);
   return *kTerminationDetection;
 }
+
+katana::TerminationDetection&
+katana::GetFlatTerminationDetection(unsigned active_threads) {
+  kFlatTerminationDetection->Init(active_threads);
+  return *kFlatTerminationDetection;
+}
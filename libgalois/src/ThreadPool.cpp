@@ -25,6 +25,7 @@
 #include "katana/Env.h"
 #include "katana/HWTopo.h"
 #include "katana/Logging.h"
+#include "katana/Threads.h"
 
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
@@ -42,7 +43,18 @@ ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo),
       reserved(0),
       masterFastmode(false),
-      running(false) {
+      running(false),
+      autoWarm(false),
+      warming(false),
+      warmGapMicros(500) {
+  int warm_us = 0;
+  if (GetEnv("KATANA_WARM_POOL_US", &warm_us)) {
+    autoWarm = true;
+    warmGapMicros = warm_us;
+  } else if (GetEnv("KATANA_WARM_POOL")) {
+    autoWarm = true;
+  }
+
   signals.resize(mi.maxThreads);
   initThread(0);
 
@@ -68,7 +80,8 @@ ThreadPool::~ThreadPool() {
 
 void
 ThreadPool::destroyCommon() {
-  beKind();  // reset fastmode
+  autoWarm = false;  // don't warm up just to shut down
+  beKind();          // reset fastmode
   run(mi.maxThreads, []() { throw shutdown_ty(); });
 }
 
@@ -86,6 +99,30 @@ ThreadPool::burnPower(unsigned num) {
   }
 }
 
+void
+ThreadPool::autoWarmPool(unsigned num) {
+  if (!autoWarm || warming || running) {
+    return;
+  }
+  num = std::min(std::max(1U, num), getMaxUsableThreads());
+  if (masterFastmode == num) {
+    return;
+  }
+  // no loop has finished yet; nothing to measure the gap against
+  if (lastRunEnd == std::chrono::steady_clock::time_point()) {
+    return;
+  }
+  auto gap = std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now() - lastRunEnd)
+                 .count();
+  if (gap > warmGapMicros) {
+    return;
+  }
+  warming = true;
+  burnPower(num);
+  warming = false;
+}
+
 void
 ThreadPool::beKind() {
   if (masterFastmode) {
@@ -149,6 +186,12 @@ ThreadPool::initThread(unsigned tid) {
       bindThreadSelf(my_box.topo.osContext);
     }
   }
+
+  const ThreadPinningProfile& profile = getThreadPinningProfile();
+  if (profile.preferredNumaNode >= 0) {
+    bindThreadMemoryPreferred(profile.preferredNumaNode);
+  }
+
   my_box.done = 1;
 }
 
@@ -253,6 +296,9 @@ ThreadPool::runInternal(unsigned num) {
   // Clean up
   work = nullptr;
   running = false;
+  if (autoWarm) {
+    lastRunEnd = std::chrono::steady_clock::now();
+  }
 }
 
 void
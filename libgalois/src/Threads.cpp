@@ -20,12 +20,122 @@
 #include "katana/Threads.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
 
+#include "katana/Env.h"
+#include "katana/HWTopo.h"
+#include "katana/Logging.h"
+#include "katana/Statistics.h"
 #include "katana/ThreadPool.h"
 namespace katana {
 KATANA_EXPORT unsigned int activeThreads = 1;
 }  // namespace katana
 
+namespace {
+
+std::string pinning_spec;
+bool pinning_spec_locked = false;
+
+katana::ThreadPinningProfile
+parsePinningSpec(const std::string& spec) {
+  using Order = katana::ThreadPinningProfile::Order;
+
+  katana::ThreadPinningProfile profile;
+
+  std::stringstream tokens(spec);
+  std::string token;
+  while (std::getline(tokens, token, ',')) {
+    if (token.empty()) {
+      continue;
+    }
+    if (token == "compact") {
+      profile.order = Order::kCompact;
+    } else if (token == "scatter") {
+      profile.order = Order::kScatter;
+    } else if (token == "no-e-cores") {
+      profile.excludeEfficiencyCores = true;
+    } else if (token.rfind("sockets=", 0) == 0) {
+      // socket ids are separated by '+' since ',' separates tokens
+      std::stringstream ids(token.substr(strlen("sockets=")));
+      std::string id;
+      while (std::getline(ids, id, '+')) {
+        unsigned socket{};
+        if (sscanf(id.c_str(), "%u", &socket) == 1) {
+          profile.sockets.push_back(socket);
+        } else {
+          KATANA_LOG_WARN("ignoring malformed socket id: {}", id);
+        }
+      }
+    } else if (token.rfind("hbm-node=", 0) == 0) {
+      int node{};
+      if (sscanf(token.c_str(), "hbm-node=%d", &node) == 1 && node >= 0) {
+        profile.preferredNumaNode = node;
+      } else {
+        KATANA_LOG_WARN("ignoring malformed token: {}", token);
+      }
+    } else {
+      KATANA_LOG_WARN("ignoring unknown thread pinning token: {}", token);
+    }
+  }
+
+  return profile;
+}
+
+}  // namespace
+
+bool
+katana::setThreadPinningProfile(const std::string& spec) noexcept {
+  if (pinning_spec_locked) {
+    KATANA_LOG_WARN(
+        "thread pinning profile \"{}\" ignored: the thread pool has already "
+        "started",
+        spec);
+    return false;
+  }
+  pinning_spec = spec;
+  return true;
+}
+
+const katana::ThreadPinningProfile&
+katana::getThreadPinningProfile() noexcept {
+  static ThreadPinningProfile profile = [] {
+    pinning_spec_locked = true;
+    if (pinning_spec.empty()) {
+      GetEnv("KATANA_THREAD_PINNING", &pinning_spec);
+    }
+    return parsePinningSpec(pinning_spec);
+  }();
+  return profile;
+}
+
+void
+katana::internal::reportThreadPinning() {
+  // locks the spec as a side effect if nothing else has
+  getThreadPinningProfile();
+
+  if (pinning_spec.empty()) {
+    return;
+  }
+
+  HWTopoInfo topo = getHWTopo();
+  std::ostringstream contexts;
+  std::ostringstream numa_nodes;
+  for (const auto& t : topo.threadTopoInfo) {
+    if (t.tid != 0) {
+      contexts << " ";
+      numa_nodes << " ";
+    }
+    contexts << t.osContext;
+    numa_nodes << t.osNumaNode;
+  }
+
+  ReportParam("ThreadPinning", "Profile", pinning_spec);
+  ReportParam("ThreadPinning", "OsContexts", contexts.str());
+  ReportParam("ThreadPinning", "OsNumaNodes", numa_nodes.str());
+}
+
 unsigned int
 katana::setActiveThreads(unsigned int num) noexcept {
   num = std::min(num, katana::GetThreadPool().getMaxUsableThreads());
@@ -0,0 +1,153 @@
+#include "katana/analytics/IterativeCheckpoint.h"
+
+#include <cstring>
+
+#include "katana/Logging.h"
+#include "katana/URI.h"
+#include "tsuba/WriteGroup.h"
+#include "tsuba/file.h"
+
+namespace {
+
+constexpr uint64_t kMagic = UINT64_C(0x4b61436b70743031);  // "KaCkpt01"
+constexpr uint32_t kVersion = 1;
+
+struct Header {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t round;
+  uint64_t num_sections;
+  // whole file: header, section sizes, section bytes, trailing sentinel
+  uint64_t total_bytes;
+};
+
+// the sentinel lands last, so its presence means every byte before it did
+uint64_t
+SentinelOffset(const Header& header) {
+  return header.total_bytes - sizeof(kMagic);
+}
+
+}  // namespace
+
+katana::analytics::IterativeCheckpointer::IterativeCheckpointer(
+    std::string location, std::string name, uint32_t interval_rounds)
+    : location_(std::move(location)),
+      name_(std::move(name)),
+      interval_rounds_(interval_rounds) {}
+
+katana::analytics::IterativeCheckpointer::~IterativeCheckpointer() {
+  if (!Enabled()) {
+    return;
+  }
+  if (auto res = tsuba::WriteGroup::FinishPending(); !res) {
+    KATANA_LOG_WARN(
+        "final checkpoint for {} did not land: {}", name_, res.error());
+  }
+}
+
+std::string
+katana::analytics::IterativeCheckpointer::SlotUri(uint32_t slot) const {
+  return katana::Uri::JoinPath(
+      location_, fmt::format("{}.ckpt.{}", name_, slot));
+}
+
+katana::Result<void>
+katana::analytics::IterativeCheckpointer::Save(
+    uint32_t round, const std::vector<Section>& sections) {
+  // Make waits for the previous DrainAsync, so buffer_ is free again and a
+  // failed earlier store surfaces here instead of being dropped
+  std::unique_ptr<tsuba::WriteGroup> group =
+      KATANA_CHECKED(tsuba::WriteGroup::Make());
+
+  Header header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.round = round;
+  header.num_sections = sections.size();
+  header.total_bytes =
+      sizeof(Header) + sections.size() * sizeof(uint64_t) + sizeof(kMagic);
+  for (const Section& section : sections) {
+    header.total_bytes += section.bytes;
+  }
+
+  buffer_.resize(header.total_bytes);
+  uint8_t* out = buffer_.data();
+  memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  for (const Section& section : sections) {
+    uint64_t bytes = section.bytes;
+    memcpy(out, &bytes, sizeof(bytes));
+    out += sizeof(bytes);
+  }
+  for (const Section& section : sections) {
+    memcpy(out, section.data, section.bytes);
+    out += section.bytes;
+  }
+  memcpy(out, &kMagic, sizeof(kMagic));
+
+  group->StartStore(SlotUri(next_slot_), buffer_.data(), buffer_.size());
+  next_slot_ = 1 - next_slot_;
+  tsuba::WriteGroup::DrainAsync(
+      std::move(group), []() { return katana::CopyableResultSuccess(); });
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::optional<
+    katana::analytics::IterativeCheckpointer::Snapshot>>
+katana::analytics::IterativeCheckpointer::Restore() {
+  // newest slot that validates wins; a torn or missing slot is a normal
+  // cold-start condition, not an error
+  bool found = false;
+  uint32_t best_slot = 0;
+  Header best_header{};
+  for (uint32_t slot = 0; slot < 2; ++slot) {
+    Header header{};
+    if (!tsuba::FileGet(SlotUri(slot), &header)) {
+      continue;
+    }
+    if (header.magic != kMagic || header.version != kVersion ||
+        header.total_bytes <
+            sizeof(Header) + header.num_sections * sizeof(uint64_t) +
+                sizeof(kMagic)) {
+      continue;
+    }
+    uint64_t sentinel = 0;
+    if (!tsuba::FileGet(
+            SlotUri(slot), &sentinel, SentinelOffset(header),
+            sizeof(sentinel)) ||
+        sentinel != kMagic) {
+      continue;
+    }
+    if (!found || header.round > best_header.round) {
+      found = true;
+      best_slot = slot;
+      best_header = header;
+    }
+  }
+  if (!found) {
+    return std::optional<Snapshot>();
+  }
+
+  std::vector<uint64_t> sizes(best_header.num_sections);
+  KATANA_CHECKED(tsuba::FileGet(
+      SlotUri(best_slot), sizes.data(), sizeof(Header),
+      sizes.size() * sizeof(uint64_t)));
+
+  Snapshot snapshot;
+  snapshot.round = best_header.round;
+  uint64_t offset = sizeof(Header) + sizes.size() * sizeof(uint64_t);
+  for (uint64_t bytes : sizes) {
+    std::vector<uint8_t> section(bytes);
+    KATANA_CHECKED(
+        tsuba::FileGet(SlotUri(best_slot), section.data(), offset, bytes));
+    offset += bytes;
+    snapshot.sections.emplace_back(std::move(section));
+  }
+
+  // overwrite the older slot first so the snapshot we resumed from
+  // survives until a newer one fully lands
+  next_slot_ = 1 - best_slot;
+  KATANA_LOG_DEBUG(
+      "resuming {} from checkpoint round {}", name_, snapshot.round);
+  return std::optional<Snapshot>(std::move(snapshot));
+}
@@ -0,0 +1,93 @@
+#include "katana/analytics/TuningProfile.h"
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/ThreadPool.h"
+#include "katana/URI.h"
+#include "tsuba/FileView.h"
+#include "tsuba/file.h"
+
+namespace {
+
+katana::Result<katana::Uri>
+ProfileUri(const std::string& rdg_dir) {
+  katana::Uri dir = KATANA_CHECKED(katana::Uri::Make(rdg_dir));
+  return dir.Join(katana::analytics::TuningProfile::kFileName);
+}
+
+}  // namespace
+
+std::string
+katana::analytics::TuningProfile::CurrentMachineShape() {
+  const ThreadPool& pool = GetThreadPool();
+  return fmt::format("{}x{}", pool.getMaxSockets(), pool.getMaxCores());
+}
+
+katana::analytics::TuningProfile
+katana::analytics::TuningProfile::Load(const PropertyGraph& pg) {
+  return Load(pg.rdg_dir());
+}
+
+katana::analytics::TuningProfile
+katana::analytics::TuningProfile::Load(const std::string& rdg_dir) {
+  if (rdg_dir.empty()) {
+    return TuningProfile();
+  }
+  auto uri = ProfileUri(rdg_dir);
+  if (!uri) {
+    KATANA_LOG_DEBUG("no tuning profile: {}", uri.error());
+    return TuningProfile();
+  }
+  tsuba::FileView fv;
+  if (auto bound = fv.Bind(uri.value().string(), true); !bound) {
+    // first run on this graph; nothing has been recorded yet
+    return TuningProfile(rdg_dir, nlohmann::json::object());
+  }
+  auto profiles = katana::JsonParse<nlohmann::json>(fv);
+  if (!profiles || !profiles.value().is_object()) {
+    KATANA_LOG_WARN(
+        "ignoring malformed tuning profile {}", uri.value().string());
+    return TuningProfile(rdg_dir, nlohmann::json::object());
+  }
+  return TuningProfile(rdg_dir, std::move(profiles.value()));
+}
+
+std::optional<int64_t>
+katana::analytics::TuningProfile::Get(
+    const std::string& algorithm, const std::string& parameter) const {
+  auto shape = profiles_.find(shape_);
+  if (shape == profiles_.end()) {
+    return std::nullopt;
+  }
+  auto algo = shape->find(algorithm);
+  if (algo == shape->end()) {
+    return std::nullopt;
+  }
+  auto param = algo->find(parameter);
+  if (param == algo->end() || !param->is_number_integer()) {
+    return std::nullopt;
+  }
+  return param->get<int64_t>();
+}
+
+void
+katana::analytics::TuningProfile::Set(
+    const std::string& algorithm, const std::string& parameter,
+    int64_t value) {
+  profiles_[shape_][algorithm][parameter] = value;
+}
+
+katana::Result<void>
+katana::analytics::TuningProfile::Store() const {
+  if (rdg_dir_.empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "tuning profile is not attached to a stored graph");
+  }
+  katana::Uri uri = KATANA_CHECKED(ProfileUri(rdg_dir_));
+  std::string serialized = KATANA_CHECKED(katana::JsonDump(profiles_));
+  return tsuba::FileStore(
+      uri.string(), reinterpret_cast<const uint8_t*>(serialized.data()),
+      serialized.size());
+}
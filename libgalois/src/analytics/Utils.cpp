@@ -19,6 +19,8 @@
 
 #include "katana/analytics/Utils.h"
 
+#include <numeric>
+
 #include "katana/Random.h"
 
 uint32_t
@@ -64,5 +66,24 @@ katana::analytics::IsApproximateDegreeDistributionPowerLaw(
   return sample_average / 1.3 > sample_median;
 }
 
+std::vector<uint32_t>
+katana::analytics::SampleValidationNodes(
+    uint64_t num_nodes, uint32_t num_samples) {
+  std::vector<uint32_t> nodes;
+  if (num_samples == 0 || num_samples >= num_nodes) {
+    nodes.resize(num_nodes);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    return nodes;
+  }
+  auto& gen = GetGenerator();
+  std::uniform_int_distribution<uint32_t> dist(0, num_nodes - 1);
+  nodes.resize(num_samples);
+  // duplicates are harmless for a spot check, so don't pay for rejection
+  for (auto& node : nodes) {
+    node = dist(gen);
+  }
+  return nodes;
+}
+
 thread_local int
     katana::analytics::TemporaryPropertyGuard::temporary_property_counter = 0;
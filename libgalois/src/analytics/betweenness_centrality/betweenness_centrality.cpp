@@ -41,6 +41,18 @@ katana::analytics::BetweennessCentrality(
     return BetweennessCentralityLevel(pg, sources, output_property_name, plan);
   case BetweennessCentralityPlan::kOuter:
     return BetweennessCentralityOuter(pg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kSampled:
+    // The sampled estimator draws its own sources until it reaches the
+    // Riondato-Kornaropoulos bound, so a caller-provided subset does not
+    // apply to it.
+    if (!std::holds_alternative<uint32_t>(sources) ||
+        sources != kBetweennessCentralityAllNodes) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "the sampled algorithm selects sources itself; pass "
+          "kBetweennessCentralityAllNodes");
+    }
+    return BetweennessCentralitySampled(pg, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
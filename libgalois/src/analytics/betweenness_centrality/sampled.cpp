@@ -0,0 +1,349 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2020, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <cmath>
+#include <random>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/DynamicBitset.h"
+#include "katana/NUMAArray.h"
+#include "katana/Properties.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+// type of the num shortest paths variable
+using SampledShortPathType = double;
+
+constexpr static uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+// Same AoS layout as the exact level-synchronous variant; the sampled
+// estimator runs the identical per-source forward/backward phases, only the
+// outer loop over sources differs.
+struct BCSampledNodeDataTy {
+  std::atomic<uint32_t> current_dist;
+  std::atomic<SampledShortPathType> num_shortest_paths;
+  float dependency;
+  float bc;
+};
+struct NodeBC : public katana::PODProperty<float> {};
+using NodeDataSampled = std::tuple<>;
+using EdgeDataSampled = std::tuple<>;
+
+typedef katana::TypedPropertyGraph<NodeDataSampled, EdgeDataSampled>
+    SampledGraph;
+typedef typename SampledGraph::Node SampledGNode;
+
+using SampledWorklistType = katana::InsertBag<SampledGNode, 4096>;
+
+constexpr static const unsigned kSampledChunkSize = 256u;
+
+/******************************************************************************/
+/* Functions for running the algorithm */
+/******************************************************************************/
+
+void
+SampledInitializeGraph(
+    SampledGraph* graph, katana::NUMAArray<BCSampledNodeDataTy>* graph_data,
+    katana::DynamicBitset* active_edges) {
+  graph_data->allocateBlocked(graph->size());
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](SampledGNode n) {
+        auto& node_data = (*graph_data)[n];
+        node_data.current_dist = 0;
+        node_data.num_shortest_paths = 0;
+        node_data.dependency = 0;
+        node_data.bc = 0;
+      },
+      katana::no_stats(), katana::loopname("InitializeGraph"));
+  active_edges->resize(graph->num_edges());
+}
+
+void
+SampledInitializeIteration(
+    SampledGraph* graph, SampledGNode src_node,
+    katana::NUMAArray<BCSampledNodeDataTy>* graph_data,
+    katana::DynamicBitset* active_edges) {
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](SampledGNode n) {
+        bool is_source = (n == src_node);
+        auto& node_data = (*graph_data)[n];
+
+        if (!is_source) {
+          node_data.current_dist = kInfinity;
+          node_data.num_shortest_paths = 0;
+        } else {
+          node_data.current_dist = 0;
+          node_data.num_shortest_paths = 1;
+        }
+        node_data.dependency = 0;
+      },
+      katana::no_stats(), katana::loopname("InitializeIteration"));
+  active_edges->reset();
+}
+
+/**
+ * Forward phase: SSSP to determine DAG and get shortest path counts, saving
+ * per-level worklists for the backward phase.
+ */
+katana::gstl::Vector<SampledWorklistType>
+SampledSSSP(
+    SampledGraph* graph, SampledGNode src_node,
+    katana::NUMAArray<BCSampledNodeDataTy>* graph_data,
+    katana::DynamicBitset* active_edges) {
+  katana::gstl::Vector<SampledWorklistType> vector_of_worklists;
+  uint32_t current_level = 0;
+
+  vector_of_worklists.emplace_back();
+  vector_of_worklists[0].emplace(src_node);
+
+  while (!vector_of_worklists[current_level].empty()) {
+    vector_of_worklists.emplace_back();
+    uint32_t next_level = current_level + 1;
+
+    katana::do_all(
+        katana::iterate(vector_of_worklists[current_level]),
+        [&](SampledGNode n) {
+          auto& src_data = (*graph_data)[n];
+          KATANA_LOG_ASSERT(src_data.current_dist == current_level);
+
+          for (auto e : graph->edges(n)) {
+            auto dest = graph->GetEdgeDest(e);
+            auto& dst_data = (*graph_data)[*dest];
+
+            if (dst_data.current_dist == kInfinity) {
+              auto expected = kInfinity;
+              // only 1 thread adds to worklist
+              bool performed_set =
+                  dst_data.current_dist.compare_exchange_strong(
+                      expected, next_level);
+              if (performed_set) {
+                vector_of_worklists[next_level].emplace(*dest);
+              }
+
+              active_edges->set(e);
+              katana::atomicAdd(
+                  dst_data.num_shortest_paths,
+                  src_data.num_shortest_paths.load());
+            } else if (dst_data.current_dist == next_level) {
+              active_edges->set(e);
+              katana::atomicAdd(
+                  dst_data.num_shortest_paths,
+                  src_data.num_shortest_paths.load());
+            }
+          }
+        },
+        katana::steal(), katana::chunk_size<kSampledChunkSize>(),
+        katana::no_stats(), katana::loopname("SampledSSSP"));
+
+    current_level++;
+  }
+  return vector_of_worklists;
+}
+
+/**
+ * Backward phase: back-propagate dependency values level by level.
+ */
+void
+SampledBackwardBrandes(
+    SampledGraph* graph,
+    katana::gstl::Vector<SampledWorklistType>* vector_of_worklists,
+    katana::NUMAArray<BCSampledNodeDataTy>* graph_data,
+    katana::DynamicBitset* active_edges) {
+  // minus 3 because last one is empty, one after is leaf nodes, and one
+  // to correct indexing to 0 index
+  if (vector_of_worklists->size() >= 3) {
+    uint32_t current_level = vector_of_worklists->size() - 3;
+
+    while (current_level > 0) {
+      SampledWorklistType& current_worklist =
+          (*vector_of_worklists)[current_level];
+
+      katana::do_all(
+          katana::iterate(current_worklist),
+          [&](SampledGNode n) {
+            auto& src_data = (*graph_data)[n];
+            KATANA_LOG_ASSERT(src_data.current_dist == current_level);
+
+            for (auto e : graph->edges(n)) {
+              if (active_edges->test(e)) {
+                auto dest = graph->GetEdgeDest(e);
+                auto& dst_data = (*graph_data)[*dest];
+
+                float contrib = ((float)1 + dst_data.dependency) /
+                                dst_data.num_shortest_paths;
+                src_data.dependency += contrib;
+              }
+            }
+
+            src_data.dependency *= src_data.num_shortest_paths;
+            src_data.bc += src_data.dependency;
+          },
+          katana::steal(), katana::chunk_size<kSampledChunkSize>(),
+          katana::no_stats(), katana::loopname("Brandes"));
+
+      current_level--;
+    }
+  }
+}
+
+/**
+ * The Riondato-Kornaropoulos sample-size bound: with
+ * r >= (c / epsilon^2) * (floor(log2(VD - 2)) + 1 + ln(1 / confidence))
+ * samples, every estimate is within epsilon of the exact normalized
+ * centrality with probability at least 1 - confidence. VD is the vertex
+ * diameter (number of nodes on a longest shortest path) and c = 0.5 is the
+ * VC-dimension constant from the paper.
+ */
+uint64_t
+SampleBound(uint64_t vertex_diameter, float epsilon, float confidence) {
+  constexpr double kVCConstant = 0.5;
+  double log_diameter = 0.0;
+  if (vertex_diameter > 2) {
+    log_diameter =
+        std::floor(std::log2(static_cast<double>(vertex_diameter - 2)));
+  }
+  double bound = (kVCConstant / (double(epsilon) * double(epsilon))) *
+                 (log_diameter + 1.0 + std::log(1.0 / double(confidence)));
+  return static_cast<uint64_t>(std::ceil(bound));
+}
+
+katana::Result<void>
+ExtractBC(
+    katana::PropertyGraph* pg, const SampledGraph& array_of_struct_graph,
+    const katana::NUMAArray<BCSampledNodeDataTy>& graph_data,
+    float scale_factor, const std::string& output_property_name) {
+  if (auto result =
+          katana::analytics::ConstructNodeProperties<std::tuple<NodeBC>>(
+              pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+  auto graph_result =
+      katana::TypedPropertyGraph<std::tuple<NodeBC>, std::tuple<>>::Make(
+          pg, {output_property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto new_graph = graph_result.value();
+
+  // extract bc to property, rescaling the sampled sums to estimates of the
+  // all-sources totals so they are comparable with the exact variants
+  katana::do_all(
+      katana::iterate(array_of_struct_graph),
+      [&](SampledGNode node_id) {
+        float bc_value = graph_data[node_id].bc * scale_factor;
+        new_graph.GetData<NodeBC>(node_id) = bc_value;
+      },
+      katana::loopname("ExtractBC"), katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralitySampled(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan) {
+  if (plan.epsilon() <= 0 || plan.confidence() <= 0 ||
+      plan.confidence() >= 1) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "epsilon must be positive and confidence must be in (0, 1): got "
+        "epsilon {} confidence {}",
+        plan.epsilon(), plan.confidence());
+  }
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "ChunkSize", kSampledChunkSize);
+  katana::StatTimer graph_construct_timer(
+      "TimerConstructGraph", "BetweennessCentrality");
+  graph_construct_timer.start();
+
+  auto pg_result =
+      katana::TypedPropertyGraph<NodeDataSampled, EdgeDataSampled>::Make(
+          pg, {}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  SampledGraph graph = pg_result.value();
+
+  graph_construct_timer.stop();
+
+  katana::StatTimer prealloc_time("PreAllocTime", "BetweennessCentrality");
+  prealloc_time.start();
+  katana::EnsurePreallocated(std::max(
+      size_t{katana::getActiveThreads()} * (graph.size() / 1350000),
+      std::max(10U, katana::getActiveThreads()) * size_t{10}));
+  prealloc_time.stop();
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::NUMAArray<BCSampledNodeDataTy> graph_data;
+  katana::DynamicBitset active_edges;
+  SampledInitializeGraph(&graph, &graph_data, &active_edges);
+
+  if (graph.size() == 0) {
+    return ExtractBC(pg, graph, graph_data, 0, output_property_name);
+  }
+
+  std::mt19937 gen{std::random_device{}()};
+  std::uniform_int_distribution<uint64_t> pick_source(0, graph.size() - 1);
+
+  katana::StatTimer exec_time("Sampled", "BetweennessCentrality");
+
+  // The sample bound needs the vertex diameter, which is unknown up front;
+  // it is refined from the level count of each forward phase, so the loop
+  // stops as soon as the samples taken cover the largest diameter seen.
+  uint64_t vertex_diameter = 2;
+  uint64_t num_samples = 0;
+  while (num_samples <
+         std::min(
+             uint64_t{pg->num_nodes()},
+             SampleBound(vertex_diameter, plan.epsilon(), plan.confidence()))) {
+    SampledGNode src_node = pick_source(gen);
+
+    exec_time.start();
+    SampledInitializeIteration(&graph, src_node, &graph_data, &active_edges);
+    katana::gstl::Vector<SampledWorklistType> worklists =
+        SampledSSSP(&graph, src_node, &graph_data, &active_edges);
+    SampledBackwardBrandes(&graph, &worklists, &graph_data, &active_edges);
+    exec_time.stop();
+
+    // worklists holds one level per distance plus a trailing empty one, so
+    // its size minus one bounds the nodes on a shortest path from src_node
+    if (worklists.size() >= 1 && worklists.size() - 1 > vertex_diameter) {
+      vertex_diameter = worklists.size() - 1;
+    }
+    num_samples++;
+  }
+
+  katana::ReportStatSingle("BetweennessCentrality", "Samples", num_samples);
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "EstimatedVertexDiameter", vertex_diameter);
+
+  // n / r turns the sampled dependency sums into unbiased estimates of the
+  // all-sources totals the exact variants report
+  float scale_factor =
+      static_cast<float>(pg->num_nodes()) / static_cast<float>(num_samples);
+  return ExtractBC(pg, graph, graph_data, scale_factor, output_property_name);
+}
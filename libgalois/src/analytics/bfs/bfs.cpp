@@ -19,11 +19,13 @@
 
 #include "katana/analytics/bfs/bfs.h"
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <type_traits>
 
-#include "katana/DynamicBitset.h"
 #include "katana/ErrorCode.h"
+#include "katana/FrontierEngine.h"
 #include "katana/Result.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
@@ -74,18 +76,6 @@ struct EdgeTileMaker {
   }
 };
 
-struct NodePushWrap {
-  template <typename C>
-  void operator()(C& cont, const GNode& n, const char* const /*tag*/) const {
-    (*this)(cont, n);
-  }
-
-  template <typename C>
-  void operator()(C& cont, const GNode& n) const {
-    cont.push(n);
-  }
-};
-
 struct EdgeTilePushWrap {
   Graph* graph;
   BfsImplementation& impl;
@@ -117,28 +107,6 @@ struct OneTilePushWrap {
   }
 };
 
-template <typename WL>
-void
-WlToBitset(const WL& wl, katana::DynamicBitset* bitset) {
-  katana::do_all(
-      katana::iterate(wl), [&](const GNode& src) { bitset->set(src); },
-      katana::chunk_size<kChunkSize>(), katana::loopname("WlToBitset"));
-}
-
-template <typename G, typename WL>
-void
-BitsetToWl(const G& graph, const katana::DynamicBitset& bitset, WL* wl) {
-  wl->clear();
-  katana::do_all(
-      katana::iterate(graph),
-      [&](const GNode& src) {
-        if (bitset.test(src)) {
-          wl->push(src);
-        }
-      },
-      katana::chunk_size<kChunkSize>(), katana::loopname("BitsetToWl"));
-}
-
 template <typename T, typename P, typename R>
 void
 AsynchronousAlgo(
@@ -217,109 +185,37 @@ AsynchronousAlgo(
   }
 }
 
-template <typename P>
 void
 SynchronousDirectOpt(
     const BiDirGraphView& bidir_view, katana::NUMAArray<GNode>* node_data,
-    const GNode source, const P& pushWrap, const uint32_t alpha,
-    const uint32_t beta) {
-  using Cont = katana::InsertBag<GNode>;
-  using Loop = katana::DoAll;
-
-  katana::GAccumulator<uint32_t> work_items;
-  katana::StatTimer bitset_to_wl_timer("Bitset_To_WL_Timer");
-  katana::StatTimer wl_to_bitset_timer("WL_To_Bitset_Timer");
-
-  Loop loop;
-
-  katana::DynamicBitset front_bitset;
-  katana::DynamicBitset next_bitset;
-
-  uint32_t num_nodes = bidir_view.num_nodes();
-  uint64_t num_edges = bidir_view.num_edges();
+    const GNode source, const uint32_t alpha, const uint32_t beta) {
+  katana::FrontierPlan plan;
+  plan.alpha = alpha;
+  plan.beta = beta;
 
-  front_bitset.resize(num_nodes);
-  next_bitset.resize(num_nodes);
-
-  auto frontier = std::make_unique<Cont>();
-  auto next_frontier = std::make_unique<Cont>();
+  katana::FrontierEngine<BiDirGraphView> engine(bidir_view, plan);
 
   (*node_data)[source] = source;
-
-  pushWrap(*next_frontier, source, "parallel");
-
-  work_items += 1;
-
-  int64_t edges_to_check = num_edges;
-  int64_t scout_count = bidir_view.degree(source);
-  uint64_t old_num_work_items{0};
-
-  katana::GAccumulator<uint64_t> writes_pull;
-  katana::GAccumulator<uint64_t> writes_push;
-
-  while (!next_frontier->empty()) {
-    std::swap(frontier, next_frontier);
-    next_frontier->clear();
-    if (scout_count > edges_to_check / alpha) {
-      wl_to_bitset_timer.start();
-      WlToBitset(*frontier, &front_bitset);
-      wl_to_bitset_timer.stop();
-      do {
-        old_num_work_items = work_items.reduce();
-        work_items.reset();
-
-        loop(
-            katana::iterate(bidir_view),
-            [&](const GNode& dst) {
-              GNode& ddata = (*node_data)[dst];
-              if (ddata == BfsImplementation::kDistanceInfinity) {
-                for (auto e : bidir_view.in_edges(dst)) {
-                  auto src = bidir_view.in_edge_dest(e);
-
-                  if (front_bitset.test(src)) {
-                    // assign parents on the bfs path.
-                    ddata = src;
-                    next_bitset.set(dst);
-                    work_items += 1;
-                    break;
-                  }
-                }
-              }
-            },
-            katana::steal(), katana::chunk_size<kChunkSize>(),
-            katana::loopname(std::string("SyncDO-pull").c_str()));
-        std::swap(front_bitset, next_bitset);
-        next_bitset.reset();
-      } while (work_items.reduce() >= old_num_work_items ||
-               (work_items.reduce() > num_nodes / beta));
-      bitset_to_wl_timer.start();
-      BitsetToWl(bidir_view, front_bitset, next_frontier.get());
-      bitset_to_wl_timer.stop();
-      scout_count = 1;
-    } else {
-      edges_to_check -= scout_count;
-      work_items.reset();
-
-      loop(
-          katana::iterate(*frontier),
-          [&](const GNode& src) {
-            for (auto e : bidir_view.edges(src)) {
-              auto dst = bidir_view.edge_dest(e);
-              GNode& ddata = (*node_data)[dst];
-              if (ddata == BfsImplementation::kDistanceInfinity) {
-                GNode old_parent = ddata;
-                if (__sync_bool_compare_and_swap(&ddata, old_parent, src)) {
-                  next_frontier->push(dst);
-                  work_items += bidir_view.degree(dst);
-                }
-              }
-            }
-          },
-          katana::steal(), katana::chunk_size<kChunkSize>(),
-          katana::loopname(std::string("SyncDO-push").c_str()));
-      scout_count = work_items.reduce();
-    }
-  }
+  engine.AddSeed(source);
+
+  engine.Run(
+      [&](const GNode& src, const GNode& dst, const auto&) {
+        GNode& ddata = (*node_data)[dst];
+        if (ddata == BfsImplementation::kDistanceInfinity) {
+          GNode old_parent = ddata;
+          return __sync_bool_compare_and_swap(&ddata, old_parent, src);
+        }
+        return false;
+      },
+      [&](const GNode& dst) {
+        return (*node_data)[dst] == BfsImplementation::kDistanceInfinity;
+      },
+      [&](const GNode& dst, const GNode& src, const auto&) {
+        // assign parents on the bfs path.
+        (*node_data)[dst] = src;
+        return true;
+      },
+      "BFS");
 }
 
 template <typename NDType, typename ValueTy>
@@ -384,8 +280,7 @@ RunAlgo(
 
     exec_time.start();
     SynchronousDirectOpt(
-        bidir_view, &node_data, source, NodePushWrap(), algo.alpha(),
-        algo.beta());
+        bidir_view, &node_data, source, algo.alpha(), algo.beta());
     exec_time.stop();
 
     UpdateGraphNodeData(graph, node_data);
@@ -448,6 +343,89 @@ BfsImpl(
   return katana::ResultSuccess();
 }
 
+/// One MS-BFS batch: up to 64 sources advance in lockstep, with bit i of
+/// a node's 64-bit word recording whether sources[batch_begin + i] has
+/// reached it. Expansion ORs a node's frontier word into its neighbors,
+/// so one pass over the adjacency lists serves the whole batch.
+void
+MultiSourceBfsBatch(
+    const katana::GraphTopology& topo, const std::vector<GNode>& sources,
+    size_t batch_begin, size_t batch_size, size_t num_sources,
+    katana::NUMAArray<uint32_t>* distances) {
+  const size_t num_nodes = topo.num_nodes();
+
+  katana::NUMAArray<uint64_t> seen;
+  katana::NUMAArray<uint64_t> visit;
+  katana::NUMAArray<std::atomic<uint64_t>> visit_next;
+  seen.allocateInterleaved(num_nodes);
+  visit.allocateInterleaved(num_nodes);
+  visit_next.allocateInterleaved(num_nodes);
+
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) {
+        seen[n] = 0;
+        visit[n] = 0;
+        visit_next.constructAt(n, uint64_t{0});
+      },
+      katana::no_stats());
+
+  for (size_t i = 0; i < batch_size; ++i) {
+    const GNode source = sources[batch_begin + i];
+    const uint64_t bit = uint64_t{1} << i;
+    seen[source] |= bit;
+    visit[source] |= bit;
+    (*distances)[size_t{source} * num_sources + batch_begin + i] = 0;
+  }
+
+  uint32_t level = 0;
+  while (true) {
+    ++level;
+
+    katana::do_all(
+        katana::iterate(topo.all_nodes()),
+        [&](const GNode& src) {
+          const uint64_t bits = visit[src];
+          if (bits == 0) {
+            return;
+          }
+          for (auto e : topo.edges(src)) {
+            const GNode dst = topo.edge_dest(e);
+            if (bits & ~seen[dst]) {
+              visit_next[dst].fetch_or(bits, std::memory_order_relaxed);
+            }
+          }
+        },
+        katana::steal(), katana::chunk_size<kChunkSize>(),
+        katana::loopname("MultiSourceBfsExpand"));
+
+    katana::GAccumulator<size_t> active;
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) {
+          uint64_t new_bits =
+              visit_next[n].load(std::memory_order_relaxed) & ~seen[n];
+          visit_next[n].store(0, std::memory_order_relaxed);
+          visit[n] = new_bits;
+          if (new_bits == 0) {
+            return;
+          }
+          seen[n] |= new_bits;
+          active += 1;
+          do {
+            const int i = __builtin_ctzll(new_bits);
+            (*distances)[n * num_sources + batch_begin + i] = level;
+            new_bits &= new_bits - 1;
+          } while (new_bits != 0);
+        },
+        katana::loopname("MultiSourceBfsUpdate"));
+
+    if (active.reduce() == 0) {
+      break;
+    }
+  }
+}
+
 }  // namespace
 
 katana::Result<void>
@@ -474,6 +452,40 @@ katana::analytics::Bfs(
   return BfsImpl(&graph, bidir_view, start_node, algo);
 }
 
+katana::Result<void>
+katana::analytics::MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    NUMAArray<uint32_t>* distances) {
+  const size_t num_nodes = pg->num_nodes();
+  for (uint32_t source : sources) {
+    if (source >= num_nodes) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "source {} is not in the graph",
+          source);
+    }
+  }
+
+  distances->allocateInterleaved(num_nodes * sources.size());
+  katana::ParallelSTL::fill(
+      distances->begin(), distances->end(), kBfsUnreachable);
+
+  // three 8-byte visitation words per node, plus the distance matrix
+  katana::EnsurePreallocated(
+      8, 24 * num_nodes + 4 * num_nodes * sources.size());
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::StatTimer exec_time("MultiSourceBfs");
+  exec_time.start();
+  for (size_t begin = 0; begin < sources.size(); begin += 64) {
+    const size_t batch_size = std::min<size_t>(64, sources.size() - begin);
+    MultiSourceBfsBatch(
+        pg->topology(), sources, begin, batch_size, sources.size(), distances);
+  }
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
 template <typename LevelVec>
 void
 ComputeLevels(
@@ -0,0 +1,666 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/bipart/bipart.h"
+
+#include <cmath>
+#include <set>
+
+#include "bipart_impl.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using namespace katana::analytics::bipart;
+
+struct NodePartition : public katana::PODProperty<uint32_t> {};
+
+using PropGraph =
+    katana::TypedPropertyGraph<std::tuple<NodePartition>, std::tuple<>>;
+
+/// Interpret the bipartite hyperedge encoding of pg as a hypergraph: the
+/// leading nodes with out-edges are the hyperedges and their destinations are
+/// the member nodes.
+katana::Result<void>
+BuildMetisGraph(const katana::PropertyGraph& pg, MetisGraph* metis_graph) {
+  const katana::GraphTopology& topo = pg.topology();
+  uint32_t total_num_nodes = topo.num_nodes();
+  uint64_t num_fedges = topo.num_edges();
+
+  uint32_t num_hedges{0};
+  while (num_hedges < total_num_nodes && topo.degree(num_hedges) > 0) {
+    num_hedges++;
+  }
+
+  if (num_hedges == 0 || num_hedges == total_num_nodes) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "graph is not a bipartite hyperedge encoding: it must contain both "
+        "hyperedges and member nodes");
+  }
+
+  katana::GAccumulator<uint64_t> num_invalid;
+  katana::do_all(
+      katana::iterate(num_hedges, total_num_nodes),
+      [&](uint32_t n) {
+        if (topo.degree(n) > 0) {
+          num_invalid += 1;
+        }
+      },
+      katana::loopname("Bipart-Validate-MemberNodes"));
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hedges),
+      [&](uint32_t hedge) {
+        for (auto e : topo.edges(hedge)) {
+          if (topo.edge_dest(e) < num_hedges) {
+            num_invalid += 1;
+          }
+        }
+      },
+      katana::steal(), katana::loopname("Bipart-Validate-HEdges"));
+  if (num_invalid.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "graph is not a bipartite hyperedge encoding: hyperedges must "
+        "precede their member nodes and member nodes may not have out-edges");
+  }
+
+  HyperGraph* graph = &metis_graph->graph;
+  EdgeDstVecTy edges_id(total_num_nodes);
+  NUMAArrayUint64Ty prefix_edges;
+  prefix_edges.allocateInterleaved(total_num_nodes);
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, total_num_nodes),
+      [&](uint32_t n) {
+        for (auto e : topo.edges(n)) {
+          edges_id[n].push_back(topo.edge_dest(e));
+        }
+        prefix_edges[n] = edges_id[n].size();
+      },
+      katana::steal(), katana::loopname("Bipart-Build-HyperGraph"));
+
+  katana::ParallelSTL::partial_sum(
+      prefix_edges.begin(), prefix_edges.end(), prefix_edges.begin());
+
+  graph->constructFrom(
+      total_num_nodes, num_fedges, std::move(prefix_edges), edges_id);
+  graph->SetHedges(num_hedges);
+  graph->SetHnodes(total_num_nodes - num_hedges);
+  InitNodes(graph, num_hedges);
+
+  return katana::ResultSuccess();
+}
+
+/**
+ * Main Partitioning function for creating bi-partitions for all
+ * graphs at a given level of the k-way recursion tree
+ *
+ * @param metis_graphs Vector containing metis graphs
+ * @param max_coarsen_level Maximum number of coarsening levels allowed
+ * @param matching_policy Matching policy used during coarsening
+ * @param target_partitions Vector containing target number of partitions for
+ * each of the graphs in the specified param metis_graphs
+ */
+void
+Partition(
+    std::vector<MetisGraph*>* metis_graphs, const uint32_t max_coarsen_level,
+    const BipartPlan::MatchingPolicy matching_policy,
+    const std::vector<uint32_t>& target_partitions) {
+  KATANA_LOG_DEBUG_ASSERT(metis_graphs->size() == target_partitions.size());
+  katana::StatTimer exec_timer("Total-Partition");
+  exec_timer.start();
+
+  katana::StatTimer timer_coarsing("Total-Coarsening");
+  timer_coarsing.start();
+  Coarsen(metis_graphs, max_coarsen_level, matching_policy);
+  timer_coarsing.stop();
+
+  katana::StatTimer timer_partitioning("Total-Partitioning-CoarsestGraph");
+  timer_partitioning.start();
+  PartitionCoarsestGraphs(*metis_graphs, target_partitions);
+  timer_partitioning.stop();
+
+  katana::StatTimer timer_refining("Total-Refining");
+  timer_refining.start();
+  Refine(metis_graphs);
+  timer_refining.stop();
+
+  exec_timer.stop();
+}
+
+/**
+ * Assigns a partition to each hyperedge based on the current partitioning
+ * assignment of the nodes.
+ *
+ * @param graph Graph
+ * @param num_hedges Number of hyperedges in the specified param graph
+ */
+void
+SetCompleteHEdgePartition(HyperGraph* graph, const uint32_t num_hedges) {
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hedges),
+      [&](uint32_t hedge) {
+        auto f_edge = *(graph->edges(hedge).begin());
+        GNode f_dst = graph->getEdgeDst(f_edge);
+        uint32_t f_partition = graph->getData(f_dst).partition;
+        bool flag{true};
+
+        for (auto& fedge : graph->edges(hedge)) {
+          GNode dst = graph->getEdgeDst(fedge);
+          uint32_t partition = graph->getData(dst).partition;
+
+          if (partition != f_partition) {
+            flag = false;
+            break;
+          }
+        }
+        // The `flag` would be false if any member node
+        // of the hyperedge are in the different partitions.
+        // If the `flag` is true, then the current hedge is still
+        // valid and partitionable.
+
+        uint32_t h_partition{0};
+        if (flag) {
+          h_partition = f_partition;
+        } else {
+          h_partition = kInfPartition;
+        }
+
+        graph->getData(hedge).partition = h_partition;
+      },
+      katana::steal(), katana::loopname("Set-CompleteHEdge-Partition"));
+}
+
+/**
+ * Assigns an id to the nodes and hyperedges in each child partition
+ *
+ * @param current_level_indices Set containing indexes of current
+ * child partitions
+ * @param mem_nodes_of_parts Vector of InsertBags containing nodes for
+ * each child partition
+ * @param mem_hedges_of_parts Vector of InsertBags containing hyperedges for
+ * each child partition
+ * @param hnodes_bag InsertBag of pair of the partition index and
+ * the node's child id, for each node
+ * @param hedges_bag InsertBag of pair of the partition index and
+ * the hyperedges's child id, for each node
+ * @param graph Graph
+ */
+void
+SetChildID(
+    const std::set<uint32_t>& current_level_indices,
+    const std::vector<katana::InsertBag<GNode>>& mem_nodes_of_parts,
+    const std::vector<katana::InsertBag<GNode>>& mem_hedges_of_parts,
+    katana::InsertBag<std::pair<uint32_t, uint32_t>>* hnodes_bag,
+    katana::InsertBag<std::pair<uint32_t, uint32_t>>* hedges_bag,
+    HyperGraph* graph) {
+  katana::do_all(
+      katana::iterate(current_level_indices),
+      [&](uint32_t i) {
+        uint32_t ed = 0;
+        for (GNode h : mem_hedges_of_parts[i]) {
+          graph->getData(h).child_id = ed++;
+        }
+
+        uint32_t id = ed;
+        // <partition no, # of member hedges>.
+        hedges_bag->emplace(std::make_pair(i, ed));
+
+        for (GNode n : mem_nodes_of_parts[i]) {
+          graph->getData(n).child_id = id++;
+        }
+        // <partition no, # of member nodes>.
+        hnodes_bag->emplace(std::make_pair(i, id - ed));
+      },
+      katana::steal(), katana::loopname("Set-Child-IDs"));
+}
+
+void
+ConstructNewGraph(
+    const std::set<uint32_t>& current_level_indices,
+    const std::vector<uint32_t>& pgraph_index,
+    const std::vector<uint32_t>& num_hnodes_per_partition,
+    const std::vector<uint32_t>& num_hedges_per_partition,
+    const uint32_t num_hedges, HyperGraph* graph,
+    const std::vector<HyperGraph*>& gr) {
+  uint32_t num_cur_partitions = gr.size();
+  std::vector<katana::gstl::Vector<katana::PODVector<uint32_t>>> edges_ids(
+      num_cur_partitions);
+  std::vector<NUMAArrayUint64Ty> edges_prefixsum(num_cur_partitions);
+
+  for (uint32_t i : current_level_indices) {
+    uint32_t index = pgraph_index[i];
+    uint32_t total_nodes =
+        num_hedges_per_partition[index] + num_hnodes_per_partition[index];
+    edges_ids[index].resize(total_nodes);
+    edges_prefixsum[index].allocateInterleaved(total_nodes);
+  }
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hedges),
+      [&](GNode src) {
+        MetisNode& src_node = graph->getData(src);
+        uint32_t partition = src_node.partition;
+        if (partition == kInfPartition) {
+          return;
+        }
+        uint32_t index = pgraph_index[partition];
+        GNode slot_id = src_node.child_id;
+
+        for (auto& e : graph->edges(src)) {
+          GNode dst = graph->getEdgeDst(e);
+          GNode dst_slot_id = graph->getData(dst).child_id;
+          edges_ids[index][slot_id].push_back(dst_slot_id);
+        }
+      },
+      katana::steal(), katana::chunk_size<kChunkSize>(),
+      katana::loopname("Build-EdgeIds"));
+
+  std::vector<katana::GAccumulator<uint64_t>> num_edges_acc(num_cur_partitions);
+
+  for (uint32_t i : current_level_indices) {
+    uint32_t index = pgraph_index[i];
+    for (uint32_t c = 0; c < num_hedges_per_partition[index]; c++) {
+      edges_prefixsum[index][c] = edges_ids[index][c].size();
+      num_edges_acc[index] += edges_prefixsum[index][c];
+    }
+  }
+
+  for (uint32_t i : current_level_indices) {
+    uint32_t index = pgraph_index[i];
+    HyperGraph* cur_graph = gr[index];
+    if (cur_graph == nullptr) {
+      continue;
+    }
+    uint64_t edges = num_edges_acc[index].reduce();
+    uint32_t ipart_num_nodes =
+        num_hedges_per_partition[index] + num_hnodes_per_partition[index];
+    for (uint32_t c = 1; c < ipart_num_nodes; ++c) {
+      edges_prefixsum[index][c] += edges_prefixsum[index][c - 1];
+    }
+
+    cur_graph->constructFrom(
+        ipart_num_nodes, edges, std::move(edges_prefixsum[index]),
+        edges_ids[index]);
+    cur_graph->SetHedges(num_hedges_per_partition[index]);
+    cur_graph->SetHnodes(num_hnodes_per_partition[index]);
+  }
+
+  for (uint32_t i : current_level_indices) {
+    uint32_t index = pgraph_index[i];
+    HyperGraph* cur_graph = gr[index];
+    if (cur_graph == nullptr) {
+      continue;
+    }
+    InitNodes(cur_graph, cur_graph->GetHedges());
+  }
+}
+
+void
+UpdateGraphTree(
+    const std::set<uint32_t>& current_level_indices,
+    const std::vector<uint32_t>& pgraph_index,
+    const std::vector<MetisGraph*>& metis_graph_vec) {
+  for (uint32_t i : current_level_indices) {
+    uint32_t index = pgraph_index[i];
+    MetisGraph* mcg = metis_graph_vec[index];
+
+    if (mcg == nullptr) {
+      continue;
+    }
+
+    while (mcg->coarsened_graph != nullptr) {
+      mcg = mcg->coarsened_graph;
+    }
+
+    while (mcg->parent_graph != nullptr &&
+           mcg->parent_graph->parent_graph != nullptr) {
+      mcg = mcg->parent_graph;
+      delete mcg->coarsened_graph;
+    }
+  }
+}
+
+void
+PostReassignPartition(
+    std::vector<uint32_t>* to_process_partitions,
+    const std::set<uint32_t>& current_level_indices,
+    std::set<uint32_t>* next_level_indices,
+    const std::vector<katana::InsertBag<GNode>>& mem_nodes_of_parts,
+    const std::vector<uint32_t>& pgraph_index, HyperGraph* graph,
+    const std::vector<HyperGraph*>& gr) {
+  for (const uint32_t i : current_level_indices) {
+    uint32_t tmp = to_process_partitions->at(i);
+    // A partition that does not need to be subdivided further carries over
+    // unchanged; its nodes keep their current assignment.
+    if (tmp <= 1) {
+      next_level_indices->insert(i);
+      continue;
+    }
+    uint32_t second_partition = (tmp + 1) / 2;
+    to_process_partitions->at(i) = second_partition;
+    to_process_partitions->at(i + second_partition) = (tmp) / 2;
+    next_level_indices->insert(i);
+    next_level_indices->insert(i + second_partition);
+
+    katana::do_all(
+        katana::iterate(mem_nodes_of_parts[i]),
+        [&](GNode src) {
+          MetisNode& src_data = graph->getData(src);
+          GNode n = src_data.child_id;
+          uint32_t partition = gr[pgraph_index[i]]->getData(n).partition;
+          if (partition == 0) {
+            src_data.partition = i;
+          } else if (partition == 1) {
+            src_data.partition = i + second_partition;
+          }
+        },
+        katana::loopname("Reassign-Partition"));
+  }
+}
+
+/**
+ * Create k partitions
+ *
+ * @param metis_graph Metis graph representing the original input graph
+ * @param num_partitions Number of partitions to create
+ * @param plan Matching policy and coarsening level limit
+ */
+void
+CreateKPartitions(
+    MetisGraph* metis_graph, const uint32_t num_partitions,
+    const BipartPlan plan) {
+  katana::StatTimer initial_partition_timer("Initial-Partition");
+  katana::StatTimer intermediate_partition_timer("Intermediate-Partition");
+  katana::StatTimer update_graphtree_timer("Update-GraphTree");
+  HyperGraph* graph = &metis_graph->graph;
+  uint32_t total_num_nodes = graph->size();
+  uint32_t num_hedges = graph->GetHedges();
+  std::vector<MetisGraph*> metis_graphs;
+  metis_graphs.push_back(metis_graph);
+
+  // Number of partitions to create.
+  std::vector<uint32_t> partitions_list;
+  partitions_list.push_back(num_partitions);
+
+  initial_partition_timer.start();
+  // Initial partitioning into two cgraphs.
+  Partition(
+      &metis_graphs, plan.max_coarsen_level(), plan.matching_policy(),
+      partitions_list);
+  initial_partition_timer.stop();
+
+  // Calculate number of iterations/levels required.
+  uint32_t num_levels = log2(static_cast<float>(num_partitions));
+  std::vector<uint32_t> to_process_partitions(num_partitions, 0);
+
+  uint32_t second_partition = (num_partitions + 1) / 2;
+  to_process_partitions[0] = second_partition;
+  to_process_partitions[second_partition] = num_partitions / 2;
+
+  katana::do_all(
+      katana::iterate(num_hedges, total_num_nodes),
+      [&](uint32_t n) {
+        MetisNode& node = graph->getData(n);
+        uint32_t partition_of_node = node.partition;
+        // Change the second partition as the middle.
+        if (partition_of_node == 1) {
+          node.partition = second_partition;
+        }
+      },
+      katana::loopname("Initial-Assign-Partition"));
+
+  std::set<uint32_t> current_level_indices;
+  std::set<uint32_t> next_level_indices;
+  current_level_indices.insert(0);
+  current_level_indices.insert(second_partition);
+
+  std::vector<katana::InsertBag<GNode>> mem_nodes_of_parts;
+  std::vector<katana::InsertBag<GNode>> mem_hedges_of_parts;
+  mem_nodes_of_parts.resize(num_partitions);
+  mem_hedges_of_parts.resize(num_partitions);
+
+  std::vector<uint32_t> pgraph_index;
+  pgraph_index.resize(num_partitions);
+
+  for (uint32_t level = 1; level < num_levels; level++) {
+    for (uint32_t i = 0; i < num_partitions; i++) {
+      mem_nodes_of_parts[i].clear();
+      mem_hedges_of_parts[i].clear();
+    }
+
+    // Assign index to each subgraph of the partitions.
+    // Note that pgraph_index does not need to be reset.
+    // It is always overwritten by the new index values.
+    uint32_t index{0};
+    for (uint32_t i : current_level_indices) {
+      pgraph_index[i] = index++;
+    }
+
+    for (uint32_t n = num_hedges; n < total_num_nodes; n++) {
+      MetisNode& node = graph->getData(n);
+      uint32_t partition = node.partition;
+      mem_nodes_of_parts[partition].emplace(n);
+      // Assign graph index.
+      node.graph_index = pgraph_index[partition];
+    }
+
+    // 1): Graph index of the nodes is assigned.
+
+    SetCompleteHEdgePartition(graph, num_hedges);
+
+    // 2): Candidate partitions of the hedges is assigned.
+
+    for (uint32_t h = 0; h < num_hedges; h++) {
+      uint32_t partition = graph->getData(h).partition;
+      if (partition != kInfPartition) {
+        mem_hedges_of_parts[partition].emplace(h);
+        graph->getData(h).graph_index = pgraph_index[partition];
+      }
+    }
+
+    // 3): Graph indices of the hedges are assigned.
+
+    // The currently processed number of partitions.
+    uint32_t num_cur_partitions = current_level_indices.size();
+    std::vector<MetisGraph*> metis_graph_vec(num_cur_partitions);
+    std::vector<HyperGraph*> gr(num_cur_partitions);
+    std::vector<uint32_t> target_partitions(num_cur_partitions);
+
+    std::vector<uint32_t> num_hedges_per_partition(num_cur_partitions);
+    std::vector<uint32_t> num_hnodes_per_partition(num_cur_partitions);
+
+    katana::InsertBag<std::pair<uint32_t, uint32_t>> hedges_bag;
+    katana::InsertBag<std::pair<uint32_t, uint32_t>> hnodes_bag;
+
+    for (uint32_t i : current_level_indices) {
+      if (to_process_partitions[i] > 1) {
+        uint32_t index = pgraph_index[i];
+        metis_graph_vec[index] = new MetisGraph();
+        gr[index] = &metis_graph_vec[index]->graph;
+      }
+    }
+
+    SetChildID(
+        current_level_indices, mem_nodes_of_parts, mem_hedges_of_parts,
+        &hnodes_bag, &hedges_bag, graph);
+
+    // 4): Assign slot id for hyper edge and its member nodes.
+
+    for (auto& pair : hedges_bag) {
+      num_hedges_per_partition[pgraph_index[pair.first]] = pair.second;
+    }
+
+    for (auto& pair : hnodes_bag) {
+      num_hnodes_per_partition[pgraph_index[pair.first]] = pair.second;
+    }
+
+    ConstructNewGraph(
+        current_level_indices, pgraph_index, num_hnodes_per_partition,
+        num_hedges_per_partition, num_hedges, graph, gr);
+
+    for (uint32_t i : current_level_indices) {
+      target_partitions[pgraph_index[i]] = to_process_partitions[i];
+    }
+
+    intermediate_partition_timer.start();
+    Partition(
+        &metis_graph_vec, plan.max_coarsen_level(), plan.matching_policy(),
+        target_partitions);
+    intermediate_partition_timer.stop();
+
+    update_graphtree_timer.start();
+    UpdateGraphTree(current_level_indices, pgraph_index, metis_graph_vec);
+    update_graphtree_timer.stop();
+
+    PostReassignPartition(
+        &to_process_partitions, current_level_indices, &next_level_indices,
+        mem_nodes_of_parts, pgraph_index, graph, gr);
+
+    for (uint32_t i : current_level_indices) {
+      MetisGraph* mcg = metis_graph_vec[pgraph_index[i]];
+      delete mcg;
+    }
+
+    current_level_indices = next_level_indices;
+    next_level_indices.clear();
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Bipart(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_property_name, BipartPlan plan) {
+  if (num_partitions == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "number of partitions must be positive: {}", num_partitions);
+  }
+
+  MetisGraph metis_graph;
+  KATANA_CHECKED(BuildMetisGraph(*pg, &metis_graph));
+  HyperGraph* graph = &metis_graph.graph;
+
+  katana::EnsurePreallocated(4, 8 * (pg->num_nodes() + pg->num_edges()));
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::StatTimer exec_time("Bipart");
+  exec_time.start();
+  if (num_partitions > 1) {
+    CreateKPartitions(&metis_graph, num_partitions, plan);
+  }
+  // Assign each hyperedge the partition of its member nodes, or mark it as
+  // cut if they disagree.
+  SetCompleteHEdgePartition(graph, graph->GetHedges());
+  exec_time.stop();
+
+  page_alloc.Report();
+
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<NodePartition>>(
+      pg, {output_property_name}));
+  PropGraph result_graph =
+      KATANA_CHECKED(PropGraph::Make(pg, {output_property_name}, {}));
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, static_cast<uint32_t>(graph->size())),
+      [&](uint32_t n) {
+        result_graph.GetData<NodePartition>(n) = graph->getData(n).partition;
+      },
+      katana::loopname("Bipart-Write-Partitions"));
+
+  return katana::ResultSuccess();
+}
+
+void
+katana::analytics::BipartStatistics::Print(std::ostream& os) const {
+  os << "Number of partitions = " << number_of_partitions << std::endl;
+  os << "Cut hyperedges = " << cut_hyperedges << std::endl;
+  os << "Largest partition size = " << largest_partition_size << std::endl;
+  os << "Smallest partition size = " << smallest_partition_size << std::endl;
+}
+
+katana::Result<katana::analytics::BipartStatistics>
+katana::analytics::BipartStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto partitions =
+      KATANA_CHECKED(pg->GetNodePropertyTyped<uint32_t>(property_name));
+  const katana::GraphTopology& topo = pg->topology();
+  uint32_t total_num_nodes = topo.num_nodes();
+
+  uint32_t num_hedges{0};
+  while (num_hedges < total_num_nodes && topo.degree(num_hedges) > 0) {
+    num_hedges++;
+  }
+
+  katana::GAccumulator<uint32_t> cut_hedges;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hedges),
+      [&](uint32_t hedge) {
+        auto edges = topo.edges(hedge);
+        uint32_t first_partition =
+            partitions->Value(topo.edge_dest(*edges.begin()));
+        for (auto e : edges) {
+          if (partitions->Value(topo.edge_dest(e)) != first_partition) {
+            cut_hedges += 1;
+            break;
+          }
+        }
+      },
+      katana::steal(), katana::loopname("Bipart-Compute-CutSize"));
+
+  katana::GReduceMax<uint32_t> max_partition;
+  katana::do_all(
+      katana::iterate(num_hedges, total_num_nodes),
+      [&](uint32_t n) { max_partition.update(partitions->Value(n)); },
+      katana::loopname("Bipart-Max-Partition"));
+
+  katana::NUMAArray<std::atomic<uint32_t>> partition_sizes;
+  partition_sizes.allocateInterleaved(max_partition.reduce() + 1);
+  katana::do_all(
+      katana::iterate(num_hedges, total_num_nodes),
+      [&](uint32_t n) {
+        partition_sizes[partitions->Value(n)].fetch_add(
+            1, std::memory_order_relaxed);
+      },
+      katana::loopname("Bipart-Partition-Sizes"));
+
+  uint32_t number_of_partitions{0};
+  uint32_t largest{0};
+  uint32_t smallest{std::numeric_limits<uint32_t>::max()};
+  for (std::atomic<uint32_t>& size : partition_sizes) {
+    uint32_t partition_size = size.load(std::memory_order_relaxed);
+    if (partition_size == 0) {
+      continue;
+    }
+    number_of_partitions++;
+    largest = std::max(largest, partition_size);
+    smallest = std::min(smallest, partition_size);
+  }
+
+  return BipartStatistics{
+      number_of_partitions, cut_hedges.reduce(), largest, smallest};
+}
@@ -0,0 +1,333 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "bipart_impl.h"
+#include "katana/PerThreadStorage.h"
+
+namespace katana::analytics::bipart {
+
+/**
+ * Initialize the nodes in the graph
+ *
+ * @param graph Graph
+ * @param num_hedges Number of hyperedges in the specified param graph
+ */
+void
+InitNodes(HyperGraph* graph, const uint32_t num_hedges) {
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](GNode n) {
+        MetisNode& node = graph->getData(n);
+        NetnumTy max_netnum = std::numeric_limits<NetnumTy>::max();
+        NetvalTy max_netval = std::numeric_limits<NetvalTy>::max();
+        // only hyper edge has its own indices.
+        node.netnum = (n < num_hedges) ? (n + 1) : max_netnum;
+        node.netrand = max_netval;
+        node.netval = max_netval;
+        node.node_id = n + 1;  ///< all nodes/hedges have indices.
+        node.graph_index = 0;
+        node.InitRefine();  ///< partition <- 0, bound <- true.
+      },
+      katana::loopname("Init-Nodes"));
+}
+
+/**
+ * Constructs a concatenated list of the hyperedges and nodes
+ *
+ * @param metis_graphs  Vector containing metis graphs
+ * @param combined_edge_list Vector of concatenated list of the hyperedges
+ * that needs to be constructed
+ * @param combined_node_list Vector of concatenated list of the nodes
+ * that needs to be constructed
+ */
+void
+ConstructCombinedLists(
+    const std::vector<MetisGraph*>& metis_graphs,
+    std::vector<std::pair<uint32_t, uint32_t>>* combined_edge_list,
+    std::vector<std::pair<uint32_t, uint32_t>>* combined_node_list) {
+  uint32_t edge_index{0};
+  uint32_t node_index{0};
+  uint32_t num_partitions = metis_graphs.size();
+
+  for (uint32_t i = 0; i < num_partitions; i++) {
+    if (metis_graphs[i] != nullptr) {
+      HyperGraph& g = (metis_graphs[i]->graph);
+      uint32_t num_hedges = g.GetHedges();
+
+      for (GNode n = 0; n < num_hedges; n++) {
+        combined_edge_list->at(edge_index) = std::make_pair(n, i);
+        edge_index++;
+      }
+      for (GNode n = num_hedges; n < static_cast<GNode>(g.size()); n++) {
+        combined_node_list->at(node_index) = std::make_pair(n, i);
+        node_index++;
+      }
+    }
+  }
+}
+
+/**
+ * Priority assinging functions.
+ */
+void
+PrioritizeHigherDegree(GNode node, HyperGraph* fine_graph) {
+  NetvalTy num_edges =
+      std::distance(fine_graph->edge_begin(node), fine_graph->edge_end(node));
+  fine_graph->getData(node).netval = -num_edges;
+}
+void
+PrioritizeRandom(GNode node, HyperGraph* fine_graph) {
+  MetisNode& node_data = fine_graph->getData(node);
+
+  node_data.netval = -node_data.netrand;
+  node_data.netrand = -node_data.netnum;
+}
+void
+PrioritizeLowerDegree(GNode node, HyperGraph* fine_graph) {
+  NetvalTy num_edges =
+      std::distance(fine_graph->edge_begin(node), fine_graph->edge_end(node));
+  fine_graph->getData(node).netval = num_edges;
+}
+void
+PrioritizeHigherWeight(GNode node, HyperGraph* fine_graph) {
+  WeightTy w = 0;
+  for (auto& e : fine_graph->edges(node)) {
+    GNode dst = fine_graph->getEdgeDst(e);
+    w += fine_graph->getData(dst).weight;
+  }
+  fine_graph->getData(node).netval = -w;
+}
+void
+PrioritizeDegree(GNode node, HyperGraph* fine_graph) {
+  WeightTy w = 0;
+  for (auto& e : fine_graph->edges(node)) {
+    GNode dst = fine_graph->getEdgeDst(e);
+    w += fine_graph->getData(dst).weight;
+  }
+  fine_graph->getData(node).netval = w;
+}
+
+void
+SortNodesByGainAndWeight(
+    HyperGraph* graph, std::vector<GNode>* nodes, uint32_t end_offset) {
+  auto end_iter =
+      (end_offset == 0) ? nodes->end() : nodes->begin() + end_offset;
+  std::sort(nodes->begin(), end_iter, [&graph](GNode& l_opr, GNode& r_opr) {
+    MetisNode& l_data = graph->getData(l_opr);
+    MetisNode& r_data = graph->getData(r_opr);
+    float l_gain = l_data.GetGain();
+    float r_gain = r_data.GetGain();
+    float l_weight = l_data.weight;
+    float r_weight = r_data.weight;
+    float l_cost = l_gain / l_weight;
+    float r_cost = r_gain / r_weight;
+
+    if (fabs(l_cost - r_cost) < 0.00001f) {
+      uint32_t l_nid = l_data.node_id;
+      uint32_t r_nid = r_data.node_id;
+
+      return l_nid < r_nid;
+    }
+
+    return l_cost > r_cost;
+  });
+}
+
+void
+InitGain(HyperGraph* g) {
+  uint32_t num_hedges = g->GetHedges();
+  uint32_t size_graph = static_cast<uint32_t>(g->size());
+
+  katana::do_all(
+      katana::iterate(num_hedges, size_graph),
+      [&](uint32_t n) {
+        MetisNode& node = g->getData(n);
+        node.positive_gain = 0;
+        node.negative_gain = 0;
+      },
+      katana::loopname("Init-Gains"));
+
+  typedef std::vector<GainTy> LocalGainVector;
+  katana::PerThreadStorage<LocalGainVector> thread_local_gain_vector;
+
+  uint32_t num_threads = katana::getActiveThreads();
+  uint32_t subvec_size = size_graph - num_hedges;
+
+  katana::do_all(katana::iterate(uint32_t{0}, num_threads), [&](uint32_t i) {
+    thread_local_gain_vector.getRemote(i)->resize(subvec_size, 0);
+  });
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hedges),
+      [&](uint32_t n) {
+        uint32_t num_p0_nodes{0}, num_p1_nodes{0};
+        for (auto& fedge : g->edges(n)) {
+          GNode node = g->getEdgeDst(fedge);
+          if (g->getData(node).partition == 0) {
+            ++num_p0_nodes;
+          } else {
+            ++num_p1_nodes;
+          }
+
+          if (num_p0_nodes > 1 && num_p1_nodes > 1) {
+            break;
+          }
+        }
+
+        LocalGainVector& gain_vector = *(thread_local_gain_vector.getLocal());
+
+        // --> p1 = 1 or 0/ p2 = 1 or 0
+        if (!(num_p0_nodes > 1 && num_p1_nodes > 1) &&
+            (num_p0_nodes + num_p1_nodes > 1)) {
+          for (auto& fedge : g->edges(n)) {
+            GNode node = g->getEdgeDst(fedge);
+            MetisNode& node_data = g->getData(node);
+            uint32_t part = node_data.partition;
+            uint32_t nodep = (part == 0) ? num_p0_nodes : num_p1_nodes;
+            if (nodep == 1) {
+              gain_vector[node - num_hedges] += 1;
+            }
+            // It means that one of p1 or p2 is zero.
+            if (nodep == (num_p0_nodes + num_p1_nodes)) {
+              gain_vector[node - num_hedges] -= 1;
+            }
+          }
+        }
+      },
+      katana::steal(), katana::loopname("Calculate-Gains"));
+
+  katana::do_all(
+      katana::iterate(num_hedges, size_graph),
+      [&](GNode n) {
+        GainTy gain{0};
+        uint32_t index_n = n - num_hedges;
+        for (uint32_t i = 0; i < num_threads; i++) {
+          gain += (*(thread_local_gain_vector.getRemote(i)))[index_n];
+        }
+
+        g->getData(n).positive_gain = gain;
+      },
+      katana::loopname("Reduce-Gains"));
+}
+
+void
+InitGain(
+    const std::vector<std::pair<uint32_t, uint32_t>>& combined_edgelist,
+    const std::vector<std::pair<uint32_t, uint32_t>>& combined_nodelist,
+    const std::vector<HyperGraph*>& g) {
+  uint32_t total_nodes = combined_nodelist.size();
+  uint32_t total_hedges = combined_edgelist.size();
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, total_nodes),
+      [&](uint32_t n) {
+        auto node_index_pair = combined_nodelist[n];
+        GNode node_id = node_index_pair.first;
+        uint32_t index = node_index_pair.second;
+        MetisNode& node_data = g[index]->getData(node_id);
+        node_data.positive_gain = 0;
+        node_data.negative_gain = 0;
+        node_data.list_index = n;
+      },
+      katana::loopname("Init-Gains"));
+
+  typedef std::vector<GainTy> LocalGainVector;
+  katana::PerThreadStorage<LocalGainVector> thread_local_positive_gain_vector;
+  katana::PerThreadStorage<LocalGainVector> thread_local_negative_gain_vector;
+
+  uint32_t num_threads = katana::getActiveThreads();
+
+  katana::do_all(katana::iterate(uint32_t{0}, num_threads), [&](uint32_t i) {
+    thread_local_positive_gain_vector.getRemote(i)->resize(total_nodes, 0);
+    thread_local_negative_gain_vector.getRemote(i)->resize(total_nodes, 0);
+  });
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, total_hedges),
+      [&](uint32_t n) {
+        auto hedge_index_pair = combined_edgelist[n];
+        GNode node_id = hedge_index_pair.first;
+        uint32_t index = hedge_index_pair.second;
+        HyperGraph& graph = *g[index];
+        uint32_t num_p0_nodes{0}, num_p1_nodes{0};
+
+        for (auto& fedge : graph.edges(node_id)) {
+          GNode node = graph.getEdgeDst(fedge);
+          if (graph.getData(node).partition == 0) {
+            ++num_p0_nodes;
+          } else {
+            ++num_p1_nodes;
+          }
+
+          if (num_p0_nodes > 1 && num_p1_nodes > 1) {
+            break;
+          }
+        }
+
+        LocalGainVector& positive_gain_vector =
+            *(thread_local_positive_gain_vector.getLocal());
+        LocalGainVector& negative_gain_vector =
+            *(thread_local_negative_gain_vector.getLocal());
+
+        // --> p1 = 1 or 0/ p2 = 1 or 0
+        if (!(num_p0_nodes > 1 && num_p1_nodes > 1) &&
+            (num_p0_nodes + num_p1_nodes > 1)) {
+          for (auto& fedge : graph.edges(node_id)) {
+            GNode dst_id = graph.getEdgeDst(fedge);
+            MetisNode& node_data = graph.getData(dst_id);
+            uint32_t part = node_data.partition;
+            uint32_t nodep = (part == 0) ? num_p0_nodes : num_p1_nodes;
+            uint32_t list_index = node_data.list_index;
+
+            if (nodep == 1) {
+              positive_gain_vector[list_index] += 1;
+            }
+            if (nodep == (num_p0_nodes + num_p1_nodes)) {
+              // it means that one of p1 or p2 is zero.
+              negative_gain_vector[list_index] += 1;
+            }
+          }
+        }
+      },
+      katana::steal(), katana::loopname("Calculate-Gains"));
+
+  katana::do_all(
+      katana::iterate(uint32_t{0}, total_nodes),
+      [&](uint32_t n) {
+        GainTy positive_gain{0};
+        GainTy negative_gain{0};
+
+        for (uint32_t i = 0; i < num_threads; i++) {
+          positive_gain +=
+              (*(thread_local_positive_gain_vector.getRemote(i)))[n];
+          negative_gain +=
+              (*(thread_local_negative_gain_vector.getRemote(i)))[n];
+        }
+
+        auto node_index_pair = combined_nodelist[n];
+        GNode node_id = node_index_pair.first;
+        uint32_t index = node_index_pair.second;
+        MetisNode& node_data = g[index]->getData(node_id);
+        node_data.positive_gain = positive_gain;
+        node_data.negative_gain = negative_gain;
+      },
+      katana::loopname("Reduce-Gains"));
+}
+
+}  // namespace katana::analytics::bipart
@@ -20,6 +20,8 @@
 #include "katana/analytics/connected_components/connected_components.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/FrontierEngine.h"
+#include "katana/OutOfCorePropertyGraph.h"
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -28,7 +30,6 @@ const int ConnectedComponentsPlan::kChunkSize = 1;
 
 namespace {
 
-const unsigned int kInfinity = std::numeric_limits<unsigned int>::max();
 struct ConnectedComponentsNode
     : public katana::UnionFindNode<ConnectedComponentsNode> {
   using ComponentType = ConnectedComponentsNode*;
@@ -99,49 +100,56 @@ struct ConnectedComponentsLabelPropAlgo {
 
   using NodeData = std::tuple<NodeComponent>;
   using EdgeData = std::tuple<>;
-  typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+  typedef katana::TypedPropertyGraphView<
+      katana::PropertyGraphViews::BiDirectional, NodeData, EdgeData>
+      Graph;
   typedef typename Graph::Node GNode;
 
-  katana::NUMAArray<ComponentType> old_component_;
   ConnectedComponentsPlan& plan_;
   ConnectedComponentsLabelPropAlgo(ConnectedComponentsPlan& plan)
       : plan_(plan) {}
 
   void Initialize(Graph* graph) {
-    old_component_.allocateBlocked(graph->size());
     katana::do_all(katana::iterate(*graph), [&](const GNode& node) {
       graph->GetData<NodeComponent>(node).store(node);
-      old_component_[node] = kInfinity;
     });
   }
 
   void Deallocate(Graph*) {}
 
   void operator()(Graph* graph) {
-    katana::GReduceLogicalOr changed;
-    do {
-      changed.reset();
-      katana::do_all(
-          katana::iterate(*graph),
-          [&](const GNode& src) {
-            auto& sdata_current_comp = graph->GetData<NodeComponent>(src);
-            auto& sdata_old_comp = old_component_[src];
-            if (sdata_old_comp > sdata_current_comp) {
-              sdata_old_comp = sdata_current_comp;
-
-              changed.update(true);
-
-              for (auto e : graph->edges(src)) {
-                auto dest = graph->GetEdgeDest(e);
-                auto& ddata_current_comp = graph->GetData<NodeComponent>(dest);
-                ComponentType label_new = sdata_current_comp;
-                katana::atomicMin(ddata_current_comp, label_new);
-              }
-            }
-          },
-          katana::disable_conflict_detection(), katana::steal(),
-          katana::loopname("ConnectedComponentsLabelPropAlgo"));
-    } while (changed.reduce());
+    katana::FrontierPlan frontier_plan;
+    // A node must observe the labels of all its frontier neighbors to take
+    // their minimum, so pulls cannot stop at the first update.
+    frontier_plan.pull_stop_on_update = false;
+
+    katana::FrontierEngine<Graph> engine(*graph, frontier_plan);
+
+    // All nodes start in their own component, so every node is a seed.
+    katana::do_all(katana::iterate(*graph), [&](const GNode& node) {
+      engine.AddSeed(node);
+    });
+
+    engine.Run(
+        [&](const GNode& src, const GNode& dst, const auto&) {
+          ComponentType label_new = graph->GetData<NodeComponent>(src).load(
+              std::memory_order_relaxed);
+          return katana::atomicMin(
+                     graph->GetData<NodeComponent>(dst), label_new) >
+                 label_new;
+        },
+        [&](const GNode&) { return true; },
+        [&](const GNode& dst, const GNode& src, const auto&) {
+          ComponentType label_new = graph->GetData<NodeComponent>(src).load(
+              std::memory_order_relaxed);
+          auto& ddata = graph->GetData<NodeComponent>(dst);
+          if (label_new < ddata.load(std::memory_order_relaxed)) {
+            ddata.store(label_new, std::memory_order_relaxed);
+            return true;
+          }
+          return false;
+        },
+        "ConnectedComponentsLabelProp");
   }
 };
 
@@ -1178,9 +1186,168 @@ katana::analytics::ConnectedComponents(
   }
 }
 
+katana::Result<void>
+katana::analytics::ConnectedComponentsIncremental(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<std::pair<uint32_t, uint32_t>>& inserted_edges,
+    uint64_t batches_since_full_compute, uint64_t full_recompute_interval,
+    ConnectedComponentsPlan plan) {
+  if (!pg->HasNodeProperty(property_name) ||
+      batches_since_full_compute >= full_recompute_interval) {
+    return ConnectedComponents(pg, property_name, plan);
+  }
+
+  using ComponentType = uint64_t;
+  struct NodeComponent : public katana::PODProperty<ComponentType> {};
+
+  using NodeData = std::tuple<NodeComponent>;
+  using EdgeData = std::tuple<>;
+  typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+  typedef typename Graph::Node GNode;
+
+  auto pg_result = Graph::Make(pg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+
+  auto graph = pg_result.value();
+
+  const uint64_t num_nodes = graph.num_nodes();
+  for (const auto& [src, dest] : inserted_edges) {
+    if (src >= num_nodes || dest >= num_nodes) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "inserted edge ({}, {}) references a node outside the graph", src,
+          dest);
+    }
+  }
+
+  katana::StatTimer execTime("ConnectedComponentsIncremental");
+  execTime.start();
+
+  // The persisted labels are a union-find forest with every path already
+  // compressed, so they resume directly as parent pointers in node-id space.
+  // UnionFindNode cannot be persisted as-is because it parents through raw
+  // pointers; storing representatives instead makes the property both the
+  // analytics output and the serialized union-find state.
+  auto parent = [&graph](ComponentType n) -> ComponentType& {
+    return graph.template GetData<NodeComponent>(GNode(n));
+  };
+  auto find = [&parent](ComponentType n) {
+    // Path halving, as in UnionFindNode::findImpl.
+    while (parent(n) != n) {
+      parent(n) = parent(parent(n));
+      n = parent(n);
+    }
+    return n;
+  };
+
+  // A micro-batch touches a tiny fraction of the graph, so the unions run
+  // serially; union by minimum id keeps the labels deterministic.
+  bool merged = false;
+  for (const auto& [src, dest] : inserted_edges) {
+    ComponentType src_rep = find(src);
+    ComponentType dest_rep = find(dest);
+    if (src_rep == dest_rep) {
+      continue;
+    }
+    if (src_rep > dest_rep) {
+      std::swap(src_rep, dest_rep);
+    }
+    parent(dest_rep) = src_rep;
+    merged = true;
+  }
+
+  // Re-establish the flattened form the next call resumes from. Each node
+  // only follows parent chains and rewrites its own label; a concurrently
+  // rewritten label is either the old parent or that parent's root, and both
+  // lead to the same root.
+  if (merged) {
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& node) {
+          ComponentType rep = graph.template GetData<NodeComponent>(node);
+          while (graph.template GetData<NodeComponent>(GNode(rep)) != rep) {
+            rep = graph.template GetData<NodeComponent>(GNode(rep));
+          }
+          graph.template GetData<NodeComponent>(node) = rep;
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("ConnectedComponentsIncremental-Relabel"));
+  }
+
+  execTime.stop();
+  return katana::ResultSuccess();
+}
+
+/// Out-of-core label propagation. Per-node component labels stay in memory;
+/// every round streams the edge segments from storage with the next segment
+/// prefetched while the current one is processed. Each edge relaxes both
+/// endpoints, so asymmetric inputs behave as if undirected.
+katana::Result<void>
+katana::analytics::ConnectedComponentsOutOfCore(
+    katana::OutOfCorePropertyGraph* graph,
+    katana::NUMAArray<uint64_t>* components) {
+  using OOCGraph = katana::OutOfCorePropertyGraph;
+  using OOCNode = OOCGraph::Node;
+  using OOCEdge = OOCGraph::Edge;
+
+  uint64_t num_nodes = graph->num_nodes();
+  components->allocateInterleaved(num_nodes);
+
+  katana::NUMAArray<std::atomic<uint64_t>> labels;
+  labels.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { labels[n] = n; });
+
+  katana::StatTimer execTime("ConnectedComponentsOutOfCore");
+  execTime.start();
+
+  bool changed = true;
+  while (changed) {
+    katana::GReduceLogicalOr any_changed;
+    KATANA_CHECKED(
+        graph->ForEachSegment([&](const OOCGraph::LoadedSegment& seg) {
+          katana::do_all(
+              katana::iterate(seg.info().node_begin, seg.info().node_end),
+              [&](OOCNode src) {
+                for (OOCEdge e = graph->edge_begin(src);
+                     e < graph->edge_end(src); ++e) {
+                  OOCNode dst = seg.edge_dest(e);
+                  uint64_t src_label = labels[src];
+                  uint64_t dst_label = labels[dst];
+                  if (src_label < dst_label) {
+                    if (katana::atomicMin(labels[dst], src_label) >
+                        src_label) {
+                      any_changed.update(true);
+                    }
+                  } else if (dst_label < src_label) {
+                    if (katana::atomicMin(labels[src], dst_label) >
+                        dst_label) {
+                      any_changed.update(true);
+                    }
+                  }
+                }
+              },
+              katana::steal());
+        }));
+    changed = any_changed.reduce();
+  }
+
+  execTime.stop();
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { (*components)[n] = labels[n]; });
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 katana::analytics::ConnectedComponentsAssertValid(
-    PropertyGraph* pg, const std::string& property_name) {
+    PropertyGraph* pg, const std::string& property_name,
+    uint32_t num_samples) {
   using ComponentType = uint64_t;
   struct NodeComponent : public katana::PODProperty<ComponentType> {};
 
@@ -1212,6 +1379,28 @@ katana::analytics::ConnectedComponentsAssertValid(
     return false;
   };
 
+  if (num_samples > 0) {
+    std::vector<uint32_t> sample =
+        SampleValidationNodes(graph.size(), num_samples);
+    katana::GAccumulator<uint64_t> num_bad;
+    katana::do_all(
+        katana::iterate(sample),
+        [&](uint32_t n) {
+          if (is_bad(n)) {
+            num_bad += 1;
+          }
+        },
+        katana::steal(), katana::loopname("CC sampled validation"),
+        katana::no_stats());
+    if (num_bad.reduce() > 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed,
+          "{} of {} sampled nodes have a neighbor in another component",
+          num_bad.reduce(), sample.size());
+    }
+    return katana::ResultSuccess();
+  }
+
   if (katana::ParallelSTL::find_if(graph.begin(), graph.end(), is_bad) !=
       graph.end()) {
     return katana::ErrorCode::AssertionFailed;
@@ -0,0 +1,416 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/graph_coloring/graph_coloring.h"
+
+#include <atomic>
+#include <cmath>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+#include "katana/gstl.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+constexpr static const unsigned kChunkSize = 64U;
+
+struct NodeColor : public katana::PODProperty<uint32_t> {};
+
+using Graph = katana::TypedPropertyGraph<std::tuple<NodeColor>, std::tuple<>>;
+using GNode = Graph::Node;
+
+// Same avalanche hash as the priority independent set algorithms; it
+// perturbs the degree-based priorities so that ties inside a log-degree
+// bucket are broken pseudo-randomly but reproducibly.
+uint32_t
+hash(uint32_t val) {
+  uint32_t ret = val;
+  ret = ((ret << 13) ^ ret) * 0x1f1f1f1f;
+  ret ^= ret >> 7;
+  ret = ((ret << 11) ^ ret) * 0x5f5f5f5f;
+  ret ^= ret >> 17;
+  return ret;
+}
+
+/**
+ * Jones-Plassmann coloring. Priorities impose a total order on the nodes
+ * (priority value, then hash of the node ID, then the node ID itself); a
+ * node colors itself with the smallest color absent among its already
+ * colored neighbors as soon as all of its higher-priority neighbors are
+ * done. Each node's color therefore depends only on the graph and the
+ * priorities, not on the parallel schedule.
+ */
+struct JonesPlassmannAlgo {
+  Graph* graph;
+  const katana::NUMAArray<uint32_t>* priority;
+
+  /// Is a colored strictly before b in the priority order?
+  bool Before(GNode a, GNode b) const {
+    if ((*priority)[a] != (*priority)[b]) {
+      return (*priority)[a] > (*priority)[b];
+    }
+    uint32_t hash_a = hash(a);
+    uint32_t hash_b = hash(b);
+    if (hash_a != hash_b) {
+      return hash_a > hash_b;
+    }
+    return a > b;
+  }
+
+  void ColorNode(GNode n) {
+    size_t degree = graph->edges(n).size();
+    // A node with d neighbors never needs a color above d, so a bitmap of
+    // d + 1 colors is enough to find the smallest free one.
+    katana::gstl::Vector<bool> used(degree + 1, false);
+    for (auto e : graph->edges(n)) {
+      GNode dest = *graph->GetEdgeDest(e);
+      if (dest == n) {
+        continue;
+      }
+      uint32_t color = graph->GetData<NodeColor>(dest);
+      if (color != kUncoloredColor && color <= degree) {
+        used[color] = true;
+      }
+    }
+    uint32_t color = 0;
+    while (used[color]) {
+      ++color;
+    }
+    graph->GetData<NodeColor>(n) = color;
+  }
+
+  void operator()(Graph* g, const katana::NUMAArray<uint32_t>& prio) {
+    graph = g;
+    priority = &prio;
+
+    katana::NUMAArray<std::atomic<uint32_t>> waiting;
+    waiting.allocateInterleaved(graph->num_nodes());
+
+    auto bag_a = std::make_unique<katana::InsertBag<GNode>>();
+    auto bag_b = std::make_unique<katana::InsertBag<GNode>>();
+    katana::InsertBag<GNode>* cur = bag_a.get();
+    katana::InsertBag<GNode>* next = bag_b.get();
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          graph->GetData<NodeColor>(n) = kUncoloredColor;
+          uint32_t count = 0;
+          for (auto e : graph->edges(n)) {
+            GNode dest = *graph->GetEdgeDest(e);
+            if (dest != n && Before(dest, n)) {
+              count++;
+            }
+          }
+          waiting[n].store(count, std::memory_order_relaxed);
+          if (count == 0) {
+            cur->push(n);
+          }
+        },
+        katana::loopname("GraphColoring_Init"), katana::steal());
+
+    uint32_t rounds = 0;
+    while (!cur->empty()) {
+      katana::do_all(
+          katana::iterate(*cur),
+          [&](GNode n) {
+            ColorNode(n);
+            for (auto e : graph->edges(n)) {
+              GNode dest = *graph->GetEdgeDest(e);
+              if (dest != n && Before(n, dest) &&
+                  katana::atomicSub(waiting[dest], uint32_t{1}) == 1) {
+                next->push(dest);
+              }
+            }
+          },
+          katana::chunk_size<kChunkSize>(), katana::steal(),
+          katana::loopname("GraphColoring_JonesPlassmann"));
+
+      cur->clear();
+      std::swap(cur, next);
+      rounds++;
+    }
+
+    katana::ReportStatSingle("GraphColoring", "Rounds", rounds);
+  }
+};
+
+/// Largest-log-degree-first priorities: nodes in a larger log-degree bucket
+/// are colored earlier.
+void
+ComputeLLFPriorities(Graph* graph, katana::NUMAArray<uint32_t>* priority) {
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](GNode n) {
+        size_t degree = graph->edges(n).size();
+        (*priority)[n] =
+            degree == 0 ? 0 : static_cast<uint32_t>(std::log2(degree));
+      },
+      katana::loopname("GraphColoring_LLFPriority"), katana::no_stats());
+}
+
+/// Smallest-log-degree-last priorities: repeatedly peel off all nodes whose
+/// residual degree is below a doubling threshold; nodes peeled in round r
+/// get priority r, so the densely connected core that survives longest is
+/// colored first.
+void
+ComputeSLLPriorities(Graph* graph, katana::NUMAArray<uint32_t>* priority) {
+  uint64_t num_nodes = graph->num_nodes();
+
+  katana::NUMAArray<std::atomic<uint32_t>> residual_degree;
+  residual_degree.allocateInterleaved(num_nodes);
+  katana::DynamicBitset peeled;
+  peeled.resize(num_nodes);
+  peeled.reset();
+
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](GNode n) {
+        residual_degree[n].store(
+            graph->edges(n).size(), std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  uint64_t remaining = num_nodes;
+  uint32_t round = 0;
+  katana::InsertBag<GNode> peel_bag;
+
+  while (remaining > 0) {
+    uint32_t threshold = round >= 31 ? std::numeric_limits<uint32_t>::max()
+                                     : (uint32_t{2} << round);
+    // Iterate to a fixed point at this threshold: removing a node can pull
+    // its neighbors below the threshold, and those cascading removals
+    // belong to the same round.
+    while (true) {
+      katana::GAccumulator<uint64_t> peeled_count;
+      katana::do_all(
+          katana::iterate(*graph),
+          [&](GNode n) {
+            if (!peeled.test(n) &&
+                residual_degree[n].load(std::memory_order_relaxed) <
+                    threshold) {
+              peel_bag.push(n);
+              peeled_count += 1;
+            }
+          },
+          katana::chunk_size<kChunkSize>(), katana::steal(),
+          katana::loopname("GraphColoring_SLLPeel"));
+
+      if (peeled_count.reduce() == 0) {
+        break;
+      }
+      remaining -= peeled_count.reduce();
+
+      katana::do_all(
+          katana::iterate(peel_bag),
+          [&](GNode n) {
+            peeled.set(n);
+            (*priority)[n] = round;
+          },
+          katana::no_stats());
+
+      katana::do_all(
+          katana::iterate(peel_bag),
+          [&](GNode n) {
+            for (auto e : graph->edges(n)) {
+              GNode dest = *graph->GetEdgeDest(e);
+              if (dest != n) {
+                katana::atomicSub(residual_degree[dest], uint32_t{1});
+              }
+            }
+          },
+          katana::chunk_size<kChunkSize>(), katana::steal(),
+          katana::no_stats());
+
+      peel_bag.clear();
+    }
+    round++;
+  }
+
+  katana::ReportStatSingle("GraphColoring", "PeelRounds", round);
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::GraphColoring(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    GraphColoringPlan plan) {
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<NodeColor>>(
+      pg, {output_property_name}));
+
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  katana::EnsurePreallocated(4, 8 * (pg->num_nodes() + pg->num_edges()));
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::NUMAArray<uint32_t> priority;
+  priority.allocateInterleaved(graph.num_nodes());
+
+  katana::StatTimer exec_time("GraphColoring", "GraphColoring");
+  exec_time.start();
+
+  switch (plan.algorithm()) {
+  case GraphColoringPlan::kJonesPlassmannLLF:
+    ComputeLLFPriorities(&graph, &priority);
+    break;
+  case GraphColoringPlan::kJonesPlassmannSLL:
+    ComputeSLLPriorities(&graph, &priority);
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  JonesPlassmannAlgo algo;
+  algo(&graph, priority);
+
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<ColorClasses>
+katana::analytics::GraphColoringColorClasses(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto colors =
+      KATANA_CHECKED(pg->GetNodePropertyTyped<uint32_t>(property_name));
+  uint64_t num_nodes = colors->length();
+
+  katana::GReduceMax<uint32_t> max_color;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { max_color.update(colors->Value(n)); },
+      katana::no_stats());
+
+  ColorClasses classes;
+  if (num_nodes == 0) {
+    return classes;
+  }
+  if (max_color.reduce() >= num_nodes) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "property {} does not contain a dense coloring", property_name);
+  }
+  uint64_t num_colors = uint64_t{max_color.reduce()} + 1;
+
+  katana::NUMAArray<std::atomic<uint64_t>> cursor;
+  cursor.allocateInterleaved(num_colors);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_colors),
+      [&](uint64_t c) { cursor[c].store(0, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        cursor[colors->Value(n)].fetch_add(1, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  classes.class_end.resize(num_colors);
+  uint64_t running = 0;
+  for (uint64_t c = 0; c < num_colors; ++c) {
+    uint64_t count = cursor[c].load(std::memory_order_relaxed);
+    // Reset the cursor to the start of the class for the scatter pass.
+    cursor[c].store(running, std::memory_order_relaxed);
+    running += count;
+    classes.class_end[c] = running;
+  }
+
+  classes.nodes.resize(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint64_t slot = cursor[colors->Value(n)].fetch_add(
+            1, std::memory_order_relaxed);
+        classes.nodes[slot] = static_cast<uint32_t>(n);
+      },
+      katana::loopname("GraphColoring_ColorClasses"), katana::no_stats());
+
+  return classes;
+}
+
+katana::Result<void>
+katana::analytics::GraphColoringAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name,
+    uint32_t num_samples) {
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GAccumulator<uint64_t> num_uncolored;
+  katana::GAccumulator<uint64_t> num_conflicts;
+  std::vector<uint32_t> sample =
+      SampleValidationNodes(graph.size(), num_samples);
+  katana::do_all(
+      katana::iterate(sample),
+      [&](GNode n) {
+        uint32_t color = graph.GetData<NodeColor>(n);
+        if (color == kUncoloredColor) {
+          num_uncolored += 1;
+          return;
+        }
+        for (auto e : graph.edges(n)) {
+          GNode dest = *graph.GetEdgeDest(e);
+          if (dest != n && graph.GetData<NodeColor>(dest) == color) {
+            num_conflicts += 1;
+          }
+        }
+      },
+      katana::steal(), katana::loopname("GraphColoring sanity check"),
+      katana::no_stats());
+
+  if (num_uncolored.reduce() > 0 || num_conflicts.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "{} is not a valid distance-1 coloring: {} uncolored nodes, {} "
+        "same-color edges",
+        property_name, num_uncolored.reduce(), num_conflicts.reduce());
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<GraphColoringStatistics>
+katana::analytics::GraphColoringStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto colors =
+      KATANA_CHECKED(pg->GetNodePropertyTyped<uint32_t>(property_name));
+
+  katana::GReduceMax<uint32_t> max_color;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, static_cast<uint64_t>(colors->length())),
+      [&](uint64_t n) { max_color.update(colors->Value(n)); },
+      katana::no_stats());
+
+  uint32_t number_of_colors =
+      colors->length() == 0 ? 0 : max_color.reduce() + 1;
+  return GraphColoringStatistics{number_of_colors};
+}
+
+void
+katana::analytics::GraphColoringStatistics::Print(std::ostream& os) const {
+  os << "Number of colors = " << number_of_colors << std::endl;
+}
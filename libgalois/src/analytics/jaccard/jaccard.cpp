@@ -19,9 +19,15 @@
 
 #include "katana/analytics/jaccard/jaccard.h"
 
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+#include "katana/SortedIntersection.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
+#include "katana/gstl.h"
 
 using namespace katana::analytics;
 
@@ -37,33 +43,23 @@ struct IntersectWithSortedEdgeList {
 private:
   const GNode base_;
   const Graph& graph_;
+  // Raw sorted destination array of the underlying topology; edge ids index
+  // directly into it, so intersections can run on the vectorized
+  // katana::SortedIntersectionCount kernel instead of an iterator merge.
+  const Graph::Node* dests_;
 
 public:
   IntersectWithSortedEdgeList(const Graph& graph, GNode base)
-      : base_(base), graph_(graph) {}
+      : base_(base),
+        graph_(graph),
+        dests_(graph.GetPropertyGraph().topology().dest_data()) {}
 
   uint32_t operator()(GNode n2) {
-    uint32_t intersection_size = 0;
-    // Iterate over the edges of both n2 and base in sync, based on the
-    // assumption that edges lists are sorted.
-    auto edges_n2_iter = graph_.edge_begin(n2);
-    auto edges_n2_end = graph_.edge_end(n2);
-    auto edges_base_iter = graph_.edge_begin(base_);
-    auto edges_base_end = graph_.edge_end(base_);
-    while (edges_n2_iter != edges_n2_end && edges_base_iter != edges_base_end) {
-      auto edge_n2_dst = graph_.GetEdgeDest(*edges_n2_iter);
-      auto edge_base_dst = graph_.GetEdgeDest(*edges_base_iter);
-      if (edge_n2_dst == edge_base_dst) {
-        intersection_size++;
-        edges_n2_iter++;
-        edges_base_iter++;
-      } else if (edge_n2_dst > edge_base_dst) {
-        edges_base_iter++;
-      } else if (edge_n2_dst < edge_base_dst) {
-        edges_n2_iter++;
-      }
-    }
-    return intersection_size;
+    auto edges_base = graph_.edges(base_);
+    auto edges_n2 = graph_.edges(n2);
+    return katana::SortedIntersectionCount(
+        dests_ + *edges_n2.begin(), edges_n2.size(),
+        dests_ + *edges_base.begin(), edges_base.size());
   }
 };
 
@@ -136,8 +132,137 @@ JaccardImpl(
   return katana::ResultSuccess();
 }
 
+using DegreeSortedView =
+    katana::PropertyGraphViews::NodesSortedByDegreeEdgesSortedByDestID;
+
+/// Node ids of the degree-sorted view ascend with degree, so this is a
+/// binary search over the whole id space.
+uint32_t
+FirstNodeWithDegreeAtLeast(const DegreeSortedView& graph, double min_degree) {
+  uint32_t lo = 0;
+  uint32_t hi = graph.num_nodes();
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (static_cast<double>(graph.degree(mid)) < min_degree) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
 }  // namespace
 
+katana::Result<std::vector<std::vector<std::pair<uint32_t, double>>>>
+katana::analytics::JaccardTopKAllPairs(
+    katana::PropertyGraph* pg, uint32_t k, double min_similarity) {
+  if (k == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "k must be positive");
+  }
+  if (min_similarity < 0.0 || min_similarity >= 1.0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "min_similarity must be in [0, 1): {}", min_similarity);
+  }
+
+  DegreeSortedView graph = pg->BuildView<DegreeSortedView>();
+
+  std::vector<std::vector<std::pair<uint32_t, double>>> rows(graph.num_nodes());
+
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::StatTimer exec_time("JaccardTopKAllPairs");
+  exec_time.start();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t u) {
+        const uint64_t du = graph.degree(u);
+        if (du == 0) {
+          return;
+        }
+
+        // A candidate v can reach min_similarity only if
+        // min(du, dv) >= min_similarity * max(du, dv). Node ids of this view
+        // ascend with degree, so the surviving candidates form a contiguous
+        // id window and each (sorted) neighbor list can be clamped to it.
+        uint32_t window_begin = 0;
+        uint32_t window_end = graph.num_nodes();
+        if (min_similarity > 0.0) {
+          window_begin =
+              FirstNodeWithDegreeAtLeast(graph, min_similarity * du);
+          window_end = FirstNodeWithDegreeAtLeast(
+              graph, std::floor(du / min_similarity) + 1.0);
+        }
+
+        const auto dest_less = [&](const auto& e, uint32_t bound) {
+          return graph.edge_dest(e) < bound;
+        };
+
+        // Count the common neighbors of u and every two-hop candidate.
+        katana::gstl::Map<uint32_t, uint32_t> shared;
+        for (auto e : graph.edges(u)) {
+          auto candidates = graph.edges(graph.edge_dest(e));
+          auto begin = candidates.begin();
+          auto end = candidates.end();
+          if (min_similarity > 0.0) {
+            begin = std::lower_bound(begin, end, window_begin, dest_less);
+            end = std::lower_bound(begin, end, window_end, dest_less);
+          }
+          for (auto it = begin; it != end; ++it) {
+            auto v = graph.edge_dest(*it);
+            if (v != u) {
+              shared[v] += 1;
+            }
+          }
+        }
+
+        // Keep the k best candidates in a min-heap.
+        using Entry = std::pair<double, uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+            heap;
+        for (const auto& [v, intersection_size] : shared) {
+          const uint64_t dv = graph.degree(v);
+          if (heap.size() == k) {
+            // Degree bound on the similarity; cheaper than the division.
+            const double bound = static_cast<double>(std::min(du, dv)) /
+                                 static_cast<double>(std::max(du, dv));
+            if (bound <= heap.top().first) {
+              continue;
+            }
+          }
+          const double similarity = static_cast<double>(intersection_size) /
+                                    static_cast<double>(du + dv -
+                                                        intersection_size);
+          if (similarity < min_similarity) {
+            continue;
+          }
+          if (heap.size() < k) {
+            heap.emplace(similarity, v);
+          } else if (similarity > heap.top().first) {
+            heap.pop();
+            heap.emplace(similarity, v);
+          }
+        }
+
+        auto& row = rows[graph.node_property_index(u)];
+        row.reserve(heap.size());
+        while (!heap.empty()) {
+          row.emplace_back(
+              graph.node_property_index(heap.top().second), heap.top().first);
+          heap.pop();
+        }
+        std::reverse(row.begin(), row.end());
+      },
+      katana::steal(), katana::loopname("JaccardTopKAllPairs"));
+
+  exec_time.stop();
+
+  return rows;
+}
+
 katana::Result<void>
 katana::analytics::Jaccard(
     PropertyGraph* pg, uint32_t compare_node,
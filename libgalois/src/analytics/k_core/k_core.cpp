@@ -19,7 +19,12 @@
 
 #include "katana/analytics/k_core/k_core.h"
 
+#include <limits>
+#include <vector>
+
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/NUMAArray.h"
+#include "katana/FrontierEngine.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
 
@@ -94,37 +99,54 @@ SetupInitialWorklist(
  */
 void
 SyncCascadeKCore(Graph* graph, uint32_t k_core_number) {
-  auto current = std::make_unique<katana::InsertBag<GNode>>();
-  auto next = std::make_unique<katana::InsertBag<GNode>>();
+  const katana::GraphTopology& topo = graph->GetPropertyGraph().topology();
 
-  //! Setup worklist.
-  SetupInitialWorklist(*graph, *next, k_core_number);
-
-  while (!next->empty()) {
-    //! Make "next" into current.
-    std::swap(current, next);
-    next->clear();
-
-    katana::do_all(
-        katana::iterate(*current),
-        [&](const GNode& dead_node) {
-          //! Decrement degree of all neighbors.
-          for (auto e : graph->edges(dead_node)) {
-            auto dest = graph->GetEdgeDest(e);
-            auto& dest_current_degree =
-                graph->GetData<KCoreNodeCurrentDegree>(dest);
-            uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
+  katana::FrontierPlan frontier_plan;
+  //! Every newly dead neighbor must be counted, so pulls cannot stop at the
+  //! first decrement.
+  frontier_plan.pull_stop_on_update = false;
 
-            if (old_degree == k_core_number) {
-              //! This thread was responsible for putting degree of destination
-              //! below threshold; add to worklist.
-              next->emplace(*dest);
-            }
-          }
-        },
-        katana::steal(), katana::chunk_size<KCorePlan::kChunkSize>(),
-        katana::loopname("KCore Synchronous"));
-  }
+  //! The graph is symmetric, so the pull phase reuses the out-edges instead
+  //! of materializing a transpose.
+  katana::FrontierEngine<katana::GraphTopology, /*kPullUsesOutEdges=*/true>
+      engine(topo, frontier_plan);
+
+  //! Setup worklist: seed the cascade with the initially dead nodes.
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        const auto& node_current_degree =
+            graph->GetData<KCoreNodeCurrentDegree>(node);
+        if (node_current_degree < k_core_number) {
+          engine.AddSeed(node);
+        }
+      },
+      katana::loopname("InitialWorklistSetup"), katana::no_stats());
+
+  engine.Run(
+      [&](const GNode&, const GNode& dst, const auto&) {
+        //! Decrement degree of the dead node's neighbor.
+        auto& dest_current_degree = graph->GetData<KCoreNodeCurrentDegree>(dst);
+        uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
+        //! This thread was responsible for putting degree of destination
+        //! below threshold; add to worklist.
+        return old_degree == k_core_number;
+      },
+      [&](const GNode& dst) {
+        //! Only nodes still in the core need their degrees maintained.
+        return graph->GetData<KCoreNodeCurrentDegree>(dst).load(
+                   std::memory_order_relaxed) >= k_core_number;
+      },
+      [&](const GNode& dst, const GNode&, const auto&) {
+        //! A single thread owns dst in the pull phase, so the decrement need
+        //! not be atomic.
+        auto& dest_current_degree = graph->GetData<KCoreNodeCurrentDegree>(dst);
+        uint32_t new_degree =
+            dest_current_degree.load(std::memory_order_relaxed) - 1;
+        dest_current_degree.store(new_degree, std::memory_order_relaxed);
+        return new_degree + 1 == k_core_number;
+      },
+      "KCore");
 }
 
 /**
@@ -262,15 +284,177 @@ katana::analytics::KCore(
   return KCoreMarkAliveNodes(&graph_final, k_core_number);
 }
 
+//! Coreness value of a node that has not been peeled yet.
+constexpr uint32_t kCorenessUnset = std::numeric_limits<uint32_t>::max();
+
+struct KCoreNodeCoreness : public katana::PODProperty<uint32_t> {};
+
+katana::Result<void>
+katana::analytics::KCoreDecomposition(
+    katana::PropertyGraph* pg, const std::string& output_property_name) {
+  katana::analytics::TemporaryPropertyGuard temporary_property{
+      pg->NodeMutablePropertyView()};
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCurrentDegree>>(
+          pg, {temporary_property.name()});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pg, {temporary_property.name()}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  size_t approxNodeData = 4 * (graph.num_nodes() + graph.num_edges());
+  katana::EnsurePreallocated(8, approxNodeData);
+  katana::ReportPageAllocGuard page_alloc;
+
+  //! Intialization of degrees.
+  DegreeCounting(&graph);
+
+  katana::NUMAArray<std::atomic<uint32_t>> coreness;
+  coreness.allocateInterleaved(graph.num_nodes());
+
+  katana::GReduceMax<uint32_t> max_degree_accum;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        coreness.constructAt(node, kCorenessUnset);
+        max_degree_accum.update(
+            graph.GetData<KCoreNodeCurrentDegree>(node).load(
+                std::memory_order_relaxed));
+      },
+      katana::loopname("KCore Decomposition Initialize"), katana::no_stats());
+  uint32_t max_degree = max_degree_accum.reduce();
+
+  //! One bucket per degree, seeded with each node's starting degree. When a
+  //! peel drops a survivor's degree, the survivor is lazily re-inserted into
+  //! the bucket of its new degree; stale entries are rejected when their
+  //! bucket is drained, so each node is peeled exactly once.
+  std::vector<katana::InsertBag<GNode>> buckets(size_t{max_degree} + 1);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        buckets[graph.GetData<KCoreNodeCurrentDegree>(node).load(
+                    std::memory_order_relaxed)]
+            .emplace(node);
+      },
+      katana::loopname("KCore Decomposition Bucket"), katana::no_stats());
+
+  //! Begins main computation.
+  katana::StatTimer exec_time("KCoreDecomposition");
+  exec_time.start();
+
+  for (uint32_t k = 0; k <= max_degree; ++k) {
+    //! Peel every node whose degree has fallen to at most k; cascades that
+    //! stay at this level run inside the same for_each.
+    katana::for_each(
+        katana::iterate(buckets[k]),
+        [&](const GNode& node, auto& ctx) {
+          //! First peel wins; later bucket entries for this node are stale.
+          uint32_t expected = kCorenessUnset;
+          if (!coreness[node].compare_exchange_strong(expected, k)) {
+            return;
+          }
+
+          for (auto e : graph.edges(node)) {
+            auto dest = graph.GetEdgeDest(e);
+            if (coreness[*dest].load(std::memory_order_relaxed) !=
+                kCorenessUnset) {
+              continue;
+            }
+            auto& dest_current_degree =
+                graph.GetData<KCoreNodeCurrentDegree>(dest);
+            uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
+            if (old_degree == k + 1) {
+              //! This thread dropped the destination to the current level.
+              ctx.push(*dest);
+            } else if (old_degree > k + 1) {
+              //! Still above the current level; remember the new degree so
+              //! the destination is seen when peeling reaches it.
+              buckets[old_degree - 1].emplace(*dest);
+            }
+          }
+        },
+        katana::disable_conflict_detection(),
+        katana::chunk_size<KCorePlan::kChunkSize>(),
+        katana::loopname("KCore Decomposition Peel"));
+  }
+  exec_time.stop();
+
+  if (auto result = ConstructNodeProperties<std::tuple<KCoreNodeCoreness>>(
+          pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+  auto pg_final_result =
+      katana::TypedPropertyGraph<std::tuple<KCoreNodeCoreness>, std::tuple<>>::
+          Make(pg, {output_property_name}, {});
+  if (!pg_final_result) {
+    return pg_final_result.error();
+  }
+  auto graph_final = pg_final_result.value();
+
+  katana::do_all(
+      katana::iterate(graph_final),
+      [&](const GNode& node) {
+        graph_final.GetData<KCoreNodeCoreness>(node) =
+            coreness[node].load(std::memory_order_relaxed);
+      },
+      katana::loopname("KCore Decomposition Extract"), katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
 // Doxygen doesn't correctly handle implementation annotations that do not
 // appear in the declaration.
 /// \cond DO_NOT_DOCUMENT
 // TODO (gill) Add a validity routine.
 katana::Result<void>
 katana::analytics::KCoreAssertValid(
-    [[maybe_unused]] katana::PropertyGraph* pg,
-    [[maybe_unused]] uint32_t k_core_number,
-    [[maybe_unused]] const std::string& property_name) {
+    katana::PropertyGraph* pg, uint32_t k_core_number,
+    const std::string& property_name, uint32_t num_samples) {
+  auto graph =
+      KATANA_CHECKED((katana::TypedPropertyGraph<
+                      std::tuple<KCoreNodeAlive>, std::tuple<>>::
+                          Make(pg, {property_name}, {})));
+
+  // The k-core is the maximal subgraph with minimum degree k, so every alive
+  // node needs at least k alive neighbors and no dead node may have that many
+  // (it would belong in the core).
+  katana::GAccumulator<uint64_t> num_underfull;
+  katana::GAccumulator<uint64_t> num_excluded;
+  std::vector<uint32_t> sample =
+      SampleValidationNodes(graph.size(), num_samples);
+  katana::do_all(
+      katana::iterate(sample),
+      [&](const GNode& node) {
+        uint64_t alive_neighbors = 0;
+        for (auto e : graph.edges(node)) {
+          auto dest = graph.GetEdgeDest(e);
+          if (graph.GetData<KCoreNodeAlive>(dest)) {
+            alive_neighbors++;
+          }
+        }
+        if (graph.GetData<KCoreNodeAlive>(node)) {
+          if (alive_neighbors < k_core_number) {
+            num_underfull += 1;
+          }
+        } else if (alive_neighbors >= k_core_number) {
+          num_excluded += 1;
+        }
+      },
+      katana::steal(), katana::loopname("KCore validation"),
+      katana::no_stats());
+
+  if (num_underfull.reduce() > 0 || num_excluded.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "not a maximal {}-core: {} alive nodes with too few alive neighbors, "
+        "{} dead nodes that belong in the core",
+        k_core_number, num_underfull.reduce(), num_excluded.reduce());
+  }
   return katana::ResultSuccess();
 }
 
@@ -0,0 +1,481 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/k_shortest_paths/k_shortest_paths.h"
+
+#include <algorithm>
+#include <map>
+
+#include "katana/Allocators.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/Properties.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/BfsSsspImplementationBase.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+/// One link of a path under construction. Paths share their prefixes: the
+/// search tree of a query is the set of these links, allocated once and
+/// reused by every path that goes through the link, so the k paths cost one
+/// shared tree instead of k recomputed ones.
+struct PathNode {
+  uint32_t parent;
+  const PathNode* last{nullptr};
+};
+
+class PathAlloc {
+public:
+  PathNode* NewPath() {
+    PathNode* path = allocator_.allocate(1);
+    allocator_.construct(path, PathNode());
+    return path;
+  }
+
+  void DeletePath(PathNode* path) {
+    allocator_.destroy(path);
+    allocator_.deallocate(path, 1);
+  }
+
+private:
+  katana::FixedSizeAllocator<PathNode> allocator_;
+};
+
+struct KssspNodeCount : public katana::AtomicPODProperty<uint32_t> {};
+
+template <typename Weight>
+struct KssspNodeMax : public katana::AtomicPODProperty<Weight> {};
+
+template <typename Weight>
+using KssspEdgeWeight = katana::PODProperty<Weight>;
+
+template <typename Weight>
+struct KssspImplementation : public katana::analytics::
+                                 BfsSsspImplementationBase<
+                                     katana::TypedPropertyGraph<
+                                         std::tuple<
+                                             KssspNodeCount,
+                                             KssspNodeMax<Weight>>,
+                                         std::tuple<KssspEdgeWeight<Weight>>>,
+                                     Weight, true> {
+  using NodeCount = KssspNodeCount;
+  using NodeMax = KssspNodeMax<Weight>;
+  using EdgeWeight = KssspEdgeWeight<Weight>;
+
+  using NodeData = typename std::tuple<NodeCount, NodeMax>;
+  using EdgeData = typename std::tuple<EdgeWeight>;
+  using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+
+  using Base =
+      katana::analytics::BfsSsspImplementationBase<Graph, Weight, true>;
+
+  using Dist = typename Base::Dist;
+  using GNode = typename Graph::Node;
+  using EI = typename Graph::edge_iterator;
+
+  using UpdateRequestIndexer = typename Base::UpdateRequestIndexer;
+  using TileRangeFn = typename Base::TileRangeFn;
+
+  static constexpr unsigned kChunkSize = 64;
+  static constexpr Dist kDistanceInfinity = Base::kDistanceInfinity;
+
+  // The base's work items have no room for the path pointer, so the
+  // path-carrying variants are defined here; the rest of the delta-stepping
+  // machinery (indexer, tiling, worklists) comes from the base.
+  struct UpdateRequest {
+    GNode src;
+    Dist dist;
+    const PathNode* path;
+    UpdateRequest(const GNode& N, Dist W, const PathNode* P)
+        : src(N), dist(W), path(P) {}
+    UpdateRequest() : src(), dist(0), path(nullptr) {}
+
+    friend bool operator<(
+        const UpdateRequest& left, const UpdateRequest& right) {
+      return left.dist == right.dist ? left.src < right.src
+                                     : left.dist < right.dist;
+    }
+  };
+
+  struct SrcEdgeTile {
+    GNode src;
+    Dist dist;
+    const PathNode* path;
+    EI beg;
+    EI end;
+
+    friend bool operator<(const SrcEdgeTile& left, const SrcEdgeTile& right) {
+      return left.dist == right.dist ? left.src < right.src
+                                     : left.dist < right.dist;
+    }
+  };
+
+  struct SrcEdgeTileMaker {
+    GNode src;
+    Dist dist;
+    const PathNode* path;
+
+    SrcEdgeTile operator()(const EI& beg, const EI& end) const {
+      return SrcEdgeTile{src, dist, path, beg, end};
+    }
+  };
+
+  struct ReqPushWrap {
+    template <typename C>
+    void operator()(
+        C& cont, const GNode& n, const Dist& dist, const PathNode* path,
+        const char* const) const {
+      (*this)(cont, n, dist, path);
+    }
+
+    template <typename C>
+    void operator()(
+        C& cont, const GNode& n, const Dist& dist,
+        const PathNode* path) const {
+      cont.push(UpdateRequest(n, dist, path));
+    }
+  };
+
+  struct SrcEdgeTilePushWrap {
+    Graph* graph;
+    KssspImplementation& impl;
+
+    template <typename C>
+    void operator()(
+        C& cont, const GNode& n, const Dist& dist, const PathNode* path,
+        const char* const) const {
+      impl.PushEdgeTilesParallel(
+          cont, graph, n, SrcEdgeTileMaker{n, dist, path});
+    }
+
+    template <typename C>
+    void operator()(
+        C& cont, const GNode& n, const Dist& dist,
+        const PathNode* path) const {
+      impl.PushEdgeTiles(cont, graph, n, SrcEdgeTileMaker{n, dist, path});
+    }
+  };
+
+  struct OutEdgeRangeFn {
+    Graph* graph;
+    auto operator()(const GNode& n) const { return graph->edges(n); }
+
+    auto operator()(const UpdateRequest& req) const {
+      return graph->edges(req.src);
+    }
+  };
+
+  using PSchunk = katana::PerSocketChunkFIFO<kChunkSize>;
+  using OBIM = katana::OrderedByIntegerMetric<UpdateRequestIndexer, PSchunk>;
+  using OBIMBarrier = typename katana::OrderedByIntegerMetric<
+      UpdateRequestIndexer, PSchunk>::template with_barrier<true>::type;
+
+  /// Level-synchronous reachability check; bails out of the full search
+  /// early when the destination cannot be reached at all. Uses NodeCount as
+  /// a visited flag and resets it afterwards.
+  bool CheckReachability(Graph* graph, const GNode& source, GNode report) {
+    katana::InsertBag<GNode> current_bag;
+    katana::InsertBag<GNode> next_bag;
+
+    current_bag.push(source);
+    graph->template GetData<NodeCount>(source) = 1;
+
+    while (current_bag.begin() != current_bag.end()) {
+      katana::do_all(
+          katana::iterate(current_bag),
+          [&](GNode n) {
+            for (auto edge : graph->edges(n)) {
+              auto dest = *(graph->GetEdgeDest(edge));
+              if (graph->template GetData<NodeCount>(dest) == 0) {
+                graph->template GetData<NodeCount>(dest) = 1;
+                next_bag.push(dest);
+              }
+            }
+          },
+          katana::steal(), katana::loopname("KShortestPaths_Reachability"));
+
+      current_bag.clear();
+      std::swap(current_bag, next_bag);
+    }
+
+    bool reachable = graph->template GetData<NodeCount>(report) != 0;
+
+    katana::do_all(katana::iterate(*graph), [&graph](GNode n) {
+      graph->template GetData<NodeCount>(n) = 0;
+    });
+
+    return reachable;
+  }
+
+  /// Delta-stepping over path-carrying work items. A node admits a new path
+  /// when it has seen fewer than num_paths paths or the new one is shorter
+  /// than the longest it has seen, so all k paths fall out of one
+  /// priority-ordered pass over the shared search tree.
+  template <typename Item, typename OBIMTy, typename PushWrap, typename ER>
+  void DeltaStepAlgo(
+      Graph* graph, const GNode& source, GNode report, size_t num_paths,
+      unsigned shift, const PushWrap& pushWrap, const ER& edgeRange,
+      katana::InsertBag<std::pair<Dist, const PathNode*>>* report_paths_bag,
+      katana::InsertBag<PathNode*>* path_pointers, PathAlloc& path_alloc) {
+    graph->template GetData<NodeCount>(source) = 1;
+
+    katana::InsertBag<Item> init_bag;
+
+    PathNode* path = path_alloc.NewPath();
+    path->last = nullptr;
+    path->parent = source;
+
+    path_pointers->push(path);
+
+    pushWrap(init_bag, source, 0, path, "parallel");
+
+    katana::for_each(
+        katana::iterate(init_bag),
+        [&](const Item& item, auto& ctx) {
+          for (auto ii : edgeRange(item)) {
+            GNode dst = *(graph->GetEdgeDest(ii));
+            auto& ddata_count = graph->template GetData<NodeCount>(dst);
+            auto& ddata_max = graph->template GetData<NodeMax>(dst);
+
+            Dist ew = graph->template GetEdgeData<EdgeWeight>(ii);
+            const Dist new_dist = item.dist + ew;
+
+            if ((ddata_count >= num_paths) && (ddata_max <= new_dist)) {
+              continue;
+            }
+
+            PathNode* new_path = path_alloc.NewPath();
+            new_path->parent = item.src;
+            new_path->last = item.path;
+            path_pointers->push(new_path);
+
+            if (ddata_count < num_paths) {
+              katana::atomicAdd<uint32_t>(ddata_count, (uint32_t)1);
+              katana::atomicMax<Weight>(ddata_max, new_dist);
+            }
+
+            if (dst == report) {
+              report_paths_bag->push(std::make_pair(new_dist, new_path));
+            }
+
+            // Check if this new extended path needs to be added to the
+            // worklist.
+            bool should_add =
+                (graph->template GetData<NodeCount>(report) < num_paths) ||
+                ((graph->template GetData<NodeCount>(report) >= num_paths) &&
+                 (graph->template GetData<NodeMax>(report) > new_dist));
+
+            if (should_add) {
+              const PathNode* const_path = new_path;
+              pushWrap(ctx, dst, new_dist, const_path);
+            }
+          }
+        },
+        katana::wl<OBIMTy>(UpdateRequestIndexer{shift}),
+        katana::disable_conflict_detection(),
+        katana::loopname("KShortestPaths_DeltaStep"));
+  }
+
+  katana::Result<std::vector<KShortestPath>> KSSSP(
+      Graph& graph, size_t source_node, size_t destination_node,
+      size_t num_paths, KShortestPathsPlan plan) {
+    auto it = graph.begin();
+    std::advance(it, source_node);
+    GNode source = *it;
+    it = graph.begin();
+    std::advance(it, destination_node);
+    GNode report = *it;
+
+    katana::EnsurePreallocated(1, graph.num_nodes() * 64);
+    katana::ReportPageAllocGuard page_alloc;
+
+    katana::do_all(katana::iterate(graph), [&](GNode n) {
+      graph.template GetData<NodeMax>(n) = 0;
+      graph.template GetData<NodeCount>(n) = 0;
+    });
+
+    katana::StatTimer exec_time("KShortestPaths", "KShortestPaths");
+    exec_time.start();
+
+    katana::InsertBag<std::pair<Dist, const PathNode*>> paths;
+    katana::InsertBag<PathNode*> path_pointers;
+    PathAlloc path_alloc;
+
+    bool reachable = CheckReachability(&graph, source, report);
+
+    if (reachable) {
+      switch (plan.algorithm()) {
+      case KShortestPathsPlan::kDeltaTile:
+        DeltaStepAlgo<SrcEdgeTile, OBIM>(
+            &graph, source, report, num_paths, plan.delta(),
+            SrcEdgeTilePushWrap{&graph, *this}, TileRangeFn(), &paths,
+            &path_pointers, path_alloc);
+        break;
+      case KShortestPathsPlan::kDeltaStep:
+        DeltaStepAlgo<UpdateRequest, OBIM>(
+            &graph, source, report, num_paths, plan.delta(), ReqPushWrap(),
+            OutEdgeRangeFn{&graph}, &paths, &path_pointers, path_alloc);
+        break;
+      case KShortestPathsPlan::kDeltaStepBarrier:
+        DeltaStepAlgo<UpdateRequest, OBIMBarrier>(
+            &graph, source, report, num_paths, plan.delta(), ReqPushWrap(),
+            OutEdgeRangeFn{&graph}, &paths, &path_pointers, path_alloc);
+        break;
+      default:
+        return katana::ErrorCode::InvalidArgument;
+      }
+    }
+
+    exec_time.stop();
+    page_alloc.Report();
+
+    std::vector<KShortestPath> result;
+
+    if (reachable) {
+      std::multimap<Dist, const PathNode*> paths_map;
+      for (auto pair : paths) {
+        paths_map.insert(std::make_pair(pair.first, pair.second));
+      }
+
+      size_t num = std::min<size_t>(paths_map.size(), num_paths);
+      result.reserve(num);
+
+      auto it_report = paths_map.begin();
+      for (size_t iter = 0; iter < num; ++iter, ++it_report) {
+        KShortestPath path;
+        path.weight = static_cast<double>(it_report->first);
+        for (const PathNode* p = it_report->second; p != nullptr;
+             p = p->last) {
+          path.nodes.push_back(p->parent);
+        }
+        std::reverse(path.nodes.begin(), path.nodes.end());
+        path.nodes.push_back(report);
+        result.push_back(std::move(path));
+      }
+
+      katana::do_all(katana::iterate(path_pointers), [&](PathNode* p) {
+        path_alloc.DeletePath(p);
+      });
+    }
+
+    katana::ReportStatSingle("KShortestPaths", "PathsFound", result.size());
+
+    return result;
+  }
+};
+
+template <typename Weight>
+katana::Result<std::vector<KShortestPath>>
+KShortestPathsWithWrap(
+    katana::PropertyGraph* pg, size_t source_node, size_t destination_node,
+    const std::string& edge_weight_property_name, size_t num_paths,
+    KShortestPathsPlan plan) {
+  static_assert(std::is_integral_v<Weight> || std::is_floating_point_v<Weight>);
+
+  using Impl = KssspImplementation<Weight>;
+
+  TemporaryPropertyGuard count_property{pg->NodeMutablePropertyView()};
+  TemporaryPropertyGuard max_property{pg->NodeMutablePropertyView()};
+
+  KATANA_CHECKED(ConstructNodeProperties<typename Impl::NodeData>(
+      pg, {count_property.name(), max_property.name()}));
+
+  typename Impl::Graph graph = KATANA_CHECKED(Impl::Graph::Make(
+      pg, {count_property.name(), max_property.name()},
+      {edge_weight_property_name}));
+
+  Impl impl{{plan.edge_tile_size()}};
+  return impl.KSSSP(graph, source_node, destination_node, num_paths, plan);
+}
+
+}  // namespace
+
+katana::Result<std::vector<KShortestPath>>
+katana::analytics::KShortestPaths(
+    katana::PropertyGraph* pg, size_t source_node, size_t destination_node,
+    const std::string& edge_weight_property_name, size_t num_paths,
+    KShortestPathsPlan plan) {
+  if (source_node >= pg->num_nodes() || destination_node >= pg->num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "source ({}) or destination ({}) is out of range [0, {})", source_node,
+        destination_node, pg->num_nodes());
+  }
+  if (num_paths == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "num_paths must be at least 1");
+  }
+
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return KShortestPathsWithWrap<uint32_t>(
+        pg, source_node, destination_node, edge_weight_property_name,
+        num_paths, plan);
+  case arrow::Int32Type::type_id:
+    return KShortestPathsWithWrap<int32_t>(
+        pg, source_node, destination_node, edge_weight_property_name,
+        num_paths, plan);
+  case arrow::UInt64Type::type_id:
+    return KShortestPathsWithWrap<uint64_t>(
+        pg, source_node, destination_node, edge_weight_property_name,
+        num_paths, plan);
+  case arrow::Int64Type::type_id:
+    return KShortestPathsWithWrap<int64_t>(
+        pg, source_node, destination_node, edge_weight_property_name,
+        num_paths, plan);
+  case arrow::FloatType::type_id:
+    return KShortestPathsWithWrap<float>(
+        pg, source_node, destination_node, edge_weight_property_name,
+        num_paths, plan);
+  case arrow::DoubleType::type_id:
+    return KShortestPathsWithWrap<double>(
+        pg, source_node, destination_node, edge_weight_property_name,
+        num_paths, plan);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+KShortestPathsStatistics
+katana::analytics::KShortestPathsStatistics::Compute(
+    const std::vector<KShortestPath>& paths) {
+  KShortestPathsStatistics stats{static_cast<uint64_t>(paths.size()), 0, 0};
+  // KShortestPaths returns paths sorted by weight in ascending order.
+  if (!paths.empty()) {
+    stats.shortest_path_weight = paths.front().weight;
+    stats.longest_path_weight = paths.back().weight;
+  }
+  return stats;
+}
+
+void
+katana::analytics::KShortestPathsStatistics::Print(std::ostream& os) const {
+  os << "Number of paths = " << number_of_paths << std::endl;
+  os << "Shortest path weight = " << shortest_path_weight << std::endl;
+  os << "Longest path weight = " << longest_path_weight << std::endl;
+}
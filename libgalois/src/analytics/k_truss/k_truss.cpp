@@ -20,6 +20,9 @@
 #include "katana/analytics/k_truss/k_truss.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/AtomicHelpers.h"
+#include "katana/DynamicBitset.h"
+#include "katana/NUMAArray.h"
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -32,8 +35,13 @@ using EdgeData = std::tuple<EdgeFlag>;
 typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
 typedef typename Graph::Node GNode;
 
+// The degree-ordered view shares its cached topology (see PGViewCache) with
+// TriangleCount and LocalClusteringCoefficient, so the relabel+sort
+// preprocessing is paid once per graph version; the algorithms below only
+// rely on the per-node edge lists being sorted by destination.
 using SortedGraphView = katana::TypedPropertyGraphView<
-    katana::PropertyGraphViews::EdgesSortedByDestID, NodeData, EdgeData>;
+    katana::PropertyGraphViews::NodesSortedByDegreeEdgesSortedByDestID,
+    NodeData, EdgeData>;
 
 using Edge = std::pair<GNode, GNode>;
 using EdgeVec = katana::InsertBag<Edge>;
@@ -315,6 +323,154 @@ BSPCoreAlgo(SortedGraphView* g, uint32_t k) {
   return katana::ResultSuccess();
 }
 
+/// SupportIndexedTrussAlgo:
+/// 1. Count the support (number of triangles) of each edge (i, j), i < j,
+///    once up front and seed a worklist with the unsupported edges.
+/// 2. Each round removes the worklist edges, atomically decrements the
+///    support of the third edge of every triangle they close, and pushes
+///    the edges whose support drops below k-2.
+/// Support is never recomputed, so each triangle is intersected only once
+/// over the whole peeling.
+katana::Result<void>
+SupportIndexedTrussAlgo(SortedGraphView* g, uint32_t k) {
+  if (k <= 2) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  const uint32_t j = k - 2;
+
+  katana::NUMAArray<std::atomic<uint32_t>> support;
+  support.allocateInterleaved(g->num_edges());
+
+  //! Canonical edge ids of the edges removed in the current round; used to
+  //! charge each dying triangle to exactly one of its removed edges.
+  katana::DynamicBitset in_frontier;
+  in_frontier.resize(g->num_edges());
+
+  auto cur = std::make_unique<EdgeVec>();
+  auto next = std::make_unique<EdgeVec>();
+
+  //! Count the support of each edge (i, j), i < j, once.
+  katana::do_all(
+      katana::iterate(*g),
+      [&](GNode n) {
+        for (auto e : g->edges(n)) {
+          auto dest = g->edge_dest(e);
+          if (dest <= n) {
+            continue;
+          }
+          uint32_t num_triangles = 0;
+          auto srcI = g->edges(n).begin(), srcE = g->edges(n).end(),
+               dstI = g->edges(dest).begin(), dstE = g->edges(dest).end();
+          while (srcI != srcE && dstI != dstE) {
+            auto sN = g->edge_dest(*srcI), dN = g->edge_dest(*dstI);
+            if (sN < dN) {
+              ++srcI;
+            } else if (dN < sN) {
+              ++dstI;
+            } else {
+              num_triangles += 1;
+              ++srcI;
+              ++dstI;
+            }
+          }
+          support[e] = num_triangles;
+          if (num_triangles < j) {
+            cur->push_back(std::make_pair(n, dest));
+            in_frontier.set(e);
+          }
+        }
+      },
+      katana::steal());
+
+  while (std::distance(cur->begin(), cur->end()) != 0) {
+    //! Decrement the support of the third edge of every triangle closed by
+    //! a removed edge. When two edges of a triangle are removed in the same
+    //! round, only the one with the smaller canonical edge id charges the
+    //! third; edges removed this or any earlier round are never decremented.
+    katana::do_all(
+        katana::iterate(*cur),
+        [&](Edge edge) {
+          GNode u = edge.first, v = edge.second;
+          auto eid = *g->find_edge(u, v);
+
+          auto decrement = [&](uint64_t f, GNode a, GNode b) {
+            if (katana::atomicSub(support[f], uint32_t{1}) == j) {
+              next->push_back(std::make_pair(a, b));
+            }
+          };
+
+          auto srcI = g->edges(u).begin(), srcE = g->edges(u).end(),
+               dstI = g->edges(v).begin(), dstE = g->edges(v).end();
+          while (true) {
+            //! Find the first valid edge.
+            while (srcI != srcE && (g->GetEdgeData<EdgeFlag>(*srcI) & removed)) {
+              ++srcI;
+            }
+            while (dstI != dstE && (g->GetEdgeData<EdgeFlag>(*dstI) & removed)) {
+              ++dstI;
+            }
+
+            if (srcI == srcE || dstI == dstE) {
+              break;
+            }
+
+            //! Check for intersection.
+            auto sN = g->edge_dest(*srcI), dN = g->edge_dest(*dstI);
+            if (sN < dN) {
+              ++srcI;
+            } else if (dN < sN) {
+              ++dstI;
+            } else {
+              GNode w = sN;
+              uint64_t f1 = (u < w) ? *srcI : *g->find_edge(w, u);
+              uint64_t f2 = (v < w) ? *dstI : *g->find_edge(w, v);
+              bool f1_in_frontier = in_frontier.test(f1);
+              bool f2_in_frontier = in_frontier.test(f2);
+
+              if (!f1_in_frontier && !f2_in_frontier) {
+                decrement(f1, std::min(u, w), std::max(u, w));
+                decrement(f2, std::min(v, w), std::max(v, w));
+              } else if (f1_in_frontier && !f2_in_frontier) {
+                if (eid < f1) {
+                  decrement(f2, std::min(v, w), std::max(v, w));
+                }
+              } else if (!f1_in_frontier && f2_in_frontier) {
+                if (eid < f2) {
+                  decrement(f1, std::min(u, w), std::max(u, w));
+                }
+              }
+              ++srcI;
+              ++dstI;
+            }
+          }
+        },
+        katana::steal());
+
+    //! Mark the removed edges after the decrements so that triangles shared
+    //! by two edges removed in the same round are still visible above.
+    katana::do_all(
+        katana::iterate(*cur),
+        [&](Edge e) {
+          KATANA_LOG_DEBUG_ASSERT(g->has_edge(e.first, e.second));
+          KATANA_LOG_DEBUG_ASSERT(g->has_edge(e.second, e.first));
+          g->template GetEdgeData<EdgeFlag>(*g->find_edge(e.first, e.second)) =
+              removed;
+          g->template GetEdgeData<EdgeFlag>(*g->find_edge(e.second, e.first)) =
+              removed;
+        },
+        katana::steal());
+
+    in_frontier.reset();
+    katana::do_all(katana::iterate(*next), [&](Edge e) {
+      in_frontier.set(*g->find_edge(e.first, e.second));
+    });
+
+    cur->clear();
+    std::swap(cur, next);
+  }
+  return katana::ResultSuccess();
+}
+
 /// BSPCoreThenTrussAlgo:
 /// 1. Reduce the graph to k-1 core
 /// 2. Compute k-truss from k-1 core
@@ -387,6 +543,8 @@ katana::analytics::KTruss(
     return BSPTrussJacobiAlgo(&graph, k_truss_number);
   case KTrussPlan::kBspCoreThenTruss:
     return BSPCoreThenTrussAlgo(&graph, k_truss_number);
+  case KTrussPlan::kSupportIndexed:
+    return SupportIndexedTrussAlgo(&graph, k_truss_number);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -398,9 +556,41 @@ katana::analytics::KTruss(
 // TODO (gill) Add a validity routine.
 katana::Result<void>
 katana::analytics::KTrussAssertValid(
-    [[maybe_unused]] katana::PropertyGraph* pg,
-    [[maybe_unused]] uint32_t k_truss_number,
-    [[maybe_unused]] const std::string& property_name) {
+    katana::PropertyGraph* pg, uint32_t k_truss_number,
+    const std::string& property_name, uint32_t num_samples) {
+  if (k_truss_number < 2) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "k in k-truss must be at least 2");
+  }
+  // Support counting intersects edge lists, so use the same sorted view the
+  // algorithm ran on.
+  auto graph =
+      KATANA_CHECKED(SortedGraphView::Make(pg, {}, {property_name}));
+  const unsigned int j = k_truss_number - 2;
+
+  katana::GAccumulator<uint64_t> num_unsupported;
+  std::vector<uint32_t> sample =
+      SampleValidationNodes(graph.size(), num_samples);
+  katana::do_all(
+      katana::iterate(sample),
+      [&](const GNode& node) {
+        for (auto e : graph.edges(node)) {
+          auto dest = graph.GetEdgeDest(e);
+          if (node < *dest && !(graph.GetEdgeData<EdgeFlag>(e) & removed) &&
+              !IsSupportNoLessThanJ(graph, node, *dest, j)) {
+            num_unsupported += 1;
+          }
+        }
+      },
+      katana::steal(), katana::loopname("KTruss validation"),
+      katana::no_stats());
+
+  if (num_unsupported.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "{} remaining edges have fewer than {} supporting triangles",
+        num_unsupported.reduce(), j);
+  }
   return katana::ResultSuccess();
 }
 
@@ -741,10 +741,33 @@ katana::analytics::LeidenClustering(
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::LeidenClusteringAssertValid(
-    [[maybe_unused]] katana::PropertyGraph* pg,
+    katana::PropertyGraph* pg,
     [[maybe_unused]] const std::string& edge_weight_property_name,
-    [[maybe_unused]] const std::string& property_name) {
-  // TODO(gill): This should have real checks.
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<
+          std::tuple<PreviousCommunityID>,
+          std::tuple<>>::Make(pg, {property_name}, {})));
+
+  // Cluster quality is what the modularity statistic reports; validity here
+  // means every node landed in a real cluster.
+  katana::GAccumulator<uint64_t> num_invalid;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        uint64_t comm_id = graph.GetData<PreviousCommunityID>(n);
+        if (comm_id >= graph.size()) {
+          num_invalid += 1;
+        }
+      },
+      katana::loopname("LeidenClustering validation"), katana::no_stats());
+
+  if (num_invalid.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "{} nodes have an unassigned or out-of-range cluster id",
+        num_invalid.reduce());
+  }
   return katana::ResultSuccess();
 }
 /// \endcond
@@ -31,12 +31,20 @@ struct NodeClusteringCoefficient : public katana::PODProperty<double> {};
 using NodeData = typename std::tuple<NodeClusteringCoefficient>;
 using EdgeData = typename std::tuple<>;
 
-using SortedPropertyGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
-using SortedGraphView =
-    katana::TypedPropertyGraphView<SortedPropertyGraphView, NodeData, EdgeData>;
-using Node = SortedGraphView::Node;
+using SortedGraphView = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::EdgesSortedByDestID, NodeData, EdgeData>;
 
+// The degree-ordered view shares its cached topology (see PGViewCache) with
+// TriangleCount and KTruss, so the relabel+sort preprocessing is paid once
+// per graph version when several of them run on the same graph.
+using DegreeSortedGraphView = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::NodesSortedByDegreeEdgesSortedByDestID,
+    NodeData, EdgeData>;
+
+template <typename GraphTy>
 struct LocalClusteringCoefficientAtomics {
+  using Node = typename GraphTy::Node;
+
   /**
    * Counts the number of triangles for each node
    * in the graph using atomics.
@@ -47,7 +55,7 @@ struct LocalClusteringCoefficientAtomics {
    */
   template <typename CountVec>
   void OrderedCountFunc(
-      const SortedGraphView& graph, Node n, CountVec* count_vec) {
+      const GraphTy& graph, Node n, CountVec* count_vec) {
     // TODO(amber): replace with NodeIteratingAlgo for triangle counting
     for (auto edges_n : graph.edges(n)) {
       auto v = graph.edge_dest(edges_n);
@@ -73,7 +81,7 @@ struct LocalClusteringCoefficientAtomics {
     }
   }
 
-  void ComputeLocalClusteringCoefficient(SortedGraphView* graph) {
+  void ComputeLocalClusteringCoefficient(GraphTy* graph) {
     katana::NUMAArray<uint32_t> per_node_triangles;
     per_node_triangles.allocateInterleaved(graph->num_nodes());
 
@@ -103,7 +111,7 @@ struct LocalClusteringCoefficientAtomics {
     return;
   }
 
-  katana::Result<void> operator()(SortedGraphView* graph) {
+  katana::Result<void> operator()(GraphTy* graph) {
     katana::StatTimer execTime(
         "LocalClusteringCoefficient", "LocalClusteringCoefficient");
     execTime.start();
@@ -117,7 +125,9 @@ struct LocalClusteringCoefficientAtomics {
   }
 };
 
+template <typename GraphTy>
 struct LocalClusteringCoefficientPerThread {
+  using Node = typename GraphTy::Node;
   using TriangleCountVec = katana::NUMAArray<uint32_t>;
   using IterPair =
       std::pair<TriangleCountVec::iterator, TriangleCountVec::iterator>;
@@ -132,7 +142,7 @@ struct LocalClusteringCoefficientPerThread {
  * is sorted.
  */
   void OrderedCountFunc(
-      const SortedGraphView& graph, Node n, IterPair per_thread_count_range) {
+      const GraphTy& graph, Node n, IterPair per_thread_count_range) {
     // TODO(amber): replace with NodeIteratingAlgo for triangle counting
     for (auto edges_n : graph.edges(n)) {
       auto v = graph.edge_dest(edges_n);
@@ -163,7 +173,7 @@ struct LocalClusteringCoefficientPerThread {
  * It assumes that edgelist of each node is sorted.
  * This uses a PerThreadStorage implementation.
  */
-  void OrderedCountAlgo(const SortedGraphView& graph) {
+  void OrderedCountAlgo(const GraphTy& graph) {
     const uint64_t num_nodes = graph.size();
     const uint32_t num_threads = katana::getActiveThreads();
 
@@ -203,7 +213,7 @@ struct LocalClusteringCoefficientPerThread {
         katana::loopname("TriangleCount_Reduce"));
   }
 
-  void ComputeLocalClusteringCoefficient(SortedGraphView* graph) {
+  void ComputeLocalClusteringCoefficient(GraphTy* graph) {
     katana::do_all(katana::iterate(*graph), [&](Node n) {
       auto degree = graph->degree(n);
       if (degree > 1) {
@@ -218,7 +228,7 @@ struct LocalClusteringCoefficientPerThread {
     return;
   }
 
-  katana::Result<void> operator()(SortedGraphView* graph) {
+  katana::Result<void> operator()(GraphTy* graph) {
     katana::StatTimer execTime(
         "LocalClusteringCoefficient", "LocalClusteringCoefficient");
     execTime.start();
@@ -239,7 +249,7 @@ struct LocalClusteringCoefficientPerThread {
 };
 }  // namespace
 
-template <typename Algorithm>
+template <template <typename> class Algorithm, typename GraphView>
 katana::Result<void>
 LocalClusteringCoefficientWithWrap(
     katana::PropertyGraph* pg, const std::string& output_property_name) {
@@ -249,9 +259,9 @@ LocalClusteringCoefficientWithWrap(
     return result.error();
   }
   auto sorted_view =
-      KATANA_CHECKED(SortedGraphView::Make(pg, {output_property_name}, {}));
+      KATANA_CHECKED(GraphView::Make(pg, {output_property_name}, {}));
 
-  Algorithm algo;
+  Algorithm<GraphView> algo;
   return algo(&sorted_view);
 }
 
@@ -264,7 +274,7 @@ katana::analytics::LocalClusteringCoefficient(
   katana::StatTimer timer_auto_algo(
       "AutoRelabel", "LocalClusteringCoefficient");
 
-  [[maybe_unused]] bool relabel;
+  bool relabel;
   timer_graph_read.start();
   switch (plan.relabeling()) {
   case LocalClusteringCoefficientPlan::kNoRelabel:
@@ -282,43 +292,33 @@ katana::analytics::LocalClusteringCoefficient(
     return katana::ErrorCode::AssertionFailed;
   }
 
-  // TODO(amber): For now, we create a sorted view (in
-  // LocalClusteringCoefficientWithWrap) unconditionally. With current triangle
-  // counting algorithm, relabelling is not expected to help, but it will once we
-  // switch to NodeIteratingAlgo, at which point, change the
-  // SortedPropertyGraphView to
-  // PropertyGraphViews::NodesSortedByDegreeEdgesSortedByDestID
-#if 0
-  if (relabel) {
-    katana::StatTimer timer_relabel(
-        "GraphRelabelTimer", "LocalClusteringCoefficient");
-    timer_relabel.start();
-    if (auto r = katana::SortNodesByDegree(pg); !r) {
-      return r.error();
-    }
-    timer_relabel.stop();
-  }
-
-  // If we relabel we must also sort. Relabeling will break the sorting.
-  if (relabel || !plan.edges_sorted()) {
-    if (auto r = katana::SortAllEdgesByDest(pg); !r) {
-      return r.error();
-    }
-  }
-#endif
-
   timer_graph_read.stop();
 
   katana::EnsurePreallocated(1, 16 * (pg->num_nodes() + pg->num_edges()));
 
+  // When relabeling, run on the degree-ordered view, whose cached topology is
+  // shared with TriangleCount and KTruss; otherwise only the edge sorting is
+  // materialized.
   switch (plan.algorithm()) {
   case LocalClusteringCoefficientPlan::kOrderedCountAtomics: {
+    if (relabel) {
+      return LocalClusteringCoefficientWithWrap<
+          LocalClusteringCoefficientAtomics, DegreeSortedGraphView>(
+          pg, output_property_name);
+    }
     return LocalClusteringCoefficientWithWrap<
-        LocalClusteringCoefficientAtomics>(pg, output_property_name);
+        LocalClusteringCoefficientAtomics, SortedGraphView>(
+        pg, output_property_name);
   }
   case LocalClusteringCoefficientPlan::kOrderedCountPerThread: {
+    if (relabel) {
+      return LocalClusteringCoefficientWithWrap<
+          LocalClusteringCoefficientPerThread, DegreeSortedGraphView>(
+          pg, output_property_name);
+    }
     return LocalClusteringCoefficientWithWrap<
-        LocalClusteringCoefficientPerThread>(pg, output_property_name);
+        LocalClusteringCoefficientPerThread, SortedGraphView>(
+        pg, output_property_name);
   }
   default:
     return katana::ErrorCode::InvalidArgument;
@@ -19,11 +19,13 @@
 
 #include "katana/analytics/louvain_clustering/louvain_clustering.h"
 
+#include <cstring>
 #include <deque>
 #include <type_traits>
 
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/ClusteringImplementationBase.h"
+#include "katana/analytics/IterativeCheckpoint.h"
 
 using namespace katana::analytics;
 namespace {
@@ -51,7 +53,8 @@ struct LouvainClusteringImplementation
 
   katana::Result<double> LouvainWithoutLockingDoAll(
       katana::PropertyGraph* pg, double lower,
-      double modularity_threshold_per_round, uint32_t& iter) {
+      double modularity_threshold_per_round, uint32_t& iter,
+      double resolution) {
     katana::StatTimer TimerClusteringTotal("Timer_Clustering_Total");
     TimerClusteringTotal.start();
 
@@ -122,7 +125,7 @@ struct LouvainClusteringImplementation
               local_target = Base::MaxModularityWithoutSwaps(
                   cluster_local_map, counter, self_loop_wt, c_info,
                   n_data_degree_wt, n_data_curr_comm_id,
-                  constant_for_second_term);
+                  constant_for_second_term, resolution);
 
             } else {
               local_target = Base::UNASSIGNED;
@@ -149,7 +152,7 @@ struct LouvainClusteringImplementation
       double a2_x = 0;
 
       curr_mod = Base::template CalModularity<EdgeWeightType>(
-          graph, c_info, e_xx, a2_x, constant_for_second_term);
+          graph, c_info, e_xx, a2_x, constant_for_second_term, resolution);
 
       if ((curr_mod - prev_mod) < modularity_threshold_per_round) {
         prev_mod = curr_mod;
@@ -178,7 +181,8 @@ struct LouvainClusteringImplementation
   // do remove duplication
   katana::Result<double> LouvainDeterministic(
       katana::PropertyGraph* pg, double lower,
-      double modularity_threshold_per_round, uint32_t& iter) {
+      double modularity_threshold_per_round, uint32_t& iter,
+      double resolution) {
     katana::StatTimer TimerClusteringTotal("Timer_Clustering_Total");
     katana::TimerGuard TimerClusteringGuard(TimerClusteringTotal);
 
@@ -274,7 +278,7 @@ struct LouvainClusteringImplementation
                 local_target[n] = Base::MaxModularityWithoutSwaps(
                     cluster_local_map, counter, self_loop_wt, c_info,
                     n_data_degree_wt, n_data_curr_comm_id,
-                    constant_for_second_term);
+                    constant_for_second_term, resolution);
 
               } else {
                 local_target[n] = Base::UNASSIGNED;
@@ -334,7 +338,7 @@ struct LouvainClusteringImplementation
       double a2_x = 0;
 
       curr_mod = Base::template CalModularity<EdgeWeightType>(
-          graph, c_info, e_xx, a2_x, constant_for_second_term);
+          graph, c_info, e_xx, a2_x, constant_for_second_term, resolution);
 
       if ((curr_mod - prev_mod) < modularity_threshold_per_round) {
         prev_mod = curr_mod;
@@ -371,10 +375,73 @@ public:
     Graph graph_curr = KATANA_CHECKED(
         Graph::Make(pg, temp_node_property_names, {edge_weight_property_name}));
 
+    // phase counter plus the modularity reached, saved alongside the
+    // cluster assignment at every checkpointed phase boundary
+    struct CheckpointScalars {
+      uint32_t iter;
+      double modularity;
+    };
+
+    IterativeCheckpointer checkpointer(
+        plan.checkpoint_location(), "louvain-clustering",
+        plan.checkpoint_interval());
+    double restored_mod = -1;
+    uint32_t restored_phase = 0;
+    uint32_t restored_iter = 0;
+    bool resumed = false;
+    if (checkpointer.Enabled()) {
+      auto snapshot = KATANA_CHECKED(checkpointer.Restore());
+      if (snapshot) {
+        const size_t cluster_bytes = clusters_orig.size() * sizeof(uint64_t);
+        if (snapshot->sections.size() == 2 &&
+            snapshot->sections[0].size() == sizeof(CheckpointScalars) &&
+            snapshot->sections[1].size() == cluster_bytes) {
+          CheckpointScalars scalars{};
+          memcpy(&scalars, snapshot->sections[0].data(), sizeof(scalars));
+          memcpy(
+              clusters_orig.data(), snapshot->sections[1].data(),
+              cluster_bytes);
+
+          // Rebuild the coarsened working graph the snapshot was taken
+          // with: re-seed the saved assignment on the original graph and
+          // coarsen once, the same construction the vertex-following setup
+          // uses below.
+          katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+            graph_curr.template GetData<CurrentCommunityID>(n) =
+                clusters_orig[n];
+          });
+          uint64_t num_unique_clusters =
+              Base::template RenumberClustersContiguously<CurrentCommunityID>(
+                  &graph_curr);
+          katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+            clusters_orig[n] =
+                graph_curr.template GetData<CurrentCommunityID>(n);
+          });
+
+          auto pg_empty = std::make_unique<katana::PropertyGraph>();
+          pg_mutable = KATANA_CHECKED((Base::template GraphCoarsening<
+                                       NodeData, EdgeData, EdgeWeightType,
+                                       CurrentCommunityID>(
+              graph_curr, pg_empty.get(), num_unique_clusters,
+              temp_node_property_names, temp_edge_property_names)));
+
+          restored_phase = snapshot->round;
+          restored_iter = scalars.iter;
+          restored_mod = scalars.modularity;
+          resumed = true;
+        } else {
+          KATANA_LOG_WARN(
+              "ignoring checkpoint whose shape does not match the graph");
+        }
+      }
+    }
+
     /*
     * Vertex following optimization
     */
-    if (plan.enable_vf()) {
+    if (resumed) {
+      // working graph already rebuilt from the checkpoint
+    } else if (plan.enable_vf()) {
       Base::VertexFollowing(&graph_curr);  // Find nodes that follow other nodes
 
       uint64_t num_unique_clusters =
@@ -416,12 +483,12 @@ public:
 
     KATANA_LOG_ASSERT(pg_mutable);
 
-    double prev_mod = -1;  // Previous modularity
-    double curr_mod = -1;  // Current modularity
-    uint32_t phase = 0;
+    double prev_mod = restored_mod;  // Previous modularity
+    double curr_mod = restored_mod;  // Current modularity
+    uint32_t phase = restored_phase;
 
     std::unique_ptr<katana::PropertyGraph> pg_curr = std::move(pg_mutable);
-    uint32_t iter = 0;
+    uint32_t iter = restored_iter;
     uint64_t num_nodes_orig = clusters_orig.size();
     while (true) {
       iter++;
@@ -433,13 +500,13 @@ public:
         case LouvainClusteringPlan::kDoAll: {
           curr_mod = KATANA_CHECKED(LouvainWithoutLockingDoAll(
               pg_curr.get(), curr_mod, plan.modularity_threshold_per_round(),
-              iter));
+              iter, plan.resolution()));
           break;
         }
         case LouvainClusteringPlan::kDeterministic: {
           curr_mod = KATANA_CHECKED(LouvainDeterministic(
               pg_curr.get(), curr_mod, plan.modularity_threshold_per_round(),
-              iter));
+              iter, plan.resolution()));
           break;
         }
         default:
@@ -475,6 +542,22 @@ public:
               });
         }
 
+        // the assignment now reflects the finished phase; the store drains
+        // in the background while the coarsening below proceeds
+        if (checkpointer.Due(phase)) {
+          CheckpointScalars scalars{};
+          scalars.iter = iter;
+          scalars.modularity = curr_mod;
+          if (auto res = checkpointer.Save(
+                  phase,
+                  {{&scalars, sizeof(scalars)},
+                   {clusters_orig.data(),
+                    num_nodes_orig * sizeof(uint64_t)}});
+              !res) {
+            KATANA_LOG_WARN("louvain checkpoint failed: {}", res.error());
+          }
+        }
+
         auto coarsened_graph_result = Base::template GraphCoarsening<
             NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
             graph_curr, pg_curr.get(), num_unique_clusters,
@@ -492,6 +575,174 @@ public:
     }
     return katana::ResultSuccess();
   }
+
+  /// Run the clustering once per resolution, in decreasing order of
+  /// resolution, reusing the coarsened level hierarchy: each resolution
+  /// continues from the previous resolution's final coarsened graph instead
+  /// of rebuilding every level from the original graph.
+  katana::Result<void> LouvainClusteringResolutionSweep(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::vector<std::string>& temp_node_property_names,
+      const std::vector<double>& resolutions,
+      std::vector<katana::NUMAArray<uint64_t>>* clusters_per_resolution,
+      LouvainClusteringPlan plan) {
+    TemporaryPropertyGuard temp_edge_property{pg->EdgeMutablePropertyView()};
+    std::vector<std::string> temp_edge_property_names = {
+        temp_edge_property.name()};
+
+    /*
+     * Construct temp property graph. This graph gets coarsened as the
+     * computation proceeds.
+     */
+    std::unique_ptr<katana::PropertyGraph> pg_mutable;
+
+    Graph graph_curr = KATANA_CHECKED(
+        Graph::Make(pg, temp_node_property_names, {edge_weight_property_name}));
+
+    /*
+     * To keep track of communities for nodes in the original graph.
+     * Community will be set to -1 for isolated nodes
+     */
+    katana::NUMAArray<uint64_t> clusters_orig;
+    clusters_orig.allocateBlocked(graph_curr.num_nodes());
+
+    /*
+    * Vertex following optimization
+    */
+    if (plan.enable_vf()) {
+      Base::VertexFollowing(&graph_curr);  // Find nodes that follow other nodes
+
+      uint64_t num_unique_clusters =
+          Base::template RenumberClustersContiguously<CurrentCommunityID>(
+              &graph_curr);
+
+      /*
+     * Initialize node cluster id.
+     */
+      katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+        clusters_orig[n] = graph_curr.template GetData<CurrentCommunityID>(n);
+      });
+
+      auto pg_empty = std::make_unique<katana::PropertyGraph>();
+
+      // Build new graph to remove the isolated nodes
+      auto coarsened_graph_result = Base::template GraphCoarsening<
+          NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
+          graph_curr, pg_empty.get(), num_unique_clusters,
+          temp_node_property_names, temp_edge_property_names);
+      if (!coarsened_graph_result) {
+        return coarsened_graph_result.error();
+      }
+
+      pg_mutable = std::move(coarsened_graph_result.value());
+
+    } else {
+      /*
+       * Initialize node cluster id.
+       */
+      katana::do_all(
+          katana::iterate(graph_curr), [&](GNode n) { clusters_orig[n] = -1; });
+
+      auto pg_dup = KATANA_CHECKED(Base::template DuplicateGraph<NodeData>(
+          pg, edge_weight_property_name, temp_edge_property_names[0]));
+
+      pg_mutable = std::move(pg_dup);
+    }
+
+    KATANA_LOG_ASSERT(pg_mutable);
+
+    uint32_t phase = 0;
+
+    std::unique_ptr<katana::PropertyGraph> pg_curr = std::move(pg_mutable);
+    uint64_t num_nodes_orig = clusters_orig.size();
+
+    clusters_per_resolution->resize(resolutions.size());
+    for (size_t r = 0; r < resolutions.size(); ++r) {
+      double prev_mod = -1;  // Previous modularity
+      double curr_mod = -1;  // Current modularity
+      uint32_t iter = 0;
+
+      while (true) {
+        iter++;
+        phase++;
+
+        Graph graph_level = KATANA_CHECKED(Graph::Make(pg_curr.get()));
+        if (graph_level.num_nodes() > plan.min_graph_size()) {
+          switch (plan.algorithm()) {
+          case LouvainClusteringPlan::kDoAll: {
+            curr_mod = KATANA_CHECKED(LouvainWithoutLockingDoAll(
+                pg_curr.get(), curr_mod, plan.modularity_threshold_per_round(),
+                iter, resolutions[r]));
+            break;
+          }
+          case LouvainClusteringPlan::kDeterministic: {
+            curr_mod = KATANA_CHECKED(LouvainDeterministic(
+                pg_curr.get(), curr_mod, plan.modularity_threshold_per_round(),
+                iter, resolutions[r]));
+            break;
+          }
+          default:
+            return KATANA_ERROR(
+                katana::ErrorCode::InvalidArgument, "Unknown algorithm");
+          }
+        } else {
+          break;
+        }
+
+        uint64_t num_unique_clusters =
+            Base::template RenumberClustersContiguously<CurrentCommunityID>(
+                &graph_level);
+
+        if (iter < plan.max_iterations() &&
+            (curr_mod - prev_mod) > plan.modularity_threshold_total()) {
+          if (!plan.enable_vf() && phase == 1) {
+            KATANA_LOG_DEBUG_ASSERT(num_nodes_orig == graph_level.num_nodes());
+            katana::do_all(katana::iterate(graph_level), [&](GNode n) {
+              clusters_orig[n] =
+                  graph_level.template GetData<CurrentCommunityID>(n);
+            });
+          } else {
+            katana::do_all(
+                katana::iterate((uint64_t)0, num_nodes_orig), [&](GNode n) {
+                  if (clusters_orig[n] != Base::UNASSIGNED) {
+                    KATANA_LOG_DEBUG_ASSERT(
+                        clusters_orig[n] < graph_level.num_nodes());
+                    clusters_orig[n] =
+                        graph_level.template GetData<CurrentCommunityID>(
+                            clusters_orig[n]);
+                  }
+                });
+          }
+
+          auto coarsened_graph_result = Base::template GraphCoarsening<
+              NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
+              graph_level, pg_curr.get(), num_unique_clusters,
+              temp_node_property_names, temp_edge_property_names);
+          if (!coarsened_graph_result) {
+            return coarsened_graph_result.error();
+          }
+
+          pg_curr = std::move(coarsened_graph_result.value());
+
+          prev_mod = curr_mod;
+        } else {
+          break;
+        }
+      }
+
+      /*
+       * Snapshot the clustering for this resolution; pg_curr (one node per
+       * final community) carries over as the starting level for the next,
+       * smaller, resolution.
+       */
+      katana::NUMAArray<uint64_t>& clusters_out = (*clusters_per_resolution)[r];
+      clusters_out.allocateBlocked(num_nodes_orig);
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_nodes_orig),
+          [&](uint64_t n) { clusters_out[n] = clusters_orig[n]; });
+    }
+    return katana::ResultSuccess();
+  }
 };
 
 template <typename EdgeWeightType>
@@ -569,6 +820,59 @@ LouvainClusteringWithWrap(
   return katana::ResultSuccess();
 }
 
+template <typename EdgeWeightType>
+static katana::Result<void>
+LouvainClusteringResolutionSweepWithWrap(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::vector<double>& resolutions,
+    const std::vector<std::string>& output_property_names,
+    LouvainClusteringPlan plan) {
+  static_assert(
+      std::is_integral_v<EdgeWeightType> ||
+      std::is_floating_point_v<EdgeWeightType>);
+
+  std::vector<TemporaryPropertyGuard> temp_node_properties(3);
+  std::generate_n(
+      temp_node_properties.begin(), temp_node_properties.size(),
+      [&]() { return TemporaryPropertyGuard{pg->NodeMutablePropertyView()}; });
+  std::vector<std::string> temp_node_property_names(
+      temp_node_properties.size());
+  std::transform(
+      temp_node_properties.begin(), temp_node_properties.end(),
+      temp_node_property_names.begin(),
+      [](const TemporaryPropertyGuard& p) { return p.name(); });
+
+  using Impl = LouvainClusteringImplementation<EdgeWeightType>;
+  KATANA_CHECKED(ConstructNodeProperties<typename Impl::NodeData>(
+      pg, temp_node_property_names));
+
+  std::vector<katana::NUMAArray<uint64_t>> clusters_per_resolution;
+
+  LouvainClusteringImplementation<EdgeWeightType> impl{};
+  KATANA_CHECKED(impl.LouvainClusteringResolutionSweep(
+      pg, edge_weight_property_name, temp_node_property_names, resolutions,
+      &clusters_per_resolution, plan));
+
+  for (size_t r = 0; r < resolutions.size(); ++r) {
+    KATANA_CHECKED(ConstructNodeProperties<std::tuple<CurrentCommunityID>>(
+        pg, {output_property_names[r]}));
+
+    auto graph = KATANA_CHECKED(
+        (katana::TypedPropertyGraph<
+            std::tuple<CurrentCommunityID>,
+            std::tuple<>>::Make(pg, {output_property_names[r]}, {})));
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](uint32_t i) {
+          graph.GetData<CurrentCommunityID>(i) = clusters_per_resolution[r][i];
+        },
+        katana::loopname("Add clusterIDs"), katana::no_stats());
+  }
+
+  return katana::ResultSuccess();
+}
+
 }  // anonymous namespace
 
 katana::Result<void>
@@ -623,13 +927,114 @@ katana::analytics::LouvainClustering(
   }
 }
 
+katana::Result<void>
+katana::analytics::LouvainClusteringResolutionSweep(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::vector<double>& resolutions,
+    const std::vector<std::string>& output_property_names,
+    LouvainClusteringPlan plan) {
+  if (resolutions.empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "no resolutions to sweep");
+  }
+  if (resolutions.size() != output_property_names.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "expected one output property per resolution: {} resolutions, {} "
+        "output properties",
+        resolutions.size(), output_property_names.size());
+  }
+  if (!std::is_sorted(resolutions.rbegin(), resolutions.rend())) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "resolutions must be in decreasing order so the level hierarchy can "
+        "be reused between resolutions");
+  }
+  if (!edge_weight_property_name.empty() &&
+      !pg->HasEdgeProperty(edge_weight_property_name)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotFound, "Edge Property: {} Not found",
+        edge_weight_property_name);
+  }
+  // If edge property name empty, add int64_t property
+  // add initialize it to 1.
+  if (edge_weight_property_name.empty()) {
+    TemporaryPropertyGuard temporary_edge_property{
+        pg->EdgeMutablePropertyView()};
+    struct EdgeWt : public katana::PODProperty<int64_t> {};
+    KATANA_CHECKED(
+        AddDefaultEdgeWeight<EdgeWt>(pg, temporary_edge_property.name()));
+    return LouvainClusteringResolutionSweepWithWrap<int64_t>(
+        pg, temporary_edge_property.name(), resolutions, output_property_names,
+        plan);
+  }
+
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return LouvainClusteringResolutionSweepWithWrap<uint32_t>(
+        pg, edge_weight_property_name, resolutions, output_property_names,
+        plan);
+  case arrow::Int32Type::type_id:
+    return LouvainClusteringResolutionSweepWithWrap<int32_t>(
+        pg, edge_weight_property_name, resolutions, output_property_names,
+        plan);
+  case arrow::UInt64Type::type_id:
+    return LouvainClusteringResolutionSweepWithWrap<uint64_t>(
+        pg, edge_weight_property_name, resolutions, output_property_names,
+        plan);
+  case arrow::Int64Type::type_id:
+    return LouvainClusteringResolutionSweepWithWrap<int64_t>(
+        pg, edge_weight_property_name, resolutions, output_property_names,
+        plan);
+  case arrow::FloatType::type_id:
+    return LouvainClusteringResolutionSweepWithWrap<float>(
+        pg, edge_weight_property_name, resolutions, output_property_names,
+        plan);
+  case arrow::DoubleType::type_id:
+    return LouvainClusteringResolutionSweepWithWrap<double>(
+        pg, edge_weight_property_name, resolutions, output_property_names,
+        plan);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::LouvainClusteringAssertValid(
-    [[maybe_unused]] katana::PropertyGraph* pg,
+    katana::PropertyGraph* pg,
     [[maybe_unused]] const std::string& edge_weight_property_name,
-    [[maybe_unused]] const std::string& property_name) {
-  // TODO(gill): This should have real checks.
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(
+      (katana::TypedPropertyGraph<
+          std::tuple<PreviousCommunityID>,
+          std::tuple<>>::Make(pg, {property_name}, {})));
+
+  // Cluster quality is what the modularity statistic reports; validity here
+  // means every node landed in a real cluster.
+  katana::GAccumulator<uint64_t> num_invalid;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        uint64_t comm_id = graph.GetData<PreviousCommunityID>(n);
+        if (comm_id >= graph.size()) {
+          num_invalid += 1;
+        }
+      },
+      katana::loopname("LouvainClustering validation"), katana::no_stats());
+
+  if (num_invalid.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "{} nodes have an unassigned or out-of-range cluster id",
+        num_invalid.reduce());
+  }
   return katana::ResultSuccess();
 }
 /// \endcond
@@ -19,6 +19,7 @@
 
 #include "katana/analytics/matrix_completion/matrix_completion.h"
 
+#include <algorithm>
 #include <cmath>
 #include <type_traits>
 #include <utility>
@@ -31,6 +32,7 @@
 #include "katana/ParallelSTL.h"
 #include "katana/Properties.h"
 #include "katana/Reduction.h"
+#include "katana/TiledExecutor.h"
 #include "katana/Timer.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/MatrixCompletionImplementationBase.h"
@@ -102,6 +104,33 @@ struct MatrixCompletionImplementation
     return error;
   }
 
+  // Same objective as DoGradientUpdate, but the latent vectors are read and
+  // written with plain relaxed accesses instead of the CAS loop that
+  // katana::atomicAdd needs for doubles. Safe when the caller guarantees
+  // exclusive access to both vectors (tiled execution); otherwise this is a
+  // Hogwild-style update where an occasional lost component update is
+  // tolerated.
+  template <typename NodeIndex>
+  double DoGradientUpdateUnsync(
+      katana::PropertyReferenceType<NodeIndex> item_latent_vector,
+      katana::PropertyReferenceType<NodeIndex> user_latent_vector,
+      double lambda, double edge_rating, double step_size) {
+    double error = edge_rating - InnerProduct<NodeIndex>(
+                                     item_latent_vector, user_latent_vector);
+    // Take gradient step to reduce error
+    for (int i = 0; i < LATENT_VECTOR_SIZE; i++) {
+      double prev_item = item_latent_vector[i].load(std::memory_order_relaxed);
+      double prev_user = user_latent_vector[i].load(std::memory_order_relaxed);
+      item_latent_vector[i].store(
+          prev_item + step_size * (error * prev_user - lambda * prev_item),
+          std::memory_order_relaxed);
+      user_latent_vector[i].store(
+          prev_user + step_size * (error * prev_item - lambda * prev_user),
+          std::memory_order_relaxed);
+    }
+    return error;
+  }
+
   struct StepFunction {
     virtual LatentValue StepSize(
         int round, MatrixCompletionPlan plan) const = 0;
@@ -368,6 +397,175 @@ public:
   }
 };
 
+class SGDItemsHogwildAlgo {
+public:
+  bool IsSgd() const { return true; }
+
+  std::string Name() const { return "sgdItemsHogwildAlgo"; }
+
+  size_t NumItems() const { return kNumItemNodes; }
+
+private:
+  struct Execute {
+    Graph& graph;
+    katana::GAccumulator<unsigned>& edges_visited;
+
+    void operator()(
+        LatentValue* steps, int, katana::GAccumulator<double>* error_accum,
+        MatrixCompletionPlan plan, MatrixCompletionImplementation impl) {
+      const LatentValue step_size = steps[0];
+      katana::do_all(
+          katana::iterate(graph.begin(), graph.begin() + kNumItemNodes),
+          [&](GNode src) {
+            for (auto ii : graph.edges(src)) {
+              auto dst = graph.GetEdgeDest(ii);
+              auto item_latent_vector = graph.GetData<NodeLatentVector>(src);
+              auto user_latent_vector = graph.GetData<NodeLatentVector>(dst);
+              LatentValue error = impl.DoGradientUpdateUnsync<NodeLatentVector>(
+                  item_latent_vector, user_latent_vector, plan.lambda(),
+                  graph.GetEdgeData<EdgeWeight>(ii), step_size);
+
+              edges_visited += 1;
+              if (plan.useExactError())
+                *error_accum += error;
+            }
+          },
+          katana::loopname("sgdItemsHogwildAlgo"));
+    }
+  };
+
+public:
+  void operator()(
+      Graph& graph, const MatrixCompletionImplementation::StepFunction& sf,
+      MatrixCompletionPlan plan, MatrixCompletionImplementation impl) {
+    katana::GAccumulator<unsigned> edges_visited;
+
+    katana::StatTimer executeTimer("Time");
+    executeTimer.start();
+
+    Execute fn{graph, edges_visited};
+    ExecuteUntilConverged(sf, graph, fn, plan, impl);
+
+    executeTimer.stop();
+
+    katana::ReportStatSingle(
+        "sgdItemsHogwildAlgo", "EdgesVisited", edges_visited.reduce());
+  }
+};
+
+/// Adapter exposing the legacy graph interface that
+/// katana::Fixed2DGraphTiledExecutor expects on top of a TypedPropertyGraph.
+struct TiledGraph {
+  using GraphNode = GNode;
+  using iterator = Graph::iterator;
+  using edge_iterator = Graph::edge_iterator;
+
+  Graph& graph;
+
+  iterator begin() { return graph.begin(); }
+  iterator end() { return graph.end(); }
+
+  GraphNode getEdgeDst(edge_iterator edge) { return *graph.GetEdgeDest(edge); }
+
+  edge_iterator edge_begin(GraphNode n, katana::MethodFlag) {
+    return graph.edge_begin(n);
+  }
+  edge_iterator edge_end(GraphNode n, katana::MethodFlag) {
+    return graph.edge_end(n);
+  }
+};
+
+/// The tiled executor binary-searches each item's edge list for the user
+/// range of a tile, so destinations must be in ascending order.
+bool
+EdgesSortedByDest(const katana::PropertyGraph& pg) {
+  const auto& topo = pg.topology();
+  katana::GAccumulator<uint64_t> unsorted;
+
+  katana::do_all(
+      katana::iterate(topo.all_nodes()),
+      [&](katana::GraphTopology::Node n) {
+        auto dest_less = [&](
+                             katana::GraphTopology::Edge e1,
+                             katana::GraphTopology::Edge e2) {
+          return topo.edge_dest(e1) < topo.edge_dest(e2);
+        };
+        auto edge_range = topo.edges(n);
+        if (!std::is_sorted(edge_range.begin(), edge_range.end(), dest_less)) {
+          unsorted += 1;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return unsorted.reduce() == 0;
+}
+
+/**
+ * Simple edge-wise operator.
+ * Uses Fixed2DGraphTiledExecutor to divide items and users into blocks and
+ * locks the item and user rows of each block, so gradient updates inside a
+ * block never race and can skip atomics entirely.
+ */
+class SGDBlockEdgeAlgo {
+public:
+  bool IsSgd() const { return true; }
+
+  std::string Name() const { return "sgdBlockEdgeAlgo"; }
+
+  size_t NumItems() const { return kNumItemNodes; }
+
+private:
+  struct Execute {
+    Graph& graph;
+    katana::GAccumulator<unsigned>& edges_visited;
+
+    void operator()(
+        LatentValue* steps, int, katana::GAccumulator<double>* error_accum,
+        MatrixCompletionPlan plan, MatrixCompletionImplementation impl) {
+      TiledGraph tiled{graph};
+      katana::Fixed2DGraphTiledExecutor<TiledGraph> executor(tiled);
+      const LatentValue step_size = steps[0];
+      executor.execute(
+          graph.begin(), graph.begin() + kNumItemNodes,
+          graph.begin() + kNumItemNodes, graph.end(), plan.itemsPerBlock(),
+          plan.usersPerBlock(),
+          [&](GNode src, GNode dst, TiledGraph::edge_iterator edge) {
+            auto item_latent_vector = graph.GetData<NodeLatentVector>(src);
+            auto user_latent_vector = graph.GetData<NodeLatentVector>(dst);
+            // The block's item and user rows are locked, so this thread has
+            // exclusive access to both latent vectors.
+            LatentValue error = impl.DoGradientUpdateUnsync<NodeLatentVector>(
+                item_latent_vector, user_latent_vector, plan.lambda(),
+                graph.GetEdgeData<EdgeWeight>(edge), step_size);
+
+            edges_visited += 1;
+            if (plan.useExactError())
+              *error_accum += error;
+          },
+          true  // use locks
+      );
+    }
+  };
+
+public:
+  void operator()(
+      Graph& graph, const MatrixCompletionImplementation::StepFunction& sf,
+      MatrixCompletionPlan plan, MatrixCompletionImplementation impl) {
+    katana::GAccumulator<unsigned> edges_visited;
+
+    katana::StatTimer executeTimer("Time");
+    executeTimer.start();
+
+    Execute fn{graph, edges_visited};
+    ExecuteUntilConverged(sf, graph, fn, plan, impl);
+
+    executeTimer.stop();
+
+    katana::ReportStatSingle(
+        "sgdBlockEdgeAlgo", "EdgesVisited", edges_visited.reduce());
+  }
+};
+
 template <typename Algo>
 katana::Result<void>
 Run(katana::PropertyGraph* pg, MatrixCompletionPlan plan) {
@@ -401,6 +599,15 @@ katana::analytics::MatrixCompletion(
   switch (plan.algorithm()) {
   case MatrixCompletionPlan::kSGDByItems:
     return Run<SGDItemsAlgo>(pg, plan);
+  case MatrixCompletionPlan::kSGDByItemsHogwild:
+    return Run<SGDItemsHogwildAlgo>(pg, plan);
+  case MatrixCompletionPlan::kSGDBlockEdge:
+    if (!EdgesSortedByDest(*pg)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "SGDBlockEdge requires edge lists sorted by destination ID");
+    }
+    return Run<SGDBlockEdgeAlgo>(pg, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -0,0 +1,342 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
+
+#include <atomic>
+
+#include "katana/Bag.h"
+#include "katana/NUMAArray.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/UnionFind.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+constexpr static const unsigned kChunkSize = 16U;
+
+template <typename Weight>
+using MSFEdgeWeight = katana::PODProperty<Weight>;
+
+struct MSFEdgeInForest : public katana::PODProperty<uint8_t> {};
+
+/**
+ * Bulk-synchronous Boruvka. Every round each component nominates the
+ * lightest candidate edge leaving it, components are merged along the
+ * nominated edges with lock-free union-find, and the candidate edge list is
+ * filtered and compacted into the next round's bag so edges internal to a
+ * component are inspected only once.
+ *
+ * Ties between equal weights are broken by edge ID, which makes the forest
+ * the unique minimum under the (weight, edge ID) order: every nominated edge
+ * belongs to it by the cut property, so the output is deterministic no
+ * matter how the merges are scheduled.
+ */
+template <typename Weight>
+struct BoruvkaAlgo {
+  using NodeData = std::tuple<>;
+  using EdgeData = std::tuple<MSFEdgeWeight<Weight>, MSFEdgeInForest>;
+  using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+  using GNode = typename Graph::Node;
+  using Edge = typename Graph::Edge;
+
+  /// A candidate edge, kept in the canonical (src < dst) direction.
+  struct WorkEdge {
+    GNode src;
+    GNode dst;
+    Edge eid;
+    Weight weight;
+  };
+
+  struct ComponentNode : public katana::UnionFindNode<ComponentNode> {
+    std::atomic<const WorkEdge*> lightest;
+    ComponentNode()
+        : katana::UnionFindNode<ComponentNode>(this), lightest(nullptr) {}
+  };
+
+  /// Total order on candidate edges: weight first, edge ID to break ties.
+  /// A null incumbent loses to any edge.
+  static bool Lighter(const WorkEdge* a, const WorkEdge* b) {
+    if (b == nullptr) {
+      return true;
+    }
+    return a->weight < b->weight ||
+           (a->weight == b->weight && a->eid < b->eid);
+  }
+
+  static void UpdateLightest(ComponentNode* rep, const WorkEdge* e) {
+    const WorkEdge* old = rep->lightest.load(std::memory_order_relaxed);
+    while (Lighter(e, old)) {
+      if (rep->lightest.compare_exchange_weak(old, e)) {
+        break;
+      }
+    }
+  }
+
+  katana::Result<void> operator()(Graph* graph) {
+    katana::StatTimer exec_time(
+        "MinimumSpanningForest", "MinimumSpanningForest");
+    exec_time.start();
+
+    katana::NUMAArray<ComponentNode> components;
+    components.allocateInterleaved(graph->num_nodes());
+    components.construct();
+
+    katana::InsertBag<WorkEdge> bags[2];
+    katana::InsertBag<WorkEdge>* cur = &bags[0];
+    katana::InsertBag<WorkEdge>* next = &bags[1];
+
+    // Clear the output property and collect the canonical direction of every
+    // edge as the initial candidate list.
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          for (auto e : graph->edges(n)) {
+            graph->template GetEdgeData<MSFEdgeInForest>(e) = 0;
+            GNode dst = *graph->GetEdgeDest(e);
+            if (n < dst) {
+              cur->push(WorkEdge{
+                  n, dst, e,
+                  graph->template GetEdgeData<MSFEdgeWeight<Weight>>(e)});
+            }
+          }
+        },
+        katana::chunk_size<kChunkSize>(), katana::steal(),
+        katana::loopname("MSFInitialize"));
+
+    size_t rounds = 0;
+
+    while (!cur->empty()) {
+      rounds += 1;
+
+      // Nominate each component's lightest outgoing candidate. The WorkEdge
+      // pointers are stable for the round because the bag is not modified
+      // until compaction.
+      katana::do_all(
+          katana::iterate(*cur),
+          [&](const WorkEdge& e) {
+            ComponentNode* src_rep = components[e.src].findAndCompress();
+            ComponentNode* dst_rep = components[e.dst].findAndCompress();
+            if (src_rep == dst_rep) {
+              return;
+            }
+            UpdateLightest(src_rep, &e);
+            UpdateLightest(dst_rep, &e);
+          },
+          katana::chunk_size<kChunkSize>(), katana::steal(),
+          katana::loopname("MSFFindLightest"));
+
+      // Merge along the nominated edges. A nominated edge whose endpoints
+      // were already joined through other merges of this round fails the
+      // merge and is simply dropped during compaction.
+      katana::do_all(
+          katana::iterate(*cur),
+          [&](const WorkEdge& e) {
+            ComponentNode* src_rep = components[e.src].findAndCompress();
+            ComponentNode* dst_rep = components[e.dst].findAndCompress();
+            if (src_rep == dst_rep) {
+              return;
+            }
+            if (src_rep->lightest.load(std::memory_order_relaxed) == &e ||
+                dst_rep->lightest.load(std::memory_order_relaxed) == &e) {
+              if (components[e.src].merge(&components[e.dst])) {
+                graph->template GetEdgeData<MSFEdgeInForest>(e.eid) = 1;
+              }
+            }
+          },
+          katana::chunk_size<kChunkSize>(), katana::steal(),
+          katana::loopname("MSFMerge"));
+
+      // Compact the surviving candidates (those still crossing components)
+      // into the next round's bag and reset the nominations.
+      katana::do_all(
+          katana::iterate(*cur),
+          [&](const WorkEdge& e) {
+            ComponentNode* src_rep = components[e.src].findAndCompress();
+            ComponentNode* dst_rep = components[e.dst].findAndCompress();
+            if (src_rep != dst_rep) {
+              next->push(e);
+            }
+            src_rep->lightest.store(nullptr, std::memory_order_relaxed);
+            dst_rep->lightest.store(nullptr, std::memory_order_relaxed);
+          },
+          katana::chunk_size<kChunkSize>(), katana::steal(),
+          katana::loopname("MSFCompact"));
+
+      cur->clear();
+      std::swap(cur, next);
+    }
+
+    exec_time.stop();
+
+    katana::ReportStatSingle("MinimumSpanningForest", "Rounds", rounds);
+
+    return katana::ResultSuccess();
+  }
+};
+
+template <typename Weight>
+katana::Result<void>
+MinimumSpanningForestWithWrap(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, MinimumSpanningForestPlan plan) {
+  KATANA_CHECKED(ConstructEdgeProperties<std::tuple<MSFEdgeInForest>>(
+      pg, {output_property_name}));
+
+  using Graph = typename BoruvkaAlgo<Weight>::Graph;
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {}, {edge_weight_property_name, output_property_name}));
+
+  katana::EnsurePreallocated(8, 16 * (pg->num_nodes() + pg->num_edges()));
+  katana::ReportPageAllocGuard page_alloc;
+
+  switch (plan.algorithm()) {
+  case MinimumSpanningForestPlan::kBoruvka: {
+    BoruvkaAlgo<Weight> algo;
+    return algo(&graph);
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForest(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, MinimumSpanningForestPlan plan) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return MinimumSpanningForestWithWrap<uint32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return MinimumSpanningForestWithWrap<int32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return MinimumSpanningForestWithWrap<uint64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return MinimumSpanningForestWithWrap<int64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::FloatType::type_id:
+    return MinimumSpanningForestWithWrap<float>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return MinimumSpanningForestWithWrap<double>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+/// \cond DO_NOT_DOCUMENT
+namespace {
+
+template <typename Weight>
+katana::Result<MinimumSpanningForestStatistics>
+ComputeStatistics(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  using Graph = typename BoruvkaAlgo<Weight>::Graph;
+  using GNode = typename Graph::Node;
+
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {}, {edge_weight_property_name, property_name}));
+
+  katana::GAccumulator<uint64_t> forest_edges;
+  katana::GAccumulator<double> total_weight;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        for (auto e : graph.edges(node)) {
+          if (graph.template GetEdgeData<MSFEdgeInForest>(e)) {
+            forest_edges += 1;
+            total_weight += static_cast<double>(
+                graph.template GetEdgeData<MSFEdgeWeight<Weight>>(e));
+          }
+        }
+      },
+      katana::loopname("MinimumSpanningForest sanity check"),
+      katana::no_stats());
+
+  uint64_t num_forest_edges = forest_edges.reduce();
+
+  // The marked edges form a forest, so every edge joins two trees and
+  // isolated nodes count as trivial trees.
+  return MinimumSpanningForestStatistics{
+      pg->num_nodes() - num_forest_edges, num_forest_edges,
+      total_weight.reduce()};
+}
+
+}  // namespace
+
+katana::Result<MinimumSpanningForestStatistics>
+katana::analytics::MinimumSpanningForestStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return ComputeStatistics<uint32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int32Type::type_id:
+    return ComputeStatistics<int32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::UInt64Type::type_id:
+    return ComputeStatistics<uint64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int64Type::type_id:
+    return ComputeStatistics<int64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::FloatType::type_id:
+    return ComputeStatistics<float>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::DoubleType::type_id:
+    return ComputeStatistics<double>(
+        pg, edge_weight_property_name, property_name);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+/// \endcond DO_NOT_DOCUMENT
+
+void
+katana::analytics::MinimumSpanningForestStatistics::Print(
+    std::ostream& os) const {
+  os << "Number of trees = " << number_of_trees << std::endl;
+  os << "Number of forest edges = " << number_of_forest_edges << std::endl;
+  os << "Total weight = " << total_weight << std::endl;
+}
@@ -0,0 +1,350 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/neighbor_sampling/neighbor_sampling.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <arrow/compute/api_vector.h>
+
+#include "katana/NUMAArray.h"
+#include "katana/Random.h"
+#include "katana/analytics/Utils.h"
+
+namespace {
+
+using namespace katana::analytics;
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+//! Copy an arrow weight column into a flat array indexed by edge property
+//! index; null weights count as zero.
+template <typename ArrowType>
+void
+CopyEdgeWeights(
+    const arrow::ChunkedArray& weights, katana::NUMAArray<double>* out) {
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+
+  int64_t index = 0;
+  for (const auto& chunk : weights.chunks()) {
+    auto array = std::static_pointer_cast<ArrayType>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i, ++index) {
+      (*out)[index] =
+          array->IsValid(i) ? static_cast<double>(array->Value(i)) : 0.0;
+    }
+  }
+}
+
+/// Gather the rows named by \p rows out of the named property columns,
+/// one arrow Take per column; returns null if no columns were requested.
+template <typename ColumnFn>
+katana::Result<std::shared_ptr<arrow::Table>>
+GatherRows(
+    const ColumnFn& column_fn, const std::vector<std::string>& names,
+    const std::vector<uint64_t>& rows) {
+  if (names.empty()) {
+    return std::shared_ptr<arrow::Table>();
+  }
+
+  arrow::UInt64Builder rows_builder;
+  KATANA_CHECKED(rows_builder.Reserve(rows.size()));
+  for (uint64_t row : rows) {
+    rows_builder.UnsafeAppend(row);
+  }
+  std::shared_ptr<arrow::Array> indices =
+      KATANA_CHECKED(rows_builder.Finish());
+
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (const std::string& name : names) {
+    std::shared_ptr<arrow::ChunkedArray> column =
+        KATANA_CHECKED(column_fn(name));
+    auto taken = arrow::compute::Take(column, indices);
+    if (!taken.ok()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::ArrowError, "gathering property {}: {}", name,
+          taken.status().ToString());
+    }
+    fields.push_back(arrow::field(name, column->type()));
+    columns.push_back(taken.ValueOrDie().chunked_array());
+  }
+
+  return arrow::Table::Make(arrow::schema(fields), columns);
+}
+
+/// Expand one batch of seeds hop by hop and assemble the renumbered CSR
+/// and property rows. Runs entirely on the calling thread; batches are
+/// the unit of parallelism.
+katana::Result<NeighborSampleBatch>
+BuildBatch(
+    const katana::PropertyGraph& pg, const katana::GraphTopology& topo,
+    const Node* seeds, uint32_t num_seeds,
+    const katana::NUMAArray<double>* edge_weight,
+    const std::vector<std::string>& node_property_names,
+    const std::vector<std::string>& edge_property_names,
+    const NeighborSamplingPlan& plan) {
+  katana::RandGenerator& gen = katana::GetGenerator();
+
+  NeighborSampleBatch batch;
+  batch.num_seeds = num_seeds;
+
+  std::unordered_map<Node, uint32_t> local_ids;
+  local_ids.reserve(num_seeds);
+  batch.node_ids.reserve(num_seeds);
+  for (uint32_t i = 0; i < num_seeds; ++i) {
+    if (!local_ids.emplace(seeds[i], i).second) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "duplicate seed {} in batch: seeds within a batch must be "
+          "distinct so batch rows align with the seeds",
+          seeds[i]);
+    }
+    batch.node_ids.push_back(seeds[i]);
+  }
+
+  struct SampledEdge {
+    uint32_t src;
+    uint32_t dst;
+    uint64_t property_index;
+  };
+  std::vector<SampledEdge> edges;
+
+  std::vector<double> cumulative;
+
+  // The frontier of each hop is the contiguous suffix of node_ids added
+  // by the previous hop (the seeds for hop zero).
+  size_t frontier_begin = 0;
+  for (uint32_t fanout : plan.fanouts()) {
+    size_t frontier_end = batch.node_ids.size();
+    for (size_t idx = frontier_begin; idx < frontier_end; ++idx) {
+      Node src = batch.node_ids[idx];
+      uint64_t degree = topo.degree(src);
+      if (degree == 0) {
+        continue;
+      }
+      Edge first = *topo.edges(src).begin();
+
+      auto take = [&](Edge e) {
+        Node dest = topo.edge_dest(e);
+        auto [it, inserted] =
+            local_ids.emplace(dest, batch.node_ids.size());
+        if (inserted) {
+          batch.node_ids.push_back(dest);
+        }
+        edges.push_back(SampledEdge{
+            static_cast<uint32_t>(idx), it->second,
+            topo.edge_property_index(e)});
+      };
+
+      if (degree <= fanout) {
+        for (Edge e : topo.edges(src)) {
+          take(e);
+        }
+      } else if (edge_weight == nullptr) {
+        // Floyd's algorithm: fanout distinct offsets in [0, degree)
+        std::unordered_set<uint64_t> picked;
+        for (uint64_t j = degree - fanout; j < degree; ++j) {
+          uint64_t t = std::uniform_int_distribution<uint64_t>(0, j)(gen);
+          if (!picked.insert(t).second) {
+            picked.insert(j);
+          }
+        }
+        for (uint64_t offset : picked) {
+          take(first + offset);
+        }
+      } else {
+        // Weighted draws with replacement: a running prefix sum over the
+        // node's weights and a binary search per draw. Each node is
+        // sampled at most fanout times, so this beats building the
+        // global alias tables random_walks uses for full-length walks.
+        cumulative.clear();
+        double total = 0.0;
+        for (uint64_t offset = 0; offset < degree; ++offset) {
+          total += (*edge_weight)[topo.edge_property_index(first + offset)];
+          cumulative.push_back(total);
+        }
+        for (uint32_t draw = 0; draw < fanout; ++draw) {
+          uint64_t offset;
+          if (total > 0.0) {
+            double r =
+                std::uniform_real_distribution<double>(0.0, total)(gen);
+            offset = std::lower_bound(
+                         cumulative.begin(), cumulative.end(), r) -
+                     cumulative.begin();
+            if (offset >= degree) {
+              offset = degree - 1;
+            }
+          } else {
+            // all weights zero: fall back to a uniform draw
+            offset =
+                std::uniform_int_distribution<uint64_t>(0, degree - 1)(gen);
+          }
+          take(first + offset);
+        }
+      }
+    }
+    frontier_begin = frontier_end;
+  }
+
+  // Counting sort of the sampled edges by local source id gives the CSR.
+  uint64_t num_local = batch.node_ids.size();
+  batch.adj_indices.assign(num_local, 0);
+  for (const SampledEdge& e : edges) {
+    ++batch.adj_indices[e.src];
+  }
+  std::partial_sum(
+      batch.adj_indices.begin(), batch.adj_indices.end(),
+      batch.adj_indices.begin());
+
+  batch.dests.resize(edges.size());
+  batch.edge_property_indices.resize(edges.size());
+  std::vector<uint64_t> offsets(num_local);
+  for (uint64_t n = 1; n < num_local; ++n) {
+    offsets[n] = batch.adj_indices[n - 1];
+  }
+  for (const SampledEdge& e : edges) {
+    uint64_t pos = offsets[e.src]++;
+    batch.dests[pos] = e.dst;
+    batch.edge_property_indices[pos] = e.property_index;
+  }
+
+  // node_ids doubles as the property row list: on the default topology a
+  // node's property row is its node id.
+  std::vector<uint64_t> node_rows(
+      batch.node_ids.begin(), batch.node_ids.end());
+  batch.node_features = KATANA_CHECKED(GatherRows(
+      [&](const std::string& name) { return pg.GetNodeProperty(name); },
+      node_property_names, node_rows));
+  batch.edge_features = KATANA_CHECKED(GatherRows(
+      [&](const std::string& name) { return pg.GetEdgeProperty(name); },
+      edge_property_names, batch.edge_property_indices));
+
+  return batch;
+}
+
+}  // namespace
+
+katana::Result<std::vector<katana::analytics::NeighborSampleBatch>>
+katana::analytics::SampleNeighborhoods(
+    katana::PropertyGraph* pg, const std::vector<PropertyGraph::Node>& seeds,
+    uint32_t batch_size, const std::vector<std::string>& node_property_names,
+    const std::vector<std::string>& edge_property_names,
+    const std::string& edge_weight_property_name, NeighborSamplingPlan plan) {
+  if (batch_size == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "batch_size must be positive");
+  }
+  if (plan.fanouts().empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "plan must specify at least one hop");
+  }
+
+  const katana::GraphTopology& topo = pg->topology();
+  for (PropertyGraph::Node seed : seeds) {
+    if (seed >= topo.num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "seed {} is not in the graph",
+          seed);
+    }
+  }
+
+  //! Weights indexed by edge property row; only extracted for the
+  //! weighted plan.
+  katana::NUMAArray<double> edge_weight;
+  bool weighted = plan.algorithm() == NeighborSamplingPlan::kWeighted;
+  if (weighted) {
+    if (edge_weight_property_name.empty()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "weighted sampling needs an edge weight property");
+    }
+    auto weights =
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name));
+
+    edge_weight.allocateInterleaved(topo.num_edges());
+    switch (weights->type()->id()) {
+    case arrow::UInt32Type::type_id:
+      CopyEdgeWeights<arrow::UInt32Type>(*weights, &edge_weight);
+      break;
+    case arrow::Int32Type::type_id:
+      CopyEdgeWeights<arrow::Int32Type>(*weights, &edge_weight);
+      break;
+    case arrow::UInt64Type::type_id:
+      CopyEdgeWeights<arrow::UInt64Type>(*weights, &edge_weight);
+      break;
+    case arrow::Int64Type::type_id:
+      CopyEdgeWeights<arrow::Int64Type>(*weights, &edge_weight);
+      break;
+    case arrow::FloatType::type_id:
+      CopyEdgeWeights<arrow::FloatType>(*weights, &edge_weight);
+      break;
+    case arrow::DoubleType::type_id:
+      CopyEdgeWeights<arrow::DoubleType>(*weights, &edge_weight);
+      break;
+    default:
+      return KATANA_ERROR(
+          katana::ErrorCode::TypeError, "Unsupported type: {}",
+          weights->type()->ToString());
+    }
+  }
+
+  if (seeds.empty()) {
+    return std::vector<NeighborSampleBatch>();
+  }
+
+  size_t num_batches = (seeds.size() + batch_size - 1) / batch_size;
+  std::vector<NeighborSampleBatch> batches(num_batches);
+  std::vector<katana::Result<void>> results(
+      num_batches, katana::ResultSuccess());
+
+  katana::StatTimer execTime("NeighborSampling");
+  execTime.start();
+  katana::do_all(
+      katana::iterate(size_t{0}, num_batches),
+      [&](size_t b) {
+        size_t begin = b * batch_size;
+        uint32_t count = static_cast<uint32_t>(
+            std::min<size_t>(batch_size, seeds.size() - begin));
+        auto batch = BuildBatch(
+            *pg, topo, seeds.data() + begin, count,
+            weighted ? &edge_weight : nullptr, node_property_names,
+            edge_property_names, plan);
+        if (!batch) {
+          results[b] = batch.error();
+          return;
+        }
+        batches[b] = std::move(batch.value());
+      },
+      katana::steal(), katana::loopname("NeighborSampling"));
+  execTime.stop();
+
+  for (auto& r : results) {
+    if (!r) {
+      return r.error();
+    }
+  }
+
+  return batches;
+}
@@ -0,0 +1,96 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <atomic>
+#include <cmath>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/OutOfCorePropertyGraph.h"
+#include "katana/Reduction.h"
+#include "pagerank-impl.h"
+
+namespace {
+
+using Graph = katana::OutOfCorePropertyGraph;
+using Node = Graph::Node;
+using Edge = Graph::Edge;
+
+}  // namespace
+
+/// Out-of-core synchronous push Page Rank. Per-node state (current ranks
+/// and next-iteration contributions) stays in memory; every iteration
+/// streams the edge segments from storage with the next segment prefetched
+/// while the current one is processed. Only the tolerance, alpha, and
+/// max_iterations of the plan apply; the algorithm is always synchronous
+/// push since that is the only schedule that works with a single pass over
+/// streamed out-edges.
+katana::Result<void>
+katana::analytics::PagerankOutOfCore(
+    katana::OutOfCorePropertyGraph* graph, katana::NUMAArray<float>* ranks,
+    katana::analytics::PagerankPlan plan) {
+  uint64_t num_nodes = graph->num_nodes();
+  if (num_nodes == 0) {
+    return katana::ResultSuccess();
+  }
+
+  ranks->allocateInterleaved(num_nodes);
+  katana::NUMAArray<std::atomic<float>> next;
+  next.allocateInterleaved(num_nodes);
+
+  const float init_value = 1.0f / num_nodes;
+  const float base_score = (1.0f - plan.alpha()) / num_nodes;
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    (*ranks)[n] = init_value;
+    next[n] = 0.0f;
+  });
+
+  for (unsigned int iteration = 0; iteration < plan.max_iterations();
+       ++iteration) {
+    KATANA_CHECKED(graph->ForEachSegment([&](const Graph::LoadedSegment& seg) {
+      katana::do_all(
+          katana::iterate(seg.info().node_begin, seg.info().node_end),
+          [&](Node src) {
+            size_t degree = graph->degree(src);
+            if (degree == 0) {
+              return;
+            }
+            float contribution = plan.alpha() * (*ranks)[src] / degree;
+            for (Edge e = graph->edge_begin(src); e < graph->edge_end(src);
+                 ++e) {
+              katana::atomicAdd(next[seg.edge_dest(e)], contribution);
+            }
+          },
+          katana::steal());
+    }));
+
+    katana::GAccumulator<float> delta;
+    katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+      float new_rank = next[n] + base_score;
+      delta += fabsf(new_rank - (*ranks)[n]);
+      (*ranks)[n] = new_rank;
+      next[n] = 0.0f;
+    });
+
+    if (delta.reduce() <= plan.tolerance()) {
+      break;
+    }
+  }
+
+  return katana::ResultSuccess();
+}
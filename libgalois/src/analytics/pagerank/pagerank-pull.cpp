@@ -17,9 +17,14 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <cmath>
+#include <cstring>
+
 #include <arrow/type.h>
 
+#include "katana/Logging.h"
 #include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/IterativeCheckpoint.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
 
@@ -62,10 +67,13 @@ void
 InitNodeDataResidual(
     Graph* graph, DeltaArray& delta, ResidualArray& residual,
     katana::analytics::PagerankPlan plan) {
+  // capture the property as a flat span once so the loop body is plain
+  // indexing through a non-aliasing pointer
+  auto node_data = graph->GetDataSpan<PagerankValueAndOutDegree>();
   katana::do_all(
       katana::iterate(*graph),
       [&](const GNode& n) {
-        auto& sdata = graph->GetData<PagerankValueAndOutDegree>(n);
+        auto& sdata = node_data[n];
         sdata.value = 0;
         sdata.out = 0;
         delta[n] = 0;
@@ -135,12 +143,10 @@ ComputeOutDeg(Graph* graph) {
       katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
       katana::loopname("ComputeOutDeg"));
 
+  auto node_data = graph->GetDataSpan<PagerankValueAndOutDegree>();
   katana::do_all(
       katana::iterate(*graph),
-      [&](const GNode& src) {
-        auto& sdata = graph->GetData<PagerankValueAndOutDegree>(src);
-        sdata.out = vec[src];
-      },
+      [&](const GNode& src) { node_data[src].out = vec[src]; },
       katana::loopname("CopyDeg"));
 
   out_degree_timer.stop();
@@ -157,20 +163,24 @@ ComputeOutDeg(Graph* graph) {
 void
 ComputePRResidual(
     Graph* graph, DeltaArray& delta, ResidualArray& residual,
-    katana::analytics::PagerankPlan plan) {
-  unsigned int iterations = 0;
+    katana::analytics::PagerankPlan plan,
+    katana::analytics::IterativeCheckpointer& checkpointer,
+    unsigned int start_iteration) {
+  unsigned int iterations = start_iteration;
   katana::GAccumulator<unsigned int> accum;
 
+  auto node_data = graph->GetDataSpan<PagerankValueAndOutDegree>();
   while (true) {
     katana::do_all(
         katana::iterate(*graph),
         [&](const GNode& src) {
-          auto& sdata = graph->GetData<PagerankValueAndOutDegree>(src);
+          auto& sdata = node_data[src];
           delta[src] = 0;
 
           //! Only the residual higher than tolerance will be reflected
-          //! to the pagerank.
-          if (residual[src] > plan.tolerance()) {
+          //! to the pagerank. Warm starts seed negative residuals for
+          //! nodes whose old rank was too high, so compare magnitudes.
+          if (std::fabs(residual[src]) > plan.tolerance()) {
             PRTy old_residual = residual[src];
             residual[src] = 0.0;
             sdata.value += old_residual;
@@ -188,11 +198,11 @@ ComputePRResidual(
           float sum = 0;
           for (auto nbr : graph->edges(src)) {
             auto dest = graph->GetEdgeDest(nbr);
-            if (delta[*dest] > 0) {
+            if (delta[*dest] != 0) {
               sum += delta[*dest];
             }
           }
-          if (sum > 0) {
+          if (sum != 0) {
             residual[src] = sum;
           }
         },
@@ -208,6 +218,19 @@ ComputePRResidual(
       break;
     }
     accum.reset();
+
+    //! delta is rebuilt from the residuals at the top of each round, so
+    //! values and residuals are the whole resumable state
+    if (checkpointer.Due(iterations)) {
+      if (auto res = checkpointer.Save(
+              iterations,
+              {{node_data.data(),
+                graph->num_nodes() * sizeof(PagerankValueAndOutDegreeTy)},
+               {residual.data(), graph->num_nodes() * sizeof(PRTy)}});
+          !res) {
+        KATANA_LOG_WARN("pagerank checkpoint failed: {}", res.error());
+      }
+    }
   }  ///< End while(true).
   //! [scalarreduction]
 }
@@ -219,8 +242,10 @@ ComputePRResidual(
 void
 ComputePRTopological(
     const katana::PropertyGraph& graph, katana::analytics::PagerankPlan plan,
-    katana::NUMAArray<PagerankValueAndOutDegreeTy>* node_data) {
-  unsigned int iteration = 0;
+    katana::NUMAArray<PagerankValueAndOutDegreeTy>* node_data,
+    katana::analytics::IterativeCheckpointer& checkpointer,
+    unsigned int start_iteration) {
+  unsigned int iteration = start_iteration;
   katana::GAccumulator<float> accum;
 
   float base_score = (1.0f - plan.alpha()) / graph.size();
@@ -263,6 +288,15 @@ ComputePRTopological(
     }
     accum.reset();
 
+    if (checkpointer.Due(iteration)) {
+      if (auto res = checkpointer.Save(
+              iteration,
+              {{node_data->data(),
+                graph.size() * sizeof(PagerankValueAndOutDegreeTy)}});
+          !res) {
+        KATANA_LOG_WARN("pagerank checkpoint failed: {}", res.error());
+      }
+    }
   }  ///< End while(true).
 
   katana::ReportStatSingle("PageRank", "Iterations", iteration);
@@ -287,9 +321,10 @@ ExtractValueFromTopoGraph(
   }
   auto graph = graph_result.value();
 
+  auto value_span = graph.GetDataSpan<NodeValue>();
   katana::do_all(
       katana::iterate(*pg),
-      [&](uint32_t i) { graph.GetData<NodeValue>(i) = node_data[i].value; },
+      [&](uint32_t i) { value_span[i] = node_data[i].value; },
       katana::loopname("Extract pagerank"), katana::no_stats());
 
   return katana::ResultSuccess();
@@ -311,9 +346,46 @@ PagerankPullTopological(
   InitNodeDataTopological(*pg, &node_data);
   ComputeOutDeg(*pg, &node_data);
 
+  //! Warm start: the power iteration converges from any starting vector, so
+  //! simply seed the values with the old ranks.
+  if (!plan.initial_rank_property_name().empty()) {
+    auto prior_result =
+        pg->GetNodePropertyTyped<PRTy>(plan.initial_rank_property_name());
+    if (!prior_result) {
+      return prior_result.error();
+    }
+    auto prior = prior_result.value();
+    katana::do_all(
+        katana::iterate(*pg),
+        [&](const GNode& n) { node_data[n].value = prior->Value(n); },
+        katana::no_stats(), katana::loopname("LoadInitialRanks"));
+  }
+
+  //! A checkpoint overrides both the cold and the warm start; its shape
+  //! must match the current graph or it is ignored.
+  katana::analytics::IterativeCheckpointer checkpointer(
+      plan.checkpoint_location(), "pagerank-pull-topological",
+      plan.checkpoint_interval());
+  unsigned int start_iteration = 0;
+  if (checkpointer.Enabled()) {
+    auto snapshot = KATANA_CHECKED(checkpointer.Restore());
+    if (snapshot) {
+      const size_t bytes =
+          pg->num_nodes() * sizeof(PagerankValueAndOutDegreeTy);
+      if (snapshot->sections.size() == 1 &&
+          snapshot->sections[0].size() == bytes) {
+        memcpy(node_data.data(), snapshot->sections[0].data(), bytes);
+        start_iteration = snapshot->round;
+      } else {
+        KATANA_LOG_WARN(
+            "ignoring checkpoint whose shape does not match the graph");
+      }
+    }
+  }
+
   katana::StatTimer exec_time("PagerankPullTopological");
   exec_time.start();
-  ComputePRTopological(*pg, plan, &node_data);
+  ComputePRTopological(*pg, plan, &node_data, checkpointer, start_iteration);
   exec_time.stop();
 
   return ExtractValueFromTopoGraph(pg, output_property_name, node_data);
@@ -346,9 +418,72 @@ PagerankPullResidual(
   InitNodeDataResidual(&graph, delta, residual, plan);
   ComputeOutDeg(&graph);
 
+  //! Warm start: seed the values with the old ranks and the residuals with
+  //! the mismatch between those ranks and the current graph. Nodes whose
+  //! neighborhood is unchanged start with a (near-)zero residual and drop
+  //! out of the iteration immediately; stale ranks show up as positive or
+  //! negative residuals and are corrected by the normal propagation.
+  if (!plan.initial_rank_property_name().empty()) {
+    auto prior_result =
+        pg->GetNodePropertyTyped<PRTy>(plan.initial_rank_property_name());
+    if (!prior_result) {
+      return prior_result.error();
+    }
+    auto prior = prior_result.value();
+    auto node_data = graph.GetDataSpan<PagerankValueAndOutDegree>();
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& n) { node_data[n].value = prior->Value(n); },
+        katana::no_stats(), katana::loopname("LoadInitialRanks"));
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& src) {
+          PRTy sum = 0;
+          for (auto nbr : graph.edges(src)) {
+            auto dest = graph.GetEdgeDest(nbr);
+            auto& ddata = node_data[*dest];
+            if (ddata.out > 0) {
+              sum += ddata.value / ddata.out;
+            }
+          }
+          residual[src] = plan.initial_residual() + plan.alpha() * sum -
+                          node_data[src].value;
+        },
+        katana::steal(),
+        katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
+        katana::loopname("InitialRankResidual"));
+  }
+
+  //! A checkpoint overrides both the cold and the warm start; its shape
+  //! must match the current graph or it is ignored.
+  katana::analytics::IterativeCheckpointer checkpointer(
+      plan.checkpoint_location(), "pagerank-pull-residual",
+      plan.checkpoint_interval());
+  unsigned int start_iteration = 0;
+  if (checkpointer.Enabled()) {
+    auto snapshot = KATANA_CHECKED(checkpointer.Restore());
+    if (snapshot) {
+      auto node_data = graph.GetDataSpan<PagerankValueAndOutDegree>();
+      const size_t value_bytes =
+          pg->num_nodes() * sizeof(PagerankValueAndOutDegreeTy);
+      const size_t residual_bytes = pg->num_nodes() * sizeof(PRTy);
+      if (snapshot->sections.size() == 2 &&
+          snapshot->sections[0].size() == value_bytes &&
+          snapshot->sections[1].size() == residual_bytes) {
+        memcpy(node_data.data(), snapshot->sections[0].data(), value_bytes);
+        memcpy(residual.data(), snapshot->sections[1].data(), residual_bytes);
+        start_iteration = snapshot->round;
+      } else {
+        KATANA_LOG_WARN(
+            "ignoring checkpoint whose shape does not match the graph");
+      }
+    }
+  }
+
   katana::StatTimer exec_time("PagerankPullResidual");
   exec_time.start();
-  ComputePRResidual(&graph, delta, residual, plan);
+  ComputePRResidual(&graph, delta, residual, plan, checkpointer,
+      start_iteration);
   exec_time.stop();
 
   return katana::ResultSuccess();
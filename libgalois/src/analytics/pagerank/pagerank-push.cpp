@@ -17,7 +17,11 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <cmath>
+
 #include "katana/AtomicHelpers.h"
+#include "katana/DynamicBitset.h"
+#include "katana/NUMAArray.h"
 #include "katana/Properties.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
@@ -34,15 +38,60 @@ using EdgeData = std::tuple<>;
 typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
 typedef typename Graph::Node GNode;
 
-void
-InitializeNodeResidual(Graph& graph, katana::analytics::PagerankPlan plan) {
+katana::Result<void>
+InitializeNodeResidual(
+    katana::PropertyGraph* pg, Graph& graph,
+    katana::analytics::PagerankPlan plan) {
+  if (plan.initial_rank_property_name().empty()) {
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& n) {
+          graph.GetData<NodeResidual>(n) = plan.initial_residual();
+          graph.GetData<NodeValue>(n) = 0;
+        },
+        katana::no_stats(), katana::loopname("Initialize"));
+    return katana::ResultSuccess();
+  }
+
+  //! Warm start: seed the values with the old ranks and push each node's old
+  //! contribution so the residual ends up as the mismatch between the old
+  //! ranks and the current graph. Stale ranks leave a positive or negative
+  //! residual that the normal propagation corrects.
+  auto prior_result =
+      pg->GetNodePropertyTyped<PRTy>(plan.initial_rank_property_name());
+  if (!prior_result) {
+    return prior_result.error();
+  }
+  auto prior = prior_result.value();
+
   katana::do_all(
       katana::iterate(graph),
       [&](const GNode& n) {
-        graph.GetData<NodeResidual>(n) = plan.initial_residual();
-        graph.GetData<NodeValue>(n) = 0;
+        graph.GetData<NodeValue>(n) = prior->Value(n);
+        graph.GetData<NodeResidual>(n) =
+            plan.initial_residual() - prior->Value(n);
       },
-      katana::no_stats(), katana::loopname("Initialize"));
+      katana::no_stats(), katana::loopname("LoadInitialRanks"));
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& src) {
+        int src_nout = graph.edges(src).size();
+        if (src_nout == 0) {
+          return;
+        }
+        PRTy contribution =
+            plan.alpha() * graph.GetData<NodeValue>(src) / src_nout;
+        for (const auto& jj : graph.edges(src)) {
+          auto dest = graph.GetEdgeDest(jj);
+          atomicAdd(graph.GetData<NodeResidual>(dest), contribution);
+        }
+      },
+      katana::steal(),
+      katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
+      katana::loopname("InitialRankResidual"));
+
+  return katana::ResultSuccess();
 }
 
 }  // namespace
@@ -70,7 +119,9 @@ PagerankPushAsynchronous(
   }
   Graph graph = graph_result.value();
 
-  InitializeNodeResidual(graph, plan);
+  if (auto result = InitializeNodeResidual(pg, graph, plan); !result) {
+    return result.error();
+  }
 
   typedef katana::PerSocketChunkFIFO<
       katana::analytics::PagerankPlan::kChunkSize>
@@ -79,7 +130,9 @@ PagerankPushAsynchronous(
       katana::iterate(graph),
       [&](const GNode& src, auto& ctx) {
         auto& src_residual = graph.GetData<NodeResidual>(src);
-        if (src_residual > plan.tolerance()) {
+        //! Warm starts seed negative residuals for nodes whose old rank
+        //! was too high, so compare magnitudes.
+        if (std::fabs(src_residual) > plan.tolerance()) {
           PRTy old_residual = src_residual.exchange(0.0);
           auto& src_value = graph.GetData<NodeValue>(src);
           src_value += old_residual;
@@ -90,10 +143,10 @@ PagerankPushAsynchronous(
             for (const auto& jj : graph.edges(src)) {
               auto dest = graph.GetEdgeDest(jj);
               auto& dest_residual = graph.GetData<NodeResidual>(dest);
-              if (delta > 0) {
+              if (delta != 0) {
                 auto old = atomicAdd(dest_residual, delta);
-                if ((old < plan.tolerance()) &&
-                    (old + delta >= plan.tolerance())) {
+                if ((std::fabs(old) < plan.tolerance()) &&
+                    (std::fabs(old + delta) >= plan.tolerance())) {
                   ctx.push(*dest);
                 }
               }
@@ -107,6 +160,202 @@ PagerankPushAsynchronous(
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+PagerankPushPullFrontier(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan) {
+  using BiDirView = katana::PropertyGraphViews::BiDirectional;
+
+  katana::EnsurePreallocated(5, 5 * pg->num_nodes() * sizeof(PRTy));
+  katana::ReportPageAllocGuard page_alloc;
+
+  BiDirView graph = pg->BuildView<BiDirView>();
+
+  const uint64_t num_nodes = graph.num_nodes();
+  const uint64_t num_edges = graph.num_edges();
+
+  katana::NUMAArray<PRTy> value;
+  katana::NUMAArray<std::atomic<PRTy>> residual;
+  katana::NUMAArray<PRTy> delta;
+  value.allocateInterleaved(num_nodes);
+  residual.allocateInterleaved(num_nodes);
+  delta.allocateInterleaved(num_nodes);
+
+  //! The frontier holds exactly the nodes whose residual still exceeds the
+  //! tolerance; converged nodes drop out and cost nothing per iteration.
+  katana::DynamicBitset frontier;
+  katana::DynamicBitset next_frontier;
+  frontier.resize(num_nodes);
+  next_frontier.resize(num_nodes);
+
+  if (plan.initial_rank_property_name().empty()) {
+    katana::do_all(
+        katana::iterate(uint64_t(0), num_nodes),
+        [&](uint64_t n) {
+          value[n] = 0;
+          residual.constructAt(n, plan.initial_residual());
+          delta[n] = 0;
+          frontier.set(n);
+        },
+        katana::no_stats(), katana::loopname("Initialize"));
+  } else {
+    //! Warm start: seed the values with the old ranks and the residuals
+    //! with the mismatch between those ranks and the current graph, pulled
+    //! over the in-edges. The first drain phase shrinks the frontier to the
+    //! nodes whose old rank is actually stale.
+    auto prior_result =
+        pg->GetNodePropertyTyped<PRTy>(plan.initial_rank_property_name());
+    if (!prior_result) {
+      return prior_result.error();
+    }
+    auto prior = prior_result.value();
+    katana::do_all(
+        katana::iterate(uint64_t(0), num_nodes),
+        [&](uint64_t n) {
+          value[n] = prior->Value(n);
+          PRTy sum = 0;
+          for (auto e : graph.in_edges(n)) {
+            auto src = graph.in_edge_dest(e);
+            size_t src_nout = graph.degree(src);
+            if (src_nout > 0) {
+              sum += prior->Value(src) / src_nout;
+            }
+          }
+          residual.constructAt(
+              n, plan.initial_residual() + plan.alpha() * sum - value[n]);
+          delta[n] = 0;
+          frontier.set(n);
+        },
+        katana::steal(),
+        katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
+        katana::loopname("LoadInitialRanks"));
+  }
+
+  //! Beamer's direction-optimization threshold: pull once the frontier's
+  //! outgoing edges exceed 1/alpha of the graph's edges.
+  constexpr uint64_t kPullAlpha = 15;
+
+  katana::StatTimer exec_time("PagerankPushPullFrontier");
+  exec_time.start();
+
+  uint64_t frontier_edges = num_edges;
+  unsigned int iterations = 0;
+  while (iterations < plan.max_iterations()) {
+    //! Drain phase: fold each active residual into the rank and turn it
+    //! into a per-out-edge delta.
+    katana::GAccumulator<uint64_t> drained;
+    katana::do_all(
+        katana::iterate(uint64_t(0), num_nodes),
+        [&](uint64_t src) {
+          delta[src] = 0;
+          if (!frontier.test(src)) {
+            return;
+          }
+          PRTy old_residual =
+              residual[src].exchange(0.0, std::memory_order_relaxed);
+          if (std::fabs(old_residual) > plan.tolerance()) {
+            value[src] += old_residual;
+            size_t src_nout = graph.degree(src);
+            if (src_nout > 0) {
+              delta[src] = old_residual * plan.alpha() / src_nout;
+              drained += 1;
+            }
+          }
+        },
+        katana::no_stats(), katana::loopname("PushPullFrontier_delta"));
+
+    if (!drained.reduce()) {
+      break;
+    }
+
+    katana::GAccumulator<uint64_t> next_count;
+    katana::GAccumulator<uint64_t> next_edges;
+
+    if (frontier_edges > num_edges / kPullAlpha) {
+      //! Dense frontier: every node pulls the deltas of its in-neighbors
+      //! with one unsynchronized write per node.
+      katana::do_all(
+          katana::iterate(uint64_t(0), num_nodes),
+          [&](uint64_t dst) {
+            PRTy sum = 0;
+            for (auto e : graph.in_edges(dst)) {
+              auto src = graph.in_edge_dest(e);
+              if (delta[src] != 0) {
+                sum += delta[src];
+              }
+            }
+            if (sum != 0) {
+              PRTy old = residual[dst].load(std::memory_order_relaxed);
+              residual[dst].store(old + sum, std::memory_order_relaxed);
+              if (std::fabs(old + sum) > plan.tolerance()) {
+                next_frontier.set(dst);
+                next_count += 1;
+                next_edges += graph.degree(dst);
+              }
+            }
+          },
+          katana::steal(),
+          katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
+          katana::loopname("PushPullFrontier_pull"));
+    } else {
+      //! Sparse frontier: only the active nodes touch their out-edges.
+      katana::do_all(
+          katana::iterate(uint64_t(0), num_nodes),
+          [&](uint64_t src) {
+            if (!frontier.test(src) || delta[src] == 0) {
+              return;
+            }
+            for (auto e : graph.edges(src)) {
+              auto dst = graph.edge_dest(e);
+              auto old = katana::atomicAdd(residual[dst], delta[src]);
+              if ((std::fabs(old) <= plan.tolerance()) &&
+                  (std::fabs(old + delta[src]) > plan.tolerance())) {
+                next_frontier.set(dst);
+                next_count += 1;
+                next_edges += graph.degree(dst);
+              }
+            }
+          },
+          katana::steal(),
+          katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
+          katana::loopname("PushPullFrontier_push"));
+    }
+
+    iterations++;
+    if (!next_count.reduce()) {
+      break;
+    }
+    frontier_edges = next_edges.reduce();
+    std::swap(frontier, next_frontier);
+    next_frontier.reset();
+  }
+  exec_time.stop();
+
+  katana::ReportStatSingle("PageRank", "Iterations", iterations);
+
+  //! Write the ranks out to the property the caller asked for.
+  if (auto result =
+          katana::analytics::ConstructNodeProperties<std::tuple<NodeValue>>(
+              pg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+  auto graph_result =
+      katana::TypedPropertyGraph<std::tuple<NodeValue>, std::tuple<>>::Make(
+          pg, {output_property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto out_graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(out_graph),
+      [&](uint32_t n) { out_graph.GetData<NodeValue>(n) = value[n]; },
+      katana::loopname("Extract pagerank"), katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 PagerankPushSynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
@@ -130,7 +379,9 @@ PagerankPushSynchronous(
   }
   Graph graph = graph_result.value();
 
-  InitializeNodeResidual(graph, plan);
+  if (auto result = InitializeNodeResidual(pg, graph, plan); !result) {
+    return result.error();
+  }
 
   struct Update {
     PRTy delta;
@@ -154,7 +405,7 @@ PagerankPushSynchronous(
         [&](const GNode& src) {
           auto& sdata_residual = graph.GetData<NodeResidual>(src);
 
-          if (sdata_residual > plan.tolerance()) {
+          if (std::fabs(sdata_residual) > plan.tolerance()) {
             PRTy old_residual = sdata_residual;
             graph.GetData<NodeValue>(src) += old_residual;
             sdata_residual = 0.0;
@@ -198,8 +449,8 @@ PagerankPushSynchronous(
             //! If fabs(old) is greater than tolerance, then it would
             //! already have been processed in the previous do_all
             //! loop.
-            if ((old <= plan.tolerance()) &&
-                (old + up.delta >= plan.tolerance())) {
+            if ((std::fabs(old) <= plan.tolerance()) &&
+                (std::fabs(old + up.delta) >= plan.tolerance())) {
               active_nodes.push(*dest);
             }
           }
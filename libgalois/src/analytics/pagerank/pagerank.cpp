@@ -17,6 +17,8 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <cmath>
+
 #include "katana/TypedPropertyGraph.h"
 #include "pagerank-impl.h"
 
@@ -33,6 +35,8 @@ katana::analytics::Pagerank(
     return PagerankPushAsynchronous(pg, output_property_name, plan);
   case PagerankPlan::kPushSynchronous:
     return PagerankPushSynchronous(pg, output_property_name, plan);
+  case PagerankPlan::kPushPullFrontier:
+    return PagerankPushPullFrontier(pg, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -41,9 +45,32 @@ katana::analytics::Pagerank(
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::PagerankAssertValid(
-    [[maybe_unused]] katana::PropertyGraph* pg,
-    [[maybe_unused]] const std::string& property_name) {
-  // TODO(gill): This should have real checks. amp has no idea what to check.
+    katana::PropertyGraph* pg, const std::string& property_name,
+    uint32_t num_samples) {
+  auto graph =
+      KATANA_CHECKED((TypedPropertyGraph<std::tuple<NodeValue>, std::tuple<>>::
+                          Make(pg, {property_name}, {})));
+
+  // The exact fixpoint depends on the plan's tolerance and scaling, so check
+  // the invariants every variant shares: ranks are finite and non-negative.
+  katana::GAccumulator<uint64_t> num_invalid;
+  std::vector<uint32_t> sample =
+      SampleValidationNodes(graph.size(), num_samples);
+  katana::do_all(
+      katana::iterate(sample),
+      [&](uint32_t i) {
+        PRTy rank = graph.GetData<NodeValue>(i);
+        if (!std::isfinite(rank) || rank < 0) {
+          num_invalid += 1;
+        }
+      },
+      katana::loopname("Pagerank validation"), katana::no_stats());
+
+  if (num_invalid.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "{} nodes have a non-finite or negative rank", num_invalid.reduce());
+  }
   return katana::ResultSuccess();
 }
 /// \endcond
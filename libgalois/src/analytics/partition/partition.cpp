@@ -0,0 +1,401 @@
+#include "katana/analytics/partition/partition.h"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#include <arrow/api.h>
+#include <arrow/compute/api_vector.h>
+
+#include "katana/CacheLineStorage.h"
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Range.h"
+#include "katana/URI.h"
+#include "tsuba/PartitionMetadata.h"
+
+namespace {
+
+using katana::analytics::PartitionPlan;
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+
+/// The shared placement state both the streaming pass and the refinement
+/// sweeps score against. Partition sizes sit on their own cache lines; they
+/// are the only cross-thread traffic on the hot path.
+struct PlacementState {
+  PlacementState(
+      const PartitionPlan& plan, uint32_t num_partitions, uint64_t num_nodes,
+      uint64_t num_edges)
+      : plan(plan), sizes(num_partitions) {
+    capacity = std::max<uint64_t>(
+        1, static_cast<uint64_t>(
+               static_cast<double>(num_nodes) / num_partitions *
+               (1.0 + plan.balance_slack())) +
+               1);
+    double n = std::max<uint64_t>(num_nodes, 1);
+    fennel_alpha = static_cast<double>(num_edges) *
+                   std::pow(num_partitions, plan.fennel_gamma() - 1.0) /
+                   std::pow(n, plan.fennel_gamma());
+  }
+
+  double Score(uint32_t part, uint64_t neighbors, uint64_t size) const {
+    if (plan.algorithm() == PartitionPlan::kFennel) {
+      return static_cast<double>(neighbors) -
+             fennel_alpha * plan.fennel_gamma() *
+                 std::pow(static_cast<double>(size), plan.fennel_gamma() - 1.0);
+    }
+    (void)part;
+    return static_cast<double>(neighbors) *
+           (1.0 - static_cast<double>(size) / static_cast<double>(capacity));
+  }
+
+  /// Pick the best partition for a node given the counts of its neighbors
+  /// in each partition. Partitions at capacity are skipped unless the node
+  /// already lives there; with every partition full the least-loaded one
+  /// wins, keeping the capacity bound soft rather than a failure.
+  uint32_t Pick(const std::vector<uint64_t>& counts, uint32_t current) const {
+    uint32_t best = kUnassigned;
+    uint64_t best_size = 0;
+    double best_score = 0;
+    for (uint32_t p = 0; p < sizes.size(); ++p) {
+      uint64_t size = sizes[p].get().load(std::memory_order_relaxed);
+      if (size >= capacity && p != current) {
+        continue;
+      }
+      double score = Score(p, counts[p], size);
+      if (best == kUnassigned || score > best_score ||
+          (score == best_score && size < best_size)) {
+        best = p;
+        best_size = size;
+        best_score = score;
+      }
+    }
+    if (best == kUnassigned) {
+      for (uint32_t p = 0; p < sizes.size(); ++p) {
+        uint64_t size = sizes[p].get().load(std::memory_order_relaxed);
+        if (best == kUnassigned || size < best_size) {
+          best = p;
+          best_size = size;
+        }
+      }
+    }
+    return best;
+  }
+
+  const PartitionPlan& plan;
+  std::vector<katana::CacheLineStorage<std::atomic<uint64_t>>> sizes;
+  uint64_t capacity{};
+  double fennel_alpha{};
+};
+
+/// Per-thread scratch for neighbor counting; only the entries a node
+/// actually touched are reset so the cost scales with its degree, not with
+/// the number of partitions.
+struct NeighborCounts {
+  explicit NeighborCounts(uint32_t num_partitions)
+      : counts(num_partitions, 0) {}
+
+  void Count(uint32_t part) {
+    if (part == kUnassigned) {
+      return;
+    }
+    if (counts[part]++ == 0) {
+      touched.push_back(part);
+    }
+  }
+
+  void Clear() {
+    for (uint32_t p : touched) {
+      counts[p] = 0;
+    }
+    touched.clear();
+  }
+
+  std::vector<uint64_t> counts;
+  std::vector<uint32_t> touched;
+};
+
+/// Gather the rows named by indices out of every column of the given
+/// schema, one arrow Take per column run in parallel across columns.
+template <typename ColumnFn>
+katana::Result<std::shared_ptr<arrow::Table>>
+GatherPropertyRows(
+    const std::shared_ptr<arrow::Schema>& schema, const ColumnFn& column_fn,
+    const std::shared_ptr<arrow::Array>& indices) {
+  int num_fields = schema->num_fields();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(num_fields);
+  std::vector<katana::Result<void>> results(
+      num_fields, katana::ResultSuccess());
+
+  katana::do_all(
+      katana::iterate(0, num_fields),
+      [&](int i) {
+        auto taken = arrow::compute::Take(column_fn(i), indices);
+        if (!taken.ok()) {
+          results[i] = KATANA_ERROR(
+              katana::ErrorCode::ArrowError, "gathering property {}: {}",
+              schema->field(i)->name(), taken.status().ToString());
+          return;
+        }
+        columns[i] = taken.ValueOrDie().chunked_array();
+      },
+      katana::loopname("Partition_GatherProperties"), katana::no_stats());
+
+  for (auto& r : results) {
+    if (!r) {
+      return r.error();
+    }
+  }
+
+  return arrow::Table::Make(schema, columns);
+}
+
+}  // namespace
+
+const char* katana::analytics::kPartitionGlobalIDPropertyName =
+    "partition_global_id";
+
+katana::Result<std::vector<uint32_t>>
+katana::analytics::StreamingPartition(
+    katana::PropertyGraph* pg, uint32_t num_partitions, PartitionPlan plan) {
+  if (num_partitions == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "cannot make zero partitions");
+  }
+  const katana::GraphTopology& topo = pg->topology();
+  uint64_t num_nodes = topo.num_nodes();
+  uint64_t num_edges = topo.num_edges();
+
+  PlacementState state(plan, num_partitions, num_nodes, num_edges);
+  katana::NUMAArray<std::atomic<uint32_t>> assignment;
+  assignment.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        assignment[n].store(kUnassigned, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  // The streaming pass: each thread streams a contiguous node block in
+  // order and places nodes against the partial assignment it can see. The
+  // blocks start unrelated to each other, but neighbor information
+  // accumulates as the pass proceeds, which is the usual restreaming
+  // compromise for parallelizing LDG/Fennel.
+  katana::on_each([&](unsigned tid, unsigned total) {
+    auto [begin, end] =
+        katana::block_range(uint64_t{0}, num_nodes, tid, total);
+    NeighborCounts scratch(num_partitions);
+    for (uint64_t n = begin; n < end; ++n) {
+      for (Edge e : topo.edges(n)) {
+        scratch.Count(
+            assignment[topo.edge_dest(e)].load(std::memory_order_relaxed));
+      }
+      uint32_t part = state.Pick(scratch.counts, kUnassigned);
+      assignment[n].store(part, std::memory_order_relaxed);
+      state.sizes[part].get().fetch_add(1, std::memory_order_relaxed);
+      scratch.Clear();
+    }
+  });
+
+  // Refinement sweeps: move a node to the partition holding most of its
+  // neighbors when that strictly improves its score and capacity allows.
+  for (uint32_t pass = 0; pass < plan.refinement_passes(); ++pass) {
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] =
+          katana::block_range(uint64_t{0}, num_nodes, tid, total);
+      NeighborCounts scratch(num_partitions);
+      for (uint64_t n = begin; n < end; ++n) {
+        for (Edge e : topo.edges(n)) {
+          scratch.Count(
+              assignment[topo.edge_dest(e)].load(std::memory_order_relaxed));
+        }
+        uint32_t current = assignment[n].load(std::memory_order_relaxed);
+        uint32_t best = state.Pick(scratch.counts, current);
+        if (best != current &&
+            scratch.counts[best] > scratch.counts[current]) {
+          assignment[n].store(best, std::memory_order_relaxed);
+          state.sizes[current].get().fetch_sub(1, std::memory_order_relaxed);
+          state.sizes[best].get().fetch_add(1, std::memory_order_relaxed);
+        }
+        scratch.Clear();
+      }
+    });
+  }
+
+  std::vector<uint32_t> result(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        result[n] = assignment[n].load(std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  return result;
+}
+
+katana::Result<void>
+katana::analytics::StreamingPartitionToRdgs(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_base, const std::string& command_line,
+    PartitionPlan plan) {
+  std::vector<uint32_t> assignment =
+      KATANA_CHECKED(StreamingPartition(pg, num_partitions, plan));
+  const katana::GraphTopology& topo = pg->topology();
+  uint64_t num_nodes = topo.num_nodes();
+  uint64_t num_edges = topo.num_edges();
+
+  // Bucket owned nodes per partition; the buckets are filled unordered with
+  // atomic cursors and sorted afterwards so owned nodes appear in ascending
+  // original id order.
+  std::vector<uint64_t> owned_counts(num_partitions, 0);
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    ++owned_counts[assignment[n]];
+  }
+  std::vector<std::vector<Node>> owned(num_partitions);
+  std::vector<katana::CacheLineStorage<std::atomic<uint64_t>>> cursors(
+      num_partitions);
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    owned[p].resize(owned_counts[p]);
+  }
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        uint32_t p = assignment[n];
+        uint64_t slot =
+            cursors[p].get().fetch_add(1, std::memory_order_relaxed);
+        owned[p][slot] = static_cast<Node>(n);
+      },
+      katana::no_stats());
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    katana::ParallelSTL::sort(owned[p].begin(), owned[p].end());
+  }
+
+  // Scratch map from original to partition-local node id, reused across
+  // partitions; only the entries a partition touched are reset afterwards.
+  katana::NUMAArray<Node> local_id;
+  local_id.allocateInterleaved(num_nodes);
+
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    uint64_t num_owned = owned[p].size();
+
+    // Remote destinations of owned edges become degree-zero mirrors,
+    // ascending by original id after the owned nodes.
+    std::vector<Node> mirrors;
+    for (Node src : owned[p]) {
+      for (Edge e : topo.edges(src)) {
+        Node dest = topo.edge_dest(e);
+        if (assignment[dest] != p) {
+          mirrors.push_back(dest);
+        }
+      }
+    }
+    katana::ParallelSTL::sort(mirrors.begin(), mirrors.end());
+    mirrors.erase(std::unique(mirrors.begin(), mirrors.end()), mirrors.end());
+
+    uint64_t num_local = num_owned + mirrors.size();
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_owned),
+        [&](uint64_t i) { local_id[owned[p][i]] = static_cast<Node>(i); },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(size_t{0}, mirrors.size()),
+        [&](size_t i) {
+          local_id[mirrors[i]] = static_cast<Node>(num_owned + i);
+        },
+        katana::no_stats());
+
+    // Topology: every out-edge of an owned node is kept; mirrors own none.
+    katana::NUMAArray<Edge> out_indices;
+    out_indices.allocateInterleaved(num_local);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_local),
+        [&](uint64_t i) {
+          out_indices[i] = i < num_owned ? topo.degree(owned[p][i]) : 0;
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        out_indices.begin(), out_indices.end(), out_indices.begin());
+    uint64_t num_local_edges = num_local > 0 ? out_indices[num_local - 1] : 0;
+
+    katana::NUMAArray<Node> out_dests;
+    out_dests.allocateInterleaved(num_local_edges);
+    katana::NUMAArray<uint64_t> edge_rows;
+    edge_rows.allocateInterleaved(num_local_edges);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_owned),
+        [&](uint64_t i) {
+          uint64_t offset = i == 0 ? 0 : out_indices[i - 1];
+          for (Edge e : topo.edges(owned[p][i])) {
+            out_dests[offset] = local_id[topo.edge_dest(e)];
+            edge_rows[offset] = topo.edge_property_index(e);
+            ++offset;
+          }
+        },
+        katana::steal(), katana::loopname("Partition_ConstructTopology"));
+
+    katana::GraphTopology part_topo{
+        std::move(out_indices), std::move(out_dests)};
+    std::unique_ptr<katana::PropertyGraph> part_g =
+        KATANA_CHECKED(katana::PropertyGraph::Make(std::move(part_topo)));
+
+    // Property rows and the global id column for all local nodes.
+    arrow::UInt64Builder node_rows_builder;
+    KATANA_CHECKED(node_rows_builder.Reserve(num_local));
+    for (uint64_t i = 0; i < num_local; ++i) {
+      Node global =
+          i < num_owned ? owned[p][i] : mirrors[i - num_owned];
+      node_rows_builder.UnsafeAppend(topo.node_property_index(global));
+    }
+    std::shared_ptr<arrow::Array> node_rows =
+        KATANA_CHECKED(node_rows_builder.Finish());
+
+    arrow::UInt64Builder edge_rows_builder;
+    KATANA_CHECKED(edge_rows_builder.Reserve(num_local_edges));
+    for (uint64_t e = 0; e < num_local_edges; ++e) {
+      edge_rows_builder.UnsafeAppend(edge_rows[e]);
+    }
+    std::shared_ptr<arrow::Array> edge_rows_array =
+        KATANA_CHECKED(edge_rows_builder.Finish());
+
+    if (pg->loaded_node_schema()->num_fields() > 0) {
+      KATANA_CHECKED(
+          part_g->AddNodeProperties(KATANA_CHECKED(GatherPropertyRows(
+              pg->loaded_node_schema(),
+              [&](int i) { return pg->GetNodeProperty(i); }, node_rows))));
+    }
+    if (pg->loaded_edge_schema()->num_fields() > 0) {
+      KATANA_CHECKED(
+          part_g->AddEdgeProperties(KATANA_CHECKED(GatherPropertyRows(
+              pg->loaded_edge_schema(),
+              [&](int i) { return pg->GetEdgeProperty(i); },
+              edge_rows_array))));
+    }
+
+    KATANA_CHECKED(part_g->AddNodeProperties(arrow::Table::Make(
+        arrow::schema(
+            {arrow::field(kPartitionGlobalIDPropertyName, arrow::uint64())}),
+        {std::make_shared<arrow::ChunkedArray>(node_rows)})));
+
+    tsuba::PartitionMetadata metadata;
+    metadata.policy_id_ = static_cast<uint32_t>(plan.algorithm());
+    metadata.is_outgoing_edge_cut_ = true;
+    metadata.num_global_nodes_ = num_nodes;
+    metadata.max_global_node_id_ = num_nodes > 0 ? num_nodes - 1 : 0;
+    metadata.num_global_edges_ = num_edges;
+    metadata.num_edges_ = num_local_edges;
+    metadata.num_nodes_ = static_cast<uint32_t>(num_local);
+    metadata.num_owned_ = static_cast<uint32_t>(num_owned);
+    part_g->set_partition_metadata(metadata);
+
+    KATANA_CHECKED_CONTEXT(
+        part_g->Write(
+            katana::Uri::JoinPath(output_base, fmt::format("part_{}", p)),
+            command_line),
+        "writing partition {}", p);
+  }
+
+  return katana::ResultSuccess();
+}
@@ -19,7 +19,9 @@
 
 #include "katana/analytics/random_walks/random_walks.h"
 
+#include "katana/Random.h"
 #include "katana/TypedPropertyGraph.h"
+#include "katana/gstl.h"
 
 using namespace katana::analytics;
 
@@ -29,6 +31,15 @@ namespace {
 
 using SortedPropertyGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
 
+//! Per-run seed for the counter-based walk generators. Each iteration draws
+//! from a PhiloxRNG keyed by (seed, iteration id), so a run's walks are
+//! identical at any thread count.
+uint64_t
+WalkSeed() {
+  katana::RandGenerator& gen = katana::GetGenerator();
+  return (uint64_t{gen()} << 32) | gen();
+}
+
 struct Node2VecAlgo {
   using NodeData = std::tuple<>;
   using EdgeData = std::tuple<>;
@@ -57,14 +68,7 @@ struct Node2VecAlgo {
       const SortedGraphView& graph,
       katana::InsertBag<std::vector<uint32_t>>* walks,
       const katana::NUMAArray<uint64_t>& degree) {
-    katana::PerThreadStorage<std::mt19937> generator;
-    katana::PerThreadStorage<std::uniform_real_distribution<double>*>
-        distribution;
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      *distribution.getRemote(i) =
-          new std::uniform_real_distribution<double>(0.0, 1.0);
-    }
+    const uint64_t seed = WalkSeed();
 
     double prob_forward = 1.0 / plan_.forward_probability();
     double prob_backward = 1.0 / plan_.backward_probability();
@@ -91,14 +95,14 @@ struct Node2VecAlgo {
             return;
           }
 
-          std::uniform_real_distribution<double>* dist =
-              *distribution.getLocal();
+          katana::PhiloxRNG rng(seed, idx);
+          std::uniform_real_distribution<double> dist(0.0, 1.0);
 
           std::vector<uint32_t> walk;
           walk.push_back(n);
 
           //random value between 0 and 1
-          double prob = (*dist)(*generator.getLocal());
+          double prob = dist(rng);
 
           //Assumption: All edges have weight 1
           auto nbr = FindSampleNeighbor(graph, n, degree, prob);
@@ -118,13 +122,13 @@ struct Node2VecAlgo {
             //acceptance-rejection sampling
             while (true) {
               //sample x
-              double prob = (*dist)(*generator.getLocal());
+              double prob = dist(rng);
 
               auto nbr = FindSampleNeighbor(graph, curr, degree, prob);
               KATANA_LOG_ASSERT(nbr < graph.num_nodes());
 
               //sample y
-              double y = (*dist)(*generator.getLocal());
+              double y = dist(rng);
               y = y * upper_bound;
 
               if (y <= lower_bound) {
@@ -158,10 +162,226 @@ struct Node2VecAlgo {
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
         katana::loopname("Node2vec walks"), katana::no_stats());
+  }
+
+  void operator()(
+      const SortedGraphView& graph,
+      katana::InsertBag<std::vector<uint32_t>>* walks,
+      const katana::NUMAArray<uint64_t>& degree) {
+    GraphRandomWalk(graph, walks, degree);
+  }
+};
+
+struct BiasedNode2VecAlgo {
+  using NodeData = std::tuple<>;
+  using EdgeData = std::tuple<>;
+
+  using SortedGraphView = katana::TypedPropertyGraphView<
+      SortedPropertyGraphView, NodeData, EdgeData>;
+  using GNode = typename SortedGraphView::Node;
+
+  const RandomWalksPlan& plan_;
+  BiasedNode2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
+
+  //! Alias-table slices, one slot per edge of the sorted view: the
+  //! probability of keeping the slot's own neighbor and the local slot to
+  //! fall back on otherwise. Together they sample a neighbor proportionally
+  //! to its edge weight with two uniform draws.
+  katana::NUMAArray<double> alias_prob_;
+  katana::NUMAArray<uint32_t> alias_index_;
+
+  //! Build the per-node alias tables with Vose's method; edge_weight is
+  //! indexed by the sorted view's edge ids.
+  void BuildAliasTables(
+      const SortedGraphView& graph,
+      const katana::NUMAArray<double>& edge_weight) {
+    alias_prob_.allocateInterleaved(graph.num_edges());
+    alias_index_.allocateInterleaved(graph.num_edges());
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& n) {
+          auto edge_range = graph.edges(n);
+          const size_t node_degree = edge_range.size();
+          if (node_degree == 0) {
+            return;
+          }
+          const uint64_t first = *edge_range.begin();
+
+          double total_weight = 0.0;
+          for (size_t i = 0; i < node_degree; ++i) {
+            total_weight += edge_weight[first + i];
+          }
+
+          //! Weights scaled so the average slot holds exactly 1.0; a
+          //! non-positive total degenerates to uniform sampling.
+          katana::gstl::Vector<double> scaled(node_degree);
+          for (size_t i = 0; i < node_degree; ++i) {
+            scaled[i] = (total_weight > 0.0)
+                            ? edge_weight[first + i] * node_degree /
+                                  total_weight
+                            : 1.0;
+          }
+
+          katana::gstl::Vector<uint32_t> small;
+          katana::gstl::Vector<uint32_t> large;
+          for (size_t i = 0; i < node_degree; ++i) {
+            (scaled[i] < 1.0 ? small : large).push_back(i);
+          }
+
+          while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back();
+            small.pop_back();
+            uint32_t l = large.back();
+            large.pop_back();
+
+            alias_prob_[first + s] = scaled[s];
+            alias_index_[first + s] = l;
+
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            (scaled[l] < 1.0 ? small : large).push_back(l);
+          }
+          //! Leftovers are exactly full slots up to rounding error.
+          while (!large.empty()) {
+            uint32_t l = large.back();
+            large.pop_back();
+            alias_prob_[first + l] = 1.0;
+            alias_index_[first + l] = l;
+          }
+          while (!small.empty()) {
+            uint32_t s = small.back();
+            small.pop_back();
+            alias_prob_[first + s] = 1.0;
+            alias_index_[first + s] = s;
+          }
+        },
+        katana::steal(), katana::loopname("BiasedNode2vec alias tables"),
+        katana::no_stats());
+  }
 
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      delete (*distribution.getRemote(i));
+  GNode SampleNeighbor(
+      const SortedGraphView& graph, const GNode& n,
+      const katana::NUMAArray<uint64_t>& degree, katana::PhiloxRNG& generator,
+      std::uniform_real_distribution<double>& dist) {
+    const uint64_t first = *graph.edges(n).begin();
+
+    uint32_t slot = std::min(
+        static_cast<uint32_t>(degree[n] - 1),
+        static_cast<uint32_t>(std::floor(dist(generator) * degree[n])));
+    if (dist(generator) >= alias_prob_[first + slot]) {
+      slot = alias_index_[first + slot];
     }
+    return graph.edge_dest(first + slot);
+  }
+
+  void GraphRandomWalk(
+      const SortedGraphView& graph,
+      katana::InsertBag<std::vector<uint32_t>>* walks,
+      const katana::NUMAArray<uint64_t>& degree) {
+    const uint64_t seed = WalkSeed();
+
+    double prob_forward = 1.0 / plan_.forward_probability();
+    double prob_backward = 1.0 / plan_.backward_probability();
+
+    double upper_bound = 1.0;
+
+    upper_bound = (upper_bound > prob_forward) ? upper_bound : prob_forward;
+    upper_bound = (upper_bound > prob_backward) ? upper_bound : prob_backward;
+
+    const uint64_t total_walks = graph.size() * plan_.number_of_walks();
+    const uint64_t nodes_per_walk = uint64_t{plan_.walk_length()} + 1;
+    const uint32_t sentinel = graph.num_nodes();
+
+    //! All walker positions live in one flat matrix so each round advances
+    //! every walker by a single step; a round streams through the alias
+    //! tables together instead of each walk touching them end to end.
+    katana::NUMAArray<uint32_t> walk_matrix;
+    walk_matrix.allocateInterleaved(total_walks * nodes_per_walk);
+
+    katana::do_all(
+        katana::iterate(uint64_t(0), total_walks),
+        [&](uint64_t walker) {
+          walk_matrix[walker * nodes_per_walk] = walker % graph.size();
+          for (uint64_t step = 1; step < nodes_per_walk; step++) {
+            walk_matrix[walker * nodes_per_walk + step] = sentinel;
+          }
+        },
+        katana::loopname("BiasedNode2vec init"), katana::no_stats());
+
+    for (uint64_t step = 1; step < nodes_per_walk; step++) {
+      katana::do_all(
+          katana::iterate(uint64_t(0), total_walks),
+          [&](uint64_t walker) {
+            uint32_t curr = walk_matrix[walker * nodes_per_walk + step - 1];
+            //! Walk already terminated or stuck at a dead end.
+            if (curr == sentinel || degree[curr] == 0) {
+              return;
+            }
+
+            //! Stream id unique per (walker, step) so every round's draws
+            //! are independent and scheduling-invariant.
+            katana::PhiloxRNG gen(seed, walker * nodes_per_walk + step);
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+            if (step == 1) {
+              //! First step has no previous node; plain weighted draw.
+              walk_matrix[walker * nodes_per_walk + step] =
+                  SampleNeighbor(graph, curr, degree, gen, dist);
+              return;
+            }
+
+            uint32_t prev = walk_matrix[walker * nodes_per_walk + step - 2];
+
+            //! Weighted draw from the alias table, then rejection against
+            //! the p/q second-order bias.
+            while (true) {
+              GNode nbr = SampleNeighbor(graph, curr, degree, gen, dist);
+
+              double y = dist(gen) * upper_bound;
+
+              double alpha;
+              //check if nbr is same as the previous node on this walk
+              if (nbr == prev) {
+                alpha = prob_backward;
+              }  //check if nbr is also a neighbor of the previous node on this walk
+              else if (graph.has_edge(prev, nbr)) {
+                alpha = 1.0;
+              } else {
+                alpha = prob_forward;
+              }
+
+              if (y <= alpha) {
+                walk_matrix[walker * nodes_per_walk + step] = nbr;
+                break;
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
+          katana::loopname("BiasedNode2vec walks"), katana::no_stats());
+    }
+
+    //! Gather matrix rows into the walk vectors callers expect.
+    katana::do_all(
+        katana::iterate(uint64_t(0), total_walks),
+        [&](uint64_t walker) {
+          uint32_t source = walk_matrix[walker * nodes_per_walk];
+          //check if source has no neighbor
+          if (degree[source] == 0) {
+            return;
+          }
+
+          std::vector<uint32_t> walk;
+          walk.reserve(nodes_per_walk);
+          for (uint64_t step = 0; step < nodes_per_walk; step++) {
+            uint32_t node = walk_matrix[walker * nodes_per_walk + step];
+            if (node == sentinel) {
+              break;
+            }
+            walk.push_back(node);
+          }
+          walks->push(std::move(walk));
+        },
+        katana::loopname("BiasedNode2vec gather"), katana::no_stats());
   }
 
   void operator()(
@@ -217,14 +437,7 @@ struct Edge2VecAlgo {
       katana::InsertBag<std::vector<uint32_t>>* walks,
       katana::InsertBag<std::vector<uint32_t>>* types_walks,
       const katana::NUMAArray<uint64_t>& degree) {
-    katana::PerThreadStorage<std::mt19937> generator;
-    katana::PerThreadStorage<std::uniform_real_distribution<double>*>
-        distribution;
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      *distribution.getRemote(i) =
-          new std::uniform_real_distribution<double>(0.0, 1.0);
-    }
+    const uint64_t seed = WalkSeed();
 
     double prob_forward = 1.0 / plan_.forward_probability();
     double prob_backward = 1.0 / plan_.backward_probability();
@@ -246,8 +459,8 @@ struct Edge2VecAlgo {
             return;
           }
 
-          std::uniform_real_distribution<double>* dist =
-              *distribution.getLocal();
+          katana::PhiloxRNG rng(seed, idx);
+          std::uniform_real_distribution<double> dist(0.0, 1.0);
 
           std::vector<uint32_t> walk;
           std::vector<uint32_t> types_vec;
@@ -255,7 +468,7 @@ struct Edge2VecAlgo {
           walk.push_back(n);
 
           //random value between 0 and 1
-          double prob = (*dist)(*generator.getLocal());
+          double prob = dist(rng);
 
           //Assumption: All edges have weight 1
           auto nbr_pair = FindSampleNeighbor(graph, n, degree, prob);
@@ -278,7 +491,7 @@ struct Edge2VecAlgo {
             //acceptance-rejection sampling
             while (true) {
               //sample x
-              double prob = (*dist)(*generator.getLocal());
+              double prob = dist(rng);
 
               auto nbr_type_pair =
                   FindSampleNeighbor(graph, curr, degree, prob);
@@ -288,7 +501,7 @@ struct Edge2VecAlgo {
               EdgeType::ViewType::value_type p2 = nbr_type_pair.second;
 
               //sample y
-              double y = (*dist)(*generator.getLocal());
+              double y = dist(rng);
               y = y * upper_bound;
 
               //compute transition probability
@@ -467,6 +680,55 @@ struct Edge2VecAlgo {
   }
 };
 
+//! Copy an arrow weight column into a flat array indexed by edge property
+//! index; null weights count as zero.
+template <typename ArrowType>
+void
+CopyEdgeWeights(
+    const arrow::ChunkedArray& weights, katana::NUMAArray<double>* out) {
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+
+  int64_t index = 0;
+  for (const auto& chunk : weights.chunks()) {
+    auto array = std::static_pointer_cast<ArrayType>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i, ++index) {
+      (*out)[index] =
+          array->IsValid(i) ? static_cast<double>(array->Value(i)) : 0.0;
+    }
+  }
+}
+
+//! Dispatch CopyEdgeWeights over the column's runtime type.
+katana::Result<void>
+CopyEdgeWeightsByType(
+    const arrow::ChunkedArray& weights, katana::NUMAArray<double>* out) {
+  switch (weights.type()->id()) {
+  case arrow::UInt32Type::type_id:
+    CopyEdgeWeights<arrow::UInt32Type>(weights, out);
+    break;
+  case arrow::Int32Type::type_id:
+    CopyEdgeWeights<arrow::Int32Type>(weights, out);
+    break;
+  case arrow::UInt64Type::type_id:
+    CopyEdgeWeights<arrow::UInt64Type>(weights, out);
+    break;
+  case arrow::Int64Type::type_id:
+    CopyEdgeWeights<arrow::Int64Type>(weights, out);
+    break;
+  case arrow::FloatType::type_id:
+    CopyEdgeWeights<arrow::FloatType>(weights, out);
+    break;
+  case arrow::DoubleType::type_id:
+    CopyEdgeWeights<arrow::DoubleType>(weights, out);
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        weights.type()->ToString());
+  }
+  return katana::ResultSuccess();
+}
+
 template <typename Graph>
 void
 InitializeDegrees(const Graph& graph, katana::NUMAArray<uint64_t>* degree) {
@@ -517,11 +779,87 @@ katana::analytics::RandomWalks(PropertyGraph* pg, RandomWalksPlan plan) {
         Edge2VecAlgo::SortedGraphView::Make(pg, {}, {tmp_edge_prop.name()}));
     return RandomWalksWithWrap<Edge2VecAlgo>(graph, plan);
   }
+  case RandomWalksPlan::kBiasedNode2Vec:
+    return BiasedRandomWalks(pg, "", plan);
   default:
     return ErrorCode::InvalidArgument;
   }
 }
 
+katana::Result<std::vector<std::vector<uint32_t>>>
+katana::analytics::BiasedRandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan) {
+  if (plan.algorithm() != RandomWalksPlan::kBiasedNode2Vec) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  auto graph =
+      KATANA_CHECKED(BiasedNode2VecAlgo::SortedGraphView::Make(pg, {}, {}));
+
+  //! Weights indexed by the sorted view's edge ids; an empty property name
+  //! means unit weights.
+  katana::NUMAArray<double> edge_weight;
+  edge_weight.allocateInterleaved(graph.num_edges());
+  if (edge_weight_property_name.empty()) {
+    katana::do_all(
+        katana::iterate(uint64_t(0), uint64_t(graph.num_edges())),
+        [&](uint64_t e) { edge_weight[e] = 1.0; }, katana::no_stats());
+  } else {
+    auto weights =
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name));
+
+    //! A materialized copy is already permuted into the sorted view's
+    //! edge order, so its values copy straight across; columns the view
+    //! cache cannot materialize (multi-chunk, nulls, non-fixed-width)
+    //! fall back to gathering through the property index mapping.
+    if (auto materialized =
+            graph.GetMaterializedEdgeProperty(edge_weight_property_name);
+        materialized) {
+      arrow::ChunkedArray one_chunk(
+          arrow::ArrayVector{std::move(materialized.value())});
+      KATANA_CHECKED(CopyEdgeWeightsByType(one_chunk, &edge_weight));
+    } else {
+      katana::NUMAArray<double> property_weight;
+      property_weight.allocateInterleaved(graph.num_edges());
+      KATANA_CHECKED(CopyEdgeWeightsByType(*weights, &property_weight));
+
+      //! The sorted view reorders edges, so route the weights through the
+      //! property index mapping.
+      katana::do_all(
+          katana::iterate(uint64_t(0), uint64_t(graph.num_edges())),
+          [&](uint64_t e) {
+            edge_weight[e] = property_weight[graph.edge_property_index(e)];
+          },
+          katana::no_stats());
+    }
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+
+  BiasedNode2VecAlgo algo(plan);
+
+  katana::NUMAArray<uint64_t> degree;
+  degree.allocateBlocked(graph.size());
+  InitializeDegrees(graph, &degree);
+
+  katana::StatTimer build_time("BiasedRandomWalksAliasTables");
+  build_time.start();
+  algo.BuildAliasTables(graph, edge_weight);
+  build_time.stop();
+
+  katana::StatTimer execTime("RandomWalks");
+  execTime.start();
+  katana::InsertBag<std::vector<uint32_t>> walks;
+  algo(graph, &walks, degree);
+  execTime.stop();
+
+  std::vector<std::vector<uint32_t>> walks_in_vector;
+  walks_in_vector.reserve(plan.number_of_walks());
+  std::move(walks.begin(), walks.end(), std::back_inserter(walks_in_vector));
+  return walks_in_vector;
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::RandomWalksAssertValid([
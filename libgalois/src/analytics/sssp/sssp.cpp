@@ -19,6 +19,10 @@
 
 #include "katana/analytics/sssp/sssp.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "katana/FrontierEngine.h"
 #include "katana/Reduction.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
@@ -312,47 +316,46 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
     katana::ReportStatSingle("SSSP-Dijkstra", "Iterations", iter);
   }
 
-  static void TopoAlgo(Graph* graph, const typename Graph::Node& source) {
-    katana::NUMAArray<Dist> old_dist;
-    old_dist.allocateInterleaved(graph->size());
+  static void TopoAlgo(
+      katana::NUMAArray<std::atomic<Weight>>* node_data,
+      katana::NUMAArray<Weight>* edge_data, Graph* graph,
+      const typename Graph::Node& source) {
+    using BiDirView = katana::PropertyGraphViews::BiDirectional;
+    using GNode = typename Graph::Node;
 
-    katana::do_all(
-        katana::iterate(size_t{0}, graph->size()),
-        [&](size_t i) { old_dist.constructAt(i, kDistanceInfinity); },
-        katana::no_stats(), katana::loopname("initDistArray"));
+    BiDirView bidir_view =
+        graph->GetPropertyGraph().template BuildView<BiDirView>();
 
-    graph->template GetData<NodeDistance>(source) = 0;
+    katana::FrontierPlan frontier_plan;
+    // A node must take the minimum over all its frontier in-neighbors, so
+    // pulls cannot stop at the first improvement.
+    frontier_plan.pull_stop_on_update = false;
 
-    katana::GReduceLogicalOr changed;
-    size_t rounds = 0;
+    katana::FrontierEngine<BiDirView> engine(bidir_view, frontier_plan);
 
-    do {
-      ++rounds;
-      changed.reset();
-
-      katana::do_all(
-          katana::iterate(*graph),
-          [&](const typename Graph::Node& n) {
-            const auto& sdata = graph->template GetData<NodeDistance>(n);
+    (*node_data)[source] = 0;
+    engine.AddSeed(source);
 
-            if (old_dist[n] > sdata) {
-              old_dist[n] = sdata;
-              changed.update(true);
-
-              for (auto e : graph->edges(n)) {
-                const Weight new_dist =
-                    sdata + graph->template GetEdgeData<EdgeWeight>(e);
-                auto dest = graph->GetEdgeDest(e);
-                auto& ddata = graph->template GetData<NodeDistance>(dest);
-                katana::atomicMin(ddata, new_dist);
-              }
-            }
-          },
-          katana::steal(), katana::loopname("Update"));
-
-    } while (changed.reduce());
-
-    katana::ReportStatSingle("SSSP-Topo", "rounds", rounds);
+    engine.Run(
+        [&](const GNode& src, const GNode& dst, const auto& e) {
+          const Weight new_dist =
+              (*node_data)[src].load(std::memory_order_relaxed) +
+              (*edge_data)[e];
+          return katana::atomicMin((*node_data)[dst], new_dist) > new_dist;
+        },
+        [&](const GNode&) { return true; },
+        [&](const GNode& dst, const GNode& src, const auto& e) {
+          const Weight new_dist =
+              (*node_data)[src].load(std::memory_order_relaxed) +
+              (*edge_data)[bidir_view.in_edge_property_index(e)];
+          auto& ddata = (*node_data)[dst];
+          if (new_dist < ddata.load(std::memory_order_relaxed)) {
+            ddata.store(new_dist, std::memory_order_relaxed);
+            return true;
+          }
+          return false;
+        },
+        "SSSP-Topo");
   }
 
   void TopoTileAlgo(Graph* graph, const typename Graph::Node& source) {
@@ -480,7 +483,7 @@ public:
           &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph});
       break;
     case SsspPlan::kTopological:
-      TopoAlgo(&graph, source);
+      TopoAlgo(&node_data, &edge_data, &graph, source);
       break;
     case SsspPlan::kTopologicalTile:
       TopoTileAlgo(&graph, source);
@@ -579,6 +582,93 @@ katana::analytics::Sssp(
 
 namespace {
 
+constexpr int64_t kDeltaSampleSize = 1024;
+
+/// Mean of up to kDeltaSampleSize weights taken at a uniform stride, so the
+/// sample covers every chunk of large properties in one forward pass.
+template <typename ArrowType>
+double
+MeanSampledWeight(const arrow::ChunkedArray& weights) {
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+
+  const int64_t stride =
+      std::max<int64_t>(1, weights.length() / kDeltaSampleSize);
+  double sum = 0.0;
+  int64_t count = 0;
+  int64_t chunk_begin = 0;
+  int64_t next = 0;
+  for (const auto& chunk : weights.chunks()) {
+    auto array = std::static_pointer_cast<ArrayType>(chunk);
+    while (next < chunk_begin + array->length()) {
+      if (array->IsValid(next - chunk_begin)) {
+        sum += static_cast<double>(array->Value(next - chunk_begin));
+        ++count;
+      }
+      next += stride;
+    }
+    chunk_begin += array->length();
+  }
+  return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+}  // namespace
+
+katana::Result<SsspPlan>
+katana::analytics::AutotuneDeltaSsspPlan(
+    PropertyGraph* pg, const std::string& edge_weight_property_name) {
+  auto weights = KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name));
+
+  double mean_weight = 0.0;
+  switch (weights->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    mean_weight = MeanSampledWeight<arrow::UInt32Type>(*weights);
+    break;
+  case arrow::Int32Type::type_id:
+    mean_weight = MeanSampledWeight<arrow::Int32Type>(*weights);
+    break;
+  case arrow::UInt64Type::type_id:
+    mean_weight = MeanSampledWeight<arrow::UInt64Type>(*weights);
+    break;
+  case arrow::Int64Type::type_id:
+    mean_weight = MeanSampledWeight<arrow::Int64Type>(*weights);
+    break;
+  case arrow::FloatType::type_id:
+    mean_weight = MeanSampledWeight<arrow::FloatType>(*weights);
+    break;
+  case arrow::DoubleType::type_id:
+    mean_weight = MeanSampledWeight<arrow::DoubleType>(*weights);
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        weights->type()->ToString());
+  }
+
+  const uint64_t num_nodes = pg->topology().num_nodes();
+  const uint64_t num_edges = pg->topology().num_edges();
+  if (num_edges == 0 || mean_weight <= 0.0) {
+    // Nothing to learn from (empty graph or all-zero sample); keep the
+    // default bucket width.
+    return SsspPlan::DeltaStepFusion();
+  }
+
+  // Size the bucket so a node expects one light-edge relaxation per bucket:
+  // delta near mean_weight / average_degree, rounded to the nearest power of
+  // two because the plan carries the shift.
+  const double average_degree = static_cast<double>(num_edges) /
+                                static_cast<double>(std::max<uint64_t>(
+                                    num_nodes, 1));
+  const double delta = std::max(1.0, mean_weight / average_degree);
+  const unsigned shift =
+      std::min(31U, static_cast<unsigned>(std::llround(std::log2(delta))));
+
+  katana::ReportStatSingle("SSSP", "AutotunedDeltaShift", shift);
+
+  return SsspPlan::DeltaStepFusion(shift);
+}
+
+namespace {
+
 template <typename Weight>
 static katana::Result<void>
 SsspValidateImpl(
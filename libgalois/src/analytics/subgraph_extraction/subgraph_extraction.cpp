@@ -21,6 +21,8 @@
 
 #include <iostream>
 
+#include <arrow/compute/api_vector.h>
+
 #include "katana/PropertyGraph.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
@@ -34,9 +36,46 @@ using SortedGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
 using Node = SortedGraphView::Node;
 using Edge = SortedGraphView::Edge;
 
+/// Gather the rows named by indices out of every column of the given schema,
+/// one arrow Take per column run in parallel across columns.
+template <typename ColumnFn>
+katana::Result<std::shared_ptr<arrow::Table>>
+GatherPropertyRows(
+    const std::shared_ptr<arrow::Schema>& schema, const ColumnFn& column_fn,
+    const std::shared_ptr<arrow::Array>& indices) {
+  int num_fields = schema->num_fields();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(num_fields);
+  std::vector<katana::Result<void>> results(
+      num_fields, katana::ResultSuccess());
+
+  katana::do_all(
+      katana::iterate(0, num_fields),
+      [&](int i) {
+        auto taken = arrow::compute::Take(column_fn(i), indices);
+        if (!taken.ok()) {
+          results[i] = KATANA_ERROR(
+              katana::ErrorCode::ArrowError, "gathering property {}: {}",
+              schema->field(i)->name(), taken.status().ToString());
+          return;
+        }
+        columns[i] = taken.ValueOrDie().chunked_array();
+      },
+      katana::loopname("SubgraphExtraction_GatherProperties"),
+      katana::no_stats());
+
+  for (auto& r : results) {
+    if (!r) {
+      return r.error();
+    }
+  }
+
+  return arrow::Table::Make(schema, columns);
+}
+
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
 SubGraphNodeSet(
-    const SortedGraphView& graph, const std::vector<Node>& node_set) {
+    const katana::PropertyGraph& pg, const SortedGraphView& graph,
+    const std::vector<Node>& node_set) {
   uint64_t num_nodes = node_set.size();
   // Subgraph topology : out indices
   katana::NUMAArray<Edge> out_indices;
@@ -44,6 +83,10 @@ SubGraphNodeSet(
 
   katana::gstl::Vector<katana::gstl::Vector<Node>> subgraph_edges;
   subgraph_edges.resize(num_nodes);
+  // Original property index of each extracted edge, used to gather the edge
+  // property rows afterwards.
+  katana::gstl::Vector<katana::gstl::Vector<uint64_t>> subgraph_edge_rows;
+  subgraph_edge_rows.resize(num_nodes);
 
   katana::do_all(
       katana::iterate(Node(0), Node(num_nodes)),
@@ -58,6 +101,8 @@ SubGraphNodeSet(
                edge_it != last && graph.edge_dest(*edge_it) == dest;
                ++edge_it) {
             subgraph_edges[n].push_back(m);
+            subgraph_edge_rows[n].push_back(
+                graph.edge_property_index(*edge_it));
           }
         }
         out_indices[n] = subgraph_edges[n].size();
@@ -72,13 +117,16 @@ SubGraphNodeSet(
   // Subgraph topology : out dests
   katana::NUMAArray<Node> out_dests;
   out_dests.allocateInterleaved(num_edges);
+  katana::NUMAArray<uint64_t> edge_rows;
+  edge_rows.allocateInterleaved(num_edges);
 
   katana::do_all(
       katana::iterate(Node(0), Node(num_nodes)),
       [&](const Node& n) {
         uint64_t offset = n == 0 ? 0 : out_indices[n - 1];
-        for (Node dest : subgraph_edges[n]) {
-          out_dests[offset] = dest;
+        for (uint64_t i = 0; i < subgraph_edges[n].size(); ++i) {
+          out_dests[offset] = subgraph_edges[n][i];
+          edge_rows[offset] = subgraph_edge_rows[n][i];
           offset++;
         }
       },
@@ -86,9 +134,39 @@ SubGraphNodeSet(
 
   katana::GraphTopology sub_g_topo{
       std::move(out_indices), std::move(out_dests)};
-  auto sub_g_res = katana::PropertyGraph::Make(std::move(sub_g_topo));
+  std::unique_ptr<katana::PropertyGraph> sub_g =
+      KATANA_CHECKED(katana::PropertyGraph::Make(std::move(sub_g_topo)));
+
+  // Gather the property rows of the extracted nodes and edges so the
+  // sub-graph is complete without a manual re-join.
+  arrow::UInt64Builder node_rows_builder;
+  KATANA_CHECKED(node_rows_builder.Reserve(num_nodes));
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    node_rows_builder.UnsafeAppend(graph.node_property_index(node_set[n]));
+  }
+  std::shared_ptr<arrow::Array> node_rows =
+      KATANA_CHECKED(node_rows_builder.Finish());
+
+  arrow::UInt64Builder edge_rows_builder;
+  KATANA_CHECKED(edge_rows_builder.Reserve(num_edges));
+  for (uint64_t e = 0; e < num_edges; ++e) {
+    edge_rows_builder.UnsafeAppend(edge_rows[e]);
+  }
+  std::shared_ptr<arrow::Array> edge_rows_array =
+      KATANA_CHECKED(edge_rows_builder.Finish());
+
+  if (pg.loaded_node_schema()->num_fields() > 0) {
+    KATANA_CHECKED(sub_g->AddNodeProperties(KATANA_CHECKED(GatherPropertyRows(
+        pg.loaded_node_schema(),
+        [&](int i) { return pg.GetNodeProperty(i); }, node_rows))));
+  }
+  if (pg.loaded_edge_schema()->num_fields() > 0) {
+    KATANA_CHECKED(sub_g->AddEdgeProperties(KATANA_CHECKED(GatherPropertyRows(
+        pg.loaded_edge_schema(),
+        [&](int i) { return pg.GetEdgeProperty(i); }, edge_rows_array))));
+  }
 
-  return sub_g_res;
+  return std::unique_ptr<katana::PropertyGraph>(std::move(sub_g));
 }
 }  // namespace
 
@@ -115,12 +193,21 @@ katana::analytics::SubGraphExtraction(
   switch (plan.algorithm()) {
   case SubGraphExtractionPlan::kNodeSet: {
     execTime.start();
-    auto subgraph = SubGraphNodeSet(sg, dedup_node_vec);
+    auto subgraph = SubGraphNodeSet(*pg, sg, dedup_node_vec);
     execTime.stop();
-    KATANA_LOG_DEBUG_ASSERT(subgraph);
-    return std::move(subgraph.value());
+    return subgraph;
   }
   default:
     return katana::ErrorCode::InvalidArgument;
   }
 }
+
+katana::Result<void>
+katana::analytics::SubGraphExtractionToRdg(
+    katana::PropertyGraph* pg, const std::vector<Node>& node_vec,
+    const std::string& output_rdg_path, const std::string& command_line,
+    SubGraphExtractionPlan plan) {
+  std::unique_ptr<katana::PropertyGraph> sub_g =
+      KATANA_CHECKED(SubGraphExtraction(pg, node_vec, plan));
+  return sub_g->Write(output_rdg_path, command_line);
+}
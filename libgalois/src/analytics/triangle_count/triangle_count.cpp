@@ -19,6 +19,7 @@
 
 #include "katana/analytics/triangle_count/triangle_count.h"
 
+#include "katana/SortedIntersection.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -60,28 +61,18 @@ LowerBound(Iterator first, Iterator last, Compare comp) {
 }
 
 /**
- * std::set_intersection over edge_iterators.
+ * Intersection count over edge_iterator ranges. Edge ids index directly into
+ * the topology's sorted destination array, so the count runs on the raw
+ * arrays through the vectorized katana::SortedIntersectionCount kernel.
  */
 template <typename G>
 size_t
 CountEqual(
     const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
     typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = g.edge_dest(*aa);
-    typename G::Node b = g.edge_dest(*bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+  const auto* dests = g.dest_data();
+  return katana::SortedIntersectionCount(
+      dests + *aa, *ea - *aa, dests + *bb, *eb - *bb);
 }
 
 template <typename G>
@@ -0,0 +1,313 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/weighted_matching/weighted_matching.h"
+
+#include <atomic>
+
+#include "katana/NUMAArray.h"
+#include "katana/Reduction.h"
+#include "katana/Statistics.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+constexpr static const unsigned kChunkSize = 64U;
+
+template <typename Weight>
+using MatchingEdgeWeight = katana::PODProperty<Weight>;
+
+struct MatchingPartner : public katana::PODProperty<uint32_t> {};
+
+/**
+ * Suitor algorithm for approximate maximum weight matching
+ * (Manne and Halappanavar). Every node proposes to the heaviest neighbor
+ * whose standing offer it can beat; proposals live in a lock-free per-node
+ * array updated with a compare-and-swap maximum. When a proposal displaces
+ * an earlier suitor, the displaced node re-proposes to its next-best
+ * neighbor inside the same work item, so conflicts are resolved where they
+ * arise instead of being deferred to another round.
+ *
+ * Offers are ordered by weight with ties broken by proposer ID, so the
+ * matching is the unique greedy one under that order and does not depend on
+ * the parallel schedule.
+ */
+template <typename Weight>
+struct SuitorAlgo {
+  using NodeData = std::tuple<MatchingPartner>;
+  using EdgeData = std::tuple<MatchingEdgeWeight<Weight>>;
+  // The edge lists must be sorted by destination so that the weight of the
+  // incumbent suitor's edge can be looked up with find_edge when comparing
+  // offers.
+  using SortedGraphView = katana::TypedPropertyGraphView<
+      katana::PropertyGraphViews::EdgesSortedByDestID, NodeData, EdgeData>;
+  using GNode = typename SortedGraphView::Node;
+
+  SortedGraphView* graph;
+
+  Weight WeightOf(GNode u, GNode v) {
+    return graph->template GetEdgeData<MatchingEdgeWeight<Weight>>(
+        *graph->find_edge(u, v));
+  }
+
+  /// Would an offer of weight w from u beat the offer v currently holds
+  /// from incumbent? Heavier offers win; equal weights go to the lower
+  /// proposer ID.
+  bool Beats(GNode u, Weight w, GNode incumbent, GNode v) {
+    if (incumbent == kUnmatchedPartnerId) {
+      return true;
+    }
+    Weight incumbent_w = WeightOf(incumbent, v);
+    return w > incumbent_w || (w == incumbent_w && u < incumbent);
+  }
+
+  /// Run the suitor kernel starting from node u. Each iteration finds the
+  /// best neighbor whose offer u can beat, installs the proposal with a CAS
+  /// maximum, and continues with the suitor it displaced (if any).
+  void Propose(GNode u, katana::NUMAArray<std::atomic<uint32_t>>* suitor) {
+    GNode cur = u;
+    while (cur != kUnmatchedPartnerId) {
+      GNode best = kUnmatchedPartnerId;
+      Weight best_w{};
+
+      for (auto e : graph->edges(cur)) {
+        GNode v = graph->edge_dest(e);
+        if (v == cur) {
+          continue;
+        }
+        Weight w =
+            graph->template GetEdgeData<MatchingEdgeWeight<Weight>>(e);
+        if (best != kUnmatchedPartnerId &&
+            (w < best_w || (w == best_w && v >= best))) {
+          continue;
+        }
+        if (!Beats(cur, w, (*suitor)[v].load(std::memory_order_relaxed), v)) {
+          continue;
+        }
+        best = v;
+        best_w = w;
+      }
+
+      if (best == kUnmatchedPartnerId) {
+        // No neighbor's offer can be beaten; cur stays unmatched for now
+        // and is reactivated only if someone proposes to it.
+        break;
+      }
+
+      uint32_t old = (*suitor)[best].load(std::memory_order_relaxed);
+      bool installed = false;
+      while (Beats(cur, best_w, old, best)) {
+        if ((*suitor)[best].compare_exchange_weak(old, cur)) {
+          installed = true;
+          break;
+        }
+      }
+      if (!installed) {
+        // Lost the race to a better offer; rescan with fresh offers.
+        continue;
+      }
+
+      // The displaced suitor (if any) re-proposes next.
+      cur = old;
+    }
+  }
+
+  katana::Result<void> operator()(SortedGraphView* g) {
+    graph = g;
+
+    katana::StatTimer exec_time("WeightedMatching", "WeightedMatching");
+    exec_time.start();
+
+    katana::NUMAArray<std::atomic<uint32_t>> suitor;
+    suitor.allocateInterleaved(graph->num_nodes());
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          suitor[n].store(kUnmatchedPartnerId, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) { Propose(n, &suitor); },
+        katana::chunk_size<kChunkSize>(), katana::steal(),
+        katana::loopname("WeightedMatching_Suitor"));
+
+    // At convergence matched pairs hold each other's proposals; everything
+    // else is unmatched.
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          uint32_t s = suitor[n].load(std::memory_order_relaxed);
+          if (s != kUnmatchedPartnerId &&
+              suitor[s].load(std::memory_order_relaxed) == n) {
+            graph->template GetData<MatchingPartner>(n) = s;
+          } else {
+            graph->template GetData<MatchingPartner>(n) = kUnmatchedPartnerId;
+          }
+        },
+        katana::no_stats());
+
+    exec_time.stop();
+
+    return katana::ResultSuccess();
+  }
+};
+
+template <typename Weight>
+katana::Result<void>
+WeightedMatchingWithWrap(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, WeightedMatchingPlan plan) {
+  KATANA_CHECKED(ConstructNodeProperties<std::tuple<MatchingPartner>>(
+      pg, {output_property_name}));
+
+  using Graph = typename SuitorAlgo<Weight>::SortedGraphView;
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {output_property_name}, {edge_weight_property_name}));
+
+  katana::EnsurePreallocated(4, 8 * (pg->num_nodes() + pg->num_edges()));
+  katana::ReportPageAllocGuard page_alloc;
+
+  switch (plan.algorithm()) {
+  case WeightedMatchingPlan::kSuitor: {
+    SuitorAlgo<Weight> algo;
+    return algo(&graph);
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::WeightedMatching(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, WeightedMatchingPlan plan) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return WeightedMatchingWithWrap<uint32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return WeightedMatchingWithWrap<int32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return WeightedMatchingWithWrap<uint64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return WeightedMatchingWithWrap<int64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::FloatType::type_id:
+    return WeightedMatchingWithWrap<float>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return WeightedMatchingWithWrap<double>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+/// \cond DO_NOT_DOCUMENT
+namespace {
+
+template <typename Weight>
+katana::Result<WeightedMatchingStatistics>
+ComputeStatistics(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  using Graph = typename SuitorAlgo<Weight>::SortedGraphView;
+  using GNode = typename Graph::Node;
+
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {property_name}, {edge_weight_property_name}));
+
+  katana::GAccumulator<uint64_t> matched_pairs;
+  katana::GAccumulator<double> total_weight;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        uint32_t partner = graph.template GetData<MatchingPartner>(n);
+        if (partner != kUnmatchedPartnerId && n < partner) {
+          matched_pairs += 1;
+          total_weight += static_cast<double>(
+              graph.template GetEdgeData<MatchingEdgeWeight<Weight>>(
+                  *graph.find_edge(n, partner)));
+        }
+      },
+      katana::loopname("WeightedMatching sanity check"), katana::no_stats());
+
+  return WeightedMatchingStatistics{
+      matched_pairs.reduce(), total_weight.reduce()};
+}
+
+}  // namespace
+
+katana::Result<WeightedMatchingStatistics>
+katana::analytics::WeightedMatchingStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return ComputeStatistics<uint32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int32Type::type_id:
+    return ComputeStatistics<int32_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::UInt64Type::type_id:
+    return ComputeStatistics<uint64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::Int64Type::type_id:
+    return ComputeStatistics<int64_t>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::FloatType::type_id:
+    return ComputeStatistics<float>(
+        pg, edge_weight_property_name, property_name);
+  case arrow::DoubleType::type_id:
+    return ComputeStatistics<double>(
+        pg, edge_weight_property_name, property_name);
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+/// \endcond DO_NOT_DOCUMENT
+
+void
+katana::analytics::WeightedMatchingStatistics::Print(std::ostream& os) const {
+  os << "Number of matched pairs = " << number_of_matched_pairs << std::endl;
+  os << "Total weight = " << total_weight << std::endl;
+}
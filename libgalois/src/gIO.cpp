@@ -32,6 +32,7 @@
 #include <iostream>
 #include <mutex>
 
+#include "katana/AsyncLog.h"
 #include "katana/Env.h"
 #include "katana/SimpleLock.h"
 #include "katana/ThreadPool.h"
@@ -81,7 +82,7 @@ katana::gDebugStr(const std::string& s) {
     }
     debugOut << os.str() << "\n";
     debugOut.flush();
-  } else {
+  } else if (!internal::AsyncLogString(LogLevel::Debug, os.str())) {
     printString(true, true, "DEBUG", os.str());
   }
 }
@@ -93,16 +94,25 @@ katana::gPrintStr(const std::string& s) {
 
 void
 katana::gInfoStr(const std::string& s) {
+  if (internal::AsyncLogString(LogLevel::Verbose, s)) {
+    return;
+  }
   printString(false, true, "INFO", s);
 }
 
 void
 katana::gWarnStr(const std::string& s) {
+  if (internal::AsyncLogString(LogLevel::Warning, s)) {
+    return;
+  }
   printString(false, true, "WARNING", s);
 }
 
 void
 katana::gErrorStr(const std::string& s) {
+  if (internal::AsyncLogString(LogLevel::Error, s)) {
+    return;
+  }
   printString(true, true, "ERROR", s);
 }
 
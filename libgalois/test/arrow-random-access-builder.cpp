@@ -0,0 +1,106 @@
+#include "katana/ArrowRandomAccessBuilder.h"
+
+#include <memory>
+
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+void
+TestInt64() {
+  // large enough that finalization spans several bitmap bytes and copy blocks
+  constexpr size_t kLength = 100000;
+  katana::ArrowRandomAccessBuilder<arrow::Int64Type> builder(kLength);
+  int64_t expected_nulls = 0;
+  for (size_t i = 0; i < kLength; ++i) {
+    if (i % 7 == 0) {
+      ++expected_nulls;
+      continue;
+    }
+    builder[i] = static_cast<int64_t>(i);
+  }
+
+  std::shared_ptr<arrow::Array> array = builder.Finalize().value();
+  KATANA_LOG_ASSERT(static_cast<size_t>(array->length()) == kLength);
+  KATANA_LOG_ASSERT(array->null_count() == expected_nulls);
+
+  const auto& typed = static_cast<const arrow::Int64Array&>(*array);
+  for (size_t i = 0; i < kLength; ++i) {
+    if (i % 7 == 0) {
+      KATANA_LOG_ASSERT(typed.IsNull(i));
+    } else {
+      KATANA_LOG_ASSERT(typed.IsValid(i));
+      KATANA_LOG_ASSERT(typed.Value(i) == static_cast<int64_t>(i));
+    }
+  }
+}
+
+void
+TestBool() {
+  constexpr size_t kLength = 1000;
+  katana::ArrowRandomAccessBuilder<arrow::BooleanType> builder(kLength);
+  for (size_t i = 0; i < kLength; ++i) {
+    if (i % 5 == 0) {
+      continue;
+    }
+    builder[i] = (i % 2 == 0);
+  }
+
+  std::shared_ptr<arrow::Array> array = builder.Finalize().value();
+  const auto& typed = static_cast<const arrow::BooleanArray&>(*array);
+  for (size_t i = 0; i < kLength; ++i) {
+    if (i % 5 == 0) {
+      KATANA_LOG_ASSERT(typed.IsNull(i));
+    } else {
+      KATANA_LOG_ASSERT(typed.IsValid(i));
+      KATANA_LOG_ASSERT(typed.Value(i) == (i % 2 == 0));
+    }
+  }
+}
+
+void
+TestString() {
+  constexpr size_t kLength = 100;
+  katana::ArrowRandomAccessBuilder<arrow::StringType> builder(kLength);
+  for (size_t i = 0; i < kLength; ++i) {
+    if (i % 3 == 0) {
+      continue;
+    }
+    builder[i] = std::to_string(i);
+  }
+
+  std::shared_ptr<arrow::Array> array = builder.Finalize().value();
+  const auto& typed = static_cast<const arrow::StringArray&>(*array);
+  for (size_t i = 0; i < kLength; ++i) {
+    if (i % 3 == 0) {
+      KATANA_LOG_ASSERT(typed.IsNull(i));
+    } else {
+      KATANA_LOG_ASSERT(typed.GetString(i) == std::to_string(i));
+    }
+  }
+}
+
+void
+TestEmpty() {
+  katana::ArrowRandomAccessBuilder<arrow::Int32Type> builder(0);
+  std::shared_ptr<arrow::Array> array = builder.Finalize().value();
+  KATANA_LOG_ASSERT(array->length() == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestInt64();
+
+  TestBool();
+
+  TestString();
+
+  TestEmpty();
+
+  return 0;
+}
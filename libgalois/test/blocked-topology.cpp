@@ -0,0 +1,57 @@
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+using BlockedGraphView = katana::PropertyGraphViews::EdgesBlocked;
+
+void
+TestBlocksCoverTopology(katana::PropertyGraph* pg) noexcept {
+  const katana::GraphTopology& topo = pg->topology();
+  BlockedGraphView blocked_view = pg->BuildView<BlockedGraphView>();
+
+  KATANA_LOG_ASSERT(blocked_view.num_nodes() == topo.num_nodes());
+  KATANA_LOG_ASSERT(blocked_view.num_edges() == topo.num_edges());
+
+  uint64_t edges_seen = 0;
+  for (uint64_t b = 0; b < blocked_view.num_blocks(); ++b) {
+    const katana::EdgeBlockDescriptor& desc = blocked_view.block(b);
+
+    // Blocks tile the edge ID space in order without gaps.
+    KATANA_LOG_ASSERT(desc.edge_begin == edges_seen);
+    KATANA_LOG_ASSERT(desc.edge_begin < desc.edge_end);
+    edges_seen = desc.edge_end;
+
+    KATANA_LOG_ASSERT(topo.edge_source(desc.edge_begin) == desc.first_node);
+
+    // Destination bounds are tight over the block's edges.
+    katana::GraphTopologyTypes::Node min_dest =
+        std::numeric_limits<katana::GraphTopologyTypes::Node>::max();
+    katana::GraphTopologyTypes::Node max_dest = 0;
+    for (auto e : blocked_view.block_edges(b)) {
+      min_dest = std::min(min_dest, topo.edge_dest(e));
+      max_dest = std::max(max_dest, topo.edge_dest(e));
+    }
+    KATANA_LOG_ASSERT(desc.min_dest == min_dest);
+    KATANA_LOG_ASSERT(desc.max_dest == max_dest);
+  }
+  KATANA_LOG_ASSERT(edges_seen == topo.num_edges());
+}
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // Enough edges for several blocks plus a partial tail block.
+  constexpr size_t kNumNodes = 20000;
+  constexpr size_t kEdgesPerNode = 10;
+
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+
+  auto pg_result = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(pg_result);
+
+  TestBlocksCoverTopology(pg_result.value().get());
+
+  return 0;
+}
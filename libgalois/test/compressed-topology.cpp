@@ -0,0 +1,59 @@
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+using CompressedGraphView =
+    katana::PropertyGraphViews::CompressedEdgesSortedByDestID;
+using SortedGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
+
+void
+TestDecodeMatchesSortedView(katana::PropertyGraph* pg) noexcept {
+  SortedGraphView sorted_view = pg->BuildView<SortedGraphView>();
+  CompressedGraphView compressed_view = pg->BuildView<CompressedGraphView>();
+
+  KATANA_LOG_ASSERT(compressed_view.num_nodes() == sorted_view.num_nodes());
+  KATANA_LOG_ASSERT(compressed_view.num_edges() == sorted_view.num_edges());
+
+  std::vector<katana::GraphTopologyTypes::Node> buf;
+  for (auto node : compressed_view.all_nodes()) {
+    KATANA_LOG_ASSERT(
+        compressed_view.degree(node) == sorted_view.degree(node));
+
+    // Lazily-decoding iterator agrees with the uncompressed sorted view.
+    auto sorted_edges = sorted_view.edges(node);
+    auto sorted_it = sorted_edges.begin();
+    for (auto dest : compressed_view.neighbors(node)) {
+      KATANA_LOG_ASSERT(sorted_it != sorted_edges.end());
+      KATANA_LOG_ASSERT(dest == sorted_view.edge_dest(*sorted_it));
+      ++sorted_it;
+    }
+    KATANA_LOG_ASSERT(sorted_it == sorted_edges.end());
+
+    // Block decode agrees with the iterator.
+    buf.resize(compressed_view.degree(node));
+    size_t decoded = compressed_view.DecodeNeighborhood(node, buf.data());
+    KATANA_LOG_ASSERT(decoded == compressed_view.degree(node));
+    size_t i = 0;
+    for (auto dest : compressed_view.neighbors(node)) {
+      KATANA_LOG_ASSERT(buf[i++] == dest);
+    }
+  }
+}
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  constexpr size_t kNumNodes = 1000;
+  constexpr size_t kEdgesPerNode = 5;
+
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+
+  auto pg_result = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(pg_result);
+
+  TestDecodeMatchesSortedView(pg_result.value().get());
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include "katana/DegreeDistribution.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+/// Makes a topology where node i has out-degree i; every edge points at
+/// node 0.
+katana::GraphTopology
+MakeSkewedTopology(size_t num_nodes) {
+  katana::NUMAArray<Edge> adj_indices;
+  adj_indices.allocateInterleaved(num_nodes);
+  Edge num_edges = 0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    num_edges += i;
+    adj_indices[i] = num_edges;
+  }
+
+  katana::NUMAArray<Node> dests;
+  dests.allocateInterleaved(num_edges);
+  for (Edge e = 0; e < num_edges; ++e) {
+    dests[e] = 0;
+  }
+
+  return katana::GraphTopology(std::move(adj_indices), std::move(dests));
+}
+
+void
+TestQueries(size_t num_nodes) {
+  katana::DegreeDistribution dist =
+      katana::DegreeDistribution::Make(MakeSkewedTopology(num_nodes));
+
+  KATANA_LOG_ASSERT(dist.num_nodes() == num_nodes);
+  KATANA_LOG_ASSERT(dist.DegreePercentile(0.0) == 0);
+  KATANA_LOG_ASSERT(dist.DegreePercentile(1.0) == num_nodes - 1);
+  KATANA_LOG_ASSERT(dist.DegreePercentile(0.5) == (num_nodes - 1) / 2);
+  KATANA_LOG_ASSERT(dist.max_degree() == num_nodes - 1);
+
+  // Node i has degree i, so the top-k nodes are the highest-numbered ones.
+  std::vector<Node> top = dist.TopKByDegree(3);
+  KATANA_LOG_ASSERT(top.size() == 3);
+  KATANA_LOG_ASSERT(top[0] == num_nodes - 1);
+  KATANA_LOG_ASSERT(top[1] == num_nodes - 2);
+  KATANA_LOG_ASSERT(top[2] == num_nodes - 3);
+  KATANA_LOG_ASSERT(dist.TopKByDegree(num_nodes + 7).size() == num_nodes);
+
+  KATANA_LOG_ASSERT(dist.NumNodesWithDegreeAtLeast(0) == num_nodes);
+  KATANA_LOG_ASSERT(dist.NumNodesWithDegreeAtLeast(num_nodes) == 0);
+  KATANA_LOG_ASSERT(
+      dist.NumNodesWithDegreeAtLeast(num_nodes / 2) ==
+      num_nodes - num_nodes / 2);
+}
+
+void
+TestCaching(size_t num_nodes) {
+  auto pg_result = katana::PropertyGraph::Make(MakeSkewedTopology(num_nodes));
+  KATANA_LOG_ASSERT(pg_result);
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_result.value());
+
+  auto first = pg->GetDegreeDistribution();
+  auto second = pg->GetDegreeDistribution();
+  KATANA_LOG_ASSERT(first == second);
+  KATANA_LOG_ASSERT(first->max_degree() == num_nodes - 1);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestQueries(100);
+  TestCaching(100);
+
+  return 0;
+}
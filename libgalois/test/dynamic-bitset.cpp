@@ -0,0 +1,114 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/DynamicBitset.h"
+
+#include <atomic>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/Reduction.h"
+
+namespace {
+
+// a size that does not divide the word size, to exercise the tail word
+constexpr size_t kNumBits = 1000;
+
+katana::DynamicBitset
+MakeBitset(size_t stride) {
+  katana::DynamicBitset bitset;
+  bitset.resize(kNumBits);
+  for (size_t i = 0; i < kNumBits; i += stride) {
+    bitset.set(i);
+  }
+  return bitset;
+}
+
+void
+TestBitwiseOps() {
+  katana::DynamicBitset evens = MakeBitset(2);
+  katana::DynamicBitset thirds = MakeBitset(3);
+
+  katana::DynamicBitset sixths;
+  sixths.resize(kNumBits);
+  sixths.bitwise_and(evens, thirds);
+  for (size_t i = 0; i < kNumBits; ++i) {
+    KATANA_LOG_ASSERT(sixths.test(i) == (i % 6 == 0));
+  }
+
+  // this = evens & ~thirds
+  katana::DynamicBitset diff;
+  diff.resize(kNumBits);
+  diff.bitwise_andnot(evens, thirds);
+  for (size_t i = 0; i < kNumBits; ++i) {
+    KATANA_LOG_ASSERT(diff.test(i) == (i % 2 == 0 && i % 3 != 0));
+  }
+
+  // in-place: evens &= ~thirds
+  evens.bitwise_andnot(thirds);
+  for (size_t i = 0; i < kNumBits; ++i) {
+    KATANA_LOG_ASSERT(evens.test(i) == diff.test(i));
+  }
+}
+
+void
+TestCountAndOffsets() {
+  katana::DynamicBitset sevens = MakeBitset(7);
+  const size_t expected = (kNumBits + 6) / 7;
+
+  KATANA_LOG_ASSERT(sevens.count() == expected);
+
+  std::vector<uint32_t> offsets = sevens.GetOffsets<uint32_t>();
+  KATANA_LOG_ASSERT(offsets.size() == expected);
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    KATANA_LOG_ASSERT(offsets[i] == i * 7);
+  }
+}
+
+void
+TestForEachSetBit() {
+  katana::DynamicBitset fives = MakeBitset(5);
+
+  std::vector<std::atomic<int>> seen(kNumBits);
+  katana::GAccumulator<size_t> visited;
+  fives.for_each_set_bit([&](size_t index) {
+    KATANA_LOG_ASSERT(index < kNumBits);
+    ++seen[index];
+    visited += 1;
+  });
+
+  KATANA_LOG_ASSERT(visited.reduce() == fives.count());
+  for (size_t i = 0; i < kNumBits; ++i) {
+    KATANA_LOG_ASSERT(seen[i] == (i % 5 == 0 ? 1 : 0));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys Katana_runtime;
+  katana::setActiveThreads(4);
+
+  TestBitwiseOps();
+  TestCountAndOffsets();
+  TestForEachSetBit();
+
+  return 0;
+}
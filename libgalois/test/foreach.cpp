@@ -47,6 +47,9 @@ main() {
       katana::loopname("with function object and options"));
   katana::do_all(katana::iterate(v), [&b](int x) { b.push(x); });
   katana::for_each(katana::iterate(b), function_object());
+  katana::for_each(
+      katana::iterate(v), function_object(), katana::flat_termination(),
+      katana::loopname("with flat termination"));
 
   return 0;
 }
@@ -33,6 +33,7 @@ printMyTopo() {
     auto& c = t.threadTopoInfo[i];
     std::cout << "tid: " << c.tid << " leader: " << c.socketLeader
               << " socket: " << c.socket << " numaNode: " << c.numaNode
+              << " core: " << c.core
               << " cumulativeMaxSocket: " << c.cumulativeMaxSocket
               << " osContext: " << c.osContext
               << " osNumaNode: " << c.osNumaNode << "\n";
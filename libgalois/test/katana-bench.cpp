@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/NUMAArray.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+
+// Microbenchmarks for the core runtime primitives that analytics kernels are
+// built from. Loop overhead itself is measured by foreach-bench and typed
+// property access by property-graph-bench; this suite covers the remaining
+// primitives so that `--benchmark_format=json` output from the katana-bench
+// target can be trended across releases.
+
+namespace {
+
+void
+MakeSizeArguments(benchmark::internal::Benchmark* b) {
+  for (long size : {64 * 1024, 1024 * 1024, 16 * 1024 * 1024}) {
+    b->Args({size});
+  }
+}
+
+void
+InsertBagPush(benchmark::State& state) {
+  long size = state.range(0);
+
+  for (auto _ : state) {
+    katana::InsertBag<int64_t> bag;
+    katana::do_all(
+        katana::iterate(int64_t{0}, int64_t{size}),
+        [&](int64_t i) { bag.push(i); }, katana::no_stats());
+    benchmark::DoNotOptimize(bag.begin());
+  }
+
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+DynamicBitsetSet(benchmark::State& state) {
+  long size = state.range(0);
+
+  katana::DynamicBitset bitset;
+  bitset.resize(size);
+
+  for (auto _ : state) {
+    katana::do_all(
+        katana::iterate(int64_t{0}, int64_t{size}),
+        [&](int64_t i) { bitset.set(i); }, katana::no_stats());
+  }
+
+  KATANA_LOG_ASSERT(bitset.count() == static_cast<size_t>(size));
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+DynamicBitsetTest(benchmark::State& state) {
+  long size = state.range(0);
+
+  katana::DynamicBitset bitset;
+  bitset.resize(size);
+  for (long i = 0; i < size; i += 2) {
+    bitset.set(i);
+  }
+
+  for (auto _ : state) {
+    katana::GAccumulator<int64_t> count;
+    katana::do_all(
+        katana::iterate(int64_t{0}, int64_t{size}),
+        [&](int64_t i) {
+          if (bitset.test(i)) {
+            count += 1;
+          }
+        },
+        katana::no_stats());
+    KATANA_LOG_ASSERT(count.reduce() == (size + 1) / 2);
+  }
+
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+DynamicBitsetCount(benchmark::State& state) {
+  long size = state.range(0);
+
+  katana::DynamicBitset bitset;
+  bitset.resize(size);
+  for (long i = 0; i < size; i += 3) {
+    bitset.set(i);
+  }
+
+  for (auto _ : state) {
+    size_t count = bitset.count();
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <void (katana::NUMAArray<int64_t>::*allocate)(size_t)>
+void
+RunNUMAArrayAllocate(benchmark::State& state) {
+  long size = state.range(0);
+
+  for (auto _ : state) {
+    katana::NUMAArray<int64_t> array;
+    (array.*allocate)(size);
+    // touch every page from the loop that would normally consume the array so
+    // that first-touch placement costs are part of the measurement
+    katana::do_all(
+        katana::iterate(int64_t{0}, int64_t{size}),
+        [&](int64_t i) { array[i] = i; }, katana::no_stats());
+    benchmark::DoNotOptimize(array.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+NUMAArrayInterleaved(benchmark::State& state) {
+  RunNUMAArrayAllocate<&katana::NUMAArray<int64_t>::allocateInterleaved>(state);
+}
+
+void
+NUMAArrayBlocked(benchmark::State& state) {
+  RunNUMAArrayAllocate<&katana::NUMAArray<int64_t>::allocateBlocked>(state);
+}
+
+void
+NUMAArrayLocal(benchmark::State& state) {
+  RunNUMAArrayAllocate<&katana::NUMAArray<int64_t>::allocateLocal>(state);
+}
+
+void
+PerThreadStorageAccess(benchmark::State& state) {
+  long size = state.range(0);
+
+  katana::PerThreadStorage<int64_t> counters;
+
+  for (auto _ : state) {
+    katana::do_all(
+        katana::iterate(int64_t{0}, int64_t{size}),
+        [&](int64_t) { *counters.getLocal() += 1; }, katana::no_stats());
+  }
+
+  benchmark::DoNotOptimize(*counters.getLocal());
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+CSRTraversal(benchmark::State& state) {
+  long num_nodes = state.range(0);
+  constexpr size_t kEdgesPerNode = 8;
+
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(num_nodes, kEdgesPerNode);
+
+  for (auto _ : state) {
+    katana::GAccumulator<uint64_t> sum;
+    katana::do_all(
+        katana::iterate(topo.all_nodes()),
+        [&](katana::GraphTopology::Node node) {
+          uint64_t local = 0;
+          for (auto edge : topo.edges(node)) {
+            local += topo.edge_dest(edge);
+          }
+          sum += local;
+        },
+        katana::steal(), katana::no_stats());
+    benchmark::DoNotOptimize(sum.reduce());
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_nodes * kEdgesPerNode);
+}
+
+void
+BuildPropertyGraph(benchmark::State& state) {
+  long num_nodes = state.range(0);
+  constexpr long kNumProperties = 4;
+
+  LinePolicy policy{4};
+
+  // covers table construction plus the AddNodeProperties/AddEdgeProperties
+  // ingest path that a Parquet load funnels into
+  for (auto _ : state) {
+    std::unique_ptr<katana::PropertyGraph> g =
+        MakeFileGraph<int64_t>(num_nodes, kNumProperties, &policy);
+    benchmark::DoNotOptimize(g.get());
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_nodes * kNumProperties);
+}
+
+BENCHMARK(InsertBagPush)->Apply(MakeSizeArguments);
+BENCHMARK(DynamicBitsetSet)->Apply(MakeSizeArguments);
+BENCHMARK(DynamicBitsetTest)->Apply(MakeSizeArguments);
+BENCHMARK(DynamicBitsetCount)->Apply(MakeSizeArguments);
+BENCHMARK(NUMAArrayInterleaved)->Apply(MakeSizeArguments);
+BENCHMARK(NUMAArrayBlocked)->Apply(MakeSizeArguments);
+BENCHMARK(NUMAArrayLocal)->Apply(MakeSizeArguments);
+BENCHMARK(PerThreadStorageAccess)->Apply(MakeSizeArguments);
+BENCHMARK(CSRTraversal)->Args({64 * 1024})->Args({1024 * 1024});
+BENCHMARK(BuildPropertyGraph)->Args({1024})->Args({64 * 1024});
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,85 @@
+#include <arrow/api.h>
+
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+
+using SortedGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
+
+namespace {
+
+/// One int64 column where row i holds offset + i, so a materialized copy
+/// can be checked against the view's property index mapping.
+std::shared_ptr<arrow::Table>
+MakeWeightColumn(const std::string& name, size_t num_rows, int64_t offset) {
+  arrow::Int64Builder builder;
+  for (size_t i = 0; i < num_rows; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(offset + static_cast<int64_t>(i)).ok());
+  }
+  std::shared_ptr<arrow::Array> column;
+  KATANA_LOG_ASSERT(builder.Finish(&column).ok());
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::int64())}), {column});
+}
+
+void
+AssertMatchesColumn(
+    const SortedGraphView& view, const std::shared_ptr<arrow::Array>& array,
+    int64_t offset) {
+  auto values = std::static_pointer_cast<arrow::Int64Array>(array);
+  KATANA_LOG_ASSERT(
+      values->length() == static_cast<int64_t>(view.num_edges()));
+  for (auto e : view.all_edges()) {
+    // entry e of the materialized copy is row edge_property_index(e) of
+    // the source column, whose value is offset + row
+    KATANA_LOG_ASSERT(
+        values->Value(e) ==
+        offset + static_cast<int64_t>(view.edge_property_index(e)));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  constexpr size_t kNumNodes = 100;
+  constexpr size_t kEdgesPerNode = 7;
+
+  katana::GraphTopology topo =
+      katana::CreateUniformRandomTopology(kNumNodes, kEdgesPerNode);
+  auto pg_result = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(pg_result);
+  katana::PropertyGraph* pg = pg_result.value().get();
+
+  const size_t num_edges = pg->num_edges();
+  KATANA_LOG_ASSERT(
+      pg->AddEdgeProperties(MakeWeightColumn("weight", num_edges, 0)));
+
+  SortedGraphView view = pg->BuildView<SortedGraphView>();
+
+  auto first = view.GetMaterializedEdgeProperty("weight");
+  KATANA_LOG_ASSERT(first);
+  AssertMatchesColumn(view, first.value(), 0);
+
+  // a second fetch is a cache hit: the same physical array comes back
+  auto second = view.GetMaterializedEdgeProperty("weight");
+  KATANA_LOG_ASSERT(second);
+  KATANA_LOG_ASSERT(second.value().get() == first.value().get());
+
+  // upserting the column drops the materialized copy; the next fetch
+  // rebuilds it from the new values
+  KATANA_LOG_ASSERT(
+      pg->UpsertEdgeProperties(MakeWeightColumn("weight", num_edges, 1000)));
+  auto after_upsert = view.GetMaterializedEdgeProperty("weight");
+  KATANA_LOG_ASSERT(after_upsert);
+  KATANA_LOG_ASSERT(after_upsert.value().get() != first.value().get());
+  AssertMatchesColumn(view, after_upsert.value(), 1000);
+
+  // removing the column leaves nothing to materialize
+  KATANA_LOG_ASSERT(pg->RemoveEdgeProperty("weight"));
+  KATANA_LOG_ASSERT(!view.GetMaterializedEdgeProperty("weight"));
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/NUMABag.h"
+
+#include <atomic>
+#include <vector>
+
+#include "katana/Galois.h"
+
+int
+main() {
+  katana::SharedMemSys Katana_runtime;
+  katana::setActiveThreads(4);
+
+  constexpr size_t kPerThread = 10000;
+  const unsigned num_threads = katana::getActiveThreads();
+  const size_t total = kPerThread * num_threads;
+
+  katana::NUMABag<size_t> bag;
+
+  // Imbalanced production: thread 0 pushes everything.
+  katana::on_each([&](unsigned tid, unsigned) {
+    if (tid != 0) {
+      return;
+    }
+    for (size_t i = 0; i < total; ++i) {
+      bag.push(i);
+    }
+  });
+
+  // Every item is visited exactly once across all local ranges.
+  std::vector<std::atomic<int>> seen(total);
+  katana::do_all(katana::iterate(bag), [&](size_t item) {
+    KATANA_LOG_ASSERT(item < total);
+    ++seen[item];
+  });
+
+  for (size_t i = 0; i < total; ++i) {
+    KATANA_LOG_VASSERT(seen[i] == 1, "item {} seen {} times", i, seen[i]);
+  }
+
+  // Serial iteration sees the same items, and more pushes after an
+  // iteration are picked up.
+  bag.push(total);
+  size_t count = 0;
+  for (size_t item : bag) {
+    KATANA_LOG_ASSERT(item <= total);
+    ++count;
+  }
+  KATANA_LOG_ASSERT(count == total + 1);
+
+  bag.clear();
+  KATANA_LOG_ASSERT(bag.empty());
+
+  return 0;
+}
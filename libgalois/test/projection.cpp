@@ -76,5 +76,23 @@ main(int argc, char** argv) {
   katana::gPrint("\n Num Nodes: ", graph->num_nodes());
   katana::gPrint("\n Num Edges: ", graph->num_edges());
 
+  // The zero-copy projection must agree with the materialized one.
+  auto lazy_graph =
+      katana::LazyProjectedTopology::MakeTypeProjection(&g, node_types, edge_types);
+
+  KATANA_LOG_ASSERT(lazy_graph->num_nodes() == graph->num_nodes());
+  KATANA_LOG_ASSERT(lazy_graph->num_edges() == graph->num_edges());
+
+  uint64_t num_filtered_edges = 0;
+  for (auto src : lazy_graph->active_nodes()) {
+    KATANA_LOG_ASSERT(lazy_graph->has_node(src));
+    for (auto e : lazy_graph->edges(src)) {
+      KATANA_LOG_ASSERT(lazy_graph->has_edge(e));
+      KATANA_LOG_ASSERT(lazy_graph->has_node(lazy_graph->edge_dest(e)));
+      ++num_filtered_edges;
+    }
+  }
+  KATANA_LOG_ASSERT(num_filtered_edges == lazy_graph->num_edges());
+
   return 0;
 }
@@ -1,7 +1,10 @@
+#include <algorithm>
+
 #include <arrow/api.h>
 #include <boost/filesystem.hpp>
 
 #include "TestTypedPropertyGraph.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/PropertyGraph.h"
 #include "katana/SharedMemSys.h"
@@ -411,6 +414,179 @@ TestSimplePGs() {
   KATANA_LOG_ASSERT(make_result);
 }
 
+void
+TestLazyProperties() {
+  constexpr size_t test_length = 10;
+  using ValueType = int32_t;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+
+  auto add_node_result =
+      g->AddNodeProperties(MakeProps<ValueType>("node-name", test_length));
+  KATANA_LOG_ASSERT(add_node_result);
+
+  auto add_edge_result =
+      g->AddEdgeProperties(MakeProps<ValueType>("edge-name", test_length));
+  KATANA_LOG_ASSERT(add_edge_result);
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  auto write_result = g->Write(rdg_dir, command_line);
+
+  KATANA_LOG_WARN("creating temp file {}", rdg_dir);
+
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  tsuba::RDGLoadOptions opts;
+  opts.lazy_properties = true;
+  katana::Result<std::unique_ptr<katana::PropertyGraph>> make_result =
+      katana::PropertyGraph::Make(rdg_dir, opts);
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+
+  // nothing is loaded up front, but the full schema still knows the columns
+  KATANA_LOG_ASSERT(g2->GetNumNodeProperties() == 0);
+  KATANA_LOG_ASSERT(g2->GetNumEdgeProperties() == 0);
+  KATANA_LOG_ASSERT(g2->full_node_schema()->GetFieldIndex("node-name") != -1);
+  KATANA_LOG_ASSERT(g2->full_edge_schema()->GetFieldIndex("edge-name") != -1);
+
+  // first touch faults the column in
+  auto node_prop_res = g2->GetNodeProperty("node-name");
+  KATANA_LOG_ASSERT(node_prop_res);
+  KATANA_LOG_ASSERT(
+      static_cast<size_t>(node_prop_res.value()->length()) == test_length);
+  KATANA_LOG_ASSERT(g2->GetNumNodeProperties() == 1);
+
+  auto edge_prop_res = g2->GetEdgeProperty("edge-name");
+  KATANA_LOG_ASSERT(edge_prop_res);
+  KATANA_LOG_ASSERT(
+      static_cast<size_t>(edge_prop_res.value()->length()) == test_length);
+  KATANA_LOG_ASSERT(g2->GetNumEdgeProperties() == 1);
+
+  // properties that exist nowhere still report not found
+  KATANA_LOG_ASSERT(!g2->GetNodeProperty("no-such-property"));
+}
+
+void
+TestConsolidateProperties() {
+  constexpr size_t test_length = 10;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+
+  // build a column that arrives in two chunks
+  arrow::Int32Builder builder;
+  std::shared_ptr<arrow::Array> first;
+  std::shared_ptr<arrow::Array> second;
+  for (int i = 0; i < 5; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(i).ok());
+  }
+  KATANA_LOG_ASSERT(builder.Finish(&first).ok());
+  for (int i = 5; i < 10; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(i).ok());
+  }
+  KATANA_LOG_ASSERT(builder.Finish(&second).ok());
+  auto chunked = std::make_shared<arrow::ChunkedArray>(
+      arrow::ArrayVector{first, second});
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("chunked", arrow::int32())}), {chunked});
+
+  KATANA_LOG_ASSERT(g->AddNodeProperties(table));
+  KATANA_LOG_ASSERT(
+      g->GetNodeProperty("chunked").value()->num_chunks() == 2);
+
+  auto consolidate_result = g->ConsolidateNodeProperty("chunked");
+  KATANA_LOG_ASSERT(consolidate_result);
+
+  auto column = g->GetNodeProperty("chunked").value();
+  KATANA_LOG_ASSERT(column->num_chunks() == 1);
+  // same logical values, different chunking
+  KATANA_LOG_ASSERT(column->Equals(*chunked));
+}
+
+void
+TestDictionaryProperty() {
+  constexpr size_t test_length = 10;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+
+  arrow::StringBuilder builder;
+  for (size_t i = 0; i < test_length; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(i % 2 == 0 ? "even" : "odd").ok());
+  }
+  std::shared_ptr<arrow::Array> tags;
+  KATANA_LOG_ASSERT(builder.Finish(&tags).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("tag", arrow::utf8())}), {tags});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(table));
+
+  auto encode_result = g->DictionaryEncodeNodeProperty("tag");
+  KATANA_LOG_ASSERT(encode_result);
+
+  auto column = g->GetNodeProperty("tag").value();
+  KATANA_LOG_ASSERT(column->type()->id() == arrow::Type::DICTIONARY);
+
+  auto view_result = katana::ConstructPropertyView<katana::StringDictProperty>(
+      column->chunk(0).get());
+  KATANA_LOG_ASSERT(view_result);
+  auto view = std::move(view_result.value());
+
+  KATANA_LOG_ASSERT(view.dictionary_size() == 2);
+  int32_t even_code = view.FindCode("even");
+  KATANA_LOG_ASSERT(even_code != view.kInvalidCode);
+  KATANA_LOG_ASSERT(
+      view.FindCode("no-such-tag") ==
+      katana::StringDictPropertyReadOnlyView::kInvalidCode);
+  for (size_t i = 0; i < test_length; ++i) {
+    KATANA_LOG_ASSERT((view.GetCode(i) == even_code) == (i % 2 == 0));
+    KATANA_LOG_ASSERT(view[i] == (i % 2 == 0 ? "even" : "odd"));
+  }
+}
+
+void
+TestCompressedTopology() {
+  constexpr size_t test_length = 10;
+
+  RandomPolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  katana::SetEnv("KATANA_COMPRESS_TOPOLOGY", "1", /*overwrite=*/true);
+  auto write_result = g->Write(rdg_dir, command_line);
+  katana::UnsetEnv("KATANA_COMPRESS_TOPOLOGY");
+
+  KATANA_LOG_WARN("creating temp file {}", rdg_dir);
+
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  katana::Result<std::unique_ptr<katana::PropertyGraph>> make_result =
+      katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  fs::remove_all(rdg_dir);
+  if (!make_result) {
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+  KATANA_LOG_ASSERT(g->Equals(g2.get()));
+}
+
 void
 TestTopologyAccess() {
   RandomPolicy policy{3};
@@ -440,6 +616,54 @@ TestTopologyAccess() {
   }
   KATANA_LOG_ASSERT(n_nodes == 10);
 }
+
+void
+TestNodeTypeIndex() {
+  constexpr size_t test_length = 10;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+
+  std::shared_ptr<arrow::Table> node_props =
+      MakeProps<uint8_t>("node-name", test_length);
+  KATANA_LOG_ASSERT(g->AddNodeProperties(node_props));
+  KATANA_LOG_ASSERT(g->ConstructEntityTypeIDs());
+
+  // ConstructEntityTypeIDs builds the index as a side effect
+  KATANA_LOG_ASSERT(g->HasNodeTypeIndex());
+
+  // the exact-type lists are sorted and partition the nodes
+  size_t total = 0;
+  for (size_t t = 0; t < g->GetNumNodeEntityTypes(); ++t) {
+    const auto& exact =
+        g->GetNodesWithExactType(static_cast<katana::EntityTypeID>(t));
+    KATANA_LOG_ASSERT(std::is_sorted(exact.begin(), exact.end()));
+    total += exact.size();
+  }
+  KATANA_LOG_ASSERT(total == test_length);
+
+  // the index agrees with the per-node predicate
+  katana::EntityTypeID named_type = g->GetNodeEntityTypeID("node-name");
+  katana::PropertyGraph::NodeList typed_nodes =
+      g->GetNodesWithType(named_type);
+  size_t num_matches = 0;
+  for (uint32_t n = 0; n < test_length; ++n) {
+    if (g->DoesNodeHaveType(n, named_type)) {
+      ++num_matches;
+    }
+  }
+  KATANA_LOG_ASSERT(typed_nodes.size() == num_matches);
+  for (auto n : typed_nodes) {
+    KATANA_LOG_ASSERT(g->DoesNodeHaveType(n, named_type));
+  }
+
+  // every node has kUnknownEntityType, so the union covers the graph and
+  // the single-type intersection reproduces the typed list
+  KATANA_LOG_ASSERT(
+      g->GetNodesWithAnyType({katana::kUnknownEntityType, named_type}).size() ==
+      test_length);
+  KATANA_LOG_ASSERT(g->GetNodesWithAllTypes({named_type}) == typed_nodes);
+}
 }  // namespace
 
 int
@@ -457,9 +681,14 @@ main(int argc, char** argv) {
   TestRoundTrip();
   TestGarbageMetadata();
   TestSimplePGs();
+  TestLazyProperties();
+  TestConsolidateProperties();
+  TestDictionaryProperty();
+  TestCompressedTopology();
   TestTopologyAccess();
   TestTypesFromPropertiesCompareTypesFromStorage();
   TestCompositeTypesFromPropertiesCompareCompositeTypesFromStorage();
+  TestNodeTypeIndex();
 
   return 0;
 }
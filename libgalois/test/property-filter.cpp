@@ -0,0 +1,148 @@
+#include <cmath>
+#include <limits>
+
+#include <arrow/api.h>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyFilter.h"
+
+namespace {
+
+template <typename c_type>
+std::shared_ptr<arrow::Table>
+CreateProperty(const std::string& name, size_t num_rows, bool with_nulls) {
+  using BuilderType = typename arrow::CTypeTraits<c_type>::BuilderType;
+  using ArrowType = typename arrow::CTypeTraits<c_type>::ArrowType;
+
+  BuilderType builder;
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (with_nulls && i % 3 == 0) {
+      KATANA_LOG_ASSERT(builder.AppendNull().ok());
+    } else {
+      KATANA_LOG_ASSERT(builder.Append(static_cast<c_type>(i)).ok());
+    }
+  }
+  std::vector<std::shared_ptr<arrow::Array>> chunks(1);
+  KATANA_LOG_ASSERT(builder.Finish(&chunks[0]).ok());
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, std::make_shared<ArrowType>())}),
+      {std::make_shared<arrow::ChunkedArray>(chunks)});
+}
+
+katana::DynamicBitset
+Evaluate(
+    katana::PropertyGraph* g,
+    const std::vector<katana::PropertyPredicate>& predicates) {
+  auto result = katana::EvaluateNodePredicates(g, predicates);
+  KATANA_LOG_VASSERT(result, "evaluation failed: {}", result.error());
+  return std::move(result.value());
+}
+
+// Value at row i is i; rows divisible by three in the "nullable" column are
+// null. The expected lambda gives the reference decision per row.
+template <typename Expected>
+void
+CheckSelection(
+    const katana::DynamicBitset& selected, size_t num_rows,
+    Expected expected) {
+  KATANA_LOG_ASSERT(selected.size() == num_rows);
+  for (size_t i = 0; i < num_rows; ++i) {
+    KATANA_LOG_VASSERT(
+        selected.test(i) == expected(i), "row {} selected = {}", i,
+        selected.test(i));
+  }
+}
+
+void
+TestIntegerPredicates(size_t num_nodes, size_t line_width) {
+  using katana::PredicateOp;
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy);
+  size_t num_rows = g->num_nodes();
+
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(CreateProperty<int64_t>("value", num_rows, false)));
+  KATANA_LOG_ASSERT(g->AddNodeProperties(
+      CreateProperty<int64_t>("nullable", num_rows, true)));
+
+  // Strict less-than against a non-integral constant folds to x <= 4.
+  auto selected =
+      Evaluate(g.get(), {{"value", PredicateOp::kLessThan, 4.5}});
+  CheckSelection(selected, num_rows, [](size_t i) { return i <= 4; });
+
+  selected = Evaluate(g.get(), {{"value", PredicateOp::kGreaterThan, 3.0}});
+  CheckSelection(selected, num_rows, [](size_t i) { return i > 3; });
+
+  selected = Evaluate(g.get(), {{"value", PredicateOp::kEqual, 6.0}});
+  CheckSelection(selected, num_rows, [](size_t i) { return i == 6; });
+
+  // A non-integral constant can never equal an integer row.
+  selected = Evaluate(g.get(), {{"value", PredicateOp::kEqual, 6.5}});
+  CheckSelection(selected, num_rows, [](size_t) { return false; });
+  selected = Evaluate(g.get(), {{"value", PredicateOp::kNotEqual, 6.5}});
+  CheckSelection(selected, num_rows, [](size_t) { return true; });
+
+  // A NaN constant satisfies no ordered comparison.
+  selected = Evaluate(
+      g.get(),
+      {{"value", PredicateOp::kLessThan, std::nan("")}});
+  CheckSelection(selected, num_rows, [](size_t) { return false; });
+
+  // Nulls never match, even under a predicate every value satisfies.
+  selected = Evaluate(g.get(), {{"nullable", PredicateOp::kGreaterEqual, 0.0}});
+  CheckSelection(selected, num_rows, [](size_t i) { return i % 3 != 0; });
+
+  // Conjunction across columns: 2 <= value <= 7 and nullable non-null.
+  selected = Evaluate(
+      g.get(), {
+                   {"value", PredicateOp::kGreaterEqual, 2.0},
+                   {"value", PredicateOp::kLessEqual, 7.0},
+                   {"nullable", PredicateOp::kNotEqual, -1.0},
+               });
+  CheckSelection(selected, num_rows, [](size_t i) {
+    return i >= 2 && i <= 7 && i % 3 != 0;
+  });
+
+  // The empty conjunction selects every node.
+  selected = Evaluate(g.get(), {});
+  CheckSelection(selected, num_rows, [](size_t) { return true; });
+
+  // Unknown properties are an error, not an empty selection.
+  auto missing = katana::EvaluateNodePredicates(
+      g.get(), {{"no-such-property", PredicateOp::kEqual, 0.0}});
+  KATANA_LOG_ASSERT(!missing);
+}
+
+void
+TestFloatingPredicates(size_t num_nodes, size_t line_width) {
+  using katana::PredicateOp;
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy);
+  size_t num_rows = g->num_nodes();
+
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(CreateProperty<double>("value", num_rows, false)));
+
+  auto selected = Evaluate(g.get(), {{"value", PredicateOp::kLessThan, 4.5}});
+  CheckSelection(selected, num_rows, [](size_t i) { return i < 4.5; });
+
+  selected = Evaluate(g.get(), {{"value", PredicateOp::kEqual, 6.0}});
+  CheckSelection(selected, num_rows, [](size_t i) { return i == 6; });
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestIntegerPredicates(100, 3);
+  TestFloatingPredicates(100, 3);
+
+  return 0;
+}
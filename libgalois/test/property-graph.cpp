@@ -1,3 +1,5 @@
+#include <unistd.h>
+
 #include <arrow/api.h>
 #include <arrow/type.h>
 #include <arrow/type_traits.h>
@@ -5,6 +7,8 @@
 #include "TestTypedPropertyGraph.h"
 #include "katana/Logging.h"
 #include "katana/Properties.h"
+#include "katana/PropertyViews.h"
+#include "katana/SharedMemoryRegion.h"
 
 using DataType = int64_t;
 
@@ -126,6 +130,107 @@ TestError1(size_t num_nodes, size_t line_width) {
       "Should return PropertyNotFound when node property doesn't exist.");
 }
 
+/// Test that repeat typed view creation is served from the cache and that
+/// property mutation invalidates it
+void
+TestViewCache(size_t num_nodes, size_t line_width) {
+  using NodeType = std::tuple<Field0>;
+  using EdgeType = std::tuple<Field0>;
+
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  std::string key =
+      katana::internal::PropertyViewCacheKey<NodeType>("node", {"0"});
+  KATANA_LOG_ASSERT(g->FindPropertyViewCacheEntry(key) == nullptr);
+
+  auto r1 = katana::TypedPropertyGraph<NodeType, EdgeType>::Make(g.get());
+  KATANA_LOG_ASSERT(r1);
+  KATANA_LOG_ASSERT(g->FindPropertyViewCacheEntry(key) != nullptr);
+
+  // a second Make must produce a working graph from the cached views
+  auto r2 = katana::TypedPropertyGraph<NodeType, EdgeType>::Make(g.get());
+  KATANA_LOG_ASSERT(r2);
+
+  size_t r_iterate = Iterate(r2.value(), 1);
+  size_t expected = ExpectedValue(
+      g->topology().num_nodes(), g->topology().num_edges(), 1, false);
+  KATANA_LOG_VASSERT(expected == r_iterate, "{} != {}", expected, r_iterate);
+
+  // mutating any property table drops every cached view
+  auto removed = g->RemoveEdgeProperty(0);
+  KATANA_LOG_ASSERT(removed);
+  KATANA_LOG_ASSERT(g->FindPropertyViewCacheEntry(key) == nullptr);
+}
+
+/// Test that the flat span accessor sees and writes the same data as GetData
+void
+TestDataSpan(size_t num_nodes, size_t line_width) {
+  using NodeType = std::tuple<Field0>;
+  using EdgeType = std::tuple<Field0>;
+
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 1, &policy);
+
+  auto r = katana::TypedPropertyGraph<NodeType, EdgeType>::Make(g.get());
+  KATANA_LOG_ASSERT(r);
+  auto graph = r.value();
+
+  auto span = graph.GetDataSpan<Field0>();
+  KATANA_LOG_ASSERT(span.size() == graph.num_nodes());
+  for (size_t i = 0; i < span.size(); ++i) {
+    KATANA_LOG_ASSERT(span[i] == graph.GetData<Field0>(i));
+  }
+
+  span[0] = 123;
+  KATANA_LOG_ASSERT(graph.GetData<Field0>(0) == 123);
+
+  auto edge_span = graph.GetEdgeDataSpan<Field0>();
+  KATANA_LOG_ASSERT(edge_span.size() == graph.num_edges());
+}
+
+/// Test that a graph exported to a shared-memory segment round-trips:
+/// the imported graph aliases the segment but sees the same topology and
+/// property data
+void
+TestSharedMemory(size_t num_nodes, size_t line_width) {
+  LinePolicy policy{line_width};
+
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<DataType>(num_nodes, 2, &policy);
+
+  const std::string name =
+      "/katana-property-graph-test-" + std::to_string(getpid());
+  auto exported = g->ExportToSharedMemory(name);
+  KATANA_LOG_VASSERT(exported, "export failed: {}", exported.error());
+
+  auto imported_res = katana::PropertyGraph::MakeFromSharedMemory(name);
+  KATANA_LOG_VASSERT(
+      imported_res, "import failed: {}", imported_res.error());
+  std::unique_ptr<katana::PropertyGraph> imported =
+      std::move(imported_res.value());
+
+  KATANA_LOG_ASSERT(imported->topology().Equals(g->topology()));
+  KATANA_LOG_ASSERT(
+      imported->GetNumNodeProperties() == g->GetNumNodeProperties());
+  for (int32_t i = 0; i < g->GetNumNodeProperties(); ++i) {
+    KATANA_LOG_ASSERT(
+        imported->GetNodeProperty(i)->Equals(*g->GetNodeProperty(i)));
+  }
+  for (int32_t i = 0; i < g->GetNumEdgeProperties(); ++i) {
+    KATANA_LOG_ASSERT(
+        imported->GetEdgeProperty(i)->Equals(*g->GetEdgeProperty(i)));
+  }
+
+  // unlinking removes the name; the existing mapping stays valid
+  KATANA_LOG_ASSERT(katana::SharedMemoryRegion::Unlink(name));
+  KATANA_LOG_ASSERT(imported->topology().num_nodes() == num_nodes);
+}
+
 int
 main() {
   katana::SharedMemSys S;
@@ -134,6 +239,9 @@ main() {
   TestIterate3(10, 3);
   TestIterate4(10, 3);
   TestError1(10, 3);
+  TestViewCache(10, 3);
+  TestDataSpan(10, 3);
+  TestSharedMemory(10, 3);
 
   return 0;
 }
@@ -87,6 +87,25 @@ test_accum() {
   KATANA_LOG_ASSERT(accum.reduce() == num);
 }
 
+void
+test_tree() {
+  katana::GAccumulator<double> accum;
+
+  constexpr int num = 123456;
+
+  katana::do_all(
+      katana::iterate(0, num), [&](int i) { accum += 1.0 / (i + 1); });
+
+  const double first = accum.reduceTree();
+  accum.reset();
+
+  katana::do_all(
+      katana::iterate(0, num), [&](int i) { accum += 1.0 / (i + 1); });
+
+  // bit-identical across runs at a fixed thread count
+  KATANA_LOG_ASSERT(accum.reduceTree() == first);
+}
+
 int
 main() {
   katana::SharedMemSys sys;
@@ -100,6 +119,7 @@ main() {
   test_move();
   test_max();
   test_accum();
+  test_tree();
 
   return 0;
 }
@@ -0,0 +1,68 @@
+#include "katana/SortedIntersection.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "katana/Logging.h"
+
+namespace {
+
+size_t
+ReferenceCount(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+  std::vector<uint32_t> out;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+  return out.size();
+}
+
+std::vector<uint32_t>
+RandomSortedList(std::mt19937& gen, size_t len, uint32_t universe) {
+  std::uniform_int_distribution<uint32_t> dist(0, universe);
+  std::set<uint32_t> vals;
+  while (vals.size() < len) {
+    vals.insert(dist(gen));
+  }
+  return std::vector<uint32_t>(vals.begin(), vals.end());
+}
+
+void
+Check(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+  size_t expected = ReferenceCount(a, b);
+  size_t actual =
+      katana::SortedIntersectionCount(a.data(), a.size(), b.data(), b.size());
+  KATANA_LOG_VASSERT(
+      actual == expected, "expected intersection {} but got {}", expected,
+      actual);
+}
+
+}  // namespace
+
+int
+main() {
+  std::mt19937 gen(29);
+
+  Check({}, {});
+  Check({1, 2, 3}, {});
+  Check({1, 2, 3}, {1, 2, 3});
+  Check({1, 3, 5, 7}, {2, 4, 6, 8});
+
+  // Balanced lists of sizes around the vector lane width, including tails.
+  for (size_t len_a : {1, 7, 8, 9, 15, 16, 17, 100, 1000}) {
+    for (size_t len_b : {1, 8, 16, 33, 1000}) {
+      Check(
+          RandomSortedList(gen, len_a, 4 * len_a),
+          RandomSortedList(gen, len_b, 4 * len_b));
+    }
+  }
+
+  // Highly skewed sizes to exercise the galloping path.
+  for (size_t len : {1, 10, 100}) {
+    Check(
+        RandomSortedList(gen, len, 100000),
+        RandomSortedList(gen, 50000, 100000));
+  }
+
+  return 0;
+}
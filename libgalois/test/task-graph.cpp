@@ -0,0 +1,108 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/TaskGraph.h"
+
+#include <atomic>
+#include <vector>
+
+#include "katana/Galois.h"
+
+void
+testDiamond() {
+  std::atomic<int> a_done{0};
+  std::atomic<int> b_done{0};
+  std::atomic<int> join_count{0};
+
+  katana::TaskGraph graph;
+  auto a = graph.AddTask([&] { a_done = 1; });
+  auto b = graph.AddTask([&] { b_done = 1; });
+  graph.AddTask(
+      [&] {
+        KATANA_LOG_ASSERT(a_done == 1);
+        KATANA_LOG_ASSERT(b_done == 1);
+        ++join_count;
+      },
+      {a, b});
+  graph.Run();
+
+  KATANA_LOG_ASSERT(join_count == 1);
+}
+
+void
+testChainFanOut() {
+  constexpr int kWidth = 64;
+  std::atomic<int> stage{0};
+  std::atomic<int> leaves{0};
+
+  katana::TaskGraph graph;
+  auto root = graph.AddTask([&] { stage = 1; });
+  std::vector<katana::TaskGraph::TaskHandle> mids;
+  for (int i = 0; i < kWidth; ++i) {
+    mids.push_back(graph.AddTask(
+        [&] {
+          KATANA_LOG_ASSERT(stage == 1);
+          ++leaves;
+        },
+        {root}));
+  }
+  graph.AddTask([&] { KATANA_LOG_ASSERT(leaves == kWidth); }, mids);
+  graph.Run();
+}
+
+void
+testContinuation() {
+  std::atomic<int> total{0};
+
+  katana::TaskGraph graph;
+  graph.AddTask([&] {
+    ++total;
+    // Tasks added while the graph runs are executed before Run() returns.
+    graph.AddTask([&] { ++total; });
+  });
+  graph.Run();
+
+  KATANA_LOG_ASSERT(total == 2);
+}
+
+void
+testReuse() {
+  std::atomic<int> runs{0};
+
+  katana::TaskGraph graph;
+  graph.AddTask([&] { ++runs; });
+  graph.Run();
+  graph.AddTask([&] { ++runs; });
+  graph.Run();
+
+  KATANA_LOG_ASSERT(runs == 2);
+}
+
+int
+main() {
+  katana::SharedMemSys Katana_runtime;
+  katana::setActiveThreads(4);
+
+  testDiamond();
+  testChainFanOut();
+  testContinuation();
+  testReuse();
+
+  return 0;
+}
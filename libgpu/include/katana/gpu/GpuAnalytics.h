@@ -0,0 +1,82 @@
+#ifndef KATANA_LIBGPU_KATANA_GPU_GPUANALYTICS_H_
+#define KATANA_LIBGPU_KATANA_GPU_GPUANALYTICS_H_
+
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/analytics/bfs/bfs.h"
+#include "katana/analytics/connected_components/connected_components.h"
+#include "katana/analytics/pagerank/pagerank.h"
+#include "katana/config.h"
+
+namespace katana::gpu {
+
+/// True when this library was built with CUDA support and at least one
+/// usable CUDA device is present. The Bfs/Pagerank/ConnectedComponents
+/// entry points below fall back to the CPU engines when this is false, so
+/// callers only need to query it to report which engine ran.
+KATANA_EXPORT bool GpuAvailable();
+
+/// Compute BFS parents of nodes in pg starting from start_node on a CUDA
+/// device, storing the result in a property named output_property_name
+/// with the same type and encoding as katana::analytics::Bfs, so
+/// BfsStatistics::Compute and BfsAssertValid apply unchanged.
+///
+/// The graph's CSR topology is copied to device memory and traversed with
+/// a level-synchronous kernel; only the parent array comes back. When the
+/// library was built without CUDA or no device is present, the call runs
+/// katana::analytics::Bfs with fallback_plan instead.
+KATANA_EXPORT Result<void> Bfs(
+    PropertyGraph* pg, uint32_t start_node,
+    const std::string& output_property_name,
+    analytics::BfsPlan fallback_plan = {});
+
+/// Compute BFS parents with hybrid direction-optimizing execution: sparse
+/// top-down (push) rounds run on the CPU over a frontier list, dense
+/// bottom-up (pull) rounds on the GPU over a frontier bitset. Placement is
+/// decided per round from frontier density with the plan's alpha/beta
+/// thresholds, the same heuristic the CPU SynchronousDirectOpt engine uses
+/// to pick its direction: switch to the GPU when the frontier's outgoing
+/// edges exceed num_edges / alpha, back to the CPU when the frontier
+/// shrinks below num_nodes / beta. The frontier crosses the PCIe bus as a
+/// bitset held in pinned memory; parent arrays are synced only at
+/// placement switches.
+///
+/// Like the CPU engine's bottom-up rounds, the pull rounds assume a
+/// symmetric graph. The output property matches katana::analytics::Bfs.
+/// Without CUDA support or a device, the call runs katana::analytics::Bfs
+/// with the same plan.
+KATANA_EXPORT Result<void> HybridBfs(
+    PropertyGraph* pg, uint32_t start_node,
+    const std::string& output_property_name, analytics::BfsPlan plan = {});
+
+/// Compute the Page Rank of each node of pg on a CUDA device, storing the
+/// result in a property named output_property_name compatible with
+/// PagerankStatistics::Compute.
+///
+/// The device engine runs synchronous push rounds over a device-resident
+/// CSR until the cumulative rank change drops below plan.tolerance() or
+/// plan.max_iterations() rounds have run; alpha is also taken from the
+/// plan. Without CUDA support or a device, the call runs
+/// katana::analytics::Pagerank with the same plan.
+KATANA_EXPORT Result<void> Pagerank(
+    PropertyGraph* pg, const std::string& output_property_name,
+    analytics::PagerankPlan plan = {});
+
+/// Compute the connected components of pg on a CUDA device, storing each
+/// node's component label in a property named output_property_name with
+/// the same encoding as katana::analytics::ConnectedComponents. As with
+/// the CPU engines, pg is expected to be symmetric.
+///
+/// The device engine is label propagation to a fixed point; labels are
+/// minimum node IDs, as the CPU algorithms produce. Without CUDA support
+/// or a device, the call runs katana::analytics::ConnectedComponents with
+/// fallback_plan.
+KATANA_EXPORT Result<void> ConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    analytics::ConnectedComponentsPlan fallback_plan = {});
+
+}  // namespace katana::gpu
+
+#endif
@@ -0,0 +1,291 @@
+#include "katana/gpu/GpuAnalytics.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "GpuEngines.h"
+#include "katana/Bag.h"
+#include "katana/ErrorCode.h"
+#include "katana/Loops.h"
+#include "katana/NUMAArray.h"
+#include "katana/Properties.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+#include "katana/gpu/PinnedHostAllocator.h"
+
+namespace {
+
+using katana::gpu::internal::BfsOnDevice;
+using katana::gpu::internal::ConnectedComponentsOnDevice;
+using katana::gpu::internal::PagerankOnDevice;
+
+// The output properties use the same types as the CPU engines so the
+// analytics statistics and validation code apply to either result.
+using BfsNodeParent = katana::PODProperty<uint32_t>;
+using PagerankNodeRank = katana::PODProperty<float>;
+using ComponentsNodeLabel = katana::PODProperty<uint64_t>;
+
+/// Create the output property output_property_name and copy values into it.
+template <typename NodeProp, typename T>
+katana::Result<void>
+WriteNodeProperty(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    const katana::NUMAArray<T>& values) {
+  KATANA_CHECKED(katana::analytics::ConstructNodeProperties<
+                 std::tuple<NodeProp>>(pg, {output_property_name}));
+  using Graph = katana::TypedPropertyGraph<std::tuple<NodeProp>, std::tuple<>>;
+  Graph graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+  katana::do_all(katana::iterate(graph), [&](uint32_t n) {
+    graph.template GetData<NodeProp>(n) = values[n];
+  });
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+bool
+katana::gpu::GpuAvailable() {
+#ifdef KATANA_USE_GPU
+  return internal::DeviceAvailable();
+#else
+  return false;
+#endif
+}
+
+katana::Result<void>
+katana::gpu::Bfs(
+    PropertyGraph* pg, uint32_t start_node,
+    const std::string& output_property_name, analytics::BfsPlan fallback_plan) {
+  if (!GpuAvailable()) {
+    return analytics::Bfs(pg, start_node, output_property_name, fallback_plan);
+  }
+  if (start_node >= pg->num_nodes()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "start node {} is not in the graph",
+        start_node);
+  }
+
+  const GraphTopology& topology = pg->topology();
+  NUMAArray<uint32_t> parents;
+  parents.allocateInterleaved(topology.num_nodes());
+#ifdef KATANA_USE_GPU
+  std::string error;
+  if (!BfsOnDevice(
+          topology.adj_data(), topology.dest_data(), topology.num_nodes(),
+          topology.num_edges(), start_node, parents.data(), &error)) {
+    return KATANA_ERROR(ErrorCode::AssertionFailed, "device BFS: {}", error);
+  }
+#endif
+  return WriteNodeProperty<BfsNodeParent>(pg, output_property_name, parents);
+}
+
+katana::Result<void>
+katana::gpu::HybridBfs(
+    PropertyGraph* pg, uint32_t start_node,
+    const std::string& output_property_name, analytics::BfsPlan plan) {
+  if (!GpuAvailable()) {
+    return analytics::Bfs(pg, start_node, output_property_name, plan);
+  }
+  if (start_node >= pg->num_nodes()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "start node {} is not in the graph",
+        start_node);
+  }
+
+  const GraphTopology& topology = pg->topology();
+  const uint64_t num_nodes = topology.num_nodes();
+  const uint64_t num_edges = topology.num_edges();
+  constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+  // Plans built by factories other than SynchronousDirectOpt leave the
+  // direction thresholds at zero.
+  const uint32_t alpha =
+      plan.alpha() > 0 ? plan.alpha() : analytics::BfsPlan::kDefaultAlpha;
+  const uint32_t beta =
+      plan.beta() > 0 ? plan.beta() : analytics::BfsPlan::kDefaultBeta;
+
+  NUMAArray<std::atomic<uint32_t>> parents;
+  parents.allocateInterleaved(num_nodes);
+  do_all(iterate(uint64_t{0}, num_nodes), [&](uint64_t n) {
+    parents[n].store(kUnvisited, std::memory_order_relaxed);
+  });
+  parents[start_node].store(start_node, std::memory_order_relaxed);
+
+#ifdef KATANA_USE_GPU
+  internal::HybridBfsState* raw_state = nullptr;
+  std::string error;
+  if (!internal::HybridBfsCreate(
+          topology.adj_data(), topology.dest_data(), num_nodes, num_edges,
+          &raw_state, &error)) {
+    return KATANA_ERROR(
+        ErrorCode::AssertionFailed, "device BFS state: {}", error);
+  }
+  std::unique_ptr<
+      internal::HybridBfsState, decltype(&internal::HybridBfsDestroy)>
+      state(raw_state, &internal::HybridBfsDestroy);
+
+  // Frontier bitsets cross the bus every GPU round; pinned memory keeps
+  // those copies at full PCIe bandwidth.
+  const uint64_t num_words = (num_nodes + 63) / 64;
+  HostAllocator<uint64_t> pinned_alloc(GetPinnedHostHeap());
+  auto free_bits = [&](uint64_t* bits) { pinned_alloc.Free(bits); };
+  std::unique_ptr<uint64_t, decltype(free_bits)> front_bits(
+      pinned_alloc.Calloc(num_words), free_bits);
+  std::unique_ptr<uint64_t, decltype(free_bits)> next_bits(
+      pinned_alloc.Calloc(num_words), free_bits);
+  if (!front_bits || !next_bits) {
+    return KATANA_ERROR(
+        ErrorCode::AssertionFailed, "cannot allocate frontier bitsets");
+  }
+
+  // std::atomic<uint32_t> has the same representation as uint32_t, so the
+  // parent array is exchanged with the device without a conversion pass.
+  uint32_t* plain_parents = reinterpret_cast<uint32_t*>(parents.data());
+
+  std::vector<uint32_t> frontier{start_node};
+  uint64_t frontier_size = 1;
+  uint64_t scout_count = topology.degree(start_node);
+  bool on_gpu = false;
+
+  while (frontier_size > 0) {
+    if (!on_gpu && scout_count > num_edges / alpha) {
+      // Dense enough for pull: move to the GPU. Publish the parent array
+      // and encode the frontier list as a bitset.
+      if (!internal::HybridBfsUploadParents(
+              state.get(), plain_parents, &error)) {
+        return KATANA_ERROR(
+            ErrorCode::AssertionFailed, "uploading parents: {}", error);
+      }
+      memset(front_bits.get(), 0, num_words * sizeof(uint64_t));
+      auto* words =
+          reinterpret_cast<std::atomic<uint64_t>*>(front_bits.get());
+      do_all(iterate(frontier), [&](uint32_t n) {
+        words[n / 64].fetch_or(
+            uint64_t{1} << (n % 64), std::memory_order_relaxed);
+      });
+      on_gpu = true;
+    } else if (on_gpu && frontier_size < num_nodes / beta) {
+      // Sparse again: come back to the CPU. Recover the parent array and
+      // expand the frontier bitset into a list.
+      if (!internal::HybridBfsDownloadParents(
+              state.get(), plain_parents, &error)) {
+        return KATANA_ERROR(
+            ErrorCode::AssertionFailed, "downloading parents: {}", error);
+      }
+      InsertBag<uint32_t> expanded;
+      GAccumulator<uint64_t> scout;
+      do_all(iterate(uint64_t{0}, num_words), [&](uint64_t w) {
+        for (uint64_t bits = front_bits.get()[w]; bits != 0;
+             bits &= bits - 1) {
+          uint32_t n = w * 64 + __builtin_ctzll(bits);
+          expanded.push(n);
+          scout += topology.degree(n);
+        }
+      });
+      frontier.assign(expanded.begin(), expanded.end());
+      scout_count = scout.reduce();
+      on_gpu = false;
+    }
+
+    if (on_gpu) {
+      uint64_t next_size = 0;
+      if (!internal::HybridBfsBottomUpRound(
+              state.get(), front_bits.get(), next_bits.get(), num_words,
+              &next_size, &error)) {
+        return KATANA_ERROR(
+            ErrorCode::AssertionFailed, "device BFS round: {}", error);
+      }
+      std::swap(front_bits, next_bits);
+      frontier_size = next_size;
+    } else {
+      InsertBag<uint32_t> next;
+      GAccumulator<uint64_t> next_size;
+      GAccumulator<uint64_t> next_scout;
+      do_all(
+          iterate(frontier),
+          [&](uint32_t n) {
+            for (auto e : topology.edges(n)) {
+              uint32_t dest = topology.edge_dest(e);
+              uint32_t expected = kUnvisited;
+              if (parents[dest].compare_exchange_strong(
+                      expected, n, std::memory_order_relaxed)) {
+                next.push(dest);
+                next_size += 1;
+                next_scout += topology.degree(dest);
+              }
+            }
+          },
+          steal());
+      frontier.assign(next.begin(), next.end());
+      frontier_size = next_size.reduce();
+      scout_count = next_scout.reduce();
+    }
+  }
+
+  if (on_gpu) {
+    if (!internal::HybridBfsDownloadParents(
+            state.get(), plain_parents, &error)) {
+      return KATANA_ERROR(
+          ErrorCode::AssertionFailed, "downloading parents: {}", error);
+    }
+  }
+#endif
+  return WriteNodeProperty<BfsNodeParent>(pg, output_property_name, parents);
+}
+
+katana::Result<void>
+katana::gpu::Pagerank(
+    PropertyGraph* pg, const std::string& output_property_name,
+    analytics::PagerankPlan plan) {
+  if (!GpuAvailable()) {
+    return analytics::Pagerank(pg, output_property_name, plan);
+  }
+
+  const GraphTopology& topology = pg->topology();
+  NUMAArray<float> ranks;
+  ranks.allocateInterleaved(topology.num_nodes());
+#ifdef KATANA_USE_GPU
+  // The push-asynchronous plans leave max_iterations at 0 because the CPU
+  // engine runs to quiescence; the round-based device engine needs a cap.
+  uint32_t max_rounds = plan.max_iterations() > 0
+                            ? plan.max_iterations()
+                            : analytics::PagerankPlan::kDefaultMaxIterations;
+  std::string error;
+  if (!PagerankOnDevice(
+          topology.adj_data(), topology.dest_data(), topology.num_nodes(),
+          topology.num_edges(), plan.alpha(), plan.tolerance(), max_rounds,
+          ranks.data(), &error)) {
+    return KATANA_ERROR(
+        ErrorCode::AssertionFailed, "device Page Rank: {}", error);
+  }
+#endif
+  return WriteNodeProperty<PagerankNodeRank>(pg, output_property_name, ranks);
+}
+
+katana::Result<void>
+katana::gpu::ConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    analytics::ConnectedComponentsPlan fallback_plan) {
+  if (!GpuAvailable()) {
+    return analytics::ConnectedComponents(
+        pg, output_property_name, fallback_plan);
+  }
+
+  const GraphTopology& topology = pg->topology();
+  NUMAArray<uint64_t> components;
+  components.allocateInterleaved(topology.num_nodes());
+#ifdef KATANA_USE_GPU
+  std::string error;
+  if (!ConnectedComponentsOnDevice(
+          topology.adj_data(), topology.dest_data(), topology.num_nodes(),
+          topology.num_edges(), components.data(), &error)) {
+    return KATANA_ERROR(
+        ErrorCode::AssertionFailed, "device connected components: {}", error);
+  }
+#endif
+  return WriteNodeProperty<ComponentsNodeLabel>(
+      pg, output_property_name, components);
+}
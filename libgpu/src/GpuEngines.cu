@@ -0,0 +1,446 @@
+#include "GpuEngines.h"
+
+#include <cuda_runtime.h>
+
+#include <limits>
+#include <memory>
+
+namespace {
+
+constexpr int kBlockSize = 256;
+constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+
+/// Record the CUDA error behind a failed call in *error and signal failure
+/// to the caller. Used at every runtime API call site; kernels are checked
+/// through the cudaDeviceSynchronize that follows them.
+#define CHECK_CUDA(expr)                                                       \
+  do {                                                                         \
+    cudaError_t check_cuda_rc = (expr);                                        \
+    if (check_cuda_rc != cudaSuccess) {                                        \
+      *error = std::string(#expr) + ": " + cudaGetErrorString(check_cuda_rc);  \
+      return false;                                                            \
+    }                                                                          \
+  } while (0)
+
+/// Device copy of a host array, freed on scope exit.
+template <typename T>
+class DeviceArray {
+public:
+  ~DeviceArray() {
+    if (data_ != nullptr) {
+      cudaFree(data_);
+    }
+  }
+
+  bool Allocate(uint64_t count, std::string* error) {
+    CHECK_CUDA(cudaMalloc(&data_, count * sizeof(T)));
+    return true;
+  }
+
+  bool CopyIn(const T* host, uint64_t count, std::string* error) {
+    CHECK_CUDA(
+        cudaMemcpy(data_, host, count * sizeof(T), cudaMemcpyHostToDevice));
+    return true;
+  }
+
+  bool CopyOut(T* host, uint64_t count, std::string* error) const {
+    CHECK_CUDA(
+        cudaMemcpy(host, data_, count * sizeof(T), cudaMemcpyDeviceToHost));
+    return true;
+  }
+
+  T* get() const { return data_; }
+
+private:
+  T* data_{nullptr};
+};
+
+inline int
+NumBlocks(uint64_t work_items) {
+  return static_cast<int>((work_items + kBlockSize - 1) / kBlockSize);
+}
+
+/// Edge range of node n in a GraphTopology CSR: adj_indices holds
+/// exclusive prefix ends, so the range is [adj_indices[n - 1],
+/// adj_indices[n]) with an implicit leading zero.
+__device__ inline uint64_t
+EdgeBegin(const uint64_t* adj_indices, uint32_t n) {
+  return n == 0 ? 0 : adj_indices[n - 1];
+}
+
+template <typename T>
+__global__ void
+FillKernel(T* data, uint64_t count, T value) {
+  uint64_t i = blockIdx.x * uint64_t{blockDim.x} + threadIdx.x;
+  if (i < count) {
+    data[i] = value;
+  }
+}
+
+__global__ void
+BfsLevelKernel(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint32_t* levels, uint32_t* parents, uint32_t current_level,
+    int* changed) {
+  uint32_t n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n >= num_nodes || levels[n] != current_level) {
+    return;
+  }
+  for (uint64_t e = EdgeBegin(adj_indices, n); e < adj_indices[n]; ++e) {
+    uint32_t dest = dests[e];
+    if (atomicCAS(&levels[dest], kUnvisited, current_level + 1) ==
+        kUnvisited) {
+      parents[dest] = n;
+      *changed = 1;
+    }
+  }
+}
+
+__global__ void
+PagerankScatterKernel(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    const float* ranks, float* next_ranks) {
+  uint32_t n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n >= num_nodes) {
+    return;
+  }
+  uint64_t begin = EdgeBegin(adj_indices, n);
+  uint64_t degree = adj_indices[n] - begin;
+  if (degree == 0) {
+    return;
+  }
+  float contribution = ranks[n] / degree;
+  for (uint64_t e = begin; e < adj_indices[n]; ++e) {
+    atomicAdd(&next_ranks[dests[e]], contribution);
+  }
+}
+
+__global__ void
+PagerankApplyKernel(
+    uint64_t num_nodes, float alpha, float* ranks, float* next_ranks,
+    float* delta) {
+  uint32_t n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n >= num_nodes) {
+    return;
+  }
+  float next = (1 - alpha) + alpha * next_ranks[n];
+  atomicAdd(delta, fabsf(next - ranks[n]));
+  ranks[n] = next;
+  next_ranks[n] = 0;
+}
+
+// CUDA's 64-bit atomicMin is defined for unsigned long long, so the
+// component labels use that type on the device; it has the same size and
+// representation as the uint64_t labels on the host.
+__global__ void
+ComponentsInitKernel(unsigned long long* components, uint64_t num_nodes) {
+  uint32_t n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n < num_nodes) {
+    components[n] = n;
+  }
+}
+
+__global__ void
+ComponentsPropagateKernel(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    unsigned long long* components, int* changed) {
+  uint32_t n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n >= num_nodes) {
+    return;
+  }
+  for (uint64_t e = EdgeBegin(adj_indices, n); e < adj_indices[n]; ++e) {
+    uint32_t dest = dests[e];
+    // The graph is expected to be symmetric, but propagating in both
+    // directions costs one extra atomicMin and halves the rounds on
+    // graphs that are only mostly symmetric.
+    unsigned long long label = min(components[n], components[dest]);
+    if (atomicMin(&components[n], label) > label) {
+      *changed = 1;
+    }
+    if (atomicMin(&components[dest], label) > label) {
+      *changed = 1;
+    }
+  }
+}
+
+bool
+UploadCsr(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, DeviceArray<uint64_t>* d_adj,
+    DeviceArray<uint32_t>* d_dests, std::string* error) {
+  if (!d_adj->Allocate(num_nodes, error) ||
+      !d_adj->CopyIn(adj_indices, num_nodes, error)) {
+    return false;
+  }
+  if (num_edges > 0 &&
+      (!d_dests->Allocate(num_edges, error) ||
+       !d_dests->CopyIn(dests, num_edges, error))) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool
+katana::gpu::internal::DeviceAvailable() {
+  int count = 0;
+  return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+}
+
+bool
+katana::gpu::internal::BfsOnDevice(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, uint32_t start, uint32_t* parents,
+    std::string* error) {
+  if (num_nodes == 0) {
+    return true;
+  }
+  DeviceArray<uint64_t> d_adj;
+  DeviceArray<uint32_t> d_dests;
+  if (!UploadCsr(
+          adj_indices, dests, num_nodes, num_edges, &d_adj, &d_dests, error)) {
+    return false;
+  }
+
+  DeviceArray<uint32_t> d_levels;
+  DeviceArray<uint32_t> d_parents;
+  DeviceArray<int> d_changed;
+  if (!d_levels.Allocate(num_nodes, error) ||
+      !d_parents.Allocate(num_nodes, error) || !d_changed.Allocate(1, error)) {
+    return false;
+  }
+
+  int blocks = NumBlocks(num_nodes);
+  FillKernel<<<blocks, kBlockSize>>>(d_levels.get(), num_nodes, kUnvisited);
+  FillKernel<<<blocks, kBlockSize>>>(d_parents.get(), num_nodes, kUnvisited);
+  uint32_t zero = 0;
+  CHECK_CUDA(cudaMemcpy(
+      d_levels.get() + start, &zero, sizeof(uint32_t),
+      cudaMemcpyHostToDevice));
+  CHECK_CUDA(cudaMemcpy(
+      d_parents.get() + start, &start, sizeof(uint32_t),
+      cudaMemcpyHostToDevice));
+
+  // Levels double as the frontier: a round expands exactly the nodes at
+  // the current level, so there is no frontier queue to maintain. Reads
+  // and claims go through the same level array; a node claimed this round
+  // has level current + 1 and is not expanded until the next round.
+  for (uint32_t level = 0;; ++level) {
+    int changed = 0;
+    CHECK_CUDA(cudaMemcpy(
+        d_changed.get(), &changed, sizeof(int), cudaMemcpyHostToDevice));
+    BfsLevelKernel<<<blocks, kBlockSize>>>(
+        d_adj.get(), d_dests.get(), num_nodes, d_levels.get(),
+        d_parents.get(), level, d_changed.get());
+    CHECK_CUDA(cudaDeviceSynchronize());
+    CHECK_CUDA(cudaMemcpy(
+        &changed, d_changed.get(), sizeof(int), cudaMemcpyDeviceToHost));
+    if (changed == 0) {
+      break;
+    }
+  }
+
+  return d_parents.CopyOut(parents, num_nodes, error);
+}
+
+bool
+katana::gpu::internal::PagerankOnDevice(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, float alpha, float tolerance, uint32_t max_rounds,
+    float* ranks, std::string* error) {
+  if (num_nodes == 0) {
+    return true;
+  }
+  DeviceArray<uint64_t> d_adj;
+  DeviceArray<uint32_t> d_dests;
+  if (!UploadCsr(
+          adj_indices, dests, num_nodes, num_edges, &d_adj, &d_dests, error)) {
+    return false;
+  }
+
+  DeviceArray<float> d_ranks;
+  DeviceArray<float> d_next;
+  DeviceArray<float> d_delta;
+  if (!d_ranks.Allocate(num_nodes, error) ||
+      !d_next.Allocate(num_nodes, error) || !d_delta.Allocate(1, error)) {
+    return false;
+  }
+
+  int blocks = NumBlocks(num_nodes);
+  FillKernel<<<blocks, kBlockSize>>>(d_ranks.get(), num_nodes, 1 - alpha);
+  FillKernel<<<blocks, kBlockSize>>>(d_next.get(), num_nodes, 0.0f);
+
+  for (uint32_t round = 0; round < max_rounds; ++round) {
+    float delta = 0;
+    CHECK_CUDA(cudaMemcpy(
+        d_delta.get(), &delta, sizeof(float), cudaMemcpyHostToDevice));
+    PagerankScatterKernel<<<blocks, kBlockSize>>>(
+        d_adj.get(), d_dests.get(), num_nodes, d_ranks.get(), d_next.get());
+    PagerankApplyKernel<<<blocks, kBlockSize>>>(
+        num_nodes, alpha, d_ranks.get(), d_next.get(), d_delta.get());
+    CHECK_CUDA(cudaDeviceSynchronize());
+    CHECK_CUDA(cudaMemcpy(
+        &delta, d_delta.get(), sizeof(float), cudaMemcpyDeviceToHost));
+    if (delta < tolerance) {
+      break;
+    }
+  }
+
+  return d_ranks.CopyOut(ranks, num_nodes, error);
+}
+
+namespace katana::gpu::internal {
+
+struct HybridBfsState {
+  DeviceArray<uint64_t> adj;
+  DeviceArray<uint32_t> dests;
+  DeviceArray<uint32_t> parents;
+  DeviceArray<uint64_t> front_bits;
+  DeviceArray<uint64_t> next_bits;
+  DeviceArray<unsigned long long> count;
+  uint64_t num_nodes{0};
+  uint64_t num_words{0};
+};
+
+}  // namespace katana::gpu::internal
+
+namespace {
+
+__global__ void
+BfsBottomUpKernel(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint32_t* parents, const uint64_t* front_bits, uint64_t* next_bits,
+    unsigned long long* count) {
+  uint32_t n = blockIdx.x * blockDim.x + threadIdx.x;
+  if (n >= num_nodes || parents[n] != kUnvisited) {
+    return;
+  }
+  for (uint64_t e = EdgeBegin(adj_indices, n); e < adj_indices[n]; ++e) {
+    uint32_t dest = dests[e];
+    if (front_bits[dest / 64] & (uint64_t{1} << (dest % 64))) {
+      parents[n] = dest;
+      atomicOr(
+          reinterpret_cast<unsigned long long*>(&next_bits[n / 64]),
+          static_cast<unsigned long long>(uint64_t{1} << (n % 64)));
+      atomicAdd(count, 1);
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+bool
+katana::gpu::internal::HybridBfsCreate(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, HybridBfsState** state, std::string* error) {
+  auto owned = std::make_unique<HybridBfsState>();
+  owned->num_nodes = num_nodes;
+  owned->num_words = (num_nodes + 63) / 64;
+  if (!UploadCsr(
+          adj_indices, dests, num_nodes, num_edges, &owned->adj, &owned->dests,
+          error)) {
+    return false;
+  }
+  if (!owned->parents.Allocate(num_nodes, error) ||
+      !owned->front_bits.Allocate(owned->num_words, error) ||
+      !owned->next_bits.Allocate(owned->num_words, error) ||
+      !owned->count.Allocate(1, error)) {
+    return false;
+  }
+  *state = owned.release();
+  return true;
+}
+
+void
+katana::gpu::internal::HybridBfsDestroy(HybridBfsState* state) {
+  delete state;
+}
+
+bool
+katana::gpu::internal::HybridBfsUploadParents(
+    HybridBfsState* state, const uint32_t* parents, std::string* error) {
+  return state->parents.CopyIn(parents, state->num_nodes, error);
+}
+
+bool
+katana::gpu::internal::HybridBfsDownloadParents(
+    HybridBfsState* state, uint32_t* parents, std::string* error) {
+  return state->parents.CopyOut(parents, state->num_nodes, error);
+}
+
+bool
+katana::gpu::internal::HybridBfsBottomUpRound(
+    HybridBfsState* state, const uint64_t* front_bits, uint64_t* next_bits,
+    uint64_t num_words, uint64_t* next_frontier_size, std::string* error) {
+  if (num_words != state->num_words) {
+    *error = "frontier bitset size mismatch";
+    return false;
+  }
+  if (!state->front_bits.CopyIn(front_bits, num_words, error)) {
+    return false;
+  }
+  CHECK_CUDA(cudaMemset(
+      state->next_bits.get(), 0, num_words * sizeof(uint64_t)));
+  unsigned long long count = 0;
+  CHECK_CUDA(cudaMemcpy(
+      state->count.get(), &count, sizeof(count), cudaMemcpyHostToDevice));
+
+  BfsBottomUpKernel<<<NumBlocks(state->num_nodes), kBlockSize>>>(
+      state->adj.get(), state->dests.get(), state->num_nodes,
+      state->parents.get(), state->front_bits.get(), state->next_bits.get(),
+      state->count.get());
+  CHECK_CUDA(cudaDeviceSynchronize());
+
+  if (!state->next_bits.CopyOut(next_bits, num_words, error)) {
+    return false;
+  }
+  CHECK_CUDA(cudaMemcpy(
+      &count, state->count.get(), sizeof(count), cudaMemcpyDeviceToHost));
+  *next_frontier_size = count;
+  return true;
+}
+
+bool
+katana::gpu::internal::ConnectedComponentsOnDevice(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, uint64_t* components, std::string* error) {
+  if (num_nodes == 0) {
+    return true;
+  }
+  DeviceArray<uint64_t> d_adj;
+  DeviceArray<uint32_t> d_dests;
+  if (!UploadCsr(
+          adj_indices, dests, num_nodes, num_edges, &d_adj, &d_dests, error)) {
+    return false;
+  }
+
+  DeviceArray<unsigned long long> d_components;
+  DeviceArray<int> d_changed;
+  if (!d_components.Allocate(num_nodes, error) ||
+      !d_changed.Allocate(1, error)) {
+    return false;
+  }
+
+  int blocks = NumBlocks(num_nodes);
+  ComponentsInitKernel<<<blocks, kBlockSize>>>(d_components.get(), num_nodes);
+
+  while (true) {
+    int changed = 0;
+    CHECK_CUDA(cudaMemcpy(
+        d_changed.get(), &changed, sizeof(int), cudaMemcpyHostToDevice));
+    ComponentsPropagateKernel<<<blocks, kBlockSize>>>(
+        d_adj.get(), d_dests.get(), num_nodes, d_components.get(),
+        d_changed.get());
+    CHECK_CUDA(cudaDeviceSynchronize());
+    CHECK_CUDA(cudaMemcpy(
+        &changed, d_changed.get(), sizeof(int), cudaMemcpyDeviceToHost));
+    if (changed == 0) {
+      break;
+    }
+  }
+
+  return d_components.CopyOut(
+      reinterpret_cast<unsigned long long*>(components), num_nodes, error);
+}
@@ -0,0 +1,74 @@
+#ifndef KATANA_LIBGPU_GPUENGINES_H_
+#define KATANA_LIBGPU_GPUENGINES_H_
+
+#include <cstdint>
+#include <string>
+
+/// Internal interface between the host dispatch code (GpuAnalytics.cpp)
+/// and the CUDA kernels (GpuEngines.cu). These functions are only defined
+/// when the library is built with CUDA support; the dispatch code guards
+/// every call with KATANA_USE_GPU. They operate on the raw CSR arrays of a
+/// GraphTopology (adj_indices holds exclusive prefix ends, dests holds
+/// edge destinations) and fill caller-allocated host output arrays. On
+/// failure they return false and describe the CUDA error in *error.
+
+namespace katana::gpu::internal {
+
+/// True when at least one usable CUDA device is present.
+bool DeviceAvailable();
+
+/// Level-synchronous BFS from start. parents has num_nodes entries; an
+/// unreached node keeps a parent of UINT32_MAX, which the statistics and
+/// validation code recognize as unvisited (any value above num_nodes is).
+bool BfsOnDevice(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, uint32_t start, uint32_t* parents, std::string* error);
+
+/// Synchronous push Page Rank. Runs until the summed absolute rank change
+/// of a round drops below tolerance or max_rounds rounds have run. ranks
+/// has num_nodes entries.
+bool PagerankOnDevice(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, float alpha, float tolerance, uint32_t max_rounds,
+    float* ranks, std::string* error);
+
+/// Label propagation to a fixed point; each label converges to the
+/// minimum node ID in its component. components has num_nodes entries.
+/// Every edge is treated as undirected, as the CPU engines assume a
+/// symmetric graph.
+bool ConnectedComponentsOnDevice(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, uint64_t* components, std::string* error);
+
+/// Device-resident state for the hybrid CPU+GPU BFS: the CSR, a parent
+/// array, and current/next frontier bitsets. The host side of the engine
+/// (HybridBfs in GpuAnalytics.cpp) keeps its own parent array and frontier
+/// and syncs them through the calls below at placement switches.
+struct HybridBfsState;
+
+/// Copy the CSR to the device and allocate parent and bitset arrays.
+bool HybridBfsCreate(
+    const uint64_t* adj_indices, const uint32_t* dests, uint64_t num_nodes,
+    uint64_t num_edges, HybridBfsState** state, std::string* error);
+void HybridBfsDestroy(HybridBfsState* state);
+
+/// Full parent-array sync at a CPU-to-GPU or GPU-to-CPU switch; placement
+/// switches are rare (typically two per traversal) so the full copy is
+/// cheaper than keeping both sides coherent every round.
+bool HybridBfsUploadParents(
+    HybridBfsState* state, const uint32_t* parents, std::string* error);
+bool HybridBfsDownloadParents(
+    HybridBfsState* state, uint32_t* parents, std::string* error);
+
+/// One bottom-up (pull) round on the device: every unvisited node scans
+/// its edges for a neighbor in front_bits and adopts it as parent.
+/// front_bits and next_bits are host bitsets of num_words 64-bit words;
+/// allocating them from the pinned heap keeps the exchange async-capable.
+/// next_frontier_size receives the number of newly visited nodes.
+bool HybridBfsBottomUpRound(
+    HybridBfsState* state, const uint64_t* front_bits, uint64_t* next_bits,
+    uint64_t num_words, uint64_t* next_frontier_size, std::string* error);
+
+}  // namespace katana::gpu::internal
+
+#endif
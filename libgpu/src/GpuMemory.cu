@@ -0,0 +1,109 @@
+#include "GpuMemory.h"
+
+#include <cuda_runtime.h>
+
+namespace {
+
+bool
+Check(cudaError_t rc, const char* what, std::string* error) {
+  if (rc != cudaSuccess) {
+    *error = std::string(what) + ": " + cudaGetErrorString(rc);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+void*
+katana::gpu::internal::PinnedAlloc(size_t bytes) {
+  void* ptr = nullptr;
+  if (cudaHostAlloc(&ptr, bytes, cudaHostAllocPortable) != cudaSuccess) {
+    return nullptr;
+  }
+  return ptr;
+}
+
+void
+katana::gpu::internal::PinnedFree(void* ptr) {
+  cudaFreeHost(ptr);
+}
+
+bool
+katana::gpu::internal::DeviceAlloc(
+    void** ptr, size_t bytes, std::string* error) {
+  return Check(cudaMalloc(ptr, bytes), "cudaMalloc", error);
+}
+
+void
+katana::gpu::internal::DeviceFree(void* ptr) {
+  cudaFree(ptr);
+}
+
+bool
+katana::gpu::internal::StreamCreate(void** stream, std::string* error) {
+  cudaStream_t s = nullptr;
+  if (!Check(
+          cudaStreamCreateWithFlags(&s, cudaStreamNonBlocking),
+          "cudaStreamCreateWithFlags", error)) {
+    return false;
+  }
+  *stream = s;
+  return true;
+}
+
+void
+katana::gpu::internal::StreamDestroy(void* stream) {
+  cudaStreamDestroy(static_cast<cudaStream_t>(stream));
+}
+
+bool
+katana::gpu::internal::StreamSynchronize(void* stream, std::string* error) {
+  return Check(
+      cudaStreamSynchronize(static_cast<cudaStream_t>(stream)),
+      "cudaStreamSynchronize", error);
+}
+
+bool
+katana::gpu::internal::EventCreate(void** event, std::string* error) {
+  cudaEvent_t e = nullptr;
+  if (!Check(
+          cudaEventCreateWithFlags(&e, cudaEventDisableTiming),
+          "cudaEventCreateWithFlags", error)) {
+    return false;
+  }
+  *event = e;
+  return true;
+}
+
+void
+katana::gpu::internal::EventDestroy(void* event) {
+  cudaEventDestroy(static_cast<cudaEvent_t>(event));
+}
+
+bool
+katana::gpu::internal::EventRecord(
+    void* event, void* stream, std::string* error) {
+  return Check(
+      cudaEventRecord(
+          static_cast<cudaEvent_t>(event), static_cast<cudaStream_t>(stream)),
+      "cudaEventRecord", error);
+}
+
+bool
+katana::gpu::internal::EventSynchronize(void* event, std::string* error) {
+  return Check(
+      cudaEventSynchronize(static_cast<cudaEvent_t>(event)),
+      "cudaEventSynchronize", error);
+}
+
+bool
+katana::gpu::internal::CopyToDeviceAsync(
+    void* dst, const void* src, size_t bytes, void* stream,
+    std::string* error) {
+  return Check(
+      cudaMemcpyAsync(
+          dst, src, bytes, cudaMemcpyHostToDevice,
+          static_cast<cudaStream_t>(stream)),
+      "cudaMemcpyAsync", error);
+}
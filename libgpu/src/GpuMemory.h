@@ -0,0 +1,41 @@
+#ifndef KATANA_LIBGPU_GPUMEMORY_H_
+#define KATANA_LIBGPU_GPUMEMORY_H_
+
+#include <cstddef>
+#include <string>
+
+/// Internal interface wrapping the CUDA memory and stream runtime calls
+/// used by the pinned host heap (PinnedHostAllocator.cpp) and the async
+/// topology transfer (TopologyTransfer.cpp). Streams and events are passed
+/// as opaque void* so the host translation units never see CUDA types.
+/// These functions are only defined when the library is built with CUDA
+/// support; callers guard every call with KATANA_USE_GPU.
+
+namespace katana::gpu::internal {
+
+/// Page-locked host allocation; returns nullptr on failure (callers fall
+/// back to pageable memory).
+void* PinnedAlloc(size_t bytes);
+void PinnedFree(void* ptr);
+
+bool DeviceAlloc(void** ptr, size_t bytes, std::string* error);
+void DeviceFree(void* ptr);
+
+bool StreamCreate(void** stream, std::string* error);
+void StreamDestroy(void* stream);
+bool StreamSynchronize(void* stream, std::string* error);
+
+bool EventCreate(void** event, std::string* error);
+void EventDestroy(void* event);
+bool EventRecord(void* event, void* stream, std::string* error);
+bool EventSynchronize(void* event, std::string* error);
+
+/// Enqueue a host-to-device copy on stream. src must be page-locked for
+/// the copy to be truly asynchronous.
+bool CopyToDeviceAsync(
+    void* dst, const void* src, size_t bytes, void* stream,
+    std::string* error);
+
+}  // namespace katana::gpu::internal
+
+#endif
@@ -0,0 +1,137 @@
+#include "katana/gpu/PinnedHostAllocator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "GpuMemory.h"
+#include "katana/Env.h"
+
+namespace {
+
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kDefaultCapMB = 256;
+
+}  // namespace
+
+struct katana::gpu::PinnedHostHeap::Header {
+  size_t capacity;
+  bool pinned;
+
+  static_assert(
+      2 * sizeof(size_t) <= kHeaderSize,
+      "allocation header must fit in its cache line");
+};
+
+katana::gpu::PinnedHostHeap::PinnedHostHeap() {
+  int cap_mb = kDefaultCapMB;
+  katana::GetEnv("KATANA_PINNED_POOL_CAP_MB", &cap_mb);
+  cap_bytes_ = static_cast<size_t>(cap_mb) << 20;
+}
+
+katana::gpu::PinnedHostHeap::~PinnedHostHeap() {
+  for (auto& [capacity, header] : pool_) {
+    Release(header);
+  }
+}
+
+void*
+katana::gpu::PinnedHostHeap::AllocateFresh(size_t capacity) {
+  void* raw = nullptr;
+#ifdef KATANA_USE_GPU
+  raw = internal::PinnedAlloc(kHeaderSize + capacity);
+#endif
+  bool pinned = raw != nullptr;
+  if (raw == nullptr) {
+    raw = malloc(kHeaderSize + capacity);
+    if (raw == nullptr) {
+      return nullptr;
+    }
+  }
+  new (raw) Header{capacity, pinned};
+  return static_cast<char*>(raw) + kHeaderSize;
+}
+
+void
+katana::gpu::PinnedHostHeap::Release(Header* header) {
+  if (header->pinned) {
+#ifdef KATANA_USE_GPU
+    internal::PinnedFree(header);
+#endif
+  } else {
+    free(header);
+  }
+}
+
+void*
+katana::gpu::PinnedHostHeap::Malloc(const size_t n_bytes) {
+  if (n_bytes == 0) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    // Reuse the smallest pooled buffer that fits, as long as it does not
+    // waste more than half its capacity on this request.
+    auto it = pool_.lower_bound(n_bytes);
+    if (it != pool_.end() && it->first <= 2 * n_bytes) {
+      Header* header = it->second;
+      pool_bytes_ -= it->first;
+      pool_.erase(it);
+      return reinterpret_cast<char*>(header) + kHeaderSize;
+    }
+  }
+  return AllocateFresh(n_bytes);
+}
+
+void*
+katana::gpu::PinnedHostHeap::Calloc(
+    const size_t n_items, const size_t item_size) {
+  void* ptr = Malloc(n_items * item_size);
+  if (ptr != nullptr) {
+    memset(ptr, 0, n_items * item_size);
+  }
+  return ptr;
+}
+
+void*
+katana::gpu::PinnedHostHeap::Realloc(void* ptr, const size_t new_bytes) {
+  if (ptr == nullptr) {
+    return Malloc(new_bytes);
+  }
+  Header* header =
+      reinterpret_cast<Header*>(static_cast<char*>(ptr) - kHeaderSize);
+  if (header->capacity >= new_bytes) {
+    return ptr;
+  }
+  void* fresh = Malloc(new_bytes);
+  if (fresh == nullptr) {
+    return nullptr;
+  }
+  memcpy(fresh, ptr, header->capacity);
+  Free(ptr);
+  return fresh;
+}
+
+void
+katana::gpu::PinnedHostHeap::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  Header* header =
+      reinterpret_cast<Header*>(static_cast<char*>(ptr) - kHeaderSize);
+  if (header->pinned) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (pool_bytes_ + header->capacity <= cap_bytes_) {
+      pool_.emplace(header->capacity, header);
+      pool_bytes_ += header->capacity;
+      return;
+    }
+  }
+  Release(header);
+}
+
+katana::HostHeap*
+katana::gpu::GetPinnedHostHeap() {
+  static PinnedHostHeap heap;
+  return &heap;
+}
@@ -0,0 +1,195 @@
+#include "katana/gpu/TopologyTransfer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GpuMemory.h"
+#include "katana/ErrorCode.h"
+#include "katana/gpu/PinnedHostAllocator.h"
+
+class katana::gpu::TopologyTransfer::Impl {
+public:
+  explicit Impl(size_t chunk_size) : chunk_size_(chunk_size) {}
+
+  ~Impl() {
+#ifdef KATANA_USE_GPU
+    // Staging buffers and device arrays may still be copy sources and
+    // targets; quiesce the stream before tearing anything down.
+    if (stream_ != nullptr) {
+      std::string ignored;
+      internal::StreamSynchronize(stream_, &ignored);
+      internal::StreamDestroy(stream_);
+    }
+    for (void*& event : events_) {
+      if (event != nullptr) {
+        internal::EventDestroy(event);
+      }
+    }
+    for (void*& buffer : staging_) {
+      GetPinnedHostHeap()->Free(buffer);
+    }
+    internal::DeviceFree(d_adj_);
+    internal::DeviceFree(d_dests_);
+#endif
+  }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+
+#ifdef KATANA_USE_GPU
+  katana::Result<void> Start(const GraphTopology& topology) {
+    num_nodes_ = topology.num_nodes();
+    num_edges_ = topology.num_edges();
+
+    std::string error;
+    if (!internal::StreamCreate(&stream_, &error)) {
+      return CudaError(error);
+    }
+    for (void*& buffer : staging_) {
+      buffer = GetPinnedHostHeap()->Malloc(chunk_size_);
+      if (buffer == nullptr) {
+        return KATANA_ERROR(
+            ErrorCode::AssertionFailed,
+            "cannot allocate a {} byte staging buffer", chunk_size_);
+      }
+    }
+    for (void*& event : events_) {
+      if (!internal::EventCreate(&event, &error)) {
+        return CudaError(error);
+      }
+    }
+
+    if (num_nodes_ > 0) {
+      KATANA_CHECKED(CopyArray(
+          topology.adj_data(), num_nodes_ * sizeof(uint64_t),
+          reinterpret_cast<void**>(&d_adj_)));
+    }
+    if (num_edges_ > 0) {
+      KATANA_CHECKED(CopyArray(
+          topology.dest_data(), num_edges_ * sizeof(uint32_t),
+          reinterpret_cast<void**>(&d_dests_)));
+    }
+    return ResultSuccess();
+  }
+
+  katana::Result<void> Wait() {
+    std::string error;
+    if (!internal::StreamSynchronize(stream_, &error)) {
+      return CudaError(error);
+    }
+    return ResultSuccess();
+  }
+#endif
+
+  const uint64_t* d_adj() const { return d_adj_; }
+  const uint32_t* d_dests() const { return d_dests_; }
+  void* stream() const { return stream_; }
+  uint64_t num_nodes() const { return num_nodes_; }
+  uint64_t num_edges() const { return num_edges_; }
+
+private:
+#ifdef KATANA_USE_GPU
+  static katana::Result<void> CudaError(const std::string& error) {
+    return KATANA_ERROR(ErrorCode::AssertionFailed, "{}", error);
+  }
+
+  /// Allocate *device for n_bytes and enqueue the chunked copy of the
+  /// host array through the staging buffers.
+  katana::Result<void> CopyArray(
+      const void* host, size_t n_bytes, void** device) {
+    std::string error;
+    if (!internal::DeviceAlloc(device, n_bytes, &error)) {
+      return CudaError(error);
+    }
+    const char* src = static_cast<const char*>(host);
+    char* dst = static_cast<char*>(*device);
+    for (size_t offset = 0; offset < n_bytes; offset += chunk_size_) {
+      size_t chunk = std::min(chunk_size_, n_bytes - offset);
+      int buffer = next_buffer_;
+      next_buffer_ = (next_buffer_ + 1) % kNumBuffers;
+      // Do not scribble over a staging buffer whose previous DMA is
+      // still in flight.
+      if (!internal::EventSynchronize(events_[buffer], &error)) {
+        return CudaError(error);
+      }
+      memcpy(staging_[buffer], src + offset, chunk);
+      if (!internal::CopyToDeviceAsync(
+              dst + offset, staging_[buffer], chunk, stream_, &error) ||
+          !internal::EventRecord(events_[buffer], stream_, &error)) {
+        return CudaError(error);
+      }
+    }
+    return ResultSuccess();
+  }
+#endif
+
+  static constexpr int kNumBuffers = 2;
+
+  size_t chunk_size_;
+  uint64_t num_nodes_{0};
+  uint64_t num_edges_{0};
+  void* stream_{nullptr};
+  void* staging_[kNumBuffers]{};
+  void* events_[kNumBuffers]{};
+  int next_buffer_{0};
+  uint64_t* d_adj_{nullptr};
+  uint32_t* d_dests_{nullptr};
+};
+
+katana::gpu::TopologyTransfer::TopologyTransfer(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+katana::gpu::TopologyTransfer::TopologyTransfer(TopologyTransfer&&) = default;
+katana::gpu::TopologyTransfer&
+katana::gpu::TopologyTransfer::operator=(TopologyTransfer&&) = default;
+katana::gpu::TopologyTransfer::~TopologyTransfer() = default;
+
+katana::Result<katana::gpu::TopologyTransfer>
+katana::gpu::TopologyTransfer::Start(
+    const GraphTopology& topology, size_t chunk_size) {
+#ifdef KATANA_USE_GPU
+  auto impl = std::make_unique<Impl>(chunk_size);
+  KATANA_CHECKED(impl->Start(topology));
+  return TopologyTransfer(std::move(impl));
+#else
+  (void)topology;
+  (void)chunk_size;
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "katana was built without CUDA support");
+#endif
+}
+
+katana::Result<void>
+katana::gpu::TopologyTransfer::Wait() {
+#ifdef KATANA_USE_GPU
+  return impl_->Wait();
+#else
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "katana was built without CUDA support");
+#endif
+}
+
+const uint64_t*
+katana::gpu::TopologyTransfer::device_adj_data() const {
+  return impl_->d_adj();
+}
+
+const uint32_t*
+katana::gpu::TopologyTransfer::device_dest_data() const {
+  return impl_->d_dests();
+}
+
+void*
+katana::gpu::TopologyTransfer::stream() const {
+  return impl_->stream();
+}
+
+uint64_t
+katana::gpu::TopologyTransfer::num_nodes() const {
+  return impl_->num_nodes();
+}
+
+uint64_t
+katana::gpu::TopologyTransfer::num_edges() const {
+  return impl_->num_edges();
+}
@@ -1,9 +1,14 @@
 #ifndef KATANA_LIBSUPPORT_KATANA_ARROWINTERCHANGE_H_
 #define KATANA_LIBSUPPORT_KATANA_ARROWINTERCHANGE_H_
 
+#include <algorithm>
+#include <limits>
+
+#include <arrow/api.h>
 #include <arrow/stl.h>
 #include <arrow/type_traits.h>
 
+#include "katana/ArrowVisitor.h"
 #include "katana/ErrorCode.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
@@ -18,6 +23,11 @@
 ///
 /// \file
 
+// Arrow C data interface structs (arrow/c/abi.h); forward declared so users
+// of this header do not pick up the C definitions unless they export.
+struct ArrowSchema;
+struct ArrowArray;
+
 namespace katana {
 
 /// Perform a safe cast from \param gen_array to \tparam ArrowArrayType
@@ -298,6 +308,130 @@ ApproxArrayMemUse(const std::shared_ptr<arrow::Array>& array);
 KATANA_EXPORT uint64_t
 ApproxTableMemUse(const std::shared_ptr<arrow::Table>& table);
 
+/// Export a ChunkedArray over the Arrow C data interface.
+///
+/// A single-chunk array is exported zero-copy: the consumer shares the
+/// chunk's buffers and keeps them alive through the release callbacks. A
+/// multi-chunk array is consolidated with arrow::Concatenate first, the one
+/// copy that cannot be avoided since the C data interface describes a
+/// single contiguous array. This runs entirely in native code, so language
+/// bindings can drop their interpreter lock (e.g. the Python GIL) while a
+/// large column consolidates.
+///
+/// \param out_array receives the exported array; the consumer must call its
+///    release callback
+/// \param out_schema receives the exported type; same ownership rule
+KATANA_EXPORT Result<void> ExportChunkedArray(
+    const std::shared_ptr<arrow::ChunkedArray>& chunked,
+    struct ArrowArray* out_array, struct ArrowSchema* out_schema);
+
+//////////////////////////////////////////////////////////
+// Bulk kernels over fixed-width arrays
+//
+// These transform whole arrays with single passes over the raw value
+// buffers, loops the compiler can vectorize, instead of per-element scalar
+// or builder access. The runtime type is resolved once per array.
+
+/// Copy the validity bitmap of \p array into a freshly allocated buffer, or
+/// return nullptr when the array has no nulls
+inline Result<std::shared_ptr<arrow::Buffer>>
+CopyValidityBitmap(const arrow::Array& array) {
+  if (array.null_count() == 0) {
+    return std::shared_ptr<arrow::Buffer>();
+  }
+  std::shared_ptr<arrow::Buffer> bitmap =
+      KATANA_CHECKED(arrow::AllocateEmptyBitmap(array.length()));
+  uint8_t* out = bitmap->mutable_data();
+  for (int64_t i = 0, n = array.length(); i < n; ++i) {
+    if (array.IsValid(i)) {
+      arrow::BitUtil::SetBit(out, i);
+    }
+  }
+  return bitmap;
+}
+
+namespace internal {
+
+template <typename ArrowToType>
+struct BulkCastVisitor : public ArrowVisitor {
+  using ResultType = Result<std::shared_ptr<arrow::Array>>;
+  using AcceptTypes = std::tuple<AcceptNumericArrowTypes>;
+
+  template <typename ArrowType, typename ArrayType>
+  ResultType Call(const ArrayType& array) {
+    using From = typename ArrowType::c_type;
+    using To = typename ArrowToType::c_type;
+    const From* src = array.raw_values();
+    const int64_t length = array.length();
+    std::shared_ptr<arrow::Buffer> values =
+        KATANA_CHECKED(arrow::AllocateBuffer(length * int64_t{sizeof(To)}));
+    To* dst = reinterpret_cast<To*>(values->mutable_data());
+    for (int64_t i = 0; i < length; ++i) {
+      dst[i] = static_cast<To>(src[i]);
+    }
+    std::shared_ptr<arrow::Buffer> validity =
+        KATANA_CHECKED(CopyValidityBitmap(array));
+    return arrow::MakeArray(arrow::ArrayData::Make(
+        arrow::TypeTraits<ArrowToType>::type_singleton(), length,
+        {std::move(validity), std::move(values)}, array.null_count()));
+  }
+
+  ResultType AcceptFailed(const arrow::Array& array) {
+    return KATANA_ERROR(
+        ErrorCode::ArrowError, "cannot bulk cast from {}",
+        array.type()->name());
+  }
+};
+
+}  // namespace internal
+
+/// BulkCast converts a numeric array to \tparam ArrowToType in one pass over
+/// the raw value buffer; nulls are preserved
+template <typename ArrowToType>
+Result<std::shared_ptr<arrow::Array>>
+BulkCast(const std::shared_ptr<arrow::Array>& array) {
+  internal::BulkCastVisitor<ArrowToType> visitor;
+  return VisitArrow(visitor, *array);
+}
+
+/// BulkFill makes an array of \p length copies of \p value with no nulls
+template <typename ArrowType>
+Result<std::shared_ptr<arrow::Array>>
+BulkFill(int64_t length, typename ArrowType::c_type value) {
+  using CType = typename ArrowType::c_type;
+  std::shared_ptr<arrow::Buffer> values =
+      KATANA_CHECKED(arrow::AllocateBuffer(length * int64_t{sizeof(CType)}));
+  std::fill_n(reinterpret_cast<CType*>(values->mutable_data()), length, value);
+  return arrow::MakeArray(arrow::ArrayData::Make(
+      arrow::TypeTraits<ArrowType>::type_singleton(), length,
+      {nullptr, std::move(values)}, /*null_count=*/0));
+}
+
+/// Element-wise a + b clamped at the numeric limits instead of wrapping.
+/// Both arrays must have the same numeric type and length; the result is
+/// null where either input is null
+KATANA_EXPORT Result<std::shared_ptr<arrow::Array>> BulkSaturatingAdd(
+    const std::shared_ptr<arrow::Array>& a,
+    const std::shared_ptr<arrow::Array>& b);
+
+/// Gather values[indices[i]] into a new array of the same type as
+/// \p values; \p indices may be any 32- or 64-bit integer type. An index
+/// outside [0, values->length()) is an error; the result is null where the
+/// index or the value it selects is null
+KATANA_EXPORT Result<std::shared_ptr<arrow::Array>> BulkGather(
+    const std::shared_ptr<arrow::Array>& values,
+    const std::shared_ptr<arrow::Array>& indices);
+
+/// The memory pool arrow-facing code (tsuba reads, property building) should
+/// allocate from. Defaults to arrow::default_memory_pool(); the shared-memory
+/// runtime installs a NUMA-aware pool at startup so property buffers land on
+/// katana-controlled pages and show up in katana accounting.
+KATANA_EXPORT arrow::MemoryPool* GetArrowMemoryPool();
+
+/// Install \p pool as the process-wide arrow pool; nullptr resets to the
+/// arrow default. The pool must outlive every buffer allocated from it.
+KATANA_EXPORT void SetArrowMemoryPool(arrow::MemoryPool* pool);
+
 }  // namespace katana
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef KATANA_LIBSUPPORT_KATANA_ARROWVISITOR_H_
 #define KATANA_LIBSUPPORT_KATANA_ARROWVISITOR_H_
 
+#include <algorithm>
 #include <type_traits>
 
 #include <arrow/api.h>
@@ -321,6 +322,174 @@ using AcceptAllArrowTypes = std::tuple<
 template <typename... Args>
 using tuple_cat_t = decltype(std::tuple_cat(std::declval<Args>()...));
 
+/// Number of values handed to a block visitor per call by default. Small
+/// enough to stay cache resident, large enough to amortize the dispatch.
+constexpr int64_t kArrowBlockSize = 4096;
+
+/// ArrowBlock is a typed view of a run of consecutive values from a
+/// fixed-width array. Values are exposed through a raw pointer so a loop over
+/// a block compiles down to plain array indexing, unlike per-element
+/// arrow::Scalar access.
+template <typename T>
+struct ArrowBlock {
+  const T* values{};
+  /// Validity bitmap of the whole array; nullptr when every value is valid
+  const uint8_t* null_bitmap{};
+  /// Bit position of values[0] in null_bitmap
+  int64_t bitmap_offset{};
+  int64_t length{};
+
+  bool IsValid(int64_t i) const {
+    return null_bitmap == nullptr ||
+           arrow::BitUtil::GetBit(null_bitmap, bitmap_offset + i);
+  }
+};
+
+/// ArrowStringBlock is a view of a run of consecutive values from a
+/// string-like array, exposed as offsets into a shared character buffer.
+template <typename OffsetType>
+struct ArrowStringBlock {
+  /// length + 1 entries; offsets[i] and offsets[i + 1] delimit value i in data
+  const OffsetType* offsets{};
+  const uint8_t* data{};
+  const uint8_t* null_bitmap{};
+  int64_t bitmap_offset{};
+  int64_t length{};
+
+  bool IsValid(int64_t i) const {
+    return null_bitmap == nullptr ||
+           arrow::BitUtil::GetBit(null_bitmap, bitmap_offset + i);
+  }
+
+  arrow::util::string_view GetView(int64_t i) const {
+    return arrow::util::string_view(
+        reinterpret_cast<const char*>(data) + offsets[i],
+        offsets[i + 1] - offsets[i]);
+  }
+};
+
+namespace internal {
+
+/// BlockDispatcher adapts a block visitor to the VisitArrow protocol: the
+/// runtime type is resolved once per array and the visitor is then invoked on
+/// typed spans, rather than paying the type switch per element.
+template <typename Visitor>
+class BlockDispatcher : public ArrowVisitor {
+public:
+  using ResultType = Result<void>;
+  using AcceptTypes = std::tuple<AcceptAllArrowTypes>;
+
+  BlockDispatcher(Visitor& visitor, int64_t block_size)
+      : visitor_(visitor), block_size_(block_size) {}
+
+  template <typename ArrowType, typename ArrayType>
+  ResultType Call(const ArrayType& array) {
+    using VisitorAcceptTuple =
+        std::tuple_element_t<0, typename Visitor::AcceptTypes>;
+    constexpr bool accepted =
+        ArrowDispatcher::TupleContains<ArrowType, VisitorAcceptTuple>(
+            std::make_index_sequence<std::tuple_size_v<VisitorAcceptTuple>>());
+    if constexpr (!accepted) {
+      return visitor_.AcceptFailed(array);
+    } else if constexpr (
+        arrow::is_number_type<ArrowType>::value ||
+        arrow::is_temporal_type<ArrowType>::value) {
+      using CType = typename ArrowType::c_type;
+      const CType* values = array.raw_values();
+      const uint8_t* bitmap = array.null_bitmap_data();
+      for (int64_t begin = 0, n = array.length(); begin < n;
+           begin += block_size_) {
+        ArrowBlock<CType> block{
+            values + begin, bitmap, array.offset() + begin,
+            std::min(block_size_, n - begin)};
+        KATANA_CHECKED(visitor_.template Call<ArrowType>(block));
+      }
+      return ResultSuccess();
+    } else if constexpr (is_string_like_type_patched<ArrowType>::value) {
+      using OffsetType = typename ArrowType::offset_type;
+      const OffsetType* offsets = array.raw_value_offsets();
+      const uint8_t* data =
+          array.value_data() ? array.value_data()->data() : nullptr;
+      const uint8_t* bitmap = array.null_bitmap_data();
+      for (int64_t begin = 0, n = array.length(); begin < n;
+           begin += block_size_) {
+        ArrowStringBlock<OffsetType> block{
+            offsets + begin, data, bitmap, array.offset() + begin,
+            std::min(block_size_, n - begin)};
+        KATANA_CHECKED(visitor_.template Call<ArrowType>(block));
+      }
+      return ResultSuccess();
+    } else {
+      // only fixed-width and offset layouts can be described by a block;
+      // booleans are bit-packed and nested types have no flat buffer
+      return visitor_.AcceptFailed(array);
+    }
+  }
+
+  ResultType AcceptFailed(const arrow::Array& array) {
+    return visitor_.AcceptFailed(array);
+  }
+
+private:
+  Visitor& visitor_;
+  int64_t block_size_;
+};
+
+}  // namespace internal
+
+/// VisitArrowBlocks resolves the runtime type of \p array once and then
+/// invokes Visitor::Call on successive typed spans of at most \p block_size
+/// values: ArrowBlock for numeric and temporal types, ArrowStringBlock for
+/// string-like types. Other types, and types outside the visitor's
+/// AcceptTypes, go to Visitor::AcceptFailed.
+///
+/// A block visitor looks like a VisitArrow visitor except that Call receives
+/// a block instead of the array and ResultType must be Result<void>;
+/// aggregation state lives in the visitor itself:
+///
+///     class SumVisitor : public ArrowVisitor {
+///     public:
+///       using ResultType = Result<void>;
+///       using AcceptTypes = std::tuple<AcceptNumericArrowTypes>;
+///
+///       template <typename ArrowType>
+///       ResultType Call(const ArrowBlock<typename ArrowType::c_type>& block) {
+///         for (int64_t i = 0; i < block.length; ++i) {
+///           if (block.IsValid(i)) {
+///             total += block.values[i];
+///           }
+///         }
+///         return ResultSuccess();
+///       }
+///
+///       ResultType AcceptFailed(const arrow::Array& array);
+///
+///       double total{};
+///     };
+template <typename Visitor>
+Result<void>
+VisitArrowBlocks(
+    Visitor&& visitor, const arrow::Array& array,
+    int64_t block_size = kArrowBlockSize) {
+  static_assert(
+      std::is_same_v<typename std::decay_t<Visitor>::ResultType, Result<void>>,
+      "block visitors must have ResultType Result<void>");
+  internal::BlockDispatcher<std::decay_t<Visitor>> dispatcher(
+      visitor, block_size);
+  return VisitArrow(dispatcher, array);
+}
+
+template <typename Visitor>
+Result<void>
+VisitArrowBlocks(
+    Visitor&& visitor, const arrow::ChunkedArray& array,
+    int64_t block_size = kArrowBlockSize) {
+  for (const auto& chunk : array.chunks()) {
+    KATANA_CHECKED(VisitArrowBlocks(visitor, *chunk, block_size));
+  }
+  return ResultSuccess();
+}
+
 /// Append a single scalar to a builder of compatible type
 /// Use of arrow::Scalar is often inefficient, consider alternatives
 KATANA_EXPORT Result<void> AppendToBuilder(
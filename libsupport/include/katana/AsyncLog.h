@@ -0,0 +1,47 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_ASYNCLOG_H_
+#define KATANA_LIBSUPPORT_KATANA_ASYNCLOG_H_
+
+#include <iosfwd>
+#include <string>
+
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// \file AsyncLog.h
+///
+/// Asynchronous backend for the KATANA_LOG_* macros. When the environment
+/// variable KATANA_ASYNC_LOG names a file, log records are appended to a
+/// per-thread lock-free ring buffer and a background thread drains the rings
+/// to that file in a binary format, so a call site costs a timestamp and a
+/// memcpy instead of a lock and a write(2). Records that arrive while a ring
+/// is full are dropped and counted rather than blocking the logging thread.
+///
+/// The binary file is rendered to text offline with RenderAsyncLog.
+
+namespace internal {
+
+/// Hand \p s to the asynchronous logger.
+///
+/// \returns true if the record was consumed (written or counted as
+/// dropped); false if asynchronous logging is not enabled and the caller
+/// should fall back to the synchronous path
+KATANA_EXPORT bool AsyncLogString(LogLevel level, const std::string& s);
+
+}  // namespace internal
+
+/// Drain all ring buffers to the log file and flush it. Called
+/// automatically at process exit; useful before a section where a crash is
+/// expected
+KATANA_EXPORT void FlushAsyncLog();
+
+/// Render the binary log file at \p input_path as text on \p out, sorted
+/// by record timestamp
+KATANA_EXPORT Result<void> RenderAsyncLog(
+    const std::string& input_path, std::ostream& out);
+
+}  // namespace katana
+
+#endif
@@ -19,6 +19,7 @@
 #include <boost/container_hash/hash.hpp>
 
 #include "katana/Logging.h"
+#include "katana/Metrics.h"
 
 namespace katana {
 
@@ -100,10 +101,18 @@ public:
     auto it = key_to_value_.find(key);
     if (it != key_to_value_.end()) {
       ret = UpdateLRU(it);
+      ++hits_;
+      hits_cell_->fetch_add(1, std::memory_order_relaxed);
+    } else {
+      ++misses_;
+      misses_cell_->fetch_add(1, std::memory_order_relaxed);
     }
     return ret;
   }
 
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
 private:
   Value UpdateLRU(typename MapType::iterator mapit) {
     auto lru_it = mapit->second.lru_it;
@@ -167,6 +176,17 @@ private:
   std::function<size_t(const Value& value)> value_to_bytes_;
   std::function<void(const Key& key, uint64_t approx_bytes, CallerPointer rdg)>
       evict_cb_;
+
+  // per-instance lookup outcomes plus the process-wide counters every
+  // cache shares, so live hit rates show up in the metrics registry
+  uint64_t hits_{0};
+  uint64_t misses_{0};
+  std::shared_ptr<std::atomic<uint64_t>> hits_cell_ =
+      MetricsRegistry::Get().RegisterCounter(
+          "katana_cache_hits", "Lookups served from a katana::Cache");
+  std::shared_ptr<std::atomic<uint64_t>> misses_cell_ =
+      MetricsRegistry::Get().RegisterCounter(
+          "katana_cache_misses", "Lookups that missed a katana::Cache");
 };
 
 }  // namespace katana
@@ -12,6 +12,15 @@ KATANA_EXPORT Result<void> HttpInit();
 KATANA_EXPORT Result<void> HttpGet(
     const std::string& url, std::vector<char>* response);
 
+/// Perform HTTP get requests for a batch of urls over pooled connections,
+/// multiplexing concurrent transfers where the server allows it. Entry i of
+/// responses receives the body for urls[i]. All transfers run to completion
+/// and the first failure is returned, so one missing object does not hide
+/// the others' results.
+KATANA_EXPORT Result<void> HttpGetMulti(
+    const std::vector<std::string>& urls,
+    std::vector<std::vector<char>>* responses);
+
 /// Perform an HTTP post request on url and send the contents of buffer
 KATANA_EXPORT Result<void> HttpPost(
     const std::string& url, const std::string& data,
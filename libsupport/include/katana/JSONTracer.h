@@ -13,6 +13,20 @@ namespace katana {
 
 using OutputCB = std::function<void(const std::string&)>;
 
+class JSONEmitter;
+
+/// Tracer that renders spans as JSON records.
+///
+/// Records pass through a bounded queue and are handed to the output
+/// callback in batches; KATANA_TRACE_BATCH sets the records per batch
+/// (default 1, i.e., emit immediately) and KATANA_TRACE_QUEUE bounds the
+/// queue (default 4096); records that arrive while the queue is full are
+/// dropped and counted rather than blocking the traced thread.
+///
+/// KATANA_TRACE_SAMPLE (0.0 to 1.0, default 1.0) enables head-based
+/// sampling: the decision is drawn once per trace when its root span
+/// starts, child spans inherit it, and spans of unsampled traces skip ID
+/// generation and all rendering.
 class KATANA_EXPORT JSONTracer : public ProgressTracer {
 public:
   static std::unique_ptr<JSONTracer> Make(
@@ -27,16 +41,16 @@ public:
   std::unique_ptr<ProgressContext> Extract(const std::string& carrier) override;
 
 private:
-  JSONTracer(uint32_t host_id, uint32_t num_hosts, OutputCB out_callback)
-      : ProgressTracer(host_id, num_hosts), out_callback_(out_callback) {}
+  JSONTracer(uint32_t host_id, uint32_t num_hosts, OutputCB out_callback);
 
   std::shared_ptr<ProgressSpan> StartSpan(
       const std::string& span_name,
       std::shared_ptr<ProgressSpan> child_of) override;
 
-  void Close() override {}
+  void Close() override;
 
-  OutputCB out_callback_;
+  std::shared_ptr<JSONEmitter> emitter_;
+  double sample_rate_{1.0};
 };
 
 class KATANA_EXPORT JSONContext : public ProgressContext {
@@ -44,16 +58,20 @@ public:
   std::unique_ptr<ProgressContext> Clone() const noexcept override;
   std::string GetTraceID() const noexcept override { return trace_id_; }
   std::string GetSpanID() const noexcept override { return span_id_; }
+  bool sampled() const noexcept { return sampled_; }
 
 private:
   friend class JSONTracer;
   friend class JSONSpan;
 
-  JSONContext(const std::string& trace_id, const std::string& span_id)
-      : trace_id_(trace_id), span_id_(span_id) {}
+  JSONContext(
+      const std::string& trace_id, const std::string& span_id,
+      bool sampled = true)
+      : trace_id_(trace_id), span_id_(span_id), sampled_(sampled) {}
 
   std::string trace_id_;
   std::string span_id_;
+  bool sampled_{true};
 };
 
 class KATANA_EXPORT JSONSpan : public ProgressSpan {
@@ -73,21 +91,22 @@ private:
 
   JSONSpan(
       const std::string& span_name, std::shared_ptr<ProgressSpan> parent,
-      OutputCB out_callback);
+      std::shared_ptr<JSONEmitter> emitter, bool sampled);
   JSONSpan(
       const std::string& span_name, const ProgressContext& parent,
-      OutputCB out_callback);
+      std::shared_ptr<JSONEmitter> emitter);
   static std::shared_ptr<ProgressSpan> Make(
       const std::string& span_name, std::shared_ptr<ProgressSpan> parent,
-      OutputCB out_callback);
+      std::shared_ptr<JSONEmitter> emitter, bool sampled);
   static std::shared_ptr<ProgressSpan> Make(
       const std::string& span_name, const ProgressContext& parent,
-      OutputCB out_callback);
+      std::shared_ptr<JSONEmitter> emitter);
 
   void Close() override;
 
   JSONContext context_;
-  OutputCB out_callback_;
+  std::shared_ptr<JSONEmitter> emitter_;
+  bool sampled_{true};
 };
 
 }  // namespace katana
@@ -0,0 +1,101 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_MEMORYTELEMETRY_H_
+#define KATANA_LIBSUPPORT_KATANA_MEMORYTELEMETRY_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// Per-NUMA-node allocation counters as exposed by the kernel's numastat
+/// (/sys/devices/system/node/node*/numastat); values are page counts.
+struct KATANA_EXPORT NumaAllocStats {
+  uint64_t numa_hit{0};
+  uint64_t numa_miss{0};
+  uint64_t numa_foreign{0};
+  uint64_t local_node{0};
+  uint64_t other_node{0};
+};
+
+/// Per-socket DRAM traffic measured at the integrated memory controller.
+struct KATANA_EXPORT SocketTrafficStats {
+  uint64_t read_bytes{0};
+  uint64_t write_bytes{0};
+};
+
+/// MemoryTelemetry samples per-socket memory-controller (uncore IMC)
+/// traffic and per-node allocation statistics, and attributes the deltas
+/// to phases of a run through the ProgressTracer. The resulting
+/// JSONTracer records say whether a workload was bandwidth-bound and how
+/// much of its traffic crossed sockets, which is the data needed to pick
+/// machine shapes per workload.
+///
+/// Collection is opt-in through the KATANA_MEMORY_TELEMETRY environment
+/// variable. The numastat side works on any Linux; the IMC side needs
+/// the uncore PMUs to be readable (perf_event_paranoid) and degrades to
+/// empty socket stats when they are not.
+class KATANA_EXPORT MemoryTelemetry {
+public:
+  struct Sample {
+    std::vector<NumaAllocStats> nodes;
+    /// One entry per socket; empty when the IMC counters are unreadable.
+    std::vector<SocketTrafficStats> sockets;
+    std::chrono::steady_clock::time_point taken;
+  };
+
+  static MemoryTelemetry& Get();
+
+  /// True when collection was requested via KATANA_MEMORY_TELEMETRY.
+  static bool Enabled();
+
+  MemoryTelemetry(const MemoryTelemetry&) = delete;
+  MemoryTelemetry(MemoryTelemetry&&) = delete;
+  MemoryTelemetry& operator=(const MemoryTelemetry&) = delete;
+  MemoryTelemetry& operator=(MemoryTelemetry&&) = delete;
+
+  /// Read the current counter values; cheap enough to call around each
+  /// phase of a run.
+  Sample Snapshot();
+
+  /// PhaseScope snapshots the counters at construction and logs the
+  /// deltas -- local/remote allocation pages, per-socket DRAM read and
+  /// write volume, and achieved bandwidth -- to the active ProgressSpan
+  /// when it goes out of scope. A no-op unless telemetry is enabled.
+  class KATANA_EXPORT PhaseScope {
+  public:
+    explicit PhaseScope(std::string phase_name);
+    ~PhaseScope();
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope(PhaseScope&&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+    PhaseScope& operator=(PhaseScope&&) = delete;
+
+  private:
+    std::string phase_name_;
+    Sample begin_;
+  };
+
+private:
+  MemoryTelemetry();
+  ~MemoryTelemetry();
+
+  void OpenImcCounters();
+
+  // one perf fd per (IMC channel, socket, direction); counts are summed
+  // into per-socket totals at snapshot time
+  struct ImcEvent {
+    int fd{-1};
+    size_t socket{0};
+    bool write{false};
+  };
+  std::vector<ImcEvent> imc_events_;
+  size_t num_sockets_{0};
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_METRICS_H_
+#define KATANA_LIBSUPPORT_KATANA_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Process-wide registry of live metrics, rendered on demand in
+/// OpenMetrics text format. StatManager and the ProgressTracer only
+/// produce end-of-run output; the registry is what lets an operator see
+/// inside a running job. Components register counters and gauges at
+/// startup and \ref MetricsExporter serves the rendered snapshot over
+/// HTTP for Prometheus-style scraping.
+///
+/// Counters are shared atomic cells so hot paths pay one relaxed
+/// fetch_add; gauges are callbacks read at render time so values that
+/// already exist elsewhere (pool occupancy, thread counts) are not
+/// mirrored.
+class KATANA_EXPORT MetricsRegistry {
+public:
+  static MetricsRegistry& Get();
+
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry(MetricsRegistry&&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+  /// Register a monotonic counter named \p name ("_total" is appended to
+  /// the samples at render time per OpenMetrics). Returns the cell to
+  /// increment; registering the same name again returns the same cell, so
+  /// translation units can share a counter without coordinating.
+  std::shared_ptr<std::atomic<uint64_t>> RegisterCounter(
+      const std::string& name, const std::string& help);
+
+  /// Register a gauge whose value is read by calling \p read at render
+  /// time. The callback must be safe to call from the exporter thread at
+  /// any point after registration.
+  void RegisterGauge(
+      const std::string& name, const std::string& help,
+      std::function<double()> read);
+
+  /// Register a callback that appends fully formed OpenMetrics lines
+  /// (including # HELP / # TYPE) to \p out; the escape hatch for labeled
+  /// families like per-socket or per-node series that the scalar
+  /// registrations above cannot express.
+  void RegisterFamily(std::function<void(std::string* out)> render);
+
+  /// Render every registered metric as an OpenMetrics exposition,
+  /// terminated by "# EOF".
+  std::string Render();
+
+private:
+  MetricsRegistry() = default;
+
+  struct Counter {
+    std::string name;
+    std::string help;
+    std::shared_ptr<std::atomic<uint64_t>> cell;
+  };
+  struct Gauge {
+    std::string name;
+    std::string help;
+    std::function<double()> read;
+  };
+
+  std::mutex lock_;
+  std::vector<Counter> counters_;
+  std::vector<Gauge> gauges_;
+  std::vector<std::function<void(std::string*)>> families_;
+};
+
+/// Serves MetricsRegistry snapshots over HTTP so existing
+/// Prometheus/OpenMetrics alerting can watch a running job. Enabled by
+/// setting KATANA_METRICS_PORT (\see SharedMemSys); every GET on that
+/// port, whatever the path, answers with the current exposition. The
+/// listener is a single plain-socket thread -- a scrape every few
+/// seconds does not justify a server dependency.
+class KATANA_EXPORT MetricsExporter {
+public:
+  static MetricsExporter& Get();
+
+  MetricsExporter(const MetricsExporter&) = delete;
+  MetricsExporter(MetricsExporter&&) = delete;
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+  MetricsExporter& operator=(MetricsExporter&&) = delete;
+
+  /// Bind \p port and start answering scrapes on a background thread.
+  Result<void> Start(uint16_t port);
+
+  /// Start on KATANA_METRICS_PORT if it is set; failures are logged and
+  /// ignored so a bad port does not take down the job it was meant to
+  /// observe.
+  void StartIfRequested();
+
+  /// Stop the listener and join its thread; no-op if not running.
+  void Stop();
+
+  bool running() const { return listen_fd_.load() >= 0; }
+
+private:
+  MetricsExporter() = default;
+
+  void Serve();
+
+  // the exporter thread reads this while Stop writes it
+  std::atomic<int> listen_fd_{-1};
+  std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace katana
+
+#endif
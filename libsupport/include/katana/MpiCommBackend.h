@@ -0,0 +1,30 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_MPICOMMBACKEND_H_
+#define KATANA_LIBSUPPORT_KATANA_MPICOMMBACKEND_H_
+
+#include <memory>
+
+#include "katana/CommBackend.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// \returns true if this build can create an MPI-backed CommBackend
+KATANA_EXPORT bool HaveMpiCommBackend();
+
+/// Create a CommBackend driving MPI_COMM_WORLD, suitable for passing to
+/// tsuba::Init so every host of an MPI job coordinates storage operations.
+///
+/// If MPI has not been initialized yet it is initialized here (with
+/// MPI_THREAD_FUNNELED) and finalized again when the backend is destroyed;
+/// a caller that initialized MPI itself keeps ownership of finalization.
+/// LocalRank is the rank within the shared-memory node, from
+/// MPI_Comm_split_type.
+///
+/// Fails with ErrorCode::NotImplemented when katana was built without MPI
+/// support.
+KATANA_EXPORT Result<std::unique_ptr<CommBackend>> MakeMpiCommBackend();
+
+}  // namespace katana
+
+#endif
@@ -93,6 +93,7 @@ using Tags = std::vector<std::pair<std::string, Value>>;
 struct HostStats {
   long nprocs{};
   long ram_gb{};
+  long numa_nodes{};
   std::string hostname;
   long pid{};
 };
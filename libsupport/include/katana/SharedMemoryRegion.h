@@ -0,0 +1,79 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_SHAREDMEMORYREGION_H_
+#define KATANA_LIBSUPPORT_KATANA_SHAREDMEMORYREGION_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A named POSIX shared-memory segment (shm_open + mmap). The creating
+/// process maps it read-write and fills it in; any number of reader
+/// processes then Open() the same name and map one physical copy of the
+/// pages. The segment outlives its creator until Unlink() removes the
+/// name, so a writer can populate a graph once and exit while readers keep
+/// using it.
+///
+/// Instances only own their own mapping; destroying one unmaps but does
+/// not remove the named segment.
+class KATANA_EXPORT SharedMemoryRegion {
+public:
+  SharedMemoryRegion() = default;
+
+  SharedMemoryRegion(SharedMemoryRegion&& other) noexcept
+      : name_(std::move(other.name_)),
+        ptr_(std::exchange(other.ptr_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  SharedMemoryRegion& operator=(SharedMemoryRegion&& other) noexcept {
+    if (this != &other) {
+      Unmap();
+      name_ = std::move(other.name_);
+      ptr_ = std::exchange(other.ptr_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+  ~SharedMemoryRegion() { Unmap(); }
+
+  /// Create a new segment of \p size bytes and map it read-write. \p name
+  /// follows shm_open conventions ("/katana-foo"); it is an error if a
+  /// segment with that name already exists.
+  static Result<SharedMemoryRegion> Create(
+      const std::string& name, size_t size);
+
+  /// Map an existing segment read-only; its size is whatever the creator
+  /// set.
+  static Result<SharedMemoryRegion> Open(const std::string& name);
+
+  /// Remove the name so the segment is freed once the last mapping goes
+  /// away. Existing mappings remain valid.
+  static Result<void> Unlink(const std::string& name);
+
+  uint8_t* data() { return ptr_; }
+  const uint8_t* data() const { return ptr_; }
+  size_t size() const { return size_; }
+  const std::string& name() const { return name_; }
+  bool valid() const { return ptr_ != nullptr; }
+
+private:
+  SharedMemoryRegion(std::string name, uint8_t* ptr, size_t size)
+      : name_(std::move(name)), ptr_(ptr), size_(size) {}
+
+  void Unmap();
+
+  std::string name_;
+  uint8_t* ptr_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace katana
+
+#endif
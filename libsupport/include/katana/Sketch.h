@@ -0,0 +1,210 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_SKETCH_H_
+#define KATANA_LIBSUPPORT_KATANA_SKETCH_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "katana/Logging.h"
+#include "katana/Random.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Finalizer from splitmix64. The sketches hash their inputs themselves so
+/// callers can feed dense ids directly; the finalizer spreads them over the
+/// full 64-bit space.
+inline uint64_t
+SketchHash(uint64_t x) {
+  x ^= x >> 30;
+  x *= UINT64_C(0xBF58476D1CE4E5B9);
+  x ^= x >> 27;
+  x *= UINT64_C(0x94D049BB133111EB);
+  x ^= x >> 31;
+  return x;
+}
+
+/// HyperLogLog distinct-count sketch.
+///
+/// Counts distinct 64-bit keys in (1 << log2_registers) bytes with a
+/// relative error around 1.04 / sqrt(num registers) -- about 1.6% at the
+/// default size -- instead of the unbounded memory of an exact hash set.
+/// Two sketches of the same size merge losslessly by taking the elementwise
+/// register maximum (a plain loop over contiguous bytes, so it vectorizes),
+/// which is what makes it usable as a per-thread reducer.
+class KATANA_EXPORT HyperLogLog {
+public:
+  explicit HyperLogLog(uint32_t log2_registers = 12)
+      : log2_registers_(log2_registers),
+        registers_(size_t{1} << log2_registers, 0) {
+    KATANA_LOG_DEBUG_ASSERT(log2_registers >= 4 && log2_registers <= 18);
+  }
+
+  void Add(uint64_t key) {
+    const uint64_t hash = SketchHash(key);
+    const uint64_t index = hash >> (64 - log2_registers_);
+    // rank of the first set bit in the remaining hash bits; the sentinel
+    // keeps clz defined when they are all zero
+    const uint64_t rest = (hash << log2_registers_) | (uint64_t{1} << (log2_registers_ - 1));
+    const uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  void Merge(const HyperLogLog& other) {
+    KATANA_LOG_DEBUG_ASSERT(log2_registers_ == other.log2_registers_);
+    for (size_t i = 0; i < registers_.size(); ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  /// Approximate number of distinct keys added
+  double Estimate() const {
+    const double m = static_cast<double>(registers_.size());
+    double inverse_sum = 0.0;
+    uint64_t zero_registers = 0;
+    for (uint8_t reg : registers_) {
+      inverse_sum += std::ldexp(1.0, -static_cast<int>(reg));
+      zero_registers += (reg == 0) ? 1 : 0;
+    }
+    const double alpha = 0.7213 / (1.0 + 1.079 / m);
+    const double raw = alpha * m * m / inverse_sum;
+    if (raw <= 2.5 * m && zero_registers > 0) {
+      // small-range correction: linear counting over empty registers
+      return m * std::log(m / static_cast<double>(zero_registers));
+    }
+    return raw;
+  }
+
+private:
+  uint32_t log2_registers_;
+  std::vector<uint8_t> registers_;
+};
+
+/// Count-min frequency sketch.
+///
+/// Approximates per-key occurrence counts in depth * width counters; counts
+/// are never underestimated and overestimate by at most (2 / width) of the
+/// total count with probability 1 - 0.5^depth. Sketches of equal shape merge
+/// by elementwise addition of the counter arrays (contiguous and
+/// branch-free, so the loop vectorizes).
+class KATANA_EXPORT CountMinSketch {
+public:
+  explicit CountMinSketch(uint32_t log2_width = 14, uint32_t depth = 4)
+      : log2_width_(log2_width),
+        depth_(depth),
+        counters_(depth * (size_t{1} << log2_width), 0) {
+    KATANA_LOG_DEBUG_ASSERT(depth >= 1 && log2_width >= 4);
+  }
+
+  void Add(uint64_t key, uint64_t count = 1) {
+    const size_t width = size_t{1} << log2_width_;
+    for (uint32_t row = 0; row < depth_; ++row) {
+      counters_[row * width + RowIndex(key, row)] += count;
+    }
+  }
+
+  /// Approximate number of times key was added; never an underestimate
+  uint64_t Count(uint64_t key) const {
+    const size_t width = size_t{1} << log2_width_;
+    uint64_t result = std::numeric_limits<uint64_t>::max();
+    for (uint32_t row = 0; row < depth_; ++row) {
+      result = std::min(result, counters_[row * width + RowIndex(key, row)]);
+    }
+    return result;
+  }
+
+  void Merge(const CountMinSketch& other) {
+    KATANA_LOG_DEBUG_ASSERT(
+        log2_width_ == other.log2_width_ && depth_ == other.depth_);
+    for (size_t i = 0; i < counters_.size(); ++i) {
+      counters_[i] += other.counters_[i];
+    }
+  }
+
+private:
+  size_t RowIndex(uint64_t key, uint32_t row) const {
+    // golden-ratio row salts keep the rows' hash functions independent
+    const uint64_t salt = (row + 1) * UINT64_C(0x9E3779B97F4A7C15);
+    return SketchHash(key ^ salt) >> (64 - log2_width_);
+  }
+
+  uint32_t log2_width_;
+  uint32_t depth_;
+  std::vector<uint64_t> counters_;
+};
+
+/// Fixed-capacity uniform sample of a stream (algorithm R).
+///
+/// Keeps each item seen so far with probability capacity / items_seen.
+/// Merging weighs the two samples by how many items each represents, so
+/// per-thread reservoirs combine into one that is still close to a uniform
+/// sample of the whole stream.
+template <typename T>
+class ReservoirSample {
+public:
+  explicit ReservoirSample(size_t capacity = 1024) : capacity_(capacity) {
+    KATANA_LOG_DEBUG_ASSERT(capacity > 0);
+    sample_.reserve(capacity);
+  }
+
+  void Add(const T& item) {
+    ++items_seen_;
+    if (sample_.size() < capacity_) {
+      sample_.push_back(item);
+      return;
+    }
+    std::uniform_int_distribution<uint64_t> dist(0, items_seen_ - 1);
+    const uint64_t slot = dist(GetGenerator());
+    if (slot < capacity_) {
+      sample_[slot] = item;
+    }
+  }
+
+  void Merge(const ReservoirSample& other) {
+    KATANA_LOG_DEBUG_ASSERT(capacity_ == other.capacity_);
+    if (other.items_seen_ == 0) {
+      return;
+    }
+    if (items_seen_ == 0) {
+      *this = other;
+      return;
+    }
+    // draw each output slot from one side with probability proportional to
+    // the number of stream items that side represents
+    auto& gen = GetGenerator();
+    std::vector<T> lhs = std::move(sample_);
+    std::vector<T> rhs = other.sample_;
+    std::shuffle(lhs.begin(), lhs.end(), gen);
+    std::shuffle(rhs.begin(), rhs.end(), gen);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    const double lhs_weight = static_cast<double>(items_seen_) /
+                              static_cast<double>(items_seen_ + other.items_seen_);
+    sample_.clear();
+    size_t lhs_next = 0;
+    size_t rhs_next = 0;
+    while (sample_.size() < capacity_ &&
+           (lhs_next < lhs.size() || rhs_next < rhs.size())) {
+      const bool take_lhs =
+          rhs_next >= rhs.size() ||
+          (lhs_next < lhs.size() && coin(gen) < lhs_weight);
+      sample_.push_back(take_lhs ? lhs[lhs_next++] : rhs[rhs_next++]);
+    }
+    items_seen_ += other.items_seen_;
+  }
+
+  const std::vector<T>& sample() const { return sample_; }
+  uint64_t items_seen() const { return items_seen_; }
+  size_t capacity() const { return capacity_; }
+
+private:
+  size_t capacity_;
+  uint64_t items_seen_{0};
+  std::vector<T> sample_;
+};
+
+}  // namespace katana
+
+#endif
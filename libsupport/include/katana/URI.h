@@ -1,6 +1,7 @@
 #ifndef KATANA_LIBSUPPORT_KATANA_URI_H_
 #define KATANA_LIBSUPPORT_KATANA_URI_H_
 
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -12,12 +13,25 @@
 namespace katana {
 
 class KATANA_EXPORT Uri {
-  std::string scheme_;
-  std::string path_;
-  std::string string_;
+  /// Immutable parsed form of a URI. Equal URIs constructed while another
+  /// copy is alive share one Interned through the process-wide intern table,
+  /// so copying a Uri updates a reference count instead of copying three
+  /// strings.
+  struct Interned {
+    std::string scheme;
+    std::string path;
+    std::string string;
+  };
+
+  std::shared_ptr<const Interned> interned_;
 
   Uri(std::string scheme, std::string path);
 
+  static std::shared_ptr<const Interned> Intern(
+      std::string scheme, std::string path);
+
+  const Interned& Data() const;
+
 public:
   static constexpr const char kSepChar = '/';
   static constexpr const char* kFileScheme = "file";
@@ -35,11 +49,11 @@ public:
   /// Return the base64 (url variant) encoded version of this uri
   std::string Encode() const;
 
-  const std::string& scheme() const { return scheme_; }
-  const std::string& path() const { return path_; }
-  const std::string& string() const { return string_; }
+  const std::string& scheme() const { return Data().scheme; }
+  const std::string& path() const { return Data().path; }
+  const std::string& string() const { return Data().string; }
 
-  bool empty() const;
+  bool empty() const { return !interned_; }
 
   // it's convenient to treat URIs like paths sometimes
   Uri DirName() const;
@@ -1,10 +1,14 @@
 #include "katana/ArrowInterchange.h"
 
+#include <atomic>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 #include <arrow/array/concatenate.h>
+#include <arrow/c/bridge.h>
 
 #include "katana/Random.h"
 
@@ -46,6 +50,141 @@ ApproxArrayDataMemUse(const std::shared_ptr<arrow::ArrayData>& data) {
   return total_mem_use;
 }
 
+template <typename T>
+T
+SaturatingAdd(T a, T b) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return a + b;
+  } else {
+    T out;
+    if (__builtin_add_overflow(a, b, &out)) {
+      if constexpr (std::is_signed_v<T>) {
+        out = a < 0 ? std::numeric_limits<T>::min()
+                    : std::numeric_limits<T>::max();
+      } else {
+        out = std::numeric_limits<T>::max();
+      }
+    }
+    return out;
+  }
+}
+
+struct SaturatingAddVisitor : public katana::ArrowVisitor {
+  const arrow::Array& untyped_b;
+
+  SaturatingAddVisitor(const arrow::Array& b) : untyped_b(b) {}
+
+  using ResultType = katana::Result<std::shared_ptr<arrow::Array>>;
+
+  using AcceptTypes = std::tuple<katana::AcceptNumericArrowTypes>;
+
+  template <typename ArrowType, typename ArrayType>
+  ResultType Call(const ArrayType& a) {
+    using CType = typename ArrowType::c_type;
+    // BulkSaturatingAdd checked that both arrays have the same type
+    const auto& b = static_cast<const ArrayType&>(untyped_b);
+    const CType* pa = a.raw_values();
+    const CType* pb = b.raw_values();
+    const int64_t length = a.length();
+    std::shared_ptr<arrow::Buffer> values =
+        KATANA_CHECKED(arrow::AllocateBuffer(length * int64_t{sizeof(CType)}));
+    CType* dst = reinterpret_cast<CType*>(values->mutable_data());
+    for (int64_t i = 0; i < length; ++i) {
+      dst[i] = SaturatingAdd(pa[i], pb[i]);
+    }
+
+    std::shared_ptr<arrow::Buffer> validity;
+    int64_t null_count = 0;
+    if (a.null_count() > 0 || b.null_count() > 0) {
+      validity = KATANA_CHECKED(arrow::AllocateEmptyBitmap(length));
+      uint8_t* out = validity->mutable_data();
+      for (int64_t i = 0; i < length; ++i) {
+        if (a.IsValid(i) && b.IsValid(i)) {
+          arrow::BitUtil::SetBit(out, i);
+        } else {
+          ++null_count;
+        }
+      }
+    }
+    return arrow::MakeArray(arrow::ArrayData::Make(
+        arrow::TypeTraits<ArrowType>::type_singleton(), length,
+        {std::move(validity), std::move(values)}, null_count));
+  }
+
+  ResultType AcceptFailed(const arrow::Array& a) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "cannot saturating-add {}",
+        a.type()->name());
+  }
+};
+
+struct GatherVisitor : public katana::ArrowVisitor {
+  using ResultType = katana::Result<std::shared_ptr<arrow::Array>>;
+
+  using AcceptIndexTypes = std::tuple<
+      arrow::Int32Type, arrow::UInt32Type, arrow::Int64Type, arrow::UInt64Type>;
+  using AcceptTypes =
+      std::tuple<katana::AcceptNumericArrowTypes, AcceptIndexTypes>;
+
+  template <
+      typename ValueArrowType, typename IndexArrowType, typename ValueArrayType,
+      typename IndexArrayType>
+  ResultType Call(const ValueArrayType& values, const IndexArrayType& indices) {
+    using CType = typename ValueArrowType::c_type;
+    using IndexCType = typename IndexArrowType::c_type;
+    const CType* src = values.raw_values();
+    const IndexCType* idx = indices.raw_values();
+    const int64_t length = indices.length();
+    const uint64_t num_values = values.length();
+    std::shared_ptr<arrow::Buffer> out_values =
+        KATANA_CHECKED(arrow::AllocateBuffer(length * int64_t{sizeof(CType)}));
+    CType* dst = reinterpret_cast<CType*>(out_values->mutable_data());
+
+    std::shared_ptr<arrow::Buffer> validity;
+    int64_t null_count = 0;
+    if (values.null_count() == 0 && indices.null_count() == 0) {
+      for (int64_t i = 0; i < length; ++i) {
+        if (static_cast<uint64_t>(idx[i]) >= num_values) {
+          return KATANA_ERROR(
+              katana::ErrorCode::InvalidArgument,
+              "gather index {} out of range [0, {})", idx[i], num_values);
+        }
+        dst[i] = src[idx[i]];
+      }
+    } else {
+      validity = KATANA_CHECKED(arrow::AllocateEmptyBitmap(length));
+      uint8_t* out = validity->mutable_data();
+      for (int64_t i = 0; i < length; ++i) {
+        if (!indices.IsValid(i)) {
+          ++null_count;
+          continue;
+        }
+        if (static_cast<uint64_t>(idx[i]) >= num_values) {
+          return KATANA_ERROR(
+              katana::ErrorCode::InvalidArgument,
+              "gather index {} out of range [0, {})", idx[i], num_values);
+        }
+        if (!values.IsValid(idx[i])) {
+          ++null_count;
+          continue;
+        }
+        arrow::BitUtil::SetBit(out, i);
+        dst[i] = src[idx[i]];
+      }
+    }
+    return arrow::MakeArray(arrow::ArrayData::Make(
+        arrow::TypeTraits<ValueArrowType>::type_singleton(), length,
+        {std::move(validity), std::move(out_values)}, null_count));
+  }
+
+  ResultType AcceptFailed(
+      const arrow::Array& values, const arrow::Array& indices) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "cannot gather {} by {}",
+        values.type()->name(), indices.type()->name());
+  }
+};
+
 }  // anonymous namespace
 
 std::shared_ptr<arrow::ChunkedArray>
@@ -119,6 +258,32 @@ katana::ApproxArrayMemUse(const std::shared_ptr<arrow::Array>& array) {
   return ApproxArrayDataMemUse(array->data());
 }
 
+katana::Result<std::shared_ptr<arrow::Array>>
+katana::BulkSaturatingAdd(
+    const std::shared_ptr<arrow::Array>& a,
+    const std::shared_ptr<arrow::Array>& b) {
+  if (!a->type()->Equals(*b->type())) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "mismatched types {} and {}",
+        a->type()->name(), b->type()->name());
+  }
+  if (a->length() != b->length()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "mismatched lengths {} and {}",
+        a->length(), b->length());
+  }
+  SaturatingAddVisitor visitor(*b);
+  return katana::VisitArrow(visitor, *a);
+}
+
+katana::Result<std::shared_ptr<arrow::Array>>
+katana::BulkGather(
+    const std::shared_ptr<arrow::Array>& values,
+    const std::shared_ptr<arrow::Array>& indices) {
+  GatherVisitor visitor;
+  return katana::VisitArrow(visitor, *values, *indices);
+}
+
 uint64_t
 katana::ApproxTableMemUse(const std::shared_ptr<arrow::Table>& table) {
   uint64_t total_mem_use = 0;
@@ -129,3 +294,52 @@ katana::ApproxTableMemUse(const std::shared_ptr<arrow::Table>& table) {
   }
   return total_mem_use;
 }
+
+katana::Result<void>
+katana::ExportChunkedArray(
+    const std::shared_ptr<arrow::ChunkedArray>& chunked,
+    struct ArrowArray* out_array, struct ArrowSchema* out_schema) {
+  std::shared_ptr<arrow::Array> array;
+  if (chunked->num_chunks() == 1) {
+    array = chunked->chunk(0);
+  } else if (chunked->num_chunks() == 0) {
+    auto maybe_empty = arrow::MakeArrayOfNull(chunked->type(), 0);
+    if (!maybe_empty.ok()) {
+      return KATANA_ERROR(
+          ErrorCode::ArrowError, "making empty array: {}",
+          maybe_empty.status().ToString());
+    }
+    array = maybe_empty.ValueUnsafe();
+  } else {
+    auto maybe_combined = arrow::Concatenate(chunked->chunks());
+    if (!maybe_combined.ok()) {
+      return KATANA_ERROR(
+          ErrorCode::ArrowError, "consolidating {} chunks: {}",
+          chunked->num_chunks(), maybe_combined.status().ToString());
+    }
+    array = maybe_combined.ValueUnsafe();
+  }
+  auto status = arrow::ExportArray(*array, out_array, out_schema);
+  if (!status.ok()) {
+    return KATANA_ERROR(
+        ErrorCode::ArrowError, "exporting array: {}", status.ToString());
+  }
+  return ResultSuccess();
+}
+
+namespace {
+
+std::atomic<arrow::MemoryPool*> active_arrow_pool{nullptr};
+
+}  // anonymous namespace
+
+arrow::MemoryPool*
+katana::GetArrowMemoryPool() {
+  arrow::MemoryPool* pool = active_arrow_pool.load(std::memory_order_acquire);
+  return pool != nullptr ? pool : arrow::default_memory_pool();
+}
+
+void
+katana::SetArrowMemoryPool(arrow::MemoryPool* pool) {
+  active_arrow_pool.store(pool, std::memory_order_release);
+}
@@ -0,0 +1,321 @@
+#include "katana/AsyncLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include "katana/Env.h"
+#include "katana/ErrorCode.h"
+
+namespace {
+
+// "KLG1"; bumped if the record layout changes
+constexpr uint32_t kMagic = 0x4b4c4731;
+constexpr uint32_t kVersion = 1;
+
+constexpr uint64_t kRingBytes = UINT64_C(1) << 20;
+
+// timestamp (8) + level (1) + thread (4) + payload size (4); fields are
+// memcpy'd in host byte order, the render step runs on the same machine
+constexpr uint64_t kHeaderBytes = 17;
+
+constexpr auto kDrainInterval = std::chrono::milliseconds(1);
+
+uint64_t
+Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+const char*
+LevelName(uint8_t level) {
+  switch (static_cast<katana::LogLevel>(level)) {
+  case katana::LogLevel::Debug:
+    return "DEBUG";
+  case katana::LogLevel::Verbose:
+    return "VERBOSE";
+  case katana::LogLevel::Warning:
+    return "WARNING";
+  case katana::LogLevel::Error:
+    return "ERROR";
+  default:
+    return "UNKNOWN LOG LEVEL";
+  }
+}
+
+/// Single-producer (the owning thread) single-consumer (the drain thread)
+/// byte ring. head_ and tail_ are free-running; the producer publishes a
+/// record by advancing head_ only after the record's bytes are in place, so
+/// the consumer always sees whole records.
+class Ring {
+public:
+  explicit Ring(uint32_t thread)
+      : thread_(thread), data_(new uint8_t[kRingBytes]) {}
+
+  /// Append one record; drops it (and counts the drop) when the ring is
+  /// full rather than blocking the logging thread
+  void Push(uint8_t level, const std::string& s) {
+    uint64_t need = kHeaderBytes + s.size();
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (need > kRingBytes - (head - tail)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    uint8_t header[kHeaderBytes];
+    uint64_t timestamp = Now();
+    uint32_t size = static_cast<uint32_t>(s.size());
+    std::memcpy(&header[0], &timestamp, 8);
+    header[8] = level;
+    std::memcpy(&header[9], &thread_, 4);
+    std::memcpy(&header[13], &size, 4);
+    Write(head, header, kHeaderBytes);
+    Write(head + kHeaderBytes, s.data(), s.size());
+    head_.store(head + need, std::memory_order_release);
+  }
+
+  /// Copy everything published since the last drain to \p out
+  void Drain(std::FILE* out, std::vector<uint8_t>* staging) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return;
+    }
+    uint64_t size = head - tail;
+    staging->resize(size);
+    uint64_t off = tail % kRingBytes;
+    uint64_t first = std::min(size, kRingBytes - off);
+    std::memcpy(staging->data(), &data_[off], first);
+    std::memcpy(staging->data() + first, &data_[0], size - first);
+    std::fwrite(staging->data(), 1, size, out);
+    tail_.store(head, std::memory_order_release);
+  }
+
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  void Write(uint64_t pos, const void* src, uint64_t size) {
+    uint64_t off = pos % kRingBytes;
+    uint64_t first = std::min(size, kRingBytes - off);
+    std::memcpy(&data_[off], src, first);
+    std::memcpy(
+        &data_[0], static_cast<const uint8_t*>(src) + first, size - first);
+  }
+
+  uint32_t thread_;
+  std::unique_ptr<uint8_t[]> data_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+
+class Sink {
+public:
+  /// The process-wide sink, or null when KATANA_ASYNC_LOG is not set. The
+  /// sink is deliberately leaked; its drain thread is stopped and the file
+  /// flushed by an atexit handler
+  static Sink* Get() {
+    static Sink* sink = MakeFromEnv();
+    return sink;
+  }
+
+  bool active() const { return active_.load(std::memory_order_acquire); }
+
+  void Log(uint8_t level, const std::string& s) { MyRing()->Push(level, s); }
+
+  void Flush() {
+    std::vector<uint8_t> staging;
+    DrainAll(&staging);
+    std::fflush(out_);
+  }
+
+  void Shutdown() {
+    stop_.store(true, std::memory_order_release);
+    drainer_.join();
+    Flush();
+    active_.store(false, std::memory_order_release);
+    uint64_t dropped = 0;
+    {
+      std::lock_guard<std::mutex> guard(rings_lock_);
+      for (const auto& ring : rings_) {
+        dropped += ring->dropped();
+      }
+    }
+    if (dropped > 0) {
+      std::fprintf(
+          stderr, "WARNING: async log dropped %llu records\n",
+          static_cast<unsigned long long>(dropped));
+    }
+  }
+
+private:
+  explicit Sink(std::FILE* out) : out_(out) {
+    drainer_ = std::thread([this]() { DrainLoop(); });
+  }
+
+  static Sink* MakeFromEnv() {
+    std::string path;
+    if (!katana::GetEnv("KATANA_ASYNC_LOG", &path)) {
+      return nullptr;
+    }
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+      // the logger is not up; this is the one place stderr is used directly
+      std::fprintf(
+          stderr, "WARNING: cannot open async log file %s\n", path.c_str());
+      return nullptr;
+    }
+    std::fwrite(&kMagic, sizeof(kMagic), 1, out);
+    std::fwrite(&kVersion, sizeof(kVersion), 1, out);
+    Sink* sink = new Sink(out);
+    std::atexit([]() { Get()->Shutdown(); });
+    return sink;
+  }
+
+  Ring* MyRing() {
+    thread_local Ring* ring = nullptr;
+    if (ring == nullptr) {
+      std::lock_guard<std::mutex> guard(rings_lock_);
+      rings_.emplace_back(std::make_unique<Ring>(next_thread_++));
+      ring = rings_.back().get();
+    }
+    return ring;
+  }
+
+  void DrainAll(std::vector<uint8_t>* staging) {
+    // one consumer at a time; producers only take rings_lock_ briefly on
+    // their first record
+    std::lock_guard<std::mutex> drain_guard(drain_lock_);
+    std::vector<Ring*> rings;
+    {
+      std::lock_guard<std::mutex> guard(rings_lock_);
+      rings.reserve(rings_.size());
+      for (const auto& ring : rings_) {
+        rings.emplace_back(ring.get());
+      }
+    }
+    for (Ring* ring : rings) {
+      ring->Drain(out_, staging);
+    }
+  }
+
+  void DrainLoop() {
+    std::vector<uint8_t> staging;
+    while (!stop_.load(std::memory_order_acquire)) {
+      DrainAll(&staging);
+      std::this_thread::sleep_for(kDrainInterval);
+    }
+  }
+
+  std::FILE* out_;
+  std::thread drainer_;
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> active_{true};
+  std::mutex drain_lock_;
+  std::mutex rings_lock_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+  uint32_t next_thread_{0};
+};
+
+}  // namespace
+
+namespace katana {
+
+bool
+internal::AsyncLogString(LogLevel level, const std::string& s) {
+  Sink* sink = Sink::Get();
+  if (sink == nullptr || !sink->active()) {
+    return false;
+  }
+  sink->Log(static_cast<uint8_t>(level), s);
+  return true;
+}
+
+void
+FlushAsyncLog() {
+  Sink* sink = Sink::Get();
+  if (sink != nullptr && sink->active()) {
+    sink->Flush();
+  }
+}
+
+Result<void>
+RenderAsyncLog(const std::string& input_path, std::ostream& out) {
+  std::ifstream in(input_path, std::ios::binary);
+  if (!in) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "cannot open async log file {}", input_path);
+  }
+  std::vector<char> bytes(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  uint32_t magic{};
+  uint32_t version{};
+  if (bytes.size() < sizeof(magic) + sizeof(version)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "async log file {} is truncated",
+        input_path);
+  }
+  std::memcpy(&magic, &bytes[0], sizeof(magic));
+  std::memcpy(&version, &bytes[sizeof(magic)], sizeof(version));
+  if (magic != kMagic || version != kVersion) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} is not an async log file", input_path);
+  }
+
+  struct Record {
+    uint64_t timestamp;
+    uint32_t thread;
+    uint8_t level;
+    std::string message;
+  };
+  std::vector<Record> records;
+  size_t pos = sizeof(magic) + sizeof(version);
+  while (pos < bytes.size()) {
+    if (bytes.size() - pos < kHeaderBytes) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "async log file {} is truncated",
+          input_path);
+    }
+    Record record{};
+    uint32_t size{};
+    std::memcpy(&record.timestamp, &bytes[pos], 8);
+    record.level = static_cast<uint8_t>(bytes[pos + 8]);
+    std::memcpy(&record.thread, &bytes[pos + 9], 4);
+    std::memcpy(&size, &bytes[pos + 13], 4);
+    pos += kHeaderBytes;
+    if (bytes.size() - pos < size) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "async log file {} is truncated",
+          input_path);
+    }
+    record.message.assign(&bytes[pos], size);
+    pos += size;
+    records.emplace_back(std::move(record));
+  }
+
+  std::stable_sort(
+      records.begin(), records.end(), [](const Record& a, const Record& b) {
+        return a.timestamp < b.timestamp;
+      });
+  for (const Record& record : records) {
+    out << fmt::format(
+        "{}.{:09} [{}] {}: {}\n", record.timestamp / 1000000000,
+        record.timestamp % 1000000000, record.thread, LevelName(record.level),
+        record.message);
+  }
+  return ResultSuccess();
+}
+
+}  // namespace katana
@@ -1,5 +1,9 @@
 #include "katana/HTTP.h"
 
+#include <array>
+#include <mutex>
+#include <vector>
+
 #include <curl/curl.h>
 
 #include "katana/ErrorCode.h"
@@ -8,6 +12,79 @@
 
 namespace {
 
+/// Process-wide pool of curl easy handles. Reusing a handle keeps its
+/// connections alive across requests, and every handle attaches to one
+/// CURLSH share so DNS results and TLS sessions are reused even across
+/// handles -- metadata bursts during an RDG open pay the handshake once
+/// per host instead of once per request.
+class CurlPool {
+public:
+  static CurlPool& Get() {
+    static CurlPool pool;
+    return pool;
+  }
+
+  CURL* Acquire() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (!idle_.empty()) {
+        CURL* handle = idle_.back();
+        idle_.pop_back();
+        return handle;
+      }
+    }
+    CURL* handle = curl_easy_init();
+    if (handle != nullptr && share_ != nullptr) {
+      curl_easy_setopt(handle, CURLOPT_SHARE, share_);
+    }
+    return handle;
+  }
+
+  void Release(CURL* handle) {
+    // reset clears request state but keeps the handle's live connections
+    // and its attachment to the share
+    curl_easy_reset(handle);
+    std::lock_guard<std::mutex> guard(lock_);
+    if (idle_.size() < kMaxIdle) {
+      idle_.push_back(handle);
+      return;
+    }
+    curl_easy_cleanup(handle);
+  }
+
+private:
+  static constexpr size_t kMaxIdle = 16;
+
+  CurlPool() {
+    share_ = curl_share_init();
+    if (share_ == nullptr) {
+      return;
+    }
+    curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, LockCB);
+    curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, UnlockCB);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
+
+  static void LockCB(
+      CURL*, curl_lock_data data, curl_lock_access, void*) {
+    ShareLocks()[data].lock();
+  }
+
+  static void UnlockCB(CURL*, curl_lock_data data, void*) {
+    ShareLocks()[data].unlock();
+  }
+
+  static std::array<std::mutex, CURL_LOCK_DATA_LAST>& ShareLocks() {
+    static std::array<std::mutex, CURL_LOCK_DATA_LAST> locks;
+    return locks;
+  }
+
+  std::mutex lock_;
+  std::vector<CURL*> idle_;
+  CURLSH* share_{};
+};
+
 class CurlHandle {
   CURL* handle_{};
   struct curl_slist* headers_{};
@@ -38,7 +115,7 @@ public:
 
   static katana::Result<CurlHandle> Make(
       const std::string& url, std::vector<char>* response) {
-    CURL* curl = curl_easy_init();
+    CURL* curl = CurlPool::Get().Acquire();
     if (!curl) {
       return katana::ErrorCode::HTTPError;
     }
@@ -55,7 +132,7 @@ public:
       curl_slist_free_all(headers_);
     }
     if (handle_ != nullptr) {
-      curl_easy_cleanup(handle_);
+      CurlPool::Get().Release(handle_);
     }
   }
 
@@ -84,8 +161,12 @@ public:
           curl_easy_strerror(request_res));
     }
 
+    return TranslateResponseCode(handle_);
+  }
+
+  static katana::Result<void> TranslateResponseCode(CURL* handle) {
     int64_t response_code;
-    curl_easy_getinfo(handle_, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response_code);
     switch (response_code) {
     case 200:
       return katana::ResultSuccess();
@@ -122,6 +203,76 @@ katana::HttpGet(const std::string& url, std::vector<char>* response) {
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+katana::HttpGetMulti(
+    const std::vector<std::string>& urls,
+    std::vector<std::vector<char>>* responses) {
+  responses->assign(urls.size(), {});
+  if (urls.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  std::vector<CurlHandle> handles;
+  handles.reserve(urls.size());
+  for (size_t i = 0; i < urls.size(); ++i) {
+    CurlHandle curl = KATANA_CHECKED_CONTEXT(
+        CurlHandle::Make(urls[i], &(*responses)[i]),
+        "multi GET failed for url: {}", urls[i]);
+    KATANA_CHECKED(curl.SetOpt(CURLOPT_HTTPGET, 1L));
+    handles.emplace_back(std::move(curl));
+  }
+
+  CURLM* multi = curl_multi_init();
+  if (multi == nullptr) {
+    return katana::ErrorCode::HTTPError;
+  }
+  // let curl multiplex concurrent transfers over the pooled connections
+  // where the server supports it instead of opening one per request
+  curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  for (CurlHandle& curl : handles) {
+    curl_multi_add_handle(multi, curl.handle());
+  }
+
+  katana::Result<void> final_result = katana::ResultSuccess();
+  int still_running = 0;
+  do {
+    CURLMcode mc = curl_multi_perform(multi, &still_running);
+    if (mc == CURLM_OK && still_running != 0) {
+      mc = curl_multi_wait(multi, nullptr, 0, 1000, nullptr);
+    }
+    if (mc != CURLM_OK) {
+      final_result = KATANA_ERROR(
+          katana::ErrorCode::HTTPError, "CURL error: {}",
+          curl_multi_strerror(mc));
+      break;
+    }
+  } while (still_running != 0);
+
+  CURLMsg* msg = nullptr;
+  int msgs_left = 0;
+  while ((msg = curl_multi_info_read(multi, &msgs_left)) != nullptr) {
+    if (msg->msg != CURLMSG_DONE || !final_result) {
+      continue;
+    }
+    if (msg->data.result != CURLE_OK) {
+      final_result = KATANA_ERROR(
+          katana::ErrorCode::HTTPError, "CURL error: {}",
+          curl_easy_strerror(msg->data.result));
+      continue;
+    }
+    if (auto code_result = CurlHandle::TranslateResponseCode(msg->easy_handle);
+        !code_result) {
+      final_result = std::move(code_result);
+    }
+  }
+
+  for (CurlHandle& curl : handles) {
+    curl_multi_remove_handle(multi, curl.handle());
+  }
+  curl_multi_cleanup(multi);
+  return final_result;
+}
+
 katana::Result<void>
 katana::HttpPost(
     const std::string& url, const std::string& data,
@@ -9,12 +9,92 @@
 
 #include <arrow/memory_pool.h>
 
+#include "katana/Env.h"
+#include "katana/Logging.h"
 #include "katana/Random.h"
 #include "katana/Time.h"
 
-namespace {
+namespace katana {
+
+/// Bounded queue between span operations and the output callback. Appending
+/// a record takes one short lock; the callback runs outside that lock, once
+/// per batch, so traced threads never wait on the sink's I/O.
+class JSONEmitter {
+public:
+  explicit JSONEmitter(OutputCB out) : out_(std::move(out)) {
+    int batch = 1;
+    GetEnv("KATANA_TRACE_BATCH", &batch);
+    int queue = 4096;
+    GetEnv("KATANA_TRACE_QUEUE", &queue);
+    batch_size_ = batch < 1 ? 1 : static_cast<size_t>(batch);
+    max_queued_ = static_cast<size_t>(queue) < batch_size_
+                      ? batch_size_
+                      : static_cast<size_t>(queue);
+  }
+
+  ~JSONEmitter() { Flush(); }
+
+  void Append(std::string record) {
+    std::vector<std::string> batch;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (queued_.size() >= max_queued_) {
+        ++dropped_;
+        return;
+      }
+      queued_.emplace_back(std::move(record));
+      if (queued_.size() < batch_size_) {
+        return;
+      }
+      batch.swap(queued_);
+    }
+    Emit(batch);
+  }
 
-std::mutex output_mutex;
+  void Flush() {
+    std::vector<std::string> batch;
+    uint64_t dropped = 0;
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      batch.swap(queued_);
+      dropped = dropped_;
+      dropped_ = 0;
+    }
+    if (!batch.empty()) {
+      Emit(batch);
+    }
+    if (dropped > 0) {
+      KATANA_LOG_WARN("tracing queue overflowed; {} spans dropped", dropped);
+    }
+  }
+
+private:
+  void Emit(const std::vector<std::string>& batch) {
+    size_t total = 0;
+    for (const std::string& record : batch) {
+      total += record.size();
+    }
+    std::string output;
+    output.reserve(total);
+    for (const std::string& record : batch) {
+      output += record;
+    }
+    std::lock_guard<std::mutex> guard(emit_lock_);
+    out_(output);
+  }
+
+  OutputCB out_;
+  std::mutex lock_;
+  std::mutex emit_lock_;
+  std::vector<std::string> queued_;
+  size_t batch_size_{1};
+  size_t max_queued_{4096};
+  uint64_t dropped_{0};
+};
+
+}  // namespace katana
+
+namespace {
 
 std::string
 GenerateID() {
@@ -62,9 +142,9 @@ GetHostStatsJSON() {
 
   fmt::format_to(
       std::back_inserter(buf),
-      R"("host_data":{{"hosts":{},"hostname":"{}","hardware_threads":{},"pid":{},"ram_gb":{}}})",
+      R"("host_data":{{"hosts":{},"hostname":"{}","hardware_threads":{},"pid":{},"ram_gb":{},"numa_nodes":{}}})",
       tracer.GetNumHosts(), host_stats.hostname, host_stats.nprocs,
-      host_stats.pid, host_stats.ram_gb);
+      host_stats.pid, host_stats.ram_gb, host_stats.numa_nodes);
 
   return fmt::to_string(buf);
 }
@@ -140,12 +220,6 @@ BuildJSON(
   return fmt::to_string(buf);
 }
 
-void
-OutputJSON(const katana::OutputCB& out_callback, const std::string& output) {
-  std::lock_guard<std::mutex> lock(output_mutex);
-  out_callback(output);
-}
-
 }  // namespace
 
 std::unique_ptr<katana::JSONTracer>
@@ -162,15 +236,36 @@ katana::JSONTracer::Make(
       new JSONTracer(host_id, num_hosts, std::move(out_callback)));
 }
 
+katana::JSONTracer::JSONTracer(
+    uint32_t host_id, uint32_t num_hosts, katana::OutputCB out_callback)
+    : ProgressTracer(host_id, num_hosts),
+      emitter_(std::make_shared<JSONEmitter>(std::move(out_callback))) {
+  GetEnv("KATANA_TRACE_SAMPLE", &sample_rate_);
+  if (sample_rate_ < 0.0) {
+    sample_rate_ = 0.0;
+  } else if (sample_rate_ > 1.0) {
+    sample_rate_ = 1.0;
+  }
+}
+
+void
+katana::JSONTracer::Close() {
+  emitter_->Flush();
+}
+
 std::shared_ptr<katana::ProgressSpan>
 katana::JSONTracer::StartSpan(
     const std::string& span_name, const katana::ProgressContext& child_of) {
-  return JSONSpan::Make(span_name, child_of, out_callback_);
+  return JSONSpan::Make(span_name, child_of, emitter_);
 }
 
 std::string
 katana::JSONTracer::Inject(const katana::ProgressContext& ctx) {
-  return ctx.GetTraceID() + "," + ctx.GetSpanID();
+  std::string carrier = ctx.GetTraceID() + "," + ctx.GetSpanID();
+  if (!static_cast<const JSONContext&>(ctx).sampled()) {
+    carrier += ",u";
+  }
+  return carrier;
 }
 
 std::unique_ptr<katana::ProgressContext>
@@ -180,24 +275,44 @@ katana::JSONTracer::Extract(const std::string& carrier) {
     return nullptr;
   }
   std::string trace_id = carrier.substr(0, split);
-  std::string span_id = carrier.substr(split + 1);
-  return std::unique_ptr<JSONContext>(new JSONContext(trace_id, span_id));
+  std::string rest = carrier.substr(split + 1);
+  // a trailing ",u" marks a trace the head-based sampler passed over
+  bool sampled = true;
+  size_t flag_split = rest.find(',');
+  std::string span_id = rest.substr(0, flag_split);
+  if (flag_split != std::string::npos && rest.substr(flag_split + 1) == "u") {
+    sampled = false;
+  }
+  return std::unique_ptr<JSONContext>(
+      new JSONContext(trace_id, span_id, sampled));
 }
 
 std::shared_ptr<katana::ProgressSpan>
 katana::JSONTracer::StartSpan(
     const std::string& span_name,
     std::shared_ptr<katana::ProgressSpan> child_of) {
-  return JSONSpan::Make(span_name, std::move(child_of), out_callback_);
+  bool sampled = true;
+  if (child_of != nullptr) {
+    sampled = std::static_pointer_cast<JSONSpan>(child_of)->sampled_;
+  } else if (sample_rate_ < 1.0) {
+    // head-based decision: drawn once per trace, inherited by every child
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    sampled = dist(GetGenerator()) < sample_rate_;
+  }
+  return JSONSpan::Make(span_name, std::move(child_of), emitter_, sampled);
 }
 
 std::unique_ptr<katana::ProgressContext>
 katana::JSONContext::Clone() const noexcept {
-  return std::unique_ptr<JSONContext>(new JSONContext(trace_id_, span_id_));
+  return std::unique_ptr<JSONContext>(
+      new JSONContext(trace_id_, span_id_, sampled_));
 }
 
 void
 katana::JSONSpan::SetTags(const katana::Tags& tags) {
+  if (!sampled_) {
+    return;
+  }
   std::string span_data = GetSpanJSON(GetContext().GetSpanID());
   std::string log_data;
   std::string tag_data = GetTagsJSON(tags);
@@ -205,11 +320,14 @@ katana::JSONSpan::SetTags(const katana::Tags& tags) {
 
   std::string output_json = BuildJSON(
       GetContext().GetTraceID(), span_data, log_data, tag_data, host_data);
-  OutputJSON(out_callback_, output_json);
+  emitter_->Append(std::move(output_json));
 }
 
 void
 katana::JSONSpan::Log(const std::string& message, const katana::Tags& tags) {
+  if (!sampled_) {
+    return;
+  }
   std::string span_data = GetSpanJSON(GetContext().GetSpanID());
   std::string log_data = GetLogJSON(message);
   std::string tag_data = GetTagsJSON(tags);
@@ -217,15 +335,22 @@ katana::JSONSpan::Log(const std::string& message, const katana::Tags& tags) {
 
   std::string output_json = BuildJSON(
       GetContext().GetTraceID(), span_data, log_data, tag_data, host_data);
-  OutputJSON(out_callback_, output_json);
+  emitter_->Append(std::move(output_json));
 }
 
 katana::JSONSpan::JSONSpan(
     const std::string& span_name, std::shared_ptr<katana::ProgressSpan> parent,
-    OutputCB out_callback)
+    std::shared_ptr<JSONEmitter> emitter, bool sampled)
     : ProgressSpan(std::move(parent)),
-      context_(JSONContext{"", ""}),
-      out_callback_(std::move(out_callback)) {
+      context_(JSONContext{"", "", sampled}),
+      emitter_(std::move(emitter)),
+      sampled_(sampled) {
+  if (!sampled_) {
+    // the whole trace was passed over; skip ID generation and rendering so
+    // span creation costs no allocation
+    context_ = JSONContext("0x0", "0x0", false);
+    return;
+  }
   std::string parent_span_id{"null"};
   std::string trace_id;
   std::string host_data;
@@ -248,15 +373,20 @@ katana::JSONSpan::JSONSpan(
 
   std::string output_json =
       BuildJSON(trace_id, span_data, log_data, tag_data, host_data);
-  OutputJSON(out_callback_, output_json);
+  emitter_->Append(std::move(output_json));
 }
 
 katana::JSONSpan::JSONSpan(
     const std::string& span_name, const katana::ProgressContext& parent,
-    OutputCB out_callback)
+    std::shared_ptr<JSONEmitter> emitter)
     : ProgressSpan(nullptr),
-      context_(JSONContext{"", ""}),
-      out_callback_(std::move(out_callback)) {
+      context_(JSONContext{"", "", true}),
+      emitter_(std::move(emitter)),
+      sampled_(static_cast<const JSONContext&>(parent).sampled()) {
+  if (!sampled_) {
+    context_ = JSONContext(parent.GetTraceID(), "0x0", false);
+    return;
+  }
   std::string parent_span_id = parent.GetSpanID();
   std::string trace_id = parent.GetTraceID();
   std::string span_id = GenerateID();
@@ -271,26 +401,29 @@ katana::JSONSpan::JSONSpan(
 
   std::string output_json =
       BuildJSON(trace_id, span_data, log_data, tag_data, host_data);
-  OutputJSON(out_callback_, output_json);
+  emitter_->Append(std::move(output_json));
 }
 
 std::shared_ptr<katana::ProgressSpan>
 katana::JSONSpan::Make(
     const std::string& span_name, std::shared_ptr<katana::ProgressSpan> parent,
-    OutputCB out_callback) {
+    std::shared_ptr<JSONEmitter> emitter, bool sampled) {
   return std::shared_ptr<JSONSpan>(
-      new JSONSpan(span_name, std::move(parent), std::move(out_callback)));
+      new JSONSpan(span_name, std::move(parent), std::move(emitter), sampled));
 }
 std::shared_ptr<katana::ProgressSpan>
 katana::JSONSpan::Make(
     const std::string& span_name, const katana::ProgressContext& parent,
-    OutputCB out_callback) {
+    std::shared_ptr<JSONEmitter> emitter) {
   return std::shared_ptr<JSONSpan>(
-      new JSONSpan(span_name, parent, std::move(out_callback)));
+      new JSONSpan(span_name, parent, std::move(emitter)));
 }
 
 void
 katana::JSONSpan::Close() {
+  if (!sampled_) {
+    return;
+  }
   std::string message{"finished"};
 
   std::string span_data = GetSpanJSON(GetContext().GetSpanID(), true);
@@ -300,5 +433,5 @@ katana::JSONSpan::Close() {
 
   std::string output_json = BuildJSON(
       GetContext().GetTraceID(), span_data, log_data, tag_data, host_data);
-  OutputJSON(out_callback_, output_json);
+  emitter_->Append(std::move(output_json));
 }
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <mutex>
 
+#include "katana/AsyncLog.h"
 #include "katana/Env.h"
 
 namespace {
@@ -34,6 +35,12 @@ katana::internal::LogString(katana::LogLevel level, const std::string& s) {
     return;
   }
 
+  // KATANA_ASYNC_LOG diverts records to per-thread ring buffers drained by
+  // a background thread; render the file with katana::RenderAsyncLog
+  if (AsyncLogString(level, s)) {
+    return;
+  }
+
   switch (level) {
   case LogLevel::Debug:
     return PrintString(true, false, "DEBUG", s);
@@ -50,6 +57,8 @@ katana::internal::LogString(katana::LogLevel level, const std::string& s) {
 
 void
 katana::AbortApplication() {
+  // records explaining the abort must not die in a ring buffer
+  FlushAsyncLog();
   // TODO(amp): Replace this with an exception throw that can be caught in
   //  language wrappers to avoid low-level aborting the language runtime.
   std::abort();
@@ -0,0 +1,303 @@
+#include "katana/MemoryTelemetry.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/ProgressTracer.h"
+
+namespace {
+
+// A CAS transfers one 64-byte cache line between the IMC and DRAM.
+constexpr uint64_t kBytesPerCas = 64;
+
+#ifdef __linux__
+
+constexpr char kNodeDir[] = "/sys/devices/system/node";
+constexpr char kEventSourceDir[] = "/sys/bus/event_source/devices";
+
+std::vector<katana::NumaAllocStats>
+ReadNumaStats() {
+  std::vector<katana::NumaAllocStats> nodes;
+  for (size_t n = 0;; ++n) {
+    std::ifstream numastat(
+        fmt::format("{}/node{}/numastat", kNodeDir, n));
+    if (!numastat) {
+      break;
+    }
+    katana::NumaAllocStats stats;
+    std::string name;
+    uint64_t value;
+    while (numastat >> name >> value) {
+      if (name == "numa_hit") {
+        stats.numa_hit = value;
+      } else if (name == "numa_miss") {
+        stats.numa_miss = value;
+      } else if (name == "numa_foreign") {
+        stats.numa_foreign = value;
+      } else if (name == "local_node") {
+        stats.local_node = value;
+      } else if (name == "other_node") {
+        stats.other_node = value;
+      }
+    }
+    nodes.emplace_back(stats);
+  }
+  return nodes;
+}
+
+// Parses an exported perf event description like "event=0x04,umask=0x03"
+// into a perf_event_attr config value.
+bool
+ParseEventConfig(const std::string& path, uint64_t* config) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::string desc;
+  std::getline(file, desc);
+  *config = 0;
+  std::stringstream fields(desc);
+  std::string field;
+  while (std::getline(fields, field, ',')) {
+    size_t eq = field.find('=');
+    if (eq == std::string::npos) {
+      return false;
+    }
+    std::string key = field.substr(0, eq);
+    uint64_t value = std::strtoull(field.c_str() + eq + 1, nullptr, 0);
+    if (key == "event") {
+      *config |= value;
+    } else if (key == "umask") {
+      *config |= value << 8;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The uncore cpumask lists one representative cpu per socket, e.g.
+// "0,18"; counters opened on those cpus cover their whole socket.
+std::vector<int>
+ParseCpuMask(const std::string& path) {
+  std::vector<int> cpus;
+  std::ifstream file(path);
+  if (!file) {
+    return cpus;
+  }
+  std::string mask;
+  std::getline(file, mask);
+  std::stringstream fields(mask);
+  std::string field;
+  while (std::getline(fields, field, ',')) {
+    cpus.emplace_back(std::atoi(field.c_str()));
+  }
+  return cpus;
+}
+
+int
+OpenUncoreCounter(uint32_t type, uint64_t config, int cpu) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  // uncore events are system-wide: pid = -1, one cpu per socket
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, -1, cpu, -1, 0));
+}
+
+uint64_t
+ReadCounter(int fd) {
+  uint64_t value = 0;
+  if (fd != -1 && read(fd, &value, sizeof(value)) != sizeof(value)) {
+    value = 0;
+  }
+  return value;
+}
+
+#endif  // __linux__
+
+}  // namespace
+
+katana::MemoryTelemetry&
+katana::MemoryTelemetry::Get() {
+  static MemoryTelemetry telemetry;
+  return telemetry;
+}
+
+bool
+katana::MemoryTelemetry::Enabled() {
+#ifdef __linux__
+  static bool enabled = katana::GetEnv("KATANA_MEMORY_TELEMETRY");
+  return enabled;
+#else
+  return false;
+#endif
+}
+
+katana::MemoryTelemetry::MemoryTelemetry() {
+  if (Enabled()) {
+    OpenImcCounters();
+  }
+}
+
+#ifdef __linux__
+
+void
+katana::MemoryTelemetry::OpenImcCounters() {
+  boost::system::error_code ec;
+  boost::filesystem::directory_iterator dir(kEventSourceDir, ec);
+  if (ec) {
+    return;
+  }
+  for (const auto& entry : dir) {
+    std::string name = entry.path().filename().string();
+    if (name.rfind("uncore_imc", 0) != 0) {
+      continue;
+    }
+    std::string base = entry.path().string();
+    uint32_t type = 0;
+    {
+      std::ifstream type_file(base + "/type");
+      if (!(type_file >> type)) {
+        continue;
+      }
+    }
+    uint64_t read_config = 0;
+    uint64_t write_config = 0;
+    if (!ParseEventConfig(base + "/events/cas_count_read", &read_config) ||
+        !ParseEventConfig(base + "/events/cas_count_write", &write_config)) {
+      continue;
+    }
+    std::vector<int> cpus = ParseCpuMask(base + "/cpumask");
+    num_sockets_ = std::max(num_sockets_, cpus.size());
+    for (size_t socket = 0; socket < cpus.size(); ++socket) {
+      int read_fd = OpenUncoreCounter(type, read_config, cpus[socket]);
+      if (read_fd != -1) {
+        imc_events_.emplace_back(ImcEvent{read_fd, socket, false});
+      }
+      int write_fd = OpenUncoreCounter(type, write_config, cpus[socket]);
+      if (write_fd != -1) {
+        imc_events_.emplace_back(ImcEvent{write_fd, socket, true});
+      }
+    }
+  }
+  if (imc_events_.empty()) {
+    KATANA_LOG_WARN(
+        "KATANA_MEMORY_TELEMETRY is set but no uncore IMC counters could "
+        "be opened; socket traffic will not be reported");
+  }
+}
+
+katana::MemoryTelemetry::~MemoryTelemetry() {
+  for (const ImcEvent& event : imc_events_) {
+    close(event.fd);
+  }
+}
+
+katana::MemoryTelemetry::Sample
+katana::MemoryTelemetry::Snapshot() {
+  Sample sample;
+  sample.taken = std::chrono::steady_clock::now();
+  if (!Enabled()) {
+    return sample;
+  }
+  sample.nodes = ReadNumaStats();
+  if (!imc_events_.empty()) {
+    sample.sockets.resize(num_sockets_);
+    for (const ImcEvent& event : imc_events_) {
+      uint64_t bytes = ReadCounter(event.fd) * kBytesPerCas;
+      if (event.write) {
+        sample.sockets[event.socket].write_bytes += bytes;
+      } else {
+        sample.sockets[event.socket].read_bytes += bytes;
+      }
+    }
+  }
+  return sample;
+}
+
+#else
+
+void
+katana::MemoryTelemetry::OpenImcCounters() {}
+
+katana::MemoryTelemetry::~MemoryTelemetry() = default;
+
+katana::MemoryTelemetry::Sample
+katana::MemoryTelemetry::Snapshot() {
+  Sample sample;
+  sample.taken = std::chrono::steady_clock::now();
+  return sample;
+}
+
+#endif  // __linux__
+
+katana::MemoryTelemetry::PhaseScope::PhaseScope(std::string phase_name)
+    : phase_name_(std::move(phase_name)) {
+  if (Enabled()) {
+    begin_ = Get().Snapshot();
+  }
+}
+
+katana::MemoryTelemetry::PhaseScope::~PhaseScope() {
+  if (!Enabled()) {
+    return;
+  }
+  Sample end = Get().Snapshot();
+
+  double seconds =
+      std::chrono::duration<double>(end.taken - begin_.taken).count();
+
+  uint64_t local_pages = 0;
+  uint64_t remote_pages = 0;
+  uint64_t miss_pages = 0;
+  size_t num_nodes = std::min(begin_.nodes.size(), end.nodes.size());
+  for (size_t n = 0; n < num_nodes; ++n) {
+    local_pages += end.nodes[n].local_node - begin_.nodes[n].local_node;
+    remote_pages += end.nodes[n].other_node - begin_.nodes[n].other_node;
+    miss_pages += end.nodes[n].numa_miss - begin_.nodes[n].numa_miss;
+  }
+
+  Tags tags = {
+      {"phase", phase_name_},
+      {"duration_sec", seconds},
+      {"numa_local_pages", local_pages},
+      {"numa_remote_pages", remote_pages},
+      {"numa_miss_pages", miss_pages},
+  };
+
+  uint64_t total_bytes = 0;
+  size_t num_sockets = std::min(begin_.sockets.size(), end.sockets.size());
+  for (size_t s = 0; s < num_sockets; ++s) {
+    uint64_t read_bytes =
+        end.sockets[s].read_bytes - begin_.sockets[s].read_bytes;
+    uint64_t write_bytes =
+        end.sockets[s].write_bytes - begin_.sockets[s].write_bytes;
+    total_bytes += read_bytes + write_bytes;
+    tags.emplace_back(
+        fmt::format("socket{}_dram_read_gb", s),
+        read_bytes / 1024.0 / 1024.0 / 1024.0);
+    tags.emplace_back(
+        fmt::format("socket{}_dram_write_gb", s),
+        write_bytes / 1024.0 / 1024.0 / 1024.0);
+  }
+  if (num_sockets > 0 && seconds > 0.0) {
+    tags.emplace_back(
+        "dram_bandwidth_gbps",
+        total_bytes / seconds / 1024.0 / 1024.0 / 1024.0);
+  }
+
+  GetTracer().GetActiveSpan().Log("memory telemetry", tags);
+}
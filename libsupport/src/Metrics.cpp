@@ -0,0 +1,248 @@
+#include "katana/Metrics.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/MemoryTelemetry.h"
+
+namespace {
+
+/// Per-socket DRAM traffic and per-node allocation counters, rendered as
+/// labeled families; values come straight from MemoryTelemetry::Snapshot
+/// so a scrape sees the kernel's current numbers.
+void
+RenderMemoryTelemetry(std::string* out) {
+  katana::MemoryTelemetry::Sample sample =
+      katana::MemoryTelemetry::Get().Snapshot();
+
+  if (!sample.sockets.empty()) {
+    out->append(
+        "# HELP katana_socket_dram_read_bytes DRAM bytes read per socket "
+        "(IMC counters)\n"
+        "# TYPE katana_socket_dram_read_bytes counter\n");
+    for (size_t i = 0; i < sample.sockets.size(); ++i) {
+      fmt::format_to(
+          std::back_inserter(*out),
+          "katana_socket_dram_read_bytes_total{{socket=\"{}\"}} {}\n", i,
+          sample.sockets[i].read_bytes);
+    }
+    out->append(
+        "# HELP katana_socket_dram_write_bytes DRAM bytes written per "
+        "socket (IMC counters)\n"
+        "# TYPE katana_socket_dram_write_bytes counter\n");
+    for (size_t i = 0; i < sample.sockets.size(); ++i) {
+      fmt::format_to(
+          std::back_inserter(*out),
+          "katana_socket_dram_write_bytes_total{{socket=\"{}\"}} {}\n", i,
+          sample.sockets[i].write_bytes);
+    }
+  }
+
+  if (!sample.nodes.empty()) {
+    out->append(
+        "# HELP katana_numa_alloc_pages Pages allocated per NUMA node by "
+        "placement outcome (numastat)\n"
+        "# TYPE katana_numa_alloc_pages counter\n");
+    for (size_t i = 0; i < sample.nodes.size(); ++i) {
+      fmt::format_to(
+          std::back_inserter(*out),
+          "katana_numa_alloc_pages_total{{node=\"{}\",kind=\"local\"}} {}\n"
+          "katana_numa_alloc_pages_total{{node=\"{}\",kind=\"remote\"}} {}\n",
+          i, sample.nodes[i].local_node, i, sample.nodes[i].other_node);
+    }
+  }
+}
+
+}  // namespace
+
+katana::MetricsRegistry&
+katana::MetricsRegistry::Get() {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<std::atomic<uint64_t>>
+katana::MetricsRegistry::RegisterCounter(
+    const std::string& name, const std::string& help) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (const Counter& counter : counters_) {
+    if (counter.name == name) {
+      return counter.cell;
+    }
+  }
+  counters_.push_back(
+      Counter{name, help, std::make_shared<std::atomic<uint64_t>>(0)});
+  return counters_.back().cell;
+}
+
+void
+katana::MetricsRegistry::RegisterGauge(
+    const std::string& name, const std::string& help,
+    std::function<double()> read) {
+  std::lock_guard<std::mutex> guard(lock_);
+  gauges_.push_back(Gauge{name, help, std::move(read)});
+}
+
+void
+katana::MetricsRegistry::RegisterFamily(
+    std::function<void(std::string*)> render) {
+  std::lock_guard<std::mutex> guard(lock_);
+  families_.push_back(std::move(render));
+}
+
+std::string
+katana::MetricsRegistry::Render() {
+  std::lock_guard<std::mutex> guard(lock_);
+  std::string out;
+  for (const Counter& counter : counters_) {
+    fmt::format_to(
+        std::back_inserter(out),
+        "# HELP {0} {1}\n# TYPE {0} counter\n{0}_total {2}\n", counter.name,
+        counter.help, counter.cell->load(std::memory_order_relaxed));
+  }
+  for (const Gauge& gauge : gauges_) {
+    fmt::format_to(
+        std::back_inserter(out), "# HELP {0} {1}\n# TYPE {0} gauge\n{0} {2}\n",
+        gauge.name, gauge.help, gauge.read());
+  }
+  for (const auto& family : families_) {
+    family(&out);
+  }
+  out.append("# EOF\n");
+  return out;
+}
+
+katana::MetricsExporter&
+katana::MetricsExporter::Get() {
+  static MetricsExporter exporter;
+  return exporter;
+}
+
+katana::Result<void>
+katana::MetricsExporter::Start(uint16_t port) {
+  if (running()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "metrics exporter already running");
+  }
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return KATANA_ERROR(
+        katana::ResultErrno(), "creating metrics listener socket");
+  }
+  int enable = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  struct sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+    auto error = katana::ResultErrno();
+    close(fd);
+    return KATANA_ERROR(error, "binding metrics listener to port {}", port);
+  }
+  if (listen(fd, 8) < 0) {
+    auto error = katana::ResultErrno();
+    close(fd);
+    return KATANA_ERROR(error, "listening on metrics port {}", port);
+  }
+
+  MetricsRegistry::Get().RegisterFamily(RenderMemoryTelemetry);
+
+  listen_fd_ = fd;
+  thread_ = std::make_unique<std::thread>([this]() { Serve(); });
+  return katana::ResultSuccess();
+}
+
+void
+katana::MetricsExporter::StartIfRequested() {
+  int port = 0;
+  if (!GetEnv("KATANA_METRICS_PORT", &port)) {
+    return;
+  }
+  if (port <= 0 || port > 65535) {
+    KATANA_LOG_WARN("ignoring invalid KATANA_METRICS_PORT: {}", port);
+    return;
+  }
+  if (auto res = Start(static_cast<uint16_t>(port)); !res) {
+    KATANA_LOG_WARN("metrics exporter did not start: {}", res.error());
+  }
+}
+
+void
+katana::MetricsExporter::Stop() {
+  int fd = listen_fd_.exchange(-1);
+  if (fd < 0) {
+    return;
+  }
+  // closing the listener unblocks the accept in Serve
+  shutdown(fd, SHUT_RDWR);
+  close(fd);
+  thread_->join();
+  thread_.reset();
+}
+
+void
+katana::MetricsExporter::Serve() {
+  while (true) {
+    int fd = listen_fd_.load();
+    if (fd < 0) {
+      return;
+    }
+    int conn = accept(fd, nullptr, nullptr);
+    if (conn < 0) {
+      if (listen_fd_.load() < 0) {
+        return;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      KATANA_LOG_WARN(
+          "metrics exporter accept failed: {}", std::strerror(errno));
+      return;
+    }
+
+    // drain the request; the path does not matter, every GET gets the
+    // full exposition
+    char request[1024];
+    while (true) {
+      ssize_t got = read(conn, request, sizeof(request));
+      if (got <= 0 || static_cast<size_t>(got) < sizeof(request)) {
+        break;
+      }
+    }
+
+    std::string body = MetricsRegistry::Get().Render();
+    std::string response = fmt::format(
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/openmetrics-text; version=1.0.0; "
+        "charset=utf-8\r\n"
+        "Content-Length: {}\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "{}",
+        body.size(), body);
+    const char* data = response.data();
+    size_t remaining = response.size();
+    while (remaining > 0) {
+      ssize_t sent = write(conn, data, remaining);
+      if (sent <= 0) {
+        break;
+      }
+      data += sent;
+      remaining -= sent;
+    }
+    close(conn);
+  }
+}
@@ -0,0 +1,122 @@
+#include "katana/MpiCommBackend.h"
+
+#include "katana/ErrorCode.h"
+
+#ifdef KATANA_USE_MPI
+
+#include <mpi.h>
+
+namespace {
+
+katana::Result<void>
+CheckMpi(int rc, const char* what) {
+  if (rc != MPI_SUCCESS) {
+    char msg[MPI_MAX_ERROR_STRING];
+    int len = 0;
+    MPI_Error_string(rc, msg, &len);
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "{}: {}", what,
+        std::string(msg, len));
+  }
+  return katana::ResultSuccess();
+}
+
+class MpiCommBackend final : public katana::CommBackend {
+public:
+  explicit MpiCommBackend(bool owns_finalize)
+      : owns_finalize_(owns_finalize) {
+    int num = 0;
+    int rank = 0;
+    MPI_Comm_size(MPI_COMM_WORLD, &num);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    Num = num;
+    Rank = rank;
+
+    MPI_Comm local = MPI_COMM_NULL;
+    MPI_Comm_split_type(
+        MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &local);
+    int local_rank = 0;
+    MPI_Comm_rank(local, &local_rank);
+    LocalRank = local_rank;
+    MPI_Comm_free(&local);
+  }
+
+  ~MpiCommBackend() override {
+    if (owns_finalize_) {
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if (!finalized) {
+        MPI_Finalize();
+      }
+    }
+  }
+
+  void Barrier() override { MPI_Barrier(MPI_COMM_WORLD); }
+
+  bool Broadcast(uint32_t root, bool val) override {
+    int v = val ? 1 : 0;
+    MPI_Bcast(&v, 1, MPI_INT, static_cast<int>(root), MPI_COMM_WORLD);
+    return v != 0;
+  }
+
+  std::string Broadcast(
+      uint32_t root, const std::string& val, uint64_t max_size) override {
+    std::string out = val.substr(0, max_size);
+    uint64_t size = out.size();
+    MPI_Bcast(&size, 1, MPI_UINT64_T, static_cast<int>(root), MPI_COMM_WORLD);
+    out.resize(size);
+    if (size > 0) {
+      MPI_Bcast(
+          out.data(), static_cast<int>(size), MPI_BYTE,
+          static_cast<int>(root), MPI_COMM_WORLD);
+    }
+    return out;
+  }
+
+  void NotifyFailure() override { MPI_Abort(MPI_COMM_WORLD, 1); }
+
+private:
+  bool owns_finalize_;
+};
+
+}  // namespace
+
+bool
+katana::HaveMpiCommBackend() {
+  return true;
+}
+
+katana::Result<std::unique_ptr<katana::CommBackend>>
+katana::MakeMpiCommBackend() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  bool owns_finalize = false;
+  if (!initialized) {
+    int provided = 0;
+    KATANA_CHECKED(CheckMpi(
+        MPI_Init_thread(nullptr, nullptr, MPI_THREAD_FUNNELED, &provided),
+        "MPI_Init_thread"));
+    if (provided < MPI_THREAD_FUNNELED) {
+      return KATANA_ERROR(
+          ErrorCode::NotImplemented,
+          "MPI implementation does not support MPI_THREAD_FUNNELED");
+    }
+    owns_finalize = true;
+  }
+  return std::unique_ptr<CommBackend>(new MpiCommBackend(owns_finalize));
+}
+
+#else
+
+bool
+katana::HaveMpiCommBackend() {
+  return false;
+}
+
+katana::Result<std::unique_ptr<katana::CommBackend>>
+katana::MakeMpiCommBackend() {
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "katana was built without MPI support");
+}
+
+#endif
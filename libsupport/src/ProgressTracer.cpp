@@ -67,6 +67,10 @@ katana::ProgressTracer::GetHostStats() {
 
   stats.ram_gb = info.totalram / (1024 * 1024 * 1024);
   stats.nprocs = get_nprocs();
+  while (std::ifstream(fmt::format(
+      "/sys/devices/system/node/node{}/cpulist", stats.numa_nodes))) {
+    stats.numa_nodes += 1;
+  }
   stats.hostname = hostname.begin();
 
   stats.pid = getpid();
@@ -0,0 +1,87 @@
+#include "katana/SharedMemoryRegion.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+
+katana::Result<katana::SharedMemoryRegion>
+katana::SharedMemoryRegion::Create(const std::string& name, size_t size) {
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return KATANA_ERROR(
+        errno == EEXIST ? ErrorCode::AlreadyExists : ErrorCode::InvalidArgument,
+        "shm_open({}) failed: {}", name, strerror(errno));
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+    int err = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "ftruncate({}, {}) failed: {}", name, size,
+        strerror(err));
+  }
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // the mapping holds its own reference to the segment
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "mmap of {} ({} bytes) failed: {}", name,
+        size, strerror(errno));
+  }
+  return SharedMemoryRegion(name, static_cast<uint8_t*>(ptr), size);
+}
+
+katana::Result<katana::SharedMemoryRegion>
+katana::SharedMemoryRegion::Open(const std::string& name) {
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "shm_open({}) failed: {}", name, strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    int err = errno;
+    close(fd);
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "fstat({}) failed: {}", name,
+        strerror(err));
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void* ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "mmap of {} ({} bytes) failed: {}", name,
+        size, strerror(errno));
+  }
+  return SharedMemoryRegion(name, static_cast<uint8_t*>(ptr), size);
+}
+
+katana::Result<void>
+katana::SharedMemoryRegion::Unlink(const std::string& name) {
+  if (shm_unlink(name.c_str()) < 0) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "shm_unlink({}) failed: {}", name,
+        strerror(errno));
+  }
+  return katana::ResultSuccess();
+}
+
+void
+katana::SharedMemoryRegion::Unmap() {
+  if (ptr_ != nullptr) {
+    if (munmap(ptr_, size_) < 0) {
+      KATANA_LOG_WARN("munmap of {} failed: {}", name_, strerror(errno));
+    }
+    ptr_ = nullptr;
+    size_ = 0;
+  }
+}
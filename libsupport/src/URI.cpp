@@ -3,9 +3,11 @@
 #include <libgen.h>
 
 #include <array>
+#include <cctype>
 #include <climits>
 #include <cstdlib>
-#include <regex>
+#include <mutex>
+#include <unordered_map>
 
 #include <fmt/format.h>
 
@@ -17,8 +19,10 @@
 
 namespace {
 
-// get scheme and path, always drop trailing slash
-const std::regex kUriRegex("^(?:([a-zA-Z0-9]+)://)?(.+?)/?$");
+// Interned URIs are dropped from the table when the last Uri referencing
+// them dies; sweep expired entries once the table grows past this size so
+// short-lived URIs (e.g., RandFile temporaries) do not accumulate.
+constexpr size_t kInternSweepSize = 1 << 12;
 
 // This function does not recognize any path seperator other than kSepChar. This
 // could be a problem for Windows or "non-standard S3" paths.
@@ -121,12 +125,43 @@ DoJoinPath(std::string_view dir, std::string_view file) {
 
 namespace katana {
 
+std::shared_ptr<const Uri::Interned>
+Uri::Intern(std::string scheme, std::string path) {
+  std::string string = scheme + "://" + path;
+
+  static std::mutex lock;
+  static std::unordered_map<std::string, std::weak_ptr<const Interned>> table;
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (table.size() >= kInternSweepSize) {
+    for (auto it = table.begin(); it != table.end();) {
+      if (it->second.expired()) {
+        it = table.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  std::weak_ptr<const Interned>& slot = table[string];
+  if (std::shared_ptr<const Interned> hit = slot.lock()) {
+    return hit;
+  }
+  auto made = std::make_shared<const Interned>(
+      Interned{std::move(scheme), std::move(path), std::move(string)});
+  slot = made;
+  return made;
+}
+
+const Uri::Interned&
+Uri::Data() const {
+  static const Interned kEmpty;
+  return interned_ ? *interned_ : kEmpty;
+}
+
 Uri::Uri(std::string scheme, std::string path)
-    : scheme_(std::move(scheme)),
-      path_(std::move(path)),
-      string_(scheme_ + "://" + path_) {
-  KATANA_LOG_DEBUG_ASSERT(!scheme_.empty());
-  KATANA_LOG_DEBUG_ASSERT(!path_.empty());
+    : interned_(Intern(std::move(scheme), std::move(path))) {
+  KATANA_LOG_DEBUG_ASSERT(!interned_->scheme.empty());
+  KATANA_LOG_DEBUG_ASSERT(!interned_->path.empty());
 }
 
 Result<Uri>
@@ -140,16 +175,35 @@ Uri::MakeFromFile(const std::string& str) {
 
 Result<Uri>
 Uri::Make(const std::string& str) {
-  std::smatch sub_match;
-  if (!std::regex_match(str, sub_match, kUriRegex)) {
+  // An optional alphanumeric scheme followed by "://", then a non-empty path
+  // with at most one trailing separator dropped; hand-parsed because this is
+  // hot enough that regex allocations dominated storage addressing profiles
+  if (str.empty()) {
     return KATANA_ERROR(ErrorCode::InvalidArgument, "could not parse URI");
   }
-  std::string scheme(sub_match[1]);
-  std::string path(sub_match[2]);
+  std::string_view scheme;
+  std::string_view path = str;
+  size_t sep = path.find("://");
+  if (sep != std::string_view::npos && sep > 0 && sep + 3 < path.size()) {
+    bool alnum_scheme = true;
+    for (size_t i = 0; i < sep; ++i) {
+      if (std::isalnum(static_cast<unsigned char>(path[i])) == 0) {
+        alnum_scheme = false;
+        break;
+      }
+    }
+    if (alnum_scheme) {
+      scheme = path.substr(0, sep);
+      path = path.substr(sep + 3);
+    }
+  }
+  if (path.size() > 1 && path.back() == kSepChar) {
+    path.remove_suffix(1);
+  }
   if (scheme.empty()) {
-    return MakeFromFile(path);
+    return MakeFromFile(std::string(path));
   }
-  return Uri(scheme, path);
+  return Uri(std::string(scheme), std::string(path));
 }
 
 Result<Uri>
@@ -166,15 +220,6 @@ Uri::JoinPath(const std::string& dir, const std::string& file) {
   return DoJoinPath(dir, file);
 }
 
-bool
-Uri::empty() const {
-  if (scheme_.empty()) {
-    KATANA_LOG_DEBUG_ASSERT(path_.empty());
-    return true;
-  }
-  return false;
-}
-
 std::string
 Uri::Encode() const {
   return katana::ToBase64(string(), true);
@@ -187,7 +232,7 @@ Uri::BaseName() const {
 
 Uri
 Uri::DirName() const {
-  return Uri(scheme_, ExtractDirName(path()));
+  return Uri(scheme(), ExtractDirName(path()));
 }
 
 Uri
@@ -195,16 +240,16 @@ Uri::Join(std::string_view to_join) const {
   if (empty()) {
     return Uri();
   }
-  return Uri(scheme_, DoJoinPath(path_, to_join));
+  return Uri(scheme(), DoJoinPath(path(), to_join));
 }
 
 Uri
 Uri::StripSep() const {
-  std::string path = path_;
-  while (path[path.size() - 1] == kSepChar) {
-    path.pop_back();
+  std::string stripped = path();
+  while (stripped[stripped.size() - 1] == kSepChar) {
+    stripped.pop_back();
   }
-  return Uri(scheme_, path);
+  return Uri(scheme(), stripped);
 }
 
 Uri
@@ -212,11 +257,15 @@ Uri::RandFile(std::string_view prefix) const {
   if (empty()) {
     return Uri();
   }
-  return Uri(scheme_, NewPath(path_, prefix));
+  return Uri(scheme(), NewPath(path(), prefix));
 }
 
 bool
 operator==(const Uri& lhs, const Uri& rhs) {
+  // equal URIs usually share one interned copy
+  if (&lhs.string() == &rhs.string()) {
+    return true;
+  }
   return (lhs.scheme() == rhs.scheme()) && (lhs.path() == rhs.path());
 }
 
@@ -227,12 +276,12 @@ operator!=(const Uri& lhs, const Uri& rhs) {
 
 Uri
 Uri::operator+(char rhs) const {
-  return Uri(scheme_, path_ + rhs);
+  return Uri(scheme(), path() + rhs);
 }
 
 Uri
 Uri::operator+(const std::string& rhs) const {
-  return Uri(scheme_, path_ + rhs);
+  return Uri(scheme(), path() + rhs);
 }
 
 }  // namespace katana
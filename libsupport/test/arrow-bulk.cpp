@@ -0,0 +1,129 @@
+#include <memory>
+
+#include <arrow/api.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/Logging.h"
+
+namespace {
+
+std::shared_ptr<arrow::Array>
+MakeInt64Array(int64_t length, int64_t null_every) {
+  arrow::Int64Builder builder;
+  for (int64_t i = 0; i < length; ++i) {
+    if (null_every > 0 && i % null_every == 0) {
+      KATANA_LOG_ASSERT(builder.AppendNull().ok());
+    } else {
+      KATANA_LOG_ASSERT(builder.Append(i).ok());
+    }
+  }
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+  return array;
+}
+
+void
+TestBulkCast() {
+  std::shared_ptr<arrow::Array> array = MakeInt64Array(100, 7);
+
+  auto res = katana::BulkCast<arrow::DoubleType>(array);
+  KATANA_LOG_ASSERT(res);
+  const auto& casted = static_cast<const arrow::DoubleArray&>(*res.value());
+  KATANA_LOG_ASSERT(casted.length() == 100);
+  KATANA_LOG_ASSERT(casted.null_count() == array->null_count());
+  for (int64_t i = 0; i < 100; ++i) {
+    if (i % 7 == 0) {
+      KATANA_LOG_ASSERT(casted.IsNull(i));
+    } else {
+      KATANA_LOG_ASSERT(casted.Value(i) == static_cast<double>(i));
+    }
+  }
+
+  // non-numeric input is rejected, not mangled
+  arrow::StringBuilder sb;
+  KATANA_LOG_ASSERT(sb.Append("x").ok());
+  std::shared_ptr<arrow::Array> strings;
+  KATANA_LOG_ASSERT(sb.Finish(&strings).ok());
+  KATANA_LOG_ASSERT(!katana::BulkCast<arrow::DoubleType>(strings));
+}
+
+void
+TestBulkFill() {
+  auto res = katana::BulkFill<arrow::Int32Type>(1000, 42);
+  KATANA_LOG_ASSERT(res);
+  const auto& filled = static_cast<const arrow::Int32Array&>(*res.value());
+  KATANA_LOG_ASSERT(filled.length() == 1000);
+  KATANA_LOG_ASSERT(filled.null_count() == 0);
+  for (int64_t i = 0; i < 1000; ++i) {
+    KATANA_LOG_ASSERT(filled.Value(i) == 42);
+  }
+}
+
+void
+TestBulkSaturatingAdd() {
+  arrow::Int8Builder ba;
+  arrow::Int8Builder bb;
+  KATANA_LOG_ASSERT(ba.AppendValues({100, -100, 1, 5}).ok());
+  KATANA_LOG_ASSERT(bb.Append(100).ok());
+  KATANA_LOG_ASSERT(bb.Append(-100).ok());
+  KATANA_LOG_ASSERT(bb.Append(2).ok());
+  KATANA_LOG_ASSERT(bb.AppendNull().ok());
+  std::shared_ptr<arrow::Array> a;
+  std::shared_ptr<arrow::Array> b;
+  KATANA_LOG_ASSERT(ba.Finish(&a).ok());
+  KATANA_LOG_ASSERT(bb.Finish(&b).ok());
+
+  auto res = katana::BulkSaturatingAdd(a, b);
+  KATANA_LOG_ASSERT(res);
+  const auto& sum = static_cast<const arrow::Int8Array&>(*res.value());
+  KATANA_LOG_ASSERT(sum.Value(0) == std::numeric_limits<int8_t>::max());
+  KATANA_LOG_ASSERT(sum.Value(1) == std::numeric_limits<int8_t>::min());
+  KATANA_LOG_ASSERT(sum.Value(2) == 3);
+  KATANA_LOG_ASSERT(sum.IsNull(3));
+
+  // mismatched types are an error
+  std::shared_ptr<arrow::Array> wide = MakeInt64Array(4, 0);
+  KATANA_LOG_ASSERT(!katana::BulkSaturatingAdd(a, wide));
+}
+
+void
+TestBulkGather() {
+  std::shared_ptr<arrow::Array> values = MakeInt64Array(100, 7);
+
+  arrow::Int32Builder ib;
+  KATANA_LOG_ASSERT(ib.Append(99).ok());
+  KATANA_LOG_ASSERT(ib.Append(7).ok());  // selects a null value
+  KATANA_LOG_ASSERT(ib.AppendNull().ok());
+  KATANA_LOG_ASSERT(ib.Append(1).ok());
+  std::shared_ptr<arrow::Array> indices;
+  KATANA_LOG_ASSERT(ib.Finish(&indices).ok());
+
+  auto res = katana::BulkGather(values, indices);
+  KATANA_LOG_ASSERT(res);
+  const auto& gathered = static_cast<const arrow::Int64Array&>(*res.value());
+  KATANA_LOG_ASSERT(gathered.length() == 4);
+  KATANA_LOG_ASSERT(gathered.Value(0) == 99);
+  KATANA_LOG_ASSERT(gathered.IsNull(1));
+  KATANA_LOG_ASSERT(gathered.IsNull(2));
+  KATANA_LOG_ASSERT(gathered.Value(3) == 1);
+
+  // out-of-range index is an error
+  arrow::Int32Builder oob;
+  KATANA_LOG_ASSERT(oob.Append(100).ok());
+  std::shared_ptr<arrow::Array> bad;
+  KATANA_LOG_ASSERT(oob.Finish(&bad).ok());
+  KATANA_LOG_ASSERT(!katana::BulkGather(values, bad));
+}
+
+}  // namespace
+
+int
+main() {
+  TestBulkCast();
+
+  TestBulkFill();
+
+  TestBulkSaturatingAdd();
+
+  TestBulkGather();
+}
@@ -1,4 +1,5 @@
 #include <memory>
+#include <string>
 #include <type_traits>
 
 #include <arrow/api.h>
@@ -144,6 +145,120 @@ TestIsStringLikeTypePatchedNeeded() {
   KATANA_LOG_ASSERT(IsStringLikeTypePatchedNeeded<arrow::BooleanType>(nullptr));
 }
 
+struct SumBlockVisitor : public katana::ArrowVisitor {
+  using ResultType = katana::Result<void>;
+  using AcceptTypes = std::tuple<katana::AcceptNumericArrowTypes>;
+
+  template <typename ArrowType>
+  ResultType Call(const katana::ArrowBlock<typename ArrowType::c_type>& block) {
+    for (int64_t i = 0; i < block.length; ++i) {
+      if (block.IsValid(i)) {
+        total += block.values[i];
+      }
+    }
+    ++num_blocks;
+    return katana::ResultSuccess();
+  }
+
+  ResultType AcceptFailed(const arrow::Array& array) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "no matching type {}",
+        array.type()->name());
+  }
+
+  int64_t total{};
+  int64_t num_blocks{};
+};
+
+struct ConcatBlockVisitor : public katana::ArrowVisitor {
+  using ResultType = katana::Result<void>;
+  using AcceptTypes = std::tuple<katana::AcceptStringArrowTypes>;
+
+  template <typename ArrowType>
+  ResultType Call(
+      const katana::ArrowStringBlock<typename ArrowType::offset_type>& block) {
+    for (int64_t i = 0; i < block.length; ++i) {
+      if (block.IsValid(i)) {
+        arrow::util::string_view view = block.GetView(i);
+        all.append(view.data(), view.size());
+      }
+    }
+    return katana::ResultSuccess();
+  }
+
+  ResultType AcceptFailed(const arrow::Array& array) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "no matching type {}",
+        array.type()->name());
+  }
+
+  std::string all;
+};
+
+void
+TestNumericBlocks() {
+  arrow::Int64Builder builder;
+  int64_t expected = 0;
+  for (int64_t i = 0; i < 100; ++i) {
+    if (i % 10 == 0) {
+      KATANA_LOG_ASSERT(builder.AppendNull().ok());
+    } else {
+      KATANA_LOG_ASSERT(builder.Append(i).ok());
+      expected += i;
+    }
+  }
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+
+  SumBlockVisitor visitor;
+  auto res = katana::VisitArrowBlocks(visitor, *array, /*block_size=*/32);
+  KATANA_LOG_ASSERT(res);
+  KATANA_LOG_ASSERT(visitor.total == expected);
+  KATANA_LOG_ASSERT(visitor.num_blocks == 4);
+
+  // a slice must observe the same values through adjusted pointers
+  SumBlockVisitor slice_visitor;
+  res = katana::VisitArrowBlocks(slice_visitor, *array->Slice(50), 32);
+  KATANA_LOG_ASSERT(res);
+  int64_t slice_expected = 0;
+  for (int64_t i = 50; i < 100; ++i) {
+    if (i % 10 != 0) {
+      slice_expected += i;
+    }
+  }
+  KATANA_LOG_ASSERT(slice_visitor.total == slice_expected);
+}
+
+void
+TestStringBlocks() {
+  arrow::StringBuilder builder;
+  KATANA_LOG_ASSERT(builder.Append("abc").ok());
+  KATANA_LOG_ASSERT(builder.AppendNull().ok());
+  KATANA_LOG_ASSERT(builder.Append("de").ok());
+  KATANA_LOG_ASSERT(builder.Append("").ok());
+  KATANA_LOG_ASSERT(builder.Append("fgh").ok());
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+
+  ConcatBlockVisitor visitor;
+  auto res = katana::VisitArrowBlocks(visitor, *array, /*block_size=*/2);
+  KATANA_LOG_ASSERT(res);
+  KATANA_LOG_ASSERT(visitor.all == "abcdefgh");
+}
+
+void
+TestBlocksAcceptFailed() {
+  arrow::BooleanBuilder builder;
+  KATANA_LOG_ASSERT(builder.Append(true).ok());
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+
+  // booleans are bit-packed so there is no block view of them
+  SumBlockVisitor visitor;
+  auto res = katana::VisitArrowBlocks(visitor, *array);
+  KATANA_LOG_ASSERT(!res);
+}
+
 }  // namespace
 
 int
@@ -157,4 +272,10 @@ main() {
   TestMultipleParameters();
 
   TestTupleContains();
+
+  TestNumericBlocks();
+
+  TestStringBlocks();
+
+  TestBlocksAcceptFailed();
 }
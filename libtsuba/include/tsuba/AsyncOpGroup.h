@@ -27,6 +27,9 @@ public:
   /// wait for the op at the head of the list, return true if there was one
   bool FinishOne();
 
+  /// number of operations added but not yet completed
+  uint64_t outstanding() const { return pending_ops_.size(); }
+
 private:
   std::list<AsyncOp> pending_ops_;
   uint64_t errors_{0};
@@ -0,0 +1,51 @@
+#ifndef KATANA_LIBTSUBA_TSUBA_COMPRESSEDTOPOLOGY_H_
+#define KATANA_LIBTSUBA_TSUBA_COMPRESSEDTOPOLOGY_H_
+
+#include <array>
+#include <cstdint>
+
+namespace tsuba {
+
+/// Optional container format for CSR topology files. The raw GR layout
+/// (see CSRTopology.h) is cut into zstd frames of at most kTopologyChunkSize
+/// raw bytes each. The first frame decodes to exactly the CSR header, and no
+/// frame crosses the boundary between the out index array and the edge
+/// destinations, so readers can decode frames independently (and in
+/// parallel) straight into their target arrays, and RDGPrefix can recover
+/// the header and out index array without transferring the destinations.
+///
+/// File layout:
+///   CompressedTopologyHeader
+///   CompressedTopologyChunk[num_chunks]  frame directory, in file order
+///   zstd frames, back to back
+
+constexpr std::array<char, 8> kCompressedTopologyMagic = {
+    'k', 'a', 't', 'z', 's', 't', 'd', '1'};
+
+struct CompressedTopologyHeader {
+  std::array<char, 8> magic;
+  /// size of the raw CSR file the frames decode to
+  uint64_t raw_size{0};
+  /// bytes of the raw file holding the CSR header plus the out index array;
+  /// no frame crosses this boundary
+  uint64_t index_bytes{0};
+  uint64_t num_chunks{0};
+};
+
+struct CompressedTopologyChunk {
+  uint64_t raw_size{0};
+  uint64_t compressed_size{0};
+};
+
+/// The most raw bytes a single frame may decode to
+constexpr uint64_t kTopologyChunkSize = UINT64_C(64) << 20;
+
+constexpr uint64_t
+CompressedTopologyFramesOffset(const CompressedTopologyHeader& header) {
+  return sizeof(CompressedTopologyHeader) +
+         header.num_chunks * sizeof(CompressedTopologyChunk);
+}
+
+}  // namespace tsuba
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef KATANA_LIBTSUBA_TSUBA_FILEFRAMESTREAM_H_
+#define KATANA_LIBTSUBA_TSUBA_FILEFRAMESTREAM_H_
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <parquet/arrow/writer.h>
+
+#include "katana/Logging.h"
+#include "katana/Result.h"
+
+namespace tsuba {
+
+/// FileFrameStream is the bounded-memory alternative to \ref FileFrame: where
+/// FileFrame buffers the whole serialized file before Persist, this stream
+/// hands fixed-size chunks to the storage backend's streaming put
+/// (append/multipart upload) as they fill, overlapping upload with
+/// serialization. At most two chunks are live at a time (one filling, one in
+/// flight), so memory is capped at roughly twice the chunk size regardless of
+/// file size.
+///
+/// Only usable against backends whose \ref FileStorage::SupportsStreamingPut
+/// is true; check \ref Supports first and fall back to FileFrame otherwise.
+class KATANA_EXPORT FileFrameStream : public arrow::io::OutputStream {
+  std::string path_;
+  uint64_t chunk_size_{0};
+  uint64_t cursor_{0};
+  std::vector<uint8_t> chunk_;
+  // previous chunk and its in-flight put; waited on before the next flush so
+  // parts arrive in order and memory stays bounded
+  std::vector<uint8_t> flushing_;
+  std::future<katana::CopyableResult<void>> flush_;
+  bool started_ = false;
+  bool valid_ = false;
+  bool finished_ = false;
+
+  katana::Result<void> FlushChunk();
+
+public:
+  constexpr static uint64_t kDefaultChunkSize = UINT64_C(64) << 20;
+
+  FileFrameStream() = default;
+  FileFrameStream(const FileFrameStream&) = delete;
+  FileFrameStream& operator=(const FileFrameStream&) = delete;
+
+  ~FileFrameStream() override;
+
+  /// \returns true when the backend for uri can accept streaming puts
+  static bool Supports(std::string_view uri);
+
+  katana::Result<void> Init(uint64_t chunk_size);
+  katana::Result<void> Init() { return Init(kDefaultChunkSize); }
+  void Bind(std::string_view filename);
+
+  /// Flush the tail chunk and complete the object; no writes may follow
+  katana::Result<void> Finish();
+
+  const std::string& path() const { return path_; }
+
+  ///// Begin arrow::io::OutputStream methods ///////
+
+  arrow::Status Close() override;
+  arrow::Result<int64_t> Tell() const override;
+  bool closed() const override;
+  arrow::Status Write(const void* data, int64_t nbytes) override;
+  arrow::Status Write(const std::shared_ptr<arrow::Buffer>& data) override;
+
+  ///// End arrow::io::OutputStream methods ///////
+};
+
+} /* namespace tsuba */
+
+#endif
@@ -39,6 +39,17 @@ public:
   virtual katana::Result<void> PutMultiSync(
       const std::string& uri, const uint8_t* data, uint64_t size) = 0;
 
+  /// Streaming puts assemble an object from ordered parts so writers do not
+  /// have to materialize the whole object in memory; see \ref
+  /// FileFrameStream. Backends map them onto appends or multipart uploads
+  /// and report support with SupportsStreamingPut; the defaults return
+  /// NotImplemented so callers can fall back to a single PutMultiSync.
+  virtual bool SupportsStreamingPut() const { return false; }
+  virtual katana::Result<void> PutStreamingStart(const std::string& uri);
+  virtual katana::Result<void> PutStreamingPart(
+      const std::string& uri, const uint8_t* data, uint64_t size);
+  virtual katana::Result<void> PutStreamingFinish(const std::string& uri);
+
   virtual katana::Result<void> RemoteCopy(
       const std::string& source_uri, const std::string& dest_uri,
       uint64_t begin, uint64_t size) = 0;
@@ -57,6 +68,15 @@ public:
   virtual std::future<katana::CopyableResult<void>> ListAsync(
       const std::string& directory, std::vector<std::string>* list,
       std::vector<uint64_t>* size) = 0;
+
+  /// Like ListAsync but returns only entries whose names begin with
+  /// \p prefix. The default lists everything and filters client side;
+  /// backends that can push the prefix into the store or shard a large
+  /// directory should override this, since callers use it to avoid paying
+  /// for full listings of big versioned stores.
+  virtual std::future<katana::CopyableResult<void>> ListPrefixAsync(
+      const std::string& directory, const std::string& prefix,
+      std::vector<std::string>* list, std::vector<uint64_t>* size);
   virtual katana::Result<void> Delete(
       const std::string& directory,
       const std::unordered_set<std::string>& files) = 0;
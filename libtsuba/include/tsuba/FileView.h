@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <future>
+#include <list>
 #include <optional>
 #include <string>
 
@@ -29,8 +30,17 @@ public:
         filename_(std::move(other.filename_)),
         bound_(other.bound_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        last_read_end_(other.last_read_end_),
+        last_stride_(other.last_stride_),
+        read_ahead_(other.read_ahead_),
+        pinned_first_page_(other.pinned_first_page_),
+        pinned_last_page_(other.pinned_last_page_),
+        has_pinned_range_(other.has_pinned_range_),
+        evictable_lru_(std::move(other.evictable_lru_)),
+        resident_bytes_(other.resident_bytes_) {
     other.bound_ = false;
+    other.resident_bytes_ = 0;
   }
 
   FileView& operator=(FileView&& other) noexcept {
@@ -48,7 +58,16 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      last_read_end_ = other.last_read_end_;
+      last_stride_ = other.last_stride_;
+      read_ahead_ = other.read_ahead_;
+      pinned_first_page_ = other.pinned_first_page_;
+      pinned_last_page_ = other.pinned_last_page_;
+      has_pinned_range_ = other.has_pinned_range_;
+      evictable_lru_ = std::move(other.evictable_lru_);
+      resident_bytes_ = other.resident_bytes_;
       other.bound_ = false;
+      other.resident_bytes_ = 0;
     }
     return *this;
   }
@@ -128,6 +147,25 @@ public:
 
   ///// End arrow::io::RandomAccessFile methods ///////
 
+  /// Wait for all outstanding asynchronous reads that overlap with the range
+  /// [start, start + size). Calls to Read do this internally, but a view
+  /// bound with resolve=false must be resolved before its contents are
+  /// accessed through ptr()
+  katana::Result<void> Resolve(int64_t start, int64_t size);
+
+  /// Release every evictable resident range of this view back to the OS.
+  /// The range bound at Bind() time stays resident (it may be accessed
+  /// through ptr()); pages pulled in later by Read and its readahead are
+  /// dropped with madvise(MADV_DONTNEED) and refetched from storage by the
+  /// next Read that touches them. Useful for idle views in long-running
+  /// processes. Not thread safe with respect to concurrent Reads.
+  katana::Result<void> EvictResident();
+
+  /// Bytes currently resident across every FileView in the process.
+  static uint64_t ProcessResidentBytes();
+  /// Bytes evicted over the lifetime of the process.
+  static uint64_t ProcessEvictedBytes();
+
 private:
   // Given the size of some region, how many pages does it take up?
   uint64_t page_number(uint64_t size);
@@ -149,11 +187,40 @@ private:
   katana::Result<void> MarkFilled(
       uint64_t* bitmap, uint64_t begin, uint64_t end);
 
-  // Resolve all outstanding reads that overlap with the range [cursor_, nbytes]
-  katana::Result<void> Resolve(int64_t start, int64_t size);
+  katana::Result<void> MarkUnfilled(
+      uint64_t* bitmap, uint64_t begin, uint64_t end);
+
+  /// A filled page range eligible for eviction; front of evictable_lru_ is
+  /// the most recently touched
+  struct ResidentRange {
+    uint64_t first_page;
+    uint64_t last_page;
+  };
+
+  uint64_t RangeBytes(uint64_t first_page, uint64_t last_page) const;
+
+  // Record a newly filled page range: account its bytes and, for the parts
+  // outside the pinned Bind-time range, make it evictable
+  void RecordFilled(uint64_t first_page, uint64_t last_page);
+
+  // Move resident ranges that overlap [start, start + size) to the front of
+  // the LRU list
+  void TouchResident(int64_t start, int64_t size);
+
+  // madvise away one range and clear its fill bits so the next Read
+  // refetches it
+  katana::Result<void> EvictRange(const ResidentRange& range);
+
+  // Evict least recently touched ranges of this view until the process is
+  // back under KATANA_FILEVIEW_BUDGET_MB; ranges with a fetch in flight are
+  // skipped
+  katana::Result<void> EvictToBudget();
 
   // Start asynchronously fetching data that we think we might need from storage
-  // @start and @size give the location and range of the previous read
+  // @start and @size give the location and range of the previous read.
+  // Consecutive reads that advance sequentially (or by a constant stride)
+  // widen the readahead window so fetches run ahead of the reader; the window
+  // is capped by KATANA_READAHEAD_WINDOW_MB (default 64)
   katana::Result<void> PreFetch(int64_t start, int64_t size);
 
   struct FillingRange {
@@ -171,6 +238,22 @@ private:
   bool bound_{false};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
+
+  // readahead state for PreFetch: where the previous read ended, the gap
+  // between the previous two reads, and the current window in bytes (zero
+  // until an access pattern has been detected)
+  int64_t last_read_end_{-1};
+  int64_t last_stride_{0};
+  uint64_t read_ahead_{0};
+
+  // eviction state: the Bind-time range is pinned because callers may hold
+  // ptr()s into it; everything else filled later is tracked in an LRU list
+  // and counted against the process-wide budget
+  uint64_t pinned_first_page_{0};
+  uint64_t pinned_last_page_{0};
+  bool has_pinned_range_{false};
+  std::list<ResidentRange> evictable_lru_;
+  uint64_t resident_bytes_{0};
 };
 }  // namespace tsuba
 
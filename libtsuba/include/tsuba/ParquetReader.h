@@ -35,6 +35,42 @@ public:
     static ReadOpts Defaults() { return ReadOpts{}; }
   };
 
+  /// Sampled statistics for one column; see SampleTable
+  struct ColumnSketch {
+    std::string column;
+    /// rows actually read to build the sketch
+    int64_t rows_read{0};
+    /// HyperLogLog estimate of the number of distinct values among the
+    /// rows read; scale by the sampled fraction with care, heavy-hitter
+    /// columns do not extrapolate linearly
+    double approx_distinct{0};
+    /// uniform reservoir over the rows read, usable as an equi-depth
+    /// histogram after sorting; only numeric columns fill this
+    std::vector<double> reservoir;
+  };
+
+  struct SampleOpts {
+    /// total rows to read, spread over the table in contiguous runs so
+    /// only the row groups the runs touch are decoded
+    int64_t max_rows{64 * 1024};
+    /// number of evenly spaced runs the sampled rows are split into;
+    /// more runs cost more row-group decodes but see more of the table
+    int64_t num_runs{8};
+    /// reservoir capacity per column
+    int64_t reservoir_size{1024};
+    uint32_t seed{0};
+    static SampleOpts Defaults() { return SampleOpts{}; }
+  };
+
+  /// Build a reservoir sample and a distinct-count sketch for every
+  /// column of a table without materializing it: evenly spaced runs of
+  /// rows are read through the slice machinery, so only the row groups
+  /// they overlap are decoded, and the columns are sketched in parallel.
+  ///   \param uri an identifier for a parquet file
+  ///   \param opts sample sizes; see the SampleOpts definition
+  katana::Result<std::vector<ColumnSketch>> SampleTable(
+      const katana::Uri& uri, SampleOpts opts = SampleOpts::Defaults());
+
   /// build a reader that will read a table from storage location optionally
   /// reading only part of the table.
   /// \param opts an opt structure detailing how reads should behave (see
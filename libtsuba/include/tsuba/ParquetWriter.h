@@ -5,6 +5,7 @@
 #include <vector>
 
 #include <arrow/api.h>
+#include <arrow/util/compression.h>
 #include <parquet/properties.h>
 
 #include "katana/Result.h"
@@ -31,9 +32,53 @@ public:
 
     /// control the approximate size of blocked files when writing blocked
     uint64_t mbs_per_block{256};
+
+    /// Compression choice for one column, or the table-wide default when
+    /// \ref column is empty. SuggestCompression builds a ready-made list
+    /// of these by sampling the table.
+    struct ColumnCompression {
+      /// name of the column this entry applies to; empty for the default
+      std::string column;
+      arrow::Compression::type codec{arrow::Compression::SNAPPY};
+      /// codec-specific level; kUseDefaultCompressionLevel leaves the
+      /// codec's own default in place
+      int level{arrow::util::kUseDefaultCompressionLevel};
+      /// write the column with the BYTE_STREAM_SPLIT encoding, which
+      /// groups the i-th byte of every value together before compression;
+      /// float and double columns compress substantially better this way.
+      /// Per-column only; dictionary encoding is disabled for the column.
+      bool byte_stream_split{false};
+    };
+
+    /// Per-column codec and level overrides, applied in order. Entries
+    /// from the KATANA_PARQUET_COMPRESSION environment variable still win
+    /// over these.
+    std::vector<ColumnCompression> compression;
+
+    /// Encode large tables as several segments in parallel. A table
+    /// bigger than parallel_encode_min_mbs is sliced into up to one
+    /// segment per core, each segment is encoded and compressed into its
+    /// own file frame concurrently, and the segments are stitched back
+    /// into one logical table with the part-file offset manifest the read
+    /// path already resolves transparently. Compression then scales with
+    /// cores instead of occupying one.
+    bool parallel_encode{false};
+
+    /// tables smaller than this are not worth splitting
+    uint64_t parallel_encode_min_mbs{256};
+
     static WriteOpts Defaults() { return WriteOpts{}; }
   };
 
+  /// Sample every column of \p table and suggest a compression entry per
+  /// column where the default is a bad trade: float and double columns
+  /// that compress get zstd with byte-stream-split, columns whose sample
+  /// barely shrinks are written uncompressed, and everything else keeps
+  /// the table default. The result can be assigned to
+  /// WriteOpts::compression as-is. Only fixed-width columns are sampled.
+  static katana::Result<std::vector<WriteOpts::ColumnCompression>>
+  SuggestCompression(const std::shared_ptr<arrow::Table>& table);
+
   /// \returns a Writer that will write a table consisting of a single column
   /// \param array will become the lone column in the table
   /// \param name will become the name of the column in the table
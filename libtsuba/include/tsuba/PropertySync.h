@@ -0,0 +1,42 @@
+#ifndef KATANA_LIBTSUBA_TSUBA_PROPERTYSYNC_H_
+#define KATANA_LIBTSUBA_TSUBA_PROPERTYSYNC_H_
+
+#include <cstdint>
+#include <string>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace tsuba {
+
+class RDG;
+
+/// A half-open row range [row_begin, row_end) of a property column whose
+/// values changed since the last synchronization. Writers record these
+/// through RDG::MarkNodePropertyDirty and RDG::MarkEdgePropertyDirty;
+/// BroadcastPropertyDeltas consumes them.
+struct KATANA_EXPORT PropertyDirtyRange {
+  std::string property_name;
+  uint64_t row_begin{0};
+  uint64_t row_end{0};
+};
+
+/// Ship the dirty property ranges recorded on \p root to every other host
+/// and patch the corresponding columns in place, so replicas of a graph can
+/// be refreshed after an ingest batch without reloading the whole RDG.
+///
+/// The root serializes one raw value-buffer slice per dirty range and
+/// broadcasts it over the comm backend; replicas rebuild only the arrow
+/// chunks that overlap each range. On success the dirty ranges are cleared
+/// on all hosts. Collective: every host must call this with the same root,
+/// and all hosts agree on the outcome before any of them continues.
+///
+/// Only fixed-width property columns can be synchronized, and a delta must
+/// not change which rows are null; validity bitmaps are not shipped. With a
+/// single host this clears the dirty ranges and returns.
+KATANA_EXPORT katana::Result<void> BroadcastPropertyDeltas(
+    RDG* rdg, uint32_t root = 0);
+
+}  // namespace tsuba
+
+#endif
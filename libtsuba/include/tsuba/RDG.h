@@ -20,6 +20,7 @@
 #include "tsuba/FileView.h"
 #include "tsuba/PartitionMetadata.h"
 #include "tsuba/PropertyCache.h"
+#include "tsuba/PropertySync.h"
 #include "tsuba/RDGLineage.h"
 #include "tsuba/ReadGroup.h"
 #include "tsuba/WriteGroup.h"
@@ -29,8 +30,62 @@ namespace tsuba {
 
 class RDGManifest;
 class RDGCore;
+class RDGPrefetch;
 class PropStorageInfo;
 
+/// Per-block min/max summary (zone map) for a numeric property column,
+/// computed when the property is written. Each block covers kRowsPerBlock
+/// consecutive rows (the last block may cover fewer). Bounds are stored as
+/// doubles and widened when a value cannot be represented exactly, so they
+/// are conservative: a block whose bounds exclude a query range definitely
+/// holds no qualifying rows. Blocks containing only nulls get inverted
+/// bounds so they never qualify.
+struct PropertyZoneMap {
+  static constexpr int64_t kRowsPerBlock = 64 * 1024;
+
+  std::vector<double> mins;
+  std::vector<double> maxs;
+};
+
+/// Sampled statistics for one property column: a uniform reservoir of
+/// values (numeric columns only, usable as an equi-depth histogram) and a
+/// HyperLogLog distinct-count estimate, typically built with
+/// ParquetReader::SampleTable. Persisted with the part header so planner
+/// warmup reuses them instead of re-reading columns; dropped when the
+/// column is rewritten or removed.
+struct PropertySketch {
+  /// rows read to build the sketch; the column may hold more
+  int64_t rows_read{0};
+  double approx_distinct{0};
+  std::vector<double> reservoir;
+};
+
+/// One contiguous run of rows materialized by a zone-map range scan
+struct PropertySlice {
+  /// row id of the first row of table within the property column
+  int64_t row_offset;
+  std::shared_ptr<arrow::Table> table;
+};
+
+/// What one committed version changed relative to its predecessor. The
+/// store path writes one of these next to every version-incrementing
+/// manifest so incremental consumers can process O(delta) instead of
+/// re-scanning the whole graph; query them with RDG::ChangesSince.
+struct KATANA_EXPORT RDGChangeSet {
+  /// the version this change set produced
+  uint64_t version{0};
+  /// a new topology file was written this commit; edges were inserted or
+  /// removed (the CSR commit does not record which individual edges, so a
+  /// topology diff is still needed, but only for versions with this set)
+  bool topology_changed{false};
+  /// node properties whose column files were rewritten this commit; any
+  /// row of a listed column may differ from the previous version,
+  /// unlisted columns are byte-identical
+  std::vector<std::string> node_properties;
+  /// edge properties whose column files were rewritten this commit
+  std::vector<std::string> edge_properties;
+};
+
 struct KATANA_EXPORT RDGLoadOptions {
   /// Which partition of the RDG on storage should be loaded
   /// nullopt means the partition associated with the current host's ID will be
@@ -46,6 +101,16 @@ struct KATANA_EXPORT RDGLoadOptions {
   // Callback provides a pointer to the RDG so we can evict
   // even before the PropertyGraph is created.
   tsuba::PropertyCache* prop_cache{nullptr};
+  /// Keep the topology backed by the memory-mapped topology file and fault
+  /// pages in on demand instead of eagerly copying it into NUMA arrays.
+  /// Use GraphTopology::Prefetch to warm node ranges ahead of traversal.
+  bool lazy_topology{false};
+  /// Do not load any properties up front (unless node_properties or
+  /// edge_properties hand-picks some); name-based property accessors fault
+  /// columns in from storage on first touch and register them with
+  /// prop_cache. Index-based accessors and the loaded schemas only see
+  /// columns that have been faulted in.
+  bool lazy_properties{false};
 };
 
 class KATANA_EXPORT RDG {
@@ -153,6 +218,34 @@ public:
   katana::Result<void> RemoveNodeProperty(int i);
   katana::Result<void> RemoveEdgeProperty(int i);
 
+  /// Record that rows [row_begin, row_end) of the named node property were
+  /// modified in place, so BroadcastPropertyDeltas can ship only the
+  /// changed values to replicas instead of the whole column
+  void MarkNodePropertyDirty(
+      const std::string& name, uint64_t row_begin, uint64_t row_end);
+
+  /// Record that rows [row_begin, row_end) of the named edge property were
+  /// modified in place
+  void MarkEdgePropertyDirty(
+      const std::string& name, uint64_t row_begin, uint64_t row_end);
+
+  const std::vector<PropertyDirtyRange>& node_dirty_ranges() const;
+  const std::vector<PropertyDirtyRange>& edge_dirty_ranges() const;
+
+  /// Forget all recorded dirty ranges without synchronizing them
+  void ClearDirtyPropertyRanges();
+
+  /// Attach sampled statistics to the named node property; persisted with
+  /// the part header on the next store and dropped when the column is
+  /// rewritten or removed
+  void SetNodePropertySketch(const std::string& name, PropertySketch sketch);
+  void SetEdgePropertySketch(const std::string& name, PropertySketch sketch);
+
+  /// \returns the stored sketch for the named node property, or nullptr
+  /// if none was attached
+  const PropertySketch* GetNodePropertySketch(const std::string& name) const;
+  const PropertySketch* GetEdgePropertySketch(const std::string& name) const;
+
   /// Ensure the node property at index `i` was written back to storage
   /// then free its memory
   katana::Result<void> UnloadNodeProperty(int i);
@@ -183,6 +276,15 @@ public:
   /// Load the RDG described by the metadata in handle into memory.
   static katana::Result<RDG> Make(RDGHandle handle, const RDGLoadOptions& opts);
 
+  /// Begin a pipelined load of the RDG described by the metadata in handle.
+  /// The partition header, topology, and entity type ID array file storage
+  /// are bound before returning, while property decode continues on
+  /// background threads. The caller may use the returned prefetch's RDG to
+  /// build derived topology structures in the meantime and must call
+  /// RDGPrefetch::Finish to obtain the fully loaded RDG.
+  static katana::Result<RDGPrefetch> MakePrefetch(
+      RDGHandle handle, const RDGLoadOptions& opts);
+
   katana::Result<void> UnbindTopologyFileStorage();
 
   /// Inform this RDG that its topology is in storage at this location
@@ -209,6 +311,49 @@ public:
   katana::Result<void> SetEdgeEntityTypeIDArrayFile(
       const katana::Uri& new_type_id_array);
 
+  /// Persist a property index for the named node property column. The
+  /// serialized form is the index's sorted id permutation as a flat array.
+  /// The file is written eagerly; the part header records it at the next
+  /// Store.
+  katana::Result<void> WriteNodePropertyIndex(
+      RDGHandle handle, const std::string& column_name, const uint8_t* data,
+      uint64_t size);
+
+  katana::Result<void> WriteEdgePropertyIndex(
+      RDGHandle handle, const std::string& column_name, const uint8_t* data,
+      uint64_t size);
+
+  /// Bind the persisted property index for the named node property column.
+  /// The read is issued asynchronously; the caller resolves the returned
+  /// view before accessing its contents, so binding early overlaps the
+  /// transfer with other load work. Returns NotFound if no index for the
+  /// column is stored.
+  katana::Result<FileView> LoadNodePropertyIndex(
+      const std::string& column_name) const;
+
+  katana::Result<FileView> LoadEdgePropertyIndex(
+      const std::string& column_name) const;
+
+  /// Materialize from storage the runs of rows of the named node property
+  /// whose value may lie in [lower, upper], both inclusive. Blocks whose
+  /// zone map bounds exclude the range are skipped, and only the row groups
+  /// overlapping the surviving runs are read; the returned slices can
+  /// contain non-qualifying rows, so callers must still filter. Properties
+  /// without a zone map are returned as a single full slice.
+  katana::Result<std::vector<PropertySlice>> ScanNodePropertyRange(
+      const std::string& property_name, double lower, double upper) const;
+
+  katana::Result<std::vector<PropertySlice>> ScanEdgePropertyRange(
+      const std::string& property_name, double lower, double upper) const;
+
+  /// Read the change feed for the RDG behind \p handle: one RDGChangeSet
+  /// per committed version after \p since_version, ascending, up to and
+  /// including the handle's current version. Fails if any version in the
+  /// range has no change set (it predates the feed or was written by
+  /// another tool); callers should fall back to a full diff in that case.
+  static katana::Result<std::vector<RDGChangeSet>> ChangesSince(
+      RDGHandle handle, uint64_t since_version);
+
   //
   // accessors and mutators
   //
@@ -284,15 +429,33 @@ private:
       const std::vector<PropStorageInfo*>& edge_props_to_be_loaded,
       const katana::Uri& metadata_dir);
 
+  /// The scheduling half of DoMake: binds the topology and entity type ID
+  /// array file storage and queues property decode on \p grp without
+  /// waiting for it.
+  /// \returns true if partition metadata properties were also queued and
+  /// FinishMake must run the partition fix-ups after joining \p grp.
+  katana::Result<bool> DoMakeAsync(
+      const std::vector<PropStorageInfo*>& node_props_to_be_loaded,
+      const std::vector<PropStorageInfo*>& edge_props_to_be_loaded,
+      const katana::Uri& metadata_dir, ReadGroup* grp);
+
+  /// The joining half of DoMake: waits for the decode queued by DoMakeAsync
+  /// and applies the partition metadata fix-ups.
+  katana::Result<void> FinishMake(
+      ReadGroup* grp, bool partition_metadata_scheduled);
+
   static katana::Result<RDG> Make(
       const RDGManifest& manifest, const RDGLoadOptions& opts);
 
+  static katana::Result<RDGPrefetch> MakePrefetch(
+      const RDGManifest& manifest, const RDGLoadOptions& opts);
+
   katana::Result<std::vector<tsuba::PropStorageInfo>> WritePartArrays(
       const katana::Uri& dir, tsuba::WriteGroup* desc);
 
   katana::Result<void> DoStore(
       RDGHandle handle, const std::string& command_line,
-      RDGVersioningPolicy versioning_action,
+      RDGVersioningPolicy versioning_action, bool topology_changed,
       std::unique_ptr<WriteGroup> write_group);
 
   katana::Result<void> DoStoreTopology(
@@ -314,6 +477,37 @@ private:
   std::unique_ptr<RDGCore> core_;
   // Optional property cache
   tsuba::PropertyCache* prop_cache_{nullptr};
+
+  friend class RDGPrefetch;
+};
+
+/// The in-flight state of a pipelined load started by RDG::MakePrefetch.
+/// The partition header and the topology and entity type ID array file
+/// storage of rdg() are bound and safe to read; the property tables are
+/// still being decoded and must not be touched until Finish() returns.
+class KATANA_EXPORT RDGPrefetch {
+public:
+  const RDG& rdg() const { return *rdg_; }
+
+  /// Join the property decode queued by RDG::MakePrefetch and yield the
+  /// fully loaded RDG.
+  katana::Result<RDG> Finish() &&;
+
+private:
+  friend class RDG;
+
+  RDGPrefetch(
+      std::unique_ptr<RDG> rdg, std::unique_ptr<ReadGroup> grp,
+      bool partition_metadata_scheduled)
+      : rdg_(std::move(rdg)),
+        grp_(std::move(grp)),
+        partition_metadata_scheduled_(partition_metadata_scheduled) {}
+
+  // The decode futures hold a pointer to the RDG, so it must stay at a
+  // stable address until Finish() joins them.
+  std::unique_ptr<RDG> rdg_;
+  std::unique_ptr<ReadGroup> grp_;
+  bool partition_metadata_scheduled_;
 };
 
 }  // namespace tsuba
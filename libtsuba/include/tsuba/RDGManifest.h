@@ -36,6 +36,11 @@ class KATANA_EXPORT RDGManifest {
   std::string view_type_;
   std::vector<std::string> view_args_;
 
+  // Partition file addresses are requested for every host on each open;
+  // assemble each once and reuse it. Indexed by host id and invalidated by
+  // the setters that change what the names would be.
+  mutable std::vector<katana::Uri> part_file_cache_;
+
   RDGManifest(katana::Uri dir)
       : dir_(std::move(dir)), view_type_(kDefaultRDGViewType) {}
   RDGManifest(katana::Uri dir, const std::string& view_type)
@@ -104,13 +109,25 @@ public:
   uint32_t policy_id() const { return policy_id_; }
   uint64_t previous_version() const { return previous_version_; }
   const std::string& viewtype() const { return view_type_; }
-  void set_viewtype(std::string v) { view_type_ = v; }
-  void set_viewargs(std::vector<std::string> v) { view_args_ = v; }
+  void set_viewtype(std::string v) {
+    view_type_ = v;
+    part_file_cache_.clear();
+  }
+  void set_viewargs(std::vector<std::string> v) {
+    view_args_ = v;
+    part_file_cache_.clear();
+  }
   const std::string& view_type() const { return view_type_; }
   bool transpose() const { return transpose_; }
 
-  void set_dir(katana::Uri dir) { dir_ = std::move(dir); }
-  void set_version(uint64_t version) { version_ = version; }
+  void set_dir(katana::Uri dir) {
+    dir_ = std::move(dir);
+    part_file_cache_.clear();
+  }
+  void set_version(uint64_t version) {
+    version_ = version;
+    part_file_cache_.clear();
+  }
   void set_prev_version(uint64_t prev_version) {
     previous_version_ = prev_version;
   }
@@ -125,6 +142,11 @@ public:
 
   katana::Uri FileName() { return FileName(dir_, view_specifier(), version_); }
 
+  /// Name prefix shared by every manifest file; lets directory listings that
+  /// only need manifests (e.g. finding the latest version) prefix-filter
+  /// instead of returning every member file
+  constexpr static const char* kFileNamePrefix = "katana_vers";
+
   // Canonical naming
   static katana::Uri FileName(
       const katana::Uri& uri, const std::string& view_type, uint64_t version);
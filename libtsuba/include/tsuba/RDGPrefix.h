@@ -2,8 +2,10 @@
 #define KATANA_LIBTSUBA_TSUBA_RDGPREFIX_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "tsuba/CSRTopology.h"
+#include "tsuba/CompressedTopology.h"
 #include "tsuba/FileView.h"
 #include "tsuba/tsuba.h"
 
@@ -43,13 +45,25 @@ private:
         view_offset_(view_offset),
         prefix_(prefix_storage_.ptr<CSRTopologyPrefix>()) {}
 
+  /// prefix decoded out of a compressed topology; the bytes live in
+  /// owned_prefix_ instead of a file mapping
+  RDGPrefix(std::vector<uint8_t>&& owned_prefix, uint64_t view_offset)
+      : view_offset_(view_offset),
+        owned_prefix_(std::move(owned_prefix)),
+        prefix_(
+            reinterpret_cast<const CSRTopologyPrefix*>(owned_prefix_.data())) {
+  }
+
   RDGPrefix() = default;
 
   FileView prefix_storage_;
   uint64_t view_offset_;
+  std::vector<uint8_t> owned_prefix_;
   const CSRTopologyPrefix* prefix_{nullptr};
 
   static katana::Result<RDGPrefix> DoMakePrefix(const RDGManifest& manifest);
+  static katana::Result<RDGPrefix> MakeCompressedPrefix(
+      const katana::Uri& t_path, const CompressedTopologyHeader& header);
 };
 
 }  // namespace tsuba
@@ -17,6 +17,7 @@ namespace tsuba {
 
 class RDGManifest;
 class RDGCore;
+struct PartitionMetadata;
 
 /// A read-only contiguous piece of a partition.
 ///
@@ -53,6 +54,31 @@ public:
       const std::optional<std::vector<std::string>>& node_props = std::nullopt,
       const std::optional<std::vector<std::string>>& edge_props = std::nullopt);
 
+  /// Load this host's contiguous share of an unpartitioned RDG, coordinated
+  /// across the hosts of the CommBackend passed to tsuba::Init.
+  ///
+  /// Nodes are split evenly across hosts at CSR node boundaries, so each
+  /// host's outgoing edges, properties, and type arrays form contiguous
+  /// slices. Each host reads only the fixed-size topology header and the two
+  /// out-index entries at its own cut points; the per-host edge cuts are
+  /// then exchanged over the CommBackend instead of every host re-reading
+  /// the out-index prefix. All hosts load their slices concurrently, and the
+  /// call fails on every host if it failed on any.
+  ///
+  /// \param metadata if non-null, filled with this host's share of the
+  ///     global graph (global and local node/edge counts)
+  /// \param all_slices if non-null, filled with every host's slice so
+  ///     callers know which host owns a given node or edge range; entry i is
+  ///     host i's slice
+  ///
+  /// With the NullCommBackend this degenerates to loading the whole graph.
+  static katana::Result<RDGSlice> MakePartitioned(
+      const std::string& rdg_manifest_path,
+      const std::optional<std::vector<std::string>>& node_props = std::nullopt,
+      const std::optional<std::vector<std::string>>& edge_props = std::nullopt,
+      PartitionMetadata* metadata = nullptr,
+      std::vector<SliceArg>* all_slices = nullptr);
+
   // metadata sorts of things
   const katana::Uri& rdg_dir() const;
   uint32_t partition_id() const;
@@ -1,6 +1,7 @@
 #ifndef KATANA_LIBTSUBA_TSUBA_WRITEGROUP_H_
 #define KATANA_LIBTSUBA_TSUBA_WRITEGROUP_H_
 
+#include <functional>
 #include <future>
 #include <list>
 #include <memory>
@@ -40,6 +41,20 @@ public:
   /// Wait until all operations this descriptor knows about have completed
   katana::Result<void> Finish();
 
+  /// Finish \p group on a background thread, then run \p on_drained (e.g.
+  /// publishing a manifest once every data file has landed). At most one
+  /// group drains this way: the next Make() waits for it first and
+  /// propagates its error, so callers overlap building the next batch with
+  /// the previous flush (double buffering) and a failed flush fails the
+  /// following batch instead of being dropped.
+  static void DrainAsync(
+      std::unique_ptr<WriteGroup> group,
+      std::function<katana::CopyableResult<void>()> on_drained);
+
+  /// Wait for any group handed to DrainAsync and return its result; safe to
+  /// call when nothing is draining
+  static katana::Result<void> FinishPending();
+
   /// Start async store op, we hold onto the data until op finishes
   void StartStore(std::shared_ptr<FileFrame> ff);
 
@@ -106,6 +106,13 @@ KATANA_EXPORT std::future<katana::CopyableResult<void>> FileListAsync(
     const std::string& directory, std::vector<std::string>* list,
     std::vector<uint64_t>* size = nullptr);
 
+/// Like FileListAsync but only returns entries whose names begin with
+/// \param prefix; backends can filter far more cheaply than the caller on
+/// large directories
+KATANA_EXPORT std::future<katana::CopyableResult<void>> FileListPrefixAsync(
+    const std::string& directory, const std::string& prefix,
+    std::vector<std::string>* list, std::vector<uint64_t>* size = nullptr);
+
 /// Delete a set of files in a directory
 /// \param directory is a base URI
 /// \param files is a set of file names relative to the directory that should be
@@ -75,6 +75,16 @@ KATANA_EXPORT katana::Uri MakeNodeEntityTypeIDArrayFileName(RDGHandle handle);
 /// out-of-core conversion
 KATANA_EXPORT katana::Uri MakeEdgeEntityTypeIDArrayFileName(RDGHandle handle);
 
+/// Generate a new canonically named property index file name for the named
+/// node property column in the directory associated with handle
+KATANA_EXPORT katana::Uri MakeNodePropertyIndexFileName(
+    RDGHandle handle, const std::string& column_name);
+
+/// Generate a new canonically named property index file name for the named
+/// edge property column in the directory associated with handle
+KATANA_EXPORT katana::Uri MakeEdgePropertyIndexFileName(
+    RDGHandle handle, const std::string& column_name);
+
 /// Get the storage directory associated with this handle
 KATANA_EXPORT katana::Uri GetRDGDir(RDGHandle handle);
 
@@ -126,6 +136,33 @@ CreateSrcDestFromViewsForCopy(
 KATANA_EXPORT katana::Result<void> CopyRDG(
     std::vector<std::pair<katana::Uri, katana::Uri>> src_dst_files);
 
+/// Summary of a garbage-collection pass; \see GC
+struct KATANA_EXPORT GCReport {
+  uint64_t versions_retained{0};
+  uint64_t live_files{0};
+  uint64_t files_deleted{0};
+  uint64_t bytes_deleted{0};
+};
+
+/// Reclaim storage from old RDG versions under \p rdg_dir.
+///
+/// Walks each view's manifest chain (following previous_version links)
+/// from its newest version, keeps the newest \p keep_versions versions,
+/// and computes the live-file set by reading the retained versions'
+/// partition headers -- delta commits share unchanged property files
+/// with earlier versions, so liveness comes from what retained versions
+/// reference, not from which version wrote a file. Everything listed
+/// under \p rdg_dir but referenced by no retained version is deleted
+/// with batched parallel storage deletes. With \p dry_run the report is
+/// computed but nothing is deleted.
+///
+/// Any failure to read a retained version's metadata aborts the pass
+/// before deleting anything. The caller must ensure no concurrent
+/// writers; a commit racing the listing could be collected.
+KATANA_EXPORT katana::Result<GCReport> GC(
+    const std::string& rdg_dir, uint64_t keep_versions = 1,
+    bool dry_run = false);
+
 // Setup and tear down
 KATANA_EXPORT katana::Result<void> Init(katana::CommBackend* comm);
 KATANA_EXPORT katana::Result<void> Init();
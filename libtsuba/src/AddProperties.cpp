@@ -1,11 +1,14 @@
 #include "AddProperties.h"
 
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
 #include <arrow/chunked_array.h>
 
 #include "katana/ArrowInterchange.h"
+#include "katana/Env.h"
 #include "katana/ProgressTracer.h"
 #include "katana/Result.h"
 #include "katana/Time.h"
@@ -16,6 +19,57 @@
 
 namespace {
 
+/// Process-wide cache of fully loaded property tables keyed by their file
+/// URI. Property files are immutable once written - a commit stores changed
+/// properties under new paths - so the URI recorded in the part header
+/// identifies the content, and any two RDG versions open in this process
+/// that name the same file can share one table. Opening many historical
+/// versions of one graph (time-travel analytics) then loads each unchanged
+/// property exactly once. Entries are weak: a table stays alive only while
+/// some loaded RDG still references it, so the cache itself holds nothing.
+class SharedTableCache {
+public:
+  std::shared_ptr<arrow::Table> Get(const std::string& uri) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = tables_.find(uri);
+    if (it == tables_.end()) {
+      return nullptr;
+    }
+    std::shared_ptr<arrow::Table> table = it->second.lock();
+    if (!table) {
+      tables_.erase(it);
+    }
+    return table;
+  }
+
+  void Put(const std::string& uri, const std::shared_ptr<arrow::Table>& table) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    tables_[uri] = table;
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<arrow::Table>> tables_;
+};
+
+SharedTableCache&
+GetSharedTableCache() {
+  static SharedTableCache cache;
+  return cache;
+}
+
+bool
+SharedTablesEnabled() {
+  static bool enabled = []() {
+    bool disabled = false;
+    if (katana::GetEnv("KATANA_DISABLE_SHARED_PROPERTY_TABLES", &disabled)) {
+      return !disabled;
+    }
+    return true;
+  }();
+  return enabled;
+}
+
 katana::Result<std::shared_ptr<arrow::Table>>
 DoLoadProperties(
     const std::string& expected_name, const katana::Uri& file_path,
@@ -55,8 +109,23 @@ DoLoadProperties(
 katana::Result<std::shared_ptr<arrow::Table>>
 tsuba::LoadProperties(
     const std::string& expected_name, const katana::Uri& file_path) {
+  if (SharedTablesEnabled()) {
+    std::shared_ptr<arrow::Table> shared =
+        GetSharedTableCache().Get(file_path.string());
+    // The name check guards against a stale file being reused under a
+    // different property; immutable storage makes that unlikely but cheap
+    // to rule out
+    if (shared && shared->schema()->num_fields() == 1 &&
+        shared->schema()->field(0)->name() == expected_name) {
+      return shared;
+    }
+  }
   try {
-    return DoLoadProperties(expected_name, file_path);
+    auto out = DoLoadProperties(expected_name, file_path);
+    if (out && SharedTablesEnabled()) {
+      GetSharedTableCache().Put(file_path.string(), out.value());
+    }
+    return out;
   } catch (const std::exception& exp) {
     return KATANA_ERROR(
         tsuba::ErrorCode::ArrowError, "arrow exception: {}", exp.what());
@@ -111,7 +180,7 @@ tsuba::AddProperties(
         return katana::ResultSuccess();
       }
     }
-    const katana::Uri& path = uri.Join(prop->path());
+    const katana::Uri& path = prop->FileUri(uri);
 
     std::future<katana::CopyableResult<std::shared_ptr<arrow::Table>>> future =
         std::async(
@@ -181,7 +250,7 @@ tsuba::AddPropertySlice(
           ErrorCode::Exists, "property {} must be absent to be added",
           std::quoted(prop->name()));
     }
-    const katana::Uri& path = dir.Join(prop->path());
+    const katana::Uri& path = prop->FileUri(dir);
 
     std::future<katana::CopyableResult<std::shared_ptr<arrow::Table>>> future =
         std::async(
@@ -0,0 +1,151 @@
+#include "tsuba/FileFrameStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GlobalState.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
+
+namespace tsuba {
+
+FileFrameStream::~FileFrameStream() {
+  if (valid_ && !finished_) {
+    KATANA_LOG_ERROR("FileFrameStream for {} dropped without Finish", path_);
+    if (flush_.valid()) {
+      (void)flush_.get();
+    }
+  }
+}
+
+bool
+FileFrameStream::Supports(std::string_view uri) {
+  return FS(uri)->SupportsStreamingPut();
+}
+
+katana::Result<void>
+FileFrameStream::Init(uint64_t chunk_size) {
+  if (chunk_size == 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "chunk size must be non-zero");
+  }
+  path_ = "";
+  chunk_size_ = chunk_size;
+  chunk_.clear();
+  chunk_.reserve(chunk_size);
+  cursor_ = 0;
+  started_ = false;
+  valid_ = true;
+  finished_ = false;
+  return katana::ResultSuccess();
+}
+
+void
+FileFrameStream::Bind(std::string_view filename) {
+  path_ = filename;
+}
+
+katana::Result<void>
+FileFrameStream::FlushChunk() {
+  // wait for the previous part so parts land in order and only two chunks
+  // are ever live
+  if (flush_.valid()) {
+    KATANA_CHECKED(flush_.get());
+  }
+  flushing_ = std::move(chunk_);
+  chunk_.clear();
+  chunk_.reserve(chunk_size_);
+
+  const bool first = !started_;
+  started_ = true;
+  flush_ = std::async(
+      std::launch::async,
+      [path = path_, first, data = flushing_.data(),
+       size = flushing_.size()]() -> katana::CopyableResult<void> {
+        FileStorage* fs = FS(path);
+        if (first) {
+          KATANA_CHECKED(fs->PutStreamingStart(path));
+        }
+        KATANA_CHECKED(fs->PutStreamingPart(path, data, size));
+        return katana::CopyableResultSuccess();
+      });
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+FileFrameStream::Finish() {
+  if (!valid_) {
+    return KATANA_ERROR(ErrorCode::InvalidArgument, "not initialized");
+  }
+  if (path_.empty()) {
+    return KATANA_ERROR(ErrorCode::InvalidArgument, "no path provided");
+  }
+  // flush the tail even when empty so zero-byte files still get created
+  if (!chunk_.empty() || !started_) {
+    KATANA_CHECKED(FlushChunk());
+  }
+  if (flush_.valid()) {
+    KATANA_CHECKED(flush_.get());
+  }
+  KATANA_CHECKED(FS(path_)->PutStreamingFinish(path_));
+  finished_ = true;
+  return katana::ResultSuccess();
+}
+
+/////// Begin arrow::io::OutputStream method definitions //////
+
+arrow::Status
+FileFrameStream::Close() {
+  valid_ = false;
+  return arrow::Status::OK();
+}
+
+arrow::Result<int64_t>
+FileFrameStream::Tell() const {
+  if (!valid_) {
+    return -1;
+  }
+  return cursor_;
+}
+
+bool
+FileFrameStream::closed() const {
+  return !valid_;
+}
+
+arrow::Status
+FileFrameStream::Write(const void* data, int64_t nbytes) {
+  if (!valid_ || finished_) {
+    return arrow::Status(arrow::StatusCode::Invalid, "Invalid FileFrameStream");
+  }
+  if (nbytes < 0) {
+    return arrow::Status(
+        arrow::StatusCode::Invalid, "Cannot Write negative bytes");
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  uint64_t remaining = nbytes;
+  while (remaining > 0) {
+    uint64_t space = chunk_size_ - chunk_.size();
+    uint64_t to_copy = std::min(space, remaining);
+    chunk_.insert(chunk_.end(), bytes, bytes + to_copy);
+    bytes += to_copy;
+    remaining -= to_copy;
+    if (chunk_.size() == chunk_size_) {
+      if (auto res = FlushChunk(); !res) {
+        return arrow::Status::IOError("FileFrameStream flush: ", res.error());
+      }
+    }
+  }
+  cursor_ += nbytes;
+  return arrow::Status::OK();
+}
+
+arrow::Status
+FileFrameStream::Write(const std::shared_ptr<arrow::Buffer>& data) {
+  return Write(data->data(), data->size());
+}
+
+//////////// End arrow::io::OutputStream method definitions ////////
+
+} /* namespace tsuba */
@@ -1,9 +1,63 @@
 #include "tsuba/FileStorage.h"
 
+#include <memory>
+
 #include "FileStorage_internal.h"
+#include "tsuba/Errors.h"
 
 tsuba::FileStorage::~FileStorage() = default;
 
+katana::Result<void>
+tsuba::FileStorage::PutStreamingStart(const std::string& uri) {
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "backend for {} does not support streaming puts",
+      uri);
+}
+
+katana::Result<void>
+tsuba::FileStorage::PutStreamingPart(
+    const std::string& uri, const uint8_t*, uint64_t) {
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "backend for {} does not support streaming puts",
+      uri);
+}
+
+katana::Result<void>
+tsuba::FileStorage::PutStreamingFinish(const std::string& uri) {
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "backend for {} does not support streaming puts",
+      uri);
+}
+
+std::future<katana::CopyableResult<void>>
+tsuba::FileStorage::ListPrefixAsync(
+    const std::string& directory, const std::string& prefix,
+    std::vector<std::string>* list, std::vector<uint64_t>* size) {
+  auto all_names = std::make_shared<std::vector<std::string>>();
+  auto all_sizes = std::make_shared<std::vector<uint64_t>>();
+  auto list_fut =
+      ListAsync(directory, all_names.get(), size ? all_sizes.get() : nullptr);
+  return std::async(
+      std::launch::deferred,
+      [=, list_fut = std::move(list_fut)]() mutable
+      -> katana::CopyableResult<void> {
+        if (auto res = list_fut.get(); !res) {
+          return res;
+        }
+        for (size_t i = 0; i < all_names->size(); ++i) {
+          const std::string& name = (*all_names)[i];
+          if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+          }
+          list->emplace_back(name);
+          if (size != nullptr) {
+            size->emplace_back((*all_sizes)[i]);
+          }
+        }
+        return katana::CopyableResultSuccess();
+      });
+}
+
 std::vector<tsuba::FileStorage*>&
 tsuba::GetRegisteredFileStorages() {
   static std::vector<FileStorage*> fs;
@@ -3,15 +3,59 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <string>
 
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
 
+namespace {
+
+// Cap on how far PreFetch will run ahead of the reader. Large enough to hide
+// remote storage latency for a handful of in-flight fetches, small enough
+// that an abandoned scan does not drag in a whole file.
+uint64_t
+MaxReadAhead() {
+  static uint64_t max_bytes = []() -> uint64_t {
+    int mbs = 0;
+    if (katana::GetEnv("KATANA_READAHEAD_WINDOW_MB", &mbs) && mbs >= 0) {
+      return static_cast<uint64_t>(mbs) << 20;
+    }
+    return UINT64_C(64) << 20;
+  }();
+  return max_bytes;
+}
+
+// How many separate fetches to split a readahead window into
+constexpr uint64_t kReadAheadSlices = 8;
+
+// Process-wide resident budget for FileView pages. Zero (the default) means
+// unlimited; long-running services that open many RDGs in one process set
+// this to keep total mapped pages inside a fixed memory envelope.
+uint64_t
+BudgetBytes() {
+  static uint64_t budget = []() -> uint64_t {
+    int mbs = 0;
+    if (katana::GetEnv("KATANA_FILEVIEW_BUDGET_MB", &mbs) && mbs > 0) {
+      return static_cast<uint64_t>(mbs) << 20;
+    }
+    return 0;
+  }();
+  return budget;
+}
+
+// Byte accounting is shared between every FileView in the process; the LRU
+// lists themselves are per view because FileView is not thread safe
+std::atomic<uint64_t> process_resident_bytes{0};
+std::atomic<uint64_t> process_evicted_bytes{0};
+
+}  // namespace
+
 /*
  * SCB 2020-07-23
  * We have a problem here involving modifying the underlying file. The problem
@@ -58,6 +102,14 @@ FileView::Unbind() {
     mem_start_ = 0;
     filename_ = "";
     filling_ = std::vector<uint64_t>();
+    last_read_end_ = -1;
+    last_stride_ = 0;
+    read_ahead_ = 0;
+    process_resident_bytes.fetch_sub(
+        resident_bytes_, std::memory_order_relaxed);
+    resident_bytes_ = 0;
+    evictable_lru_.clear();
+    has_pinned_range_ = false;
     KATANA_LOG_DEBUG_ASSERT(fetches_->empty());
 
     bound_ = false;
@@ -110,11 +162,21 @@ FileView::Bind(
   filling_.resize(page_number(buf.size) / 64 + 1, 0);
   file_size_ = buf.size;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
+  // The range requested at Bind time is pinned: callers are allowed to hold
+  // ptr()s into it, so it is never eligible for eviction
+  has_pinned_range_ = in_end > begin;
+  if (has_pinned_range_) {
+    pinned_first_page_ = page_number(begin);
+    pinned_last_page_ = page_number(in_end);
+  }
   if (auto res = Fill(begin, in_end, resolve); !res) {
     return res.error().WithContext("reading content");
   }
 
   cursor_ = 0;
+  last_read_end_ = -1;
+  last_stride_ = 0;
+  read_ahead_ = 0;
   bound_ = true;
   return katana::ResultSuccess();
 }
@@ -162,6 +224,10 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
       if (auto res = MarkFilled(&filling_[0], first_page, last_page); !res) {
         return res.error().WithContext("updating bookkeeping data");
       }
+      RecordFilled(first_page, last_page);
+      if (auto res = EvictToBudget(); !res) {
+        return res.error().WithContext("evicting to budget");
+      }
       if (resolve) {
         if (auto res = Resolve(file_off, map_size); !res) {
           return res.error().WithContext("resolving fill");
@@ -250,6 +316,7 @@ FileView::Read(int64_t nbytes) {
   if (auto res = Fill(cursor_, cursor_ + nbytes_internal, true); !res) {
     return arrow::Status(arrow::StatusCode::IOError, "FileView::Fill");
   }
+  TouchResident(cursor_, nbytes_internal);
   // resolve outstanding relevant fetches
   if (auto res = Resolve(cursor_, nbytes_internal); !res) {
     // TODO (scober): Include res.error() as part of arrow Status
@@ -285,6 +352,7 @@ FileView::Read(int64_t nbytes, void* out) {
   if (auto res = Fill(cursor_, cursor_ + nbytes_internal, true); !res) {
     return arrow::Status(arrow::StatusCode::IOError, "FileView::Fill");
   }
+  TouchResident(cursor_, nbytes_internal);
   // resolve outstanding relevant fetches
   if (auto res = Resolve(cursor_, nbytes_internal); !res) {
     // TODO (scober): Include res.error() as part of arrow Status
@@ -467,6 +535,162 @@ FileView::MarkFilled(uint64_t* bitmap, uint64_t begin, uint64_t end) {
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+FileView::MarkUnfilled(uint64_t* bitmap, uint64_t begin, uint64_t end) {
+  uint64_t begin_mask;
+  if (begin % 64) {
+    begin_mask = (UINT64_C(1) << (64 - begin % 64)) - UINT64_C(1);
+  } else {
+    begin_mask = ~UINT64_C(0);
+  }
+  uint64_t end_mask = ~((UINT64_C(1) << (63 - end % 64)) - UINT64_C(1));
+
+  uint64_t begin_block = begin / 64;
+  uint64_t end_block = end / 64;
+
+  if (begin_block == end_block) {
+    bitmap[begin_block] &= ~(begin_mask & end_mask);
+  } else {
+    bitmap[begin_block] &= ~begin_mask;
+    for (uint64_t i = begin_block + 1; i < end_block; ++i) {
+      bitmap[i] = 0;
+    }
+    bitmap[end_block] &= ~end_mask;
+  }
+
+  return katana::ResultSuccess();
+}
+
+uint64_t
+FileView::RangeBytes(uint64_t first_page, uint64_t last_page) const {
+  uint64_t file_off = first_page * (1UL << page_shift_);
+  return std::min(
+      (last_page + 1) * (1UL << page_shift_) - file_off,
+      static_cast<uint64_t>(file_size_) - file_off);
+}
+
+void
+FileView::RecordFilled(uint64_t first_page, uint64_t last_page) {
+  uint64_t bytes = RangeBytes(first_page, last_page);
+  resident_bytes_ += bytes;
+  process_resident_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+  // The pinned Bind-time range is resident but never evictable; only the
+  // parts of the new range outside it go into the LRU list
+  if (!has_pinned_range_) {
+    evictable_lru_.push_front({first_page, last_page});
+    return;
+  }
+  if (first_page < pinned_first_page_) {
+    evictable_lru_.push_front(
+        {first_page, std::min(last_page, pinned_first_page_ - 1)});
+  }
+  if (last_page > pinned_last_page_) {
+    evictable_lru_.push_front(
+        {std::max(first_page, pinned_last_page_ + 1), last_page});
+  }
+}
+
+void
+FileView::TouchResident(int64_t start, int64_t size) {
+  if (evictable_lru_.empty()) {
+    return;
+  }
+  uint64_t first_page = page_number(start);
+  uint64_t last_page = page_number(start + size);
+  for (auto it = evictable_lru_.begin(); it != evictable_lru_.end();) {
+    auto range = it++;
+    if (range->first_page <= last_page && range->last_page >= first_page) {
+      evictable_lru_.splice(evictable_lru_.begin(), evictable_lru_, range);
+    }
+  }
+}
+
+katana::Result<void>
+FileView::EvictRange(const ResidentRange& range) {
+  uint64_t file_off = range.first_page * (1UL << page_shift_);
+  uint64_t len = RangeBytes(range.first_page, range.last_page);
+  // The mapping is anonymous, so MADV_DONTNEED frees the physical pages;
+  // PROT_NONE makes a stale ptr() into the range fault instead of silently
+  // reading zeroes
+  if (madvise(map_start_ + file_off, len, MADV_DONTNEED) == -1) {
+    return KATANA_ERROR(katana::ResultErrno(), "releasing evicted pages");
+  }
+  if (mprotect(map_start_ + file_off, len, PROT_NONE) == -1) {
+    return KATANA_ERROR(katana::ResultErrno(), "protecting evicted pages");
+  }
+  // Clear the fill bits so the next Read that touches the range refetches
+  // it from storage
+  if (auto res = MarkUnfilled(&filling_[0], range.first_page, range.last_page);
+      !res) {
+    return res.error().WithContext("updating bookkeeping data");
+  }
+  resident_bytes_ -= len;
+  process_resident_bytes.fetch_sub(len, std::memory_order_relaxed);
+  process_evicted_bytes.fetch_add(len, std::memory_order_relaxed);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+FileView::EvictToBudget() {
+  uint64_t budget = BudgetBytes();
+  if (budget == 0 || evictable_lru_.empty()) {
+    return katana::ResultSuccess();
+  }
+  auto it = evictable_lru_.end();
+  while (process_resident_bytes.load(std::memory_order_relaxed) > budget &&
+         it != evictable_lru_.begin()) {
+    --it;
+    // Skip ranges with a fetch still writing into them; they will come up
+    // for eviction again once the reader moves past them
+    bool in_flight = false;
+    for (const auto& fetch : *fetches_) {
+      if (fetch.first_page <= it->last_page &&
+          fetch.last_page >= it->first_page) {
+        in_flight = true;
+        break;
+      }
+    }
+    if (in_flight) {
+      continue;
+    }
+    if (auto res = EvictRange(*it); !res) {
+      return res.error().WithContext("evicting LRU range");
+    }
+    it = evictable_lru_.erase(it);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+FileView::EvictResident() {
+  if (!bound_) {
+    return katana::ResultSuccess();
+  }
+  // Resolve everything first so no asynchronous fetch writes into pages we
+  // are about to release
+  if (auto res = Resolve(0, file_size_); !res) {
+    return res.error().WithContext("resolving before eviction");
+  }
+  for (auto it = evictable_lru_.begin(); it != evictable_lru_.end();) {
+    if (auto res = EvictRange(*it); !res) {
+      return res.error().WithContext("evicting resident range");
+    }
+    it = evictable_lru_.erase(it);
+  }
+  return katana::ResultSuccess();
+}
+
+uint64_t
+FileView::ProcessResidentBytes() {
+  return process_resident_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t
+FileView::ProcessEvictedBytes() {
+  return process_evicted_bytes.load(std::memory_order_relaxed);
+}
+
 katana::Result<void>
 FileView::Resolve(int64_t start, int64_t size) {
   // This loop could do less work by sorting the vector or storing an
@@ -474,7 +698,9 @@ FileView::Resolve(int64_t start, int64_t size) {
   // bottleneck
   for (auto it = fetches_->begin(); it != fetches_->end();) {
     auto fetch = it;
-    if (fetch->first_page <= page_number(start + size) ||
+    // Only wait for fetches that intersect [start, start + size); fetches
+    // running ahead of the reader stay in flight until a read reaches them
+    if (fetch->first_page <= page_number(start + size) &&
         fetch->last_page >= page_number(start)) {
       // Complete the remaining work if there is some
       if (fetch->work.valid()) {
@@ -494,17 +720,42 @@ FileView::Resolve(int64_t start, int64_t size) {
 
 katana::Result<void>
 FileView::PreFetch(int64_t start, int64_t size) {
-  // Our highly sophisticated prefetching algorithm is to crudely approximate
-  // the size of the last read plus 10%. This is largely motivated by parquet
-  // files, which consecutively read row groups that are (in theory)
-  // approximately the same size.
+  // Our baseline prefetching algorithm is to crudely approximate the size of
+  // the last read plus 10%. This is largely motivated by parquet files, which
+  // consecutively read row groups that are (in theory) approximately the same
+  // size.
   int64_t fetch_size = (size / 10) * 11;
   // Make sure we haven't overflown
   KATANA_LOG_DEBUG_ASSERT(fetch_size >= 0);
+
+  // On top of that, watch for scans: reads that pick up where the previous
+  // read left off, or that skip forward by the same gap as last time (e.g. a
+  // single column being read out of every row group). Each read that
+  // continues the pattern doubles the readahead window, so a cold scan over
+  // remote storage quickly builds up several fetches in flight ahead of the
+  // reader instead of paying a round trip per hole. Any read that breaks the
+  // pattern drops back to the one-read lookahead above.
+  int64_t stride = (last_read_end_ >= 0) ? start - last_read_end_ : -1;
+  if (stride >= 0 && (stride == 0 || stride == last_stride_)) {
+    uint64_t base = static_cast<uint64_t>(fetch_size + stride);
+    read_ahead_ = std::min(std::max(read_ahead_ * 2, base), MaxReadAhead());
+  } else {
+    read_ahead_ = 0;
+  }
+  last_stride_ = stride;
+  last_read_end_ = start + size;
+
   uint64_t begin = static_cast<uint64_t>(start + size);
-  uint64_t end = static_cast<uint64_t>(start + size + fetch_size);
-  if (auto res = Fill(begin, end, false); !res) {
-    return res.error();
+  uint64_t window = std::max(static_cast<uint64_t>(fetch_size), read_ahead_);
+  uint64_t end = begin + window;
+  // Issue the window in page-aligned slices so each slice becomes its own
+  // FillingRange with its own asynchronous fetch. Resolve only waits for the
+  // slices a read actually touches; the rest keep streaming in behind it.
+  uint64_t slice = std::max(1UL << page_shift_, window / kReadAheadSlices);
+  for (uint64_t off = begin; off < end; off += slice) {
+    if (auto res = Fill(off, std::min(off + slice, end), false); !res) {
+      return res.error();
+    }
   }
   return katana::ResultSuccess();
 }
@@ -24,6 +24,9 @@ class LocalStorage : public FileStorage {
   katana::Result<void> RemoteCopyFile(
       std::string source_uri, std::string dest_uri, uint64_t begin,
       uint64_t size);
+  katana::Result<void> ListDir(
+      const std::string& dirname, const std::string& prefix,
+      std::vector<std::string>* list, std::vector<uint64_t>* size);
 
 public:
   LocalStorage() : FileStorage("file://") {}
@@ -45,6 +48,13 @@ public:
     return WriteFile(uri, data, size);
   }
 
+  // streaming puts map directly onto file appends
+  bool SupportsStreamingPut() const override { return true; }
+  katana::Result<void> PutStreamingStart(const std::string& uri) override;
+  katana::Result<void> PutStreamingPart(
+      const std::string& uri, const uint8_t* data, uint64_t size) override;
+  katana::Result<void> PutStreamingFinish(const std::string& uri) override;
+
   katana::Result<void> RemoteCopy(
       const std::string& source_uri, const std::string& dest_uri,
       uint64_t begin, uint64_t size) override {
@@ -68,22 +78,13 @@ public:
   }
   std::future<katana::CopyableResult<void>> GetAsync(
       const std::string& uri, uint64_t start, uint64_t size,
-      uint8_t* result_buf) override {
-    // I suppose there is no need for AsyncGet to local storage either
-    if (auto read_res = ReadFile(uri, start, size, result_buf); !read_res) {
-      katana::CopyableErrorInfo cei{read_res.error()};
-      return std::async(
-          std::launch::deferred,
-          [=]() -> katana::CopyableResult<void> { return cei; });
-    }
-    return std::async(
-        std::launch::deferred, []() -> katana::CopyableResult<void> {
-          return katana::CopyableResultSuccess();
-        });
-  }
+      uint8_t* result_buf) override;
   std::future<katana::CopyableResult<void>> ListAsync(
       const std::string& uri, std::vector<std::string>* list,
       std::vector<uint64_t>* size) override;
+  std::future<katana::CopyableResult<void>> ListPrefixAsync(
+      const std::string& uri, const std::string& prefix,
+      std::vector<std::string>* list, std::vector<uint64_t>* size) override;
 
   katana::Result<void> Delete(
       const std::string& directory,
@@ -1,7 +1,10 @@
 #include "tsuba/ParquetReader.h"
 
+#include <cmath>
+#include <future>
 #include <limits>
 #include <memory>
+#include <random>
 #include <unordered_map>
 
 #include <arrow/array/util.h>
@@ -11,6 +14,7 @@
 #include <arrow/type_fwd.h>
 #include <parquet/arrow/schema.h>
 
+#include "katana/ArrowInterchange.h"
 #include "katana/JSON.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
@@ -22,6 +26,12 @@ using ErrorCode = tsuba::ErrorCode;
 
 namespace {
 
+// Cap on the cumulative (uncompressed) bytes of row groups being decoded at
+// once by one ReadTable, and on the number of decode tasks in flight; decode
+// proceeds in waves that fit the budget
+constexpr int64_t kDecodeBudgetBytes = INT64_C(256) << 20;
+constexpr size_t kMaxDecodeTasks = 16;
+
 katana::Result<std::shared_ptr<arrow::ChunkedArray>>
 HandleBadParquetTypes(std::shared_ptr<arrow::ChunkedArray> old_array) {
   switch (old_array->type()->id()) {
@@ -69,7 +79,7 @@ BuildReader(
 
   std::unique_ptr<parquet::arrow::FileReader> reader;
   KATANA_CHECKED(
-      parquet::arrow::OpenFile(fv_tmp, arrow::default_memory_pool(), &reader));
+      parquet::arrow::OpenFile(fv_tmp, katana::GetArrowMemoryPool(), &reader));
 
   return std::unique_ptr<parquet::arrow::FileReader>(std::move(reader));
 }
@@ -206,9 +216,7 @@ public:
       std::vector<std::shared_ptr<arrow::Table>> tables;
       for (size_t i = 0, num_files = readers_.size(); i < num_files; ++i) {
         KATANA_CHECKED(EnsureReader(i, true));
-        std::shared_ptr<arrow::Table> table;
-        KATANA_CHECKED(readers_[i]->ReadTable(&table));
-        tables.emplace_back(std::move(table));
+        tables.emplace_back(KATANA_CHECKED(ReadWholeFile(i)));
       }
       return KATANA_CHECKED(arrow::ConcatenateTables(tables));
     }
@@ -340,6 +348,56 @@ private:
         readers_(std::move(readers)),
         row_offsets_(std::move(row_offsets)) {}
 
+  /// Read all row groups of file idx, decoding them in parallel when there
+  /// is more than one. Decode tasks run in waves bounded by
+  /// kDecodeBudgetBytes/kMaxDecodeTasks, and each task opens its own reader
+  /// over the file so no FileView or parquet reader state is shared across
+  /// threads.
+  Result<std::shared_ptr<arrow::Table>> ReadWholeFile(size_t idx) {
+    auto md = readers_[idx]->parquet_reader()->metadata();
+    const int rg_count = md->num_row_groups();
+    if (rg_count <= 1) {
+      std::shared_ptr<arrow::Table> table;
+      KATANA_CHECKED(readers_[idx]->ReadTable(&table));
+      return table;
+    }
+
+    const std::string& file_uri = fvs_[idx]->filename();
+    std::vector<std::shared_ptr<arrow::Table>> tables(rg_count);
+    int next = 0;
+    while (next < rg_count) {
+      int64_t budget = kDecodeBudgetBytes;
+      std::vector<std::pair<
+          int,
+          std::future<katana::CopyableResult<std::shared_ptr<arrow::Table>>>>>
+          wave;
+      // always make progress, even if one row group blows the budget
+      while (next < rg_count && wave.size() < kMaxDecodeTasks &&
+             (wave.empty() ||
+              budget >= md->RowGroup(next)->total_byte_size())) {
+        budget -= md->RowGroup(next)->total_byte_size();
+        const int rg = next++;
+        wave.emplace_back(
+            rg,
+            std::async(
+                std::launch::async,
+                [file_uri, rg]()
+                    -> katana::CopyableResult<std::shared_ptr<arrow::Table>> {
+                  std::shared_ptr<tsuba::FileView> task_fv;
+                  std::unique_ptr<parquet::arrow::FileReader> task_reader =
+                      KATANA_CHECKED(BuildReader(file_uri, false, &task_fv));
+                  std::shared_ptr<arrow::Table> table;
+                  KATANA_CHECKED(task_reader->ReadRowGroup(rg, &table));
+                  return table;
+                }));
+      }
+      for (auto& [rg, fut] : wave) {
+        tables[rg] = KATANA_CHECKED(fut.get());
+      }
+    }
+    return KATANA_CHECKED(arrow::ConcatenateTables(tables));
+  }
+
   Result<void> EnsureReader(size_t idx, bool preload = false) {
     if (readers_[idx]) {
       KATANA_LOG_ASSERT(fvs_[idx]);
@@ -415,6 +473,222 @@ tsuba::ParquetReader::GetFiles(const katana::Uri& uri) {
   return KATANA_CHECKED(BlockedParquetReader::Make(uri, false))->GetFiles();
 }
 
+namespace {
+
+// 2^11 HyperLogLog registers: ~2.3% relative error on the distinct count,
+// 2KB of state per column
+constexpr uint64_t kHllPrecision = 11;
+constexpr uint64_t kHllRegisters = UINT64_C(1) << kHllPrecision;
+
+uint64_t
+Fnv1a64(const void* data, size_t len) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  uint64_t hash = UINT64_C(0xcbf29ce484222325);
+  for (size_t i = 0; i < len; ++i) {
+    hash = (hash ^ bytes[i]) * UINT64_C(0x100000001b3);
+  }
+  return hash;
+}
+
+/// Running reservoir-plus-HyperLogLog state for one column
+struct SketchState {
+  explicit SketchState(int64_t reservoir_capacity, uint32_t seed)
+      : capacity(reservoir_capacity), rng(seed) {
+    registers.assign(kHllRegisters, 0);
+  }
+
+  void UpdateDistinct(uint64_t hash) {
+    uint64_t index = hash >> (64 - kHllPrecision);
+    // rank of the first set bit in the remaining 53; the or-ed 1 bounds it
+    uint8_t rank = __builtin_clzll((hash << kHllPrecision) | 1) + 1;
+    registers[index] = std::max(registers[index], rank);
+  }
+
+  /// Vitter's algorithm R: every value seen so far has an equal chance of
+  /// being in the reservoir
+  void UpdateReservoir(double value) {
+    if (static_cast<int64_t>(reservoir.size()) < capacity) {
+      reservoir.push_back(value);
+      return;
+    }
+    uint64_t j = rng() % static_cast<uint64_t>(rows_read);
+    if (j < static_cast<uint64_t>(capacity)) {
+      reservoir[j] = value;
+    }
+  }
+
+  double EstimateDistinct() const {
+    const double m = static_cast<double>(kHllRegisters);
+    double sum = 0;
+    int64_t zeros = 0;
+    for (uint8_t r : registers) {
+      sum += std::ldexp(1.0, -r);
+      zeros += (r == 0) ? 1 : 0;
+    }
+    double alpha = 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    // linear counting is more accurate while most registers are empty
+    if (estimate <= 2.5 * m && zeros > 0) {
+      estimate = m * std::log(m / static_cast<double>(zeros));
+    }
+    return estimate;
+  }
+
+  std::vector<uint8_t> registers;
+  std::vector<double> reservoir;
+  int64_t capacity;
+  int64_t rows_read{0};
+  std::mt19937_64 rng;
+};
+
+template <typename ArrayType>
+void
+SketchNumericChunk(const ArrayType& array, SketchState* state) {
+  for (int64_t i = 0, n = array.length(); i < n; ++i) {
+    if (array.IsNull(i)) {
+      continue;
+    }
+    auto value = array.Value(i);
+    state->rows_read++;
+    state->UpdateDistinct(Fnv1a64(&value, sizeof(value)));
+    state->UpdateReservoir(static_cast<double>(value));
+  }
+}
+
+template <typename ArrayType>
+void
+SketchBinaryChunk(const ArrayType& array, SketchState* state) {
+  for (int64_t i = 0, n = array.length(); i < n; ++i) {
+    if (array.IsNull(i)) {
+      continue;
+    }
+    auto view = array.GetView(i);
+    state->rows_read++;
+    state->UpdateDistinct(Fnv1a64(view.data(), view.size()));
+  }
+}
+
+/// Fold one chunk into the state; \returns false for column types the
+/// sketch does not cover
+bool
+SketchChunk(const arrow::Array& array, SketchState* state) {
+  switch (array.type_id()) {
+  case arrow::Type::INT8:
+    SketchNumericChunk(static_cast<const arrow::Int8Array&>(array), state);
+    return true;
+  case arrow::Type::INT16:
+    SketchNumericChunk(static_cast<const arrow::Int16Array&>(array), state);
+    return true;
+  case arrow::Type::INT32:
+    SketchNumericChunk(static_cast<const arrow::Int32Array&>(array), state);
+    return true;
+  case arrow::Type::INT64:
+    SketchNumericChunk(static_cast<const arrow::Int64Array&>(array), state);
+    return true;
+  case arrow::Type::UINT8:
+    SketchNumericChunk(static_cast<const arrow::UInt8Array&>(array), state);
+    return true;
+  case arrow::Type::UINT16:
+    SketchNumericChunk(static_cast<const arrow::UInt16Array&>(array), state);
+    return true;
+  case arrow::Type::UINT32:
+    SketchNumericChunk(static_cast<const arrow::UInt32Array&>(array), state);
+    return true;
+  case arrow::Type::UINT64:
+    SketchNumericChunk(static_cast<const arrow::UInt64Array&>(array), state);
+    return true;
+  case arrow::Type::FLOAT:
+    SketchNumericChunk(static_cast<const arrow::FloatArray&>(array), state);
+    return true;
+  case arrow::Type::DOUBLE:
+    SketchNumericChunk(static_cast<const arrow::DoubleArray&>(array), state);
+    return true;
+  case arrow::Type::STRING:
+    SketchBinaryChunk(static_cast<const arrow::StringArray&>(array), state);
+    return true;
+  case arrow::Type::LARGE_STRING:
+    SketchBinaryChunk(
+        static_cast<const arrow::LargeStringArray&>(array), state);
+    return true;
+  default:
+    return false;
+  }
+}
+
+tsuba::ParquetReader::ColumnSketch
+SketchColumn(
+    const std::vector<std::shared_ptr<arrow::Table>>& runs, int column,
+    const tsuba::ParquetReader::SampleOpts& opts) {
+  tsuba::ParquetReader::ColumnSketch sketch;
+  sketch.column = runs[0]->field(column)->name();
+  SketchState state(
+      std::max(opts.reservoir_size, INT64_C(1)),
+      opts.seed + static_cast<uint32_t>(column));
+  for (const auto& run : runs) {
+    for (const auto& chunk : run->column(column)->chunks()) {
+      if (!SketchChunk(*chunk, &state)) {
+        KATANA_LOG_WARN(
+            "not sketching column {}: unsupported type {}", sketch.column,
+            chunk->type()->ToString());
+        return sketch;
+      }
+    }
+  }
+  sketch.rows_read = state.rows_read;
+  if (state.rows_read > 0) {
+    sketch.approx_distinct = state.EstimateDistinct();
+  }
+  sketch.reservoir = std::move(state.reservoir);
+  return sketch;
+}
+
+}  // namespace
+
+Result<std::vector<tsuba::ParquetReader::ColumnSketch>>
+tsuba::ParquetReader::SampleTable(const katana::Uri& uri, SampleOpts opts) {
+  const int64_t total_rows = KATANA_CHECKED(NumRows(uri));
+  const int64_t max_rows = std::max(opts.max_rows, INT64_C(1));
+  int64_t num_runs = std::max(opts.num_runs, INT64_C(1));
+  if (total_rows <= max_rows) {
+    num_runs = 1;
+  }
+  const int64_t run_length = std::max(max_rows / num_runs, INT64_C(1));
+
+  // each run goes through the slice machinery, so only the row groups it
+  // overlaps are decoded
+  std::vector<std::shared_ptr<arrow::Table>> runs;
+  runs.reserve(num_runs);
+  for (int64_t r = 0; r < num_runs; ++r) {
+    int64_t offset = total_rows / num_runs * r;
+    int64_t length = std::min(run_length, total_rows - offset);
+    if (length <= 0) {
+      break;
+    }
+    ReadOpts read_opts;
+    read_opts.make_cannonical = make_cannonical_;
+    read_opts.slice = Slice{offset, length};
+    auto reader = KATANA_CHECKED(Make(read_opts));
+    runs.emplace_back(KATANA_CHECKED(reader->ReadTable(uri)));
+  }
+  if (runs.empty()) {
+    return std::vector<ColumnSketch>();
+  }
+
+  std::vector<std::future<ColumnSketch>> tasks;
+  for (int c = 0, n = runs[0]->num_columns(); c < n; ++c) {
+    tasks.emplace_back(std::async(
+        std::launch::async, [&runs, &opts, c] {
+          return SketchColumn(runs, c, opts);
+        }));
+  }
+  std::vector<ColumnSketch> sketches;
+  sketches.reserve(tasks.size());
+  for (auto& task : tasks) {
+    sketches.emplace_back(task.get());
+  }
+  return sketches;
+}
+
 Result<std::shared_ptr<arrow::Schema>>
 tsuba::ParquetReader::FixSchema(const std::shared_ptr<arrow::Schema>& schema) {
   if (!make_cannonical_) {
@@ -465,7 +739,7 @@ tsuba::ParquetReader::FixTable(std::shared_ptr<arrow::Table>&& _table) {
   // combined into a single chunk due to the fact the offset type for these
   // columns is int32_t and thus the maximum size of an arrow::Array for these
   // types is 2^31.
-  table = KATANA_CHECKED(table->CombineChunks(arrow::default_memory_pool()));
+  table = KATANA_CHECKED(table->CombineChunks(katana::GetArrowMemoryPool()));
 
   // lots of the code base assumes chunks will exist, but arrow allows zero length
   // chunked arrays to have zero chunks. Let's be helpful.
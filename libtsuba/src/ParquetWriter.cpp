@@ -1,10 +1,17 @@
 #include "tsuba/ParquetWriter.h"
 
+#include <thread>
+
+#include <arrow/util/compression.h>
+
 #include "katana/ArrowInterchange.h"
+#include "katana/Env.h"
 #include "katana/JSON.h"
 #include "katana/Result.h"
+#include "katana/Strings.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FaultTest.h"
+#include "tsuba/FileFrameStream.h"
 
 template <typename T>
 using Result = katana::Result<T>;
@@ -58,12 +65,72 @@ BlockTable(std::shared_ptr<arrow::Table> table, uint64_t mbs_per_block) {
   return blocks;
 }
 
+// approximate encoded bytes per row group on the streaming path; the
+// parquet writer buffers about one row group's worth of data, so together
+// with FileFrameStream's two chunks this caps writer memory
+constexpr uint64_t kStreamingRowGroupBytes = 64 * kMB;
+
+Result<void>
+DoStoreParquetStreaming(
+    const std::string& path, std::shared_ptr<arrow::Table> table,
+    const std::shared_ptr<parquet::WriterProperties>& writer_props,
+    const std::shared_ptr<parquet::ArrowWriterProperties>& arrow_props,
+    tsuba::WriteGroup* desc) {
+  auto future = std::async(
+      std::launch::async,
+      [table = std::move(table), path, writer_props,
+       arrow_props]() mutable -> katana::CopyableResult<void> {
+        auto fs = std::make_shared<tsuba::FileFrameStream>();
+        KATANA_CHECKED(fs->Init());
+        fs->Bind(path);
+
+        // bound the writer's own buffering by emitting modest row groups
+        uint64_t row_size =
+            table->num_rows() > 0 ? std::max(EstimateRowSize(table), UINT64_C(1))
+                                  : UINT64_C(1);
+        int64_t rows_per_group = std::max(
+            static_cast<int64_t>(kStreamingRowGroupBytes / row_size),
+            INT64_C(1));
+
+        auto write_result = parquet::arrow::WriteTable(
+            *table, katana::GetArrowMemoryPool(), fs, rows_per_group,
+            writer_props, arrow_props);
+        table.reset();
+
+        if (!write_result.ok()) {
+          return KATANA_ERROR(
+              tsuba::ErrorCode::ArrowError, "arrow error: {}", write_result);
+        }
+
+        TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
+        KATANA_CHECKED(fs->Finish());
+        return katana::CopyableResultSuccess();
+      });
+  // no AddToOutstanding bookkeeping: unlike the FileFrame path this holds
+  // only a couple of chunks, not the whole serialized file
+
+  if (!desc) {
+    auto res = future.get();
+    if (!res) {
+      return res.error();
+    }
+    return katana::ResultSuccess();
+  }
+
+  desc->AddOp(std::move(future), path);
+  return katana::ResultSuccess();
+}
+
 Result<void>
 DoStoreParquet(
     const std::string& path, std::shared_ptr<arrow::Table> table,
     const std::shared_ptr<parquet::WriterProperties>& writer_props,
     const std::shared_ptr<parquet::ArrowWriterProperties>& arrow_props,
     tsuba::WriteGroup* desc) {
+  if (tsuba::FileFrameStream::Supports(path)) {
+    return DoStoreParquetStreaming(
+        path, std::move(table), writer_props, arrow_props, desc);
+  }
   auto ff = std::make_shared<tsuba::FileFrame>();
   KATANA_CHECKED(ff->Init());
   ff->Bind(path);
@@ -73,7 +140,7 @@ DoStoreParquet(
       [table = std::move(table), ff = std::move(ff), desc, writer_props,
        arrow_props]() mutable -> katana::CopyableResult<void> {
         auto write_result = parquet::arrow::WriteTable(
-            *table, arrow::default_memory_pool(), ff,
+            *table, katana::GetArrowMemoryPool(), ff,
             std::numeric_limits<int64_t>::max(), writer_props, arrow_props);
         table.reset();
 
@@ -137,12 +204,167 @@ tsuba::ParquetWriter::WriteToUri(const katana::Uri& uri, WriteGroup* group) {
   }
 }
 
+namespace {
+
+// KATANA_PARQUET_COMPRESSION selects the codec used for property files. The
+// value is a comma-separated list of entries; a bare codec name ("zstd",
+// "snappy", "gzip", "uncompressed", ...) sets the default and a
+// "column=codec" entry overrides it for one column.
+void
+ApplyCompressionFromEnv(parquet::WriterProperties::Builder* builder) {
+  std::string spec;
+  if (!katana::GetEnv("KATANA_PARQUET_COMPRESSION", &spec)) {
+    return;
+  }
+  for (std::string_view entry : katana::SplitView(spec, ",")) {
+    if (entry.empty()) {
+      continue;
+    }
+    std::string column;
+    std::string codec_name;
+    if (size_t eq = entry.find('='); eq != std::string_view::npos) {
+      column = std::string(entry.substr(0, eq));
+      codec_name = std::string(entry.substr(eq + 1));
+    } else {
+      codec_name = std::string(entry);
+    }
+    auto codec = arrow::util::Codec::GetCompressionType(codec_name);
+    if (!codec.ok()) {
+      KATANA_LOG_WARN(
+          "ignoring unknown compression codec {} in "
+          "KATANA_PARQUET_COMPRESSION",
+          codec_name);
+      continue;
+    }
+    if (column.empty()) {
+      builder->compression(codec.ValueOrDie());
+    } else {
+      builder->compression(column, codec.ValueOrDie());
+    }
+  }
+}
+
+// how much of a column SuggestCompression feeds to the trial codec
+constexpr uint64_t kCodecSampleBytes = 64 * 1024;
+
+// a sample that keeps more than this fraction of its size is treated as
+// already compressed and written uncompressed
+constexpr double kIncompressibleRatio = 0.95;
+
+// zstd level that trades well for float embedding columns
+constexpr int kSuggestedZstdLevel = 3;
+
+/// Collect up to kCodecSampleBytes of raw value bytes from the front of a
+/// fixed-width column
+std::vector<uint8_t>
+SampleColumnBytes(const arrow::ChunkedArray& column, uint64_t width) {
+  std::vector<uint8_t> sample;
+  sample.reserve(std::min(
+      kCodecSampleBytes, static_cast<uint64_t>(column.length()) * width));
+  for (const auto& chunk : column.chunks()) {
+    if (sample.size() >= kCodecSampleBytes) {
+      break;
+    }
+    const uint8_t* values =
+        chunk->data()->buffers[1]->data() + chunk->offset() * width;
+    uint64_t take = std::min(
+        static_cast<uint64_t>(chunk->length()) * width,
+        kCodecSampleBytes - sample.size());
+    sample.insert(sample.end(), values, values + take);
+  }
+  return sample;
+}
+
+/// Regroup a sample of fixed-width values so the i-th byte of every value
+/// is contiguous, mirroring what the BYTE_STREAM_SPLIT encoding does
+/// before compression
+std::vector<uint8_t>
+ByteStreamSplit(const std::vector<uint8_t>& sample, uint64_t width) {
+  const uint64_t num_values = sample.size() / width;
+  std::vector<uint8_t> split(num_values * width);
+  for (uint64_t i = 0; i < num_values; ++i) {
+    for (uint64_t j = 0; j < width; ++j) {
+      split[j * num_values + i] = sample[i * width + j];
+    }
+  }
+  return split;
+}
+
+katana::Result<double>
+TrialCompressionRatio(const std::vector<uint8_t>& sample) {
+  std::unique_ptr<arrow::util::Codec> codec = KATANA_CHECKED(
+      arrow::util::Codec::Create(arrow::Compression::ZSTD, kSuggestedZstdLevel));
+  std::vector<uint8_t> out(codec->MaxCompressedLen(sample.size(), sample.data()));
+  int64_t compressed_size = KATANA_CHECKED(
+      codec->Compress(sample.size(), sample.data(), out.size(), out.data()));
+  return static_cast<double>(compressed_size) /
+         static_cast<double>(sample.size());
+}
+
+}  // namespace
+
+katana::Result<std::vector<tsuba::ParquetWriter::WriteOpts::ColumnCompression>>
+tsuba::ParquetWriter::SuggestCompression(
+    const std::shared_ptr<arrow::Table>& table) {
+  std::vector<WriteOpts::ColumnCompression> suggestions;
+  for (int i = 0, n = table->num_columns(); i < n; ++i) {
+    const std::shared_ptr<arrow::ChunkedArray>& column = table->column(i);
+    const std::string& name = table->field(i)->name();
+    auto fixed =
+        std::dynamic_pointer_cast<arrow::FixedWidthType>(column->type());
+    if (!fixed || fixed->bit_width() % 8 != 0 || column->length() == 0) {
+      continue;
+    }
+    const uint64_t width = fixed->bit_width() / 8;
+    const bool is_float = column->type()->id() == arrow::Type::FLOAT ||
+                          column->type()->id() == arrow::Type::DOUBLE;
+
+    std::vector<uint8_t> sample = SampleColumnBytes(*column, width);
+    if (sample.empty()) {
+      continue;
+    }
+    // judge float columns on the split layout they would be stored in
+    double ratio = KATANA_CHECKED(TrialCompressionRatio(
+        is_float ? ByteStreamSplit(sample, width) : sample));
+    if (ratio >= kIncompressibleRatio) {
+      // already dense (compressed embeddings, hashes, ...); any codec is
+      // wasted effort on it
+      suggestions.push_back(WriteOpts::ColumnCompression{
+          name, arrow::Compression::UNCOMPRESSED,
+          arrow::util::kUseDefaultCompressionLevel, false});
+    } else if (is_float) {
+      suggestions.push_back(WriteOpts::ColumnCompression{
+          name, arrow::Compression::ZSTD, kSuggestedZstdLevel, true});
+    }
+    // other compressible columns keep the table default
+  }
+  return suggestions;
+}
+
 std::shared_ptr<parquet::WriterProperties>
 tsuba::ParquetWriter::StandardWriterProperties() {
-  return parquet::WriterProperties::Builder()
-      .version(opts_.parquet_version)
-      ->data_page_version(opts_.data_page_version)
-      ->build();
+  parquet::WriterProperties::Builder builder;
+  builder.version(opts_.parquet_version)
+      ->data_page_version(opts_.data_page_version);
+  for (const auto& entry : opts_.compression) {
+    if (entry.column.empty()) {
+      builder.compression(entry.codec);
+      if (entry.level != arrow::util::kUseDefaultCompressionLevel) {
+        builder.compression_level(entry.level);
+      }
+    } else {
+      builder.compression(entry.column, entry.codec);
+      if (entry.level != arrow::util::kUseDefaultCompressionLevel) {
+        builder.compression_level(entry.column, entry.level);
+      }
+      if (entry.byte_stream_split) {
+        builder.encoding(entry.column, parquet::Encoding::BYTE_STREAM_SPLIT);
+        builder.disable_dictionary(entry.column);
+      }
+    }
+  }
+  ApplyCompressionFromEnv(&builder);
+  return builder.build();
 }
 
 std::shared_ptr<parquet::ArrowWriterProperties>
@@ -159,34 +381,77 @@ tsuba::ParquetWriter::StoreParquet(
   auto arrow_props = StandardArrowProperties();
   std::string prefix = uri.string();
 
-  if (table->num_rows() <= kMaxRowsPerFile) {
+  // Slicing into parts is necessary above kMaxRowsPerFile because of a
+  // problem with arrow<>parquet and nulls for string columns. If entries in
+  // a column are all or mostly null and greater than the element limit for
+  // a String array, you can end up in a situation where you've generated a
+  // parquet file that arrow cannot read. To make sure we don't end up in
+  // that situation, slice the table here into groups of rows that are
+  // definitely smaller than the element limit.
+  //
+  // With parallel_encode we additionally slice big tables into one part
+  // per core: every part is encoded and compressed in its own async task,
+  // and the offset manifest stitches them back into one logical table.
+  int64_t rows_per_part = kMaxRowsPerFile;
+  const int64_t total_rows = table->num_rows();
+  if (opts_.parallel_encode && total_rows > 1) {
+    uint64_t total_bytes =
+        std::max(EstimateRowSize(table), UINT64_C(1)) * total_rows;
+    if (total_bytes >= opts_.parallel_encode_min_mbs * kMB) {
+      int64_t num_parts = std::max(
+          static_cast<int64_t>(std::thread::hardware_concurrency()),
+          INT64_C(1));
+      rows_per_part = std::min(
+          rows_per_part, (total_rows + num_parts - 1) / num_parts);
+    }
+  }
+
+  if (total_rows <= rows_per_part) {
     return DoStoreParquet(prefix, table, writer_props, arrow_props, desc);
   }
 
+  // the parts must run concurrently to overlap their encoding, so make a
+  // write group if the caller did not provide one
+  std::unique_ptr<tsuba::WriteGroup> our_desc;
+  if (!desc) {
+    our_desc = KATANA_CHECKED(WriteGroup::Make());
+    desc = our_desc.get();
+  }
+
   std::vector<std::shared_ptr<arrow::Table>> tables;
   std::vector<int64_t> table_offsets;
-
-  // Slicing like this is necessary because of a problem with arrow<>parquet
-  // and nulls for string columns. If entries in a column are all or mostly null
-  // and greater than the element limit for a String array, you can end up
-  // in a situation where you've generated a parquet file that arrow cannot
-  // read. To make sure we don't end up in that situation, slice the table here
-  // into groups of rows that are definitely smaller than the element limit
-  for (int64_t i = 0, total_rows = table->num_rows(); i < total_rows;
-       i += kMaxRowsPerFile) {
+  for (int64_t i = 0; i < total_rows; i += rows_per_part) {
     table_offsets.emplace_back(i);
-    tables.emplace_back(table->Slice(i, kMaxRowsPerFile));
+    tables.emplace_back(table->Slice(i, rows_per_part));
   }
   table.reset();
 
+  katana::Result<void> ret = katana::ResultSuccess();
   uint32_t table_count = 0;
   for (const auto& t : tables) {
-    KATANA_CHECKED(DoStoreParquet(
+    ret = DoStoreParquet(
         fmt::format("{}.part_{:09}", prefix, table_count++), t, writer_props,
-        arrow_props, desc));
+        arrow_props, desc);
+    if (!ret) {
+      break;
+    }
+  }
+  if (ret) {
+    ret = FileStore(
+        uri.string(), KATANA_CHECKED(katana::JsonDump(table_offsets)));
   }
-  return FileStore(
-      uri.string(), KATANA_CHECKED(katana::JsonDump(table_offsets)));
+
+  if (our_desc) {
+    auto final_ret = our_desc->Finish();
+    if (!final_ret && !ret) {
+      KATANA_LOG_ERROR("multiple errors, masking: {}", final_ret.error());
+      return ret;
+    }
+    if (!final_ret) {
+      return final_ret;
+    }
+  }
+  return ret;
 }
 
 katana::Result<void>
@@ -0,0 +1,281 @@
+#include "tsuba/PropertySync.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <arrow/api.h>
+#include <nlohmann/json.hpp>
+
+#include "GlobalState.h"
+#include "katana/CommBackend.h"
+#include "katana/JSON.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
+#include "tsuba/RDG.h"
+
+namespace {
+
+// More than enough for any realistic set of dirty ranges; the manifest
+// holds a few dozen bytes per range.
+constexpr uint64_t kMaxManifestSize = 64ULL * 1024 * 1024;
+
+const std::string kEmpty;
+
+/// Wire description of one dirty range. The root broadcasts a JSON
+/// manifest of these, then one raw value-buffer payload per entry.
+struct DeltaHeader {
+  bool is_node{true};
+  std::string property_name;
+  uint64_t row_begin{0};
+  uint64_t row_end{0};
+  uint64_t value_width{0};
+};
+
+void
+to_json(nlohmann::json& j, const DeltaHeader& d) {
+  j = nlohmann::json{
+      {"is_node", d.is_node},
+      {"property_name", d.property_name},
+      {"row_begin", d.row_begin},
+      {"row_end", d.row_end},
+      {"value_width", d.value_width},
+  };
+}
+
+void
+from_json(const nlohmann::json& j, DeltaHeader& d) {
+  j.at("is_node").get_to(d.is_node);
+  j.at("property_name").get_to(d.property_name);
+  j.at("row_begin").get_to(d.row_begin);
+  j.at("row_end").get_to(d.row_end);
+  j.at("value_width").get_to(d.value_width);
+}
+
+katana::Result<uint64_t>
+FixedValueWidth(const std::shared_ptr<arrow::Field>& field) {
+  auto fixed = std::dynamic_pointer_cast<arrow::FixedWidthType>(field->type());
+  if (!fixed || fixed->bit_width() % 8 != 0) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::NotImplemented,
+        "property {} has type {}; only fixed-width columns can be "
+        "synchronized",
+        field->name(), field->type()->ToString());
+  }
+  return fixed->bit_width() / 8;
+}
+
+katana::Result<DeltaHeader>
+MakeHeader(
+    const std::shared_ptr<arrow::Table>& table,
+    const tsuba::PropertyDirtyRange& range, bool is_node) {
+  auto field = table->schema()->GetFieldByName(range.property_name);
+  if (!field) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::PropertyNotFound, "no {} property named {}",
+        is_node ? "node" : "edge", range.property_name);
+  }
+  if (range.row_begin >= range.row_end ||
+      range.row_end > static_cast<uint64_t>(table->num_rows())) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::InvalidArgument,
+        "dirty range [{}, {}) of property {} is invalid for a column of {} "
+        "rows",
+        range.row_begin, range.row_end, range.property_name,
+        table->num_rows());
+  }
+  uint64_t width = KATANA_CHECKED(FixedValueWidth(field));
+  return DeltaHeader{
+      is_node, range.property_name, range.row_begin, range.row_end, width};
+}
+
+/// Copy the value-buffer bytes of rows [row_begin, row_end) out of the
+/// chunks that cover them
+std::string
+ExtractPayload(const arrow::ChunkedArray& column, const DeltaHeader& d) {
+  std::string payload;
+  payload.reserve((d.row_end - d.row_begin) * d.value_width);
+  uint64_t chunk_begin = 0;
+  for (const auto& chunk : column.chunks()) {
+    uint64_t chunk_end = chunk_begin + chunk->length();
+    uint64_t begin = std::max(d.row_begin, chunk_begin);
+    uint64_t end = std::min(d.row_end, chunk_end);
+    if (begin < end) {
+      const uint8_t* values = chunk->data()->buffers[1]->data();
+      const uint8_t* src =
+          values +
+          (chunk->offset() + (begin - chunk_begin)) * d.value_width;
+      payload.append(
+          reinterpret_cast<const char*>(src), (end - begin) * d.value_width);
+    }
+    chunk_begin = chunk_end;
+  }
+  return payload;
+}
+
+/// Patch rows [row_begin, row_end) of the named column with the root's
+/// values. Chunks outside the range are shared as-is; arrow buffers are
+/// immutable, so the overlapping chunks are rebuilt around a patched copy
+/// of their value buffer. Validity bitmaps are carried over unchanged.
+katana::Result<void>
+ApplyDelta(
+    tsuba::RDG* rdg, const DeltaHeader& d, const std::string& payload) {
+  const std::shared_ptr<arrow::Table>& table =
+      d.is_node ? rdg->node_properties() : rdg->edge_properties();
+  auto field = table->schema()->GetFieldByName(d.property_name);
+  auto column = table->GetColumnByName(d.property_name);
+  if (!field || !column) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::PropertyNotFound,
+        "replica has no {} property named {}", d.is_node ? "node" : "edge",
+        d.property_name);
+  }
+  uint64_t width = KATANA_CHECKED(FixedValueWidth(field));
+  if (width != d.value_width ||
+      d.row_end > static_cast<uint64_t>(column->length())) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::InvalidArgument,
+        "replica copy of property {} does not match the root's layout",
+        d.property_name);
+  }
+  if (payload.size() != (d.row_end - d.row_begin) * width) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::InvalidArgument,
+        "short delta payload for property {}: got {} bytes, expected {}",
+        d.property_name, payload.size(),
+        (d.row_end - d.row_begin) * width);
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  chunks.reserve(column->num_chunks());
+  uint64_t chunk_begin = 0;
+  for (const auto& chunk : column->chunks()) {
+    uint64_t chunk_end = chunk_begin + chunk->length();
+    uint64_t begin = std::max(d.row_begin, chunk_begin);
+    uint64_t end = std::min(d.row_end, chunk_end);
+    if (begin >= end) {
+      chunks.emplace_back(chunk);
+    } else {
+      const std::shared_ptr<arrow::Buffer>& values = chunk->data()->buffers[1];
+      std::shared_ptr<arrow::Buffer> patched =
+          KATANA_CHECKED(arrow::AllocateBuffer(values->size()));
+      memcpy(patched->mutable_data(), values->data(), values->size());
+      uint64_t local = chunk->offset() + (begin - chunk_begin);
+      memcpy(
+          patched->mutable_data() + local * width,
+          payload.data() + (begin - d.row_begin) * width,
+          (end - begin) * width);
+      std::shared_ptr<arrow::ArrayData> data = chunk->data()->Copy();
+      data->buffers[1] = std::move(patched);
+      chunks.emplace_back(arrow::MakeArray(data));
+    }
+    chunk_begin = chunk_end;
+  }
+
+  // Upserting the patched column also marks it dirty for storage, so a
+  // replica that later stores the RDG writes the new values back.
+  auto patched_column =
+      std::make_shared<arrow::ChunkedArray>(std::move(chunks), column->type());
+  std::shared_ptr<arrow::Table> props = arrow::Table::Make(
+      arrow::schema({field}), {std::move(patched_column)}, table->num_rows());
+  if (d.is_node) {
+    return rdg->UpsertNodeProperties(props);
+  }
+  return rdg->UpsertEdgeProperties(props);
+}
+
+}  // namespace
+
+katana::Result<void>
+tsuba::BroadcastPropertyDeltas(RDG* rdg, uint32_t root) {
+  katana::CommBackend* comm = Comm();
+  if (root >= comm->Num) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "root {} is not a valid host ({} hosts)",
+        root, comm->Num);
+  }
+  if (comm->Num == 1) {
+    rdg->ClearDirtyPropertyRanges();
+    return katana::ResultSuccess();
+  }
+  const bool is_root = comm->Rank == root;
+
+  // The root validates every range and serializes the whole manifest
+  // before the first broadcast, so a bad delta fails fast everywhere
+  // instead of leaving replicas waiting mid-protocol.
+  std::vector<DeltaHeader> headers;
+  std::vector<std::string> payloads;
+  std::string manifest;
+  katana::Result<void> local = katana::ResultSuccess();
+  if (is_root) {
+    local = [&]() -> katana::Result<void> {
+      for (const auto& range : rdg->node_dirty_ranges()) {
+        DeltaHeader header =
+            KATANA_CHECKED(MakeHeader(rdg->node_properties(), range, true));
+        payloads.emplace_back(ExtractPayload(
+            *rdg->node_properties()->GetColumnByName(range.property_name),
+            header));
+        headers.emplace_back(std::move(header));
+      }
+      for (const auto& range : rdg->edge_dirty_ranges()) {
+        DeltaHeader header =
+            KATANA_CHECKED(MakeHeader(rdg->edge_properties(), range, false));
+        payloads.emplace_back(ExtractPayload(
+            *rdg->edge_properties()->GetColumnByName(range.property_name),
+            header));
+        headers.emplace_back(std::move(header));
+      }
+      manifest = KATANA_CHECKED(katana::JsonDump(headers));
+      return katana::ResultSuccess();
+    }();
+  }
+  if (!comm->Broadcast(root, static_cast<bool>(local))) {
+    if (!local) {
+      return local.error();
+    }
+    return KATANA_ERROR(
+        ErrorCode::MpiError, "property delta broadcast failed on the root");
+  }
+
+  // The count travels separately so a replica that cannot parse the
+  // manifest still consumes the right number of collectives and reaches
+  // the outcome agreement below instead of desynchronizing.
+  std::string count = comm->Broadcast(
+      root, std::to_string(headers.size()),
+      std::numeric_limits<uint64_t>::digits10 + 1);
+  uint64_t num_deltas = std::strtoull(count.c_str(), nullptr, 10);
+  manifest = comm->Broadcast(root, manifest, kMaxManifestSize);
+  if (!is_root) {
+    if (auto parsed = katana::JsonParse(manifest, &headers); !parsed) {
+      local = parsed.error();
+    }
+  }
+
+  for (uint64_t i = 0; i < num_deltas; ++i) {
+    const std::string& out = is_root ? payloads[i] : kEmpty;
+    std::string payload = comm->Broadcast(root, out, out.size());
+    if (!is_root && local && i < headers.size()) {
+      if (auto applied = ApplyDelta(rdg, headers[i], payload); !applied) {
+        local = applied.error();
+      }
+    }
+  }
+
+  // agree on the outcome so no host continues with a stale replica
+  bool all_ok = true;
+  for (uint32_t r = 0; r < comm->Num; ++r) {
+    all_ok &= comm->Broadcast(r, static_cast<bool>(local));
+  }
+  if (!local) {
+    return local.error();
+  }
+  if (!all_ok) {
+    return KATANA_ERROR(
+        ErrorCode::MpiError,
+        "property delta broadcast failed on a remote host");
+  }
+  rdg->ClearDirtyPropertyRanges();
+  return katana::ResultSuccess();
+}
@@ -1,10 +1,14 @@
 #include "tsuba/RDG.h"
 
 #include <cassert>
+#include <cmath>
 #include <exception>
 #include <fstream>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <unordered_set>
@@ -27,6 +31,7 @@
 #include "RDGCore.h"
 #include "RDGHandleImpl.h"
 #include "katana/ArrowInterchange.h"
+#include "katana/Env.h"
 #include "katana/ErrorCode.h"
 #include "katana/JSON.h"
 #include "katana/Logging.h"
@@ -34,6 +39,7 @@
 #include "katana/URI.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FaultTest.h"
+#include "tsuba/ParquetReader.h"
 #include "tsuba/ParquetWriter.h"
 #include "tsuba/PropertyCache.h"
 #include "tsuba/ReadGroup.h"
@@ -43,8 +49,38 @@
 
 using json = nlohmann::json;
 
+namespace tsuba {
+
+void
+to_json(json& j, const RDGChangeSet& changes) {
+  j = json{
+      {"version", changes.version},
+      {"topology_changed", changes.topology_changed},
+      {"node_properties", changes.node_properties},
+      {"edge_properties", changes.edge_properties},
+  };
+}
+
+void
+from_json(const json& j, RDGChangeSet& changes) {
+  j.at("version").get_to(changes.version);
+  j.at("topology_changed").get_to(changes.topology_changed);
+  j.at("node_properties").get_to(changes.node_properties);
+  j.at("edge_properties").get_to(changes.edge_properties);
+}
+
+}  // namespace tsuba
+
 namespace {
 
+// Change sets live next to the manifests they describe and reuse the
+// manifests' zero-padded version naming so one can be located by version
+// alone
+katana::Uri
+ChangeSetFileName(const katana::Uri& rdg_dir, uint64_t version) {
+  return rdg_dir.Join(fmt::format("changes_vers{0:0{1}d}", version, 20));
+}
+
 katana::Result<std::string>
 StoreArrowArrayAtName(
     const std::shared_ptr<arrow::ChunkedArray>& array, const katana::Uri& dir,
@@ -62,10 +98,96 @@ StoreArrowArrayAtName(
   return new_path.BaseName();
 }
 
+// Conversion to the double bounds stored in a zone map; integer values can
+// be inexact as doubles, so widen them by one ulp in the conservative
+// direction to keep block pruning sound
+template <typename T>
+double
+ZoneMapLower(T v) {
+  double d = static_cast<double>(v);
+  if constexpr (std::is_integral_v<T>) {
+    d = std::nextafter(d, -std::numeric_limits<double>::infinity());
+  }
+  return d;
+}
+
+template <typename T>
+double
+ZoneMapUpper(T v) {
+  double d = static_cast<double>(v);
+  if constexpr (std::is_integral_v<T>) {
+    d = std::nextafter(d, std::numeric_limits<double>::infinity());
+  }
+  return d;
+}
+
+template <typename ArrayType>
+tsuba::PropertyZoneMap
+ComputeZoneMapTyped(const arrow::ChunkedArray& column) {
+  constexpr int64_t block_rows = tsuba::PropertyZoneMap::kRowsPerBlock;
+  int64_t num_blocks = (column.length() + block_rows - 1) / block_rows;
+
+  tsuba::PropertyZoneMap zone_map;
+  // all-null blocks keep these inverted bounds and never qualify a scan;
+  // infinities are avoided because they do not survive JSON
+  zone_map.mins.assign(num_blocks, std::numeric_limits<double>::max());
+  zone_map.maxs.assign(num_blocks, std::numeric_limits<double>::lowest());
+
+  int64_t row = 0;
+  for (const auto& chunk : column.chunks()) {
+    const auto& array = static_cast<const ArrayType&>(*chunk);
+    for (int64_t i = 0, n = array.length(); i < n; ++i, ++row) {
+      if (array.IsNull(i)) {
+        continue;
+      }
+      auto value = array.Value(i);
+      if constexpr (std::is_floating_point_v<decltype(value)>) {
+        if (std::isnan(value)) {
+          continue;
+        }
+      }
+      size_t block = row / block_rows;
+      zone_map.mins[block] = std::min(zone_map.mins[block], ZoneMapLower(value));
+      zone_map.maxs[block] = std::max(zone_map.maxs[block], ZoneMapUpper(value));
+    }
+  }
+  return zone_map;
+}
+
+std::optional<tsuba::PropertyZoneMap>
+ComputeZoneMap(const arrow::ChunkedArray& column) {
+  switch (column.type()->id()) {
+  case arrow::Type::INT8:
+    return ComputeZoneMapTyped<arrow::Int8Array>(column);
+  case arrow::Type::INT16:
+    return ComputeZoneMapTyped<arrow::Int16Array>(column);
+  case arrow::Type::INT32:
+    return ComputeZoneMapTyped<arrow::Int32Array>(column);
+  case arrow::Type::INT64:
+    return ComputeZoneMapTyped<arrow::Int64Array>(column);
+  case arrow::Type::UINT8:
+    return ComputeZoneMapTyped<arrow::UInt8Array>(column);
+  case arrow::Type::UINT16:
+    return ComputeZoneMapTyped<arrow::UInt16Array>(column);
+  case arrow::Type::UINT32:
+    return ComputeZoneMapTyped<arrow::UInt32Array>(column);
+  case arrow::Type::UINT64:
+    return ComputeZoneMapTyped<arrow::UInt64Array>(column);
+  case arrow::Type::FLOAT:
+    return ComputeZoneMapTyped<arrow::FloatArray>(column);
+  case arrow::Type::DOUBLE:
+    return ComputeZoneMapTyped<arrow::DoubleArray>(column);
+  default:
+    return std::nullopt;
+  }
+}
+
 katana::Result<void>
 WriteProperties(
     const arrow::Table& props, std::vector<tsuba::PropStorageInfo*> prop_info,
-    const katana::Uri& dir, tsuba::WriteGroup* desc) {
+    const katana::Uri& dir, tsuba::WriteGroup* desc,
+    std::map<std::string, tsuba::PropertyZoneMap>* zone_maps,
+    std::map<std::string, tsuba::PropertySketch>* sketches) {
   const auto& schema = props.schema();
 
   std::vector<std::string> next_paths;
@@ -79,6 +201,15 @@ WriteProperties(
         KATANA_CHECKED(StoreArrowArrayAtName(props.column(i), dir, name, desc));
 
     prop_info[i]->WasWritten(path);
+
+    // refresh the zone map alongside the file it summarizes; sampled
+    // sketches cannot be recomputed here, so drop stale ones instead
+    if (auto zone_map = ComputeZoneMap(*props.column(i)); zone_map) {
+      (*zone_maps)[name] = std::move(zone_map.value());
+    } else {
+      zone_maps->erase(name);
+    }
+    sketches->erase(name);
   }
   TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
 
@@ -98,6 +229,36 @@ CommitRDG(
           : handle.impl_->rdg_manifest().NextVersion(
                 comm->Num, policy_id, transposed, lineage);
 
+  // With write-behind enabled the caller gets control back while this
+  // group's data files drain in the background; the manifest is only
+  // written after they all land, so it doubles as the commit journal: a
+  // crash mid-pipeline leaves the previous version current. The drain's
+  // result surfaces at the next WriteGroup::Make (or tsuba::Fini), failing
+  // the following batch instead of being dropped. Restricted to one host
+  // because the barrier below is a collective.
+  if (katana::GetEnv("KATANA_WRITE_BEHIND") && comm->Num == 1) {
+    std::string manifest_name =
+        tsuba::RDGManifest::FileName(
+            handle.impl_->rdg_manifest().dir(),
+            handle.impl_->rdg_manifest().viewtype(), new_manifest.version())
+            .string();
+    std::string curr_s = new_manifest.ToJsonString();
+    handle.impl_->set_rdg_manifest(std::move(new_manifest));
+    tsuba::WriteGroup::DrainAsync(
+        std::move(desc),
+        [manifest_name = std::move(manifest_name),
+         curr_s = std::move(curr_s)]() -> katana::CopyableResult<void> {
+          KATANA_CHECKED_CONTEXT(
+              tsuba::FileStore(
+                  manifest_name,
+                  reinterpret_cast<const uint8_t*>(curr_s.data()),
+                  curr_s.size()),
+              "CommitRDG write-behind manifest {}", manifest_name);
+          return katana::CopyableResultSuccess();
+        });
+    return katana::ResultSuccess();
+  }
+
   // wait for all the work we queued to finish
   TSUBA_PTP(tsuba::internal::FaultSensitivity::High);
   if (auto res = desc->Finish(); !res) {
@@ -164,52 +325,66 @@ tsuba::RDG::WritePartArrays(const katana::Uri& dir, tsuba::WriteGroup* desc) {
       local_to_user_id() == nullptr ? 0 : local_to_user_id()->length(),
       local_to_global_id() == nullptr ? 0 : local_to_global_id()->length());
 
+  // a partition array whose PropStorageInfo is still clean was loaded from
+  // this directory and has not been replaced in memory since, so link the
+  // file we loaded instead of rewriting it
+  auto prior_path = [&](const std::string& name) -> std::string {
+    if (dir != rdg_dir()) {
+      return "";
+    }
+    const std::vector<tsuba::PropStorageInfo>& part_props =
+        core_->part_header().part_prop_info_list();
+    auto it = std::find_if(
+        part_props.begin(), part_props.end(),
+        [&](const tsuba::PropStorageInfo& psi) { return psi.name() == name; });
+    if (it != part_props.end() && it->IsClean()) {
+      return it->path();
+    }
+    return "";
+  };
+  auto store_array =
+      [&](const std::shared_ptr<arrow::ChunkedArray>& array,
+          const std::string& name) -> katana::Result<void> {
+    std::string path = prior_path(name);
+    if (path.empty()) {
+      path = KATANA_CHECKED_CONTEXT(
+          StoreArrowArrayAtName(array, dir, name, desc), "storing {}", name);
+    }
+    // written (or linked) and still in memory, so the entry starts out clean
+    tsuba::PropStorageInfo prop_info(name, array->type());
+    prop_info.WasWritten(path);
+    next_properties.emplace_back(std::move(prop_info));
+    return katana::ResultSuccess();
+  };
+
   for (size_t i = 0; i < mirror_nodes().size(); ++i) {
-    std::string name = RDGCore::MirrorPropName(i);
-    std::string path = KATANA_CHECKED_CONTEXT(
-        StoreArrowArrayAtName(mirror_nodes()[i], dir, name, desc), "storing {}",
-        name);
-    next_properties.emplace_back(tsuba::PropStorageInfo(name, path));
+    KATANA_CHECKED(store_array(mirror_nodes()[i], RDGCore::MirrorPropName(i)));
   }
 
   for (size_t i = 0; i < master_nodes().size(); ++i) {
-    std::string name = RDGCore::MasterPropName(i);
-    std::string path = KATANA_CHECKED_CONTEXT(
-        StoreArrowArrayAtName(master_nodes()[i], dir, name, desc), "storing {}",
-        name);
-    next_properties.emplace_back(tsuba::PropStorageInfo(name, path));
+    KATANA_CHECKED(store_array(master_nodes()[i], RDGCore::MasterPropName(i)));
   }
 
   if (host_to_owned_global_node_ids() != nullptr) {
-    std::string name = RDGCore::kHostToOwnedGlobalNodeIDsPropName;
-    std::string path = KATANA_CHECKED_CONTEXT(
-        StoreArrowArrayAtName(host_to_owned_global_node_ids(), dir, name, desc),
-        "storing {}", name);
-    next_properties.emplace_back(tsuba::PropStorageInfo(name, path));
+    KATANA_CHECKED(store_array(
+        host_to_owned_global_node_ids(),
+        RDGCore::kHostToOwnedGlobalNodeIDsPropName));
   }
 
   if (host_to_owned_global_edge_ids() != nullptr) {
-    std::string name = RDGCore::kHostToOwnedGlobalEdgeIDsPropName;
-    std::string path = KATANA_CHECKED_CONTEXT(
-        StoreArrowArrayAtName(host_to_owned_global_edge_ids(), dir, name, desc),
-        "storing {}", name);
-    next_properties.emplace_back(tsuba::PropStorageInfo(name, path));
+    KATANA_CHECKED(store_array(
+        host_to_owned_global_edge_ids(),
+        RDGCore::kHostToOwnedGlobalEdgeIDsPropName));
   }
 
   if (local_to_user_id() != nullptr) {
-    std::string name = RDGCore::kLocalToUserIDPropName;
-    std::string path = KATANA_CHECKED_CONTEXT(
-        StoreArrowArrayAtName(local_to_user_id(), dir, name, desc),
-        "storing {}", name);
-    next_properties.emplace_back(tsuba::PropStorageInfo(name, path));
+    KATANA_CHECKED(
+        store_array(local_to_user_id(), RDGCore::kLocalToUserIDPropName));
   }
 
   if (local_to_global_id() != nullptr) {
-    std::string name = RDGCore::kLocalToGlobalIDPropName;
-    std::string path = KATANA_CHECKED_CONTEXT(
-        StoreArrowArrayAtName(local_to_global_id(), dir, name, desc),
-        "storing {}", name);
-    next_properties.emplace_back(tsuba::PropStorageInfo(name, path));
+    KATANA_CHECKED(
+        store_array(local_to_global_id(), RDGCore::kLocalToGlobalIDPropName));
   }
 
   return next_properties;
@@ -352,14 +527,167 @@ tsuba::RDG::DoStoreEdgeEntityTypeIDArray(
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+tsuba::RDG::WriteNodePropertyIndex(
+    RDGHandle handle, const std::string& column_name, const uint8_t* data,
+    uint64_t size) {
+  if (!handle.impl_->AllowsWrite()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "handle does not allow write");
+  }
+  katana::Uri path_uri = MakeNodePropertyIndexFileName(handle, column_name);
+  KATANA_CHECKED(FileStore(path_uri.string(), data, size));
+  core_->part_header().UpsertNodeIndexStorageInfo(
+      PropStorageInfo(column_name, path_uri.BaseName()));
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::RDG::WriteEdgePropertyIndex(
+    RDGHandle handle, const std::string& column_name, const uint8_t* data,
+    uint64_t size) {
+  if (!handle.impl_->AllowsWrite()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "handle does not allow write");
+  }
+  katana::Uri path_uri = MakeEdgePropertyIndexFileName(handle, column_name);
+  KATANA_CHECKED(FileStore(path_uri.string(), data, size));
+  core_->part_header().UpsertEdgeIndexStorageInfo(
+      PropStorageInfo(column_name, path_uri.BaseName()));
+  return katana::ResultSuccess();
+}
+
+katana::Result<tsuba::FileView>
+tsuba::RDG::LoadNodePropertyIndex(const std::string& column_name) const {
+  const PropStorageInfo* info =
+      core_->part_header().FindNodeIndexStorageInfo(column_name);
+  if (info == nullptr) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "no stored index for column {}",
+        std::quoted(column_name));
+  }
+  FileView fv;
+  // resolve=false issues the read asynchronously; the caller resolves the
+  // view before touching its contents
+  KATANA_CHECKED(fv.Bind(info->FileUri(rdg_dir()).string(), false));
+  return katana::Result<FileView>(std::move(fv));
+}
+
+katana::Result<tsuba::FileView>
+tsuba::RDG::LoadEdgePropertyIndex(const std::string& column_name) const {
+  const PropStorageInfo* info =
+      core_->part_header().FindEdgeIndexStorageInfo(column_name);
+  if (info == nullptr) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "no stored index for column {}",
+        std::quoted(column_name));
+  }
+  FileView fv;
+  KATANA_CHECKED(fv.Bind(info->FileUri(rdg_dir()).string(), false));
+  return katana::Result<FileView>(std::move(fv));
+}
+
+namespace {
+
+katana::Result<std::vector<tsuba::PropertySlice>>
+ScanPropertyRange(
+    const std::vector<tsuba::PropStorageInfo>& prop_info_list,
+    const tsuba::PropertyZoneMap* zone_map, const katana::Uri& dir,
+    const std::string& property_name, double lower, double upper) {
+  const tsuba::PropStorageInfo* info = nullptr;
+  for (const tsuba::PropStorageInfo& psi : prop_info_list) {
+    if (psi.name() == property_name) {
+      info = &psi;
+      break;
+    }
+  }
+  if (info == nullptr) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::PropertyNotFound, "no property {}",
+        std::quoted(property_name));
+  }
+  if (info->path().empty()) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::InvalidArgument,
+        "property {} has unwritten changes; range scans read from storage",
+        std::quoted(property_name));
+  }
+  const katana::Uri& uri = info->FileUri(dir);
+
+  std::vector<tsuba::PropertySlice> slices;
+  if (zone_map == nullptr) {
+    // no zone map (non-numeric property or RDG written by older code);
+    // fall back to one full read
+    auto reader = KATANA_CHECKED(tsuba::ParquetReader::Make());
+    slices.emplace_back(
+        tsuba::PropertySlice{0, KATANA_CHECKED(reader->ReadTable(uri))});
+    return slices;
+  }
+
+  constexpr int64_t block_rows = tsuba::PropertyZoneMap::kRowsPerBlock;
+  auto excluded = [&](size_t block) {
+    return zone_map->maxs[block] < lower || zone_map->mins[block] > upper;
+  };
+
+  // materialize each maximal run of qualifying blocks with one sliced
+  // read; the reader only touches row groups overlapping the slice
+  for (size_t block = 0, num_blocks = zone_map->mins.size();
+       block < num_blocks;) {
+    if (excluded(block)) {
+      ++block;
+      continue;
+    }
+    size_t run_end = block + 1;
+    while (run_end < num_blocks && !excluded(run_end)) {
+      ++run_end;
+    }
+
+    tsuba::ParquetReader::ReadOpts opts =
+        tsuba::ParquetReader::ReadOpts::Defaults();
+    int64_t row_offset = static_cast<int64_t>(block) * block_rows;
+    opts.slice = tsuba::ParquetReader::Slice{
+        row_offset, static_cast<int64_t>(run_end - block) * block_rows};
+    auto reader = KATANA_CHECKED(tsuba::ParquetReader::Make(opts));
+    slices.emplace_back(tsuba::PropertySlice{
+        row_offset, KATANA_CHECKED(reader->ReadTable(uri))});
+    block = run_end;
+  }
+  return slices;
+}
+
+}  // namespace
+
+katana::Result<std::vector<tsuba::PropertySlice>>
+tsuba::RDG::ScanNodePropertyRange(
+    const std::string& property_name, double lower, double upper) const {
+  return ScanPropertyRange(
+      core_->part_header().node_prop_info_list(),
+      core_->part_header().FindNodeZoneMap(property_name), rdg_dir(),
+      property_name, lower, upper);
+}
+
+katana::Result<std::vector<tsuba::PropertySlice>>
+tsuba::RDG::ScanEdgePropertyRange(
+    const std::string& property_name, double lower, double upper) const {
+  return ScanPropertyRange(
+      core_->part_header().edge_prop_info_list(),
+      core_->part_header().FindEdgeZoneMap(property_name), rdg_dir(),
+      property_name, lower, upper);
+}
+
 katana::Result<void>
 tsuba::RDG::DoStore(
     RDGHandle handle, const std::string& command_line,
-    RDGVersioningPolicy versioning_action,
+    RDGVersioningPolicy versioning_action, bool topology_changed,
     std::unique_ptr<WriteGroup> write_group) {
   // bump the storage format version to the latest
   core_->part_header().update_storage_format_version();
 
+  // The change feed for this commit; dirty properties must be collected
+  // before WriteProperties marks them clean
+  RDGChangeSet change_set;
+  change_set.topology_changed = topology_changed;
+
   std::vector<std::string> node_prop_names;
   for (const auto& field : core_->node_properties()->fields()) {
     node_prop_names.emplace_back(field->name());
@@ -368,10 +696,18 @@ tsuba::RDG::DoStore(
   std::vector<PropStorageInfo*> node_props_to_store = KATANA_CHECKED(
       core_->part_header().SelectNodeProperties(node_prop_names));
 
+  for (const PropStorageInfo* prop : node_props_to_store) {
+    if (prop->IsDirty()) {
+      change_set.node_properties.emplace_back(prop->name());
+    }
+  }
+
   KATANA_CHECKED_CONTEXT(
       WriteProperties(
           *core_->node_properties(), node_props_to_store,
-          handle.impl_->rdg_manifest().dir(), write_group.get()),
+          handle.impl_->rdg_manifest().dir(), write_group.get(),
+          &core_->part_header().node_zone_maps(),
+          &core_->part_header().node_sketches()),
       "writing node properties");
 
   std::vector<std::string> edge_prop_names;
@@ -382,10 +718,18 @@ tsuba::RDG::DoStore(
   std::vector<PropStorageInfo*> edge_props_to_store = KATANA_CHECKED(
       core_->part_header().SelectEdgeProperties(edge_prop_names));
 
+  for (const PropStorageInfo* prop : edge_props_to_store) {
+    if (prop->IsDirty()) {
+      change_set.edge_properties.emplace_back(prop->name());
+    }
+  }
+
   KATANA_CHECKED_CONTEXT(
       WriteProperties(
           *core_->edge_properties(), edge_props_to_store,
-          handle.impl_->rdg_manifest().dir(), write_group.get()),
+          handle.impl_->rdg_manifest().dir(), write_group.get(),
+          &core_->part_header().edge_zone_maps(),
+          &core_->part_header().edge_sketches()),
       "writing edge properties");
 
   core_->part_header().set_part_properties(KATANA_CHECKED_CONTEXT(
@@ -405,6 +749,25 @@ tsuba::RDG::DoStore(
     return write_result.error().WithContext("failed to write metadata");
   }
 
+  // Publish the change set for the version this commit creates so
+  // incremental consumers can catch up without diffing whole versions.
+  // RetainVersion rewrites the current version in place and gets no entry.
+  if (versioning_action != RetainVersion) {
+    change_set.version = handle.impl_->rdg_manifest().version() + 1;
+    KATANA_CHECKED_CONTEXT(
+        OneHostOnly([&]() -> katana::Result<void> {
+          // POSIX specifies that text files end in a newline
+          std::string serialized = json(change_set).dump() + '\n';
+          return FileStore(
+              ChangeSetFileName(
+                  handle.impl_->rdg_manifest().dir(), change_set.version)
+                  .string(),
+              reinterpret_cast<const uint8_t*>(serialized.data()),
+              serialized.size());
+        }),
+        "writing change set");
+  }
+
   // Update lineage and commit
   core_->AddCommandLine(command_line);
   if (auto res = CommitRDG(
@@ -417,17 +780,15 @@ tsuba::RDG::DoStore(
   return katana::ResultSuccess();
 }
 
-katana::Result<void>
-tsuba::RDG::DoMake(
+katana::Result<bool>
+tsuba::RDG::DoMakeAsync(
     const std::vector<PropStorageInfo*>& node_props_to_be_loaded,
     const std::vector<PropStorageInfo*>& edge_props_to_be_loaded,
-    const katana::Uri& metadata_dir) {
-  ReadGroup grp;
-
+    const katana::Uri& metadata_dir, ReadGroup* grp) {
   KATANA_CHECKED_CONTEXT(
       AddProperties(
           metadata_dir, tsuba::NodeEdge::kNode, prop_cache_, this,
-          node_props_to_be_loaded, &grp,
+          node_props_to_be_loaded, grp,
           [rdg = this](const std::shared_ptr<arrow::Table>& props)
               -> katana::Result<void> {
             std::shared_ptr<arrow::Table> prop_table =
@@ -450,7 +811,7 @@ tsuba::RDG::DoMake(
   KATANA_CHECKED_CONTEXT(
       AddProperties(
           metadata_dir, tsuba::NodeEdge::kEdge, prop_cache_, this,
-          edge_props_to_be_loaded, &grp,
+          edge_props_to_be_loaded, grp,
           [rdg = this](const std::shared_ptr<arrow::Table>& props)
               -> katana::Result<void> {
             std::shared_ptr<arrow::Table> prop_table =
@@ -503,18 +864,27 @@ tsuba::RDG::DoMake(
   KATANA_CHECKED(core_->EnsureEdgeTypesLoaded());
 
   if (part_info.empty()) {
-    return grp.Finish();
+    return false;
   }
 
   KATANA_CHECKED_CONTEXT(
       AddProperties(
           metadata_dir, tsuba::NodeEdge::kNeitherNodeNorEdge, nullptr, nullptr,
-          part_info, &grp,
+          part_info, grp,
           [rdg = this](const std::shared_ptr<arrow::Table>& props) {
             return rdg->core_->AddPartitionMetadataArray(props);
           }),
       "populating partition metadata");
-  KATANA_CHECKED(grp.Finish());
+  return true;
+}
+
+katana::Result<void>
+tsuba::RDG::FinishMake(ReadGroup* grp, bool partition_metadata_scheduled) {
+  KATANA_CHECKED(grp->Finish());
+
+  if (!partition_metadata_scheduled) {
+    return katana::ResultSuccess();
+  }
 
   if (local_to_user_id()->length() == 0) {
     // for backward compatibility
@@ -559,6 +929,65 @@ tsuba::RDG::DoMake(
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+tsuba::RDG::DoMake(
+    const std::vector<PropStorageInfo*>& node_props_to_be_loaded,
+    const std::vector<PropStorageInfo*>& edge_props_to_be_loaded,
+    const katana::Uri& metadata_dir) {
+  ReadGroup grp;
+  const bool partition_metadata_scheduled = KATANA_CHECKED(DoMakeAsync(
+      node_props_to_be_loaded, edge_props_to_be_loaded, metadata_dir, &grp));
+  return FinishMake(&grp, partition_metadata_scheduled);
+}
+
+katana::Result<tsuba::RDGPrefetch>
+tsuba::RDG::MakePrefetch(
+    const RDGManifest& manifest, const RDGLoadOptions& opts) {
+  uint32_t partition_id_to_load =
+      opts.partition_id_to_load.value_or(Comm()->Rank);
+
+  katana::Uri partition_path = manifest.PartitionFileName(partition_id_to_load);
+
+  auto part_header_res = RDGPartHeader::Make(partition_path);
+  if (!part_header_res) {
+    return part_header_res.error().WithContext(
+        "failed to read path {}", partition_path);
+  }
+
+  std::unique_ptr<RDG> rdg(
+      new RDG(std::make_unique<RDGCore>(std::move(part_header_res.value()))));
+  rdg->prop_cache_ = opts.prop_cache;
+
+  // with lazy_properties, columns that are not hand-picked here fault in on
+  // first access instead of being selected up front
+  std::vector<PropStorageInfo*> node_props;
+  if (!opts.lazy_properties || opts.node_properties) {
+    node_props = KATANA_CHECKED(
+        rdg->core_->part_header().SelectNodeProperties(opts.node_properties));
+  }
+
+  std::vector<PropStorageInfo*> edge_props;
+  if (!opts.lazy_properties || opts.edge_properties) {
+    edge_props = KATANA_CHECKED(
+        rdg->core_->part_header().SelectEdgeProperties(opts.edge_properties));
+  }
+
+  auto grp = std::make_unique<ReadGroup>();
+  const bool partition_metadata_scheduled = KATANA_CHECKED(
+      rdg->DoMakeAsync(node_props, edge_props, manifest.dir(), grp.get()));
+
+  rdg->core_->set_partition_id(partition_id_to_load);
+
+  return RDGPrefetch(
+      std::move(rdg), std::move(grp), partition_metadata_scheduled);
+}
+
+katana::Result<tsuba::RDG>
+tsuba::RDGPrefetch::Finish() && {
+  KATANA_CHECKED(rdg_->FinishMake(grp_.get(), partition_metadata_scheduled_));
+  return RDG(std::move(*rdg_));
+}
+
 katana::Result<tsuba::RDG>
 tsuba::RDG::Make(const RDGManifest& manifest, const RDGLoadOptions& opts) {
   uint32_t partition_id_to_load =
@@ -575,11 +1004,19 @@ tsuba::RDG::Make(const RDGManifest& manifest, const RDGLoadOptions& opts) {
   RDG rdg(std::make_unique<RDGCore>(std::move(part_header_res.value())));
   rdg.prop_cache_ = opts.prop_cache;
 
-  std::vector<PropStorageInfo*> node_props = KATANA_CHECKED(
-      rdg.core_->part_header().SelectNodeProperties(opts.node_properties));
+  // with lazy_properties, columns that are not hand-picked here fault in on
+  // first access instead of being selected up front
+  std::vector<PropStorageInfo*> node_props;
+  if (!opts.lazy_properties || opts.node_properties) {
+    node_props = KATANA_CHECKED(
+        rdg.core_->part_header().SelectNodeProperties(opts.node_properties));
+  }
 
-  std::vector<PropStorageInfo*> edge_props = KATANA_CHECKED(
-      rdg.core_->part_header().SelectEdgeProperties(opts.edge_properties));
+  std::vector<PropStorageInfo*> edge_props;
+  if (!opts.lazy_properties || opts.edge_properties) {
+    edge_props = KATANA_CHECKED(
+        rdg.core_->part_header().SelectEdgeProperties(opts.edge_properties));
+  }
 
   KATANA_CHECKED(rdg.DoMake(node_props, edge_props, manifest.dir()));
 
@@ -615,6 +1052,15 @@ tsuba::RDG::Make(RDGHandle handle, const RDGLoadOptions& opts) {
   return Make(handle.impl_->rdg_manifest(), opts);
 }
 
+katana::Result<tsuba::RDGPrefetch>
+tsuba::RDG::MakePrefetch(RDGHandle handle, const RDGLoadOptions& opts) {
+  if (!handle.impl_->AllowsRead()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "handle does not allow full read");
+  }
+  return MakePrefetch(handle.impl_->rdg_manifest(), opts);
+}
+
 katana::Result<void>
 tsuba::RDG::Store(
     RDGHandle handle, const std::string& command_line,
@@ -648,6 +1094,7 @@ tsuba::RDG::Store(
   // All write buffers must outlive desc
   std::unique_ptr<WriteGroup> desc = std::move(desc_res.value());
 
+  bool topology_changed = topology_ff != nullptr;
   auto res = DoStoreTopology(handle, std::move(topology_ff), desc);
   if (!res) {
     return res.error();
@@ -668,7 +1115,35 @@ tsuba::RDG::Store(
   core_->part_header().StoreNodeEntityTypeManager(node_entity_type_manager);
   core_->part_header().StoreEdgeEntityTypeManager(edge_entity_type_manager);
 
-  return DoStore(handle, command_line, versioning_action, std::move(desc));
+  return DoStore(
+      handle, command_line, versioning_action, topology_changed,
+      std::move(desc));
+}
+
+katana::Result<std::vector<tsuba::RDGChangeSet>>
+tsuba::RDG::ChangesSince(RDGHandle handle, uint64_t since_version) {
+  if (!handle.impl_->AllowsRead()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "handle does not allow full read");
+  }
+  const RDGManifest& manifest = handle.impl_->rdg_manifest();
+
+  std::vector<RDGChangeSet> changes;
+  for (uint64_t version = since_version + 1; version <= manifest.version();
+       ++version) {
+    katana::Uri uri = ChangeSetFileName(manifest.dir(), version);
+
+    FileView fv;
+    KATANA_CHECKED_CONTEXT(
+        fv.Bind(uri.string(), true), "no change set for version {}", version);
+
+    RDGChangeSet change_set;
+    KATANA_CHECKED_CONTEXT(
+        katana::JsonParse<RDGChangeSet>(fv, &change_set), "cannot parse {}",
+        uri.string());
+    changes.emplace_back(std::move(change_set));
+  }
+  return changes;
 }
 
 katana::Result<void>
@@ -709,6 +1184,55 @@ tsuba::RDG::RemoveEdgeProperty(int i) {
   return core_->RemoveEdgeProperty(i);
 }
 
+void
+tsuba::RDG::MarkNodePropertyDirty(
+    const std::string& name, uint64_t row_begin, uint64_t row_end) {
+  core_->MarkNodePropertyDirty(name, row_begin, row_end);
+}
+
+void
+tsuba::RDG::MarkEdgePropertyDirty(
+    const std::string& name, uint64_t row_begin, uint64_t row_end) {
+  core_->MarkEdgePropertyDirty(name, row_begin, row_end);
+}
+
+const std::vector<tsuba::PropertyDirtyRange>&
+tsuba::RDG::node_dirty_ranges() const {
+  return core_->node_dirty_ranges();
+}
+
+const std::vector<tsuba::PropertyDirtyRange>&
+tsuba::RDG::edge_dirty_ranges() const {
+  return core_->edge_dirty_ranges();
+}
+
+void
+tsuba::RDG::ClearDirtyPropertyRanges() {
+  core_->ClearDirtyPropertyRanges();
+}
+
+void
+tsuba::RDG::SetNodePropertySketch(
+    const std::string& name, PropertySketch sketch) {
+  core_->part_header().node_sketches()[name] = std::move(sketch);
+}
+
+void
+tsuba::RDG::SetEdgePropertySketch(
+    const std::string& name, PropertySketch sketch) {
+  core_->part_header().edge_sketches()[name] = std::move(sketch);
+}
+
+const tsuba::PropertySketch*
+tsuba::RDG::GetNodePropertySketch(const std::string& name) const {
+  return core_->part_header().FindNodeSketch(name);
+}
+
+const tsuba::PropertySketch*
+tsuba::RDG::GetEdgePropertySketch(const std::string& name) const {
+  return core_->part_header().FindEdgeSketch(name);
+}
+
 namespace {
 
 katana::Result<std::shared_ptr<arrow::Table>>
@@ -973,33 +1497,39 @@ tsuba::RDG::local_to_global_id() const {
 void
 tsuba::RDG::set_master_nodes(
     std::vector<std::shared_ptr<arrow::ChunkedArray>>&& master_nodes) {
+  core_->part_header().MarkPartArraysDirty();
   return core_->set_master_nodes(std::move(master_nodes));
 }
 void
 tsuba::RDG::set_mirror_nodes(
     std::vector<std::shared_ptr<arrow::ChunkedArray>>&& mirror_nodes) {
+  core_->part_header().MarkPartArraysDirty();
   return core_->set_mirror_nodes(std::move(mirror_nodes));
 }
 void
 tsuba::RDG::set_host_to_owned_global_node_ids(
     std::shared_ptr<arrow::ChunkedArray>&& host_to_owned_global_node_ids) {
+  core_->part_header().MarkPartArraysDirty();
   return core_->set_host_to_owned_global_node_ids(
       std::move(host_to_owned_global_node_ids));
 }
 void
 tsuba::RDG::set_host_to_owned_global_edge_ids(
     std::shared_ptr<arrow::ChunkedArray>&& host_to_owned_global_edge_ids) {
+  core_->part_header().MarkPartArraysDirty();
   return core_->set_host_to_owned_global_edge_ids(
       std::move(host_to_owned_global_edge_ids));
 }
 void
 tsuba::RDG::set_local_to_user_id(
     std::shared_ptr<arrow::ChunkedArray>&& local_to_user_id) {
+  core_->part_header().MarkPartArraysDirty();
   return core_->set_local_to_user_id(std::move(local_to_user_id));
 }
 void
 tsuba::RDG::set_local_to_global_id(
     std::shared_ptr<arrow::ChunkedArray>&& local_to_global_id) {
+  core_->part_header().MarkPartArraysDirty();
   return core_->set_local_to_global_id(std::move(local_to_global_id));
 }
 
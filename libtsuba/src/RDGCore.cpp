@@ -62,6 +62,14 @@ UpsertProperties(
             next->AddColumn(last++, field, props->column(i)), "insert");
       }
     } else {
+      if (prop_info_it->IsClean() &&
+          next->column(current_col).get() == props->column(i).get() &&
+          next->field(current_col)->Equals(*field)) {
+        // the caller handed back the same column it read; leave the property
+        // clean so the next store links the existing file instead of
+        // rewriting it
+        continue;
+      }
       next = KATANA_CHECKED_CONTEXT(
           next->SetColumn(current_col, field, props->column(i)), "update");
     }
@@ -106,7 +114,7 @@ EnsureTypeLoaded(const katana::Uri& rdg_dir, tsuba::PropStorageInfo* psi) {
     auto reader = KATANA_CHECKED(tsuba::ParquetReader::Make());
     KATANA_LOG_ASSERT(psi->IsAbsent());
     std::shared_ptr<arrow::Schema> schema =
-        KATANA_CHECKED(reader->GetSchema(rdg_dir.Join(psi->path())));
+        KATANA_CHECKED(reader->GetSchema(psi->FileUri(rdg_dir)));
     psi->set_type(schema->field(0)->type());
   }
   return katana::ResultSuccess();
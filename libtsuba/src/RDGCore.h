@@ -8,6 +8,7 @@
 #include "RDGPartHeader.h"
 #include "katana/config.h"
 #include "tsuba/FileView.h"
+#include "tsuba/PropertySync.h"
 
 namespace tsuba {
 
@@ -226,6 +227,31 @@ public:
     lineage_.AddCommandLine(command_line);
   }
 
+  void MarkNodePropertyDirty(
+      const std::string& name, uint64_t row_begin, uint64_t row_end) {
+    node_dirty_ranges_.emplace_back(
+        PropertyDirtyRange{name, row_begin, row_end});
+  }
+
+  void MarkEdgePropertyDirty(
+      const std::string& name, uint64_t row_begin, uint64_t row_end) {
+    edge_dirty_ranges_.emplace_back(
+        PropertyDirtyRange{name, row_begin, row_end});
+  }
+
+  const std::vector<PropertyDirtyRange>& node_dirty_ranges() const {
+    return node_dirty_ranges_;
+  }
+
+  const std::vector<PropertyDirtyRange>& edge_dirty_ranges() const {
+    return edge_dirty_ranges_;
+  }
+
+  void ClearDirtyPropertyRanges() {
+    node_dirty_ranges_.clear();
+    edge_dirty_ranges_.clear();
+  }
+
 private:
   void InitEmptyProperties();
 
@@ -236,6 +262,10 @@ private:
   std::shared_ptr<arrow::Table> node_properties_;
   std::shared_ptr<arrow::Table> edge_properties_;
 
+  /// Row ranges modified in place since the last BroadcastPropertyDeltas
+  std::vector<PropertyDirtyRange> node_dirty_ranges_;
+  std::vector<PropertyDirtyRange> edge_dirty_ranges_;
+
   FileView topology_file_storage_;
 
   FileView node_entity_type_id_array_file_storage_;
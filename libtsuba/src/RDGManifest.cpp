@@ -1,5 +1,6 @@
 #include "tsuba/RDGManifest.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "Constants.h"
@@ -124,8 +125,15 @@ RDGManifest::PartitionFileName(
 
 katana::Uri
 RDGManifest::PartitionFileName(uint32_t host_id) const {
-  return RDGManifest::PartitionFileName(
-      view_specifier(), dir_, host_id, version());
+  if (host_id >= part_file_cache_.size()) {
+    part_file_cache_.resize(std::max<size_t>(num_hosts_, host_id + 1));
+  }
+  katana::Uri& name = part_file_cache_[host_id];
+  if (name.empty()) {
+    name = RDGManifest::PartitionFileName(
+        view_specifier(), dir_, host_id, version());
+  }
+  return name;
 }
 
 std::string
@@ -291,6 +299,7 @@ tsuba::from_json(const json& j, tsuba::RDGManifest& manifest) {
   j.at("magic").get_to(magic);
   j.at("version").get_to(manifest.version_);
   j.at("num_hosts").get_to(manifest.num_hosts_);
+  manifest.part_file_cache_.clear();
 
   // these values are temporarily optional
   if (auto it = j.find("previous_version"); it != j.end()) {
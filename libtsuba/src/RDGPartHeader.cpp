@@ -1,8 +1,13 @@
 #include "RDGPartHeader.h"
 
+#include <array>
+#include <cstring>
+#include <future>
+
 #include "Constants.h"
 #include "GlobalState.h"
 #include "RDGHandleImpl.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
@@ -16,6 +21,14 @@ namespace {
 const char* kTopologyPathKey = "kg.v1.topology.path";
 const char* kNodePropertyKey = "kg.v1.node_property";
 const char* kEdgePropertyKey = "kg.v1.edge_property";
+// Index file at path holds the id permutation for the named property
+const char* kNodePropertyIndexKey = "kg.v1.node_property_index";
+const char* kEdgePropertyIndexKey = "kg.v1.edge_property_index";
+// Per-block min/max bounds for numeric properties, keyed by property name
+const char* kNodeZoneMapKey = "kg.v1.node_property_zone_map";
+const char* kEdgeZoneMapKey = "kg.v1.edge_property_zone_map";
+const char* kNodeSketchKey = "kg.v1.node_property_sketch";
+const char* kEdgeSketchKey = "kg.v1.edge_property_sketch";
 const char* kPartPropertyFilesKey = "kg.v1.part_property_files";
 const char* kPartPropertyMetaKey = "kg.v1.part_property_meta";
 const char* kStorageFormatVersionKey = "kg.v1.storage_format_version";
@@ -53,6 +66,79 @@ CopyProperty(
   return tsuba::FileStore(new_path.string(), fv.ptr<uint8_t>(), fv.size());
 }
 
+/*
+ * Binary part header format
+ *
+ * JSON parsing of the property info lists dominates open time for graphs
+ * with very many properties, so part headers can also be stored as:
+ *
+ *   BinaryPartHeaderPreamble   magic, sizes and entry counts (little-endian)
+ *   common section             JSON for everything except the property lists
+ *   node section               packed node PropStorageInfo entries
+ *   edge section               packed edge PropStorageInfo entries
+ *
+ * A packed entry is two length-prefixed strings (name, path); decoding one
+ * is two string copies instead of a JSON object parse, and the two property
+ * sections decode concurrently with the common JSON. Readers sniff the
+ * magic and fall back to JSON for part headers written by older code.
+ */
+
+struct BinaryPartHeaderPreamble {
+  std::array<char, 8> magic;
+  uint64_t common_size;
+  uint64_t node_section_size;
+  uint64_t node_count;
+  uint64_t edge_section_size;
+  uint64_t edge_count;
+};
+
+constexpr std::array<char, 8> kBinaryPartHeaderMagic = {'k', 'a', 't', 'p',
+                                                        'a', 'r', 't', '1'};
+
+void
+AppendPropSection(
+    std::string* out, const std::vector<tsuba::PropStorageInfo>& props) {
+  for (const auto& prop : props) {
+    uint32_t name_len = prop.name().size();
+    uint32_t path_len = prop.path().size();
+    out->append(reinterpret_cast<const char*>(&name_len), sizeof(name_len));
+    out->append(reinterpret_cast<const char*>(&path_len), sizeof(path_len));
+    out->append(prop.name());
+    out->append(prop.path());
+  }
+}
+
+katana::CopyableResult<std::vector<tsuba::PropStorageInfo>>
+DecodePropSection(const uint8_t* data, uint64_t size, uint64_t count) {
+  std::vector<tsuba::PropStorageInfo> props;
+  props.reserve(count);
+  uint64_t off = 0;
+  for (uint64_t i = 0; i < count; ++i) {
+    uint32_t name_len = 0;
+    uint32_t path_len = 0;
+    if (off + sizeof(name_len) + sizeof(path_len) > size) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::InvalidArgument,
+          "truncated property section: entry {} of {}", i, count);
+    }
+    memcpy(&name_len, data + off, sizeof(name_len));
+    off += sizeof(name_len);
+    memcpy(&path_len, data + off, sizeof(path_len));
+    off += sizeof(path_len);
+    if (off + name_len + path_len > size) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::InvalidArgument,
+          "truncated property section: entry {} of {}", i, count);
+    }
+    std::string name(reinterpret_cast<const char*>(data + off), name_len);
+    off += name_len;
+    std::string path(reinterpret_cast<const char*>(data + off), path_len);
+    off += path_len;
+    props.emplace_back(std::move(name), std::move(path));
+  }
+  return props;
+}
+
 }  // namespace
 
 // TODO(vkarthik): repetitive code from RDGManifest, try to unify
@@ -78,41 +164,128 @@ const std::regex kPartitionFile(
 const int kPartitionMatchHostIndex = 3;
 
 katana::Result<RDGPartHeader>
-RDGPartHeader::MakeJson(const katana::Uri& partition_path) {
-  tsuba::FileView fv;
-  if (auto res = fv.Bind(partition_path.string(), true); !res) {
-    return res.error();
-  }
-  if (fv.size() == 0) {
-    return tsuba::RDGPartHeader();
+RDGPartHeader::MakeJson(const tsuba::FileView& fv) {
+  tsuba::RDGPartHeader header;
+  auto json_res = katana::JsonParse<tsuba::RDGPartHeader>(fv, &header);
+  if (!json_res) {
+    return json_res.error();
   }
+  return header;
+}
 
+katana::Result<RDGPartHeader>
+RDGPartHeader::MakeBinary(const tsuba::FileView& fv) {
+  BinaryPartHeaderPreamble preamble;
+  memcpy(&preamble, fv.ptr<uint8_t>(), sizeof(preamble));
+  uint64_t total = sizeof(preamble) + preamble.common_size +
+                   preamble.node_section_size + preamble.edge_section_size;
+  if (total > fv.size()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "truncated part header: sections need {} bytes but file has {}", total,
+        fv.size());
+  }
+  const uint8_t* common = fv.ptr<uint8_t>() + sizeof(preamble);
+  const uint8_t* node_section = common + preamble.common_size;
+  const uint8_t* edge_section = node_section + preamble.node_section_size;
+
+  // decode the property sections concurrently with the common JSON; for
+  // wide graphs they hold the bulk of the bytes
+  auto node_fut = std::async(std::launch::async, [&preamble, node_section]() {
+    return DecodePropSection(
+        node_section, preamble.node_section_size, preamble.node_count);
+  });
+  auto edge_fut = std::async(std::launch::async, [&preamble, edge_section]() {
+    return DecodePropSection(
+        edge_section, preamble.edge_section_size, preamble.edge_count);
+  });
+
+  std::string_view common_view(
+      reinterpret_cast<const char*>(common), preamble.common_size);
   tsuba::RDGPartHeader header;
-  auto json_res = katana::JsonParse<tsuba::RDGPartHeader>(fv, &header);
+  auto json_res = katana::JsonParse<tsuba::RDGPartHeader>(common_view, &header);
+
+  auto node_res = node_fut.get();
+  auto edge_res = edge_fut.get();
   if (!json_res) {
     return json_res.error();
   }
+  header.set_node_prop_info_list(KATANA_CHECKED(std::move(node_res)));
+  header.set_edge_prop_info_list(KATANA_CHECKED(std::move(edge_res)));
   return header;
 }
 
 katana::Result<RDGPartHeader>
 RDGPartHeader::Make(const katana::Uri& partition_path) {
-  return KATANA_CHECKED(MakeJson(partition_path));
+  tsuba::FileView fv;
+  if (auto res = fv.Bind(partition_path.string(), true); !res) {
+    return res.error();
+  }
+  if (fv.size() == 0) {
+    return tsuba::RDGPartHeader();
+  }
+  if (fv.size() >= sizeof(BinaryPartHeaderPreamble) &&
+      memcmp(
+          fv.ptr<char>(), kBinaryPartHeaderMagic.data(),
+          kBinaryPartHeaderMagic.size()) == 0) {
+    return KATANA_CHECKED(MakeBinary(fv));
+  }
+  return KATANA_CHECKED(MakeJson(fv));
+}
+
+katana::Result<std::string>
+RDGPartHeader::SerializeBinary() const {
+  // everything except the property lists stays JSON; the lists are written
+  // as empty arrays so the common section parses with the same from_json
+  json j;
+  to_json(j, *this);
+  j[kNodePropertyKey] = json::array();
+  j[kEdgePropertyKey] = json::array();
+  std::string common = KATANA_CHECKED(katana::JsonDump(j));
+
+  std::string node_section;
+  AppendPropSection(&node_section, node_prop_info_list_);
+  std::string edge_section;
+  AppendPropSection(&edge_section, edge_prop_info_list_);
+
+  BinaryPartHeaderPreamble preamble;
+  preamble.magic = kBinaryPartHeaderMagic;
+  preamble.common_size = common.size();
+  preamble.node_section_size = node_section.size();
+  preamble.node_count = node_prop_info_list_.size();
+  preamble.edge_section_size = edge_section.size();
+  preamble.edge_count = edge_prop_info_list_.size();
+
+  std::string serialized;
+  serialized.reserve(
+      sizeof(preamble) + common.size() + node_section.size() +
+      edge_section.size());
+  serialized.append(
+      reinterpret_cast<const char*>(&preamble), sizeof(preamble));
+  serialized.append(common);
+  serialized.append(node_section);
+  serialized.append(edge_section);
+  return serialized;
 }
 
 katana::Result<void>
 RDGPartHeader::Write(
     RDGHandle handle, WriteGroup* writes,
     RDG::RDGVersioningPolicy retain_version) const {
-  auto serialized_res = katana::JsonDump(*this);
-  if (!serialized_res) {
-    return serialized_res.error();
-  }
-
-  std::string serialized = std::move(serialized_res.value());
+  std::string serialized;
+  if (katana::GetEnv("KATANA_PART_HEADER_JSON")) {
+    // plain JSON, readable by older code
+    auto serialized_res = katana::JsonDump(*this);
+    if (!serialized_res) {
+      return serialized_res.error();
+    }
+    serialized = std::move(serialized_res.value());
 
-  // POSIX files end with newlines
-  serialized = serialized + "\n";
+    // POSIX files end with newlines
+    serialized = serialized + "\n";
+  } else {
+    serialized = KATANA_CHECKED(SerializeBinary());
+  }
 
   TSUBA_PTP(internal::FaultSensitivity::Normal);
   auto ff = std::make_unique<FileFrame>();
@@ -250,6 +423,14 @@ RDGPartHeader::ChangeStorageLocation(
     }
   }
 
+  // index files are never held in memory, so they are always copied
+  for (PropStorageInfo& prop : node_index_info_list_) {
+    KATANA_CHECKED(CopyProperty(&prop, old_location, new_location));
+  }
+  for (PropStorageInfo& prop : edge_index_info_list_) {
+    KATANA_CHECKED(CopyProperty(&prop, old_location, new_location));
+  }
+
   // clear out specific file paths so that we know to store them later
   topology_path_ = "";
   node_entity_type_id_array_path_ = "";
@@ -275,6 +456,12 @@ tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
       {kTopologyPathKey, header.topology_path_},
       {kNodePropertyKey, header.node_prop_info_list_},
       {kEdgePropertyKey, header.edge_prop_info_list_},
+      {kNodePropertyIndexKey, header.node_index_info_list_},
+      {kEdgePropertyIndexKey, header.edge_index_info_list_},
+      {kNodeZoneMapKey, header.node_zone_maps_},
+      {kEdgeZoneMapKey, header.edge_zone_maps_},
+      {kNodeSketchKey, header.node_sketches_},
+      {kEdgeSketchKey, header.edge_sketches_},
       {kPartPropertyFilesKey, header.part_prop_info_list_},
       {kPartPropertyMetaKey, header.metadata_},
       {kStorageFormatVersionKey, header.storage_format_version_},
@@ -295,6 +482,26 @@ tsuba::from_json(const json& j, tsuba::RDGPartHeader& header) {
   j.at(kPartPropertyFilesKey).get_to(header.part_prop_info_list_);
   j.at(kPartPropertyMetaKey).get_to(header.metadata_);
 
+  // property index lists are absent from part headers written by older code
+  if (auto it = j.find(kNodePropertyIndexKey); it != j.end()) {
+    it->get_to(header.node_index_info_list_);
+  }
+  if (auto it = j.find(kEdgePropertyIndexKey); it != j.end()) {
+    it->get_to(header.edge_index_info_list_);
+  }
+  if (auto it = j.find(kNodeZoneMapKey); it != j.end()) {
+    it->get_to(header.node_zone_maps_);
+  }
+  if (auto it = j.find(kEdgeZoneMapKey); it != j.end()) {
+    it->get_to(header.edge_zone_maps_);
+  }
+  if (auto it = j.find(kNodeSketchKey); it != j.end()) {
+    it->get_to(header.node_sketches_);
+  }
+  if (auto it = j.find(kEdgeSketchKey); it != j.end()) {
+    it->get_to(header.edge_sketches_);
+  }
+
   if (auto it = j.find(kStorageFormatVersionKey); it != j.end()) {
     it->get_to(header.storage_format_version_);
   } else {
@@ -372,3 +579,30 @@ void
 tsuba::to_json(json& j, const tsuba::PropStorageInfo& propmd) {
   j = json{propmd.name(), propmd.path()};
 }
+
+void
+tsuba::to_json(json& j, const tsuba::PropertyZoneMap& zone_map) {
+  j = json{{"mins", zone_map.mins}, {"maxs", zone_map.maxs}};
+}
+
+void
+tsuba::from_json(const nlohmann::json& j, tsuba::PropertyZoneMap& zone_map) {
+  j.at("mins").get_to(zone_map.mins);
+  j.at("maxs").get_to(zone_map.maxs);
+}
+
+void
+tsuba::to_json(json& j, const tsuba::PropertySketch& sketch) {
+  j = json{
+      {"rows_read", sketch.rows_read},
+      {"approx_distinct", sketch.approx_distinct},
+      {"reservoir", sketch.reservoir},
+  };
+}
+
+void
+tsuba::from_json(const nlohmann::json& j, tsuba::PropertySketch& sketch) {
+  j.at("rows_read").get_to(sketch.rows_read);
+  j.at("approx_distinct").get_to(sketch.approx_distinct);
+  j.at("reservoir").get_to(sketch.reservoir);
+}
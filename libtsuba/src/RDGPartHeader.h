@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <map>
 #include <optional>
 #include <regex>
 #include <string>
@@ -24,6 +25,8 @@
 
 namespace tsuba {
 
+class FileView;
+
 /// PropStorageInfo objects track the state of properties, and sanity check their
 /// transitions. N.b., It does not "DO" the transitions, this structure is purely
 /// for bookkeeping
@@ -76,6 +79,7 @@ public:
 
   void WasModified(const std::shared_ptr<arrow::DataType>& type) {
     path_.clear();
+    file_uri_cache_ = katana::Uri();
     state_ = State::kDirty;
     type_ = type;
   }
@@ -83,6 +87,7 @@ public:
   void WasWritten(std::string_view new_path) {
     KATANA_LOG_ASSERT(state_ == State::kDirty);
     path_ = new_path;
+    file_uri_cache_ = katana::Uri();
     state_ = State::kClean;
   }
 
@@ -99,6 +104,19 @@ public:
 
   const std::string& name() const { return name_; }
   const std::string& path() const { return path_; }
+
+  /// Absolute storage location of this property under \p dir. Loading a
+  /// graph resolves every property against the same directory, so the
+  /// joined URI is assembled once and reused; the cache is dropped whenever
+  /// the relative path changes
+  const katana::Uri& FileUri(const katana::Uri& dir) const {
+    if (file_uri_cache_.empty() || file_uri_cache_dir_ != dir) {
+      file_uri_cache_dir_ = dir;
+      file_uri_cache_ = dir.Join(path_);
+    }
+    return file_uri_cache_;
+  }
+
   const std::shared_ptr<arrow::DataType>& type() const { return type_; }
 
   // since we don't have type info in the header don't know the
@@ -121,6 +139,9 @@ private:
   std::string path_;
   std::shared_ptr<arrow::DataType> type_;
   State state_;
+  // lazily assembled by FileUri
+  mutable katana::Uri file_uri_cache_;
+  mutable katana::Uri file_uri_cache_dir_;
 };
 
 class KATANA_EXPORT RDGPartHeader {
@@ -133,6 +154,10 @@ public:
       RDGHandle handle, WriteGroup* writes,
       RDG::RDGVersioningPolicy retain_version) const;
 
+  /// Serialize to the binary part header format; see RDGPartHeader.cpp for
+  /// the layout. Write uses this unless KATANA_PART_HEADER_JSON is set.
+  katana::Result<std::string> SerializeBinary() const;
+
   /// Mark all in-memory properties dirty so that they can be written
   /// out, copy out-of-memory properties
   katana::Result<void> ChangeStorageLocation(
@@ -164,6 +189,15 @@ public:
     return SelectProperties(&part_prop_info_list_, std::nullopt);
   }
 
+  /// Mark every partition metadata array as modified; called when the
+  /// in-memory arrays are replaced so the next Store rewrites them instead
+  /// of linking the files the loaded version pointed at
+  void MarkPartArraysDirty() {
+    for (PropStorageInfo& prop : part_prop_info_list_) {
+      prop.WasModified(prop.type());
+    }
+  }
+
   void UpsertNodePropStorageInfo(PropStorageInfo&& pmd) {
     auto pmd_it = std::find_if(
         node_prop_info_list_.begin(), node_prop_info_list_.end(),
@@ -190,9 +224,97 @@ public:
     }
   }
 
+  /// Record a persisted property index file for the named node column.
+  /// Index files are written eagerly, so an existing entry is replaced
+  /// outright; the part header carries the entry to storage at the next
+  /// Store.
+  void UpsertNodeIndexStorageInfo(PropStorageInfo&& pmd) {
+    auto pmd_it = std::find_if(
+        node_index_info_list_.begin(), node_index_info_list_.end(),
+        [&](const PropStorageInfo& my_pmd) {
+          return my_pmd.name() == pmd.name();
+        });
+    if (pmd_it == node_index_info_list_.end()) {
+      node_index_info_list_.emplace_back(std::move(pmd));
+    } else {
+      *pmd_it = std::move(pmd);
+    }
+  }
+
+  void UpsertEdgeIndexStorageInfo(PropStorageInfo&& pmd) {
+    auto pmd_it = std::find_if(
+        edge_index_info_list_.begin(), edge_index_info_list_.end(),
+        [&](const PropStorageInfo& my_pmd) {
+          return my_pmd.name() == pmd.name();
+        });
+    if (pmd_it == edge_index_info_list_.end()) {
+      edge_index_info_list_.emplace_back(std::move(pmd));
+    } else {
+      *pmd_it = std::move(pmd);
+    }
+  }
+
+  const PropStorageInfo* FindNodeIndexStorageInfo(
+      const std::string& name) const {
+    for (const PropStorageInfo& psi : node_index_info_list_) {
+      if (psi.name() == name) {
+        return &psi;
+      }
+    }
+    return nullptr;
+  }
+
+  const PropStorageInfo* FindEdgeIndexStorageInfo(
+      const std::string& name) const {
+    for (const PropStorageInfo& psi : edge_index_info_list_) {
+      if (psi.name() == name) {
+        return &psi;
+      }
+    }
+    return nullptr;
+  }
+
+  std::map<std::string, PropertyZoneMap>& node_zone_maps() {
+    return node_zone_maps_;
+  }
+
+  std::map<std::string, PropertyZoneMap>& edge_zone_maps() {
+    return edge_zone_maps_;
+  }
+
+  const PropertyZoneMap* FindNodeZoneMap(const std::string& name) const {
+    auto it = node_zone_maps_.find(name);
+    return it == node_zone_maps_.end() ? nullptr : &it->second;
+  }
+
+  const PropertyZoneMap* FindEdgeZoneMap(const std::string& name) const {
+    auto it = edge_zone_maps_.find(name);
+    return it == edge_zone_maps_.end() ? nullptr : &it->second;
+  }
+
+  std::map<std::string, PropertySketch>& node_sketches() {
+    return node_sketches_;
+  }
+
+  std::map<std::string, PropertySketch>& edge_sketches() {
+    return edge_sketches_;
+  }
+
+  const PropertySketch* FindNodeSketch(const std::string& name) const {
+    auto it = node_sketches_.find(name);
+    return it == node_sketches_.end() ? nullptr : &it->second;
+  }
+
+  const PropertySketch* FindEdgeSketch(const std::string& name) const {
+    auto it = edge_sketches_.find(name);
+    return it == edge_sketches_.end() ? nullptr : &it->second;
+  }
+
   void RemoveNodeProperty(uint32_t i) {
     auto& p = node_prop_info_list_;
     KATANA_LOG_DEBUG_ASSERT(i < p.size());
+    node_zone_maps_.erase(p[i].name());
+    node_sketches_.erase(p[i].name());
     p.erase(p.begin() + i);
   }
 
@@ -206,12 +328,16 @@ public:
           tsuba::ErrorCode::PropertyNotFound, "no such node property");
     }
     p.erase(it);
+    node_zone_maps_.erase(name);
+    node_sketches_.erase(name);
     return katana::ResultSuccess();
   }
 
   void RemoveEdgeProperty(uint32_t i) {
     auto& p = edge_prop_info_list_;
     KATANA_LOG_DEBUG_ASSERT(i < p.size());
+    edge_zone_maps_.erase(p[i].name());
+    edge_sketches_.erase(p[i].name());
     p.erase(p.begin() + i);
   }
 
@@ -225,6 +351,8 @@ public:
           tsuba::ErrorCode::PropertyNotFound, "no such edge property");
     }
     p.erase(it);
+    edge_zone_maps_.erase(name);
+    edge_sketches_.erase(name);
     return katana::ResultSuccess();
   }
 
@@ -271,6 +399,14 @@ public:
     edge_prop_info_list_ = std::move(edge_prop_info_list);
   }
 
+  const std::vector<PropStorageInfo>& node_index_info_list() const {
+    return node_index_info_list_;
+  }
+
+  const std::vector<PropStorageInfo>& edge_index_info_list() const {
+    return edge_index_info_list_;
+  }
+
   const std::vector<PropStorageInfo>& part_prop_info_list() const {
     return part_prop_info_list_;
   }
@@ -472,8 +608,11 @@ private:
     return DoSelectProperties(storage_info);
   }
 
-  static katana::Result<RDGPartHeader> MakeJson(
-      const katana::Uri& partition_path);
+  static katana::Result<RDGPartHeader> MakeJson(const tsuba::FileView& fv);
+
+  /// Parse the binary part header format; see RDGPartHeader.cpp for the
+  /// layout. The property info sections decode in parallel.
+  static katana::Result<RDGPartHeader> MakeBinary(const tsuba::FileView& fv);
 
   void set_node_entity_type_id_dictionary(
       const tsuba::EntityTypeIDToSetOfEntityTypeIDsStorageMap&
@@ -501,6 +640,21 @@ private:
   std::vector<PropStorageInfo> node_prop_info_list_;
   std::vector<PropStorageInfo> edge_prop_info_list_;
 
+  /// Persisted property index files (the sorted id permutation for a
+  /// column). Unlike properties these have no in-memory dirty state; the
+  /// files are written eagerly and the entries stay in the Absent state.
+  std::vector<PropStorageInfo> node_index_info_list_;
+  std::vector<PropStorageInfo> edge_index_info_list_;
+
+  /// Zone maps for numeric properties, keyed by property name. Recomputed
+  /// whenever a dirty property is written, so an entry always describes
+  /// the file the matching PropStorageInfo points at.
+  std::map<std::string, PropertyZoneMap> node_zone_maps_;
+  std::map<std::string, PropertyZoneMap> edge_zone_maps_;
+
+  std::map<std::string, PropertySketch> node_sketches_;
+  std::map<std::string, PropertySketch> edge_sketches_;
+
   /// Metadata filled in by CuSP, or from storage (meta partition file)
   PartitionMetadata metadata_;
 
@@ -540,6 +694,12 @@ void from_json(const nlohmann::json& j, RDGPartHeader& header);
 void to_json(nlohmann::json& j, const PropStorageInfo& propmd);
 void from_json(const nlohmann::json& j, PropStorageInfo& propmd);
 
+void to_json(nlohmann::json& j, const PropertyZoneMap& zone_map);
+void from_json(const nlohmann::json& j, PropertyZoneMap& zone_map);
+
+void to_json(nlohmann::json& j, const PropertySketch& sketch);
+void from_json(const nlohmann::json& j, PropertySketch& sketch);
+
 void to_json(nlohmann::json& j, const PartitionMetadata& propmd);
 void from_json(const nlohmann::json& j, PartitionMetadata& propmd);
 
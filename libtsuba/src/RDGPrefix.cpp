@@ -1,5 +1,9 @@
 #include "tsuba/RDGPrefix.h"
 
+#include <cstring>
+
+#include <arrow/util/compression.h>
+
 #include "RDGHandleImpl.h"
 #include "RDGPartHeader.h"
 #include "katana/Result.h"
@@ -9,6 +13,61 @@
 
 namespace tsuba {
 
+katana::Result<tsuba::RDGPrefix>
+RDGPrefix::MakeCompressedPrefix(
+    const katana::Uri& t_path, const CompressedTopologyHeader& header) {
+  // fetch the frame directory, then only the leading frames; the container
+  // guarantees no frame crosses the end of the out index array, so the edge
+  // destinations are never transferred
+  uint64_t frames_off = CompressedTopologyFramesOffset(header);
+  FileView directory;
+  KATANA_CHECKED_CONTEXT(
+      directory.Bind(t_path.string(), sizeof(header), frames_off, true),
+      "failed to bind frame directory of {}", t_path);
+  const auto* chunks =
+      directory.ptr<CompressedTopologyChunk>(sizeof(header));
+
+  uint64_t raw = 0;
+  uint64_t frames_end = frames_off;
+  uint64_t prefix_chunks = 0;
+  for (uint64_t i = 0; i < header.num_chunks && raw < header.index_bytes;
+       ++i) {
+    raw += chunks[i].raw_size;
+    frames_end += chunks[i].compressed_size;
+    prefix_chunks = i + 1;
+  }
+  if (raw != header.index_bytes) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "frames of {} do not line up with its out index array", t_path);
+  }
+
+  FileView fv;
+  KATANA_CHECKED_CONTEXT(
+      fv.Bind(t_path.string(), frames_off, frames_end, true),
+      "failed to bind {}", t_path);
+
+  std::vector<uint8_t> prefix(header.index_bytes);
+  std::unique_ptr<arrow::util::Codec> codec =
+      KATANA_CHECKED(arrow::util::Codec::Create(arrow::Compression::ZSTD));
+  uint64_t src = 0;
+  uint64_t dst = 0;
+  for (uint64_t i = 0; i < prefix_chunks; ++i) {
+    int64_t decoded = KATANA_CHECKED(codec->Decompress(
+        chunks[i].compressed_size, fv.ptr<uint8_t>(frames_off + src),
+        chunks[i].raw_size, prefix.data() + dst));
+    if (static_cast<uint64_t>(decoded) != chunks[i].raw_size) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "frame {} of {} decoded {} of {} bytes",
+          i, t_path, decoded, chunks[i].raw_size);
+    }
+    src += chunks[i].compressed_size;
+    dst += chunks[i].raw_size;
+  }
+
+  return RDGPrefix(std::move(prefix), header.index_bytes);
+}
+
 katana::Result<tsuba::RDGPrefix>
 RDGPrefix::DoMakePrefix(const tsuba::RDGManifest& manifest) {
   auto meta_res = RDGPartHeader::Make(manifest.PartitionFileName(0));
@@ -23,11 +82,23 @@ RDGPrefix::DoMakePrefix(const tsuba::RDGManifest& manifest) {
 
   katana::Uri t_path = manifest.dir().Join(part_header.topology_path());
 
-  CSRTopologyHeader gr_header;
-  if (auto res = FileGet(t_path.string(), &gr_header); !res) {
+  // the compressed container header is the same size as the CSR header, so
+  // one ranged read serves both formats
+  static_assert(
+      sizeof(CompressedTopologyHeader) == sizeof(CSRTopologyHeader));
+  CompressedTopologyHeader c_header;
+  if (auto res = FileGet(t_path.string(), &c_header); !res) {
     return res.error().WithContext(
-        "file get failed: {}: sz: {}", t_path, sizeof(gr_header));
+        "file get failed: {}: sz: {}", t_path, sizeof(c_header));
+  }
+  if (memcmp(
+          c_header.magic.data(), kCompressedTopologyMagic.data(),
+          kCompressedTopologyMagic.size()) == 0) {
+    return MakeCompressedPrefix(t_path, c_header);
   }
+
+  CSRTopologyHeader gr_header;
+  memcpy(&gr_header, &c_header, sizeof(gr_header));
   FileView fv;
   if (auto res = fv.Bind(
           t_path.string(),
@@ -1,11 +1,18 @@
 #include "tsuba/RDGSlice.h"
 
+#include <cstdlib>
+#include <limits>
+
 #include "AddProperties.h"
+#include "GlobalState.h"
 #include "RDGCore.h"
 #include "RDGHandleImpl.h"
 #include "katana/EntityTypeManager.h"
 #include "katana/Logging.h"
+#include "tsuba/CSRTopology.h"
 #include "tsuba/Errors.h"
+#include "tsuba/PartitionMetadata.h"
+#include "tsuba/file.h"
 
 katana::Result<void>
 tsuba::RDGSlice::DoMake(
@@ -13,13 +20,24 @@ tsuba::RDGSlice::DoMake(
     const std::optional<std::vector<std::string>>& edge_props,
     const katana::Uri& metadata_dir, const SliceArg& slice) {
   ReadGroup grp;
+  // register every byte range with the read group up front so the topology
+  // and type array fetches stream concurrently with the property slices
+  // below instead of serializing on per-range storage latency
   katana::Uri topology_path =
       metadata_dir.Join(core_->part_header().topology_path());
-  KATANA_CHECKED_CONTEXT(
-      core_->topology_file_storage().Bind(
-          topology_path.string(), slice.topo_off,
-          slice.topo_off + slice.topo_size, true),
-      "loading topology array");
+  grp.AddOp(
+      std::async(
+          std::launch::async,
+          [core = core_.get(), path = topology_path.string(),
+           slice]() -> katana::CopyableResult<void> {
+            KATANA_CHECKED_CONTEXT(
+                core->topology_file_storage().Bind(
+                    path, slice.topo_off, slice.topo_off + slice.topo_size,
+                    true),
+                "loading topology array");
+            return katana::CopyableResultSuccess();
+          }),
+      topology_path.string(), []() { return katana::CopyableResultSuccess(); });
 
   if (core_->part_header().IsEntityTypeIDsOutsideProperties()) {
     katana::Uri node_types_path = metadata_dir.Join(
@@ -27,20 +45,40 @@ tsuba::RDGSlice::DoMake(
     katana::Uri edge_types_path = metadata_dir.Join(
         core_->part_header().edge_entity_type_id_array_path());
 
-    KATANA_CHECKED_CONTEXT(
-        core_->node_entity_type_id_array_file_storage().Bind(
-            node_types_path.string(),
-            slice.node_range.first * sizeof(katana::EntityTypeID),
-            slice.node_range.second * sizeof(katana::EntityTypeID), true),
-        "loading node type id array; begin: {}, end: {}",
-        slice.node_range.first * sizeof(katana::EntityTypeID),
-        slice.node_range.second * sizeof(katana::EntityTypeID));
-    KATANA_CHECKED_CONTEXT(
-        core_->edge_entity_type_id_array_file_storage().Bind(
-            edge_types_path.string(),
-            slice.edge_range.first * sizeof(katana::EntityTypeID),
-            slice.edge_range.second * sizeof(katana::EntityTypeID), true),
-        "loading edge type id array");
+    grp.AddOp(
+        std::async(
+            std::launch::async,
+            [core = core_.get(), path = node_types_path.string(),
+             slice]() -> katana::CopyableResult<void> {
+              KATANA_CHECKED_CONTEXT(
+                  core->node_entity_type_id_array_file_storage().Bind(
+                      path,
+                      slice.node_range.first * sizeof(katana::EntityTypeID),
+                      slice.node_range.second * sizeof(katana::EntityTypeID),
+                      true),
+                  "loading node type id array; begin: {}, end: {}",
+                  slice.node_range.first * sizeof(katana::EntityTypeID),
+                  slice.node_range.second * sizeof(katana::EntityTypeID));
+              return katana::CopyableResultSuccess();
+            }),
+        node_types_path.string(),
+        []() { return katana::CopyableResultSuccess(); });
+    grp.AddOp(
+        std::async(
+            std::launch::async,
+            [core = core_.get(), path = edge_types_path.string(),
+             slice]() -> katana::CopyableResult<void> {
+              KATANA_CHECKED_CONTEXT(
+                  core->edge_entity_type_id_array_file_storage().Bind(
+                      path,
+                      slice.edge_range.first * sizeof(katana::EntityTypeID),
+                      slice.edge_range.second * sizeof(katana::EntityTypeID),
+                      true),
+                  "loading edge type id array");
+              return katana::CopyableResultSuccess();
+            }),
+        edge_types_path.string(),
+        []() { return katana::CopyableResultSuccess(); });
   }
   core_->set_rdg_dir(metadata_dir);
   // all of the properties
@@ -192,6 +230,119 @@ tsuba::RDGSlice::Make(
   return RDGSlice(std::move(rdg_slice));
 }
 
+katana::Result<tsuba::RDGSlice>
+tsuba::RDGSlice::MakePartitioned(
+    const std::string& rdg_manifest_path,
+    const std::optional<std::vector<std::string>>& node_props,
+    const std::optional<std::vector<std::string>>& edge_props,
+    PartitionMetadata* metadata, std::vector<SliceArg>* all_slices) {
+  katana::CommBackend* comm = Comm();
+
+  RDGManifest manifest = KATANA_CHECKED(FindManifest(rdg_manifest_path));
+  if (manifest.num_hosts() != 1) {
+    return KATANA_ERROR(
+        ErrorCode::NotImplemented,
+        "MakePartitioned slices an unpartitioned graph; this one already "
+        "has {} partitions",
+        manifest.num_hosts());
+  }
+  katana::Uri partition_path(manifest.PartitionFileName(0));
+  auto part_header = KATANA_CHECKED(RDGPartHeader::Make(partition_path));
+  katana::Uri topology_uri =
+      manifest.dir().Join(part_header.topology_path());
+
+  CSRTopologyHeader header{};
+  KATANA_CHECKED_CONTEXT(
+      FileGet(topology_uri.string(), &header), "reading topology header");
+  uint64_t edge_size =
+      header.version == 1 ? sizeof(uint32_t) : sizeof(uint64_t);
+
+  // Split nodes evenly; CSR makes each host's edge range contiguous. Only
+  // the out-index entries at this host's cut points are read, and the edge
+  // cuts are exchanged below so nobody re-reads the whole prefix.
+  uint64_t num_hosts = comm->Num;
+  uint64_t node_begin = (header.num_nodes * comm->Rank) / num_hosts;
+  uint64_t node_end = (header.num_nodes * (comm->Rank + 1)) / num_hosts;
+  auto edge_start_of = [&](uint64_t node) -> katana::Result<uint64_t> {
+    if (node == 0) {
+      return uint64_t{0};
+    }
+    uint64_t start = 0;
+    KATANA_CHECKED_CONTEXT(
+        FileGet(
+            topology_uri.string(), &start,
+            sizeof(CSRTopologyHeader) + (node - 1) * sizeof(uint64_t),
+            sizeof(uint64_t)),
+        "reading out-index entry for node {}", node);
+    return start;
+  };
+  uint64_t edge_begin = KATANA_CHECKED(edge_start_of(node_begin));
+  uint64_t edge_end = KATANA_CHECKED(edge_start_of(node_end));
+
+  // every host contributes its starting edge cut; host r+1's cut is host
+  // r's end, and the last host ends at num_edges
+  std::vector<uint64_t> edge_cuts(num_hosts + 1);
+  for (uint32_t r = 0; r < num_hosts; ++r) {
+    std::string cut = comm->Broadcast(
+        r, std::to_string(edge_begin), std::numeric_limits<uint64_t>::digits10 + 1);
+    edge_cuts[r] = std::strtoull(cut.c_str(), nullptr, 10);
+  }
+  edge_cuts[num_hosts] = header.num_edges;
+  if (edge_cuts[comm->Rank] != edge_begin) {
+    return KATANA_ERROR(
+        ErrorCode::MpiError,
+        "hosts disagree about edge cuts; are they reading the same graph?");
+  }
+
+  auto slice_for = [&](uint32_t r) {
+    return SliceArg{
+        .node_range =
+            {(header.num_nodes * r) / num_hosts,
+             (header.num_nodes * (r + 1)) / num_hosts},
+        .edge_range = {edge_cuts[r], edge_cuts[r + 1]},
+        .topo_off = sizeof(CSRTopologyHeader) +
+                    header.num_nodes * sizeof(uint64_t) +
+                    edge_cuts[r] * edge_size,
+        .topo_size = (edge_cuts[r + 1] - edge_cuts[r]) * edge_size,
+    };
+  };
+  if (all_slices != nullptr) {
+    all_slices->clear();
+    for (uint32_t r = 0; r < num_hosts; ++r) {
+      all_slices->push_back(slice_for(r));
+    }
+  }
+  if (metadata != nullptr) {
+    *metadata = PartitionMetadata{};
+    metadata->is_outgoing_edge_cut_ = true;
+    metadata->num_global_nodes_ = header.num_nodes;
+    metadata->max_global_node_id_ =
+        header.num_nodes > 0 ? header.num_nodes - 1 : 0;
+    metadata->num_global_edges_ = header.num_edges;
+    metadata->num_edges_ = edge_end - edge_begin;
+    metadata->num_nodes_ = static_cast<uint32_t>(node_end - node_begin);
+    metadata->num_owned_ = static_cast<uint32_t>(node_end - node_begin);
+  }
+
+  RDGSlice rdg_slice(std::make_unique<RDGCore>(std::move(part_header)));
+  auto load_res = rdg_slice.DoMake(
+      node_props, edge_props, manifest.dir(), slice_for(comm->Rank));
+
+  // agree on the outcome so no host continues with a partial job
+  bool all_ok = true;
+  for (uint32_t r = 0; r < num_hosts; ++r) {
+    all_ok &= comm->Broadcast(r, static_cast<bool>(load_res));
+  }
+  if (!load_res) {
+    return load_res.error();
+  }
+  if (!all_ok) {
+    return KATANA_ERROR(
+        ErrorCode::MpiError, "partitioned load failed on a remote host");
+  }
+  return RDGSlice(std::move(rdg_slice));
+}
+
 const katana::Uri&
 tsuba::RDGSlice::rdg_dir() const {
   return core_->rdg_dir();
@@ -1,9 +1,35 @@
 #include "tsuba/ReadGroup.h"
 
+#include "katana/Env.h"
+
+namespace {
+
+// Bound on reads in flight per ReadGroup, configurable with
+// KATANA_MAX_OUTSTANDING_READS. Object stores tolerate many concurrent
+// streams, but a graph with thousands of properties should not open
+// thousands of them at once.
+uint64_t
+MaxOutstandingReads() {
+  static uint64_t max_ops = []() -> uint64_t {
+    int ops = 0;
+    if (katana::GetEnv("KATANA_MAX_OUTSTANDING_READS", &ops) && ops > 0) {
+      return ops;
+    }
+    return 256;
+  }();
+  return max_ops;
+}
+
+}  // namespace
+
 void
 tsuba::ReadGroup::AddOp(
     std::future<katana::CopyableResult<void>> future, std::string file,
     const std::function<katana::CopyableResult<void>()>& on_complete) {
+  // complete the oldest reads first so the number in flight stays bounded
+  while (async_op_group_.outstanding() >= MaxOutstandingReads()) {
+    async_op_group_.FinishOne();
+  }
   async_op_group_.AddOp(std::move(future), std::move(file), on_complete);
 }
 
@@ -1,5 +1,7 @@
 #include "tsuba/WriteGroup.h"
 
+#include <mutex>
+
 #include "GlobalState.h"
 #include "katana/Random.h"
 #include "katana/Result.h"
@@ -11,12 +13,19 @@ namespace {
 
 constexpr uint32_t kTagLen = 12;
 
+// the group most recently handed to DrainAsync; guarded by pending_mutex
+std::mutex pending_mutex;
+std::future<katana::CopyableResult<void>> pending_drain;
+
 }  // namespace
 
 namespace tsuba {
 
 Result<std::unique_ptr<WriteGroup>>
 WriteGroup::Make() {
+  // surface a write-behind failure here, before the next batch starts
+  KATANA_CHECKED_CONTEXT(FinishPending(), "draining previous write group");
+
   // Don't use `OneHostOnly` because we can skip its broadcast
   std::string tag;
   if (Comm()->Rank == 0) {
@@ -31,6 +40,38 @@ WriteGroup::Finish() {
   return async_op_group_.Finish();
 }
 
+void
+WriteGroup::DrainAsync(
+    std::unique_ptr<WriteGroup> group,
+    std::function<katana::CopyableResult<void>()> on_drained) {
+  std::lock_guard<std::mutex> lock(pending_mutex);
+  KATANA_LOG_ASSERT(!pending_drain.valid());
+  pending_drain = std::async(
+      std::launch::async,
+      [group = std::move(group),
+       on_drained = std::move(on_drained)]() -> katana::CopyableResult<void> {
+        KATANA_CHECKED_CONTEXT(group->Finish(), "write-behind group failed");
+        if (on_drained) {
+          KATANA_CHECKED(on_drained());
+        }
+        return katana::CopyableResultSuccess();
+      });
+}
+
+Result<void>
+WriteGroup::FinishPending() {
+  std::future<katana::CopyableResult<void>> drain;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    if (!pending_drain.valid()) {
+      return katana::ResultSuccess();
+    }
+    drain = std::move(pending_drain);
+  }
+  KATANA_CHECKED(drain.get());
+  return katana::ResultSuccess();
+}
+
 void
 WriteGroup::AddOp(
     std::future<katana::CopyableResult<void>> future, std::string file,
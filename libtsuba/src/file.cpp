@@ -16,17 +16,42 @@
 
 #include "GlobalState.h"
 #include "katana/Logging.h"
+#include "katana/Metrics.h"
 #include "katana/Platform.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
 
+namespace {
+
+// live I/O volume for the metrics exporter; counted at issue time so
+// in-flight async transfers are visible
+std::atomic<uint64_t>&
+ReadBytesCounter() {
+  static std::shared_ptr<std::atomic<uint64_t>> counter =
+      katana::MetricsRegistry::Get().RegisterCounter(
+          "katana_tsuba_read_bytes", "Bytes requested from tsuba storage");
+  return *counter;
+}
+
+std::atomic<uint64_t>&
+WriteBytesCounter() {
+  static std::shared_ptr<std::atomic<uint64_t>> counter =
+      katana::MetricsRegistry::Get().RegisterCounter(
+          "katana_tsuba_write_bytes", "Bytes written to tsuba storage");
+  return *counter;
+}
+
+}  // namespace
+
 katana::Result<void>
 tsuba::FileStore(const std::string& uri, const void* data, uint64_t size) {
+  WriteBytesCounter().fetch_add(size, std::memory_order_relaxed);
   return FS(uri)->PutMultiSync(uri, static_cast<const uint8_t*>(data), size);
 }
 
 std::future<katana::CopyableResult<void>>
 tsuba::FileStoreAsync(const std::string& uri, const void* data, uint64_t size) {
+  WriteBytesCounter().fetch_add(size, std::memory_order_relaxed);
   return FS(uri)->PutAsync(uri, static_cast<const uint8_t*>(data), size);
 }
 
@@ -34,6 +59,7 @@ katana::Result<void>
 tsuba::FileGet(
     const std::string& uri, void* result_buffer, uint64_t begin,
     uint64_t size) {
+  ReadBytesCounter().fetch_add(size, std::memory_order_relaxed);
   return FS(uri)->GetMultiSync(
       uri, begin, size, static_cast<uint8_t*>(result_buffer));
 }
@@ -42,6 +68,7 @@ std::future<katana::CopyableResult<void>>
 tsuba::FileGetAsync(
     const std::string& uri, void* result_buffer, uint64_t begin,
     uint64_t size) {
+  ReadBytesCounter().fetch_add(size, std::memory_order_relaxed);
   return FS(uri)->GetAsync(
       uri, begin, size, static_cast<uint8_t*>(result_buffer));
 }
@@ -73,6 +100,13 @@ tsuba::FileListAsync(
   return FS(directory)->ListAsync(directory, list, size);
 }
 
+std::future<katana::CopyableResult<void>>
+tsuba::FileListPrefixAsync(
+    const std::string& directory, const std::string& prefix,
+    std::vector<std::string>* list, std::vector<uint64_t>* size) {
+  return FS(directory)->ListPrefixAsync(directory, prefix, list, size);
+}
+
 katana::Result<void>
 tsuba::FileDelete(
     const std::string& directory,
@@ -1,5 +1,10 @@
 #include "tsuba/tsuba.h"
 
+#include <future>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "GlobalState.h"
 #include "RDGHandleImpl.h"
 #include "RDGPartHeader.h"
@@ -9,6 +14,7 @@
 #include "katana/Signals.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
+#include "tsuba/WriteGroup.h"
 #include "tsuba/file.h"
 
 namespace {
@@ -16,9 +22,9 @@ namespace {
 katana::NullCommBackend default_comm_backend;
 
 katana::Result<std::vector<std::string>>
-FileList(const std::string& dir) {
+FileList(const std::string& dir, const std::string& prefix = "") {
   std::vector<std::string> files;
-  auto list_fut = tsuba::FileListAsync(dir, &files);
+  auto list_fut = tsuba::FileListPrefixAsync(dir, prefix, &files);
   KATANA_LOG_ASSERT(list_fut.valid());
 
   if (auto res = list_fut.get(); !res) {
@@ -30,7 +36,10 @@ FileList(const std::string& dir) {
 katana::Result<katana::Uri>
 FindAnyManifestForLatestVersion(const katana::Uri& name) {
   KATANA_LOG_DEBUG_ASSERT(!tsuba::RDGManifest::IsManifestUri(name));
-  auto list_res = FileList(name.string());
+  // only manifests are of interest; don't make the backend return the
+  // hundreds of thousands of member files a versioned store can hold
+  auto list_res =
+      FileList(name.string(), tsuba::RDGManifest::kFileNamePrefix);
   if (!list_res) {
     return list_res.error();
   }
@@ -142,7 +151,8 @@ katana::Result<std::pair<uint64_t, std::vector<tsuba::RDGView>>>
 tsuba::ListViewsOfVersion(
     const std::string& rdg_dir, std::optional<uint64_t> version) {
   auto rdg_uri = KATANA_CHECKED(katana::Uri::Make(rdg_dir));
-  std::vector<std::string> files = KATANA_CHECKED(FileList(rdg_uri.string()));
+  std::vector<std::string> files = KATANA_CHECKED(
+      FileList(rdg_uri.string(), tsuba::RDGManifest::kFileNamePrefix));
 
   std::vector<tsuba::RDGView> views_found;
   uint64_t latest_version = 0;
@@ -317,6 +327,174 @@ tsuba::CopyRDG(std::vector<std::pair<katana::Uri, katana::Uri>> src_dst_files) {
   return katana::ResultSuccess();
 }
 
+namespace {
+
+// S3 DeleteObjects caps a batch at 1000 keys; other backends just see
+// fewer round trips
+constexpr size_t kGCDeleteBatchSize = 1000;
+
+katana::Result<tsuba::RDGManifest>
+LoadManifestForVersion(
+    const katana::Uri& rdg_uri, const std::string& view_specifier,
+    uint64_t version) {
+  return tsuba::RDGManifest::Make(
+      tsuba::RDGManifest::FileName(rdg_uri, view_specifier, version));
+}
+
+}  // namespace
+
+katana::Result<tsuba::GCReport>
+tsuba::GC(const std::string& rdg_dir, uint64_t keep_versions, bool dry_run) {
+  if (keep_versions == 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "GC must retain at least one version");
+  }
+  katana::Uri rdg_uri = KATANA_CHECKED(katana::Uri::Make(rdg_dir));
+  if (RDGManifest::IsManifestUri(rdg_uri)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "GC takes the RDG's directory, not a manifest: {}", rdg_uri.string());
+  }
+
+  // one full listing up front; liveness is decided against this snapshot
+  // and the sizes feed the report
+  std::vector<std::string> all_files;
+  std::vector<uint64_t> all_sizes;
+  auto list_fut = FileListAsync(rdg_uri.string(), &all_files, &all_sizes);
+  KATANA_LOG_ASSERT(list_fut.valid());
+  if (auto res = list_fut.get(); !res) {
+    return res.error();
+  }
+
+  // newest manifest of every view; each view has its own version chain
+  struct ViewHead {
+    uint64_t version{0};
+    std::string file;
+  };
+  std::unordered_map<std::string, ViewHead> heads;
+  for (const std::string& file : all_files) {
+    auto version_res = RDGManifest::ParseVersionFromName(file);
+    if (!version_res) {
+      continue;
+    }
+    auto type_res = RDGManifest::ParseViewNameFromName(file);
+    auto args_res = RDGManifest::ParseViewArgsFromName(file);
+    if (!type_res || !args_res) {
+      continue;
+    }
+    std::string specifier =
+        args_res.value().empty()
+            ? type_res.value()
+            : fmt::format(
+                  "{}-{}", type_res.value(),
+                  fmt::join(args_res.value(), "-"));
+    ViewHead& head = heads[specifier];
+    if (version_res.value() >= head.version) {
+      head.version = version_res.value();
+      head.file = file;
+    }
+  }
+  if (heads.empty()) {
+    return KATANA_ERROR(
+        ErrorCode::NotFound, "no manifest files found in {}",
+        rdg_uri.string());
+  }
+
+  // walk each chain through previous_version links; any failure to read
+  // retained metadata aborts before anything is deleted
+  std::vector<RDGManifest> retained;
+  for (const auto& [specifier, head] : heads) {
+    RDGManifest manifest = KATANA_CHECKED_CONTEXT(
+        RDGManifest::Make(rdg_uri.Join(head.file)),
+        "reading newest manifest of view {}", specifier);
+    for (uint64_t kept = 1;; ++kept) {
+      uint64_t version = manifest.version();
+      uint64_t prev = manifest.previous_version();
+      retained.emplace_back(std::move(manifest));
+      if (kept >= keep_versions || prev >= version || prev == 0) {
+        break;
+      }
+      manifest = KATANA_CHECKED_CONTEXT(
+          LoadManifestForVersion(rdg_uri, specifier, prev),
+          "view {} version {} links to previous version {}", specifier,
+          version, prev);
+    }
+  }
+
+  // the live set is what retained versions reference, not what they
+  // wrote: delta commits share unchanged files with older versions, and
+  // reading the partition headers (RDGManifest::FileNames) respects
+  // those links. One reader task per retained version.
+  std::vector<std::future<katana::CopyableResult<std::set<std::string>>>>
+      file_name_futures;
+  file_name_futures.reserve(retained.size());
+  for (RDGManifest& manifest : retained) {
+    file_name_futures.emplace_back(std::async(
+        std::launch::async,
+        [&manifest]() -> katana::CopyableResult<std::set<std::string>> {
+          auto res = manifest.FileNames();
+          if (!res) {
+            return katana::CopyableErrorInfo{res.error()};
+          }
+          return std::move(res.value());
+        }));
+  }
+  std::unordered_set<std::string> live;
+  for (auto& fut : file_name_futures) {
+    auto res = fut.get();
+    if (!res) {
+      return res.error();
+    }
+    live.insert(res.value().begin(), res.value().end());
+  }
+
+  GCReport report;
+  report.versions_retained = retained.size();
+  report.live_files = live.size();
+
+  // everything listed but referenced by no retained version is dead;
+  // delete in parallel batches
+  std::vector<std::future<katana::CopyableResult<void>>> delete_futures;
+  std::unordered_set<std::string> batch;
+  auto flush_batch = [&]() {
+    if (batch.empty()) {
+      return;
+    }
+    delete_futures.emplace_back(std::async(
+        std::launch::async,
+        [dir = rdg_uri.string(),
+         files = std::move(batch)]() -> katana::CopyableResult<void> {
+          if (auto res = FileDelete(dir, files); !res) {
+            return katana::CopyableErrorInfo{res.error()};
+          }
+          return katana::CopyableResultSuccess();
+        }));
+    batch.clear();
+  };
+  for (size_t i = 0; i < all_files.size(); ++i) {
+    if (live.count(all_files[i]) > 0) {
+      continue;
+    }
+    report.files_deleted += 1;
+    report.bytes_deleted += (i < all_sizes.size()) ? all_sizes[i] : 0;
+    if (dry_run) {
+      continue;
+    }
+    batch.insert(all_files[i]);
+    if (batch.size() >= kGCDeleteBatchSize) {
+      flush_batch();
+    }
+  }
+  flush_batch();
+
+  for (auto& fut : delete_futures) {
+    if (auto res = fut.get(); !res) {
+      return res.error();
+    }
+  }
+  return report;
+}
+
 katana::Uri
 tsuba::MakeTopologyFileName(tsuba::RDGHandle handle) {
   return GetRDGDir(handle).RandFile("topology");
@@ -332,6 +510,18 @@ tsuba::MakeEdgeEntityTypeIDArrayFileName(tsuba::RDGHandle handle) {
   return GetRDGDir(handle).RandFile("edge_entity_type_id_array");
 }
 
+katana::Uri
+tsuba::MakeNodePropertyIndexFileName(
+    tsuba::RDGHandle handle, const std::string& column_name) {
+  return GetRDGDir(handle).RandFile("node_property_index_" + column_name);
+}
+
+katana::Uri
+tsuba::MakeEdgePropertyIndexFileName(
+    tsuba::RDGHandle handle, const std::string& column_name) {
+  return GetRDGDir(handle).RandFile("edge_property_index_" + column_name);
+}
+
 katana::Uri
 tsuba::GetRDGDir(tsuba::RDGHandle handle) {
   return handle.impl_->rdg_manifest().dir();
@@ -350,6 +540,8 @@ tsuba::Init() {
 
 katana::Result<void>
 tsuba::Fini() {
+  // flush any write-behind group before the storage backends go away
+  KATANA_CHECKED(WriteGroup::FinishPending());
   auto r = GlobalState::Fini();
   return r;
 }
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "tsuba/FileFrameStream.h"
+#include "tsuba/FileView.h"
+#include "tsuba/file.h"
+#include "tsuba/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+katana::Result<void>
+EnsureDir(const std::string& path) {
+  if (boost::system::error_code err; !fs::create_directories(path, err)) {
+    if (err) {
+      return KATANA_ERROR(
+          std::error_code(err.value(), err.category()),
+          "creating parent directories: {}", err.message());
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestChunked(const std::string& path) {
+  auto uri = KATANA_CHECKED(katana::Uri::MakeFromFile(path));
+  auto file_uri = uri.Join("chunked_file");
+
+  // chunk size much smaller than the payload so many parts are exercised,
+  // including writes that straddle chunk boundaries
+  constexpr uint64_t kChunkSize = 1024;
+  constexpr uint64_t kPayloadSize = 10 * kChunkSize + 123;
+
+  std::vector<uint8_t> payload(kPayloadSize);
+  for (uint64_t i = 0; i < kPayloadSize; ++i) {
+    payload[i] = static_cast<uint8_t>(i * 31);
+  }
+
+  KATANA_LOG_ASSERT(tsuba::FileFrameStream::Supports(file_uri.string()));
+
+  tsuba::FileFrameStream ffs;
+  KATANA_CHECKED(ffs.Init(kChunkSize));
+  ffs.Bind(file_uri.string());
+
+  // uneven write sizes so chunk boundaries never line up with writes
+  uint64_t off = 0;
+  uint64_t write_size = 1;
+  while (off < kPayloadSize) {
+    uint64_t n = std::min(write_size, kPayloadSize - off);
+    auto status = ffs.Write(payload.data() + off, n);
+    KATANA_LOG_ASSERT(status.ok());
+    off += n;
+    write_size = write_size * 2 + 1;
+  }
+  KATANA_CHECKED(ffs.Finish());
+
+  tsuba::FileView fv;
+  KATANA_CHECKED(fv.Bind(file_uri.string(), true));
+  KATANA_LOG_ASSERT(fv.size() == kPayloadSize);
+  KATANA_LOG_ASSERT(
+      memcmp(fv.ptr<uint8_t>(), payload.data(), kPayloadSize) == 0);
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestEmpty(const std::string& path) {
+  auto uri = KATANA_CHECKED(katana::Uri::MakeFromFile(path));
+  auto file_uri = uri.Join("empty_file");
+
+  tsuba::FileFrameStream ffs;
+  KATANA_CHECKED(ffs.Init(1024));
+  ffs.Bind(file_uri.string());
+  KATANA_CHECKED(ffs.Finish());
+
+  tsuba::FileView fv;
+  KATANA_CHECKED(fv.Bind(file_uri.string(), true));
+  KATANA_LOG_ASSERT(fv.size() == 0);
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestAll(const std::string& path) {
+  KATANA_CHECKED(EnsureDir(path));
+  KATANA_CHECKED_CONTEXT(TestChunked(path), "TestChunked");
+  KATANA_CHECKED_CONTEXT(TestEmpty(path), "TestEmpty");
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+  if (auto init_good = tsuba::Init(); !init_good) {
+    KATANA_LOG_FATAL("tsuba::Init: {}", init_good.error());
+  }
+
+  if (argc <= 1) {
+    KATANA_LOG_FATAL("{} <empty dir>", argv[0]);
+  }
+
+  auto res = TestAll(argv[1]);
+  if (!res) {
+    KATANA_LOG_FATAL("test failed: {}", res.error());
+  }
+
+  if (auto fini_good = tsuba::Fini(); !fini_good) {
+    KATANA_LOG_FATAL("tsuba::Fini: {}", fini_good.error());
+  }
+
+  return 0;
+}
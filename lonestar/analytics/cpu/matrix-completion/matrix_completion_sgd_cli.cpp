@@ -102,10 +102,25 @@ static cll::opt<bool> useDetInit(
 
 static cll::opt<MatrixCompletionPlan::Algorithm> algo(
     "algo", cll::desc("Choose an algorithm:"),
-    cll::values(clEnumValN(
-        MatrixCompletionPlan::kSGDByItems, "sgdByItems",
-        "Simple SGD on Items")),
+    cll::values(
+        clEnumValN(
+            MatrixCompletionPlan::kSGDByItems, "sgdByItems",
+            "Simple SGD on Items"),
+        clEnumValN(
+            MatrixCompletionPlan::kSGDByItemsHogwild, "sgdByItemsHogwild",
+            "SGD on Items with Hogwild unsynchronized updates"),
+        clEnumValN(
+            MatrixCompletionPlan::kSGDBlockEdge, "sgdBlockEdge",
+            "SGD on edges tiled into locked item x user blocks")),
     cll::init(MatrixCompletionPlan::kSGDByItems));
+
+static cll::opt<unsigned> itemsPerBlock(
+    "itemsPerBlock", cll::desc("items per block (for sgdBlockEdge)"),
+    cll::init(MatrixCompletionPlan::kDefaultItemsPerBlock));
+
+static cll::opt<unsigned> usersPerBlock(
+    "usersPerBlock", cll::desc("users per block (for sgdBlockEdge)"),
+    cll::init(MatrixCompletionPlan::kDefaultUsersPerBlock));
 /*
  * Commandline options for different learning functions
  */
@@ -149,6 +164,18 @@ main(int argc, char** argv) {
         maxUpdates, updatesPerEdge, fixedRounds, useExactError, useDetInit,
         learningRateFunction);
     break;
+  case MatrixCompletionPlan::kSGDByItemsHogwild:
+    plan = MatrixCompletionPlan::SGDByItemsHogwild(
+        learningRate, decayRate, lambda, tolerance, useSameLatentVector,
+        maxUpdates, updatesPerEdge, fixedRounds, useExactError, useDetInit,
+        learningRateFunction);
+    break;
+  case MatrixCompletionPlan::kSGDBlockEdge:
+    plan = MatrixCompletionPlan::SGDBlockEdge(
+        learningRate, decayRate, lambda, tolerance, useSameLatentVector,
+        maxUpdates, updatesPerEdge, fixedRounds, useExactError, useDetInit,
+        learningRateFunction, itemsPerBlock, usersPerBlock);
+    break;
   default:
     KATANA_LOG_FATAL("invalid algorithm");
   }
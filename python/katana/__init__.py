@@ -32,7 +32,7 @@ try:
 
     __version__ = katana.globals.get_version()
 
-    from katana._loops import OrderedByIntegerMetric, PerSocketChunkFIFO, UserContext, do_all, for_each
+    from katana._loops import OrderedByIntegerMetric, PerSocketChunkFIFO, UserContext, do_all, do_all_batch, for_each
     from katana.loop_operators import do_all_operator, for_each_operator, obim_metric
 except ModuleNotFoundError as e:
     if "katana.katana_static_state" in str(e):
@@ -60,6 +60,7 @@ __all__ = [
     "TsubaError",
     "UserContext",
     "do_all",
+    "do_all_batch",
     "do_all_operator",
     "for_each",
     "for_each_operator",
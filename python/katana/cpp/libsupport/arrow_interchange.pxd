@@ -0,0 +1,18 @@
+from libcpp.memory cimport shared_ptr
+
+from pyarrow.lib cimport CChunkedArray
+
+from katana.cpp.libsupport.result cimport Result
+
+
+cdef extern from "arrow/c/abi.h" nogil:
+    cdef struct ArrowSchema:
+        pass
+
+    cdef struct ArrowArray:
+        pass
+
+
+cdef extern from "katana/ArrowInterchange.h" namespace "katana" nogil:
+    Result[void] ExportChunkedArray(
+        const shared_ptr[CChunkedArray]& chunked, ArrowArray* out_array, ArrowSchema* out_schema)
@@ -1,20 +1,20 @@
 import numpy
 import pyarrow
 
-from pyarrow.lib cimport pyarrow_unwrap_table, pyarrow_wrap_chunked_array, pyarrow_wrap_schema, to_shared
+from pyarrow.lib cimport CChunkedArray, pyarrow_unwrap_table, pyarrow_wrap_chunked_array, pyarrow_wrap_schema, to_shared
 
 from katana.cpp.libgalois.graphs cimport Graph as CGraph
+from katana.cpp.libsupport.arrow_interchange cimport ArrowArray, ArrowSchema, ExportChunkedArray
 from katana.cpp.libsupport.entity_type_manager cimport EntityTypeManager
 from katana.cpp.libsupport.result cimport Result, handle_result_void, raise_error_code
 
-from katana.native_interfacing._pyarrow_wrappers import unchunked
 
 from . cimport datastructures
 
 from . import datastructures
 
 from cython.operator cimport dereference as deref
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uintptr_t
 from libcpp.memory cimport shared_ptr, unique_ptr
 from libcpp.string cimport string
 from libcpp.utility cimport move
@@ -32,6 +32,21 @@ cdef _convert_string_list(l):
     return [bytes(s, "utf-8") for s in l or []]
 
 
+cdef _export_to_pyarrow(shared_ptr[CChunkedArray] chunked):
+    """
+    Hand a C++ chunked array to pyarrow over the Arrow C data interface.
+    Single-chunk columns cross zero-copy (pyarrow shares the C++ buffers);
+    multi-chunk columns are consolidated on the C++ side with the GIL
+    released, so other Python threads keep running while a large column
+    materializes.
+    """
+    cdef ArrowArray c_array
+    cdef ArrowSchema c_schema
+    with nogil:
+        handle_result_void(ExportChunkedArray(chunked, &c_array, &c_schema))
+    return pyarrow.Array._import_from_c(<uintptr_t>&c_array, <uintptr_t>&c_schema)
+
+
 cdef shared_ptr[_PropertyGraph] handle_result_PropertyGraph(Result[unique_ptr[_PropertyGraph]] res) nogil except *:
     if not res.has_value():
         with gil:
@@ -168,11 +183,15 @@ cdef class GraphBase:
 
     def get_node_property(self, prop):
         """
-        Return a `pyarrow` array or chunked array storing the data for node property `prop`.
-        This attempts to unwrap chunked arrays if possible.
+        Return a `pyarrow` array storing the data for node property `prop`.
+        The data crosses into Python zero-copy over the Arrow C data interface;
+        a property held in several chunks is consolidated first with the GIL
+        released.
         `prop` may be either a name or an index.
         """
-        return unchunked(self.get_node_property_chunked(prop))
+        return _export_to_pyarrow(
+            self.underlying_property_graph().GetNodeProperty(Graph._property_name_to_id(prop, self.loaded_node_schema()))
+        )
 
     def get_node_property_chunked(self, prop):
         """
@@ -186,11 +205,15 @@ cdef class GraphBase:
 
     def get_edge_property(self, prop):
         """
-        Return a `pyarrow` array or chunked array storing the data for edge property `prop`.
-        This attempts to unwrap chunked arrays if possible.
+        Return a `pyarrow` array storing the data for edge property `prop`.
+        The data crosses into Python zero-copy over the Arrow C data interface;
+        a property held in several chunks is consolidated first with the GIL
+        released.
         `prop` may be either a name or an index.
         """
-        return unchunked(self.get_edge_property_chunked(prop))
+        return _export_to_pyarrow(
+            self.underlying_property_graph().GetEdgeProperty(Graph._property_name_to_id(prop, self.loaded_edge_schema()))
+        )
 
     def get_edge_property_chunked(self, prop):
         """
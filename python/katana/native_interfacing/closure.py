@@ -9,6 +9,7 @@ from numba.extending import lower_builtin, type_callable
 
 from katana.native_interfacing import exec_in_file
 from katana.native_interfacing.katana_compiler import OperatorCompiler, cfunc
+from katana.native_interfacing.operator_cache import caching_enabled, exec_in_cache_file, specialization_key
 from katana.timer import StatTimer
 
 PointerPair = ctypes.c_void_p * 2
@@ -58,7 +59,8 @@ class _ClosureInstance:
         Environment = self._build_environment(func, bound_args)
         store_struct = self._build_store_struct(Environment)
         load_struct = self._build_load_struct(Environment)
-        wrapper = self._build_wrapper(func, load_struct, return_type, bound_args, unbound_args)
+        cache_key = specialization_key(func, return_type, bound_args, unbound_args)
+        wrapper = self._build_wrapper(func, load_struct, return_type, bound_args, unbound_args, cache_key)
 
         self.Environment = Environment
         self.store_struct = store_struct
@@ -86,25 +88,30 @@ class Environment():
         return exec_glbls["Environment"]
 
     @staticmethod
-    def _build_wrapper(func, load_struct, return_type, bound_args, unbound_args):
+    def _build_wrapper(func, load_struct, return_type, bound_args, unbound_args, cache_key):
         """
         The arguments are unpacked from the jitclass pointer passed as an int64.
+
+        The wrapper source is written to the persistent operator cache under a name derived from
+        ``cache_key`` so that numba's on-disk cache can reuse the compiled code across processes;
+        the key is stable for a given operator source and argument types.
         """
         exec_glbls = dict(func=func, load_struct=load_struct, return_type=return_type, unbound_args=unbound_args)
         exec_glbls["cfunc"] = cfunc
         exec_glbls["types"] = types
         exec_glbls["OperatorCompiler"] = OperatorCompiler
+        exec_glbls["enable_cache"] = caching_enabled()
         unbound_pass_args = (
             "" if not unbound_args else ", ".join(f"unbound_arg{i}" for i, t in enumerate(unbound_args)) + ","
         )
         extract_env = "" if not bound_args else ", ".join(f"userdata.arg{i}" for i, t in enumerate(bound_args)) + ","
         src = f"""
-@cfunc(return_type(*unbound_args, types.int64), nopython=True, nogil=True, cache=False, pipeline_class=OperatorCompiler)
+@cfunc(return_type(*unbound_args, types.int64), nopython=True, nogil=True, cache=enable_cache, pipeline_class=OperatorCompiler)
 def wrapper({unbound_pass_args} userdata):
     userdata = load_struct(userdata)
     return func({extract_env} {unbound_pass_args})
 """
-        exec_in_file(f"{func.__name__}_wrapper_{id(func)}", src, exec_glbls)
+        exec_in_cache_file(f"{func.__name__}_wrapper_{cache_key}", src, exec_glbls)
         return exec_glbls["wrapper"]
 
     @staticmethod
@@ -252,11 +259,18 @@ class UninstantiatedClosure:
     def __init__(self, builder, args):
         self._builder = builder
         self._args = args
+        self._instantiations = {}
         self.__name__ = self._builder.__name__
         self.__qualname__ = self._builder.__qualname__
 
     def instantiate(self, *unbound_argument_types):
-        return self._builder.bind(self._args, unbound_argument_types)
+        # Memoize per unbound type tuple so that repeated loop launches with the same operator
+        # reuse the already-bound Closure instead of rebuilding the environment every call.
+        closure = self._instantiations.get(unbound_argument_types)
+        if closure is None:
+            closure = self._builder.bind(self._args, unbound_argument_types)
+            self._instantiations[unbound_argument_types] = closure
+        return closure
 
     def __str__(self):
         return "<UninstantiatedClosure {}>".format(self._builder._underlying_function)
@@ -0,0 +1,115 @@
+"""
+Persistent on-disk cache for compiled loop operators.
+
+Numba can cache compiled machine code next to the source file of the
+function it compiled. The operator wrappers built by `closure` are exec'd
+from generated source, so to make that cache survive interpreter restarts
+we materialize each wrapper's source in a stable cache directory under a
+name derived from the operator's code and the types it was specialized
+for, and only rewrite a source file when its content actually changes:
+numba invalidates cache entries by source timestamp, so an unconditional
+rewrite would throw the compiled code away every run.
+
+The cache directory defaults to ``~/.cache/katana/operators`` and can be
+moved with ``KATANA_OPERATOR_CACHE_DIR``. Setting
+``KATANA_DISABLE_OPERATOR_CACHE`` (to any non-empty value) disables
+persistence and falls back to per-process compilation.
+"""
+
+import hashlib
+import inspect
+import logging
+import os
+import shutil
+from pathlib import Path
+from typing import Optional
+
+from katana.native_interfacing import exec_in_file
+
+_logger = logging.getLogger(__name__)
+
+
+def cache_directory() -> Optional[Path]:
+    """
+    The directory holding generated operator sources and numba's compiled
+    code for them, or None if the cache is disabled or unusable.
+    """
+    if os.environ.get("KATANA_DISABLE_OPERATOR_CACHE"):
+        return None
+    configured = os.environ.get("KATANA_OPERATOR_CACHE_DIR")
+    path = Path(configured) if configured else Path.home() / ".cache" / "katana" / "operators"
+    try:
+        path.mkdir(parents=True, exist_ok=True)
+    except OSError as e:
+        _logger.warning("operator cache directory %s is unusable (%s); compiling per process", path, e)
+        return None
+    return path
+
+
+def clear_cache():
+    """Remove every cached operator source and its compiled code."""
+    path = cache_directory()
+    if path is not None:
+        shutil.rmtree(path, ignore_errors=True)
+
+
+def specialization_key(func, return_type, bound_argument_types, unbound_argument_types) -> str:
+    """
+    A stable key for one operator specialization: the operator's source
+    code and the exact types it is bound to. Two interpreter runs of the
+    same notebook cell produce the same key and therefore share compiled
+    code.
+    """
+    try:
+        code = inspect.getsource(func)
+    except (OSError, TypeError):
+        # No retrievable source (e.g. built in a REPL without a file);
+        # fall back to the name, which keeps caching correct per process
+        # but may collide across edits, so mix in the code hash if any.
+        code = getattr(func, "__qualname__", repr(func))
+        func_code = getattr(func, "__code__", None)
+        if func_code is not None:
+            code += repr((func_code.co_code, func_code.co_consts, func_code.co_names))
+    hasher = hashlib.sha256()
+    hasher.update(code.encode("utf-8"))
+    hasher.update(
+        repr(
+            (
+                str(return_type),
+                tuple(str(t) for t in bound_argument_types),
+                tuple(str(t) for t in unbound_argument_types),
+            )
+        ).encode("utf-8")
+    )
+    return hasher.hexdigest()[:16]
+
+
+def exec_in_cache_file(filename: str, source: str, globals_dict: Optional[dict] = None):
+    """
+    Execute ``source`` like `exec`, associated with a file of that name in
+    the operator cache directory so numba's on-disk cache can key off it.
+    The file is left untouched when it already holds exactly this source,
+    preserving the timestamp numba validates cache entries against. With
+    the cache disabled this degrades to `exec_in_file`.
+    """
+    source = source.strip()
+    directory = cache_directory()
+    if directory is None:
+        exec_in_file(filename, source, globals_dict)
+        return
+    if not filename.endswith(".py"):
+        filename += ".py"
+    path = directory / filename
+    try:
+        if not path.exists() or path.read_text(encoding="UTF-8").strip() != source:
+            path.write_text(source + "\n", encoding="UTF-8")
+    except OSError as e:
+        _logger.warning("cannot write operator source %s (%s); compiling per process", path, e)
+        exec_in_file(filename, source, globals_dict)
+        return
+    code = compile(source, str(path), "exec")
+    exec(code, globals_dict)  # pylint: disable=exec-used
+
+
+def caching_enabled() -> bool:
+    return cache_directory() is not None
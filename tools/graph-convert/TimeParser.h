@@ -30,9 +30,20 @@ public:
   /// Parse parses a string and returns a Unix timestamp in units of Duration.
   /// If the string could not be parsed, the null option is returned.
   std::optional<CType> Parse(const std::string& str);
+  /// ParseCommon parses the fixed-layout forms the importer sees almost
+  /// exclusively ("YYYY-MM-DD", optionally followed by "[ T]hh:mm[:ss[.frac]]"
+  /// and "Z") by scanning digits directly, with no streams or format loops.
+  /// Returns the null option for anything else so callers can fall back to
+  /// the general Parse path.
+  std::optional<CType> ParseCommon(const char* str, size_t len);
   /// calls Parse on each string in the StringArray, appending into the builder
   void ParseInto(
       const arrow::StringArray& strings, arrow::ArrayBuilder* builder);
+  /// like ParseInto over all strings, but restricted to the slice
+  /// [offset, offset + length); used to parse one column in parallel slices
+  void ParseInto(
+      const arrow::StringArray& strings, int64_t offset, int64_t length,
+      arrow::ArrayBuilder* builder);
 };
 
 }  // namespace katana
@@ -43,6 +54,9 @@ katana::TimeParser<ArrowDateTimeType, Duration>::Parse(const std::string& str) {
   if (str.empty()) {
     return std::nullopt;
   }
+  if (auto fast = ParseCommon(str.data(), str.size()); fast) {
+    return fast;
+  }
   // Possible time formats
   //
   // ISO 8601:
@@ -113,17 +127,123 @@ katana::TimeParser<ArrowDateTimeType, Duration>::Parse(const std::string& str) {
   return std::nullopt;
 }
 
+template <class ArrowDateTimeType, typename Duration>
+std::optional<typename katana::TimeParser<ArrowDateTimeType, Duration>::CType>
+katana::TimeParser<ArrowDateTimeType, Duration>::ParseCommon(
+    const char* str, size_t len) {
+  auto digits = [](const char* p, size_t count, int64_t* out) -> bool {
+    int64_t v = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (p[i] < '0' || p[i] > '9') {
+        return false;
+      }
+      v = v * 10 + (p[i] - '0');
+    }
+    *out = v;
+    return true;
+  };
+
+  if (len < 10) {
+    return std::nullopt;
+  }
+  int64_t year = 0;
+  int64_t month = 0;
+  int64_t day = 0;
+  if (!digits(str, 4, &year) || str[4] != '-' || !digits(str + 5, 2, &month) ||
+      str[7] != '-' || !digits(str + 8, 2, &day)) {
+    return std::nullopt;
+  }
+  date::year_month_day ymd{
+      date::year{static_cast<int>(year)},
+      date::month{static_cast<unsigned>(month)},
+      date::day{static_cast<unsigned>(day)}};
+  if (!ymd.ok()) {
+    return std::nullopt;
+  }
+
+  size_t pos = 10;
+  int64_t hour = 0;
+  int64_t minute = 0;
+  int64_t second = 0;
+  std::chrono::nanoseconds frac{0};
+  if (pos < len) {
+    if (str[pos] != ' ' && str[pos] != 'T') {
+      return std::nullopt;
+    }
+    ++pos;
+    if (pos + 5 > len || !digits(str + pos, 2, &hour) ||
+        str[pos + 2] != ':' || !digits(str + pos + 3, 2, &minute)) {
+      return std::nullopt;
+    }
+    pos += 5;
+    if (pos < len && str[pos] == ':') {
+      if (pos + 3 > len || !digits(str + pos + 1, 2, &second)) {
+        return std::nullopt;
+      }
+      pos += 3;
+      if (pos < len && str[pos] == '.') {
+        ++pos;
+        int64_t frac_value = 0;
+        int frac_digits = 0;
+        while (pos < len && str[pos] >= '0' && str[pos] <= '9' &&
+               frac_digits < 9) {
+          frac_value = frac_value * 10 + (str[pos] - '0');
+          ++frac_digits;
+          ++pos;
+        }
+        if (frac_digits == 0) {
+          return std::nullopt;
+        }
+        // drop sub-nanosecond digits
+        while (pos < len && str[pos] >= '0' && str[pos] <= '9') {
+          ++pos;
+        }
+        for (; frac_digits < 9; ++frac_digits) {
+          frac_value *= 10;
+        }
+        frac = std::chrono::nanoseconds{frac_value};
+      }
+    }
+    if (pos < len && str[pos] == 'Z') {
+      ++pos;
+    }
+    if (pos != len) {
+      return std::nullopt;
+    }
+    if (hour > 23 || minute > 59 || second > 60) {
+      return std::nullopt;
+    }
+  }
+
+  date::sys_time<std::chrono::nanoseconds> tp =
+      date::sys_days{ymd} + std::chrono::hours{hour} +
+      std::chrono::minutes{minute} + std::chrono::seconds{second} + frac;
+  return std::chrono::duration_cast<Duration>(tp.time_since_epoch()).count();
+}
+
 template <class ArrowDateTimeType, typename Duration>
 void
 katana::TimeParser<ArrowDateTimeType, Duration>::ParseInto(
     const arrow::StringArray& strings, arrow::ArrayBuilder* untyped_builder) {
+  ParseInto(strings, 0, strings.length(), untyped_builder);
+}
+
+template <class ArrowDateTimeType, typename Duration>
+void
+katana::TimeParser<ArrowDateTimeType, Duration>::ParseInto(
+    const arrow::StringArray& strings, int64_t offset, int64_t length,
+    arrow::ArrayBuilder* untyped_builder) {
   BuilderType& builder = dynamic_cast<BuilderType&>(*untyped_builder);
-  if (auto st = builder.Reserve(strings.length()); !st.ok()) {
+  if (auto st = builder.Reserve(length); !st.ok()) {
     KATANA_LOG_FATAL("builder failed to reserve space");
   }
-  for (size_t i = 0, n = strings.length(); i < n; ++i) {
-    std::string str = strings.GetString(i);
-    auto r = Parse(str);
+  for (int64_t i = offset, n = offset + length; i < n; ++i) {
+    auto view = strings.GetView(i);
+    if (auto fast = ParseCommon(view.data(), view.size()); fast) {
+      builder.UnsafeAppend(*fast);
+      continue;
+    }
+    auto r = Parse(std::string{view});
     if (r) {
       builder.UnsafeAppend(*r);
     } else {
@@ -1,11 +1,40 @@
 #include "Transforms.h"
 
+#include <algorithm>
+
 #include <arrow/type.h>
 
 #include "TimeParser.h"
+#include "katana/Loops.h"
 
 namespace {
 
+// Transforms run as parallel kernels over slices of the source chunks; the
+// per-slice output arrays are stitched back together in order as the chunks
+// of the rewritten column
+constexpr int64_t kTransformSliceSize = 64 * 1024;
+
+struct ChunkSlice {
+  std::shared_ptr<arrow::Array> chunk;
+  int64_t offset;
+  int64_t length;
+};
+
+std::vector<ChunkSlice>
+MakeSlices(arrow::ChunkedArray* chunked_array) {
+  std::vector<ChunkSlice> slices;
+  for (int cidx = 0, num_chunks = chunked_array->num_chunks();
+       cidx < num_chunks; ++cidx) {
+    std::shared_ptr<arrow::Array> chunk = chunked_array->chunk(cidx);
+    for (int64_t offset = 0, n = chunk->length(); offset < n;
+         offset += kTransformSliceSize) {
+      slices.emplace_back(ChunkSlice{
+          chunk, offset, std::min(kTransformSliceSize, n - offset)});
+    }
+  }
+  return slices;
+}
+
 void
 ApplyTransform(
     katana::PropertyGraph::MutablePropertyView view,
@@ -56,58 +85,55 @@ ApplyTransform(
 std::pair<std::shared_ptr<arrow::Field>, std::shared_ptr<arrow::ChunkedArray>>
 katana::ConvertDateTime::operator()(
     arrow::Field* field, arrow::ChunkedArray* chunked_array) {
-  std::vector<int64_t> values;
-  std::vector<bool> is_valid;
-
-  values.reserve(chunked_array->length());
-  is_valid.reserve(chunked_array->length());
-
-  std::unique_ptr<arrow::ArrayBuilder> builder;
-  if (auto st =
-          arrow::MakeBuilder(arrow::default_memory_pool(), dtype_, &builder);
-      !st.ok()) {
-    KATANA_LOG_FATAL("failed to create builder");
-  }
-
-  for (int cidx = 0, num_chunks = chunked_array->num_chunks();
-       cidx < num_chunks; ++cidx) {
-    std::shared_ptr<arrow::Array> chunk = chunked_array->chunk(cidx);
-    auto array = std::dynamic_pointer_cast<arrow::StringArray>(chunk);
-
-    if (!array) {
-      KATANA_LOG_FATAL("column not string");
-    }
-
-    switch (dtype_->id()) {
-    case arrow::Type::TIMESTAMP: {
-      TimeParser<arrow::TimestampType, std::chrono::nanoseconds> parser;
-      parser.ParseInto(*array, builder.get());
-      break;
-    }
-    case arrow::Type::DATE32: {
-      TimeParser<arrow::Date32Type, date::days> parser;
-      parser.ParseInto(*array, builder.get());
-      break;
-    }
-    case arrow::Type::DATE64: {
-      TimeParser<arrow::Date64Type, std::chrono::milliseconds> parser;
-      parser.ParseInto(*array, builder.get());
-      break;
-    }
-    default:
-      KATANA_LOG_FATAL("unsupported type: ({})", dtype_->ToString());
-    }
-  }
+  std::vector<ChunkSlice> slices = MakeSlices(chunked_array);
+  std::vector<std::shared_ptr<arrow::Array>> new_arrays(slices.size());
+
+  katana::do_all(
+      katana::iterate(size_t{0}, slices.size()),
+      [&](size_t sidx) {
+        const ChunkSlice& slice = slices[sidx];
+        auto array = std::dynamic_pointer_cast<arrow::StringArray>(slice.chunk);
+
+        if (!array) {
+          KATANA_LOG_FATAL("column not string");
+        }
+
+        std::unique_ptr<arrow::ArrayBuilder> builder;
+        if (auto st = arrow::MakeBuilder(
+                arrow::default_memory_pool(), dtype_, &builder);
+            !st.ok()) {
+          KATANA_LOG_FATAL("failed to create builder");
+        }
+
+        switch (dtype_->id()) {
+        case arrow::Type::TIMESTAMP: {
+          TimeParser<arrow::TimestampType, std::chrono::nanoseconds> parser;
+          parser.ParseInto(*array, slice.offset, slice.length, builder.get());
+          break;
+        }
+        case arrow::Type::DATE32: {
+          TimeParser<arrow::Date32Type, date::days> parser;
+          parser.ParseInto(*array, slice.offset, slice.length, builder.get());
+          break;
+        }
+        case arrow::Type::DATE64: {
+          TimeParser<arrow::Date64Type, std::chrono::milliseconds> parser;
+          parser.ParseInto(*array, slice.offset, slice.length, builder.get());
+          break;
+        }
+        default:
+          KATANA_LOG_FATAL("unsupported type: ({})", dtype_->ToString());
+        }
+
+        if (auto st = builder->Finish(&new_arrays[sidx]); !st.ok()) {
+          KATANA_LOG_FATAL("could not finish array: {}", st);
+        }
+      },
+      katana::steal());
 
   auto new_field = field->WithType(dtype_)->WithNullable(true);
-
-  std::shared_ptr<arrow::Array> new_array;
-  if (auto st = builder->Finish(&new_array); !st.ok()) {
-    KATANA_LOG_FATAL("could not finish array: {}", st);
-  }
-
-  auto new_column = std::make_shared<arrow::ChunkedArray>(
-      std::vector<std::shared_ptr<arrow::Array>>{std::move(new_array)});
+  auto new_column =
+      std::make_shared<arrow::ChunkedArray>(std::move(new_arrays), dtype_);
 
   return std::make_pair(new_field, new_column);
 }
@@ -115,25 +141,35 @@ katana::ConvertDateTime::operator()(
 std::pair<std::shared_ptr<arrow::Field>, std::shared_ptr<arrow::ChunkedArray>>
 katana::SparsifyBooleans::operator()(
     arrow::Field* field, arrow::ChunkedArray* chunked_array) {
-  std::vector<uint8_t> values;
-
-  values.reserve(chunked_array->length());
-
-  for (int cidx = 0, num_chunks = chunked_array->num_chunks();
-       cidx < num_chunks; ++cidx) {
-    std::shared_ptr<arrow::Array> chunk = chunked_array->chunk(cidx);
-    auto array = std::dynamic_pointer_cast<arrow::BooleanArray>(chunk);
-
-    if (!array) {
-      KATANA_LOG_FATAL("column not boolean");
-    }
-
-    for (int64_t i = 0, n = array->length(); i < n; ++i) {
-      uint8_t value = array->IsValid(i) && array->Value(i) ? 1 : 0;
-      values.emplace_back(value);
-    }
+  std::vector<uint8_t> values(chunked_array->length());
+
+  std::vector<ChunkSlice> slices = MakeSlices(chunked_array);
+  std::vector<int64_t> slice_bases(slices.size());
+  int64_t base = 0;
+  for (size_t sidx = 0; sidx < slices.size(); ++sidx) {
+    slice_bases[sidx] = base;
+    base += slices[sidx].length;
   }
 
+  katana::do_all(
+      katana::iterate(size_t{0}, slices.size()),
+      [&](size_t sidx) {
+        const ChunkSlice& slice = slices[sidx];
+        auto array =
+            std::dynamic_pointer_cast<arrow::BooleanArray>(slice.chunk);
+
+        if (!array) {
+          KATANA_LOG_FATAL("column not boolean");
+        }
+
+        int64_t out = slice_bases[sidx];
+        for (int64_t i = slice.offset, n = slice.offset + slice.length; i < n;
+             ++i) {
+          values[out++] = array->IsValid(i) && array->Value(i) ? 1 : 0;
+        }
+      },
+      katana::steal());
+
   arrow::UInt8Builder builder;
   if (auto result = builder.AppendValues(values); !result.ok()) {
     KATANA_LOG_FATAL("could not append array: {}", result);
@@ -22,14 +22,18 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <deque>
 #include <fstream>
+#include <future>
 #include <ios>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <random>
 #include <regex>
+#include <string>
 #include <vector>
 
 #include <boost/iostreams/filter/gzip.hpp>
@@ -54,6 +58,19 @@ static cll::opt<bool> edgesSorted(
     cll::init(false));
 static cll::opt<unsigned long long> numNodes(
     "numNodes", cll::desc("Total number of nodes given."), cll::init(0));
+static cll::opt<bool> externalSort(
+    "externalSort",
+    cll::desc("Convert with a bounded memory budget by bucketing edges into "
+              "temporary files and assembling the CSR one bucket at a time."),
+    cll::init(false));
+static cll::opt<unsigned long long> memoryBudgetGB(
+    "memoryBudgetGB", cll::desc("Memory budget for -externalSort in GB."),
+    cll::init(8));
+static cll::opt<std::string> scratchDir(
+    "scratchDir",
+    cll::desc("Directory for -externalSort scratch files; defaults to the "
+              "output file's directory."),
+    cll::init(""));
 
 union dataTy {
   int64_t ival;
@@ -164,6 +181,262 @@ perEdge(
             << " MB/s\n";
 }
 
+struct EdgeRecord {
+  uint64_t src;
+  uint64_t dst;
+};
+
+/**
+ * Appends records to a scratch file, writing full buffers on a background
+ * thread so that parsing overlaps with I/O.
+ */
+class DoubleBufferedWriter {
+  std::ofstream out_;
+  std::vector<EdgeRecord> front_;
+  std::vector<EdgeRecord> back_;
+  std::future<void> pending_;
+  size_t capacity_;
+
+public:
+  DoubleBufferedWriter(const std::string& filename, size_t capacity)
+      : out_(filename, std::ios_base::binary | std::ios_base::trunc),
+        capacity_(std::max<size_t>(capacity, 1)) {
+    if (!out_.is_open() || !out_.good())
+      throw "Bad scratch filename";
+    front_.reserve(capacity_);
+    back_.reserve(capacity_);
+  }
+
+  void push(const EdgeRecord& record) {
+    front_.push_back(record);
+    if (front_.size() == capacity_)
+      flush();
+  }
+
+  void flush() {
+    if (pending_.valid())
+      pending_.get();
+    std::swap(front_, back_);
+    front_.clear();
+    pending_ = std::async(std::launch::async, [this]() {
+      out_.write(
+          reinterpret_cast<const char*>(back_.data()),
+          back_.size() * sizeof(EdgeRecord));
+    });
+  }
+
+  void finish() {
+    flush();
+    if (pending_.valid())
+      pending_.get();
+    out_.close();
+    if (!out_)
+      throw "Failed writing scratch file";
+  }
+};
+
+/**
+ * External-memory conversion: edges are bucketed by source-id range into
+ * temporary files sized to the memory budget, then each bucket is loaded,
+ * counted, and scattered into its contiguous slice of the output CSR. The
+ * next bucket is read on a background thread while the current one is
+ * processed. Nothing allocated here is proportional to the full node or edge
+ * count, so dataset size is bounded by disk, not RAM.
+ *
+ * Like OfflineGraphWriter::setCounts, the output header advertises no edge
+ * data; only the topology is written.
+ */
+void
+goExternal(std::istream& input) {
+  constexpr uint64_t kGB = uint64_t{1024} * 1024 * 1024;
+
+  try {
+    // Pass 1: count edges and find the node range; unlike go(), do not
+    // build a node-proportional edge count here.
+    uint64_t totalEdges = 0;
+    uint64_t maxNode = 0;
+    uint64_t hintedNodes = 0;
+    perEdge(
+        input,
+        [&](uint64_t src, uint64_t dst, dataTy) {
+          ++totalEdges;
+          maxNode = std::max(maxNode, std::max(src, dst));
+        },
+        [&](uint64_t nodes, uint64_t) { hintedNodes = nodes; });
+
+    uint64_t nNodes = std::max<uint64_t>(
+        {hintedNodes, numNodes.getValue(),
+         totalEdges != 0 ? maxNode + 1 : 0});
+
+    // Budget splits: half for a loaded bucket and its staging arrays, a
+    // quarter for the per-bucket offset slice, a quarter for write buffers.
+    uint64_t budget = std::max<uint64_t>(memoryBudgetGB, 1) * kGB;
+    uint64_t halfBudget = budget / 2;
+    uint64_t quarterBudget = budget / 4;
+    uint64_t edgeBytes =
+        totalEdges * (sizeof(EdgeRecord) + sizeof(uint64_t));
+    uint64_t nodeBytes = nNodes * sizeof(uint64_t);
+    uint64_t numBuckets = std::max(
+        (edgeBytes + halfBudget - 1) / halfBudget,
+        (nodeBytes + quarterBudget - 1) / quarterBudget);
+    numBuckets = std::min(
+        std::max<uint64_t>(numBuckets, 1), uint64_t{64 * 1024});
+    uint64_t nodesPerBucket =
+        std::max<uint64_t>((nNodes + numBuckets - 1) / numBuckets, 1);
+
+    std::string scratchBase = scratchDir.getValue().empty()
+                                  ? outputFilename.getValue()
+                                  : scratchDir.getValue() + "/" +
+                                        "katana-external-sort";
+    auto bucketName = [&](uint64_t bucket) {
+      return scratchBase + ".bucket-" + std::to_string(bucket);
+    };
+
+    std::cout << "External sort: " << numBuckets << " bucket(s) of "
+              << nodesPerBucket << " node(s) each\n";
+
+    // Pass 2: distribute edges into per-bucket scratch files.
+    input.clear();
+    input.seekg(0, std::ios_base::beg);
+
+    uint64_t recordsPerBuffer = std::max<uint64_t>(
+        std::min<uint64_t>(
+            quarterBudget / (numBuckets * 2 * sizeof(EdgeRecord)),
+            uint64_t{1} << 20),
+        1024);
+    std::vector<std::unique_ptr<DoubleBufferedWriter>> buckets;
+    for (uint64_t b = 0; b < numBuckets; ++b) {
+      buckets.emplace_back(std::make_unique<DoubleBufferedWriter>(
+          bucketName(b), recordsPerBuffer));
+    }
+    perEdge(
+        input,
+        [&](uint64_t src, uint64_t dst, dataTy) {
+          buckets[src / nodesPerBucket]->push(EdgeRecord{src, dst});
+        },
+        [](uint64_t, uint64_t) {});
+    for (auto& bucket : buckets) {
+      bucket->finish();
+    }
+    buckets.clear();
+
+    // Pass 3: assemble the CSR bucket by bucket.
+    std::fstream out(
+        outputFilename,
+        std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!out.is_open() || !out.good())
+      throw "Bad output filename";
+
+    uint64_t ver = nNodes >= (uint64_t{1} << 32) ? 2 : 1;
+    uint64_t etSize = 0;
+    out.write(reinterpret_cast<char*>(&ver), sizeof(uint64_t));
+    out.write(reinterpret_cast<char*>(&etSize), sizeof(uint64_t));
+    out.write(reinterpret_cast<char*>(&nNodes), sizeof(uint64_t));
+    out.write(reinterpret_cast<char*>(&totalEdges), sizeof(uint64_t));
+
+    const std::streamoff idxStart = 4 * sizeof(uint64_t);
+    const std::streamoff dstStart = idxStart + nNodes * sizeof(uint64_t);
+
+    auto loadBucket = [](const std::string& name) {
+      std::ifstream in(name, std::ios_base::binary | std::ios_base::ate);
+      if (!in.is_open())
+        throw "Bad scratch filename";
+      std::streamoff size = in.tellg();
+      std::vector<EdgeRecord> records(size / sizeof(EdgeRecord));
+      in.seekg(0, std::ios_base::beg);
+      in.read(reinterpret_cast<char*>(records.data()), size);
+      in.close();
+      std::remove(name.c_str());
+      return records;
+    };
+
+    std::future<std::vector<EdgeRecord>> next =
+        std::async(std::launch::async, loadBucket, bucketName(0));
+
+    uint64_t edgeBase = 0;
+    for (uint64_t b = 0; b < numBuckets; ++b) {
+      std::vector<EdgeRecord> records = next.get();
+      if (b + 1 < numBuckets)
+        next = std::async(std::launch::async, loadBucket, bucketName(b + 1));
+
+      if (records.size() * sizeof(EdgeRecord) > halfBudget) {
+        std::cerr << "Warning: bucket " << b
+                  << " exceeds the memory budget due to source-id skew\n";
+      }
+
+      uint64_t firstNode = b * nodesPerBucket;
+      uint64_t lastNode = std::min(firstNode + nodesPerBucket, nNodes);
+      if (firstNode >= lastNode)
+        continue;
+
+      std::vector<uint64_t> counts(lastNode - firstNode, 0);
+      for (const EdgeRecord& record : records)
+        ++counts[record.src - firstNode];
+
+      // cursors hold bucket-relative scatter positions; counts becomes this
+      // bucket's slice of the global inclusive prefix sum
+      std::vector<uint64_t> cursors(counts.size());
+      uint64_t local = 0;
+      for (size_t i = 0; i < counts.size(); ++i) {
+        cursors[i] = local;
+        local += counts[i];
+        counts[i] = edgeBase + local;
+      }
+
+      out.seekp(idxStart + firstNode * sizeof(uint64_t), std::ios_base::beg);
+      out.write(
+          reinterpret_cast<char*>(counts.data()),
+          counts.size() * sizeof(uint64_t));
+
+      if (ver == 1) {
+        std::vector<uint32_t> dsts(records.size());
+        for (const EdgeRecord& record : records)
+          dsts[cursors[record.src - firstNode]++] =
+              static_cast<uint32_t>(record.dst);
+        out.seekp(dstStart + edgeBase * sizeof(uint32_t), std::ios_base::beg);
+        out.write(
+            reinterpret_cast<char*>(dsts.data()),
+            dsts.size() * sizeof(uint32_t));
+      } else {
+        std::vector<uint64_t> dsts(records.size());
+        for (const EdgeRecord& record : records)
+          dsts[cursors[record.src - firstNode]++] = record.dst;
+        out.seekp(dstStart + edgeBase * sizeof(uint64_t), std::ios_base::beg);
+        out.write(
+            reinterpret_cast<char*>(dsts.data()),
+            dsts.size() * sizeof(uint64_t));
+      }
+
+      edgeBase += records.size();
+    }
+
+    if (edgeBase != totalEdges) {
+      std::cerr << "Error: scattered " << edgeBase << " of " << totalEdges
+                << " edges\n";
+      abort();
+    }
+
+    // pad version 1 destinations to an 8 byte boundary like
+    // FileGraph::fromArrays
+    if (ver == 1 && totalEdges % 2 != 0) {
+      uint32_t pad = 0;
+      out.seekp(
+          dstStart + totalEdges * sizeof(uint32_t), std::ios_base::beg);
+      out.write(reinterpret_cast<char*>(&pad), sizeof(uint32_t));
+    }
+
+    out.close();
+    if (!out)
+      throw "Failed writing output";
+
+    std::cout << "Wrote " << nNodes << " nodes and " << totalEdges
+              << " edges\n";
+  } catch (const char* c) {
+    std::cerr << "Failed with: " << c << "\n";
+    abort();
+  }
+}
+
 void
 go(std::istream& input) {
   try {
@@ -247,7 +520,9 @@ main(int argc, char** argv) {
     return 1;
   }
 
-  if (numNodes > 0 && edgesSorted) {
+  if (externalSort) {
+    goExternal(infile);
+  } else if (numNodes > 0 && edgesSorted) {
     go_edgesSorted(infile, numNodes);
   } else {
     go(infile);
@@ -18,16 +18,22 @@
  */
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cerrno>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/mpl/if.hpp>
@@ -89,7 +95,8 @@ enum ConvertMode {
   nodelist2gr,
   pbbs2gr,
   svmlight2gr,
-  edgelist2binary
+  edgelist2binary,
+  binaryedgelist2gr
 };
 
 enum EdgeType { float32_, float64_, int32_, int64_, uint32_, uint64_, void_ };
@@ -209,7 +216,11 @@ static cll::opt<ConvertMode> convertMode(
         clEnumVal(
             edgelist2binary,
             "Convert edge list to binary edgelist "
-            "format (assumes vertices of type uin32_t)")),
+            "format (assumes vertices of type uin32_t)"),
+        clEnumVal(
+            binaryedgelist2gr,
+            "Convert binary edgelist (fixed-width uint32 "
+            "src,dst[,weight] records) to binary gr")),
     cll::Required);
 static cll::opt<uint32_t> sourceNode(
     "sourceNode", cll::desc("Source node ID for BFS traversal"), cll::init(0));
@@ -378,6 +389,155 @@ skipLine(std::ifstream& infile) {
   infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
+/**
+ * Read-only memory-mapped view of an input file for parallel parsing.
+ */
+class MappedInputFile {
+public:
+  explicit MappedInputFile(const std::string& filename) {
+    fd_ = open(filename.c_str(), O_RDONLY);
+    if (fd_ == -1) {
+      KATANA_LOG_FATAL("failed to open {}: {}", filename, std::strerror(errno));
+    }
+    struct stat stat_buf;
+    if (fstat(fd_, &stat_buf) == -1) {
+      KATANA_LOG_FATAL("failed to stat {}: {}", filename, std::strerror(errno));
+    }
+    size_ = stat_buf.st_size;
+    if (size_ == 0) {
+      return;
+    }
+    void* ret = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (ret == MAP_FAILED) {
+      KATANA_LOG_FATAL("failed to mmap {}: {}", filename, std::strerror(errno));
+    }
+    base_ = static_cast<const char*>(ret);
+  }
+
+  ~MappedInputFile() {
+    if (base_) {
+      munmap(const_cast<char*>(base_), size_);
+    }
+    if (fd_ != -1) {
+      close(fd_);
+    }
+  }
+
+  MappedInputFile(const MappedInputFile&) = delete;
+  MappedInputFile& operator=(const MappedInputFile&) = delete;
+
+  const char* data() const { return base_; }
+  size_t size() const { return size_; }
+
+private:
+  int fd_{-1};
+  const char* base_{};
+  size_t size_{};
+};
+
+/**
+ * Splits [begin, size) into chunks that end just past a newline so that each
+ * chunk holds whole lines. Chunks are at least a megabyte so that small
+ * inputs are parsed as a single chunk, which keeps the edge order of a
+ * serial parse.
+ */
+std::vector<std::pair<size_t, size_t>>
+computeLineChunks(
+    const char* data, size_t size, size_t begin, size_t maxChunks) {
+  constexpr size_t kMinChunkSize = 1024 * 1024;
+
+  size_t span = size - begin;
+  size_t numChunks =
+      std::max(std::min(maxChunks, span / kMinChunkSize), size_t{1});
+
+  std::vector<std::pair<size_t, size_t>> chunks;
+  size_t prev = begin;
+  for (size_t i = 1; i <= numChunks; ++i) {
+    size_t target = begin + (span / numChunks) * i;
+    if (i == numChunks) {
+      target = size;
+    } else {
+      target = std::max(target, prev);
+      const void* newline = memchr(data + target, '\n', size - target);
+      target = newline
+                   ? static_cast<size_t>(
+                         static_cast<const char*>(newline) - data) +
+                         1
+                   : size;
+    }
+    if (target > prev) {
+      chunks.emplace_back(prev, target);
+    }
+    prev = target;
+  }
+  return chunks;
+}
+
+bool
+isLineSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+void
+skipLineSpace(const char*& cursor, const char* end) {
+  while (cursor != end && isLineSpace(*cursor)) {
+    ++cursor;
+  }
+}
+
+bool
+parseNodeId(const char*& cursor, const char* end, size_t* out) {
+  skipLineSpace(cursor, end);
+  if (cursor == end || *cursor < '0' || *cursor > '9') {
+    return false;
+  }
+  size_t value = 0;
+  do {
+    value = value * 10 + static_cast<size_t>(*cursor - '0');
+    ++cursor;
+  } while (cursor != end && *cursor >= '0' && *cursor <= '9');
+  *out = value;
+  return true;
+}
+
+bool
+parseDelim(const char*& cursor, const char* end, char delim) {
+  skipLineSpace(cursor, end);
+  if (cursor == end || *cursor != delim) {
+    return false;
+  }
+  ++cursor;
+  return true;
+}
+
+template <typename T>
+bool
+parseEdgeValue(const char*& cursor, const char* end, T* out) {
+  skipLineSpace(cursor, end);
+
+  // copy the token out so strto* cannot read past the mapping
+  char buf[64];
+  size_t len = 0;
+  while (cursor != end && len < sizeof(buf) - 1 && !isLineSpace(*cursor)) {
+    buf[len++] = *cursor;
+    ++cursor;
+  }
+  buf[len] = '\0';
+  if (len == 0) {
+    return false;
+  }
+
+  char* parse_end = nullptr;
+  if constexpr (std::is_floating_point_v<T>) {
+    *out = static_cast<T>(std::strtod(buf, &parse_end));
+  } else if constexpr (std::is_signed_v<T>) {
+    *out = static_cast<T>(std::strtoll(buf, &parse_end, 10));
+  } else {
+    *out = static_cast<T>(std::strtoull(buf, &parse_end, 10));
+  }
+  return parse_end != buf;
+}
+
 /**
  * Common parsing for edgelist style text files.
  *
@@ -386,6 +546,11 @@ skipLine(std::ifstream& infile) {
  *
  * If delim is set, this function expects that each entry is separated by delim
  * surrounded by optional whitespace.
+ *
+ * The input is memory mapped, split into per-thread chunks at line
+ * boundaries, and converted with the usual parallel count/prefix-sum/fill
+ * CSR assembly. Edges of a node that straddle chunk boundaries may land in
+ * any order within that node's neighborhood.
  */
 template <typename EdgeTy>
 void
@@ -398,171 +563,130 @@ convertEdgelist(
 
   Writer p;
   EdgeData edgeData;
-  std::ifstream infile(infilename.c_str());
-
-  size_t numNodes = 0;
-  size_t numEdges = 0;
-  size_t lineNumber = 0;
+  MappedInputFile infile(infilename);
+  const char* data = infile.data();
 
+  size_t begin = 0;
   if (skipFirstLine) {
     katana::gWarn(
         "first line is assumed to contain labels and will be ignored\n");
-    skipLine(infile);
-    ++lineNumber;
+    const void* newline = memchr(data, '\n', infile.size());
+    begin = newline
+                ? static_cast<size_t>(static_cast<const char*>(newline) - data)
+                      + 1
+                : infile.size();
   }
 
   const bool hasDelim = static_cast<bool>(delim);
-  std::optional<size_t> skippedLine;
-  std::string line;
-  char readDelim;
-
-  for (; std::getline(infile, line); ++lineNumber) {
-    std::stringstream iss(line);
 
-    size_t src;
-    if (!(iss >> src)) {
-      skippedLine = lineNumber;
-      continue;
+  // parses one line; returns false for lines that do not match the expected
+  // format, which are skipped like in the serial converter
+  auto parseLine = [&](const char* cursor, const char* lineEnd, size_t* src,
+                       size_t* dst, edge_value_type* value) -> bool {
+    if (!parseNodeId(cursor, lineEnd, src)) {
+      return false;
     }
-
-    if (hasDelim) {
-      if (!(iss >> readDelim) || readDelim != delim) {
-        skippedLine = lineNumber;
-        continue;
-      }
+    if (hasDelim && !parseDelim(cursor, lineEnd, *delim)) {
+      return false;
     }
-
-    size_t dst;
-    if (!(iss >> dst)) {
-      skippedLine = lineNumber;
-      continue;
+    if (!parseNodeId(cursor, lineEnd, dst)) {
+      return false;
+    }
+    if constexpr (EdgeData::has_value) {
+      if (hasDelim && !parseDelim(cursor, lineEnd, *delim)) {
+        return false;
+      }
+      if (!parseEdgeValue(cursor, lineEnd, value)) {
+        return false;
+      }
     }
+    return true;
+  };
 
-    edge_value_type data{};
-    if (EdgeData::has_value) {
-      if (hasDelim) {
-        if (!(iss >> readDelim) || readDelim != delim) {
-          skippedLine = lineNumber;
-          continue;
-        }
+  auto forEachEdge = [&](const std::pair<size_t, size_t>& chunk,
+                         auto&& onEdge, auto&& onSkipped) {
+    const char* cursor = data + chunk.first;
+    const char* chunkEnd = data + chunk.second;
+    while (cursor < chunkEnd) {
+      const char* lineEnd = static_cast<const char*>(
+          memchr(cursor, '\n', chunkEnd - cursor));
+      if (!lineEnd) {
+        lineEnd = chunkEnd;
       }
 
-      if (!(iss >> data)) {
-        skippedLine = lineNumber;
-        continue;
+      size_t src;
+      size_t dst;
+      edge_value_type value{};
+      if (parseLine(cursor, lineEnd, &src, &dst, &value)) {
+        onEdge(src, dst, value);
+      } else {
+        onSkipped();
       }
-    }
 
-    if (infile) {
-      ++numEdges;
-      if (src > numNodes)
-        numNodes = src;
-      if (dst > numNodes)
-        numNodes = dst;
+      cursor = lineEnd + 1;
     }
-  }
+  };
 
-  if (skippedLine) {
+  std::vector<std::pair<size_t, size_t>> chunks = computeLineChunks(
+      data, infile.size(), begin, 4 * katana::getActiveThreads());
+
+  katana::GAccumulator<size_t> edgeCount;
+  katana::GReduceMax<size_t> maxNodeId;
+  katana::GAccumulator<size_t> skippedLines;
+
+  katana::do_all(
+      katana::iterate(chunks),
+      [&](const std::pair<size_t, size_t>& chunk) {
+        forEachEdge(
+            chunk,
+            [&](size_t src, size_t dst, const edge_value_type&) {
+              edgeCount += 1;
+              maxNodeId.update(std::max(src, dst));
+            },
+            [&]() { skippedLines += 1; });
+      },
+      katana::steal());
+
+  if (size_t skipped = skippedLines.reduce()) {
     katana::gWarn(
-        "ignored at least one line (line ", *skippedLine,
-        ") because it did not match the expected format\n");
+        "ignored ", skipped,
+        " line(s) because they did not match the expected format\n");
   }
 
-  numNodes++;
+  size_t numEdges = edgeCount.reduce();
+  size_t numNodes = maxNodeId.reduce() + 1;
   p.setNumNodes(numNodes);
   p.setNumEdges(numEdges);
   p.setSizeofEdgeData(EdgeData::size_of::value);
   edgeData.create(numEdges);
 
-  infile.clear();
-  infile.seekg(0, std::ios::beg);
   p.phase1();
 
-  if (skipFirstLine) {
-    skipLine(infile);
-  }
-
-  while (std::getline(infile, line)) {
-    std::stringstream iss(line);
-
-    size_t src;
-    if (!(iss >> src)) {
-      continue;
-    }
-
-    if (hasDelim) {
-      if (!(iss >> readDelim) || readDelim != delim) {
-        continue;
-      }
-    }
-
-    size_t dst;
-    if (!(iss >> dst)) {
-      continue;
-    }
-
-    edge_value_type data{};
-    if (EdgeData::has_value) {
-      if (hasDelim) {
-        if (!(iss >> readDelim) || readDelim != delim) {
-          continue;
-        }
-      }
-
-      if (!(iss >> data)) {
-        continue;
-      }
-    }
+  katana::do_all(
+      katana::iterate(chunks),
+      [&](const std::pair<size_t, size_t>& chunk) {
+        forEachEdge(
+            chunk,
+            [&](size_t src, size_t, const edge_value_type&) {
+              p.incrementDegreeAtomic(src);
+            },
+            []() {});
+      },
+      katana::steal());
 
-    if (infile) {
-      p.incrementDegree(src);
-    }
-  }
-
-  infile.clear();
-  infile.seekg(0, std::ios::beg);
   p.phase2();
 
-  if (skipFirstLine) {
-    skipLine(infile);
-  }
-
-  while (std::getline(infile, line)) {
-    std::stringstream iss(line);
-
-    size_t src;
-    if (!(iss >> src)) {
-      continue;
-    }
-
-    if (hasDelim) {
-      if (!(iss >> readDelim) || readDelim != delim) {
-        continue;
-      }
-    }
-
-    size_t dst;
-    if (!(iss >> dst)) {
-      continue;
-    }
-
-    edge_value_type data{};
-    if (EdgeData::has_value) {
-      if (hasDelim) {
-        if (!(iss >> readDelim) || readDelim != delim) {
-          continue;
-        }
-      }
-
-      if (!(iss >> data)) {
-        continue;
-      }
-    }
-
-    if (infile) {
-      edgeData.set(p.addNeighbor(src, dst), data);
-    }
-  }
+  katana::do_all(
+      katana::iterate(chunks),
+      [&](const std::pair<size_t, size_t>& chunk) {
+        forEachEdge(
+            chunk,
+            [&](size_t src, size_t dst, const edge_value_type& value) {
+              edgeData.set(p.addNeighborAtomic(src, dst), value);
+            },
+            []() {});
+      },
+      katana::steal());
 
   edge_value_type* rawEdgeData = p.finish<edge_value_type>();
   if (EdgeData::has_value)
@@ -673,6 +797,108 @@ struct Edgelist2Binary : public Conversion {
   }
 };
 
+/**
+ * Convert binary edgelist to binary graph.
+ *
+ * The input is a packed array of fixed-width little-endian records with no
+ * header:
+ *
+ * <src:uint32> <dst:uint32> [<weight:EdgeTy>]
+ * ...
+ *
+ * This is the format written by edgelist2binary, optionally extended with one
+ * edge value per record when -edgeType is not void. Because records have a
+ * fixed width the file is memory mapped and split into record ranges without
+ * any text scanning, so repeat conversions of machine-generated edge dumps
+ * skip parsing entirely.
+ */
+struct BinaryEdgelist2Gr : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    typedef katana::FileGraphWriter Writer;
+    typedef katana::NUMAArray<EdgeTy> EdgeData;
+    typedef typename EdgeData::value_type edge_value_type;
+
+    Writer p;
+    EdgeData edgeData;
+    MappedInputFile infile(infilename);
+    const char* data = infile.data();
+
+    constexpr size_t kRecordSize =
+        2 * sizeof(uint32_t) + EdgeData::size_of::value;
+    if (infile.size() % kRecordSize != 0) {
+      KATANA_DIE(
+          "file size is not a multiple of the record size; "
+          "check -edgeType against how the file was written");
+    }
+    size_t numEdges = infile.size() / kRecordSize;
+
+    // records may not be aligned for EdgeTy, so copy fields out of the mapping
+    auto readEdge = [&](size_t idx, uint32_t* src, uint32_t* dst,
+                        edge_value_type* value) {
+      const char* record = data + idx * kRecordSize;
+      memcpy(src, record, sizeof(uint32_t));
+      memcpy(dst, record + sizeof(uint32_t), sizeof(uint32_t));
+      if constexpr (EdgeData::has_value) {
+        memcpy(value, record + 2 * sizeof(uint32_t), sizeof(edge_value_type));
+      }
+    };
+
+    katana::GReduceMax<uint32_t> maxNodeId;
+    katana::do_all(
+        katana::iterate(size_t{0}, numEdges),
+        [&](size_t idx) {
+          uint32_t src;
+          uint32_t dst;
+          edge_value_type value{};
+          readEdge(idx, &src, &dst, &value);
+          maxNodeId.update(std::max(src, dst));
+        },
+        katana::steal());
+
+    size_t numNodes = numEdges ? size_t{maxNodeId.reduce()} + 1 : 0;
+    p.setNumNodes(numNodes);
+    p.setNumEdges(numEdges);
+    p.setSizeofEdgeData(EdgeData::size_of::value);
+    edgeData.create(numEdges);
+
+    p.phase1();
+
+    katana::do_all(
+        katana::iterate(size_t{0}, numEdges),
+        [&](size_t idx) {
+          uint32_t src;
+          uint32_t dst;
+          edge_value_type value{};
+          readEdge(idx, &src, &dst, &value);
+          p.incrementDegreeAtomic(src);
+        },
+        katana::steal());
+
+    p.phase2();
+
+    katana::do_all(
+        katana::iterate(size_t{0}, numEdges),
+        [&](size_t idx) {
+          uint32_t src;
+          uint32_t dst;
+          edge_value_type value{};
+          readEdge(idx, &src, &dst, &value);
+          edgeData.set(p.addNeighborAtomic(src, dst), value);
+        },
+        katana::steal());
+
+    edge_value_type* rawEdgeData = p.finish<edge_value_type>();
+    if (EdgeData::has_value)
+      std::uninitialized_copy(
+          std::make_move_iterator(edgeData.begin()),
+          std::make_move_iterator(edgeData.end()), rawEdgeData);
+
+    p.toFile(outfilename);
+    printStatus(numNodes, numEdges);
+  }
+};
+
 /**
  * Convert matrix market matrix to binary graph.
  *
@@ -3422,6 +3648,9 @@ main(int argc, char** argv) {
   case edgelist2binary:
     convert<Edgelist2Binary>();
     break;
+  case binaryedgelist2gr:
+    convert<BinaryEdgelist2Gr>();
+    break;
   default:
     abort();
   }
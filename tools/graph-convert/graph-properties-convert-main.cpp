@@ -56,6 +56,17 @@ cll::opt<int> chunk_size(
               "it can be decreased to improve memory usage when "
               "converting large inputs"),
     cll::init(25000));
+cll::opt<bool> parallel_ingest(
+    "parallel",
+    cll::desc("Parse GraphML input with parallel segmented ingest"),
+    cll::init(false));
+cll::opt<unsigned> fetch_threads(
+    "fetch-threads",
+    cll::desc("Number of concurrent cursors used to fetch data from a "
+              "database, each covering a disjoint key range\n"
+              "Conversion is pipelined with fetching; 1 disables "
+              "partitioned fetching"),
+    cll::init(1));
 cll::opt<std::string> mapping(
     "mapping",
     cll::desc("File in graphml format with a schema mapping for the database"),
@@ -139,7 +150,9 @@ ParseWild() {
   switch (type) {
   case katana::SourceType::kGraphml: {
     auto components_result =
-        katana::ConvertGraphML(input_filename, chunk_size, true);
+        parallel_ingest
+            ? katana::ConvertGraphMLParallel(input_filename, chunk_size, true)
+            : katana::ConvertGraphML(input_filename, chunk_size, true);
     if (!components_result) {
       KATANA_LOG_FATAL("Error converting graph: {}", components_result.error());
     }
@@ -167,7 +180,9 @@ ParseNeo4j() {
   switch (type) {
   case katana::SourceType::kGraphml: {
     auto components_result =
-        katana::ConvertGraphML(input_filename, chunk_size, true);
+        parallel_ingest
+            ? katana::ConvertGraphMLParallel(input_filename, chunk_size, true)
+            : katana::ConvertGraphML(input_filename, chunk_size, true);
     if (!components_result) {
       KATANA_LOG_FATAL("Error converting graph: {}", components_result.error());
     }
@@ -190,7 +205,8 @@ ParseMongoDB() {
     katana::GenerateMappingMongoDB(input_filename, output_directory);
   } else {
     if (auto r = katana::WritePropertyGraph(
-            katana::ConvertMongoDB(input_filename, mapping, chunk_size),
+            katana::ConvertMongoDB(
+                input_filename, mapping, chunk_size, fetch_threads),
             output_directory);
         !r) {
       KATANA_LOG_FATAL("Failed to write property graph: {}", r.error());
@@ -209,7 +225,8 @@ ParseMysql() {
   } else {
     if (auto r = katana::WritePropertyGraph(
             katana::ConvertMysql(
-                input_filename, mapping, chunk_size, host, user),
+                input_filename, mapping, chunk_size, host, user,
+                fetch_threads),
             output_directory);
         !r) {
       KATANA_LOG_FATAL("Failed to write property graph: {}", r.error());
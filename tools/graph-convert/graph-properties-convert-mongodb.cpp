@@ -1,6 +1,7 @@
 #include "graph-properties-convert-mongodb.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <deque>
@@ -11,6 +12,7 @@
 #include <optional>
 #include <random>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -18,6 +20,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include "graph-properties-convert-pipeline.h"
 #include "katana/ErrorCode.h"
 #include "katana/Galois.h"
 #include "katana/GraphMLSchema.h"
@@ -570,6 +573,146 @@ QueryEntireCollection(
   mongoc_collection_destroy(collection);
 }
 
+// GetPartitionBounds splits a collection into roughly equal _id ranges using
+// a $bucketAuto aggregation; the returned values are the lower bounds of each
+// range, so partition i covers [bounds[i], bounds[i + 1]) and the last
+// partition is unbounded above. An empty result means the collection could
+// not be partitioned and a single cursor should be used instead
+std::vector<bson_value_t_wrapper>
+GetPartitionBounds(
+    mongoc_database_t* database, const std::string& coll_name,
+    size_t num_partitions) {
+  std::vector<bson_value_t_wrapper> bounds;
+  if (num_partitions <= 1) {
+    return bounds;
+  }
+  auto collection = mongoc_database_get_collection(database, coll_name.c_str());
+  bson_t* pipeline = BCON_NEW(
+      "pipeline", "[", "{", "$bucketAuto", "{", "groupBy", "$_id", "buckets",
+      BCON_INT64(static_cast<int64_t>(num_partitions)), "}", "}", "]");
+  bson_t* opts = BCON_NEW("allowDiskUse", BCON_BOOL(true));
+  auto cursor = mongoc_collection_aggregate(
+      collection, MONGOC_QUERY_NONE, pipeline, opts, nullptr);
+
+  const bson_t* doc = nullptr;
+  while (mongoc_cursor_next(cursor, &doc)) {
+    bson_iter_t iter;
+    bson_iter_t bucket;
+    if (bson_iter_init_find(&iter, doc, "_id") &&
+        bson_iter_recurse(&iter, &bucket) && bson_iter_find(&bucket, "min")) {
+      bson_value_t_wrapper bound{};
+      bson_value_copy(bson_iter_value(&bucket), &bound.val);
+      bounds.emplace_back(bound);
+    }
+  }
+  bson_error_t error;
+  if (mongoc_cursor_error(cursor, &error)) {
+    KATANA_LOG_WARN(
+        "Could not partition collection {}, falling back to a single "
+        "cursor: {}",
+        coll_name, error.message);
+    for (auto& bound : bounds) {
+      bson_value_destroy(&bound.val);
+    }
+    bounds.clear();
+  }
+
+  mongoc_cursor_destroy(cursor);
+  bson_destroy(opts);
+  bson_destroy(pipeline);
+  mongoc_collection_destroy(collection);
+  return bounds;
+}
+
+// QueryCollectionPartitioned is a parallel variant of QueryEntireCollection:
+// the collection is split into _id ranges, each range is fetched by its own
+// thread over its own client connection, and the fetched documents are fed
+// through a bounded queue to the calling thread, which runs document_op on
+// them. Fetching thus overlaps with conversion, and conversion applies
+// backpressure to fetching through the queue bound
+template <typename T>
+void
+QueryCollectionPartitioned(
+    const char* uri_string, const std::string& db_name,
+    mongoc_database_t* database, const bson_t** document,
+    const std::string& coll_name, size_t fetch_threads, T document_op) {
+  constexpr size_t kFetchBatchSize = 256;
+  using DocumentBatch = std::vector<bson_t*>;
+
+  std::vector<bson_value_t_wrapper> bounds =
+      GetPartitionBounds(database, coll_name, fetch_threads);
+  if (bounds.size() <= 1) {
+    for (auto& bound : bounds) {
+      bson_value_destroy(&bound.val);
+    }
+    QueryEntireCollection(database, document, coll_name, document_op);
+    return;
+  }
+
+  katana::BoundedBatchQueue<DocumentBatch> queue{4 * bounds.size()};
+  std::atomic<size_t> active{bounds.size()};
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < bounds.size(); i++) {
+    workers.emplace_back([&, i]() {
+      MongoClient client{GetMongoClient(uri_string)};
+      auto collection = mongoc_client_get_collection(
+          client.client, db_name.c_str(), coll_name.c_str());
+      bson_t filter;
+      bson_t id_range;
+      bson_init(&filter);
+      bson_append_document_begin(&filter, "_id", -1, &id_range);
+      bson_append_value(&id_range, "$gte", -1, &bounds[i].val);
+      if (i + 1 < bounds.size()) {
+        bson_append_value(&id_range, "$lt", -1, &bounds[i + 1].val);
+      }
+      bson_append_document_end(&filter, &id_range);
+
+      auto cursor = mongoc_collection_find_with_opts(
+          collection, &filter, nullptr, nullptr);
+      DocumentBatch batch;
+      batch.reserve(kFetchBatchSize);
+      const bson_t* doc = nullptr;
+      while (mongoc_cursor_next(cursor, &doc)) {
+        batch.emplace_back(bson_copy(doc));
+        if (batch.size() >= kFetchBatchSize) {
+          queue.Push(std::move(batch));
+          batch = DocumentBatch{};
+          batch.reserve(kFetchBatchSize);
+        }
+      }
+      bson_error_t error;
+      if (mongoc_cursor_error(cursor, &error)) {
+        KATANA_LOG_ERROR(
+            "An error occurred with a mongodb cursor: {}", error.message);
+      }
+      if (!batch.empty()) {
+        queue.Push(std::move(batch));
+      }
+
+      bson_destroy(&filter);
+      mongoc_cursor_destroy(cursor);
+      mongoc_collection_destroy(collection);
+      if (--active == 0) {
+        queue.Close();
+      }
+    });
+  }
+
+  while (auto batch = queue.Pop()) {
+    for (bson_t* doc : *batch) {
+      *document = doc;
+      document_op();
+      bson_destroy(doc);
+    }
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (auto& bound : bounds) {
+    bson_value_destroy(&bound.val);
+  }
+}
+
 /***************************************/
 /* Functions for MongoDB preprocessing */
 /***************************************/
@@ -1112,7 +1255,8 @@ katana::GenerateMappingMongoDB(
 
 katana::GraphComponents
 katana::ConvertMongoDB(
-    const std::string& db_name, const std::string& mapping, size_t chunk_size) {
+    const std::string& db_name, const std::string& mapping, size_t chunk_size,
+    size_t fetch_threads) {
   const char* uri_string = "mongodb://localhost:27017";
   const bson_t* document = nullptr;
 
@@ -1142,15 +1286,19 @@ katana::ConvertMongoDB(
 
   // add all edges first
   for (auto coll_name : edges) {
-    QueryEntireCollection(database, &document, coll_name, [&]() {
-      katana::HandleEdgeDocumentMongoDB(&builder, document, coll_name);
-    });
+    QueryCollectionPartitioned(
+        uri_string, db_name, database, &document, coll_name, fetch_threads,
+        [&]() {
+          katana::HandleEdgeDocumentMongoDB(&builder, document, coll_name);
+        });
   }
   // then add all nodes
   for (auto coll_name : nodes) {
-    QueryEntireCollection(database, &document, coll_name, [&]() {
-      katana::HandleNodeDocumentMongoDB(&builder, document, coll_name);
-    });
+    QueryCollectionPartitioned(
+        uri_string, db_name, database, &document, coll_name, fetch_threads,
+        [&]() {
+          katana::HandleNodeDocumentMongoDB(&builder, document, coll_name);
+        });
   }
 
   mongoc_cleanup();
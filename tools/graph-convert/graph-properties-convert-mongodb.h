@@ -17,7 +17,7 @@ void HandleEdgeDocumentMongoDB(
 
 GraphComponents ConvertMongoDB(
     const std::string& db_name, const std::string& mapping,
-    const size_t chunk_size);
+    const size_t chunk_size, size_t fetch_threads = 1);
 void GenerateMappingMongoDB(
     const std::string& db_name, const std::string& outfile);
 
@@ -4,6 +4,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <deque>
@@ -14,6 +15,7 @@
 #include <optional>
 #include <random>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -21,6 +23,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include "graph-properties-convert-pipeline.h"
 #include "katana/ErrorCode.h"
 #include "katana/Galois.h"
 #include "katana/GraphMLSchema.h"
@@ -256,105 +259,256 @@ RunQuery(MYSQL* con, const std::string& query) {
   return MysqlRes(mysql_use_result(con));
 }
 
+// a row copied out of a MYSQL_RES so it can outlive the result set and cross
+// thread boundaries; a disengaged field is a SQL NULL
+using MaterializedRow = std::vector<std::optional<std::string>>;
+
+MaterializedRow
+MaterializeRow(MYSQL_ROW row, unsigned long* lengths, size_t num_fields) {
+  MaterializedRow fields(num_fields);
+  for (size_t i = 0; i < num_fields; i++) {
+    if (row[i] != NULL) {
+      fields[i] = std::string(row[i], lengths[i]);
+    }
+  }
+  return fields;
+}
+
 void
-AddNodeTable(
-    katana::PropertyGraphBuilder* builder, MYSQL* con,
-    const TableData& table_data) {
-  MysqlRes table = RunQuery(con, GenerateFetchTableQuery(table_data.name));
-  MYSQL_ROW row;
+AddNodeRow(
+    katana::PropertyGraphBuilder* builder, const TableData& table_data,
+    const MaterializedRow& row) {
+  builder->StartNode();
+  builder->AddLabel(table_data.name);
+
+  // if table has a primary key, add it as node's ID
+  auto primary_index = table_data.primary_key_index;
+  if (primary_index >= 0 && row[primary_index]) {
+    builder->AddNodeID(table_data.name + *row[primary_index]);
+  }
 
-  while ((row = mysql_fetch_row(table.res))) {
-    auto lengths = mysql_fetch_lengths(table.res);
+  // add data fields
+  for (size_t i = 0; i < table_data.field_names.size(); i++) {
+    auto index = table_data.field_indexes[i];
+    // if the data is null then do not add it
+    if (row[index]) {
+      const std::string& value = *row[index];
+
+      builder->AddValue(
+          table_data.field_names[i],
+          []() {
+            return PropertyKey{"invalid", ImportDataType::kUnsupported, false};
+          },
+          [&value](ImportDataType type, bool is_list) {
+            return ResolveValue(value, type, is_list);
+          });
+    }
+  }
 
-    builder->StartNode();
-    builder->AddLabel(table_data.name);
+  // if table has outgoing edges, add them
+  for (auto relation : table_data.out_references) {
+    auto foreign_index = relation.source_index;
+    // if the target is null then do not add an edge
+    if (row[foreign_index]) {
+      std::string edge_id = relation.target_table + *row[foreign_index];
+      builder->AddOutgoingEdge(edge_id, relation.label);
+    }
+  }
+  builder->FinishNode();
+}
 
-    // if table has a primary key, add it as node's ID
-    auto primary_index = table_data.primary_key_index;
-    if (primary_index >= 0) {
-      std::string primary_key{row[primary_index], lengths[primary_index]};
-      builder->AddNodeID(table_data.name + primary_key);
+void
+AddEdgeRow(
+    katana::PropertyGraphBuilder* builder, const TableData& table_data,
+    const MaterializedRow& row) {
+  builder->StartEdge();
+  builder->AddLabel(table_data.name);
+
+  bool adding_source = true;
+  // if the source or target is null then add a placeholder node
+  for (auto relation : table_data.out_references) {
+    auto foreign_index = relation.source_index;
+    std::string foreign_key =
+        row[foreign_index] ? *row[foreign_index] : std::string{};
+    std::string edge_id = relation.target_table + foreign_key;
+    if (adding_source) {
+      builder->AddEdgeSource(edge_id);
+      adding_source = false;
+    } else {
+      builder->AddEdgeTarget(edge_id);
     }
+  }
 
-    // add data fields
-    for (size_t i = 0; i < table_data.field_names.size(); i++) {
-      auto index = table_data.field_indexes[i];
-      // if the data is null then do not add it
-      if (row[index] != NULL) {
-        std::string value{row[index], lengths[index]};
-
-        builder->AddValue(
-            table_data.field_names[i],
-            []() {
-              return PropertyKey{
-                  "invalid", ImportDataType::kUnsupported, false};
-            },
-            [&value](ImportDataType type, bool is_list) {
-              return ResolveValue(value, type, is_list);
-            });
-      }
+  // add data fields
+  for (size_t i = 0; i < table_data.field_names.size(); i++) {
+    auto index = table_data.field_indexes[i];
+    // if the data is null then do not add it
+    if (row[index]) {
+      const std::string& value = *row[index];
+
+      builder->AddValue(
+          table_data.field_names[i],
+          []() {
+            return PropertyKey{"invalid", ImportDataType::kUnsupported, false};
+          },
+          [&value](ImportDataType type, bool is_list) {
+            return ResolveValue(value, type, is_list);
+          });
     }
+  }
+  builder->FinishEdge();
+}
+
+struct PrimaryKeyRange {
+  std::string column;
+  int64_t min;
+  int64_t max;
+};
 
-    // if table has outgoing edges, add them
-    for (auto relation : table_data.out_references) {
-      auto foreign_index = relation.source_index;
-      // if the target is null then do not add an edge
-      if (row[foreign_index] != NULL) {
-        std::string foreign_key{row[foreign_index], lengths[foreign_index]};
-        std::string edge_id = relation.target_table + foreign_key;
-        builder->AddOutgoingEdge(edge_id, relation.label);
+// FetchPrimaryKeyRange finds an integer primary key column of a table and
+// its value range so the table can be partitioned into PK ranges; returns
+// std::nullopt if the table has no integer primary key or is empty
+std::optional<PrimaryKeyRange>
+FetchPrimaryKeyRange(MYSQL* con, const std::string& table) {
+  std::string column;
+  {
+    MysqlRes sample = RunQuery(con, GenerateFetchRowQuery(table));
+    MYSQL_FIELD* field;
+    while ((field = mysql_fetch_field(sample.res))) {
+      if ((field->flags & PRI_KEY_FLAG) && IS_NUM(field->type)) {
+        column = std::string{field->name, field->name_length};
+        break;
       }
     }
-    builder->FinishNode();
+    while (mysql_fetch_row(sample.res))
+      ;
+  }
+  if (column.empty()) {
+    return std::nullopt;
+  }
+
+  MysqlRes range = RunQuery(
+      con,
+      "SELECT MIN(" + column + "), MAX(" + column + ") FROM " + table + ";");
+  std::optional<PrimaryKeyRange> result;
+  MYSQL_ROW row = mysql_fetch_row(range.res);
+  if (row != nullptr && row[0] != NULL && row[1] != NULL) {
+    result = PrimaryKeyRange{
+        column, std::strtoll(row[0], nullptr, 10),
+        std::strtoll(row[1], nullptr, 10)};
   }
+  while (mysql_fetch_row(range.res))
+    ;
+  return result;
 }
 
+struct MysqlConnectionParams {
+  std::string host;
+  std::string user;
+  std::string password;
+  std::string db_name;
+};
+
+MYSQL*
+ConnectMysql(const MysqlConnectionParams& params) {
+  MYSQL* con = mysql_init(NULL);
+  if (con == nullptr) {
+    KATANA_LOG_FATAL("mysql_init() failed");
+  }
+  if (mysql_real_connect(
+          con, params.host.c_str(), params.user.c_str(),
+          params.password.c_str(), params.db_name.c_str(), 0, NULL,
+          0) == NULL) {
+    KATANA_LOG_FATAL(
+        "Could not establish mysql connection: {}", mysql_error(con));
+  }
+  return con;
+}
+
+// AddTablePartitioned converts a table into graph elements, fetching rows
+// with fetch_threads concurrent connections over disjoint primary key ranges
+// when the table has an integer primary key and serially over con otherwise.
+// Fetched rows flow through a bounded queue to the calling thread, which
+// applies add_row (AddNodeRow or AddEdgeRow) to them; conversion thus
+// overlaps with fetching and applies backpressure through the queue bound
 void
-AddEdgeTable(
+AddTablePartitioned(
     katana::PropertyGraphBuilder* builder, MYSQL* con,
-    const TableData& table_data) {
-  MysqlRes table = RunQuery(con, GenerateFetchTableQuery(table_data.name));
-  MYSQL_ROW row;
-
-  while ((row = mysql_fetch_row(table.res))) {
-    auto lengths = mysql_fetch_lengths(table.res);
-
-    builder->StartEdge();
-    builder->AddLabel(table_data.name);
-
-    bool adding_source = true;
-    // if the source or target is null then add a placeholder node
-    for (auto relation : table_data.out_references) {
-      auto foreign_index = relation.source_index;
-      std::string foreign_key{row[foreign_index], lengths[foreign_index]};
-      std::string edge_id = relation.target_table + foreign_key;
-      if (adding_source) {
-        builder->AddEdgeSource(edge_id);
-        adding_source = false;
-      } else {
-        builder->AddEdgeTarget(edge_id);
-      }
+    const MysqlConnectionParams& params, const TableData& table_data,
+    size_t fetch_threads,
+    void (*add_row)(
+        katana::PropertyGraphBuilder*, const TableData&,
+        const MaterializedRow&)) {
+  constexpr size_t kRowBatchSize = 1024;
+  using RowBatch = std::vector<MaterializedRow>;
+
+  std::optional<PrimaryKeyRange> range;
+  if (fetch_threads > 1) {
+    range = FetchPrimaryKeyRange(con, table_data.name);
+  }
+  uint64_t span =
+      range ? static_cast<uint64_t>(range->max - range->min) + 1 : 0;
+  if (!range || span < fetch_threads) {
+    MysqlRes table = RunQuery(con, GenerateFetchTableQuery(table_data.name));
+    auto num_fields = mysql_num_fields(table.res);
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(table.res))) {
+      auto lengths = mysql_fetch_lengths(table.res);
+      add_row(builder, table_data, MaterializeRow(row, lengths, num_fields));
     }
+    return;
+  }
 
-    // add data fields
-    for (size_t i = 0; i < table_data.field_names.size(); i++) {
-      auto index = table_data.field_indexes[i];
-      // if the data is null then do not add it
-      if (row[index] != NULL) {
-        std::string value{row[index], lengths[index]};
-
-        builder->AddValue(
-            table_data.field_names[i],
-            []() {
-              return PropertyKey{
-                  "invalid", ImportDataType::kUnsupported, false};
-            },
-            [&value](ImportDataType type, bool is_list) {
-              return ResolveValue(value, type, is_list);
-            });
+  katana::BoundedBatchQueue<RowBatch> queue{4 * fetch_threads};
+  std::atomic<size_t> active{fetch_threads};
+  uint64_t chunk = (span + fetch_threads - 1) / fetch_threads;
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < fetch_threads; i++) {
+    int64_t lower = range->min + static_cast<int64_t>(i * chunk);
+    bool last = i + 1 == fetch_threads;
+    int64_t upper =
+        last ? range->max : range->min + static_cast<int64_t>((i + 1) * chunk);
+    workers.emplace_back([&, lower, upper, last]() {
+      mysql_thread_init();
+      MYSQL* wcon = ConnectMysql(params);
+      {
+        std::string query =
+            "SELECT * FROM " + table_data.name + " WHERE " + range->column +
+            " >= " + std::to_string(lower) + " AND " + range->column +
+            (last ? " <= " : " < ") + std::to_string(upper) + ";";
+        MysqlRes table = RunQuery(wcon, query);
+        auto num_fields = mysql_num_fields(table.res);
+        RowBatch batch;
+        batch.reserve(kRowBatchSize);
+        MYSQL_ROW row;
+        while ((row = mysql_fetch_row(table.res))) {
+          auto lengths = mysql_fetch_lengths(table.res);
+          batch.emplace_back(MaterializeRow(row, lengths, num_fields));
+          if (batch.size() >= kRowBatchSize) {
+            queue.Push(std::move(batch));
+            batch = RowBatch{};
+            batch.reserve(kRowBatchSize);
+          }
+        }
+        if (!batch.empty()) {
+          queue.Push(std::move(batch));
+        }
+      }
+      mysql_close(wcon);
+      mysql_thread_end();
+      if (--active == 0) {
+        queue.Close();
       }
+    });
+  }
+
+  while (auto batch = queue.Pop()) {
+    for (const MaterializedRow& row : *batch) {
+      add_row(builder, table_data, row);
     }
-    builder->FinishEdge();
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
   }
 }
 
@@ -859,20 +1013,13 @@ GetMappingInput(
 GraphComponents
 katana::ConvertMysql(
     const std::string& db_name, const std::string& mapping,
-    const size_t chunk_size, const std::string& host, const std::string& user) {
+    const size_t chunk_size, const std::string& host, const std::string& user,
+    size_t fetch_threads) {
   katana::PropertyGraphBuilder builder{chunk_size};
   std::string password{getpass("MySQL Password: ")};
 
-  MYSQL* con = mysql_init(NULL);
-  if (con == nullptr) {
-    KATANA_LOG_FATAL("mysql_init() failed");
-  }
-  if (mysql_real_connect(
-          con, host.c_str(), user.c_str(), password.c_str(), db_name.c_str(), 0,
-          NULL, 0) == NULL) {
-    KATANA_LOG_FATAL(
-        "Could not establish mysql connection: {}", mysql_error(con));
-  }
+  MysqlConnectionParams params{host, user, password, db_name};
+  MYSQL* con = ConnectMysql(params);
   std::vector<std::string> table_names = FetchTableNames(con);
   std::unordered_map<std::string, TableData> table_data;
   if (!mapping.empty()) {
@@ -885,11 +1032,9 @@ katana::ConvertMysql(
   }
 
   for (auto table : table_data) {
-    if (table.second.is_node) {
-      AddNodeTable(&builder, con, table.second);
-    } else {
-      AddEdgeTable(&builder, con, table.second);
-    }
+    AddTablePartitioned(
+        &builder, con, params, table.second, fetch_threads,
+        table.second.is_node ? AddNodeRow : AddEdgeRow);
   }
   mysql_close(con);
   auto out_result = builder.Finish();
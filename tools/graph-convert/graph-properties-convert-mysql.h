@@ -7,7 +7,8 @@ namespace katana {
 
 GraphComponents ConvertMysql(
     const std::string& db_name, const std::string& mapping,
-    const size_t chunk_size, const std::string& host, const std::string& user);
+    const size_t chunk_size, const std::string& host, const std::string& user,
+    size_t fetch_threads = 1);
 void GenerateMappingMysql(
     const std::string& db_name, const std::string& outfile,
     const std::string& host, const std::string& user);
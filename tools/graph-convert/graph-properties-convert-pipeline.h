@@ -0,0 +1,68 @@
+#ifndef KATANA_TOOLS_GRAPH_CONVERT_GRAPH_PROPERTIES_CONVERT_PIPELINE_H_
+#define KATANA_TOOLS_GRAPH_CONVERT_GRAPH_PROPERTIES_CONVERT_PIPELINE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace katana {
+
+/// A bounded multi-producer single-consumer queue used to pipeline database
+/// extraction with graph construction. Extraction threads block in Push once
+/// the queue is full, so a slow conversion stage applies backpressure to the
+/// fetch stage instead of letting fetched batches accumulate without bound.
+template <typename T>
+class BoundedBatchQueue {
+public:
+  BoundedBatchQueue(size_t capacity) : capacity_(capacity) {}
+
+  /// Push blocks until there is room in the queue; returns false if the
+  /// queue was closed before the batch could be enqueued
+  bool Push(T batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(
+        lock, [&]() { return closed_ || batches_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    batches_.emplace_back(std::move(batch));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /// Pop blocks until a batch is available; returns std::nullopt once the
+  /// queue has been closed and drained
+  std::optional<T> Pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [&]() { return closed_ || !batches_.empty(); });
+    if (batches_.empty()) {
+      return std::nullopt;
+    }
+    T batch = std::move(batches_.front());
+    batches_.pop_front();
+    not_full_.notify_one();
+    return batch;
+  }
+
+  /// Close wakes all waiting producers and consumers; pending batches can
+  /// still be drained with Pop
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+private:
+  size_t capacity_;
+  bool closed_{false};
+  std::deque<T> batches_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+}  // end namespace katana
+
+#endif
@@ -1,6 +1,16 @@
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <arrow/api.h>
+
 #include "katana/BuildGraph.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
 
 constexpr uint64_t kNumNodes = 100;
+constexpr uint64_t kNumOps = 25000;
+constexpr uint64_t kDefaultOpsPerWindow = 1000;
 
 class LogPlay {
   katana::PropertyGraphBuilder pgb;
@@ -21,7 +31,7 @@ public:
           ResolveValue) {
     pgb.AddValue(id, ProcessElement, ResolveValue);
   }
-  void CreateRDG() {
+  std::string CreateRDG() {
     auto uri_res = katana::Uri::MakeRand("/tmp/oplog");
     KATANA_LOG_ASSERT(uri_res);
     std::string dest_dir(uri_res.value().string());
@@ -36,11 +46,80 @@ public:
       KATANA_LOG_FATAL("Failed to write graph: {}", r.error());
     }
     fmt::print("RDG written to {}\n", dest_dir);
+    return dest_dir;
   }
 };
 
+// A single oplog entry: set the rank property of edge (src, dst)
+struct PropUpdateOp {
+  uint64_t src;
+  uint64_t dst;
+  int64_t rank;
+};
+
+// Stand-in for reading an oplog from storage: a deterministic stream of
+// rank updates spread over the whole graph
+std::vector<PropUpdateOp>
+MakeOplog() {
+  std::vector<PropUpdateOp> ops;
+  ops.reserve(kNumOps);
+  uint64_t state = 1;
+  for (uint64_t i = 0; i < kNumOps; ++i) {
+    state = state * 6364136223846793005UL + 1442695040888963407UL;
+    uint64_t edge = (state >> 32) % (kNumNodes * kNumNodes);
+    ops.push_back(PropUpdateOp{
+        edge / kNumNodes, edge % kNumNodes, static_cast<int64_t>(i)});
+  }
+  return ops;
+}
+
+uint64_t
+FindEdge(const katana::GraphTopology& topo, uint64_t src, uint64_t dst) {
+  for (auto e : topo.edges(src)) {
+    if (topo.edge_dest(e) == dst) {
+      return e;
+    }
+  }
+  KATANA_LOG_FATAL("no edge {} -> {}", src, dst);
+}
+
+// ApplyWindow batches one transaction window of updates into an in-memory
+// Arrow builder and swaps the resulting column into the graph; the caller
+// commits once per window rather than once per operation
+katana::Result<void>
+ApplyWindow(
+    katana::PropertyGraph* graph, const std::vector<PropUpdateOp>& window) {
+  const katana::GraphTopology& topo = graph->topology();
+  std::shared_ptr<arrow::ChunkedArray> chunked =
+      KATANA_CHECKED(graph->GetEdgeProperty("rank"));
+
+  std::vector<int64_t> ranks;
+  ranks.reserve(topo.num_edges());
+  for (const auto& chunk : chunked->chunks()) {
+    auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i) {
+      ranks.push_back(array->Value(i));
+    }
+  }
+
+  for (const PropUpdateOp& op : window) {
+    ranks[FindEdge(topo, op.src, op.dst)] = op.rank;
+  }
+
+  arrow::Int64Builder builder;
+  KATANA_LOG_ASSERT(builder.AppendValues(ranks).ok());
+  std::shared_ptr<arrow::Array> column;
+  KATANA_LOG_ASSERT(builder.Finish(&column).ok());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("rank", arrow::int64())}), {column});
+
+  KATANA_CHECKED(graph->RemoveEdgeProperty("rank"));
+  KATANA_CHECKED(graph->AddEdgeProperties(table));
+  return katana::ResultSuccess();
+}
+
 void
-ReadLog() {
+ReadLog(uint64_t ops_per_window) {
   LogPlay lp;
 
   std::string prop_id = "n0";
@@ -86,14 +165,49 @@ ReadLog() {
       lp.FinishEdge();
     }
   }
-  lp.CreateRDG();
+  std::string dest_dir = lp.CreateRDG();
+
+  // replay the remaining oplog in transaction windows: each window is
+  // applied to in-memory builders and committed once, and the commit only
+  // rewrites the files the window actually changed
+  auto graph_result = katana::PropertyGraph::Make(dest_dir);
+  if (!graph_result) {
+    KATANA_LOG_FATAL("Failed to load graph: {}", graph_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> graph =
+      std::move(graph_result.value());
+
+  std::vector<PropUpdateOp> oplog = MakeOplog();
+  uint64_t num_windows = 0;
+  for (size_t begin = 0; begin < oplog.size(); begin += ops_per_window) {
+    size_t end = std::min<size_t>(oplog.size(), begin + ops_per_window);
+    std::vector<PropUpdateOp> window(
+        oplog.begin() + begin, oplog.begin() + end);
+    if (auto r = ApplyWindow(graph.get(), window); !r) {
+      KATANA_LOG_FATAL("Failed to apply oplog window: {}", r.error());
+    }
+    if (auto r = graph->Commit("oplog-rdg"); !r) {
+      KATANA_LOG_FATAL("Failed to commit oplog window: {}", r.error());
+    }
+    ++num_windows;
+  }
+  fmt::print(
+      "Replayed {} operations in {} windows of {}\n", oplog.size(),
+      num_windows, ops_per_window);
 }
 
 int
-main() {  //int argc, char* argv[]) {
+main(int argc, char* argv[]) {
   katana::SharedMemSys sys;
 
-  ReadLog();
+  uint64_t ops_per_window = kDefaultOpsPerWindow;
+  if (argc > 1) {
+    ops_per_window = std::strtoull(argv[1], nullptr, 10);
+    if (ops_per_window == 0) {
+      KATANA_LOG_FATAL("invalid window size {}", argv[1]);
+    }
+  }
+  ReadLog(ops_per_window);
 
   return 0;
 }
@@ -0,0 +1,332 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/compute/api_vector.h>
+#include <llvm/Support/CommandLine.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/GraphTopology.h"
+#include "katana/NUMAArray.h"
+#include "katana/NodeOrdering.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Strings.h"
+
+namespace cll = llvm::cl;
+
+// Offline compaction pass for RDGs. Months of delta updates leave an RDG
+// with many small property files and unsorted adjacency lists; this tool
+// rewrites it into the form consumers want to read: destination-sorted
+// edges, single-chunk single-file properties, optionally locality-ordered
+// node IDs (degree, RCM, or Gorder) and a different parquet codec.
+
+static std::string kCommandLine;
+
+static cll::opt<std::string> inputFilename(
+    cll::Positional, cll::desc("<input RDG directory>"), cll::Required);
+static cll::opt<std::string> outputFilename(
+    cll::Positional, cll::desc("<output RDG directory>"), cll::Required);
+static cll::opt<bool> sortEdges(
+    "sortEdges", cll::desc("sort each node's edges by destination ID"),
+    cll::init(true));
+enum class NodeOrderKind { kNone, kDegree, kRCM, kGorder };
+
+static cll::opt<bool> sortNodesByDegree(
+    "sortNodesByDegree",
+    cll::desc("renumber nodes in descending degree order "
+              "(same as -nodeOrder=degree)"),
+    cll::init(false));
+static cll::opt<NodeOrderKind> nodeOrder(
+    "nodeOrder", cll::desc("renumber nodes for traversal locality:"),
+    cll::values(
+        clEnumValN(
+            NodeOrderKind::kDegree, "degree", "descending degree order"),
+        clEnumValN(
+            NodeOrderKind::kRCM, "rcm",
+            "reverse Cuthill-McKee; best on meshes and road networks"),
+        clEnumValN(
+            NodeOrderKind::kGorder, "gorder",
+            "Gorder window order; best on power-law graphs")),
+    cll::init(NodeOrderKind::kNone));
+static cll::opt<std::string> compression(
+    "compression",
+    cll::desc("parquet codec for rewritten properties; a bare codec name "
+              "(zstd, snappy, gzip, uncompressed) or a comma-separated "
+              "list of column=codec overrides"),
+    cll::init(""));
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+/// Gather the rows named by indices out of every column of the given schema,
+/// one arrow Take per column run in parallel across columns.
+template <typename ColumnFn>
+katana::Result<std::shared_ptr<arrow::Table>>
+GatherPropertyRows(
+    const std::shared_ptr<arrow::Schema>& schema, const ColumnFn& column_fn,
+    const std::shared_ptr<arrow::Array>& indices) {
+  int num_fields = schema->num_fields();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(num_fields);
+  std::vector<katana::Result<void>> results(
+      num_fields, katana::ResultSuccess());
+
+  katana::do_all(katana::iterate(0, num_fields), [&](int i) {
+    auto taken = arrow::compute::Take(column_fn(i), indices);
+    if (!taken.ok()) {
+      results[i] = KATANA_ERROR(
+          katana::ErrorCode::ArrowError, "gathering property {}: {}",
+          schema->field(i)->name(), taken.status().ToString());
+      return;
+    }
+    columns[i] = taken.ValueOrDie().chunked_array();
+  });
+
+  for (auto& r : results) {
+    if (!r) {
+      return r.error();
+    }
+  }
+
+  return arrow::Table::Make(schema, columns);
+}
+
+katana::Result<std::shared_ptr<arrow::Array>>
+MakeIndexArray(const katana::NUMAArray<uint64_t>& perm) {
+  arrow::UInt64Builder builder;
+  if (auto r = builder.AppendValues(perm.begin(), perm.end()); !r.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "building index array: {}",
+        r.ToString());
+  }
+  std::shared_ptr<arrow::Array> indices;
+  if (auto r = builder.Finish(&indices); !r.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "building index array: {}",
+        r.ToString());
+  }
+  return indices;
+}
+
+/// Compute the new-to-old node permutation for the requested order.
+katana::NUMAArray<uint64_t>
+ComputeNodeOrder(const katana::GraphTopology& topo, NodeOrderKind kind) {
+  uint64_t num_nodes = topo.num_nodes();
+  katana::NUMAArray<uint64_t> node_perm;
+  node_perm.allocateInterleaved(num_nodes);
+
+  if (kind == NodeOrderKind::kDegree) {
+    using DegreeNodePair = std::pair<uint64_t, Node>;
+    katana::NUMAArray<DegreeNodePair> dn_pairs;
+    dn_pairs.allocateInterleaved(num_nodes);
+    katana::do_all(katana::iterate(topo.all_nodes()), [&](Node node) {
+      dn_pairs[node] = DegreeNodePair(topo.edges(node).size(), node);
+    });
+    katana::ParallelSTL::sort(
+        dn_pairs.begin(), dn_pairs.end(), std::greater<DegreeNodePair>());
+    katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t i) {
+      node_perm[i] = dn_pairs[i].second;
+    });
+    return node_perm;
+  }
+
+  katana::NUMAArray<Node> perm = kind == NodeOrderKind::kRCM
+                                     ? katana::ComputeRCMPermutation(topo)
+                                     : katana::ComputeGorderPermutation(topo);
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t i) {
+    node_perm[i] = perm[i];
+  });
+  return node_perm;
+}
+
+/// Renumber nodes by the given new-to-old permutation, producing a new
+/// graph with permuted topology, entity types, and node/edge properties.
+/// Edges keep their relative order within each node's neighborhood.
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+RenumberNodes(
+    katana::PropertyGraph* pg, const katana::NUMAArray<uint64_t>& node_perm) {
+  const auto& topo = pg->topology();
+  uint64_t num_nodes = topo.num_nodes();
+  uint64_t num_edges = topo.num_edges();
+
+  katana::NUMAArray<Node> old_to_new;
+  old_to_new.allocateInterleaved(num_nodes);
+  katana::NUMAArray<Edge> new_adj_indices;
+  new_adj_indices.allocateInterleaved(num_nodes);
+
+  katana::do_all(katana::iterate(uint64_t{0}, num_nodes), [&](uint64_t i) {
+    new_adj_indices[i] = topo.degree(node_perm[i]);
+    old_to_new[node_perm[i]] = i;
+  });
+  katana::ParallelSTL::partial_sum(
+      new_adj_indices.begin(), new_adj_indices.end(), new_adj_indices.begin());
+
+  katana::NUMAArray<Node> new_dests;
+  new_dests.allocateInterleaved(num_edges);
+  katana::NUMAArray<uint64_t> edge_perm;
+  edge_perm.allocateInterleaved(num_edges);
+
+  katana::PropertyGraph::EntityTypeIDArray node_types;
+  node_types.allocateInterleaved(num_nodes);
+  katana::PropertyGraph::EntityTypeIDArray edge_types;
+  edge_types.allocateInterleaved(num_edges);
+
+  katana::do_all(
+      katana::iterate(topo.all_nodes()),
+      [&](Node old_id) {
+        Node new_id = old_to_new[old_id];
+        node_types[new_id] = pg->GetTypeOfNode(old_id);
+        Edge out = new_id == 0 ? Edge{0} : new_adj_indices[new_id - 1];
+        for (Edge e : topo.edges(old_id)) {
+          new_dests[out] = old_to_new[topo.edge_dest(e)];
+          edge_perm[out] = e;
+          edge_types[out] = pg->GetTypeOfEdge(e);
+          ++out;
+        }
+      },
+      katana::steal());
+
+  katana::GraphTopology new_topo{
+      std::move(new_adj_indices), std::move(new_dests)};
+  std::unique_ptr<katana::PropertyGraph> new_pg =
+      KATANA_CHECKED(katana::PropertyGraph::Make(
+          std::move(new_topo), std::move(node_types), std::move(edge_types),
+          katana::EntityTypeManager(pg->GetNodeTypeManager()),
+          katana::EntityTypeManager(pg->GetEdgeTypeManager())));
+
+  if (pg->GetNumNodeProperties() > 0) {
+    std::shared_ptr<arrow::Array> indices =
+        KATANA_CHECKED(MakeIndexArray(node_perm));
+    std::shared_ptr<arrow::Table> props = KATANA_CHECKED(GatherPropertyRows(
+        pg->loaded_node_schema(),
+        [&](int i) { return pg->GetNodeProperty(i); }, indices));
+    KATANA_CHECKED(new_pg->AddNodeProperties(props));
+  }
+  if (pg->GetNumEdgeProperties() > 0) {
+    std::shared_ptr<arrow::Array> indices =
+        KATANA_CHECKED(MakeIndexArray(edge_perm));
+    std::shared_ptr<arrow::Table> props = KATANA_CHECKED(GatherPropertyRows(
+        pg->loaded_edge_schema(),
+        [&](int i) { return pg->GetEdgeProperty(i); }, indices));
+    KATANA_CHECKED(new_pg->AddEdgeProperties(props));
+  }
+
+  return std::unique_ptr<katana::PropertyGraph>(std::move(new_pg));
+}
+
+/// Sort every node's edges by destination in place and permute the edge
+/// properties to match the new edge order.
+katana::Result<void>
+SortEdgesWithProperties(katana::PropertyGraph* pg) {
+  std::unique_ptr<katana::NUMAArray<uint64_t>> perm =
+      KATANA_CHECKED(katana::SortAllEdgesByDest(pg));
+
+  if (pg->GetNumEdgeProperties() == 0) {
+    return katana::ResultSuccess();
+  }
+
+  std::shared_ptr<arrow::Array> indices =
+      KATANA_CHECKED(MakeIndexArray(*perm));
+  std::shared_ptr<arrow::Table> props = KATANA_CHECKED(GatherPropertyRows(
+      pg->loaded_edge_schema(), [&](int i) { return pg->GetEdgeProperty(i); },
+      indices));
+  while (pg->GetNumEdgeProperties() > 0) {
+    KATANA_CHECKED(pg->RemoveEdgeProperty(0));
+  }
+  return pg->AddEdgeProperties(props);
+}
+
+/// Merge every loaded property into a single contiguous chunk so the output
+/// is written as one arrow chunk per column.
+katana::Result<void>
+ConsolidateAllProperties(katana::PropertyGraph* pg) {
+  std::vector<std::string> node_props;
+  for (int32_t i = 0; i < pg->GetNumNodeProperties(); ++i) {
+    node_props.emplace_back(pg->GetNodePropertyName(i));
+  }
+  std::vector<std::string> edge_props;
+  for (int32_t i = 0; i < pg->GetNumEdgeProperties(); ++i) {
+    edge_props.emplace_back(pg->GetEdgePropertyName(i));
+  }
+  return pg->ConsolidateProperties(node_props, edge_props);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  kCommandLine = katana::Join(" ", argv, argv + argc);
+  katana::SharedMemSys G;
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv,
+      "Offline RDG compaction: re-sort, consolidate, and re-compress an "
+      "RDG for read performance\n");
+
+  auto pg_res = katana::PropertyGraph::Make(inputFilename);
+  if (!pg_res) {
+    KATANA_LOG_FATAL("failed to load {}: {}", inputFilename, pg_res.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  NodeOrderKind order = nodeOrder;
+  if (order == NodeOrderKind::kNone && sortNodesByDegree) {
+    order = NodeOrderKind::kDegree;
+  }
+  if (order != NodeOrderKind::kNone) {
+    auto renumbered =
+        RenumberNodes(pg.get(), ComputeNodeOrder(pg->topology(), order));
+    if (!renumbered) {
+      KATANA_LOG_FATAL("failed to renumber nodes: {}", renumbered.error());
+    }
+    pg = std::move(renumbered.value());
+  }
+
+  if (sortEdges) {
+    if (auto r = SortEdgesWithProperties(pg.get()); !r) {
+      KATANA_LOG_FATAL("failed to sort edges: {}", r.error());
+    }
+  }
+
+  if (auto r = ConsolidateAllProperties(pg.get()); !r) {
+    KATANA_LOG_FATAL("failed to consolidate properties: {}", r.error());
+  }
+
+  if (!compression.empty()) {
+    // the parquet writer picks its codec up from the environment; see
+    // ParquetWriter::StandardWriterProperties()
+    setenv("KATANA_PARQUET_COMPRESSION", compression.c_str(), 1);
+  }
+
+  if (auto r = pg->Write(outputFilename, kCommandLine); !r) {
+    KATANA_LOG_FATAL("failed to write {}: {}", outputFilename, r.error());
+  }
+
+  katana::gPrint(
+      "-nodes ", pg->num_nodes(), " -edges ", pg->num_edges(), "\n");
+  return 0;
+}
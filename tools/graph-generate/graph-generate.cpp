@@ -0,0 +1,269 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <llvm/Support/CommandLine.h>
+
+#include "katana/Galois.h"
+#include "katana/GraphTopology.h"
+#include "katana/NUMAArray.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Random.h"
+#include "katana/Strings.h"
+
+namespace cll = llvm::cl;
+
+// Synthesizes graphs at configurable scales and writes them out as RDGs,
+// bypassing the text conversion path entirely. Edges are generated in
+// parallel with per-thread generators; the CSR is assembled with the
+// concurrent TopologyBuilderImpl and the result stored through
+// PropertyGraph::Write.
+
+enum GenMode { rmat, uniform, powerlaw };
+
+static std::string kCommandLine;
+
+static cll::opt<std::string> outputFilename(
+    cll::Positional, cll::desc("<output RDG directory>"), cll::Required);
+static cll::opt<GenMode> genMode(
+    cll::desc("Generator:"),
+    cll::values(
+        clEnumVal(rmat, "Recursive-matrix (Graph500 style) generator"),
+        clEnumVal(uniform, "Erdos-Renyi generator with uniform endpoints"),
+        clEnumVal(
+            powerlaw,
+            "Endpoints drawn from a Zipf-like rank distribution")),
+    cll::Required);
+static cll::opt<unsigned> scale(
+    "scale", cll::desc("log2 of the number of nodes (required for rmat)"),
+    cll::init(0));
+static cll::opt<unsigned long long> numNodes(
+    "numNodes", cll::desc("number of nodes (ignored when -scale is set)"),
+    cll::init(0));
+static cll::opt<unsigned long long> edgeFactor(
+    "edgeFactor", cll::desc("edges generated per node"), cll::init(16));
+static cll::opt<double> rmatA(
+    "rmatA", cll::desc("RMAT upper-left quadrant probability"),
+    cll::init(0.57));
+static cll::opt<double> rmatB(
+    "rmatB", cll::desc("RMAT upper-right quadrant probability"),
+    cll::init(0.19));
+static cll::opt<double> rmatC(
+    "rmatC", cll::desc("RMAT lower-left quadrant probability"),
+    cll::init(0.19));
+static cll::opt<double> powerlawSkew(
+    "powerlawSkew",
+    cll::desc("skew exponent for powerlaw endpoints; larger "
+              "values concentrate edges on low node IDs"),
+    cll::init(2.0));
+static cll::opt<unsigned long long> seed(
+    "seed",
+    cll::desc("seed for deterministic generation; 0 uses "
+              "platform randomness"),
+    cll::init(0));
+static cll::opt<bool> genEdgeWeights(
+    "genEdgeWeights",
+    cll::desc("attach a uniform random int64 'weight' edge property"),
+    cll::init(false));
+static cll::opt<long long> minWeight(
+    "minWeight", cll::desc("minimum generated edge weight"), cll::init(1));
+static cll::opt<long long> maxWeight(
+    "maxWeight", cll::desc("maximum generated edge weight"), cll::init(100));
+
+namespace {
+
+using Node = katana::GraphTopologyTypes::Node;
+
+/// One RMAT edge: descend the adjacency matrix scale times, picking a
+/// quadrant per level according to the a/b/c/d probabilities.
+std::pair<Node, Node>
+GenRmatEdge(katana::RandGenerator& gen, unsigned scale_in) {
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  Node src = 0;
+  Node dst = 0;
+  for (unsigned level = 0; level < scale_in; ++level) {
+    double r = coin(gen);
+    src <<= 1;
+    dst <<= 1;
+    if (r < rmatA) {
+      // upper-left: no bits set
+    } else if (r < rmatA + rmatB) {
+      dst |= 1;
+    } else if (r < rmatA + rmatB + rmatC) {
+      src |= 1;
+    } else {
+      src |= 1;
+      dst |= 1;
+    }
+  }
+  return {src, dst};
+}
+
+std::pair<Node, Node>
+GenUniformEdge(katana::RandGenerator& gen, size_t num_nodes) {
+  std::uniform_int_distribution<Node> pick(0, num_nodes - 1);
+  return {pick(gen), pick(gen)};
+}
+
+/// Zipf-like endpoints via inverse transform: mapping a uniform draw u to
+/// floor(n * u^skew) concentrates mass on low node IDs with a power-law
+/// rank-frequency curve.
+std::pair<Node, Node>
+GenPowerlawEdge(katana::RandGenerator& gen, size_t num_nodes) {
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  auto pick = [&]() -> Node {
+    auto id = static_cast<size_t>(
+        static_cast<double>(num_nodes) * std::pow(coin(gen), powerlawSkew));
+    return static_cast<Node>(std::min(id, num_nodes - 1));
+  };
+  return {pick(), pick()};
+}
+
+/// Splits [0, count) into contiguous per-chunk ranges. Each chunk seeds the
+/// calling thread's generator from -seed and its chunk index so output is
+/// reproducible regardless of which thread runs which chunk.
+std::vector<std::pair<size_t, size_t>>
+ComputeChunks(size_t count) {
+  size_t num_chunks = std::min<size_t>(
+      4 * katana::getActiveThreads(), std::max<size_t>(count, 1));
+  std::vector<std::pair<size_t, size_t>> chunks;
+  chunks.reserve(num_chunks);
+  size_t per_chunk = (count + num_chunks - 1) / num_chunks;
+  for (size_t begin = 0; begin < count; begin += per_chunk) {
+    chunks.emplace_back(begin, std::min(begin + per_chunk, count));
+  }
+  return chunks;
+}
+
+katana::Result<void>
+AppendGeneratedWeights(katana::PropertyGraph* pg) {
+  katana::NUMAArray<int64_t> weights;
+  weights.allocateInterleaved(pg->num_edges());
+
+  std::vector<std::pair<size_t, size_t>> chunks =
+      ComputeChunks(pg->num_edges());
+  katana::do_all(
+      katana::iterate(size_t{0}, chunks.size()),
+      [&](size_t chunk_idx) {
+        katana::RandGenerator& gen = katana::GetGenerator();
+        if (seed != 0) {
+          gen.seed(seed + chunks.size() + chunk_idx);
+        }
+        std::uniform_int_distribution<int64_t> pick(minWeight, maxWeight);
+        for (size_t i = chunks[chunk_idx].first; i < chunks[chunk_idx].second;
+             ++i) {
+          weights[i] = pick(gen);
+        }
+      },
+      katana::steal());
+
+  arrow::Int64Builder builder;
+  if (auto r = builder.AppendValues(weights.begin(), weights.end()); !r.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", r);
+    return katana::ErrorCode::ArrowError;
+  }
+  std::shared_ptr<arrow::Array> array;
+  if (auto r = builder.Finish(&array); !r.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", r);
+    return katana::ErrorCode::ArrowError;
+  }
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::int64())}), {array});
+  return pg->AddEdgeProperties(table);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  kCommandLine = katana::Join(" ", argv, argv + argc);
+  katana::SharedMemSys G;
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "Synthetic graph generator producing RDGs directly\n");
+
+  if (genMode == rmat && scale == 0) {
+    KATANA_LOG_FATAL("rmat requires -scale");
+  }
+  if (rmatA + rmatB + rmatC >= 1.0) {
+    KATANA_LOG_FATAL("RMAT quadrant probabilities must sum to less than 1");
+  }
+
+  size_t num_nodes = scale != 0 ? size_t{1} << scale : size_t{numNodes};
+  if (num_nodes == 0) {
+    KATANA_LOG_FATAL("one of -scale or -numNodes is required");
+  }
+  size_t num_edges = num_nodes * edgeFactor;
+
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(num_nodes);
+
+  std::vector<std::pair<size_t, size_t>> chunks = ComputeChunks(num_edges);
+  katana::do_all(
+      katana::iterate(size_t{0}, chunks.size()),
+      [&](size_t chunk_idx) {
+        katana::RandGenerator& gen = katana::GetGenerator();
+        if (seed != 0) {
+          gen.seed(seed + chunk_idx);
+        }
+        for (size_t i = chunks[chunk_idx].first; i < chunks[chunk_idx].second;
+             ++i) {
+          std::pair<Node, Node> edge;
+          switch (genMode) {
+          case rmat:
+            edge = GenRmatEdge(gen, scale);
+            break;
+          case uniform:
+            edge = GenUniformEdge(gen, num_nodes);
+            break;
+          case powerlaw:
+            edge = GenPowerlawEdge(gen, num_nodes);
+            break;
+          }
+          builder.AddEdge(edge.first, edge.second);
+        }
+      },
+      katana::steal());
+
+  katana::GraphTopology topo = builder.ConvertToCSR();
+  auto pg_res = katana::PropertyGraph::Make(std::move(topo));
+  if (!pg_res) {
+    KATANA_LOG_FATAL("failed to create PropertyGraph: {}", pg_res.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  if (genEdgeWeights) {
+    if (auto r = AppendGeneratedWeights(pg.get()); !r) {
+      KATANA_LOG_FATAL("could not add edge weights: {}", r.error());
+    }
+  }
+
+  if (auto r = pg->Write(outputFilename, kCommandLine); !r) {
+    KATANA_LOG_FATAL("failed to write RDG: {}", r.error());
+  }
+
+  katana::gPrint(
+      "-nodes ", pg->num_nodes(), " -edges ", pg->num_edges(), "\n");
+  return 0;
+}
@@ -0,0 +1,517 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+///
+/// graph-server hosts one loaded PropertyGraph and serves topology ranges,
+/// property ranges, and predicate selections to thin clients over a batched
+/// binary RPC, so many analysts share a single resident copy of the graph
+/// instead of each loading their own.
+///
+/// The protocol is one HTTP POST to /batch per round trip. The request body
+/// packs any number of operations; the response carries one status and
+/// payload per operation in order, so a client assembles everything it
+/// needs for a step (a topology slice, the property columns over it, a
+/// selection bitmap) in a single exchange. All integers are little-endian.
+///
+/// Request body:   "KGS1" u32 | num_ops u32 | per op: op u32, body_len u32,
+///                 body bytes.
+/// Response body:  "KGSR" u32 | num_ops u32 | per op: status u32 (0 = ok),
+///                 payload_len u64, payload bytes (an error message when
+///                 status != 0).
+///
+/// Operations:
+///   0 info            -> num_nodes u64, num_edges u64, node property
+///                        names, edge property names (each: count u32,
+///                        then len u32 + chars per name)
+///   1 topology        <- node_begin u64, node_end u64
+///                     -> node_begin u64, node_end u64, edge_begin u64,
+///                        edge_end u64, adjacency ends u64[node range],
+///                        destinations u32[edge range]
+///   2 node property   <- name (len u32 + chars), row_begin u64, row_end u64
+///   3 edge property      (same body as 2)
+///                     -> arrow type id u32, value width u32, num_rows u64,
+///                        raw values, has_validity u8, validity bits
+///                        (num_rows bits, LSB first) when present
+///   4 select nodes    <- num_predicates u32, per predicate: name, op u32
+///   5 select edges       (PredicateOp), value f64
+///                     -> num_bits u64, count u64, bitmap words u64[...]
+///
+/// Selections evaluate server side through the property-filter engine, so
+/// a client scanning for "value > 0.9" receives a bitmap instead of the
+/// column.
+///
+/// GET / answers with a one-line text summary for health checks.
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/PropertyFilter.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "llvm/Support/CommandLine.h"
+
+namespace cll = llvm::cl;
+
+static cll::opt<std::string> inputFile(
+    cll::Positional, cll::desc("<input rdg>"), cll::Required);
+static cll::opt<int> port(
+    "port", cll::desc("TCP port to listen on"), cll::init(9090));
+static cll::opt<int> threads(
+    "t", cll::desc("Number of threads for server-side evaluation"),
+    cll::init(1));
+
+namespace {
+
+constexpr uint32_t kRequestMagic = 0x3153474b;   // "KGS1"
+constexpr uint32_t kResponseMagic = 0x5253474b;  // "KGSR"
+
+enum Op : uint32_t {
+  kInfo = 0,
+  kTopology = 1,
+  kNodeProperty = 2,
+  kEdgeProperty = 3,
+  kSelectNodes = 4,
+  kSelectEdges = 5,
+};
+
+/// Append-only little-endian serializer over a byte vector.
+class Writer {
+public:
+  explicit Writer(std::vector<char>* out) : out_(out) {}
+
+  template <typename T>
+  void Pod(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const char* p = reinterpret_cast<const char*>(&value);
+    out_->insert(out_->end(), p, p + sizeof(T));
+  }
+
+  void Bytes(const void* data, size_t n) {
+    const char* p = static_cast<const char*>(data);
+    out_->insert(out_->end(), p, p + n);
+  }
+
+  void String(const std::string& s) {
+    Pod<uint32_t>(s.size());
+    Bytes(s.data(), s.size());
+  }
+
+  size_t size() const { return out_->size(); }
+
+private:
+  std::vector<char>* out_;
+};
+
+/// Bounds-checked little-endian reader over a request body.
+class Reader {
+public:
+  Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  katana::Result<T> Pod() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (size_ - pos_ < sizeof(T)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "truncated request body");
+    }
+    T value;
+    memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  katana::Result<std::string> String() {
+    uint32_t len = KATANA_CHECKED(Pod<uint32_t>());
+    if (size_ - pos_ < len) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "truncated request body");
+    }
+    std::string s(data_ + pos_, len);
+    pos_ += len;
+    return s;
+  }
+
+private:
+  const char* data_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+katana::Result<void>
+HandleInfo(const katana::PropertyGraph& pg, Writer* out) {
+  out->Pod<uint64_t>(pg.num_nodes());
+  out->Pod<uint64_t>(pg.num_edges());
+  const auto& node_schema = pg.loaded_node_schema();
+  out->Pod<uint32_t>(node_schema->num_fields());
+  for (int i = 0; i < node_schema->num_fields(); ++i) {
+    out->String(node_schema->field(i)->name());
+  }
+  const auto& edge_schema = pg.loaded_edge_schema();
+  out->Pod<uint32_t>(edge_schema->num_fields());
+  for (int i = 0; i < edge_schema->num_fields(); ++i) {
+    out->String(edge_schema->field(i)->name());
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+HandleTopology(const katana::PropertyGraph& pg, Reader* in, Writer* out) {
+  uint64_t node_begin = KATANA_CHECKED(in->Pod<uint64_t>());
+  uint64_t node_end = KATANA_CHECKED(in->Pod<uint64_t>());
+  if (node_begin > node_end || node_end > pg.num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "node range [{}, {}) out of [0, {})",
+        node_begin, node_end, pg.num_nodes());
+  }
+  const katana::GraphTopology& topology = pg.topology();
+  uint64_t edge_begin =
+      node_begin == 0 ? 0 : topology.adj_data()[node_begin - 1];
+  uint64_t edge_end =
+      node_end == 0 ? 0 : topology.adj_data()[node_end - 1];
+  out->Pod<uint64_t>(node_begin);
+  out->Pod<uint64_t>(node_end);
+  out->Pod<uint64_t>(edge_begin);
+  out->Pod<uint64_t>(edge_end);
+  out->Bytes(
+      topology.adj_data() + node_begin,
+      (node_end - node_begin) * sizeof(uint64_t));
+  out->Bytes(
+      topology.dest_data() + edge_begin,
+      (edge_end - edge_begin) * sizeof(uint32_t));
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+HandleProperty(
+    const katana::PropertyGraph& pg, bool is_node, Reader* in, Writer* out) {
+  std::string name = KATANA_CHECKED(in->String());
+  uint64_t row_begin = KATANA_CHECKED(in->Pod<uint64_t>());
+  uint64_t row_end = KATANA_CHECKED(in->Pod<uint64_t>());
+
+  std::shared_ptr<arrow::ChunkedArray> column = KATANA_CHECKED(
+      is_node ? pg.GetNodeProperty(name) : pg.GetEdgeProperty(name));
+  if (row_begin > row_end ||
+      row_end > static_cast<uint64_t>(column->length())) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "row range [{}, {}) out of [0, {})",
+        row_begin, row_end, column->length());
+  }
+
+  const auto& type = column->type();
+  auto fixed = std::dynamic_pointer_cast<arrow::FixedWidthType>(type);
+  if (!fixed || fixed->bit_width() % 8 != 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented,
+        "property {} has non-fixed-width type {}; fetch it through the "
+        "column API instead",
+        name, type->name());
+  }
+  const size_t width = fixed->bit_width() / 8;
+  const uint64_t num_rows = row_end - row_begin;
+
+  out->Pod<uint32_t>(type->id());
+  out->Pod<uint32_t>(width);
+  out->Pod<uint64_t>(num_rows);
+
+  // Copy the value range chunk by chunk straight out of the Arrow buffers.
+  uint64_t chunk_start = 0;
+  bool has_nulls = false;
+  for (const auto& chunk : column->chunks()) {
+    uint64_t chunk_end = chunk_start + chunk->length();
+    uint64_t lo = std::max(row_begin, chunk_start);
+    uint64_t hi = std::min(row_end, chunk_end);
+    if (lo < hi) {
+      const uint8_t* values = chunk->data()->buffers[1]->data() +
+                              (chunk->offset() + (lo - chunk_start)) * width;
+      out->Bytes(values, (hi - lo) * width);
+      if (chunk->null_count() > 0) {
+        has_nulls = true;
+      }
+    }
+    chunk_start = chunk_end;
+  }
+
+  out->Pod<uint8_t>(has_nulls ? 1 : 0);
+  if (has_nulls) {
+    std::vector<uint8_t> validity((num_rows + 7) / 8, 0);
+    chunk_start = 0;
+    for (const auto& chunk : column->chunks()) {
+      uint64_t chunk_end = chunk_start + chunk->length();
+      uint64_t lo = std::max(row_begin, chunk_start);
+      uint64_t hi = std::min(row_end, chunk_end);
+      for (uint64_t row = lo; row < hi; ++row) {
+        if (!chunk->IsNull(row - chunk_start)) {
+          uint64_t i = row - row_begin;
+          validity[i / 8] |= uint8_t{1} << (i % 8);
+        }
+      }
+      chunk_start = chunk_end;
+    }
+    out->Bytes(validity.data(), validity.size());
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+HandleSelect(
+    const katana::PropertyGraph& pg, bool is_node, Reader* in, Writer* out) {
+  uint32_t num_predicates = KATANA_CHECKED(in->Pod<uint32_t>());
+  std::vector<katana::PropertyPredicate> predicates;
+  predicates.reserve(num_predicates);
+  for (uint32_t i = 0; i < num_predicates; ++i) {
+    katana::PropertyPredicate predicate;
+    predicate.property_name = KATANA_CHECKED(in->String());
+    predicate.op =
+        static_cast<katana::PredicateOp>(KATANA_CHECKED(in->Pod<uint32_t>()));
+    predicate.value = KATANA_CHECKED(in->Pod<double>());
+    predicates.emplace_back(std::move(predicate));
+  }
+
+  katana::DynamicBitset selected = KATANA_CHECKED(
+      is_node ? katana::EvaluateNodePredicates(&pg, predicates)
+              : katana::EvaluateEdgePredicates(&pg, predicates));
+
+  out->Pod<uint64_t>(selected.size());
+  out->Pod<uint64_t>(selected.count());
+  for (const auto& word : selected.get_vec()) {
+    out->Pod<uint64_t>(word);
+  }
+  return katana::ResultSuccess();
+}
+
+/// Decode and execute one batch request; always produces a well-formed
+/// response, turning per-op failures into per-op error payloads.
+std::vector<char>
+HandleBatch(const katana::PropertyGraph& pg, const std::vector<char>& body) {
+  std::vector<char> response;
+  Writer header(&response);
+
+  Reader in(body.data(), body.size());
+  auto magic = in.Pod<uint32_t>();
+  auto num_ops = in.Pod<uint32_t>();
+  if (!magic || magic.value() != kRequestMagic || !num_ops) {
+    header.Pod<uint32_t>(kResponseMagic);
+    header.Pod<uint32_t>(0);
+    return response;
+  }
+
+  header.Pod<uint32_t>(kResponseMagic);
+  header.Pod<uint32_t>(num_ops.value());
+
+  for (uint32_t i = 0; i < num_ops.value(); ++i) {
+    auto op = in.Pod<uint32_t>();
+    auto body_len = in.Pod<uint32_t>();
+    katana::Result<void> result = katana::ResultSuccess();
+    std::vector<char> payload;
+    Writer out(&payload);
+    if (!op || !body_len) {
+      result = KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "truncated request body");
+    } else {
+      // Each op parses from its own body; trailing bytes in an op body
+      // are ignored so fields can be added without breaking old servers.
+      std::vector<char> op_body;
+      op_body.resize(body_len.value());
+      for (auto& byte : op_body) {
+        auto b = in.Pod<char>();
+        if (!b) {
+          result = KATANA_ERROR(
+              katana::ErrorCode::InvalidArgument, "truncated request body");
+          break;
+        }
+        byte = b.value();
+      }
+      if (result) {
+        Reader op_in(op_body.data(), op_body.size());
+        switch (op.value()) {
+        case kInfo:
+          result = HandleInfo(pg, &out);
+          break;
+        case kTopology:
+          result = HandleTopology(pg, &op_in, &out);
+          break;
+        case kNodeProperty:
+          result = HandleProperty(pg, true, &op_in, &out);
+          break;
+        case kEdgeProperty:
+          result = HandleProperty(pg, false, &op_in, &out);
+          break;
+        case kSelectNodes:
+          result = HandleSelect(pg, true, &op_in, &out);
+          break;
+        case kSelectEdges:
+          result = HandleSelect(pg, false, &op_in, &out);
+          break;
+        default:
+          result = KATANA_ERROR(
+              katana::ErrorCode::InvalidArgument, "unknown op {}", op.value());
+        }
+      }
+    }
+    if (!result) {
+      payload.clear();
+      std::string message = fmt::format("{}", result.error());
+      payload.assign(message.begin(), message.end());
+      header.Pod<uint32_t>(1);
+    } else {
+      header.Pod<uint32_t>(0);
+    }
+    header.Pod<uint64_t>(payload.size());
+    header.Bytes(payload.data(), payload.size());
+  }
+  return response;
+}
+
+bool
+SendAll(int fd, const char* data, size_t n) {
+  while (n > 0) {
+    ssize_t sent = send(fd, data, n, 0);
+    if (sent <= 0) {
+      return false;
+    }
+    data += sent;
+    n -= sent;
+  }
+  return true;
+}
+
+void
+SendHttp(
+    int fd, const char* status, const char* content_type,
+    const std::vector<char>& body) {
+  std::string head = std::string("HTTP/1.1 ") + status +
+                     "\r\nContent-Type: " + content_type +
+                     "\r\nContent-Length: " + std::to_string(body.size()) +
+                     "\r\nConnection: close\r\n\r\n";
+  if (SendAll(fd, head.data(), head.size())) {
+    SendAll(fd, body.data(), body.size());
+  }
+}
+
+/// Minimal HTTP/1.1 handling: read one request, answer it, close. Thin
+/// clients batch everything into a single POST so connection reuse buys
+/// little here.
+void
+ServeConnection(int fd, const katana::PropertyGraph* pg) {
+  std::string request;
+  size_t header_end = std::string::npos;
+  char buf[4096];
+  while (header_end == std::string::npos) {
+    ssize_t got = recv(fd, buf, sizeof(buf), 0);
+    if (got <= 0) {
+      close(fd);
+      return;
+    }
+    request.append(buf, got);
+    header_end = request.find("\r\n\r\n");
+  }
+
+  size_t content_length = 0;
+  // Field names are case-insensitive; clients in the wild send both forms.
+  for (const char* field : {"Content-Length:", "content-length:"}) {
+    size_t at = request.find(field);
+    if (at != std::string::npos && at < header_end) {
+      content_length = strtoull(request.c_str() + at + strlen(field), nullptr, 10);
+      break;
+    }
+  }
+
+  std::vector<char> body(
+      request.begin() + header_end + 4, request.end());
+  while (body.size() < content_length) {
+    ssize_t got = recv(fd, buf, sizeof(buf), 0);
+    if (got <= 0) {
+      close(fd);
+      return;
+    }
+    body.insert(body.end(), buf, buf + got);
+  }
+
+  if (request.rfind("POST /batch", 0) == 0) {
+    SendHttp(fd, "200 OK", "application/octet-stream", HandleBatch(*pg, body));
+  } else if (request.rfind("GET /", 0) == 0) {
+    std::string text = fmt::format(
+        "graph-server: {} nodes, {} edges\n", pg->num_nodes(),
+        pg->num_edges());
+    SendHttp(fd, "200 OK", "text/plain", {text.begin(), text.end()});
+  } else {
+    SendHttp(fd, "404 Not Found", "text/plain", {});
+  }
+  close(fd);
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys G;
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+  katana::setActiveThreads(threads);
+
+  auto pg_result = katana::PropertyGraph::Make(inputFile);
+  if (!pg_result) {
+    KATANA_LOG_FATAL(
+        "cannot load {}: {}", std::string(inputFile), pg_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_result.value());
+  std::cout << "loaded " << inputFile << ": " << pg->num_nodes() << " nodes, "
+            << pg->num_edges() << " edges\n";
+
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    KATANA_LOG_FATAL("socket: {}", strerror(errno));
+  }
+  int enable = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(listen_fd, 64) < 0) {
+    KATANA_LOG_FATAL("cannot listen on port {}: {}", port, strerror(errno));
+  }
+  std::cout << "listening on port " << port << "\n";
+
+  while (true) {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+    int nodelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    std::thread(ServeConnection, fd, pg.get()).detach();
+  }
+}
@@ -17,13 +17,20 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <random>
 #include <vector>
 
 #include "katana/Galois.h"
 #include "katana/LCGraph.h"
 #include "katana/OfflineGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SimpleLock.h"
+#include "katana/Statistics.h"
 #include "llvm/Support/CommandLine.h"
 
 namespace cll = llvm::cl;
@@ -36,7 +43,8 @@ enum StatMode {
   indegreehist,
   sortedlogoffsethist,
   sparsityPattern,
-  summary
+  summary,
+  fusedstats
 };
 
 static cll::opt<std::string> inputfilename(
@@ -56,11 +64,19 @@ static cll::list<StatMode> statModeList(
             sparsityPattern,
             "Pattern of non-zeros when graph is "
             "interpreted as a sparse matrix"),
-        clEnumVal(summary, "Graph summary")));
+        clEnumVal(summary, "Graph summary"),
+        clEnumVal(
+            fusedstats,
+            "Degree/in-degree histograms, assortativity, sampled "
+            "clustering and component count in a single pass")));
 static cll::opt<int> numBins(
     "numBins", cll::desc("Number of bins"), cll::init(-1));
 static cll::opt<int> columns(
     "columns", cll::desc("Columns for sparsity"), cll::init(80));
+static cll::opt<unsigned long long> clusteringSamples(
+    "clusteringSamples",
+    cll::desc("Wedge samples for the fused clustering estimate"),
+    cll::init(1000000));
 
 typedef katana::OfflineGraph Graph;
 typedef Graph::GraphNode GNode;
@@ -251,8 +267,225 @@ doDestinationHistogram(Graph& graph) {
   printHistogram("DestinationBin", hist);
 }
 
+// Concurrent union-find over a shared parent array; find uses path halving
+// (the racy write is benign, it only shortens paths) and union links the
+// larger root under the smaller with a CAS
+uint64_t
+findRoot(std::vector<uint64_t>& parent, uint64_t x) {
+  while (parent[x] != x) {
+    uint64_t grand = parent[parent[x]];
+    parent[x] = grand;
+    x = grand;
+  }
+  return x;
+}
+
+void
+unionNodes(std::vector<uint64_t>& parent, uint64_t a, uint64_t b) {
+  while (true) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a == b) {
+      return;
+    }
+    if (a < b) {
+      std::swap(a, b);
+    }
+    if (__sync_bool_compare_and_swap(&parent[a], a, b)) {
+      return;
+    }
+  }
+}
+
+// doFusedStats computes degree and in-degree histograms, degree
+// assortativity, a weakly-connected-component count and a sampled global
+// clustering coefficient in one pass over the edges instead of one pass per
+// statistic. Each thread streams its own block of the graph through a
+// private OfflineGraph, so the single shared stream is not a bottleneck.
+void
+doFusedStats(const std::string& filename) {
+  Graph sizes(filename);
+  const uint64_t numNodes = sizes.size();
+  const uint64_t numEdges = sizes.sizeEdges();
+  if (numNodes == 0) {
+    std::cout << "NumNodes: 0\n";
+    return;
+  }
+
+  // degrees come from an index-only scan; the edge pass below needs the
+  // degree of arbitrary destinations, which the out index gives in O(1)
+  std::vector<uint64_t> degree(numNodes);
+  katana::RunningSum<double> degreeSum;
+  katana::RunningMax<uint64_t> degreeMax;
+  uint64_t maxDegreeNode = 0;
+  for (auto n : sizes) {
+    uint64_t d = sizes.edges(n).size();
+    degree[n] = d;
+    degreeSum.add(static_cast<double>(d));
+    if (d > degreeMax.max()) {
+      maxDegreeNode = n;
+    }
+    degreeMax.add(d);
+  }
+
+  std::vector<uint64_t> indeg(numNodes);
+  std::vector<uint64_t> parent(numNodes);
+  for (uint64_t i = 0; i < numNodes; ++i) {
+    parent[i] = i;
+  }
+
+  // sums for the Pearson correlation of (deg(src), deg(dst)) over edges
+  katana::GAccumulator<double> sumX;
+  katana::GAccumulator<double> sumY;
+  katana::GAccumulator<double> sumXX;
+  katana::GAccumulator<double> sumYY;
+  katana::GAccumulator<double> sumXY;
+  katana::GAccumulator<uint64_t> edgesSeen;
+
+  katana::SimpleLock histLock;
+  std::map<uint64_t, uint64_t> degreeHist;
+
+  katana::on_each([&](unsigned tid, unsigned total) {
+    Graph graph(filename);
+    auto range = katana::block_range(graph.begin(), graph.end(), tid, total);
+    std::map<uint64_t, uint64_t> localHist;
+    double sx = 0;
+    double sy = 0;
+    double sxx = 0;
+    double syy = 0;
+    double sxy = 0;
+    uint64_t seen = 0;
+    for (auto ii = range.first; ii != range.second; ++ii) {
+      GNode src = *ii;
+      double x = static_cast<double>(degree[src]);
+      ++localHist[degree[src]];
+      for (auto jj : graph.edges(src)) {
+        GNode dst = graph.getEdgeDst(jj);
+        __sync_fetch_and_add(&indeg[dst], 1);
+        unionNodes(parent, src, dst);
+        double y = static_cast<double>(degree[dst]);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        syy += y * y;
+        sxy += x * y;
+        ++seen;
+      }
+    }
+    sumX += sx;
+    sumY += sy;
+    sumXX += sxx;
+    sumYY += syy;
+    sumXY += sxy;
+    edgesSeen += seen;
+    std::lock_guard<katana::SimpleLock> lg(histLock);
+    for (auto p : localHist) {
+      degreeHist[p.first] += p.second;
+    }
+  });
+
+  // the in-degree histogram and component count fold over per-node state
+  // the edge pass left behind
+  std::map<uint64_t, uint64_t> inDegreeHist;
+  uint64_t numComponents = 0;
+  for (uint64_t i = 0; i < numNodes; ++i) {
+    ++inDegreeHist[indeg[i]];
+    if (findRoot(parent, i) == i) {
+      ++numComponents;
+    }
+  }
+
+  // sampled global clustering coefficient: wedges are sampled uniformly via
+  // a prefix sum of per-node wedge counts, and a wedge is closed if either
+  // direction of the closing edge exists
+  std::vector<uint64_t> wedgePrefix(numNodes + 1);
+  for (uint64_t i = 0; i < numNodes; ++i) {
+    wedgePrefix[i + 1] = wedgePrefix[i] + degree[i] * (degree[i] - 1) / 2;
+  }
+  const uint64_t totalWedges = wedgePrefix[numNodes];
+  const uint64_t wantedSamples = clusteringSamples;
+  katana::GAccumulator<uint64_t> closedWedges;
+  katana::GAccumulator<uint64_t> sampledWedges;
+  if (totalWedges != 0 && wantedSamples != 0) {
+    katana::on_each([&](unsigned tid, unsigned total) {
+      Graph graph(filename);
+      std::mt19937_64 rng(29 + tid);
+      uint64_t samples =
+          wantedSamples / total + (tid < wantedSamples % total ? 1 : 0);
+      uint64_t closed = 0;
+      for (uint64_t s = 0; s < samples; ++s) {
+        uint64_t w = rng() % totalWedges;
+        auto it =
+            std::upper_bound(wedgePrefix.begin(), wedgePrefix.end(), w);
+        GNode center = (it - wedgePrefix.begin()) - 1;
+        uint64_t d = degree[center];
+        uint64_t i = rng() % d;
+        uint64_t j = rng() % (d - 1);
+        if (j >= i) {
+          ++j;
+        }
+        auto eb = graph.edge_begin(center);
+        GNode u = graph.getEdgeDst(eb + i);
+        GNode v = graph.getEdgeDst(eb + j);
+        bool found = false;
+        for (auto kk : graph.edges(u)) {
+          if (graph.getEdgeDst(kk) == v) {
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          for (auto kk : graph.edges(v)) {
+            if (graph.getEdgeDst(kk) == u) {
+              found = true;
+              break;
+            }
+          }
+        }
+        if (found) {
+          ++closed;
+        }
+      }
+      closedWedges += closed;
+      sampledWedges += samples;
+    });
+  }
+
+  const double e = static_cast<double>(edgesSeen.reduce());
+  double assortativity = std::nan("");
+  if (e != 0) {
+    double mx = sumX.reduce() / e;
+    double my = sumY.reduce() / e;
+    double vx = sumXX.reduce() / e - mx * mx;
+    double vy = sumYY.reduce() / e - my * my;
+    if (vx > 0 && vy > 0) {
+      assortativity =
+          (sumXY.reduce() / e - mx * my) / (std::sqrt(vx) * std::sqrt(vy));
+    }
+  }
+  double clustering = 0;
+  if (sampledWedges.reduce() != 0) {
+    clustering = static_cast<double>(closedWedges.reduce()) /
+                 static_cast<double>(sampledWedges.reduce());
+  }
+
+  std::cout << "NumNodes: " << numNodes << "\n";
+  std::cout << "NumEdges: " << numEdges << "\n";
+  std::cout << "AvgDegree: " << degreeSum.avg() << "\n";
+  std::cout << "MaxDegreeNode: " << maxDegreeNode
+            << " , MaxDegree: " << degreeMax.max() << "\n";
+  std::cout << "Assortativity: " << assortativity << "\n";
+  std::cout << "ClusteringCoefficient: " << clustering << " (sampled from "
+            << sampledWedges.reduce() << " of " << totalWedges
+            << " wedges)\n";
+  std::cout << "ConnectedComponents: " << numComponents << "\n";
+  printHistogram("Degree", degreeHist);
+  printHistogram("InDegree", inDegreeHist);
+}
+
 int
 main(int argc, char** argv) {
+  katana::SharedMemSys G;
   llvm::cl::ParseCommandLineOptions(argc, argv);
   try {
     Graph graph(inputfilename);
@@ -291,6 +524,9 @@ main(int argc, char** argv) {
       case summary:
         doSummary(graph);
         break;
+      case fusedstats:
+        doFusedStats(inputfilename);
+        break;
       default:
         std::cerr << "Unknown stat requested\n";
         break;